@@ -0,0 +1,186 @@
+#ifndef HEADER_fd_src_ballet_pack_fd_alt_cache_h
+#define HEADER_fd_src_ballet_pack_fd_alt_cache_h
+
+#include "../fd_ballet_base.h"
+#include "../txn/fd_txn.h"
+
+/* fd_alt_cache is a cache of the contents of on-chain address lookup
+   tables (ALTs), keyed by the address of the table account.  v0
+   transactions can load accounts from ALTs by index, and pack needs the
+   resolved addresses to know which accounts such a transaction reads
+   and writes.
+
+   The cache is meant to live in a workspace shared between whatever
+   loads tables from the account store (the writer) and pack (the
+   reader).  It is direct mapped: each table address hashes to one
+   entry, and inserting a table evicts whichever table was in its entry
+   before.  A miss is never an error, just a lost opportunity for
+   precision, so there's no need for anything smarter.
+
+   Each entry is protected by a sequence lock:
+
+     - There must be at most one writer at a time (or the writers must
+       serialize among themselves).  The writer makes the sequence
+       number odd, updates the entry, and then makes it even again.
+     - Readers copy what they need out of the entry and then check that
+       the sequence number was even and didn't change while they did,
+       retrying if it did.
+
+   So readers never block the writer, and they always see an entry as
+   it was after some complete insert.
+
+   Tables can only be extended, or deactivated and eventually closed.
+   A stale entry for an extended table still resolves every index that
+   was valid when it was inserted, so refreshing it is only needed to
+   resolve the new ones.  The results are only used to schedule, not to
+   execute, so a stale entry for a table that was closed and recreated
+   at the same address can make pack schedule conservatively or
+   optimistically, but can't make a transaction execute incorrectly. */
+
+#define FD_ALT_CACHE_MAGIC (0xF17EDA2C37A17CA0UL) /* F17E=FIRE,DA2C/37=DANCER,A17CA=ALTCA,0=V0 / FIREDANCER ALT CACHE V0 */
+
+#define FD_ALT_CACHE_ALIGN    (128UL)
+
+/* FD_ALT_CACHE_ADDR_MAX is the maximum number of addresses in an
+   on-chain address lookup table. */
+#define FD_ALT_CACHE_ADDR_MAX (256UL)
+
+#define FD_ALT_CACHE_FOOTPRINT( entry_cnt ) ( sizeof(fd_alt_cache_t) + ((entry_cnt)-1UL)*sizeof(fd_alt_cache_entry_t) )
+
+struct __attribute__((aligned(FD_ALT_CACHE_ALIGN))) fd_private_alt_cache_entry {
+  /* seq: odd while the entry is being written.  Starts at 0. */
+  ulong          seq;
+  /* addr_cnt: the number of valid elements of addr, or 0 if the entry
+     is empty. */
+  ulong          addr_cnt;
+  /* key: the address of the table account */
+  fd_acct_addr_t key;
+  fd_acct_addr_t addr[ FD_ALT_CACHE_ADDR_MAX ];
+};
+typedef struct fd_private_alt_cache_entry fd_alt_cache_entry_t;
+
+struct __attribute__((aligned(FD_ALT_CACHE_ALIGN))) fd_private_alt_cache {
+  /* magic: set to FD_ALT_CACHE_MAGIC */
+  ulong magic;
+  /* entry_cnt_mask: (entry_cnt_mask+1) is the number of entries, a
+     power of two */
+  ulong entry_cnt_mask;
+  /* entries: the array of (entry_cnt_mask+1) entries follows.  The
+     array size of 1 is just convention. */
+  fd_alt_cache_entry_t entries[1];
+};
+typedef struct fd_private_alt_cache fd_alt_cache_t;
+
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_alt_cache_{align, footprint} return the alignment and footprint
+   of a region of memory suitable for a cache with entry_cnt entries.
+   entry_cnt must be a power of two.  fd_alt_cache_footprint returns 0
+   for an invalid entry_cnt. */
+FD_FN_CONST static inline ulong fd_alt_cache_align    ( void ) { return FD_ALT_CACHE_ALIGN; }
+FD_FN_CONST static inline ulong fd_alt_cache_footprint( ulong entry_cnt ) {
+  if( FD_UNLIKELY( !entry_cnt || !fd_ulong_is_pow2( entry_cnt )                                      ) ) return 0UL;
+  if( FD_UNLIKELY(  entry_cnt > ((ULONG_MAX - sizeof(fd_alt_cache_t))/sizeof(fd_alt_cache_entry_t)) ) ) return 0UL;
+  return FD_ALT_CACHE_FOOTPRINT( entry_cnt );
+}
+
+/* fd_alt_cache_new formats mem, which must have the required alignment
+   and footprint, as an empty cache with entry_cnt entries.  Returns mem
+   on success and NULL if entry_cnt is invalid.  The memory region can
+   be shared with other threads or processes; each should have its own
+   join. */
+static inline void *
+fd_alt_cache_new( void * mem,
+                  ulong  entry_cnt ) {
+  if( FD_UNLIKELY( !fd_alt_cache_footprint( entry_cnt ) ) ) return NULL;
+  fd_alt_cache_t * cache = (fd_alt_cache_t *)mem;
+  cache->entry_cnt_mask = entry_cnt-1UL;
+  for( ulong i=0UL; i<entry_cnt; i++ ) {
+    cache->entries[ i ].seq      = 0UL;
+    cache->entries[ i ].addr_cnt = 0UL;
+    fd_memset( cache->entries[ i ].key.b, 0, FD_TXN_ACCT_ADDR_SZ );
+  }
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = FD_ALT_CACHE_MAGIC;
+  FD_COMPILER_MFENCE();
+  return mem;
+}
+
+static inline fd_alt_cache_t *
+fd_alt_cache_join( void * _cache ) {
+  fd_alt_cache_t * cache = (fd_alt_cache_t *)_cache;
+  if( FD_UNLIKELY( cache->magic != FD_ALT_CACHE_MAGIC ) ) return NULL;
+  return cache;
+}
+static inline void * fd_alt_cache_leave ( fd_alt_cache_t * cache ) { return (void *)cache; }
+static inline void * fd_alt_cache_delete( fd_alt_cache_t * cache ) {
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+  return (void *)cache;
+}
+
+/* fd_alt_cache_private_entry returns the entry that table maps to. */
+FD_FN_PURE static inline fd_alt_cache_entry_t *
+fd_alt_cache_private_entry( fd_alt_cache_t const * cache,
+                            fd_acct_addr_t const * table ) {
+  ulong idx = fd_ulong_hash( fd_ulong_load_8( table->b ) ) & cache->entry_cnt_mask;
+  return (fd_alt_cache_entry_t *)(cache->entries + idx);
+}
+
+/* fd_alt_cache_insert stores the addr_cnt addresses in addr as the
+   contents of the table with address table, replacing whatever was
+   cached for it before, as well as any other table that maps to the
+   same entry.  addr_cnt must be in [1, FD_ALT_CACHE_ADDR_MAX].  Must
+   not be called concurrently with another insert, but can be called
+   concurrently with fd_alt_cache_resolve. */
+static inline void
+fd_alt_cache_insert( fd_alt_cache_t       * cache,
+                     fd_acct_addr_t const * table,
+                     fd_acct_addr_t const * addr,
+                     ulong                  addr_cnt ) {
+  fd_alt_cache_entry_t * entry = fd_alt_cache_private_entry( cache, table );
+  ulong seq = entry->seq;
+  FD_VOLATILE( entry->seq ) = seq+1UL;
+  FD_COMPILER_MFENCE();
+  entry->key      = *table;
+  entry->addr_cnt = addr_cnt;
+  fd_memcpy( entry->addr, addr, addr_cnt*sizeof(fd_acct_addr_t) );
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( entry->seq ) = seq+2UL;
+}
+
+/* fd_alt_cache_resolve looks up the addresses at the idx_cnt indices
+   in idx of the table with address table and writes them to out, in
+   order.  Returns 1 on success and 0 if the table isn't cached or any
+   index is out of bounds for the cached contents.  On failure, the
+   contents of out are unspecified. */
+static inline int
+fd_alt_cache_resolve( fd_alt_cache_t const * cache,
+                      fd_acct_addr_t const * table,
+                      uchar const          * idx,
+                      ulong                  idx_cnt,
+                      fd_acct_addr_t       * out ) {
+  fd_alt_cache_entry_t const * entry = fd_alt_cache_private_entry( cache, table );
+  for(;;) {
+    ulong seq0 = FD_VOLATILE_CONST( entry->seq );
+    FD_COMPILER_MFENCE();
+    if( FD_UNLIKELY( seq0 & 1UL ) ) { FD_SPIN_PAUSE(); continue; }
+
+    ulong addr_cnt = fd_ulong_min( entry->addr_cnt, FD_ALT_CACHE_ADDR_MAX );
+    int   found    = !memcmp( entry->key.b, table->b, FD_TXN_ACCT_ADDR_SZ ) & (addr_cnt>0UL);
+    for( ulong i=0UL; found & (i<idx_cnt); i++ ) {
+      found = (ulong)idx[ i ]<addr_cnt;
+      if( FD_LIKELY( found ) ) out[ i ] = entry->addr[ idx[ i ] ];
+    }
+
+    FD_COMPILER_MFENCE();
+    if( FD_LIKELY( FD_VOLATILE_CONST( entry->seq )==seq0 ) ) return found;
+    FD_SPIN_PAUSE();
+  }
+}
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_pack_fd_alt_cache_h */
@@ -0,0 +1,199 @@
+#ifndef HEADER_fd_src_ballet_pack_fd_est_ftbl_h
+#define HEADER_fd_src_ballet_pack_fd_est_ftbl_h
+
+#include "../fd_ballet_base.h"
+#if FD_HAS_SSE
+#include "../../util/simd/fd_sse.h"
+#endif
+
+/* fd_est_ftbl is a variant of fd_est_tbl (see fd_est_tbl.h for the
+   estimator itself) with single precision bins so that each bin is 16
+   bytes.  That makes it possible to share one table between several
+   threads or processes, e.g. in a workspace, where many writers insert
+   values while readers query it, without any locks:
+
+     - Writers update a bin with a 16 byte compare-and-swap, retrying if
+       another writer changed the bin in the meantime.
+     - Readers load a bin with a single 16 byte aligned load, which is
+       atomic on x86 processors that support AVX.
+
+   So a reader always sees a bin as it was after some complete update.
+   Values from concurrent updates of the same bin are never lost, but
+   the order in which they are applied is unspecified, which doesn't
+   matter for an EMA.
+
+   On targets without a 16 byte compare-and-swap (see
+   FD_EST_FTBL_ATOMIC), updates are plain stores.  The table is then only
+   safe with one writer and readers that tolerate the occasional torn
+   bin.
+
+   Floats hold values up to about 3.4e38, so as with fd_est_tbl, values
+   up to UINT_MAX and histories of up to around 10^9 are safe.  The
+   precision of the mean and variance is about 6 significant digits,
+   which is plenty for an estimate. */
+
+#define FD_EST_FTBL_MAGIC (0xF17EDA2C37E5F7B0UL) /* F17E=FIRE,DA2C/37=DANCER,E5/F7B=ESFTB,0=V0 / FIREDANCER EST FTBL V0 */
+
+#define FD_EST_FTBL_ALIGN                   (32UL)
+#define FD_EST_FTBL_FOOTPRINT( bin_cnt ) ( sizeof(fd_est_ftbl_t) + ((bin_cnt)-1UL)*sizeof(fd_est_ftbl_bin_t) )
+
+/* FD_EST_FTBL_ATOMIC is 1 if updates are atomic and 0 if not */
+#if FD_HAS_X86 && FD_HAS_INT128 && FD_HAS_SSE && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+#define FD_EST_FTBL_ATOMIC 1
+#else
+#define FD_EST_FTBL_ATOMIC 0
+#endif
+
+/* Internal table bin structure.  The fields are as in fd_est_tbl_bin_t
+   but single precision. */
+union __attribute__((aligned(16))) fd_private_est_ftbl_bin {
+  struct {
+    float x;
+    float x2;
+    float d;
+    float d2;
+  };
+#if FD_HAS_INT128
+  uint128 u;
+#endif
+};
+typedef union fd_private_est_ftbl_bin fd_est_ftbl_bin_t;
+
+FD_STATIC_ASSERT( sizeof(fd_est_ftbl_bin_t)==16UL, fd_est_ftbl_bin );
+
+struct __attribute__((aligned(FD_EST_FTBL_ALIGN))) fd_private_est_ftbl {
+  /* magic: set to FD_EST_FTBL_MAGIC */
+  ulong  magic;
+  /* bin_cnt_mask: (bin_cnt_mask+1) is the number of bins in the table, a power
+     of two */
+  ulong  bin_cnt_mask;
+  /* ema_coeff: the decay coefficient used in EMA computations. Near 1.0. */
+  float  ema_coeff;
+  /* default_val: the value to return as mean when the query maps to a bin with
+     very few values */
+  float  default_val;
+  ulong  _pad;
+  /* 32 byte aligned at this point */
+  /* bins: the array of (bin_cnt_mask+1) bins follows.  The array size of 1 is
+     just convention. */
+  fd_est_ftbl_bin_t bins[1];
+};
+typedef struct fd_private_est_ftbl fd_est_ftbl_t;
+
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_est_ftbl_{align, footprint, new, join, leave, delete} behave
+   exactly like their fd_est_tbl counterparts.  The memory region can be
+   shared with other threads or processes; each should have its own
+   join. */
+
+FD_FN_CONST static inline ulong fd_est_ftbl_align    ( void ) { return FD_EST_FTBL_ALIGN; }
+FD_FN_CONST static inline ulong fd_est_ftbl_footprint( ulong bin_cnt ) {
+  if( FD_UNLIKELY( !bin_cnt || !fd_ulong_is_pow2( bin_cnt )                                   ) ) return 0UL;
+  if( FD_UNLIKELY(  bin_cnt > ((ULONG_MAX - sizeof(fd_est_ftbl_t))/sizeof(fd_est_ftbl_bin_t)) ) ) return 0UL;
+  return sizeof(fd_est_ftbl_t) + (bin_cnt-1UL)*sizeof(fd_est_ftbl_bin_t);
+}
+
+static inline void *
+fd_est_ftbl_new( void * mem,
+                 ulong  bin_cnt,
+                 ulong  history,
+                 uint   default_val ) {
+  if( FD_UNLIKELY( !bin_cnt || !fd_ulong_is_pow2( bin_cnt )                                   ) ) return NULL;
+  if( FD_UNLIKELY(  bin_cnt > ((ULONG_MAX - sizeof(fd_est_ftbl_t))/sizeof(fd_est_ftbl_bin_t)) ) ) return NULL;
+  if( FD_UNLIKELY( !history                                                                   ) ) return NULL;
+  fd_est_ftbl_t * tbl = (fd_est_ftbl_t *)mem;
+  tbl->bin_cnt_mask   = bin_cnt-1UL;
+  tbl->ema_coeff      = (float)(1.0 - 1.0/(double)history);
+  tbl->default_val    = (float)default_val;
+  tbl->_pad           = 0UL;
+
+  fd_memset( tbl->bins, 0, bin_cnt*sizeof(fd_est_ftbl_bin_t) );
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( tbl->magic ) = FD_EST_FTBL_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return (void *)tbl;
+}
+
+static inline fd_est_ftbl_t *
+fd_est_ftbl_join( void * _tbl ) {
+  fd_est_ftbl_t * tbl = (fd_est_ftbl_t *)_tbl;
+  if( FD_UNLIKELY( tbl->magic != FD_EST_FTBL_MAGIC ) ) return NULL;
+  return tbl;
+}
+static inline void * fd_est_ftbl_leave ( fd_est_ftbl_t * tbl ) { return (void *)tbl; }
+static inline void * fd_est_ftbl_delete( fd_est_ftbl_t * tbl ) {
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( tbl->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+  return (void *)tbl;
+}
+
+/* fd_est_ftbl_private_bin_load returns a snapshot of bin that is
+   consistent with some complete update. */
+static inline fd_est_ftbl_bin_t
+fd_est_ftbl_private_bin_load( fd_est_ftbl_bin_t const * bin ) {
+  fd_est_ftbl_bin_t snap;
+#if FD_HAS_SSE
+  vf_st( &snap.x, vf_ld( &bin->x ) );
+#else
+  snap = FD_VOLATILE_CONST( *bin );
+#endif
+  return snap;
+}
+
+/* fd_est_ftbl_estimate: estimate the mean and variance of the
+   distribution from which data tagged with tag is drawn, as
+   fd_est_tbl_estimate.  Safe to call concurrently with updates. */
+static inline float
+fd_est_ftbl_estimate( fd_est_ftbl_t const * tbl,
+                      ulong                 tag,
+                      float *               variance_out ) {
+  fd_est_ftbl_bin_t bin = fd_est_ftbl_private_bin_load( tbl->bins + (tag & tbl->bin_cnt_mask) );
+  float mean, var;
+  if( FD_UNLIKELY( !(bin.d > 0.0f) ) ) {
+    mean = tbl->default_val;
+    var  = 0.0f;
+  } else {
+    mean = bin.x / bin.d;
+    var  = (bin.d * bin.x2 - (bin.x*bin.x)) / ( bin.d * bin.d - bin.d2 );
+  }
+  var  = fd_float_if( var>0.0f, var, 0.0f );
+  if( FD_LIKELY( variance_out ) ) *variance_out = var;
+  return mean;
+}
+
+/* fd_est_ftbl_update: inserts a new tagged value into this data
+   structure.  Safe to call concurrently with other updates and with
+   estimates if FD_EST_FTBL_ATOMIC. */
+static inline void
+fd_est_ftbl_update( fd_est_ftbl_t * tbl,
+                    ulong           tag,
+                    uint            value ) {
+  fd_est_ftbl_bin_t * bin = tbl->bins + (tag & tbl->bin_cnt_mask);
+  float C = tbl->ema_coeff;
+  float v = (float)value;
+#if FD_EST_FTBL_ATOMIC
+  for(;;) {
+    fd_est_ftbl_bin_t old = fd_est_ftbl_private_bin_load( bin );
+    fd_est_ftbl_bin_t new;
+    new.x  = v   + fd_float_if( C*old.x >FLT_MIN, C*old.x , 0.0f );
+    new.x2 = v*v + fd_float_if( C*old.x2>FLT_MIN, C*old.x2, 0.0f );
+    new.d  = 1.0f +   C*old.d ; /* Can't go denormal */
+    new.d2 = 1.0f + C*C*old.d2; /* Can't go denormal */
+    if( FD_LIKELY( __sync_bool_compare_and_swap( &bin->u, old.u, new.u ) ) ) break;
+    FD_SPIN_PAUSE();
+  }
+#else
+  bin->x  = v    + fd_float_if( C*bin->x >FLT_MIN, C*bin->x , 0.0f );
+  bin->x2 = v*v  + fd_float_if( C*bin->x2>FLT_MIN, C*bin->x2, 0.0f );
+  bin->d  = 1.0f +   C*bin->d ; /* Can't go denormal */
+  bin->d2 = 1.0f + C*C*bin->d2; /* Can't go denormal */
+#endif
+}
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_pack_fd_est_ftbl_h */
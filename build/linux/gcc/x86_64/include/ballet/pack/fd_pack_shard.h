@@ -0,0 +1,363 @@
+#ifndef HEADER_fd_src_ballet_pack_fd_pack_shard_h
+#define HEADER_fd_src_ballet_pack_fd_pack_shard_h
+
+#include "../fd_ballet_base.h"
+#include "../txn/fd_txn.h"
+#include "fd_alt_cache.h"
+
+/* Sharded packing splits the work of one pack object between shard_cnt
+   pack objects (shards), typically each in its own tile with its own
+   bank tiles, plus a coordinator pack object for the transactions that
+   don't fit in one shard.
+
+   Each account belongs to one shard, by hash (see fd_pack_shard_of).
+   A transaction whose accounts all belong to the same shard goes to
+   that shard, and every other transaction goes to the coordinator (see
+   fd_pack_shard_route).  Since a shard only ever schedules transactions
+   that use its own accounts, shards can't conflict with each other, and
+   each only needs to track its own account locks.
+
+   Accounts that can never be written don't count: sysvars, which the
+   runtime never lets a transaction write, and accounts a transaction
+   invokes as a program.  Otherwise, every transaction would depend on
+   the shard of the programs it calls.  The exception is a transaction
+   that upgrades a program while another shard invokes it; the runtime
+   takes account locks of its own, so at worst one of them fails to
+   lock and is retried, which is no different from what happens when a
+   transaction is scheduled with an imprecise view of its accounts.
+
+   The coordinator only schedules while every shard is parked with no
+   outstanding microblock, so it can't conflict with them either.  That
+   is done with a barrier in the fd_pack_shard_ctl_t that they all
+   share:
+
+     - When the coordinator has something to schedule, it calls
+       fd_pack_shard_ctl_request.
+     - Before scheduling each microblock, each shard calls
+       fd_pack_shard_ctl_may_schedule, which parks the shard once it's
+       idle if the coordinator has asked, and tells it not to schedule.
+     - Once fd_pack_shard_ctl_quiesced returns 1, the coordinator
+       schedules its microblocks.  When they have all completed, it
+       calls fd_pack_shard_ctl_release and the shards resume.
+
+   Cross-shard transactions are expected to be a small fraction of the
+   total; each one costs a pipeline drain.
+
+   The shard ctl also holds the cost of the current block, for all the
+   pack objects together, so that the block limits are global (see
+   fd_pack_set_shard_ctl).  Each microblock reserves what it might use
+   up front and gives back what it didn't.  Each counter word carries a
+   generation number in the top FD_PACK_SHARD_GEN_BITS bits, bumped by
+   fd_pack_shard_ctl_new_block, so that what is given back after the
+   block ended isn't taken off the next one.
+
+   The per-account write cost limit can't be shared this way, since
+   accounts are tracked by each pack object separately.  Instead, it is
+   split: the coordinator gets FD_PACK_SHARD_COORD_WRITE_COST per
+   account and the shard that owns the account gets the rest. */
+
+#define FD_PACK_SHARD_CTL_MAGIC (0xF17EDA2C375BA7C0UL) /* F17E=FIRE,DA2C/37=DANCER,5BA7C=SHARDC,0=V0 / FIREDANCER SHARD CTL V0 */
+
+#define FD_PACK_SHARD_CTL_ALIGN     (128UL)
+#define FD_PACK_SHARD_CTL_FOOTPRINT (sizeof(fd_pack_shard_ctl_t))
+
+/* FD_PACK_SHARD_MAX is the maximum number of shards. */
+#define FD_PACK_SHARD_MAX (63UL)
+
+/* FD_PACK_SHARD_CROSS is returned by fd_pack_shard_route for a
+   transaction that uses accounts of more than one shard. */
+#define FD_PACK_SHARD_CROSS (ULONG_MAX)
+
+/* FD_PACK_SHARD_BUDGET_{BLOCK,VOTE} identify the block-wide cost
+   counters in a shard ctl: the cost of everything, and the cost of the
+   simple votes. */
+#define FD_PACK_SHARD_BUDGET_BLOCK (0UL)
+#define FD_PACK_SHARD_BUDGET_VOTE  (1UL)
+
+/* FD_PACK_SHARD_COORD_WRITE_COST is the part of the per-account write
+   cost limit that goes to the coordinator.  It must be at least the
+   cost of the most expensive transaction. */
+#define FD_PACK_SHARD_COORD_WRITE_COST (3000000UL)
+
+#define FD_PACK_SHARD_GEN_BITS  (16)
+#define FD_PACK_SHARD_COST_MASK ((1UL<<(64-FD_PACK_SHARD_GEN_BITS))-1UL)
+
+#define FD_PACK_SHARD_BARRIER_REQUESTED (1UL<<63)
+
+struct __attribute__((aligned(FD_PACK_SHARD_CTL_ALIGN))) fd_private_pack_shard_ctl_line {
+  ulong val;
+};
+typedef struct fd_private_pack_shard_ctl_line fd_pack_shard_ctl_line_t;
+
+struct __attribute__((aligned(FD_PACK_SHARD_CTL_ALIGN))) fd_private_pack_shard_ctl {
+  /* magic: set to FD_PACK_SHARD_CTL_MAGIC */
+  ulong magic;
+  ulong shard_cnt;
+
+  /* budget[ FD_PACK_SHARD_BUDGET_* ]: the generation in the high
+     FD_PACK_SHARD_GEN_BITS bits and the cost in cost units so far in
+     this block (including reservations) in the rest. */
+  fd_pack_shard_ctl_line_t budget[ 2 ];
+
+  /* barrier: FD_PACK_SHARD_BARRIER_REQUESTED if the coordinator asked
+     the shards to park, and bit i for i in [0, shard_cnt) if shard i
+     is parked.  Each is on its own cache line. */
+  fd_pack_shard_ctl_line_t barrier;
+};
+typedef struct fd_private_pack_shard_ctl fd_pack_shard_ctl_t;
+
+
+FD_PROTOTYPES_BEGIN
+
+FD_FN_CONST static inline ulong fd_pack_shard_ctl_align    ( void ) { return FD_PACK_SHARD_CTL_ALIGN;     }
+FD_FN_CONST static inline ulong fd_pack_shard_ctl_footprint( void ) { return FD_PACK_SHARD_CTL_FOOTPRINT; }
+
+/* fd_pack_shard_ctl_new formats mem, which must have the required
+   alignment and footprint, as a shard ctl for shard_cnt shards, with
+   no cost in the current block and no barrier.  Returns mem on success
+   and NULL if shard_cnt isn't in [1, FD_PACK_SHARD_MAX].  The memory
+   region can be shared with other threads or processes; each should
+   have its own join. */
+static inline void *
+fd_pack_shard_ctl_new( void * mem,
+                       ulong  shard_cnt ) {
+  if( FD_UNLIKELY( (shard_cnt==0UL) | (shard_cnt>FD_PACK_SHARD_MAX) ) ) return NULL;
+  fd_pack_shard_ctl_t * ctl = (fd_pack_shard_ctl_t *)mem;
+  ctl->shard_cnt = shard_cnt;
+  ctl->budget[ FD_PACK_SHARD_BUDGET_BLOCK ].val = 0UL;
+  ctl->budget[ FD_PACK_SHARD_BUDGET_VOTE  ].val = 0UL;
+  ctl->barrier.val = 0UL;
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( ctl->magic ) = FD_PACK_SHARD_CTL_MAGIC;
+  FD_COMPILER_MFENCE();
+  return mem;
+}
+
+static inline fd_pack_shard_ctl_t *
+fd_pack_shard_ctl_join( void * _ctl ) {
+  fd_pack_shard_ctl_t * ctl = (fd_pack_shard_ctl_t *)_ctl;
+  if( FD_UNLIKELY( ctl->magic != FD_PACK_SHARD_CTL_MAGIC ) ) return NULL;
+  return ctl;
+}
+static inline void * fd_pack_shard_ctl_leave ( fd_pack_shard_ctl_t * ctl ) { return (void *)ctl; }
+static inline void * fd_pack_shard_ctl_delete( fd_pack_shard_ctl_t * ctl ) {
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( ctl->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+  return (void *)ctl;
+}
+
+FD_FN_PURE static inline ulong fd_pack_shard_ctl_shard_cnt( fd_pack_shard_ctl_t const * ctl ) { return ctl->shard_cnt; }
+
+/* fd_pack_shard_ctl_private_cas is FD_ATOMIC_CAS, emulated (and not
+   atomic) on platforms without FD_HAS_ATOMIC, where shards can't run
+   concurrently anyway. */
+static inline ulong
+fd_pack_shard_ctl_private_cas( ulong * p,
+                               ulong   c,
+                               ulong   s ) {
+# if FD_HAS_ATOMIC
+  return FD_ATOMIC_CAS( p, c, s );
+# else
+  ulong o = FD_VOLATILE_CONST( *p );
+  if( o==c ) FD_VOLATILE( *p ) = s;
+  return o;
+# endif
+}
+
+/* fd_pack_shard_of returns the shard in [0, shard_cnt) that acct
+   belongs to.  It uses different bits of the hash than pack's own
+   tables do, so that the accounts of one shard still spread out over
+   those. */
+FD_FN_PURE static inline ulong
+fd_pack_shard_of( fd_acct_addr_t const * acct,
+                  ulong                  shard_cnt ) {
+  return (fd_ulong_hash( fd_ulong_load_8( acct->b ) )>>32) % shard_cnt;
+}
+
+/* fd_pack_shard_private_is_sysvar returns 1 if acct looks like the
+   address of a sysvar, all of which start with these bytes ("Sysvar"
+   in base58). */
+FD_FN_PURE static inline int
+fd_pack_shard_private_is_sysvar( fd_acct_addr_t const * acct ) {
+  return (acct->b[0]==0x06) & (acct->b[1]==0xa7) & (acct->b[2]==0xd5) & (acct->b[3]==0x17);
+}
+
+/* fd_pack_shard_private_is_invoked returns 1 if account idx of txn is
+   the program of one of its instructions. */
+FD_FN_PURE static inline int
+fd_pack_shard_private_is_invoked( fd_txn_t const * txn,
+                                  ulong            idx ) {
+  for( ulong i=0UL; i<(ulong)txn->instr_cnt; i++ ) if( (ulong)txn->instr[ i ].program_id==idx ) return 1;
+  return 0;
+}
+
+/* fd_pack_shard_route returns the shard in [0, shard_cnt) that the
+   transaction txn, with payload payload, should be inserted into, or
+   FD_PACK_SHARD_CROSS if it uses accounts of more than one shard and
+   should go to the coordinator.  Accounts loaded from address lookup
+   tables are resolved through alt_cache, which may be NULL, the same
+   way the pack objects do (see fd_pack_set_alt_cache); if they can't
+   be, the transaction goes to the coordinator. */
+static inline ulong
+fd_pack_shard_route( fd_txn_t             * txn,
+                     uchar const          * payload,
+                     fd_alt_cache_t const * alt_cache,
+                     ulong                  shard_cnt ) {
+  if( FD_UNLIKELY( shard_cnt==1UL ) ) return 0UL;
+
+  fd_acct_addr_t const * imm   = fd_txn_get_acct_addrs( txn, payload );
+  ulong                  shard = FD_PACK_SHARD_CROSS;
+  fd_txn_acct_iter_t     ctrl[1];
+  for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
+      i=fd_txn_acct_iter_next( i, ctrl ) ) {
+    ulong s = fd_pack_shard_of( imm+i, shard_cnt );
+    if( FD_UNLIKELY( (shard!=FD_PACK_SHARD_CROSS) & (s!=shard) ) ) return FD_PACK_SHARD_CROSS;
+    shard = s;
+  }
+  for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_READONLY & FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
+      i=fd_txn_acct_iter_next( i, ctrl ) ) {
+    if( fd_pack_shard_private_is_sysvar( imm+i ) || fd_pack_shard_private_is_invoked( txn, i ) ) continue;
+    ulong s = fd_pack_shard_of( imm+i, shard_cnt );
+    if( FD_UNLIKELY( (shard!=FD_PACK_SHARD_CROSS) & (s!=shard) ) ) return FD_PACK_SHARD_CROSS;
+    shard = s;
+  }
+
+  if( FD_UNLIKELY( txn->addr_table_lookup_cnt ) ) {
+    if( FD_UNLIKELY( !alt_cache ) ) return FD_PACK_SHARD_CROSS;
+    fd_txn_acct_addr_lut_t const * tables = fd_txn_get_address_tables( txn );
+    fd_acct_addr_t loaded[ FD_TXN_ACCT_ADDR_MAX ];
+    for( ulong i=0UL; i<(ulong)txn->addr_table_lookup_cnt; i++ ) {
+      fd_acct_addr_t const * table = (fd_acct_addr_t const *)(payload + tables[ i ].addr_off);
+      ulong w_cnt = (ulong)tables[ i ].writable_cnt;
+      ulong r_cnt = (ulong)tables[ i ].readonly_cnt;
+      if( FD_UNLIKELY( w_cnt+r_cnt>FD_TXN_ACCT_ADDR_MAX ) ) return FD_PACK_SHARD_CROSS;
+      if( FD_UNLIKELY( !fd_alt_cache_resolve( alt_cache, table, payload+tables[ i ].writable_off, w_cnt, loaded       ) ||
+                       !fd_alt_cache_resolve( alt_cache, table, payload+tables[ i ].readonly_off, r_cnt, loaded+w_cnt ) ) ) return FD_PACK_SHARD_CROSS;
+      for( ulong j=0UL; j<w_cnt+r_cnt; j++ ) {
+        if( (j>=w_cnt) && fd_pack_shard_private_is_sysvar( loaded+j ) ) continue;
+        ulong s = fd_pack_shard_of( loaded+j, shard_cnt );
+        if( FD_UNLIKELY( (shard!=FD_PACK_SHARD_CROSS) & (s!=shard) ) ) return FD_PACK_SHARD_CROSS;
+        shard = s;
+      }
+    }
+  }
+  /* Every transaction has a writable fee payer, so shard is set */
+  return shard;
+}
+
+/* fd_pack_shard_ctl_reserve takes up to want cost units from the
+   budget counter which (one of FD_PACK_SHARD_BUDGET_*) of ctl, without
+   going over limit.  Returns how many it took, possibly 0, and stores
+   the generation they were taken from at *gen, for
+   fd_pack_shard_ctl_unreserve. */
+static inline ulong
+fd_pack_shard_ctl_reserve( fd_pack_shard_ctl_t * ctl,
+                           ulong                 which,
+                           ulong                 limit,
+                           ulong                 want,
+                           ulong               * gen ) {
+  ulong * p = &ctl->budget[ which ].val;
+  for(;;) {
+    ulong w    = FD_VOLATILE_CONST( *p );
+    ulong used = w & FD_PACK_SHARD_COST_MASK;
+    ulong got  = fd_ulong_min( want, limit-fd_ulong_min( used, limit ) );
+    *gen = w & ~FD_PACK_SHARD_COST_MASK;
+    if( FD_UNLIKELY( !got ) ) return 0UL;
+    if( FD_LIKELY( fd_pack_shard_ctl_private_cas( p, w, w+got )==w ) ) return got;
+    FD_SPIN_PAUSE();
+  }
+}
+
+/* fd_pack_shard_ctl_unreserve gives back cus cost units that were
+   reserved from the budget counter which of ctl in generation gen but
+   not used.  If the block has ended since, they're already gone. */
+static inline void
+fd_pack_shard_ctl_unreserve( fd_pack_shard_ctl_t * ctl,
+                             ulong                 which,
+                             ulong                 gen,
+                             ulong                 cus ) {
+  if( !cus ) return;
+  ulong * p = &ctl->budget[ which ].val;
+  for(;;) {
+    ulong w = FD_VOLATILE_CONST( *p );
+    if( FD_UNLIKELY( (w & ~FD_PACK_SHARD_COST_MASK)!=gen ) ) return;
+    if( FD_LIKELY( fd_pack_shard_ctl_private_cas( p, w, w-cus )==w ) ) return;
+    FD_SPIN_PAUSE();
+  }
+}
+
+/* fd_pack_shard_ctl_new_block starts a new block with no cost so far.
+   Exactly one of the parties sharing ctl, e.g. the coordinator, should
+   call this at each block boundary, along with fd_pack_end_block on
+   each of the pack objects. */
+static inline void
+fd_pack_shard_ctl_new_block( fd_pack_shard_ctl_t * ctl ) {
+  for( ulong which=0UL; which<2UL; which++ ) {
+    ulong * p = &ctl->budget[ which ].val;
+    for(;;) {
+      ulong w = FD_VOLATILE_CONST( *p );
+      if( FD_LIKELY( fd_pack_shard_ctl_private_cas( p, w, (w & ~FD_PACK_SHARD_COST_MASK) + (FD_PACK_SHARD_COST_MASK+1UL) )==w ) ) break;
+      FD_SPIN_PAUSE();
+    }
+  }
+}
+
+/* fd_pack_shard_ctl_used returns the cost so far in the current block
+   in the budget counter which of ctl, including outstanding
+   reservations. */
+static inline ulong
+fd_pack_shard_ctl_used( fd_pack_shard_ctl_t const * ctl,
+                        ulong                       which ) {
+  return FD_VOLATILE_CONST( ctl->budget[ which ].val ) & FD_PACK_SHARD_COST_MASK;
+}
+
+/* fd_pack_shard_ctl_may_schedule returns 1 if shard shard_idx may
+   schedule a microblock now.  If the coordinator has requested the
+   barrier, returns 0, and if idle is non-zero, i.e. the shard has no
+   outstanding microblocks, marks the shard as parked. */
+static inline int
+fd_pack_shard_ctl_may_schedule( fd_pack_shard_ctl_t * ctl,
+                                ulong                 shard_idx,
+                                int                   idle ) {
+  ulong * p   = &ctl->barrier.val;
+  ulong   bit = 1UL<<shard_idx;
+  for(;;) {
+    ulong w = FD_VOLATILE_CONST( *p );
+    if( FD_LIKELY( !(w & FD_PACK_SHARD_BARRIER_REQUESTED) ) ) return 1;
+    if( (!idle) | !!(w & bit) ) return 0;
+    if( FD_LIKELY( fd_pack_shard_ctl_private_cas( p, w, w|bit )==w ) ) return 0;
+    FD_SPIN_PAUSE();
+  }
+}
+
+/* fd_pack_shard_ctl_{request,quiesced,release} are for the
+   coordinator.  request asks the shards to park.  quiesced returns 1
+   once they all have, after which the coordinator can schedule until
+   it calls release, which lets the shards resume. */
+static inline void
+fd_pack_shard_ctl_request( fd_pack_shard_ctl_t * ctl ) {
+  ulong * p = &ctl->barrier.val;
+  for(;;) {
+    ulong w = FD_VOLATILE_CONST( *p );
+    if( FD_LIKELY( fd_pack_shard_ctl_private_cas( p, w, w|FD_PACK_SHARD_BARRIER_REQUESTED )==w ) ) return;
+    FD_SPIN_PAUSE();
+  }
+}
+
+static inline int
+fd_pack_shard_ctl_quiesced( fd_pack_shard_ctl_t const * ctl ) {
+  ulong all = FD_PACK_SHARD_BARRIER_REQUESTED | ((1UL<<ctl->shard_cnt)-1UL);
+  return FD_VOLATILE_CONST( ctl->barrier.val )==all;
+}
+
+static inline void
+fd_pack_shard_ctl_release( fd_pack_shard_ctl_t * ctl ) {
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( ctl->barrier.val ) = 0UL;
+  FD_COMPILER_MFENCE();
+}
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_pack_fd_pack_shard_h */
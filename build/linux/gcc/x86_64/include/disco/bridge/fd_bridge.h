@@ -0,0 +1,145 @@
+#ifndef HEADER_fd_src_disco_bridge_fd_bridge_h
+#define HEADER_fd_src_disco_bridge_fd_bridge_h
+
+/* fd_bridge provides services to move a stream of frags from an
+   mcache / dcache pair on one NUMA node into an mcache / dcache pair on
+   another NUMA node.  Unlike fd_mux, this copies the frag payloads.
+   The point is to pay for the cross-interconnect reads once, in a
+   single tile that can hide their latency (by prefetching ahead of the
+   copy and batching), instead of in every downstream consumer on the
+   far node (where they show up as stalls on the critical path). */
+
+#include "../fd_disco_base.h"
+
+/* Beyond the standard FD_CNC_SIGNAL_HALT, FD_BRIDGE_CNC_SIGNAL_ACK can
+   be raised by a cnc thread with an open command session while the
+   bridge is in the RUN state.  The bridge will transition from ACK->RUN
+   the next time it processes cnc signals to indicate it is running
+   normally.  If a signal other than ACK, HALT, or RUN is raised, it
+   will be logged as unexpected and transitioned by back to RUN. */
+
+#define FD_BRIDGE_CNC_SIGNAL_ACK (4UL)
+
+/* FD_BRIDGE_TILE_OUT_MAX is the maximum number of reliable outs a
+   bridge tile can have.  This is more or less arbitrary from a
+   functional correctness POV (it matches FD_MUX_TILE_OUT_MAX). */
+
+#define FD_BRIDGE_TILE_OUT_MAX FD_FRAG_META_ORIG_MAX
+
+/* FD_BRIDGE_TILE_BATCH_MAX is the maximum number of frags the bridge
+   will gather from its in before copying their payloads and publishing
+   them to its outs.  All payloads of a batch are prefetched before any
+   of them are copied.  The default is large enough to cover the latency
+   of a remote NUMA read with typical transaction sized frags without
+   overflowing the L1 cache. */
+
+#define FD_BRIDGE_TILE_BATCH_MAX (16UL)
+
+/* FD_BRIDGE_TILE_SCRATCH_{ALIGN,FOOTPRINT} specify the alignment and
+   footprint needed for a bridge tile scratch region that can support
+   out_cnt outputs.  ALIGN is an integer power of 2 of at least double
+   cache line to mitigate various kinds of false sharing.  FOOTPRINT
+   will be an integer multiple of ALIGN.  out_cnt is assumed to be valid
+   (i.e. at most FD_BRIDGE_TILE_OUT_MAX) and safe against multiple
+   evaluation.  These are provided to facilitate compile time
+   declarations. */
+
+#define FD_BRIDGE_TILE_SCRATCH_ALIGN (128UL)
+#define FD_BRIDGE_TILE_SCRATCH_FOOTPRINT( out_cnt )                           \
+  FD_LAYOUT_FINI( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND(       \
+  FD_LAYOUT_APPEND( FD_LAYOUT_INIT,                                           \
+    alignof(ulong *), (out_cnt)*sizeof(ulong *)             ),                \
+    alignof(ulong *), (out_cnt)*sizeof(ulong *)             ),                \
+    alignof(ulong),   (out_cnt)*sizeof(ulong)               ),                \
+    alignof(ushort),  ((out_cnt)+2UL)*sizeof(ushort)        ),                \
+    FD_BRIDGE_TILE_SCRATCH_ALIGN )
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_bridge_tile republishes the frag stream in in_mcache / in_dcache
+   into mcache / dcache for out_cnt reliable consumers and an arbitrary
+   number of unreliable consumers.  The bridge is a reliable consumer
+   of in_mcache.
+
+   Frags are republished in order.  The sig, sz, ctl (including
+   ctl.orig and the SOM / EOM / ERR bits, such that multiple frag
+   messages pass through unchanged) and tsorig of a frag are unchanged.
+   seq is resequenced into mcache's sequence space, chunk is the
+   location of the copy in dcache and tspub is recomputed when the copy
+   is published.  Frags whose sz is larger than mtu or whose payload is
+   not within in_dcache's data region are filtered (this indicates a
+   misconfiguration upstream; such frags are counted in the in fseq's
+   FD_FSEQ_DIAG_FILT_{CNT,SZ}).
+
+   Chunks are relative to the workspace containing the dcache on both
+   sides (i.e. in frag chunks are resolved relative to
+   fd_wksp_containing( in_dcache ) and out frag chunks are relative to
+   fd_wksp_containing( dcache )), as is typical for the application.
+   mtu is the largest frag the bridge will copy and dcache should have a
+   data region of at least
+   fd_dcache_req_data_sz( mtu, fd_mcache_depth( mcache ), 1, 1 ) bytes.
+
+   For the intended usage, the tile should run on a core on the NUMA
+   node of mcache / dcache (i.e. the consumer's node) and mcache /
+   dcache / fseqs / cnc / scratch should all be local to that node.  The
+   bridge then does all the remote reads, up to
+   FD_BRIDGE_TILE_BATCH_MAX frags at a time with all of a batch's
+   payloads prefetched before any are copied.  Payloads are written with
+   non-temporal stores (when the target supports them) such that the
+   copy does not evict the bridge's working set and the payloads go
+   straight to the memory the consumers will read them from.
+
+   The bridge returns flow control credits to the in as soon as a frag
+   has been copied (the in's payloads are never exposed downstream), so
+   a slow out backpressures the in only once the bridge itself is out of
+   credits.
+
+   cr_max is the maximum number of flow control credits the bridge is
+   allowed for publishing frags to outs.  It must be in
+   [1,fd_mcache_depth( mcache )] and 0 indicates to use
+   fd_mcache_depth( mcache ).  lazy is the ballpark interval in ns for
+   how often to receive credits from an out (and, equivalently, how
+   often to return credits to the in).  <=0 indicates to pick a
+   conservative default.  See fd_mux_tile for more details on both.
+
+   scratch points to tile scratch memory.  fd_bridge_tile_scratch_align
+   and fd_bridge_tile_scratch_footprint return the required alignment
+   and footprint needed for this region.  This memory region is
+   exclusively owned by the bridge tile while the tile is running.  If
+   out_cnt is not valid, fd_bridge_tile_scratch_footprint silently
+   returns 0 so callers can diagnose configuration issues.  Otherwise,
+   fd_bridge_tile_scratch_footprint will return the same value as
+   FD_BRIDGE_TILE_SCRATCH_FOOTPRINT.
+
+   When this is called, the cnc should be in the BOOT state.  Returns 0
+   on a successful run of the bridge tile (booted, ran and halted
+   successfully, as in fd_mux_tile) and non-zero if the tile failed to
+   boot (logs details).  Diagnostics are accumulated in the cnc and
+   fseq application regions in the standard ways.  The lifetime and
+   exclusive use requirements for cnc, mcaches, dcaches, fseqs, rng and
+   scratch are the same as fd_mux_tile. */
+
+FD_FN_CONST ulong
+fd_bridge_tile_scratch_align( void );
+
+FD_FN_CONST ulong
+fd_bridge_tile_scratch_footprint( ulong out_cnt );
+
+int
+fd_bridge_tile( fd_cnc_t *             cnc,       /* Local join to the bridge's command-and-control */
+                fd_frag_meta_t const * in_mcache, /* Local join to the in's mcache */
+                uchar const *          in_dcache, /* Local join to the in's dcache */
+                ulong *                in_fseq,   /* Local join to the in's fseq */
+                fd_frag_meta_t *       mcache,    /* Local join to the bridge's frag stream output mcache */
+                uchar *                dcache,    /* Local join to the bridge's frag stream output dcache */
+                ulong                  mtu,       /* Largest frag the bridge will copy */
+                ulong                  out_cnt,   /* Number of reliable consumers, reliable consumers are indexed [0,out_cnt) */
+                ulong **               out_fseq,  /* out_fseq[out_idx] is the local join to reliable consumer out_idx's fseq */
+                ulong                  cr_max,    /* Maximum number of flow control credits, 0 means use a reasonable default */
+                long                   lazy,      /* Lazyiness, <=0 means use a reasonable default */
+                fd_rng_t *             rng,       /* Local join to the rng this bridge should use */
+                void *                 scratch ); /* Tile scratch memory */
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_disco_bridge_fd_bridge_h */
@@ -0,0 +1,14 @@
+#ifndef HEADER_fd_src_disco_fd_disco_base_h
+#define HEADER_fd_src_disco_fd_disco_base_h
+
+#include "../tango/fd_tango.h"
+
+//FD_PROTOTYPES_BEGIN
+
+/* This is currently just a stub in anticipation of future common tile
+   functionality */
+
+//FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_disco_fd_disco_base_h */
+
@@ -0,0 +1,438 @@
+#ifndef HEADER_fd_src_tango_dcache_fd_dcache_h
+#define HEADER_fd_src_tango_dcache_fd_dcache_h
+
+#include "../fd_tango_base.h"
+
+/* FD_DCACHE_{ALIGN,FOOTPRINT} specify the alignment and footprint
+   needed for a dcache with a data region of data_sz bytes and an
+   application region of app_sz bytes.  ALIGN is at least FD_CHUNK_ALIGN
+   and recommended to be at least double cache line to mitigate various
+   kinds of false sharing.  data_sz and app_sz are assumed to be valid
+   (e.g. will not require a footprint larger than ULONG_MAX).  These are
+   provided to facilitate compile time dcache declarations. */
+
+#define FD_DCACHE_ALIGN (128UL)
+#define FD_DCACHE_FOOTPRINT( data_sz, app_sz )                                                            \
+  FD_LAYOUT_FINI( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_INIT, \
+    FD_DCACHE_ALIGN, 128UL                     ), /* hdr   */                                             \
+    FD_DCACHE_ALIGN, FD_DCACHE_GUARD_FOOTPRINT ), /* guard */                                             \
+    FD_DCACHE_ALIGN, (data_sz)                 ), /* data  */                                             \
+    FD_DCACHE_ALIGN, (app_sz)                  ), /* app   */                                             \
+    FD_DCACHE_ALIGN )
+
+/* FD_DCACHE_GUARD_FOOTPRINT specify the footprint of the guard region
+   immediately before the dcache data region.  The guard region
+   footprint is FD_DCACHE_ALIGN aligned and a FD_DCACHE_ALIGN multiple.
+   It provides flexibility (up to the magnitude of the footprint) to
+   align how a producer might write directly into a dcache such that the
+   frag payload alignment a consumer sees is consistent regardless of
+   the details of the underlying producer. */
+
+#define FD_DCACHE_GUARD_FOOTPRINT (128UL)
+
+/* FD_DCACHE_SLOT_FOOTPRINT returns the footprint of a FD_DCACHE_ALIGN
+   aligned slot sufficient to hold a frag payload of up to mtu bytes.
+   Returns 0 if mtu is not valid (i.e. so large that the required slot
+   size is larger than ULONG_MAX). */
+
+#define FD_DCACHE_SLOT_FOOTPRINT( mtu ) FD_ULONG_ALIGN_UP( (mtu), FD_DCACHE_ALIGN )
+
+/* FD_DCACHE_REQ_DATA_SZ returns the size of a data region in bytes
+   sufficient for a dcache whose producer writes frag payloads up to mtu
+   (should be positive) bytes in size, that can have up to depth (should
+   be positive) frag payloads visible to consumers while the producer
+   can be concurrently preparing up to burst (should be positive) frag
+   payloads.  Assumes mtu, depth, burst and compact are valid and
+   payload footprints are rounded up to at most a FD_DCACHE_ALIGN
+   multiple when written by a producer.  Note that payloads written by a
+   producer will generally be at least FD_DCACHE_ALIGN aligned to
+   facilitate interoperability with fd_frag_meta_t chunk indexing.  Also
+   note that for a compactly stored ring, it is usually not useful to
+   use a burst larger than 1 (but not particularly harmful outside
+   resulting a data region larger than necessary ... might use it to
+   quasi-batch publish frags). */
+
+#define FD_DCACHE_REQ_DATA_SZ( mtu, depth, burst, compact ) (FD_DCACHE_SLOT_FOOTPRINT( mtu )*((depth)+(burst)+(ulong)!!(compact)))
+
+FD_PROTOTYPES_BEGIN
+
+/* Construction API */
+
+/* fd_dcache_req_data_sz is the same as FD_DCACHE_REQ_DATA_SZ but does
+   not assume valid arguments.  Returns sz on success or 0 on failure.
+   Reasons for failure include zero mtu, too large mtu, zero depth, zero
+   burst or the required data_sz would be larger than ULONG_MAX. */
+
+FD_FN_CONST ulong
+fd_dcache_req_data_sz( ulong mtu,
+                       ulong depth,
+                       ulong burst,
+                       int   compact );
+
+/* fd_dcache_{align,footprint} return the required alignment and
+   footprint of a memory region suitable for use as dcache with a data
+   region of data_sz bytes and an application region of app_sz bytes.
+   align returns FD_DCACHE_ALIGN.  If data_sz or app_sz are invalid
+   (e.g. the required footprint is larger than a ULONG_MAX), footprint
+   will silently return 0 (and thus can be used by the caller to
+   validate dcache configuration parameters).  Zero is valid for data_sz
+   and/or app_sz. */
+
+FD_FN_CONST ulong
+fd_dcache_align( void );
+
+FD_FN_CONST ulong
+fd_dcache_footprint( ulong data_sz,
+                     ulong app_sz );
+
+/* fd_dcache_new formats an unused memory region for use as a dcache.
+   shmem is a non-NULL pointer to this region in the local address space
+   with the required footprint and alignment.  The size of the dcache
+   data size region is data_sz bytes and the size of the application
+   region is app_sz bytes.  Zero is valid for data_sz and/or app_sz.
+
+   Returns shmem (and the memory region it points to will be formatted
+   as a dcache with the data and application regions initialized to
+   zero, caller is not joined) on success and NULL on failure (logs
+   details).  Reasons for failure include obviously bad shmem, bad
+   data_sz or bad app_sz. */
+
+void *
+fd_dcache_new( void * shmem,
+               ulong  data_sz,
+               ulong  app_sz );
+
+/* fd_dcache_join joins the caller to the dcache.  shdcache points to
+   the first byte of the memory region backing the dcache in the
+   caller's address space.
+
+   Returns a pointer in the local address space to the dcache's data
+   region on success (IMPORTANT! THIS IS NOT JUST A CAST OF SHDCACHE)
+   and NULL on failure (logs details).  Reasons for failure are that
+   shdcache is obviously not a pointer to memory region holding a
+   dcache.  Every successful join should have a matching leave.  The
+   lifetime of the join is until the matching leave or the thread group
+   is terminated.
+
+   This region will have a guard region of FD_DCACHE_GUARD_FOOTPRINT
+   just before it and data_sz bytes available after it. */
+
+uchar *
+fd_dcache_join( void * shdcache );
+
+/* fd_dcache_leave leaves a current local join.  Returns a pointer to
+   the underlying shared memory region on success (IMPORTANT!  THIS IS
+   NOT JUST A CAST OF DCACHE) and NULL on failure (logs details).
+   Reasons for failure include dcache is NULL. */
+
+void *
+fd_dcache_leave( uchar const * dcache );
+
+/* fd_dcache_delete unformats a memory region used as a dcache.  Assumes
+   nobody is joined to the region.  Returns a pointer to the underlying
+   shared memory region or NULL if used obviously in error (e.g.
+   shdcache is obviously not a dcache ...  logs details).  The ownership
+   of the memory region is transferred to the caller. */
+
+void *
+fd_dcache_delete( void * shdcache );
+
+/* Accessor API */
+
+/* fd_dcache_{data_sz,app_sz} return the sizes of the {data,app}
+   regions.  Assumes dcache is a current local join. */
+
+FD_FN_PURE ulong fd_dcache_data_sz( uchar const * dcache );
+FD_FN_PURE ulong fd_dcache_app_sz ( uchar const * dcache );
+
+/* fd_dcache_app_laddr returns location in the caller's local address
+   space of memory set aside for application specific usage.  Assumes
+   dcache is a current local join.  The lifetime of the returned pointer
+   is the same as the underlying join.  This region has FD_DCACHE_ALIGN
+   alignment (double cache line) and is fd_cache_app_sz( dcache ) in
+   size.  laddr_const is a const-correct version. */
+
+FD_FN_PURE uchar const * fd_dcache_app_laddr_const( uchar const * dcache );
+FD_FN_PURE uchar *       fd_dcache_app_laddr      ( uchar *       dcache );
+
+/* fd_dcache_compact_is_safe return whether the dcache can safely store
+   frags in compactly quasi ring like as described in
+   fd_dcache_chunk_next below.
+
+   Chunks are indexed relative to base (e.g. the wksp containing the
+   dcache to facilitate multiple dcaches written by multiple producers
+   concurrently in the same wksp using a common chunk indexing scheme at
+   consumers ... base==dcache is fine and implies chunks in this dcache
+   region will be indexed starting from zero).
+
+   base and dcache should be double chunk aligned, dcache should be
+   current local join, base and dcache should be relatively spaced
+   identically between different thread groups that might use the chunk
+   indices and sufficiently close in the local address space that the
+   all data region chunk addresses can be losslessly compressed and
+   shared via a 32-bit fd_frag_meta_t chunk field.
+
+   mtu is the maximum frag that a producer might write into this dcache.
+   It is assumed that the producer will round up the footprint of frags
+   into the dcache into double chunk aligned boundaries.
+
+   depth is the maximum number of frags that might be concurrently
+   accessing frags in this dcache.
+
+   Returns 1 if the dcache is safe and 0 if not (with details logged). */
+
+int
+fd_dcache_compact_is_safe( void const * base,
+                           void const * dcache,
+                           ulong        mtu,
+                           ulong        depth );
+
+/* fd_dcache_compact_{chunk0,chunk1,wmark} returns the range of chunk indices
+   [chunk0,chunk1) that relative to the base address covered by the
+   dcache's data region and watermark chunk index for use by
+   fd_dcache_compact_chunk_next below.
+   0<=chunk0<=wmark<=chunk1<=UINT_MAX.  These assume dcache is current
+   local join and the base / dcache pass fd_dcache_is_compact_safe
+   above. */
+
+FD_FN_CONST static inline ulong
+fd_dcache_compact_chunk0( void const * base,
+                          void const * dcache ) {
+  return ((ulong)dcache - (ulong)base) >> FD_CHUNK_LG_SZ;
+}
+
+FD_FN_PURE static inline ulong
+fd_dcache_compact_chunk1( void const * base,
+                          void const * dcache ) {
+  return ((ulong)dcache + fd_dcache_data_sz( (uchar const *)dcache ) - (ulong)base) >> FD_CHUNK_LG_SZ;
+}
+
+FD_FN_PURE static inline ulong
+fd_dcache_compact_wmark( void const * base,
+                         void const * dcache,
+                         ulong        mtu ) {
+  ulong chunk_mtu = ((mtu + 2UL*FD_CHUNK_SZ-1UL) >> (1+FD_CHUNK_LG_SZ)) << 1;
+  return fd_dcache_compact_chunk1( base, dcache ) - chunk_mtu;
+}
+
+/* fd_dcache_compact_chunk_next:
+
+   Let a dcache have space for at least chunk_mtu*(depth+2)-1 chunks
+   where chunks are indexed [chunk0,chunk1) and chunk_mtu is a
+   sufficient number of chunks to hold the worst case frag size.
+   Further, let the dcache's producer write frags into the dcache at
+   chunk aligned positions with a footprint of at most chunk_mtu chunks
+   (with one exception noted below).  Lastly, let the producer write
+   frags contiguously into the dcache such that consumers do not need to
+   do any special handling for frags that wrap around the end of the
+   dcache.
+
+   Since the producer does not necessarily know the size of a frag as it
+   is producing it but does know a priori the maximum size of a frag it
+   might produce, the producer can achieve this by making the first
+   chunk of any frag it writes in:
+
+     [chunk0,wmark]
+
+   where:
+
+     wmark = chunk1 - chunk_mtu
+
+   This is equivalent to saying that, if there are at least chunk_mtu
+   chunks until the end of a dcache after a frag, that frag's footprint
+   will be enough contiguous chunks to cover the frag (up to chunk_mtu).
+   But if there there are less than chunk_mtu chunks, that frag's
+   footprint will be until the end of the dcache.
+
+   This implies, in the worst case, there at least depth+1 chunk_mtu
+   footprint frags (those not near the end) and 1 frag with a
+   2*chunk_mtu-1 footprint (the one frag nearest the dcache end) in the
+   dcache.  depth of these are exposed to consumers and 1 in prepration
+   by the producer.  It also implies that the set of chunks in the
+   dcache in use is cyclically contiguous starting from the oldest
+   consumer exposed frag until the currently exposed frag.
+
+   Noting that the act of publishing in the in preparation frag also
+   unpublishes the oldest exposed frag.  Given the above, this
+   guarantees that there is at least chunk_mtu contiguous space
+   available for use by the next frag so long as chunk_mtu is large
+   enough to cover the worst case frag and the dcache has room at least
+   for chunk_mtu*(depth+2)-1 chunks. */
+
+FD_FN_CONST static inline ulong         /* Will be in [chunk0,wmark] */
+fd_dcache_compact_next( ulong chunk,    /* Assumed in [chunk0,wmark] */
+                        ulong sz,       /* Assumed in [0,mtu] */
+                        ulong chunk0,   /* From fd_dcache_compact_chunk0 */
+                        ulong wmark ) { /* From fd_dcache_compact_wmark */
+  chunk += ((sz+(2UL*FD_CHUNK_SZ-1UL)) >> (1+FD_CHUNK_LG_SZ)) << 1; /* Advance to next chunk pair, no overflow if init passed */
+  return fd_ulong_if( chunk>wmark, chunk0, chunk );                 /* If that goes over the high water mark, wrap to zero */
+}
+
+/* Multi-frag messages:
+
+   A message larger than a single frag can carry (fd_frag_meta_t sz is
+   16 bits) can be sent as a run of consecutive frags whose payloads are
+   stored contiguously in a compact dcache.  The first frag of the
+   message has its SOM bit set, the last its EOM bit set (a message that
+   fits in one frag has both set).  Every frag but the last has exactly
+   frag_mtu bytes, where frag_mtu is a positive multiple of
+   2*FD_CHUNK_SZ no larger than FD_DCACHE_MSG_FRAG_MTU_MAX, so that frag
+   i of a message starting at chunk is at chunk + i*frag_mtu/FD_CHUNK_SZ.
+
+   The producer reserves room for a whole message exactly as it would a
+   single frag, just with the message mtu in place of the frag mtu:
+   the dcache is sized with FD_DCACHE_REQ_DATA_SZ( msg_mtu, depth, 1, 1 ),
+   the watermark is fd_dcache_compact_wmark( base, dcache, msg_mtu ), the
+   message payload is written starting at chunk and the next message
+   starts at fd_dcache_compact_next( chunk, msg_sz, chunk0, wmark ).
+   This is safe because each message uses at least one of the depth
+   mcache lines.  The frag metadata for a message is then given by
+   fd_dcache_msg_frag_meta and can be published with a single
+   fd_mcache_publish_burst.
+
+   A consumer feeds each frag it receives to fd_dcache_msg_append, which
+   checks that the frags of a message are sequential and contiguous.
+   When the EOM frag arrives, the whole message can be read in place at
+   fd_dcache_msg_laddr_const without any copying.  As for single frags,
+   the producer may have overwritten the payload by the time the
+   consumer is done with it.  The payload was intact if the SOM frag was
+   not overrun when the consumer finished, i.e. if
+   fd_mcache_query( mcache, depth, msg->seq0 ) still returns msg->seq0
+   (the producer cannot reuse the message's chunks until depth more
+   frags have been published after the SOM frag). */
+
+#define FD_DCACHE_MSG_FRAG_MTU_MAX (65408UL) /* Largest multiple of 2*FD_CHUNK_SZ that fits in 16 bits */
+
+/* FD_DCACHE_MSG_* give the possible return values of
+   fd_dcache_msg_append.  The error codes are negative; on error, any
+   message being reassembled is discarded. */
+
+#define FD_DCACHE_MSG_CONT        ( 0) /* Frag accepted, more frags needed to complete the message */
+#define FD_DCACHE_MSG_DONE        ( 1) /* Frag accepted, message complete */
+#define FD_DCACHE_MSG_ERR_ORPHAN  (-1) /* Frag is not SOM but no message is being reassembled */
+#define FD_DCACHE_MSG_ERR_SEQ     (-2) /* Frag does not immediately follow the previous frag of the message (overrun) */
+#define FD_DCACHE_MSG_ERR_LAYOUT  (-3) /* Frag payload does not immediately follow the previous frag's payload */
+#define FD_DCACHE_MSG_ERR_FRAG    (-4) /* Frag has its ERR bit set */
+
+/* fd_dcache_msg_t is the consumer side reassembly state for a
+   multi-frag message.  It only records where the message is; the
+   payload itself is never copied. */
+
+struct fd_dcache_msg {
+  ulong seq0;     /* Sequence number of the message's SOM frag */
+  ulong seq;      /* Sequence number of the next frag expected */
+  ulong chunk;    /* Chunk of the message's SOM frag (i.e. the start of the message payload) */
+  ulong sz;       /* Bytes of payload reassembled so far */
+  ulong frag_cnt; /* Number of frags reassembled so far */
+  int   active;   /* 1 if a message is being reassembled (SOM seen but not EOM) */
+};
+
+typedef struct fd_dcache_msg fd_dcache_msg_t;
+
+/* fd_dcache_msg_frag_cnt returns the number of frags needed to send a
+   msg_sz byte message in frags of at most frag_mtu bytes.  This is at
+   least 1 (a zero byte message is a single zero byte frag).  frag_mtu
+   is assumed valid as described above. */
+
+FD_FN_CONST static inline ulong
+fd_dcache_msg_frag_cnt( ulong msg_sz,
+                        ulong frag_mtu ) {
+  return fd_ulong_max( (msg_sz + frag_mtu - 1UL) / frag_mtu, 1UL );
+}
+
+/* fd_dcache_msg_frag_meta fills in meta[i] for i in [0,frag_cnt) with
+   the metadata for the frags of a msg_sz byte message whose payload
+   starts at chunk and returns frag_cnt, where frag_cnt is
+   fd_dcache_msg_frag_cnt( msg_sz, frag_mtu ).  meta should have room
+   for at least that many entries.  Every frag gets the same sig, orig,
+   tsorig and tspub.  meta[i].seq is set to zero (fd_mcache_publish_burst
+   ignores it). */
+
+static inline ulong
+fd_dcache_msg_frag_meta( fd_frag_meta_t * meta,
+                         ulong            chunk,    /* Assumed in [chunk0,wmark] */
+                         ulong            msg_sz,   /* Assumed in [0,msg_mtu] */
+                         ulong            frag_mtu, /* Assumed valid */
+                         ulong            sig,
+                         ulong            orig,
+                         ulong            tsorig,
+                         ulong            tspub ) {
+  ulong frag_cnt   = fd_dcache_msg_frag_cnt( msg_sz, frag_mtu );
+  ulong chunk_frag = frag_mtu >> FD_CHUNK_LG_SZ;
+  for( ulong i=0UL; i<frag_cnt; i++ ) {
+    int eom = (i==frag_cnt-1UL);
+    meta[i].seq    = 0UL;
+    meta[i].sig    = sig;
+    meta[i].chunk  = (uint)(chunk + i*chunk_frag);
+    meta[i].sz     = (ushort)fd_ulong_if( eom, msg_sz - i*frag_mtu, frag_mtu );
+    meta[i].ctl    = (ushort)fd_frag_meta_ctl( orig, i==0UL, eom, 0 );
+    meta[i].tsorig = (uint)tsorig;
+    meta[i].tspub  = (uint)tspub;
+  }
+  return frag_cnt;
+}
+
+/* fd_dcache_msg_reset discards any message being reassembled by msg.
+   Also used to initialize msg.  Returns msg. */
+
+static inline fd_dcache_msg_t *
+fd_dcache_msg_reset( fd_dcache_msg_t * msg ) {
+  msg->seq0     = 0UL;
+  msg->seq      = 0UL;
+  msg->chunk    = 0UL;
+  msg->sz       = 0UL;
+  msg->frag_cnt = 0UL;
+  msg->active   = 0;
+  return msg;
+}
+
+/* fd_dcache_msg_append adds the frag with sequence number seq and
+   metadata chunk, sz and ctl to the message being reassembled by msg.
+   Returns FD_DCACHE_MSG_DONE if this frag completed a message (msg
+   then describes the complete message until the next call),
+   FD_DCACHE_MSG_CONT if more frags are needed and a negative
+   FD_DCACHE_MSG_ERR_* code if the frag could not be used (msg is then
+   reset).  A SOM frag always starts a new message, discarding any
+   incomplete one. */
+
+static inline int
+fd_dcache_msg_append( fd_dcache_msg_t * msg,
+                      ulong             seq,
+                      ulong             chunk,
+                      ulong             sz,
+                      ulong             ctl ) {
+  if( fd_frag_meta_ctl_som( ctl ) ) {
+    msg->seq0     = seq;
+    msg->chunk    = chunk;
+    msg->sz       = 0UL;
+    msg->frag_cnt = 0UL;
+  } else {
+    if( FD_UNLIKELY( !msg->active ) ) { fd_dcache_msg_reset( msg ); return FD_DCACHE_MSG_ERR_ORPHAN; }
+    if( FD_UNLIKELY( fd_seq_ne( seq, msg->seq ) ) ) { fd_dcache_msg_reset( msg ); return FD_DCACHE_MSG_ERR_SEQ; }
+    if( FD_UNLIKELY( (!fd_ulong_is_aligned( msg->sz, 2UL*FD_CHUNK_SZ )) |
+                     (chunk!=msg->chunk + (msg->sz >> FD_CHUNK_LG_SZ)) ) ) { fd_dcache_msg_reset( msg ); return FD_DCACHE_MSG_ERR_LAYOUT; }
+  }
+  if( FD_UNLIKELY( fd_frag_meta_ctl_err( ctl ) ) ) { fd_dcache_msg_reset( msg ); return FD_DCACHE_MSG_ERR_FRAG; }
+
+  msg->seq       = fd_seq_inc( seq, 1UL );
+  msg->sz       += sz;
+  msg->frag_cnt += 1UL;
+  msg->active    = !fd_frag_meta_ctl_eom( ctl );
+  return fd_int_if( msg->active, FD_DCACHE_MSG_CONT, FD_DCACHE_MSG_DONE );
+}
+
+/* fd_dcache_msg_laddr_const returns the location in the caller's local
+   address space of the first byte of the message payload described by
+   msg, given the same base used for chunk indexing by the producer.
+   The payload is msg->sz contiguous bytes. */
+
+FD_FN_PURE static inline uchar const *
+fd_dcache_msg_laddr_const( fd_dcache_msg_t const * msg,
+                           void const *            base ) {
+  return (uchar const *)fd_chunk_to_laddr_const( base, msg->chunk );
+}
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_tango_dcache_fd_dcache_h */
+
@@ -0,0 +1,246 @@
+#ifndef HEADER_fd_src_tango_trace_fd_trace_h
+#define HEADER_fd_src_tango_trace_fd_trace_h
+
+/* fd_trace provides APIs for sampled end-to-end tracing of frags as
+   they flow through a pipeline of tiles.  Each tile that participates
+   has its own trace, a persistent shared memory ring of fixed size
+   events written only by that tile.  An event records which tile saw
+   the frag, the link it was seen on, the frag's sequence number on that
+   link, the frag's trace key (typically the frag's sig), what happened
+   (FD_TRACE_EVENT_*) and the tickcount when it happened.
+
+   Only a 1 in 2^lg_sample subset of frags is traced.  Whether or not a
+   frag is sampled is a pure function of its trace key and lg_sample,
+   so as long as every tile in the pipeline uses the same lg_sample and
+   derives the same key for a frag (e.g. the first 8 bytes of a
+   transaction's first signature, which is what the verify tiles use for
+   the sig of the frags they publish), every tile samples the same frags
+   and a monitor can stitch the events of all the tiles into per frag
+   timelines by key.
+
+   Tiles that are not tracing should not have a trace at all (tile code
+   is expected to use a NULL trace to indicate tracing is off, such that
+   the cost of tracing when off is a single well predicted branch per
+   frag).  Monitors read traces concurrently with the writer without
+   blocking it; a monitor reading a trace while it is written might
+   lose the oldest events (see fd_trace_snap) but will never see a torn
+   event. */
+
+#include "../fd_tango_base.h"
+
+/* FD_TRACE_{ALIGN,FOOTPRINT} specify the alignment and footprint needed
+   for a trace with depth events.  ALIGN is a positive integer power of
+   2.  FOOTPRINT is a multiple of ALIGN.  depth is assumed to be valid
+   (i.e. an integer power of 2 of at least FD_TRACE_DEPTH_MIN).  These
+   are provided to facilitate compile time declarations. */
+
+#define FD_TRACE_ALIGN               (128UL)
+#define FD_TRACE_FOOTPRINT( depth ) (128UL + (depth)*sizeof(fd_trace_event_t))
+
+/* FD_TRACE_DEPTH_MIN is the minimum depth of a trace */
+
+#define FD_TRACE_DEPTH_MIN (16UL)
+
+/* FD_TRACE_LG_SAMPLE_MAX is the maximum lg_sample of a trace */
+
+#define FD_TRACE_LG_SAMPLE_MAX (32UL)
+
+/* FD_TRACE_EVENT_* specify what happened to a frag.  For RX, DONE and
+   FILT, the event's link is the index of the in the frag was received
+   on and the event's seq is the frag's sequence number on that in.  For
+   PUB, the event's link is the index of the out the frag was published
+   to and seq is the sequence number it was published with.  A tile that
+   creates frags (e.g. from network traffic) records RX with link 0 and
+   seq 0 when the data for the frag started arriving.
+
+     RX   the tile started processing the frag
+     DONE the tile finished processing the frag (e.g. verified it or
+          inserted it into a pending pool)
+     PUB  the tile published the frag (or a frag derived from it, e.g.
+          a microblock holding the transaction) downstream
+     FILT the tile dropped the frag */
+
+#define FD_TRACE_EVENT_RX   (0UL)
+#define FD_TRACE_EVENT_DONE (1UL)
+#define FD_TRACE_EVENT_PUB  (2UL)
+#define FD_TRACE_EVENT_FILT (3UL)
+#define FD_TRACE_EVENT_CNT  (4UL)
+
+struct fd_trace_event {
+  ulong  key;   /* Trace key of the frag */
+  ulong  seq;   /* Sequence number of the frag on link */
+  long   ts;    /* Tickcount when the event happened */
+  ushort tile;  /* Id of the tile that recorded the event */
+  ushort link;  /* Index of the link the event happened on */
+  ushort event; /* FD_TRACE_EVENT_* */
+  ushort _pad;
+};
+
+typedef struct fd_trace_event fd_trace_event_t;
+
+/* fd_trace_t is an opaque handle of a trace.  The header is exposed
+   here to facilitate inlining recording on the critical path. */
+
+struct __attribute__((aligned(FD_TRACE_ALIGN))) fd_trace_private {
+  ulong magic;     /* == FD_TRACE_MAGIC */
+  ulong depth;     /* Number of events in the ring, integer power of 2 */
+  ulong tile;      /* Id of the tile that writes this trace */
+  ulong lg_sample; /* 1 in 2^lg_sample frags are traced */
+  ulong mask;      /* ==(1UL<<lg_sample)-1UL */
+  ulong cursor;    /* Number of events recorded so far, event i is at ring[ i & (depth-1) ] */
+  /* Padding to FD_TRACE_ALIGN here */
+  /* depth fd_trace_event_t here */
+};
+
+typedef struct fd_trace_private fd_trace_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_trace_{align,footprint} return the required alignment and
+   footprint of a memory region suitable for use as a trace with depth
+   events.  footprint returns 0 if depth is not an integer power of 2
+   of at least FD_TRACE_DEPTH_MIN. */
+
+FD_FN_CONST ulong
+fd_trace_align( void );
+
+FD_FN_CONST ulong
+fd_trace_footprint( ulong depth );
+
+/* fd_trace_new formats an unused memory region for use as a trace.
+   Assumes shmem is a non-NULL pointer to this region in the local
+   address space with the required footprint and alignment.  The trace
+   will hold the most recent depth events recorded by the tile with id
+   tile (in [0,USHORT_MAX]) for a 1 in 2^lg_sample (lg_sample in
+   [0,FD_TRACE_LG_SAMPLE_MAX]) subset of frags.  Returns shmem (and the
+   memory region it points to will be formatted as a trace, caller is
+   not joined) and NULL on failure (logs details). */
+
+void *
+fd_trace_new( void * shmem,
+              ulong  depth,
+              ulong  tile,
+              ulong  lg_sample );
+
+/* fd_trace_join joins the caller to the trace.  shtrace points to the
+   first byte of the memory region backing the trace in the caller's
+   address space.  Returns a pointer in the local address space to the
+   trace on success and NULL on failure (logs details).  A trace should
+   have only one joiner recording to it at a time (there can be any
+   number of joiners reading it).  fd_trace_leave leaves a current local
+   join.  Returns a pointer to the underlying shared memory region on
+   success and NULL on failure (logs details).  fd_trace_delete unformats
+   a memory region used as a trace.  Returns shtrace on success and NULL
+   on failure (logs details).  Assumes nobody is joined. */
+
+fd_trace_t *
+fd_trace_join( void * shtrace );
+
+void *
+fd_trace_leave( fd_trace_t const * trace );
+
+void *
+fd_trace_delete( void * shtrace );
+
+/* Accessors.  Assume trace is a current local join. */
+
+FD_FN_PURE static inline ulong fd_trace_depth    ( fd_trace_t const * trace ) { return trace->depth;     }
+FD_FN_PURE static inline ulong fd_trace_tile     ( fd_trace_t const * trace ) { return trace->tile;      }
+FD_FN_PURE static inline ulong fd_trace_lg_sample( fd_trace_t const * trace ) { return trace->lg_sample; }
+
+FD_FN_CONST static inline fd_trace_event_t *
+fd_trace_ring_laddr( fd_trace_t * trace ) {
+  return (fd_trace_event_t *)(trace+1);
+}
+
+FD_FN_CONST static inline fd_trace_event_t const *
+fd_trace_ring_laddr_const( fd_trace_t const * trace ) {
+  return (fd_trace_event_t const *)(trace+1);
+}
+
+/* fd_trace_cursor returns the number of events recorded to trace so
+   far as observed at some point during the call.  Events in
+   [cursor-depth,cursor) are (or were recently) in the ring. */
+
+static inline ulong
+fd_trace_cursor( fd_trace_t const * trace ) {
+  FD_COMPILER_MFENCE();
+  ulong cursor = FD_VOLATILE_CONST( trace->cursor );
+  FD_COMPILER_MFENCE();
+  return cursor;
+}
+
+/* fd_trace_sampled returns 1 if the frag with the given trace key
+   should be traced and 0 if not.  Returns 0 if trace is NULL (i.e.
+   tracing is off), which is optimized for.  Keys are hashed before
+   sampling such that sampling is robust against keys with low entropy
+   in some of their bits. */
+
+FD_FN_PURE static inline int
+fd_trace_sampled( fd_trace_t const * trace,
+                  ulong              key ) {
+  if( FD_LIKELY( !trace ) ) return 0;
+  return !(fd_ulong_hash( key ) & trace->mask);
+}
+
+/* fd_trace_record records that event (a FD_TRACE_EVENT_*) happened at
+   tickcount ts to the frag with the given trace key and sequence number
+   seq on link.  Assumes trace is a current local join and the caller is
+   the trace's only writer.  The caller is responsible for only
+   recording events of sampled frags (fd_trace_sampled). */
+
+static inline void
+fd_trace_record( fd_trace_t * trace,
+                 ulong        key,
+                 ulong        link,
+                 ulong        seq,
+                 ulong        event,
+                 long         ts ) {
+  ulong              cursor = trace->cursor;
+  fd_trace_event_t * e      = fd_trace_ring_laddr( trace ) + (cursor & (trace->depth-1UL));
+  e->key   = key;
+  e->seq   = seq;
+  e->ts    = ts;
+  e->tile  = (ushort)trace->tile;
+  e->link  = (ushort)link;
+  e->event = (ushort)event;
+  e->_pad  = (ushort)0;
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( trace->cursor ) = cursor+1UL;
+  FD_COMPILER_MFENCE();
+}
+
+/* fd_trace_snap copies the events recorded to trace at or after
+   cursor0 (i.e. the events that have been recorded since a previous
+   fd_trace_snap returned cursor0, 0 for all events) to out, oldest
+   first.  out has room for out_max events.  Returns the number of
+   events copied and sets *_cursor to the cursor to use for the next
+   snap.  Events that were recorded since cursor0 but were overwritten
+   before they could be copied (or could have been overwritten while
+   being copied) are skipped, *_lost_cnt is set to the number of events
+   skipped this way (this is 0 if the trace is snapped often enough
+   relative to its depth and the sampling rate).  At most the
+   min(out_max,depth-1) most recent events are copied (the slot of the
+   oldest event in the ring could be in the middle of being overwritten
+   by the writer), older ones are counted as lost.  Safe
+   to call concurrently with the trace's writer.  Not intended for use
+   on the critical path. */
+
+ulong
+fd_trace_snap( fd_trace_t const * trace,
+               ulong              cursor0,
+               fd_trace_event_t * out,
+               ulong              out_max,
+               ulong *            _cursor,
+               ulong *            _lost_cnt );
+
+/* fd_trace_event_cstr returns a cstr with the name of event (e.g.
+   "rx").  Returns "unk" for unknown events.  The returned pointer is
+   infinite lifetime. */
+
+FD_FN_CONST char const *
+fd_trace_event_cstr( ulong event );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_tango_trace_fd_trace_h */
@@ -0,0 +1,11 @@
+#ifndef HEADER_fd_src_tango_xdp_fd_xdp_h
+#define HEADER_fd_src_tango_xdp_fd_xdp_h
+
+/* Helpers for hardware-agnostic kernel-bypass networking on Linux
+   using the eBPF, XDP, AF_XDP (XSK) kernel APIs. */
+
+#include "fd_xsk.h"               /* XSKs (AF_XDP sockets)              */
+#include "fd_xsk_aio.h"           /* fd_aio driver for fd_xsk           */
+#include "fd_xdp_redirect_user.h" /* XDP redirect program userspace API */
+
+#endif /* HEADER_fd_src_tango_xdp_fd_xdp_h */
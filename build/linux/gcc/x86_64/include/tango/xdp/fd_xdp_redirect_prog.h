@@ -0,0 +1,44 @@
+#ifndef HEADER_fd_src_tango_xdp_fd_xdp_redirect_prog_h
+#define HEADER_fd_src_tango_xdp_fd_xdp_redirect_prog_h
+
+/* Cross-platform definitions about fd_xdp_redirect_prog.c */
+
+/* FD_XDP_XSKS_MAP_CNT: Max supported number of XSKs (queues).
+   The actual limit may be lower in practice depending on hardware. */
+#define FD_XDP_XSKS_MAP_CNT 256U
+
+/* FD_XDP_UDP_MAP_CNT: Max supported number of UDP port mappings. */
+#define FD_XDP_UDP_MAP_CNT  64U
+
+/* FD_XDP_RATE_LIMIT_MAP_CNT: Max number of IPv4 source addresses
+   tracked for rate limiting.  Least recently seen sources get evicted
+   when exceeded. */
+#define FD_XDP_RATE_LIMIT_MAP_CNT 65536U
+
+/* FD_XDP_QUIC_{MIN,MAX}_SZ: Bounds of the UDP payload size of QUIC
+   datagrams accepted by the XDP program.  MIN is the smallest possible
+   short header packet sent to an fd_quic server (1 byte flags, 8 byte
+   conn ID, 4 byte header protection sample offset, 16 byte sample).
+   MAX is the largest payload that fits into a 2048 byte XSK frame.
+   FD_XDP_QUIC_INITIAL_MIN_SZ is the smallest valid UDP payload carrying
+   a QUIC Initial packet (RFC 9000 Section 14.1).  FD_XDP_QUIC_CONN_ID_SZ
+   is the size of the conn IDs issued by fd_quic (FD_QUIC_CONN_ID_SZ). */
+#define FD_XDP_QUIC_MIN_SZ          29U
+#define FD_XDP_QUIC_MAX_SZ        2006U
+#define FD_XDP_QUIC_INITIAL_MIN_SZ 1200U
+#define FD_XDP_QUIC_CONN_ID_SZ       8U
+
+/* fd_xdp_rate_cfg_t is the value type of the single entry of the
+   fd_xdp_rate_cfg map.  Rate limiting is implemented as a generic cell
+   rate algorithm: Each packet from a source advances the source's
+   theoretical arrival time (TAT) by cost_ns.  Packets that arrive more
+   than burst_ns before their source's TAT are dropped.  cost_ns==0
+   disables rate limiting. */
+
+struct fd_xdp_rate_cfg {
+  ulong cost_ns;  /* Average ns between packets of a single source */
+  ulong burst_ns; /* Max ns a source may get ahead of its average rate */
+};
+typedef struct fd_xdp_rate_cfg fd_xdp_rate_cfg_t;
+
+#endif /* HEADER_fd_src_tango_xdp_fd_xdp_redirect_prog_h */
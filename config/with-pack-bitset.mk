@@ -0,0 +1 @@
+CPPFLAGS+=-DFD_PACK_USE_BITSET=1
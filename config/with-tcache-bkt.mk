@@ -0,0 +1 @@
+CPPFLAGS+=-DFD_TCACHE_USE_BKT=1
@@ -1,6 +1,7 @@
 #include "fdctl.h"
 
 #include "../frank/fd_frank.h"
+#include "../../ballet/pack/fd_pack_shard.h"
 #include "../../util/net/fd_eth.h"
 
 #include <stdio.h>
@@ -262,6 +263,7 @@ static void parse_key_value( config_t *   config,
 
   ENTRY_STR   ( ., layout,              affinity                                                  );
   ENTRY_UINT  ( ., layout,              verify_tile_count                                         );
+  ENTRY_UINT  ( ., layout,              pack_tile_count                                           );
   ENTRY_UINT  ( ., layout,              bank_tile_count                                           );
 
   ENTRY_STR   ( ., shmem,               gigantic_page_mount_path                                  );
@@ -277,6 +279,10 @@ static void parse_key_value( config_t *   config,
   ENTRY_STR   ( ., development.netns,   interface1_mac                                            );
   ENTRY_STR   ( ., development.netns,   interface1_addr                                           );
 
+  ENTRY_BOOL  ( ., development.trace,   enabled                                                   );
+  ENTRY_UINT  ( ., development.trace,   depth                                                     );
+  ENTRY_UINT  ( ., development.trace,   lg_sample                                                 );
+
   ENTRY_STR   ( ., tiles.quic,          interface                                                 );
   ENTRY_USHORT( ., tiles.quic,          listen_port                                               );
   ENTRY_UINT  ( ., tiles.quic,          max_concurrent_connections                                );
@@ -289,11 +295,16 @@ static void parse_key_value( config_t *   config,
   ENTRY_UINT  ( ., tiles.quic,          xdp_rx_queue_size                                         );
   ENTRY_UINT  ( ., tiles.quic,          xdp_tx_queue_size                                         );
   ENTRY_UINT  ( ., tiles.quic,          xdp_aio_depth                                             );
+  ENTRY_UINT  ( ., tiles.quic,          xdp_busy_poll_usecs                                       );
+  ENTRY_UINT  ( ., tiles.quic,          xdp_busy_poll_budget                                      );
+  ENTRY_UINT  ( ., tiles.quic,          xdp_rate_limit_pkt_per_sec                                );
+  ENTRY_UINT  ( ., tiles.quic,          xdp_rate_limit_burst                                      );
 
   ENTRY_UINT  ( ., tiles.verify,        receive_buffer_size                                       );
   ENTRY_UINT  ( ., tiles.verify,        mtu                                                       );
 
   ENTRY_UINT  ( ., tiles.pack,          max_pending_transactions                                  );
+  ENTRY_BOOL  ( ., tiles.pack,          adaptive_flow_control                                     );
 
   ENTRY_UINT  ( ., tiles.bank,          receive_buffer_size                                       );
 
@@ -542,11 +553,14 @@ init_workspaces( config_t * config ) {
   config->shmem.workspaces[ idx ].num_pages = 1;
   idx++;
 
-  config->shmem.workspaces[ idx ].kind      = wksp_pack;
-  config->shmem.workspaces[ idx ].name      = "pack";
-  config->shmem.workspaces[ idx ].page_size = FD_SHMEM_GIGANTIC_PAGE_SZ;
-  config->shmem.workspaces[ idx ].num_pages = 1;
-  idx++;
+  for( ulong i=0; i<config->layout.pack_tile_count; i++ ) {
+    config->shmem.workspaces[ idx ].kind      = wksp_pack;
+    config->shmem.workspaces[ idx ].name      = "pack";
+    config->shmem.workspaces[ idx ].page_size = FD_SHMEM_GIGANTIC_PAGE_SZ;
+    config->shmem.workspaces[ idx ].num_pages = 1;
+    config->shmem.workspaces[ idx ].kind_idx  = i;
+    idx++;
+  }
 
   config->shmem.workspaces[ idx ].kind      = wksp_forward;
   config->shmem.workspaces[ idx ].name      = "forward";
@@ -657,6 +671,28 @@ config_parse( int *    pargc,
     mac_address( result.tiles.quic.interface, result.tiles.quic.mac_addr );
   }
 
+  if( FD_UNLIKELY( result.development.trace.enabled ) ) {
+    if( FD_UNLIKELY( !fd_trace_footprint( result.development.trace.depth ) || result.development.trace.depth>32768U ) )
+      FD_LOG_ERR(( "[development.trace.depth] must be a power of 2 in [%lu,32768]", FD_TRACE_DEPTH_MIN ));
+    if( FD_UNLIKELY( result.development.trace.lg_sample>FD_TRACE_LG_SAMPLE_MAX ) )
+      FD_LOG_ERR(( "[development.trace.lg_sample] must be at most %lu", FD_TRACE_LG_SAMPLE_MAX ));
+  }
+
+  if( FD_UNLIKELY( !result.layout.pack_tile_count || result.layout.pack_tile_count>FD_PACK_SHARD_MAX ) )
+    FD_LOG_ERR(( "[layout.pack_tile_count] must be in [1,%lu]", FD_PACK_SHARD_MAX ));
+  if( FD_UNLIKELY( result.layout.bank_tile_count % result.layout.pack_tile_count ) )
+    FD_LOG_ERR(( "[layout.bank_tile_count] must be a multiple of [layout.pack_tile_count]" ));
+  if( FD_UNLIKELY( !result.layout.bank_tile_count || result.layout.bank_tile_count/result.layout.pack_tile_count>16U ) )
+    FD_LOG_ERR(( "[layout.bank_tile_count] must be at least 1 and at most 16 per pack tile" ));
+
+  if( FD_UNLIKELY( result.tiles.quic.xdp_busy_poll_budget>USHORT_MAX ) )
+    FD_LOG_ERR(( "[tiles.quic.xdp_busy_poll_budget] must be at most %u", (uint)USHORT_MAX ));
+
+  if( FD_UNLIKELY( result.tiles.quic.xdp_rate_limit_pkt_per_sec>1000000000U ) )
+    FD_LOG_ERR(( "[tiles.quic.xdp_rate_limit_pkt_per_sec] must be at most 1000000000" ));
+  if( FD_UNLIKELY( result.tiles.quic.xdp_rate_limit_pkt_per_sec && !result.tiles.quic.xdp_rate_limit_burst ) )
+    FD_LOG_ERR(( "[tiles.quic.xdp_rate_limit_burst] must be non-zero when rate limiting is enabled" ));
+
   uint uid = username_to_uid( result.user );
   result.uid = uid;
   result.gid = uid;
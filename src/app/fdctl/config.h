@@ -101,6 +101,7 @@ typedef struct {
   struct {
     char affinity[ AFFINITY_SZ ];
     uint verify_tile_count;
+    uint pack_tile_count;
     uint bank_tile_count;
   } layout;
 
@@ -124,6 +125,11 @@ typedef struct {
       char interface1_mac [ 32 ];
       char interface1_addr[ 32 ];
     } netns;
+    struct {
+      int  enabled;
+      uint depth;
+      uint lg_sample;
+    } trace;
   } development;
 
   struct {
@@ -143,6 +149,10 @@ typedef struct {
       uint xdp_rx_queue_size;
       uint xdp_tx_queue_size;
       uint xdp_aio_depth;
+      uint xdp_busy_poll_usecs;
+      uint xdp_busy_poll_budget;
+      uint xdp_rate_limit_pkt_per_sec;
+      uint xdp_rate_limit_burst;
     } quic;
 
     struct {
@@ -152,6 +162,7 @@ typedef struct {
 
     struct {
       uint max_pending_transactions;
+      int  adaptive_flow_control;
     } pack;
 
     struct {
@@ -83,6 +83,16 @@ typedef struct {
   configure_stage_t ** stages;
 } configure_args_t;
 
+/* When the QUIC tiles busy poll their queues, the kernel should defer
+   the interrupts of the device for a while to give the tiles a chance
+   to poll first.  These are the settings recommended by the kernel
+   documentation for SO_PREFER_BUSY_POLL (the timeout is in ns, much
+   longer than a tile takes between polls).  The ethtool stage sets
+   them on the real device, and fddev's netns stage on its veth. */
+
+#define NAPI_DEFER_HARD_IRQS (2U)
+#define GRO_FLUSH_TIMEOUT    (200000U)
+
 /* read_uint_file() reads a uint from the given path, or exits the
    program with an error if any error was encountered. */
 uint
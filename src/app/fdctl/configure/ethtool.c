@@ -88,6 +88,15 @@ init_device( const char * device,
     FD_LOG_ERR(( "error configuring network device, close() socket failed (%i-%s)", errno, fd_io_strerror( errno ) ));
 }
 
+static void
+init_busy_poll( const char * device ) {
+  char path[ PATH_MAX ];
+  snprintf1( path, PATH_MAX, "/sys/class/net/%s/napi_defer_hard_irqs", device );
+  write_uint_file( path, NAPI_DEFER_HARD_IRQS );
+  snprintf1( path, PATH_MAX, "/sys/class/net/%s/gro_flush_timeout", device );
+  write_uint_file( path, GRO_FLUSH_TIMEOUT );
+}
+
 static void
 init( config_t * const config ) {
   /* we need one channel for both TX and RX on the NIC for each QUIC
@@ -104,6 +113,8 @@ init( config_t * const config ) {
   } else {
     init_device( config->tiles.quic.interface, config->layout.verify_tile_count );
   }
+
+  if( FD_UNLIKELY( config->tiles.quic.xdp_busy_poll_usecs ) ) init_busy_poll( config->tiles.quic.interface );
 }
 
 static configure_result_t
@@ -163,6 +174,23 @@ check_device( const char * device,
   CONFIGURE_OK();
 }
 
+static configure_result_t
+check_busy_poll( const char * device ) {
+  char path[ PATH_MAX ];
+  snprintf1( path, PATH_MAX, "/sys/class/net/%s/napi_defer_hard_irqs", device );
+  uint napi_defer_hard_irqs = read_uint_file( path );
+  if( FD_UNLIKELY( napi_defer_hard_irqs!=NAPI_DEFER_HARD_IRQS ) )
+    NOT_CONFIGURED( "device `%s` does not defer interrupts for busy polling, `%s` is %u, expected %u",
+                    device, path, napi_defer_hard_irqs, NAPI_DEFER_HARD_IRQS );
+  snprintf1( path, PATH_MAX, "/sys/class/net/%s/gro_flush_timeout", device );
+  uint gro_flush_timeout = read_uint_file( path );
+  if( FD_UNLIKELY( gro_flush_timeout!=GRO_FLUSH_TIMEOUT ) )
+    NOT_CONFIGURED( "device `%s` does not defer interrupts for busy polling, `%s` is %u, expected %u",
+                    device, path, gro_flush_timeout, GRO_FLUSH_TIMEOUT );
+
+  CONFIGURE_OK();
+}
+
 static configure_result_t
 check( config_t * const config ) {
   if( FD_UNLIKELY( device_is_bonded( config->tiles.quic.interface ) ) ) {
@@ -176,6 +204,8 @@ check( config_t * const config ) {
     CHECK( check_device( config->tiles.quic.interface, config->layout.verify_tile_count ) );
   }
 
+  if( FD_UNLIKELY( config->tiles.quic.xdp_busy_poll_usecs ) ) CHECK( check_busy_poll( config->tiles.quic.interface ) );
+
   CONFIGURE_OK();
 }
 
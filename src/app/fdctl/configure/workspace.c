@@ -3,6 +3,12 @@
 #include "../../../tango/fd_tango.h"
 #include "../../../tango/quic/fd_quic.h"
 #include "../../../tango/xdp/fd_xsk_aio.h"
+#include "../../../ballet/pack/fd_est_ftbl.h"
+#include "../../../ballet/pack/fd_alt_cache.h"
+#include "../../../ballet/pack/fd_balance_tbl.h"
+#include "../../../ballet/pack/fd_fee_stats.h"
+#include "../../../ballet/pack/fd_pack_shard.h"
+#include "../../../ballet/pack/fd_compute_budget_program.h"
 
 #include <sys/stat.h>
 #include <linux/capability.h>
@@ -38,11 +44,15 @@ init_perm( security_t *     security,
       FD_LOG_ERR(( "failed to insert value into pod for `%s`", name ));             \
   } while( 0 )
 
-static void cnc( void * pod, char * fmt, ... ) {
-  INSERTER( fmt,
-            fd_cnc_align    (                                ),
-            fd_cnc_footprint( 4032                           ),
-            fd_cnc_new      ( shmem, 4032, 0, fd_tickcount() ) );
+/* in_cnt is the number of frag streams the tile consumes, the cnc app
+   region is sized to have room for their latency histograms. */
+
+static void cnc( void * pod, char * fmt, ulong in_cnt, ... ) {
+  ulong app_sz = fd_ulong_max( 4032UL, FD_LAT_CNC_APP_SZ( in_cnt ) );
+  INSERTER( in_cnt,
+            fd_cnc_align    (                                  ),
+            fd_cnc_footprint( app_sz                           ),
+            fd_cnc_new      ( shmem, app_sz, 0, fd_tickcount() ) );
 }
 
 static void mcache( void * pod, char * fmt, ulong depth, ... ) {
@@ -74,6 +84,13 @@ static void tcache( void * pod, char * fmt, ulong depth, ... ) {
             fd_tcache_new      ( shmem, depth, 0 ) );
 }
 
+static void trace( void * pod, char * fmt, ulong depth, ulong tile, ulong lg_sample, ... ) {
+  INSERTER( lg_sample,
+            fd_trace_align    (                               ),
+            fd_trace_footprint( depth                         ),
+            fd_trace_new      ( shmem, depth, tile, lg_sample ) );
+}
+
 static void quic( void * pod, char * fmt, fd_quic_limits_t * limits, ... ) {
   INSERTER( limits,
             fd_quic_align    (               ),
@@ -95,6 +112,41 @@ static void xsk_aio( void * pod, char * fmt, ulong tx_depth, ulong batch_count,
             fd_xsk_aio_new      ( shmem,    tx_depth, batch_count ) );
 }
 
+static void est_ftbl( void * pod, char * fmt, ulong bin_cnt, ulong history, uint default_val, ... ) {
+  INSERTER( default_val,
+            fd_est_ftbl_align    (                                          ),
+            fd_est_ftbl_footprint( bin_cnt                                  ),
+            fd_est_ftbl_new      ( shmem, bin_cnt, history, default_val     ) );
+}
+
+static void alt_cache( void * pod, char * fmt, ulong entry_cnt, ... ) {
+  INSERTER( entry_cnt,
+            fd_alt_cache_align    (                  ),
+            fd_alt_cache_footprint( entry_cnt        ),
+            fd_alt_cache_new      ( shmem, entry_cnt ) );
+}
+
+static void balance_tbl( void * pod, char * fmt, ulong slot_cnt, ... ) {
+  INSERTER( slot_cnt,
+            fd_balance_tbl_align    (                 ),
+            fd_balance_tbl_footprint( slot_cnt        ),
+            fd_balance_tbl_new      ( shmem, slot_cnt ) );
+}
+
+static void fee_stats( void * pod, char * fmt, ... ) {
+  INSERTER( fmt,
+            fd_fee_stats_align    (       ),
+            fd_fee_stats_footprint(       ),
+            fd_fee_stats_new      ( shmem ) );
+}
+
+static void shard_ctl( void * pod, char * fmt, ulong shard_cnt, ... ) {
+  INSERTER( shard_cnt,
+            fd_pack_shard_ctl_align    (                  ),
+            fd_pack_shard_ctl_footprint(                  ),
+            fd_pack_shard_ctl_new      ( shmem, shard_cnt ) );
+}
+
 FD_FN_UNUSED static void alloc( void * pod, char * fmt, ulong align, ulong sz, ... ) {
   INSERTER( sz, align, sz, 1 );
 }
@@ -117,6 +169,10 @@ static void uint1( void * pod, char * fmt, uint value, ... ) {
   VALUE( uint, value );
 }
 
+static void int1( void * pod, char * fmt, int value, ... ) {
+  VALUE( int, value );
+}
+
 /* need a dummy argument so we can locate va_args (value would be default
    promoted) */
 static void ushort1( void * pod, char * fmt, ushort value, ulong dummy, ... ) {
@@ -215,6 +271,21 @@ init( config_t * const config ) {
     workspace_config_t * wksp1 = &config->shmem.workspaces[ j ];
     WKSP_BEGIN( config, wksp1, 0 );
 
+    /* Tiles on the transaction ingest path trace into their own
+       workspace, the trace's tile id is the index of that workspace */
+    if( FD_UNLIKELY( config->development.trace.enabled ) ) {
+      switch( wksp1->kind ) {
+        case wksp_quic:
+        case wksp_verify:
+        case wksp_dedup:
+        case wksp_pack:
+          trace( pod, "trace", config->development.trace.depth, j, config->development.trace.lg_sample );
+          break;
+        default:
+          break;
+      }
+    }
+
     switch( wksp1->kind ) {
       case wksp_tpu_txn_data:
         for( ulong i=0; i<config->layout.verify_tile_count; i++ ) {
@@ -235,8 +306,11 @@ init( config_t * const config ) {
         }
         break;
       case wksp_dedup_pack:
+        ulong1( pod, "cnt", config->layout.pack_tile_count );
         mcache( pod, "mcache", config->tiles.verify.receive_buffer_size );
-        fseq  ( pod, "fseq" );
+        for( ulong i=0; i<config->layout.pack_tile_count; i++ ) {
+          fseq( pod, "fseq%lu", i );
+        }
         break;
       case wksp_pack_bank:
         ulong1( pod, "num_tiles", config->layout.bank_tile_count );
@@ -247,6 +321,11 @@ init( config_t * const config ) {
           mcache( pod, "mcache-back%lu", config->tiles.bank.receive_buffer_size, i );
           fseq  ( pod, "fseq-back%lu", i );
         }
+        est_ftbl( pod, "cu_est", 4096UL, 1000UL, FD_COMPUTE_BUDGET_DEFAULT_INSTR_CU_LIMIT );
+        alt_cache( pod, "alt_cache", 4096UL );
+        balance_tbl( pod, "balances", 1UL<<18 );
+        fee_stats( pod, "fee_stats" );
+        if( FD_UNLIKELY( config->layout.pack_tile_count>1U ) ) shard_ctl( pod, "shard_ctl", config->layout.pack_tile_count );
         break;
       case wksp_pack_forward:
         mcache( pod, "mcache", config->tiles.forward.receive_buffer_size );
@@ -261,7 +340,7 @@ init( config_t * const config ) {
         }
         break;
       case wksp_quic:
-        cnc    ( pod, "cnc" );
+        cnc    ( pod, "cnc",     0UL );
         quic   ( pod, "quic",    &limits );
         xsk    ( pod, "xsk",     2048, config->tiles.quic.xdp_rx_queue_size, config->tiles.quic.xdp_tx_queue_size );
         xsk_aio( pod, "xsk_aio", config->tiles.quic.xdp_tx_queue_size, config->tiles.quic.xdp_aio_depth );
@@ -270,6 +349,8 @@ init( config_t * const config ) {
         void *       shmem          = fd_wksp_map      ( quic_xsk_gaddr );
         if( FD_UNLIKELY( !fd_xsk_bind( shmem, config->name, config->tiles.quic.interface, (uint)wksp1->kind_idx ) ) )
           FD_LOG_ERR(( "failed to bind xsk for quic tile %lu", wksp1->kind_idx ));
+        if( FD_UNLIKELY( !fd_xsk_set_busy_poll( shmem, config->tiles.quic.xdp_busy_poll_usecs, config->tiles.quic.xdp_busy_poll_budget ) ) )
+          FD_LOG_ERR(( "failed to configure busy polling of xsk for quic tile %lu", wksp1->kind_idx ));
         fd_wksp_unmap( shmem );
 
         uint1  ( pod, "ip_addr",                    config->tiles.quic.ip_addr );
@@ -279,22 +360,24 @@ init( config_t * const config ) {
         ulong1 ( pod, "initial_rx_max_stream_data", 1<<15 );
         break;
       case wksp_verify:
-        cnc( pod, "cnc" );
+        cnc( pod, "cnc", 1UL );
         break;
       case wksp_dedup:
-        cnc   ( pod, "cnc",    pod, wksp );
+        cnc   ( pod, "cnc",    config->layout.verify_tile_count );
         tcache( pod, "tcache", config->tiles.dedup.signature_cache_size );
         break;
       case wksp_pack:
-        cnc   ( pod, "cnc" );
-        ulong1( pod, "min-gap", config->layout.bank_tile_count - 1UL        );
-        ulong1( pod, "depth",   config->tiles.pack.max_pending_transactions );
+        cnc   ( pod, "cnc",       1UL+config->layout.bank_tile_count/config->layout.pack_tile_count );
+        ulong1( pod, "depth",     config->tiles.pack.max_pending_transactions );
+        ulong1( pod, "shard_cnt", config->layout.pack_tile_count );
+        ulong1( pod, "shard_idx", wksp1->kind_idx );
+        int1  ( pod, "cr_adapt",  config->tiles.pack.adaptive_flow_control );
         break;
       case wksp_bank:
-        cnc   ( pod, "cnc" );
+        cnc   ( pod, "cnc", 1UL );
         break;
       case wksp_forward:
-        cnc   ( pod, "cnc" );
+        cnc   ( pod, "cnc", 1UL );
         break;
     }
 
@@ -49,8 +49,13 @@ init( config_t * const config ) {
     FD_LOG_ERR(( "fd_xdp_hook_iface failed" ));
   if( FD_UNLIKELY( fd_xdp_listen_udp_port( config->name,
                                            config->tiles.quic.ip_addr,
-                                           config->tiles.quic.listen_port, 1 ) ) )
+                                           config->tiles.quic.listen_port,
+                                           FD_XDP_PROTO_TPU_QUIC_USER ) ) )
     FD_LOG_ERR(( "fd_xdp_listen_udp_port failed" ));
+  if( FD_UNLIKELY( fd_xdp_set_rate_limit( config->name,
+                                          config->tiles.quic.xdp_rate_limit_pkt_per_sec,
+                                          config->tiles.quic.xdp_rate_limit_burst ) ) )
+    FD_LOG_ERR(( "fd_xdp_set_rate_limit failed" ));
 }
 
 static void
@@ -95,6 +100,12 @@ check( config_t * const config ) {
   snprintf1( xdp_path, PATH_MAX, "/sys/fs/bpf/%s/udp_dsts", config->name );
   CHECK( check_file( xdp_path,      config->uid, config->uid, S_IFREG | S_IRUSR | S_IWUSR | S_IRGRP ) );
 
+  snprintf1( xdp_path, PATH_MAX, "/sys/fs/bpf/%s/rate_limits", config->name );
+  CHECK( check_file( xdp_path,      config->uid, config->uid, S_IFREG | S_IRUSR | S_IWUSR | S_IRGRP ) );
+
+  snprintf1( xdp_path, PATH_MAX, "/sys/fs/bpf/%s/rate_cfg", config->name );
+  CHECK( check_file( xdp_path,      config->uid, config->uid, S_IFREG | S_IRUSR | S_IWUSR | S_IRGRP ) );
+
   snprintf1( xdp_path, PATH_MAX, "/sys/fs/bpf/%s/%s/xdp_link", config->name, config->tiles.quic.interface );
   CHECK( check_file( xdp_path,      config->uid, config->uid, S_IFREG | S_IRUSR | S_IWUSR | S_IRGRP ) );
 
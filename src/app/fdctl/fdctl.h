@@ -33,6 +33,12 @@ typedef union {
   struct {
     int monitor;
   } dev;
+  struct {
+    long   duration;
+    long   dt;
+    ulong  txn_cnt;
+    double ns_per_tic;
+  } trace;
 } args_t;
 
 typedef struct security security_t;
@@ -44,7 +50,7 @@ typedef struct {
     void       (*fn  )( args_t * args, config_t * const config );
 } action_t;
 
-extern action_t ACTIONS[ 4 ];
+extern action_t ACTIONS[ 5 ];
 
 int
 main1( int     argc,
@@ -87,6 +93,18 @@ void
 monitor_cmd_fn( args_t *         args,
                 config_t * const config );
 
+void
+trace_cmd_args( int *    pargc,
+                char *** pargv,
+                args_t * args );
+void
+trace_cmd_perm( args_t *         args,
+                security_t *     security,
+                config_t * const config );
+void
+trace_cmd_fn( args_t *         args,
+              config_t * const config );
+
 void
 keygen_cmd_fn( args_t *         args,
                config_t * const config );
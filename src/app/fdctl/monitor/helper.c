@@ -176,3 +176,16 @@ printf_pct( char ** buf,
   if( pct<=999.999 ) { PRINT( " %7.3f", pct ); return; }
   /**/                 PRINT( ">999.999" );
 }
+
+void
+printf_lat( char **      buf,
+            ulong *      buf_sz,
+            uint const * hist_now,
+            uint const * hist_then,
+            double       q,
+            double       ns_per_tic ) {
+  if( FD_UNLIKELY( !fd_lat_hist_cnt( hist_now, hist_then ) ) ) { PRINT( TEXT_GREEN "         -" TEXT_NORMAL ); return; }
+  ulong tic = fd_lat_hist_pctile( hist_now, hist_then, q );
+  if( FD_UNLIKELY( tic==ULONG_MAX ) ) { PRINT( TEXT_RED "  overflow" TEXT_NORMAL ); return; }
+  printf_age( buf, buf_sz, (long)(0.5 + ns_per_tic*(double)tic) );
+}
@@ -107,4 +107,16 @@ printf_pct( char ** buf,
             ulong  den_then,
             double lhopital_den );
 
+/* printf_lat prints to stdout an upper bound in ns for the q-th
+   quantile of the frag latencies recorded in fd_lat histogram hist_now
+   since snapshot hist_then, given the tickcount period ns_per_tic.
+   Will be exactly 10 char wide and color coded. */
+void
+printf_lat( char **      buf,
+            ulong *      buf_sz,
+            uint const * hist_now,
+            uint const * hist_then,
+            double       q,
+            double       ns_per_tic );
+
 #endif /* HEADER_fd_src_app_fdctl_monitor_helper_h */
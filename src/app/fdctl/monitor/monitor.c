@@ -3,6 +3,8 @@
 #include "helper.h"
 #include "../run.h"
 #include "../../../disco/fd_disco.h"
+#include "../../../ballet/base58/fd_base58.h"
+#include "../../../ballet/pack/fd_fee_stats.h"
 
 #include <stdio.h>
 #include <signal.h>
@@ -64,18 +66,24 @@ typedef struct {
   ulong fseq_diag_ovrnp_cnt;
   ulong fseq_diag_ovrnr_cnt;
   ulong fseq_diag_slow_cnt;
+
+  uint  lat[ 2UL*FD_LAT_BKT_CNT ];
 } link_snap_t;
 
 typedef struct {
   char const *     name;
+  ulong            kind_idx;
   fd_cnc_t *       cnc;
 } tile_t;
 
 typedef struct {
   char const *     src_name;
   char const *     dst_name;
+  ulong            dst_kind_idx; /* Which of the dst_name tiles consumes this link */
+  ulong            dst_in_idx;   /* Index of this link in the consumer's ins */
   fd_frag_meta_t * mcache;
   ulong *          fseq;
+  uint const *     lat;          /* Consumer's latency histograms for this link, NULL if none */
 } link_t;
 
 static void
@@ -126,6 +134,15 @@ link_snap( link_snap_t * snap_cur,
     FD_COMPILER_MFENCE();
     snap->fseq_diag_tot_cnt += snap->fseq_diag_filt_cnt;
     snap->fseq_diag_tot_sz  += snap->fseq_diag_filt_sz;
+
+    uint const * lat = links[ link_idx ].lat;
+    if( FD_LIKELY( lat ) ) {
+      FD_COMPILER_MFENCE();
+      fd_memcpy( snap->lat, lat, sizeof(snap->lat) );
+      FD_COMPILER_MFENCE();
+    } else {
+      fd_memset( snap->lat, 0, sizeof(snap->lat) );
+    }
   }
 }
 
@@ -146,7 +163,11 @@ static void write_stdout( char * buf, ulong buf_sz ) {
 
 static int stop1 = 0;
 
-#define FD_MONITOR_TEXT_BUF_SZ 16384
+/* FD_MONITOR_FEE_ROW_CNT is the number of hot accounts shown.  The
+   table always has this many rows so that it can be redrawn in place. */
+#define FD_MONITOR_FEE_ROW_CNT (8UL)
+
+#define FD_MONITOR_TEXT_BUF_SZ 32768
 char buffer[ FD_MONITOR_TEXT_BUF_SZ ];
 char buffer2[ FD_MONITOR_TEXT_BUF_SZ ];
 
@@ -199,22 +220,27 @@ run_monitor( config_t * const config,
     config->layout.verify_tile_count + // QUIC tiles
     config->layout.verify_tile_count + // verify tiles
     1 +                                // dedup tile
-    1 +                                // pack tile
+    config->layout.pack_tile_count +   // pack tiles
     config->layout.bank_tile_count +   // bank tiles
     1;                                 // forward tile
 
   ulong link_cnt =
     config->layout.verify_tile_count + // quic <-> verify
     config->layout.verify_tile_count + // verify <-> dedup
-    1 +                                // dedup <-> pack
+    config->layout.pack_tile_count +   // dedup <-> pack
     config->layout.bank_tile_count +   // pack <-> bank
     config->layout.bank_tile_count +   // bank <-> pack
     1;                                 // pack <-> forward
 
+  /* Each pack tile has an equal share of the bank tiles */
+  ulong bank_per_pack = config->layout.bank_tile_count / config->layout.pack_tile_count;
+
   tile_t * tiles = fd_alloca( alignof(tile_t *), sizeof(tile_t)*tile_cnt );
   link_t * links = fd_alloca( alignof(link_t *), sizeof(link_t)*link_cnt );
   if( FD_UNLIKELY( (!tiles) | (!links)) ) FD_LOG_ERR(( "fd_alloca failed" )); /* paranoia */
 
+  fd_fee_stats_t const * fee_stats = NULL;
+
   ulong tile_idx = 0;
   ulong link_idx = 0;
   for( ulong j=0; j<config->shmem.workspaces_cnt; j++ ) {
@@ -229,6 +255,8 @@ run_monitor( config_t * const config,
         for( ulong i=0; i<config->layout.verify_tile_count; i++ ) {
           links[ link_idx ].src_name = "quic";
           links[ link_idx ].dst_name = "verify";
+          links[ link_idx ].dst_kind_idx = i;
+          links[ link_idx ].dst_in_idx   = 0UL;
           links[ link_idx ].mcache = fd_mcache_join( fd_wksp_pod_map( pods[ j ], snprintf1( buf, 64, "mcache%lu", i ) ) );
           if( FD_UNLIKELY( !links[ link_idx ].mcache ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
           links[ link_idx ].fseq = fd_fseq_join( fd_wksp_pod_map( pods[ j ], snprintf1( buf, 64, "fseq%lu", i ) ) );
@@ -240,6 +268,8 @@ run_monitor( config_t * const config,
         for( ulong i=0; i<config->layout.verify_tile_count; i++ ) {
           links[ link_idx ].src_name = "verify";
           links[ link_idx ].dst_name = "dedup";
+          links[ link_idx ].dst_kind_idx = 0UL;
+          links[ link_idx ].dst_in_idx   = i;
           links[ link_idx ].mcache = fd_mcache_join( fd_wksp_pod_map( pods[ j ], snprintf1( buf, 64, "mcache%lu", i ) ) );
           if( FD_UNLIKELY( !links[ link_idx ].mcache ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
           links[ link_idx ].fseq = fd_fseq_join( fd_wksp_pod_map( pods[ j ], snprintf1( buf, 64, "fseq%lu", i ) ) );
@@ -248,18 +278,24 @@ run_monitor( config_t * const config,
         }
         break;
       case wksp_dedup_pack:
-        links[ link_idx ].src_name = "dedup";
-        links[ link_idx ].dst_name = "pack";
-        links[ link_idx ].mcache = fd_mcache_join( fd_wksp_pod_map( pods[ j ], "mcache" ) );
-        if( FD_UNLIKELY( !links[ link_idx ].mcache ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
-        links[ link_idx ].fseq = fd_fseq_join( fd_wksp_pod_map( pods[ j ], "fseq" ) );
-        if( FD_UNLIKELY( !links[ link_idx ].fseq ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
-        link_idx++;
+        for( ulong i=0; i<config->layout.pack_tile_count; i++ ) {
+          links[ link_idx ].src_name = "dedup";
+          links[ link_idx ].dst_name = "pack";
+          links[ link_idx ].dst_kind_idx = i;
+          links[ link_idx ].dst_in_idx   = 0UL;
+          links[ link_idx ].mcache = fd_mcache_join( fd_wksp_pod_map( pods[ j ], "mcache" ) );
+          if( FD_UNLIKELY( !links[ link_idx ].mcache ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
+          links[ link_idx ].fseq = fd_fseq_join( fd_wksp_pod_map( pods[ j ], snprintf1( buf, 64, "fseq%lu", i ) ) );
+          if( FD_UNLIKELY( !links[ link_idx ].fseq ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
+          link_idx++;
+        }
         break;
       case wksp_pack_bank:
         for( ulong i=0; i<config->layout.bank_tile_count; i++ ) {
           links[ link_idx ].src_name = "pack";
           links[ link_idx ].dst_name = "bank";
+          links[ link_idx ].dst_kind_idx = i;
+          links[ link_idx ].dst_in_idx   = 0UL;
           links[ link_idx ].mcache = fd_mcache_join( fd_wksp_pod_map( pods[ j ], snprintf1( buf, 64, "mcache%lu", i ) ) );
           if( FD_UNLIKELY( !links[ link_idx ].mcache ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
           links[ link_idx ].fseq = fd_fseq_join( fd_wksp_pod_map( pods[ j ], snprintf1( buf, 64, "fseq%lu", i ) ) );
@@ -268,16 +304,24 @@ run_monitor( config_t * const config,
 
           links[ link_idx ].src_name = "bank";
           links[ link_idx ].dst_name = "pack";
+          links[ link_idx ].dst_kind_idx = i/bank_per_pack;
+          links[ link_idx ].dst_in_idx   = 1UL+i%bank_per_pack;
           links[ link_idx ].mcache = fd_mcache_join( fd_wksp_pod_map( pods[ j ], snprintf1( buf, 64, "mcache-back%lu", i ) ) );
           if( FD_UNLIKELY( !links[ link_idx ].mcache ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
           links[ link_idx ].fseq = fd_fseq_join( fd_wksp_pod_map( pods[ j ], snprintf1( buf, 64, "fseq-back%lu", i ) ) );
           if( FD_UNLIKELY( !links[ link_idx ].fseq ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
           link_idx++;
         }
+        if( FD_LIKELY( fd_pod_query_cstr( pods[ j ], "fee_stats", NULL ) ) ) {
+          fee_stats = fd_fee_stats_join( fd_wksp_pod_map( pods[ j ], "fee_stats" ) );
+          if( FD_UNLIKELY( !fee_stats ) ) FD_LOG_ERR(( "fd_fee_stats_join failed" ));
+        }
         break;
       case wksp_pack_forward:
         links[ link_idx ].src_name = "pack";
         links[ link_idx ].dst_name = "forward";
+        links[ link_idx ].dst_kind_idx = 0UL;
+        links[ link_idx ].dst_in_idx   = 0UL;
         links[ link_idx ].mcache = fd_mcache_join( fd_wksp_pod_map( pods[ j ], "mcache" ) );
         if( FD_UNLIKELY( !links[ link_idx ].mcache ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
         links[ link_idx ].fseq = fd_fseq_join( fd_wksp_pod_map( pods[ j ], "fseq" ) );
@@ -288,6 +332,7 @@ run_monitor( config_t * const config,
         break;
       case wksp_quic:
         tiles[ tile_idx ].name = "quic";
+        tiles[ tile_idx ].kind_idx = wksp->kind_idx;
         tiles[ tile_idx ].cnc = fd_cnc_join( fd_wksp_pod_map( pod, "cnc" ) );
         if( FD_UNLIKELY( !tiles[ tile_idx ].cnc ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
         if( FD_UNLIKELY( fd_cnc_app_sz( tiles[ tile_idx ].cnc )<64UL ) ) FD_LOG_ERR(( "cnc app sz should be at least 64 bytes" ));
@@ -295,6 +340,7 @@ run_monitor( config_t * const config,
         break;
       case wksp_verify:
         tiles[ tile_idx ].name = "verify";
+        tiles[ tile_idx ].kind_idx = wksp->kind_idx;
         tiles[ tile_idx ].cnc = fd_cnc_join( fd_wksp_pod_map( pod, "cnc" ) );
         if( FD_UNLIKELY( !tiles[tile_idx].cnc ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
         if( FD_UNLIKELY( fd_cnc_app_sz( tiles[ tile_idx ].cnc )<64UL ) ) FD_LOG_ERR(( "cnc app sz should be at least 64 bytes" ));
@@ -302,6 +348,7 @@ run_monitor( config_t * const config,
         break;
       case wksp_dedup:
         tiles[ tile_idx ].name = "dedup";
+        tiles[ tile_idx ].kind_idx = wksp->kind_idx;
         tiles[ tile_idx ].cnc = fd_cnc_join( fd_wksp_pod_map( pod, "cnc" ) );
         if( FD_UNLIKELY( !tiles[ tile_idx ].cnc ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
         if( FD_UNLIKELY( fd_cnc_app_sz( tiles[ tile_idx ].cnc )<64UL ) ) FD_LOG_ERR(( "cnc app sz should be at least 64 bytes" ));
@@ -309,6 +356,7 @@ run_monitor( config_t * const config,
         break;
       case wksp_pack:
         tiles[ tile_idx ].name = "pack";
+        tiles[ tile_idx ].kind_idx = wksp->kind_idx;
         tiles[ tile_idx ].cnc = fd_cnc_join( fd_wksp_pod_map( pod, "cnc" ) );
         if( FD_UNLIKELY( !tiles[ tile_idx ].cnc ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
         if( FD_UNLIKELY( fd_cnc_app_sz( tiles[ tile_idx ].cnc )<64UL ) ) FD_LOG_ERR(( "cnc app sz should be at least 64 bytes" ));
@@ -316,6 +364,7 @@ run_monitor( config_t * const config,
         break;
       case wksp_bank:
         tiles[ tile_idx ].name = "bank";
+        tiles[ tile_idx ].kind_idx = wksp->kind_idx;
         tiles[ tile_idx ].cnc = fd_cnc_join( fd_wksp_pod_map( pod, "cnc" ) );
         if( FD_UNLIKELY( !tiles[ tile_idx ].cnc ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
         if( FD_UNLIKELY( fd_cnc_app_sz( tiles[ tile_idx ].cnc )<64UL ) ) FD_LOG_ERR(( "cnc app sz should be at least 64 bytes" ));
@@ -323,6 +372,7 @@ run_monitor( config_t * const config,
         break;
       case wksp_forward:
         tiles[ tile_idx ].name = "forward";
+        tiles[ tile_idx ].kind_idx = wksp->kind_idx;
         tiles[ tile_idx ].cnc = fd_cnc_join( fd_wksp_pod_map( pod, "cnc" ) );
         if( FD_UNLIKELY( !tiles[ tile_idx ].cnc ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
         if( FD_UNLIKELY( fd_cnc_app_sz( tiles[ tile_idx ].cnc )<64UL ) ) FD_LOG_ERR(( "cnc app sz should be at least 64 bytes" ));
@@ -334,6 +384,18 @@ run_monitor( config_t * const config,
   FD_TEST( tile_idx == tile_cnt );
   FD_TEST( link_idx == link_cnt );
 
+  /* Find the latency histograms each link's consumer keeps for it */
+  for( ulong i=0UL; i<link_cnt; i++ ) {
+    link_t * link = &links[ i ];
+    link->lat = NULL;
+    for( ulong j=0UL; j<tile_cnt; j++ ) {
+      if( strcmp( tiles[ j ].name, link->dst_name ) || tiles[ j ].kind_idx!=link->dst_kind_idx ) continue;
+      uint const * lat = fd_lat_cnc_laddr_const( tiles[ j ].cnc, link->dst_in_idx+1UL );
+      if( FD_LIKELY( lat ) ) link->lat = fd_lat_link_const( lat, link->dst_in_idx );
+      break;
+    }
+  }
+
   /* Setup local objects used by this app */
   fd_rng_t _rng[1];
   fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, seed, 0UL ) );
@@ -447,6 +509,42 @@ run_monitor( config_t * const config,
       PRINT( TEXT_NEWLINE );
     }
 
+    PRINT( TEXT_NEWLINE );
+    PRINT( "             link |  orig p50 |  orig p99 | orig p999 |   pub p50 |   pub p99 |  pub p999" TEXT_NEWLINE );
+    PRINT( "------------------+-----------+-----------+-----------+-----------+-----------+-----------" TEXT_NEWLINE );
+    for( ulong link_idx=0UL; link_idx<link_cnt; link_idx++ ) {
+      link_snap_t * prv = &link_snap_prv[ link_idx ];
+      link_snap_t * cur = &link_snap_cur[ link_idx ];
+      PRINT( " %7s->%-7s", links[ link_idx ].src_name, links[ link_idx ].dst_name );
+      static double const q[3] = { 0.5, 0.99, 0.999 };
+      for( ulong h=0UL; h<2UL; h++ ) {
+        uint const * hist_cur = cur->lat + h*FD_LAT_BKT_CNT;
+        uint const * hist_prv = prv->lat + h*FD_LAT_BKT_CNT;
+        for( ulong k=0UL; k<3UL; k++ ) { PRINT( " | " ); printf_lat( &buf, &buf_sz, hist_cur, hist_prv, q[k], ns_per_tic ); }
+      }
+      PRINT( TEXT_NEWLINE );
+    }
+
+    if( FD_LIKELY( fee_stats ) ) {
+      /* Fees are in micro-lamports per CU, see fd_fee_stats.h */
+      fd_fee_stats_acct_t accts[ FD_FEE_STATS_ACCT_MAX ];
+      ulong pending_cnt;
+      ulong acct_cnt = fd_fee_stats_read( fee_stats, accts, &pending_cnt );
+      PRINT( TEXT_NEWLINE );
+      PRINT( "                                  hot account |  pending | min uL/CU | med uL/CU |  block CUs   (%10lu pending)" TEXT_NEWLINE, pending_cnt );
+      PRINT( "----------------------------------------------+----------+-----------+-----------+-----------" TEXT_NEWLINE );
+      for( ulong i=0UL; i<FD_MONITOR_FEE_ROW_CNT; i++ ) {
+        if( FD_UNLIKELY( i>=acct_cnt ) ) {
+          PRINT( " %44s | %8s | %9s | %9s | %9s" TEXT_NEWLINE, "-", "-", "-", "-", "-" );
+          continue;
+        }
+        char key_cstr[ FD_BASE58_ENCODED_32_SZ ];
+        fd_base58_encode_32( accts[ i ].key.b, NULL, key_cstr );
+        PRINT( " %44s | %8lu | %9lu | %9lu | %9lu" TEXT_NEWLINE, key_cstr, accts[ i ].pending_cnt, accts[ i ].min_fee_per_cu,
+               accts[ i ].median_fee_per_cu, accts[ i ].cus_scheduled );
+      }
+    }
+
     /* write entire monitor output buffer */
     write_stdout( buffer, sizeof(buffer) - buf_sz );
 
@@ -25,6 +25,8 @@ run_cmd_perm( args_t *         args,
   check_res( security, "run", RLIMIT_NOFILE, 1024000, "increase `RLIMIT_NOFILE` to allow more open files for Solana Labs" );
   check_cap( security, "run", CAP_NET_RAW, "call `bind(2)` to bind to a socket with `SOCK_RAW`" );
   check_cap( security, "run", CAP_SYS_ADMIN, "initialize XDP by calling `bpf_obj_get`" );
+  if( FD_UNLIKELY( config->tiles.quic.xdp_busy_poll_usecs ) )
+    check_cap( security, "run", CAP_NET_ADMIN, "busy poll network devices with `SO_PREFER_BUSY_POLL`" );
   if( FD_LIKELY( getuid() != config->uid ) )
     check_cap( security, "run", CAP_SETUID, "switch uid by calling `setuid(2)`" );
   if( FD_LIKELY( getgid() != config->gid ) )
@@ -344,7 +346,7 @@ main_pid_namespace( void * args ) {
   ushort tile_to_cpu[ FD_TILE_MAX ];
   ulong  affinity_tile_cnt = fd_tile_private_cpus_parse( config->layout.affinity, tile_to_cpu );
   /* TODO: Can we use something like config->shmem.workspaces_cnt = idx; here instead? */
-   ulong tile_cnt = 4UL + config->layout.verify_tile_count * 2;
+   ulong tile_cnt = 3UL + config->layout.pack_tile_count + config->layout.verify_tile_count * 2;
   if( FD_UNLIKELY( affinity_tile_cnt<tile_cnt ) ) FD_LOG_ERR(( "at least %lu tiles required for this config", tile_cnt ));
   if( FD_UNLIKELY( affinity_tile_cnt>tile_cnt ) ) FD_LOG_WARNING(( "only %lu tiles required for this config", tile_cnt ));
 
@@ -377,7 +379,7 @@ main_pid_namespace( void * args ) {
   for( ulong i=0; i<config->layout.verify_tile_count; i++ ) clone_tile( &spawner, &frank_quic, i );
   for( ulong i=0; i<config->layout.verify_tile_count; i++ ) clone_tile( &spawner, &frank_verify, i );
   clone_tile( &spawner, &frank_dedup, 0 );
-  clone_tile( &spawner, &frank_pack , 0 );
+  for( ulong i=0; i<config->layout.pack_tile_count; i++ ) clone_tile( &spawner, &frank_pack, i );
   clone_tile( &spawner, &frank_forward , 0 );
 
   if( FD_UNLIKELY( sched_setaffinity( 0, sizeof(cpu_set_t), floating_cpu_set ) ) )
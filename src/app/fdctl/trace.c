@@ -0,0 +1,220 @@
+#include "fdctl.h"
+
+#include "run.h"
+#include "../../disco/fd_disco.h"
+
+#include <stdio.h>
+#include <sys/syscall.h>
+#include <linux/capability.h>
+
+/* fdctl trace polls the traces of the tiles on the transaction ingest
+   path (see [development.trace] and fd_trace.h) for a while, stitches
+   the events the tiles recorded into per transaction timelines by trace
+   key and prints the timelines of the slowest transactions that made it
+   all the way from a QUIC tile into a microblock. */
+
+#define TRACE_MAX (256UL)     /* Max traced tiles */
+#define EVENT_MAX (1UL<<19)   /* Max events collected, 16 MiB */
+#define TXN_MAX   (EVENT_MAX/2UL)
+
+typedef struct {
+  ulong off;   /* Timeline is events[ off, off+cnt ) */
+  ulong cnt;
+  long  dt;    /* Ticks from the QUIC rx to the pack pub */
+} txn_t;
+
+#define SORT_NAME        sort_event
+#define SORT_KEY_T       fd_trace_event_t
+#define SORT_BEFORE(a,b) ((a).key<(b).key || ((a).key==(b).key && (a).ts<(b).ts))
+#include "../../util/tmpl/fd_sort.c"
+
+#define SORT_NAME        sort_txn
+#define SORT_KEY_T       txn_t
+#define SORT_BEFORE(a,b) ((a).dt>(b).dt)
+#include "../../util/tmpl/fd_sort.c"
+
+static fd_trace_event_t events[ EVENT_MAX ];
+static txn_t            txns  [ TXN_MAX   ];
+
+void
+trace_cmd_args( int *    pargc,
+                char *** pargv,
+                args_t * args ) {
+  args->trace.duration   = fd_env_strip_cmdline_long ( pargc, pargv, "--duration", NULL, 1000000000. );
+  args->trace.dt         = fd_env_strip_cmdline_long ( pargc, pargv, "--dt",       NULL,   10000000. );
+  args->trace.txn_cnt    = fd_env_strip_cmdline_ulong( pargc, pargv, "--txn-cnt",  NULL,         16UL );
+  args->trace.ns_per_tic = 1./fd_tempo_tick_per_ns( NULL ); /* calibrate during init */
+
+  if( FD_UNLIKELY( args->trace.duration<=0L ) ) FD_LOG_ERR(( "--duration should be positive" ));
+  if( FD_UNLIKELY( args->trace.dt<=0L       ) ) FD_LOG_ERR(( "--dt should be positive"       ));
+}
+
+void
+trace_cmd_perm( args_t *         args,
+                security_t *     security,
+                config_t * const config ) {
+  (void)args;
+
+  ulong limit = memlock_max_bytes( config );
+  check_res( security, "trace", RLIMIT_MEMLOCK, limit, "increase `RLIMIT_MEMLOCK` to lock the workspace in memory with `mlock(2)`" );
+  if( getuid() != config->uid )
+    check_cap( security, "trace", CAP_SETUID, "switch uid by calling `setuid(2)`" );
+  if( getgid() != config->gid )
+    check_cap( security, "trace", CAP_SETGID, "switch gid by calling `setgid(2)`" );
+}
+
+static int
+is_kind( config_t * const config,
+         ulong            tile,
+         int              kind ) {
+  return tile<config->shmem.workspaces_cnt && (int)config->shmem.workspaces[ tile ].kind==kind;
+}
+
+static void
+run_trace( config_t * const    config,
+           fd_trace_t const ** traces,
+           ulong               trace_cnt,
+           long                duration,
+           long                dt,
+           ulong               txn_max,
+           double              ns_per_tic ) {
+
+  /* Poll the traces for duration, collecting everything they record */
+
+  ulong cursor[ TRACE_MAX ];
+  for( ulong i=0UL; i<trace_cnt; i++ ) cursor[ i ] = fd_trace_cursor( traces[ i ] );
+
+  ulong event_cnt = 0UL;
+  ulong lost_cnt  = 0UL;
+  long  stop      = fd_log_wallclock() + duration;
+  for(;;) {
+    for( ulong i=0UL; i<trace_cnt; i++ ) {
+      ulong lost;
+      event_cnt += fd_trace_snap( traces[ i ], cursor[ i ], events + event_cnt, EVENT_MAX - event_cnt, cursor + i, &lost );
+      lost_cnt  += lost;
+    }
+    if( FD_UNLIKELY( event_cnt==EVENT_MAX ) ) {
+      FD_LOG_WARNING(( "collected %lu events, stopping early", EVENT_MAX ));
+      break;
+    }
+    if( FD_UNLIKELY( (fd_log_wallclock()-stop)>=0L ) ) break;
+    fd_log_sleep( dt );
+  }
+
+  /* Stitch the events into timelines.  A transaction is complete if its
+     timeline has the QUIC tile receiving it and a pack tile putting it
+     in a microblock. */
+
+  sort_event_inplace( events, event_cnt );
+
+  ulong key_cnt  = 0UL;
+  ulong filt_cnt = 0UL;
+  ulong txn_cnt  = 0UL;
+  for( ulong off=0UL; off<event_cnt; ) {
+    ulong key  = events[ off ].key;
+    ulong cnt  = 1UL;
+    while( off+cnt<event_cnt && events[ off+cnt ].key==key ) cnt++;
+
+    long rx   = LONG_MAX;
+    long pub  = LONG_MIN;
+    int  filt = 0;
+    for( ulong i=off; i<off+cnt; i++ ) {
+      fd_trace_event_t const * e = events + i;
+      if( e->event==FD_TRACE_EVENT_RX  && is_kind( config, e->tile, wksp_quic ) ) rx  = fd_long_min( rx,  e->ts );
+      if( e->event==FD_TRACE_EVENT_PUB && is_kind( config, e->tile, wksp_pack ) ) pub = fd_long_max( pub, e->ts );
+      filt |= e->event==FD_TRACE_EVENT_FILT;
+    }
+
+    key_cnt++;
+    filt_cnt += (ulong)filt;
+    if( rx!=LONG_MAX && pub!=LONG_MIN && txn_cnt<TXN_MAX ) txns[ txn_cnt++ ] = (txn_t){ .off = off, .cnt = cnt, .dt = pub-rx };
+    off += cnt;
+  }
+
+  sort_txn_inplace( txns, txn_cnt );
+
+  printf( "%lu events from %lu tiles (%lu lost), %lu transactions, %lu complete, %lu with a drop\n",
+          event_cnt, trace_cnt, lost_cnt, key_cnt, txn_cnt, filt_cnt );
+  if( FD_UNLIKELY( lost_cnt ) )
+    printf( "events were lost, poll more often with --dt or increase [development.trace.depth]\n" );
+  if( FD_LIKELY( txn_cnt ) )
+    printf( "end-to-end p50 %.3f us, p99 %.3f us, max %.3f us\n",
+            1e-3*ns_per_tic*(double)txns[ txn_cnt/2UL ].dt,
+            1e-3*ns_per_tic*(double)txns[ txn_cnt/100UL ].dt,
+            1e-3*ns_per_tic*(double)txns[ 0 ].dt );
+
+  for( ulong t=0UL; t<fd_ulong_min( txn_max, txn_cnt ); t++ ) {
+    txn_t const * txn = txns + t;
+    printf( "\ntxn %016lx: %.3f us\n", events[ txn->off ].key, 1e-3*ns_per_tic*(double)txn->dt );
+    long ts0 = events[ txn->off ].ts;
+    long prv = ts0;
+    for( ulong i=txn->off; i<txn->off+txn->cnt; i++ ) {
+      fd_trace_event_t const * e    = events + i;
+      workspace_config_t *     wksp = &config->shmem.workspaces[ e->tile ];
+      printf( "  %+12.3f us (%+12.3f us) %7s%-3lu %-4s link %-3u seq %lu\n",
+              1e-3*ns_per_tic*(double)(e->ts-ts0), 1e-3*ns_per_tic*(double)(e->ts-prv),
+              wksp->name, wksp->kind_idx, fd_trace_event_cstr( e->event ), (uint)e->link, e->seq );
+      prv = e->ts;
+    }
+  }
+  fflush( stdout );
+}
+
+void
+trace_cmd_fn( args_t *         args,
+              config_t * const config ) {
+  ulong              trace_cnt = 0UL;
+  fd_trace_t const * traces[ TRACE_MAX ];
+  for( ulong i=0; i<config->shmem.workspaces_cnt; i++ ) {
+    workspace_config_t * wksp = &config->shmem.workspaces[ i ];
+    switch( wksp->kind ) {
+      case wksp_quic:
+      case wksp_verify:
+      case wksp_dedup:
+      case wksp_pack: {
+        const uchar * pod = workspace_pod_join( config->name, wksp->name, wksp->kind_idx );
+        if( FD_UNLIKELY( !fd_pod_query_cstr( pod, "trace", NULL ) ) ) break;
+        fd_trace_t const * trace = fd_trace_join( fd_wksp_pod_map( pod, "trace" ) );
+        if( FD_UNLIKELY( !trace ) ) FD_LOG_ERR(( "fd_trace_join failed for %s%lu", wksp->name, wksp->kind_idx ));
+        traces[ trace_cnt++ ] = trace;
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  if( FD_UNLIKELY( !trace_cnt ) ) FD_LOG_ERR(( "no tiles are tracing, enable [development.trace] and restart" ));
+
+  long allow_syscalls[] = {
+    __NR_write,        /* logging, output */
+    __NR_fsync,        /* logging, WARNING and above fsync immediately */
+    __NR_nanosleep,    /* fd_log_sleep */
+    __NR_sched_yield,  /* fd_log_sleep */
+    __NR_exit_group,   /* exit process */
+  };
+
+  int allow_fds[] = {
+    1, /* stdout */
+    2, /* stderr */
+    3, /* logfile */
+  };
+
+  if( FD_UNLIKELY( close( 0 ) ) ) FD_LOG_ERR(( "close(0) failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  fd_sandbox( config->development.sandbox,
+              config->uid,
+              config->gid,
+              sizeof(allow_fds)/sizeof(allow_fds[ 0 ]),
+              allow_fds,
+              (ushort)(sizeof(allow_syscalls)/sizeof(allow_syscalls[ 0 ])),
+              allow_syscalls );
+
+  run_trace( config,
+             traces,
+             trace_cnt,
+             args->trace.duration,
+             args->trace.dt,
+             args->trace.txn_cnt,
+             args->trace.ns_per_tic );
+
+  exit_group( 0 );
+}
@@ -73,6 +73,19 @@ init( config_t * const config ) {
        interface0, interface0 );
   RUN( "nsenter --net=/var/run/netns/%s ethtool -K %s tx-gre-segmentation off",
        interface1, interface1 );
+
+  /* veth only runs a NAPI context per rx queue (which the QUIC tiles
+     can busy poll) with GRO or a native XDP program, and only defers
+     its interrupts if asked to, the same as a real NIC configured by
+     the ethtool stage */
+  if( FD_UNLIKELY( config->tiles.quic.xdp_busy_poll_usecs ) ) {
+    RUN( "nsenter --net=/var/run/netns/%s ethtool -K %s gro on",
+         interface0, interface0 );
+    RUN( "ip netns exec %s sh -c 'echo %u > /sys/class/net/%s/napi_defer_hard_irqs'",
+         interface0, NAPI_DEFER_HARD_IRQS, interface0 );
+    RUN( "ip netns exec %s sh -c 'echo %u > /sys/class/net/%s/gro_flush_timeout'",
+         interface0, GRO_FLUSH_TIMEOUT, interface0 );
+  }
 }
 
 static void
@@ -26,6 +26,14 @@
 
 #define FD_FRANK_CNC_DIAG_PID         (128UL)
 
+/* Tiles that consume frags also accumulate the standard per in latency
+   histograms (see fd_lat.h) at FD_LAT_CNC_APP_OFF in their cnc app
+   region (past FD_FRANK_CNC_DIAG_PID) when the region is large enough
+   (fd_lat_cnc_laddr).  Ins are indexed in the order the tile joins them
+   (for pack, the dedup link is in 0 and bank i's back link is in 1+i). */
+
+FD_STATIC_ASSERT( FD_LAT_CNC_APP_OFF>=(FD_FRANK_CNC_DIAG_PID+1UL)*sizeof(ulong), frank_cnc_layout );
+
 typedef struct {
    int           pid;
    char *        app_name;
@@ -52,6 +60,23 @@ typedef struct {
    void  (*run )( fd_frank_args_t * args );
 } fd_frank_task_t;
 
+/* fd_frank_trace_join joins the tile's trace (see fd_trace.h), which is
+   the "trace" entry of its tile pod.  Returns NULL if the tile has no
+   trace, i.e. tracing is off.  Tiles that trace use the same keys as
+   the verify tiles use for the sig of their frags (the first 8 bytes of
+   the transaction's first signature) such that every tile samples the
+   same transactions. */
+
+static inline fd_trace_t *
+fd_frank_trace_join( fd_frank_args_t const * args ) {
+  if( FD_LIKELY( !fd_pod_query_cstr( args->tile_pod, "trace", NULL ) ) ) return NULL;
+  FD_LOG_INFO(( "joining trace" ));
+  fd_trace_t * trace = fd_trace_join( fd_wksp_pod_map( args->tile_pod, "trace" ) );
+  if( FD_UNLIKELY( !trace ) ) FD_LOG_ERR(( "fd_trace_join failed" ));
+  FD_LOG_INFO(( "tracing 1 in 2^%lu transactions", fd_trace_lg_sample( trace ) ));
+  return trace;
+}
+
 extern fd_frank_task_t frank_verify;
 extern fd_frank_task_t frank_dedup;
 extern fd_frank_task_t frank_quic;
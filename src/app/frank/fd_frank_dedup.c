@@ -52,9 +52,23 @@ run( fd_frank_args_t * args ) {
   fd_frag_meta_t * mcache = fd_mcache_join( fd_wksp_pod_map( args->out_pod, "mcache" ) );
   if( FD_UNLIKELY( !mcache ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
 
-  FD_LOG_INFO(( "joining fseq" ));
-  ulong * out_fseq = fd_fseq_join( fd_wksp_pod_map( args->out_pod, "fseq" ) );
-  if( FD_UNLIKELY( !out_fseq ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
+  /* One consumer per pack tile */
+  ulong out_cnt = fd_pod_query_ulong( args->out_pod, "cnt", 1UL );
+  if( FD_UNLIKELY( !out_cnt ) ) FD_LOG_ERR(( "cnt is zero" ));
+  FD_LOG_INFO(( "%lu pack found", out_cnt ));
+
+  ulong ** out_fseq = (ulong **)fd_alloca( alignof(ulong *), sizeof(ulong *)*out_cnt );
+  if( FD_UNLIKELY( !out_fseq ) ) FD_LOG_ERR(( "fd_alloca failed" ));
+
+  for( ulong i=0; i<out_cnt; i++ ) {
+    char path[ 32 ];
+    snprintf( path, 32, "fseq%lu", i );
+    FD_LOG_INFO(( "joining fseq%lu", i ));
+    out_fseq[ i ] = fd_fseq_join( fd_wksp_pod_map( args->out_pod, path ) );
+    if( FD_UNLIKELY( !out_fseq[ i ] ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
+  }
+
+  fd_trace_t * trace = fd_frank_trace_join( args );
 
   /* Setup local objects used by this tile */
 
@@ -69,7 +83,7 @@ run( fd_frank_args_t * args ) {
   if( FD_UNLIKELY( !rng ) ) FD_LOG_ERR(( "fd_rng_join failed" ));
 
   FD_LOG_INFO(( "creating scratch" ));
-  ulong footprint = fd_dedup_tile_scratch_footprint( in_cnt, 1UL );
+  ulong footprint = fd_dedup_tile_scratch_footprint( in_cnt, out_cnt );
   if( FD_UNLIKELY( !footprint ) ) FD_LOG_ERR(( "fd_dedup_tile_scratch_footprint failed" ));
   void * scratch = fd_alloca( FD_DEDUP_TILE_SCRATCH_ALIGN, footprint );
   if( FD_UNLIKELY( !scratch ) ) FD_LOG_ERR(( "fd_alloca failed" ));
@@ -77,7 +91,7 @@ run( fd_frank_args_t * args ) {
   /* Start deduping */
 
   FD_LOG_INFO(( "dedup run" ));
-  int err = fd_dedup_tile( cnc, in_cnt, in_mcache, in_fseq, tcache, mcache, 1UL, &out_fseq, cr_max, lazy, rng, scratch, args->tick_per_ns );
+  int err = fd_dedup_tile( cnc, in_cnt, in_mcache, in_fseq, tcache, mcache, trace, out_cnt, out_fseq, cr_max, lazy, rng, scratch, args->tick_per_ns );
   if( FD_UNLIKELY( err ) ) FD_LOG_ERR(( "fd_dedup_tile failed (%i)", err ));
 }
 
@@ -13,6 +13,9 @@ run( fd_frank_args_t * args ) {
   ulong * cnc_diag = (ulong *)fd_cnc_app_laddr( cnc );
   cnc_diag[ FD_FRANK_CNC_DIAG_PID ] = (ulong)args->pid;
 
+  /* Latency histograms for the pack link (NULL if no room) */
+  uint * lat = fd_lat_cnc_laddr( cnc, 1UL );
+
   FD_LOG_INFO(( "joining mcache" ));
   fd_frag_meta_t const * mcache = fd_mcache_join( fd_wksp_pod_map( args->in_pod, "mcache" ) );
   if( FD_UNLIKELY( !mcache ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
@@ -114,6 +117,8 @@ run( fd_frank_args_t * args ) {
     }
 
     now = fd_tickcount();
+    ulong tsorig = (ulong)mline->tsorig;
+    ulong tspub  = (ulong)mline->tspub;
 
     /* Check that we weren't overrun while processing */
     seq_found = fd_frag_meta_seq_query( mline );
@@ -123,6 +128,8 @@ run( fd_frank_args_t * args ) {
       continue;
     }
 
+    if( FD_LIKELY( lat ) ) fd_lat_sample( lat, now, tsorig, tspub );
+
     /* Wind up for the next iteration */
     seq   = fd_seq_inc( seq, 1UL );
     mline = mcache + fd_mcache_line_idx( seq, depth );
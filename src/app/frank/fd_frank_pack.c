@@ -10,6 +10,20 @@
 #define MAX_MICROBLOCK_SZ USHORT_MAX /* in bytes.  Defined this way to
                                         use the size field of mcache */
 
+/* A transaction can only land within this many slots of its recent
+   blockhash.  Pack doesn't know which slot the blockhash is from, so
+   it counts from when the transaction arrives, which is an upper
+   bound. */
+#define MAX_TXN_AGE_BLOCKS (150UL)
+
+/* The states of the coordinator of a sharded pack, run by shard 0:
+   IDLE, REQUESTED once it has asked the shards to park, and SCHEDULED
+   once it has scheduled its microblocks and is waiting for them to
+   finish. */
+#define COORD_STATE_IDLE      (0)
+#define COORD_STATE_REQUESTED (1)
+#define COORD_STATE_SCHEDULED (2)
+
 /* Helper struct containing all the state associated with one output */
 typedef struct {
   fd_frag_meta_t * out_mcache;
@@ -24,6 +38,14 @@ typedef struct {
   ulong            out_depth;
   fd_fctl_t      * out_fctl;
   uchar            _fctl_footprint[ FD_FCTL_FOOTPRINT( 1 ) ] __attribute__((aligned(FD_FCTL_ALIGN)));
+
+  /* The bank tile publishes one frag on its back link for each
+     microblock it finishes executing. */
+  fd_frag_meta_t const * back_mcache;
+  ulong                * back_fseq;
+  ulong                  back_depth;
+  ulong                  back_seq;
+  fd_frag_meta_t const * back_mline;
 } out_state;
 
 
@@ -32,7 +54,8 @@ typedef struct {
 static void
 join_out( out_state * state,
           uchar const * pod,
-          ulong         suffix ) {
+          ulong         suffix,
+          int           cr_adapt ) {
   char path[ 32 ];
 
   FD_LOG_INFO(( "joining mcache%lu", suffix ));
@@ -67,9 +90,12 @@ join_out( out_state * state,
                                       fd_fctl_join( fd_fctl_new( state->_fctl_footprint, 1UL ) ),
                                       out_depth, out_fseq, &fseq_diag[ FD_FSEQ_DIAG_SLOW_CNT ] ),
                                     1UL /*cr_burst*/, 0UL, 0UL, 0UL ); /* TODO: allow manual configuration of these? */
+  if( FD_UNLIKELY( !out_fctl ) ) FD_LOG_ERR(( "Unable to create flow control" ));
+  if( cr_adapt && FD_UNLIKELY( !fd_fctl_cfg_adapt( out_fctl ) ) ) FD_LOG_ERR(( "Unable to enable adaptive flow control" ));
 
-  FD_LOG_INFO(( "using cr_burst %lu, cr_max %lu, cr_resume %lu, cr_refill %lu",
-        fd_fctl_cr_burst( out_fctl ), fd_fctl_cr_max( out_fctl ), fd_fctl_cr_resume( out_fctl ), fd_fctl_cr_refill( out_fctl ) ));
+  FD_LOG_INFO(( "using cr_burst %lu, cr_max %lu, cr_resume %lu, cr_refill %lu, cr_adapt %i",
+        fd_fctl_cr_burst( out_fctl ), fd_fctl_cr_max( out_fctl ), fd_fctl_cr_resume( out_fctl ), fd_fctl_cr_refill( out_fctl ),
+        fd_fctl_adapt( out_fctl ) ));
 
   state->out_mcache   =  out_mcache;
   state->out_dcache   =  out_dcache;
@@ -82,6 +108,25 @@ join_out( out_state * state,
   state->out_cr_avail =  out_cr_avail;
   state->out_depth    =  out_depth;
   state->out_fctl     =  out_fctl;
+
+  FD_LOG_INFO(( "joining mcache-back%lu", suffix ));
+  snprintf( path, sizeof( path ), "mcache-back%lu", suffix );
+  fd_frag_meta_t const * back_mcache = fd_mcache_join( fd_wksp_pod_map( pod, path ) );
+  if( FD_UNLIKELY( !back_mcache ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
+
+  FD_LOG_INFO(( "joining fseq-back%lu", suffix ));
+  snprintf( path, sizeof( path ), "fseq-back%lu", suffix );
+  ulong * back_fseq = fd_fseq_join( fd_wksp_pod_map( pod, path ) );
+  if( FD_UNLIKELY( !back_fseq ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
+
+  ulong back_depth = fd_mcache_depth( back_mcache );
+  ulong back_seq   = fd_mcache_seq_query( fd_mcache_seq_laddr_const( back_mcache ) );
+
+  state->back_mcache  =  back_mcache;
+  state->back_fseq    =  back_fseq;
+  state->back_depth   =  back_depth;
+  state->back_seq     =  back_seq;
+  state->back_mline   =  back_mcache + fd_mcache_line_idx( back_seq, back_depth );
 }
 
 
@@ -97,6 +142,16 @@ run( fd_frank_args_t * args ) {
   ulong * cnc_diag = (ulong *)fd_cnc_app_laddr( cnc );
   cnc_diag[ FD_FRANK_CNC_DIAG_PID ] = (ulong)args->pid;
 
+  /* With more than one pack tile, each is a shard that only takes the
+     transactions whose accounts it owns, and shard 0 also runs the
+     coordinator, which takes the rest and schedules them on shard 0's
+     bank tiles while the shards are parked (see fd_pack_shard.h).
+     Every shard gets all of dedup's output, and the bank tiles are
+     split evenly between them. */
+  ulong shard_cnt = fd_pod_query_ulong( args->tile_pod, "shard_cnt", 1UL );
+  ulong shard_idx = fd_pod_query_ulong( args->tile_pod, "shard_idx", 0UL );
+  if( FD_UNLIKELY( shard_idx>=shard_cnt ) ) FD_LOG_ERR(( "pack.shard_idx %lu out of range for pack.shard_cnt %lu", shard_idx, shard_cnt ));
+
   FD_LOG_INFO(( "joining mcache" ));
   fd_frag_meta_t const * mcache = fd_mcache_join( fd_wksp_pod_map( args->in_pod, "mcache" ) );
   if( FD_UNLIKELY( !mcache ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
@@ -113,8 +168,10 @@ run( fd_frank_args_t * args ) {
   fd_wksp_t * wksp = fd_wksp_containing( dcache );
   if( FD_UNLIKELY( !wksp ) ) FD_LOG_ERR(( "fd_wksp_containing failed" ));
 
-  FD_LOG_INFO(( "joining fseq" ));
-  ulong * fseq = fd_fseq_join( fd_wksp_pod_map( args->in_pod, "fseq" ) );
+  FD_LOG_INFO(( "joining fseq%lu", shard_idx ));
+  char fseq_path[ 32 ];
+  snprintf( fseq_path, sizeof( fseq_path ), "fseq%lu", shard_idx );
+  ulong * fseq = fd_fseq_join( fd_wksp_pod_map( args->in_pod, fseq_path ) );
   if( FD_UNLIKELY( !fseq ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
   /* Hook up to this pack's flow control diagnostics (will be stored in
      the pack's fseq) */
@@ -131,8 +188,6 @@ run( fd_frank_args_t * args ) {
   ulong accum_ovrnp_cnt = 0UL;
   ulong accum_ovrnr_cnt = 0UL;
 
-  ulong gap = fd_pod_query_ulong( args->tile_pod, "min-gap", 0UL );
-
   ulong pack_depth = fd_pod_query_ulong( args->tile_pod, "depth", 0UL );
   if( FD_UNLIKELY( !pack_depth ) ) FD_LOG_ERR(( "pack.depth unset or set to zero" ));
 
@@ -140,16 +195,25 @@ run( fd_frank_args_t * args ) {
   out_state out[ FD_FRANK_PACK_MAX_OUT ];
 
   /* FIXME: Plumb this through properly: */
-  ulong bank_cnt = fd_pod_query_ulong( args->out_pod, "num_tiles", 0UL );
-  if( FD_UNLIKELY( !bank_cnt ) ) FD_LOG_ERR(( "pack.num_tiles unset or set to zero" ));
+  ulong bank_tile_cnt = fd_pod_query_ulong( args->out_pod, "num_tiles", 0UL );
+  if( FD_UNLIKELY( !bank_tile_cnt ) ) FD_LOG_ERR(( "pack.num_tiles unset or set to zero" ));
+  if( FD_UNLIKELY( bank_tile_cnt%shard_cnt ) ) FD_LOG_ERR(( "pack.num_tiles %lu not a multiple of pack.shard_cnt %lu", bank_tile_cnt, shard_cnt ));
+  ulong bank_cnt = bank_tile_cnt/shard_cnt;
   if( FD_UNLIKELY( bank_cnt>FD_FRANK_PACK_MAX_OUT ) ) FD_LOG_ERR(( "pack tile connects to too many banking tiles" ));
 
-  for( ulong i=0UL; i<bank_cnt; i++ ) join_out( out+i, args->out_pod, i );
+  int cr_adapt = fd_pod_query_int( args->tile_pod, "cr_adapt", 0 );
+  for( ulong i=0UL; i<bank_cnt; i++ ) join_out( out+i, args->out_pod, shard_idx*bank_cnt+i, cr_adapt );
+
+  /* Latency histograms for the dedup link (in 0) and the bank back
+     links (in 1+i), NULL if no room */
+  uint * lat = fd_lat_cnc_laddr( cnc, 1UL+bank_cnt );
+
+  fd_trace_t * trace = fd_frank_trace_join( args );
   fd_wksp_t * out_wksp = fd_wksp_containing( args->out_pod );
 
-  ulong max_txn_per_microblock = MAX_MICROBLOCK_SZ/sizeof(fd_txn_p_t);
+  ulong max_txn_per_microblock = MAX_MICROBLOCK_SZ/FD_PACK_MICROBLOCK_TXN_MAX_SZ;
 
-  ulong pack_footprint   = fd_pack_footprint( pack_depth, gap, max_txn_per_microblock );
+  ulong pack_footprint   = fd_pack_footprint( pack_depth, bank_cnt, max_txn_per_microblock );
 
   ulong cus_per_microblock = 1500000UL; /* 1.5 M cost units, enough for 1 max size transaction */
   float vote_fraction = 0.75;
@@ -173,14 +237,86 @@ run( fd_frank_args_t * args ) {
   if( FD_UNLIKELY( !pack_laddr ) ) FD_LOG_ERR(( "allocating memory for pack object failed" ));
 
 
-  fd_pack_t * pack = fd_pack_join( fd_pack_new( pack_laddr, pack_depth, gap, max_txn_per_microblock, rng ) );
+  fd_pack_t * pack = fd_pack_join( fd_pack_new( pack_laddr, pack_depth, bank_cnt, max_txn_per_microblock, rng ) );
+  if( FD_UNLIKELY( !pack ) ) FD_LOG_ERR(( "fd_pack_new failed" ));
+
+  fd_pack_shard_ctl_t * shard_ctl = NULL;
+  fd_pack_t           * coord     = NULL;
+  if( FD_UNLIKELY( shard_cnt>1UL ) ) {
+    FD_LOG_INFO(( "joining shard_ctl" ));
+    char const * shard_ctl_gaddr = fd_pod_query_cstr( args->out_pod, "shard_ctl", NULL );
+    if( FD_UNLIKELY( !shard_ctl_gaddr ) ) FD_LOG_ERR(( "pack.shard_cnt is %lu but there is no shard_ctl", shard_cnt ));
+    shard_ctl = fd_pack_shard_ctl_join( fd_wksp_map( shard_ctl_gaddr ) );
+    if( FD_UNLIKELY( !shard_ctl ) ) FD_LOG_ERR(( "fd_pack_shard_ctl_join failed" ));
+    if( FD_UNLIKELY( fd_pack_shard_ctl_shard_cnt( shard_ctl )!=shard_cnt ) ) FD_LOG_ERR(( "shard_ctl is for %lu shards, not %lu",
+                                                                                        fd_pack_shard_ctl_shard_cnt( shard_ctl ), shard_cnt ));
+    fd_pack_set_shard_ctl( pack, shard_ctl, 0 );
+
+    if( !shard_idx ) {
+      void * coord_laddr = fd_wksp_alloc_laddr( fd_wksp_containing( args->tile_pod ), fd_pack_align(), pack_footprint, FD_PACK_TAG );
+      if( FD_UNLIKELY( !coord_laddr ) ) FD_LOG_ERR(( "allocating memory for coordinator pack object failed" ));
+      coord = fd_pack_join( fd_pack_new( coord_laddr, pack_depth, bank_cnt, max_txn_per_microblock, rng ) );
+      if( FD_UNLIKELY( !coord ) ) FD_LOG_ERR(( "fd_pack_new failed" ));
+      fd_pack_set_shard_ctl( coord, shard_ctl, 1 );
+    }
+  }
 
+  /* The bank tiles record the CUs that transactions actually consume in
+     a table shared with pack, if there is one. */
+  char const * cu_est_gaddr = fd_pod_query_cstr( args->out_pod, "cu_est", NULL );
+  if( FD_LIKELY( cu_est_gaddr ) ) {
+    FD_LOG_INFO(( "joining cu_est" ));
+    fd_est_ftbl_t * cu_est = fd_est_ftbl_join( fd_wksp_map( cu_est_gaddr ) );
+    if( FD_UNLIKELY( !cu_est ) ) FD_LOG_ERR(( "fd_est_ftbl_join failed" ));
+    fd_pack_set_cu_est_tbl( pack, cu_est );
+    if( coord ) fd_pack_set_cu_est_tbl( coord, cu_est );
+  }
+
+  /* Likewise, the bank tiles keep the contents of the address lookup
+     tables they load in a cache shared with pack, if there is one. */
+  fd_alt_cache_t * alt_cache = NULL;
+  char const * alt_cache_gaddr = fd_pod_query_cstr( args->out_pod, "alt_cache", NULL );
+  if( FD_LIKELY( alt_cache_gaddr ) ) {
+    FD_LOG_INFO(( "joining alt_cache" ));
+    alt_cache = fd_alt_cache_join( fd_wksp_map( alt_cache_gaddr ) );
+    if( FD_UNLIKELY( !alt_cache ) ) FD_LOG_ERR(( "fd_alt_cache_join failed" ));
+    fd_pack_set_alt_cache( pack, alt_cache );
+    if( coord ) fd_pack_set_alt_cache( coord, alt_cache );
+  }
 
-  FD_LOG_INFO(( "packing blocks of at most %lu transactions with a parallelism of %lu", max_txn_per_microblock, gap ));
+  /* And the fee payer balances they see, to drop transactions that
+     can't be paid for. */
+  char const * balances_gaddr = fd_pod_query_cstr( args->out_pod, "balances", NULL );
+  if( FD_LIKELY( balances_gaddr ) ) {
+    FD_LOG_INFO(( "joining balances" ));
+    fd_balance_tbl_t * balances = fd_balance_tbl_join( fd_wksp_map( balances_gaddr ) );
+    if( FD_UNLIKELY( !balances ) ) FD_LOG_ERR(( "fd_balance_tbl_join failed" ));
+    fd_pack_set_balance_tbl( pack, balances );
+    if( coord ) fd_pack_set_balance_tbl( coord, balances );
+  }
+
+  /* Publish local fee market statistics for the monitor and RPC, if
+     there is a table for them.  The table has a single writer, so with
+     a sharded pack only shard 0 publishes, and the statistics cover
+     just the transactions routed to it.  The other shards don't keep
+     them at all. */
+  fd_fee_stats_t * fee_stats = NULL;
+  char const * fee_stats_gaddr = fd_pod_query_cstr( args->out_pod, "fee_stats", NULL );
+  if( FD_LIKELY( fee_stats_gaddr && !shard_idx ) ) {
+    FD_LOG_INFO(( "joining fee_stats" ));
+    fee_stats = fd_fee_stats_join( fd_wksp_map( fee_stats_gaddr ) );
+    if( FD_UNLIKELY( !fee_stats ) ) FD_LOG_ERR(( "fd_fee_stats_join failed" ));
+    fd_pack_set_fee_stats( pack, fee_stats );
+  }
+
+
+  FD_LOG_INFO(( "packing blocks of at most %lu transactions for %lu bank tiles", max_txn_per_microblock, bank_cnt ));
 
   const ulong block_duration_ns      = 400UL*1000UL*1000UL; /* 400ms */
+  const ulong fee_stats_interval_ns  =  10UL*1000UL*1000UL; /*  10ms */
 
-  long block_duration_ticks = (long)(args->tick_per_ns * (double)block_duration_ns);
+  long block_duration_ticks     = (long)(args->tick_per_ns * (double)block_duration_ns);
+  long fee_stats_interval_ticks = (long)(args->tick_per_ns * (double)fee_stats_interval_ns);
 
   int ctl_som = 1;
   int ctl_eom = 1;
@@ -195,6 +331,29 @@ run( fd_frank_args_t * args ) {
   long now            = fd_tickcount();
   long then           = now;            /* Do housekeeping on first iteration of run loop */
   long block_end      = now + block_duration_ticks;
+  long fee_stats_due  = now;
+  ulong block_cnt     = 0UL;
+
+  /* Shard 0 decides when blocks end and tells the other shards through
+     the shard ctl's block generation; they end theirs when they see it
+     change.  block_new_cnt is how many blocks a follower has seen start
+     that it hasn't ended yet. */
+  int   follow        = !!shard_ctl && !!shard_idx;
+  ulong block_gen     = shard_ctl ? fd_pack_shard_ctl_block_gen( shard_ctl ) : 0UL;
+  ulong block_new_cnt = 0UL;
+
+  /* outstanding: bit i is set if bank tile i has a microblock, from
+     either pack object, that it hasn't finished.  coord_state is one of
+     COORD_STATE_*.  coord_due is set at the end of a block if the
+     coordinator has anything pending, so that cross-shard transactions
+     don't wait for a full microblock's worth forever.  coord_stalled
+     is set if the coordinator parked the shards and then couldn't
+     schedule anything, so that it doesn't do that again until the next
+     block. */
+  ulong outstanding   = 0UL;
+  int   coord_state   = COORD_STATE_IDLE;
+  int   coord_due     = 0;
+  int   coord_stalled = 0;
   for(;;) {
 
     /* Do housekeeping at a low rate in the background */
@@ -216,6 +375,23 @@ run( fd_frank_args_t * args ) {
 
         /* Receive flow control credits */
         o->out_cr_avail = fd_fctl_tx_cr_update( o->out_fctl, o->out_cr_avail, o->out_seq );
+
+        /* Send flow control credits for the completion link */
+        fd_fctl_rx_cr_return( o->back_fseq, o->back_seq );
+      }
+
+      /* Has shard 0 started a new block? */
+      if( FD_UNLIKELY( follow ) ) {
+        ulong gen     = fd_pack_shard_ctl_block_gen( shard_ctl );
+        block_new_cnt = (gen-block_gen) & ((1UL<<FD_PACK_SHARD_GEN_BITS)-1UL);
+      }
+
+      /* Readers of the fee statistics don't need them any fresher, and
+         each publish dirties the table's cache lines, so they're
+         published at a much lower rate than the rest */
+      if( FD_UNLIKELY( fee_stats && (now-fee_stats_due)>=0L ) ) {
+        fd_pack_publish_fee_stats( pack );
+        fee_stats_due = now + fee_stats_interval_ticks;
       }
 
       /* Send diagnostic info */
@@ -243,25 +419,98 @@ run( fd_frank_args_t * args ) {
     }
 
     /* Are we ready to end the block? */
-    if( FD_UNLIKELY( (now-block_end)>=0L ) ) {
+    if( FD_UNLIKELY( follow ? !!block_new_cnt : (now-block_end)>=0L ) ) {
       fd_pack_end_block( pack );
       block_end += block_duration_ticks;
+      block_cnt += fd_ulong_if( follow, block_new_cnt, 1UL );
+      block_gen += block_new_cnt;
+      block_new_cnt = 0UL;
+      fd_pack_expire_before( pack, block_cnt );
+      if( FD_UNLIKELY( coord ) ) {
+        fd_pack_end_block( coord );
+        fd_pack_expire_before( coord, block_cnt );
+        fd_pack_shard_ctl_new_block( shard_ctl );
+        coord_due     = !!fd_pack_avail_txn_cnt( coord );
+        coord_stalled = 0;
+      }
     }
 
-    /* Is it time to schedule the next microblock? */
-    /* for each banking thread, if it has credits */
+    /* Have any bank tiles finished their microblocks?  Each frag on a
+       back link releases the account locks of that bank's outstanding
+       microblock. */
     for( ulong i=0UL; i<bank_cnt; i++ ) {
+      out_state * o = out+i;
+      ulong back_seq_found = fd_frag_meta_seq_query( o->back_mline );
+      long  back_diff      = fd_seq_diff( back_seq_found, o->back_seq );
+      if( FD_LIKELY( back_diff<0L ) ) continue; /* nothing new */
+      if( FD_UNLIKELY( back_diff>0L ) ) {
+        /* Overrun by the bank tile.  We only ever have one outstanding
+           microblock per bank, so any completion means it is done. */
+        accum_ovrnp_cnt++;
+        o->back_seq = back_seq_found;
+      }
+      if( FD_LIKELY( lat ) ) fd_lat_sample( fd_lat_link( lat, 1UL+i ), now, (ulong)o->back_mline->tsorig, (ulong)o->back_mline->tspub );
+      fd_pack_microblock_complete( pack, i );
+      if( FD_UNLIKELY( coord ) ) fd_pack_microblock_complete( coord, i );
+      outstanding &= ~(1UL<<i);
+      o->back_seq   = fd_seq_inc( o->back_seq, 1UL );
+      o->back_mline = o->back_mcache + fd_mcache_line_idx( o->back_seq, o->back_depth );
+    }
+
+    /* Does the coordinator need the shards to park, and once they
+       have, is it done? */
+    fd_pack_t * sched_pack = pack;
+    if( FD_UNLIKELY( coord ) ) {
+      if( coord_state==COORD_STATE_IDLE ) {
+        ulong coord_avail = fd_pack_avail_txn_cnt( coord );
+        if( FD_UNLIKELY( (!coord_stalled) & ((coord_avail>=max_txn_per_microblock) | (coord_due & !!coord_avail)) ) ) {
+          fd_pack_shard_ctl_request( shard_ctl );
+          coord_state = COORD_STATE_REQUESTED;
+        }
+      } else if( coord_state==COORD_STATE_SCHEDULED && !outstanding ) {
+        fd_pack_shard_ctl_release( shard_ctl );
+        coord_state = COORD_STATE_IDLE;
+        coord_due   = 0;
+      }
+    }
+    if( FD_UNLIKELY( shard_ctl && !fd_pack_shard_ctl_may_schedule( shard_ctl, shard_idx, !outstanding ) ) ) {
+      sched_pack = NULL;
+      if( FD_UNLIKELY( coord_state==COORD_STATE_REQUESTED && fd_pack_shard_ctl_quiesced( shard_ctl ) ) ) {
+        sched_pack  = coord;
+        coord_state = COORD_STATE_SCHEDULED;
+      }
+    }
+
+    /* Is it time to schedule the next microblock? */
+    /* for each banking thread, if it has credits.  Bank tiles that
+       have not finished their previous microblock are skipped by
+       pack. */
+    ulong sched_total = 0UL;
+    for( ulong i=0UL; sched_pack && i<bank_cnt; i++ ) {
       out_state * o = out+i;
       if( FD_LIKELY( o->out_cr_avail>0UL ) ) { /* optimize for the case we send a microblock */
-        void * microblock_dst = fd_chunk_to_laddr( out_wksp, o->out_chunk );
-        ulong schedule_cnt = fd_pack_schedule_next_microblock( pack, cus_per_microblock, vote_fraction, microblock_dst );
+        uchar * microblock_dst = fd_chunk_to_laddr( out_wksp, o->out_chunk );
+        ulong   msg_sz;
+        ulong schedule_cnt = fd_pack_schedule_next_microblock( sched_pack, cus_per_microblock, vote_fraction, i,
+                                                               microblock_dst, MAX_MICROBLOCK_SZ, &msg_sz );
+        sched_total += schedule_cnt;
         if( FD_LIKELY( schedule_cnt ) ) {
+          outstanding |= 1UL<<i;
           ulong tspub  = (ulong)fd_frag_meta_ts_comp( fd_tickcount() );
           ulong chunk  = o->out_chunk;
           ulong sig    = 0UL;
-          ulong msg_sz = schedule_cnt*sizeof(fd_txn_p_t);
 
-          fd_mcache_publish( o->out_mcache, o->out_depth, o->out_seq, sig, chunk, msg_sz, ctl, 0UL, tspub );
+          fd_mcache_publish( o->out_mcache, o->out_depth, o->out_seq, sig, chunk, msg_sz, ctl, tspub, tspub );
+
+          if( FD_UNLIKELY( trace ) ) { /* Microblock records carry the trace key of their txn in meta */
+            long ts = fd_tickcount();
+            fd_pack_microblock_txn_t const * rec = (fd_pack_microblock_txn_t const *)microblock_dst;
+            for( ulong j=0UL; j<schedule_cnt; j++ ) {
+              if( FD_UNLIKELY( fd_trace_sampled( trace, rec->meta ) ) )
+                fd_trace_record( trace, rec->meta, i, o->out_seq, FD_TRACE_EVENT_PUB, ts );
+              rec = fd_pack_microblock_txn_next( rec );
+            }
+          }
 
           o->out_chunk = fd_dcache_compact_next( o->out_chunk, msg_sz, o->out_chunk0, o->out_wmark );
           o->out_seq   = fd_seq_inc( o->out_seq, 1UL );
@@ -269,6 +518,7 @@ run( fd_frank_args_t * args ) {
         }
       }
     }
+    if( FD_UNLIKELY( sched_pack==coord && coord && !sched_total ) ) coord_stalled = 1;
     /* Normally, we have an "else, do housekeeping next iteration"
        branch here, but because we're using extremely short queues, we
        actually expect to spend a significant fraction of the time in
@@ -295,12 +545,12 @@ run( fd_frank_args_t * args ) {
     /* At this point, we have started receiving frag seq with details in
        mline at time now.  Speculatively processs it here. */
 
-    /* Speculative pack operations */
-    fd_txn_p_t * slot          = fd_pack_insert_txn_init( pack );
-
     ulong         sz           = (ulong)mline->sz;
     uchar const * dcache_entry = fd_chunk_to_laddr_const( wksp, mline->chunk );
     ulong         mline_sig    = mline->sig;
+    if( FD_LIKELY( lat ) ) fd_lat_sample( lat, now, (ulong)mline->tsorig, (ulong)mline->tspub );
+    int traced = fd_trace_sampled( trace, mline_sig );
+    if( FD_UNLIKELY( traced ) ) fd_trace_record( trace, mline_sig, 0UL, seq, FD_TRACE_EVENT_RX, now );
     /* Assume that the dcache entry is:
          Payload ....... (payload_sz bytes)
          0 or 1 byte of padding (since alignof(fd_txn) is 2)
@@ -310,9 +560,29 @@ run( fd_frank_args_t * args ) {
     ulong payload_sz = *(ushort*)(dcache_entry + sz - sizeof(ushort));
     uchar    const * payload = dcache_entry;
     fd_txn_t const * txn     = (fd_txn_t const *)( dcache_entry + fd_ulong_align_up( payload_sz, 2UL ) );
+
+    /* Speculative pack operations.  When sharded, the transaction is
+       only ours if it uses just our accounts, or, for shard 0, if it's
+       cross-shard. */
+    fd_pack_t * dst = pack;
+    if( FD_UNLIKELY( shard_ctl ) ) {
+      ulong shard = fd_pack_shard_route( (fd_txn_t *)txn /* acct iter wants non-const */, payload, alt_cache, shard_cnt );
+      dst = fd_ptr_if( shard==shard_idx, pack, fd_ptr_if( shard==FD_PACK_SHARD_CROSS, coord, NULL ) );
+    }
+    if( FD_UNLIKELY( !dst ) ) {
+      if( FD_UNLIKELY( traced ) ) fd_trace_record( trace, mline_sig, 0UL, seq, FD_TRACE_EVENT_FILT, now ); /* Another shard's */
+      accum_pub_cnt++;
+      accum_pub_sz += sz;
+      seq   = fd_seq_inc( seq, 1UL );
+      mline = mcache + fd_mcache_line_idx( seq, depth );
+      continue;
+    }
+
+    fd_txn_p_t * slot = fd_pack_insert_txn_init( dst );
     fd_memcpy( slot->payload, payload, payload_sz                                                     );
     fd_memcpy( TXN(slot),     txn,     fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
-    slot->meta = mline_sig;
+    slot->payload_sz = payload_sz;
+    slot->meta       = mline_sig;
 
 #if DETAILED_LOGGING
     FD_LOG_NOTICE(( "Pack got a packet. Payload size: %lu, txn footprint: %lu", payload_sz,
@@ -323,7 +593,7 @@ run( fd_frank_args_t * args ) {
     /* Check that we weren't overrun while processing */
     seq_found = fd_frag_meta_seq_query( mline );
     if( FD_UNLIKELY( fd_seq_ne( seq_found, seq ) ) ) {
-      fd_pack_insert_txn_cancel( pack, slot );
+      fd_pack_insert_txn_cancel( dst, slot );
       accum_ovrnr_cnt++;
       seq = seq_found;
       continue;
@@ -333,7 +603,8 @@ run( fd_frank_args_t * args ) {
     accum_pub_cnt++;
     accum_pub_sz += sz;
 
-    fd_pack_insert_txn_fini( pack, slot );
+    fd_pack_insert_txn_fini( dst, slot, block_cnt + MAX_TXN_AGE_BLOCKS );
+    if( FD_UNLIKELY( traced ) ) fd_trace_record( trace, mline_sig, 0UL, seq, FD_TRACE_EVENT_DONE, fd_tickcount() );
 
     /* Wind up for the next iteration */
     seq   = fd_seq_inc( seq, 1UL );
@@ -56,6 +56,8 @@ run( fd_frank_args_t * args ) {
   uchar * dcache = fd_dcache_join( fd_wksp_pod_map( args->extra_pod, path ) );
   if( FD_UNLIKELY( !dcache ) ) FD_LOG_ERR(( "fd_dcache_join failed" ));
 
+  fd_trace_t * trace = fd_frank_trace_join( args );
+
   FD_LOG_INFO(( "loading quic" ));
   fd_quic_t * quic = fd_quic_join( fd_wksp_pod_map( args->tile_pod, "quic" ) );
   if( FD_UNLIKELY( !quic ) ) FD_LOG_ERR(( "fd_quic_join failed" ));
@@ -126,7 +128,7 @@ run( fd_frank_args_t * args ) {
   /* Start serving */
 
   FD_LOG_INFO(( "%s(%lu) run", args->tile_name, args->tile_idx ));
-  int err = fd_quic_tile( cnc, quic, xsk_aio, mcache, dcache, lazy, rng, scratch, args->tick_per_ns );
+  int err = fd_quic_tile( cnc, quic, xsk_aio, mcache, dcache, trace, lazy, rng, scratch, args->tick_per_ns );
   if( FD_UNLIKELY( err ) ) FD_LOG_ERR(( "fd_quic_tile failed (%i)", err ));
 }
 
@@ -137,6 +139,7 @@ static long allow_syscalls[] = {
   __NR_getrandom, /* OpenSSL RAND_bytes reads getrandom, temporarily used as part of quic_init to generate a certificate */
   __NR_madvise,   /* OpenSSL SSL_do_handshake () uses an arena which eventually calls _rjem_je_pages_purge_forced */
   __NR_sendto,    /* fd_xsk requires sendto */
+  __NR_recvfrom,  /* fd_xsk requires recvfrom to wake up (or busy poll) rx */
 };
 
 static ulong
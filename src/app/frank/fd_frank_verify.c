@@ -20,6 +20,11 @@ run( fd_frank_args_t * args ) {
   ulong * cnc_diag = (ulong *)fd_cnc_app_laddr( cnc );
   cnc_diag[ FD_FRANK_CNC_DIAG_PID ] = (ulong)args->pid;
 
+  /* Latency histograms for the quic link (NULL if no room) */
+  uint * lat = fd_lat_cnc_laddr( cnc, 1UL );
+
+  fd_trace_t * trace = fd_frank_trace_join( args );
+
   /* In IPC objects */
   FD_LOG_INFO(( "joining mcache%lu", args->tile_idx ));
   char path[ 32 ];
@@ -118,10 +123,12 @@ run( fd_frank_args_t * args ) {
   ulong cr_max    = fd_pod_query_ulong( args->tile_pod, "cr_max",    0UL );
   ulong cr_resume = fd_pod_query_ulong( args->tile_pod, "cr_resume", 0UL );
   ulong cr_refill = fd_pod_query_ulong( args->tile_pod, "cr_refill", 0UL );
+  int   cr_adapt  = fd_pod_query_int  ( args->tile_pod, "cr_adapt",  0   );
   long  lazy      = fd_pod_query_long ( args->tile_pod, "lazy",      0L  );
   FD_LOG_INFO(( "cr_max    %lu", cr_max    ));
   FD_LOG_INFO(( "cr_resume %lu", cr_resume ));
   FD_LOG_INFO(( "cr_refill %lu", cr_refill ));
+  FD_LOG_INFO(( "cr_adapt  %i",  cr_adapt  ));
   FD_LOG_INFO(( "lazy      %li", lazy      ));
 
   fd_fctl_t * fctl = fd_fctl_cfg_done( fd_fctl_cfg_rx_add( fd_fctl_join( fd_fctl_new( fd_alloca( FD_FCTL_ALIGN,
@@ -130,8 +137,10 @@ run( fd_frank_args_t * args ) {
                                                            depth, fseq, &fseq_diag[ FD_FSEQ_DIAG_SLOW_CNT ] ),
                                        1UL /*cr_burst*/, cr_max, cr_resume, cr_refill );
   if( FD_UNLIKELY( !fctl ) ) FD_LOG_ERR(( "Unable to create flow control" ));
-  FD_LOG_INFO(( "using cr_burst %lu, cr_max %lu, cr_resume %lu, cr_refill %lu",
-                fd_fctl_cr_burst( fctl ), fd_fctl_cr_max( fctl ), fd_fctl_cr_resume( fctl ), fd_fctl_cr_refill( fctl ) ));
+  if( cr_adapt && FD_UNLIKELY( !fd_fctl_cfg_adapt( fctl ) ) ) FD_LOG_ERR(( "Unable to enable adaptive flow control" ));
+  FD_LOG_INFO(( "using cr_burst %lu, cr_max %lu, cr_resume %lu, cr_refill %lu, cr_adapt %i",
+                fd_fctl_cr_burst( fctl ), fd_fctl_cr_max( fctl ), fd_fctl_cr_resume( fctl ), fd_fctl_cr_refill( fctl ),
+                fd_fctl_adapt( fctl ) ));
 
   ulong cr_avail = 0UL;
 
@@ -153,6 +162,7 @@ run( fd_frank_args_t * args ) {
   fd_tcache_t * tcache  = fd_tcache_join( fd_tcache_new( tcache_mem, TCACHE_DEPTH, TCACHE_MAP_CNT ) );
   ulong   tcache_depth   = fd_tcache_depth       ( tcache );
   ulong   tcache_map_cnt = fd_tcache_map_cnt     ( tcache );
+  if( FD_UNLIKELY( FD_TCACHE_USE_BKT && tcache_map_cnt<FD_TCACHE_BKT_SLOT_CNT ) ) FD_LOG_ERR(( "tcache map_cnt too small" ));
   ulong * _tcache_sync   = fd_tcache_oldest_laddr( tcache );
   ulong * _tcache_ring   = fd_tcache_ring_laddr  ( tcache );
   ulong * _tcache_map    = fd_tcache_map_laddr   ( tcache );
@@ -280,7 +290,9 @@ run( fd_frank_args_t * args ) {
       continue;
     }
 
-    uint chunk = vin_mline->chunk;
+    uint  chunk      = vin_mline->chunk;
+    ulong vin_tsorig = (ulong)vin_mline->tsorig;
+    if( FD_LIKELY( lat ) ) fd_lat_sample( lat, now, vin_tsorig, (ulong)vin_mline->tspub );
 
     ulong vin_data_sz    = (ulong)vin_mline->sz;
     uchar * udp_payload = (uchar *)fd_chunk_to_laddr( vin_wksp, chunk );
@@ -315,12 +327,21 @@ run( fd_frank_args_t * args ) {
         time being. */
 
     ulong ha_tag = *sig;
+
+    int traced = fd_trace_sampled( trace, ha_tag );
+    if( FD_UNLIKELY( traced ) ) fd_trace_record( trace, ha_tag, 0UL, vin_seq_found, FD_TRACE_EVENT_RX, now );
+
     int ha_dup;
-    FD_TCACHE_INSERT( ha_dup, tcache_oldest, _tcache_ring, tcache_depth, _tcache_map, tcache_map_cnt, ha_tag );
+#   if FD_TCACHE_USE_BKT
+    FD_TCACHE_BKT_INSERT( ha_dup, tcache_oldest, _tcache_ring, tcache_depth, _tcache_map, tcache_map_cnt, ha_tag );
+#   else
+    FD_TCACHE_INSERT    ( ha_dup, tcache_oldest, _tcache_ring, tcache_depth, _tcache_map, tcache_map_cnt, ha_tag );
+#   endif
     if( FD_UNLIKELY( ha_dup ) ) { /* optimize for the non dup case */
       accum_ha_filt_cnt++;
       accum_ha_filt_sz += payload_sz; //WW accum_ha_filt_sz += msg_framing + msg_sz;
       now = fd_tickcount();
+      if( FD_UNLIKELY( traced ) ) fd_trace_record( trace, ha_tag, 0UL, vin_seq_found, FD_TRACE_EVENT_FILT, now );
       continue;
     }
 
@@ -338,6 +359,7 @@ run( fd_frank_args_t * args ) {
       //FD_LOG_WARNING(( "fd_ed25519_verify failed for mcache[%lu], fail/pass: %lu/%lu",
       //  vin_seq_found, sigvfy_fail_cnt, sigvfy_pass_cnt ));
       now = fd_tickcount();
+      if( FD_UNLIKELY( traced ) ) fd_trace_record( trace, ha_tag, 0UL, vin_seq_found, FD_TRACE_EVENT_FILT, now );
       continue;
     }
     else {
@@ -366,9 +388,14 @@ run( fd_frank_args_t * args ) {
     int   ctl_som  = 1;
     int   ctl_eom  = 1;
     ulong   ctl    = fd_frag_meta_ctl( 0, ctl_som, ctl_eom, 0 );
-    ulong   tsorig = tspub;
+    ulong   tsorig = vin_tsorig; /* preserve the time the quic tile received the transaction */
     fd_mcache_publish( mcache, depth, seq, ha_tag, chunk, vin_data_sz, ctl, tsorig, tspub );
 
+    if( FD_UNLIKELY( traced ) ) {
+      fd_trace_record( trace, ha_tag, 0UL, vin_seq_found, FD_TRACE_EVENT_DONE, now );
+      fd_trace_record( trace, ha_tag, 0UL, seq,           FD_TRACE_EVENT_PUB,  now );
+    }
+
     seq   = fd_seq_inc( seq, 1UL );
     cr_avail--;
 
@@ -4,23 +4,25 @@
 
 FD_IMPORT_BINARY( test_prog, "src/tango/xdp/fd_xdp_redirect_prog.o" );
 
-static uchar prog_buf[ 2048UL ];
+static uchar prog_buf[ 4096UL ];
 
 int main( int     argc,
           char ** argv ) {
   fd_boot( &argc, &argv );
 
-  FD_TEST( test_prog_sz<=2048UL );
+  FD_TEST( test_prog_sz<=4096UL );
   fd_memcpy( prog_buf, test_prog, test_prog_sz );
 
-  fd_ebpf_sym_t syms[ 2 ] = {
-    { .name = "fd_xdp_udp_dsts", .value = 0x41424344 },
-    { .name = "fd_xdp_xsks",     .value = 0x45464748 }
+  fd_ebpf_sym_t syms[ 4 ] = {
+    { .name = "fd_xdp_udp_dsts",    .value = 0x41424344 },
+    { .name = "fd_xdp_xsks",        .value = 0x45464748 },
+    { .name = "fd_xdp_rate_limits", .value = 0x494a4b4c },
+    { .name = "fd_xdp_rate_cfg",    .value = 0x4d4e4f50 }
   };
   fd_ebpf_link_opts_t opts = {
     .section = "xdp",
     .sym     = syms,
-    .sym_cnt = 2UL
+    .sym_cnt = 4UL
   };
 
   fd_ebpf_link_opts_t * res =
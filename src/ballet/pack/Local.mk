@@ -1,10 +1,20 @@
 ifdef FD_HAS_DOUBLE
-$(call add-hdrs,fd_pack.h fd_est_tbl.h fd_compute_budget_program.h)
+$(call add-hdrs,fd_pack.h fd_est_tbl.h fd_est_ftbl.h fd_alt_cache.h fd_balance_tbl.h fd_fee_stats.h fd_pack_shard.h fd_compute_budget_program.h)
 $(call add-objs,fd_pack,fd_ballet)
 $(call make-unit-test,test_compute_budget_program,test_compute_budget_program,fd_ballet fd_util)
 $(call make-unit-test,test_est_tbl,test_est_tbl,fd_ballet fd_util)
+$(call make-unit-test,test_est_ftbl,test_est_ftbl,fd_ballet fd_util)
+$(call make-unit-test,test_balance_tbl,test_balance_tbl,fd_ballet fd_util)
 $(call make-unit-test,test_pack,test_pack,fd_disco fd_ballet fd_util)
+$(call make-unit-test,bench_pack,bench_pack,fd_ballet fd_util)
+$(call make-unit-test,bench_pack_conflict,bench_pack_conflict,fd_ballet fd_util)
+$(call make-unit-test,bench_pack_shard,bench_pack_shard,fd_ballet fd_util)
 $(call run-unit-test,test_compute_budget_program,)
 $(call run-unit-test,test_est_tbl,)
+$(call run-unit-test,test_est_ftbl,)
+$(call run-unit-test,test_balance_tbl,)
 $(call run-unit-test,test_pack,)
+ifdef FD_HAS_HOSTED
+$(call make-bin,fd_pack_backtest,fd_pack_backtest,fd_ballet fd_util)
+endif
 endif
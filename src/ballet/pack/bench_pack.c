@@ -0,0 +1,357 @@
+#include "../fd_ballet.h"
+#include "fd_pack.h"
+#include "fd_compute_budget_program.h"
+#include "../txn/fd_txn.h"
+#include <math.h>
+
+/* bench_pack measures end-to-end scheduling throughput of pack on a
+   synthetic but realistically shaped transaction population.  It drives
+   the same loop as the pack tile (complete, insert, schedule, and
+   end_block at the end of each block) as fast as possible and reports:
+
+     - scheduled transactions per second of scheduling time,
+     - insert cost per transaction and scheduling cost per candidate,
+     - how full each block got in CUs, and
+     - how many transactions were pending at the end of each block.
+
+   Transactions are serialized in the wire format and go through
+   fd_txn_parse just like transactions arriving from the network.  The
+   population is controlled by:
+
+     --acct-cnt, --zipf-s  Written and read accounts are drawn from
+                           acct-cnt accounts with Zipf(s) popularity, so
+                           higher s means more contention.
+     --vote-frac           Fraction of simple vote transactions.  Votes
+                           from the same one of --validator-cnt
+                           validators write the same vote account.
+     --cu-min, --cu-max    Requested CUs are log-uniform in this range.
+     --alt-frac            Fraction of non-vote transactions that are v0
+                           transactions loading accounts through an
+                           address lookup table.
+     --alt-cache           If non-zero, pack resolves the lookup tables
+                           through an ALT cache, so the loaded accounts
+                           count for conflicts.  Each table holds
+                           accounts of its own that no transaction lists
+                           directly.
+
+   With --fee-stats non-zero, pack also keeps the local fee market
+   statistics, which are published at the end of each block, outside
+   the timed sections, so the insert and scheduling costs include
+   keeping them up to date.  Runs are deterministic given --seed. */
+
+FD_IMPORT_BINARY( sample_vote, "src/ballet/pack/sample_vote.bin" );
+
+#define WRITE_CNT (2UL)
+#define READ_CNT  (2UL)
+#define ALT_CNT   (16UL) /* Number of distinct lookup tables */
+#define ALT_CACHE_ENTRY_CNT (1024UL)
+
+#define PACK_SCRATCH_SZ (512UL*1024UL*1024UL)
+uchar pack_scratch[ PACK_SCRATCH_SZ ] __attribute__((aligned(128)));
+uchar fee_stats_scratch[ FD_FEE_STATS_FOOTPRINT ] __attribute__((aligned(FD_FEE_STATS_ALIGN)));
+
+#define MAX_TXN_PER_MICRO (31UL)
+uchar microblock[ MAX_TXN_PER_MICRO*FD_PACK_MICROBLOCK_TXN_MAX_SZ ] __attribute__((aligned(FD_PACK_MICROBLOCK_TXN_ALIGN)));
+
+static const uchar work_program_id[ FD_TXN_ACCT_ADDR_SZ ] = "Bench Program Id Does Some Work.";
+
+struct bench_cfg {
+  ulong    acct_cnt;
+  double * zipf_cdf;      /* zipf_cdf[i] = P(account <= i) */
+  double   vote_frac;
+  ulong    validator_cnt;
+  double   alt_frac;
+  double   log_cu_min;
+  double   log_cu_max;
+};
+typedef struct bench_cfg bench_cfg_t;
+
+static ulong
+zipf_sample( bench_cfg_t const * cfg,
+             fd_rng_t          * rng ) {
+  double u  = fd_rng_double_o( rng );
+  ulong  lo = 0UL;
+  ulong  hi = cfg->acct_cnt-1UL;
+  while( lo<hi ) {
+    ulong mid = (lo+hi)/2UL;
+    if( cfg->zipf_cdf[ mid ]<u ) lo = mid+1UL;
+    else                         hi = mid;
+  }
+  return lo;
+}
+
+/* write_vote serializes a simple vote from validator into payload, with
+   a unique signature derived from sig. */
+static ulong
+write_vote( uchar * payload,
+            ulong   sig,
+            ulong   validator ) {
+  fd_memcpy( payload, sample_vote, sample_vote_sz );
+  FD_STORE( ulong, payload+0x01UL, sig       ); /* signature */
+  FD_STORE( ulong, payload+0x45UL, validator ); /* authorized voter */
+  FD_STORE( ulong, payload+0x65UL, validator ); /* vote account */
+  return sample_vote_sz;
+}
+
+/* write_txn serializes a transaction with a unique signature and fee
+   payer derived from sig that writes the accounts identified by w,
+   reads those identified by r, requests cus CUs at a price of
+   micro_lamports per CU, and, if alt is not ULONG_MAX, loads one
+   writable and one readonly account from lookup table alt. */
+static ulong
+write_txn( uchar       * payload,
+           ulong         sig,
+           ulong const * w,
+           ulong const * r,
+           uint          cus,
+           ulong         micro_lamports,
+           ulong         alt ) {
+  uchar * p = payload;
+
+  *(p++) = (uchar)1;
+  memset( p, 0, FD_TXN_SIGNATURE_SZ ); FD_STORE( ulong, p, sig ); p += FD_TXN_SIGNATURE_SZ;
+
+  if( alt!=ULONG_MAX ) *(p++) = (uchar)0x80; /* v0 */
+  *(p++) = (uchar)1;                             /* signatures */
+  *(p++) = (uchar)0;                             /* readonly signed */
+  *(p++) = (uchar)(READ_CNT+2UL);                /* readonly unsigned */
+  *(p++) = (uchar)(1UL+WRITE_CNT+READ_CNT+2UL);  /* account count */
+
+  /* Fee payer, writable accounts, readonly accounts, then programs.
+     The prefixes keep the classes of addresses from colliding. */
+  memset( p, 'S', FD_TXN_ACCT_ADDR_SZ ); FD_STORE( ulong, p, sig );      p += FD_TXN_ACCT_ADDR_SZ;
+  for( ulong i=0UL; i<WRITE_CNT; i++ ) {
+    memset( p, 'A', FD_TXN_ACCT_ADDR_SZ ); FD_STORE( ulong, p, w[ i ] ); p += FD_TXN_ACCT_ADDR_SZ;
+  }
+  for( ulong i=0UL; i<READ_CNT; i++ ) {
+    memset( p, 'A', FD_TXN_ACCT_ADDR_SZ ); FD_STORE( ulong, p, r[ i ] ); p += FD_TXN_ACCT_ADDR_SZ;
+  }
+  ulong cbp_idx  = 1UL+WRITE_CNT+READ_CNT;
+  fd_memcpy( p, FD_COMPUTE_BUDGET_PROGRAM_ID, FD_TXN_ACCT_ADDR_SZ );     p += FD_TXN_ACCT_ADDR_SZ;
+  fd_memcpy( p, work_program_id,              FD_TXN_ACCT_ADDR_SZ );     p += FD_TXN_ACCT_ADDR_SZ;
+
+  memset( p, 'B', FD_TXN_ACCT_ADDR_SZ );                                 p += FD_TXN_ACCT_ADDR_SZ; /* recent blockhash */
+
+  *(p++) = (uchar)3; /* instructions */
+
+  /* SetComputeUnitLimit( cus ) */
+  *(p++) = (uchar)cbp_idx; *(p++) = (uchar)0; *(p++) = (uchar)5;
+  *(p++) = (uchar)2; FD_STORE( uint, p, cus );             p += sizeof(uint);
+
+  /* SetComputeUnitPrice( micro_lamports ) */
+  *(p++) = (uchar)cbp_idx; *(p++) = (uchar)0; *(p++) = (uchar)9;
+  *(p++) = (uchar)3; FD_STORE( ulong, p, micro_lamports ); p += sizeof(ulong);
+
+  /* The work instruction references every non-program account */
+  ulong ref_cnt = WRITE_CNT+READ_CNT+fd_ulong_if( alt!=ULONG_MAX, 2UL, 0UL );
+  *(p++) = (uchar)(cbp_idx+1UL); *(p++) = (uchar)ref_cnt;
+  for( ulong i=0UL; i<WRITE_CNT+READ_CNT; i++ ) *(p++) = (uchar)(1UL+i);
+  /* Loaded accounts are indexed after the static ones, writable first */
+  if( alt!=ULONG_MAX ) { *(p++) = (uchar)(cbp_idx+2UL); *(p++) = (uchar)(cbp_idx+3UL); }
+  *(p++) = (uchar)1; *(p++) = (uchar)0;
+
+  if( alt!=ULONG_MAX ) {
+    *(p++) = (uchar)1; /* lookup tables */
+    memset( p, 'T', FD_TXN_ACCT_ADDR_SZ ); FD_STORE( ulong, p, alt ); p += FD_TXN_ACCT_ADDR_SZ;
+    *(p++) = (uchar)1; *(p++) = (uchar)(sig & 0x7FUL);        /* writable */
+    *(p++) = (uchar)1; *(p++) = (uchar)(0x80UL | (sig & 0x7FUL)); /* readonly */
+  }
+
+  return (ulong)(p - payload);
+}
+
+/* insert_one draws a transaction from the population described by cfg
+   and inserts it into pack. */
+static void
+insert_one( fd_pack_t         * pack,
+            bench_cfg_t const * cfg,
+            fd_rng_t          * rng,
+            ulong             * next_sig,
+            ulong               expires_at ) {
+  fd_txn_p_t * slot = fd_pack_insert_txn_init( pack );
+  ulong sig = (*next_sig)++;
+
+  if( fd_rng_double_o( rng )<cfg->vote_frac ) {
+    slot->payload_sz = write_vote( slot->payload, sig, fd_rng_ulong_roll( rng, cfg->validator_cnt ) );
+  } else {
+    /* Draw distinct accounts so the transaction is well-formed */
+    ulong picked[ WRITE_CNT+READ_CNT ];
+    for( ulong i=0UL; i<WRITE_CNT+READ_CNT; i++ ) {
+      int dup;
+      do {
+        picked[ i ] = zipf_sample( cfg, rng );
+        dup = 0;
+        for( ulong j=0UL; j<i; j++ ) dup |= picked[ j ]==picked[ i ];
+      } while( dup );
+    }
+    uint  cus            = (uint)exp( cfg->log_cu_min + (cfg->log_cu_max-cfg->log_cu_min)*fd_rng_double_c( rng ) );
+    ulong micro_lamports = (ulong)( 10000.0*fd_rng_double_exp( rng ) );
+    ulong alt            = fd_ulong_if( fd_rng_double_o( rng )<cfg->alt_frac, fd_rng_ulong_roll( rng, ALT_CNT ), ULONG_MAX );
+    slot->payload_sz = write_txn( slot->payload, sig, picked, picked+WRITE_CNT, cus, micro_lamports, alt );
+  }
+
+  if( FD_UNLIKELY( !fd_txn_parse( slot->payload, slot->payload_sz, TXN(slot), NULL ) ) ) FD_LOG_ERR(( "generated transaction failed to parse" ));
+  fd_pack_insert_txn_fini( pack, slot, expires_at );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong  pack_depth      = fd_env_strip_cmdline_ulong ( &argc, &argv, "--pack-depth",            NULL,    4096UL  );
+  ulong  bank_cnt        = fd_env_strip_cmdline_ulong ( &argc, &argv, "--bank-cnt",              NULL,       4UL  );
+  ulong  block_cnt       = fd_env_strip_cmdline_ulong ( &argc, &argv, "--block-cnt",             NULL,     100UL  );
+  ulong  mb_per_block    = fd_env_strip_cmdline_ulong ( &argc, &argv, "--microblocks-per-block", NULL,     128UL  );
+  ulong  arrival_per_mb  = fd_env_strip_cmdline_ulong ( &argc, &argv, "--arrival-per-mb",        NULL,      31UL  );
+  ulong  cus_per_mb      = fd_env_strip_cmdline_ulong ( &argc, &argv, "--cus-per-mb",            NULL, 1500000UL  );
+  float  sched_vote_frac = fd_env_strip_cmdline_float ( &argc, &argv, "--sched-vote-frac",       NULL,    0.75f   );
+  ulong  acct_cnt        = fd_env_strip_cmdline_ulong ( &argc, &argv, "--acct-cnt",              NULL,  100000UL  );
+  double zipf_s          = fd_env_strip_cmdline_double( &argc, &argv, "--zipf-s",                NULL,     1.0    );
+  double vote_frac       = fd_env_strip_cmdline_double( &argc, &argv, "--vote-frac",             NULL,     0.5    );
+  ulong  validator_cnt   = fd_env_strip_cmdline_ulong ( &argc, &argv, "--validator-cnt",         NULL,    2000UL  );
+  double alt_frac        = fd_env_strip_cmdline_double( &argc, &argv, "--alt-frac",              NULL,     0.2    );
+  int    use_alt_cache   = fd_env_strip_cmdline_int   ( &argc, &argv, "--alt-cache",             NULL,       1    );
+  int    use_fee_stats   = fd_env_strip_cmdline_int   ( &argc, &argv, "--fee-stats",             NULL,       0    );
+  ulong  cu_min          = fd_env_strip_cmdline_ulong ( &argc, &argv, "--cu-min",                NULL,    1000UL  );
+  ulong  cu_max          = fd_env_strip_cmdline_ulong ( &argc, &argv, "--cu-max",                NULL,  400000UL  );
+  ulong  report_interval = fd_env_strip_cmdline_ulong ( &argc, &argv, "--report-interval",       NULL,      10UL  );
+  uint   seed            = fd_env_strip_cmdline_uint  ( &argc, &argv, "--seed",                  NULL,       0U   );
+
+  if( FD_UNLIKELY( acct_cnt<WRITE_CNT+READ_CNT             ) ) FD_LOG_ERR(( "--acct-cnt too small" ));
+  if( FD_UNLIKELY( !validator_cnt                          ) ) FD_LOG_ERR(( "--validator-cnt must be positive" ));
+  if( FD_UNLIKELY( !cu_min || cu_min>cu_max || cu_max>FD_COMPUTE_BUDGET_MAX_CU_LIMIT ) )
+    FD_LOG_ERR(( "need 0<--cu-min<=--cu-max<=%lu", FD_COMPUTE_BUDGET_MAX_CU_LIMIT ));
+  if( FD_UNLIKELY( !bank_cnt || !mb_per_block || !report_interval ) ) FD_LOG_ERR(( "counts must be positive" ));
+
+  fd_rng_t _rng[1];
+  fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, seed, 0UL ) );
+
+  bench_cfg_t cfg[1];
+  cfg->acct_cnt      = acct_cnt;
+  cfg->vote_frac     = vote_frac;
+  cfg->validator_cnt = validator_cnt;
+  cfg->alt_frac      = alt_frac;
+  cfg->log_cu_min    = log( (double)cu_min );
+  cfg->log_cu_max    = log( (double)cu_max );
+
+  /* Precompute the Zipf CDF.  Store it at the end of the scratch region
+     after the pack object. */
+  ulong footprint = fd_pack_footprint( pack_depth, bank_cnt, MAX_TXN_PER_MICRO );
+  ulong cdf_off   = fd_ulong_align_up( footprint, alignof(double) );
+  if( FD_UNLIKELY( !footprint || cdf_off+acct_cnt*sizeof(double)>PACK_SCRATCH_SZ ) )
+    FD_LOG_ERR(( "bench required %lu bytes, but scratch was only %lu", cdf_off+acct_cnt*sizeof(double), PACK_SCRATCH_SZ ));
+  ulong alt_cache_off = fd_ulong_align_up( cdf_off+acct_cnt*sizeof(double), fd_alt_cache_align() );
+  if( FD_UNLIKELY( alt_cache_off+fd_alt_cache_footprint( ALT_CACHE_ENTRY_CNT )>PACK_SCRATCH_SZ ) )
+    FD_LOG_ERR(( "bench required %lu bytes, but scratch was only %lu", alt_cache_off+fd_alt_cache_footprint( ALT_CACHE_ENTRY_CNT ), PACK_SCRATCH_SZ ));
+  cfg->zipf_cdf = (double *)(pack_scratch + cdf_off);
+  double sum = 0.0;
+  for( ulong i=0UL; i<acct_cnt; i++ ) { sum += pow( (double)(i+1UL), -zipf_s ); cfg->zipf_cdf[ i ] = sum; }
+  for( ulong i=0UL; i<acct_cnt; i++ ) cfg->zipf_cdf[ i ] /= sum;
+
+  FD_LOG_NOTICE(( "Conflict detection: %s. pack_depth=%lu bank_cnt=%lu acct_cnt=%lu zipf_s=%.2f vote_frac=%.2f alt_frac=%.2f alt_cache=%i fee_stats=%i cus=[%lu,%lu]",
+                  FD_PACK_USE_BITSET ? "bitset" : "map", pack_depth, bank_cnt, acct_cnt, zipf_s, vote_frac, alt_frac, use_alt_cache, use_fee_stats, cu_min, cu_max ));
+
+  fd_pack_t * pack = fd_pack_join( fd_pack_new( pack_scratch, pack_depth, bank_cnt, MAX_TXN_PER_MICRO, rng ) );
+  fd_pack_metrics_t const * metrics = fd_pack_metrics( pack );
+
+  fd_alt_cache_t * alt_cache = NULL;
+  if( use_alt_cache ) {
+    alt_cache = fd_alt_cache_join( fd_alt_cache_new( pack_scratch+alt_cache_off, ALT_CACHE_ENTRY_CNT ) );
+    /* Entry k of table t is account acct_cnt+t*FD_ALT_CACHE_ADDR_MAX+k */
+    fd_acct_addr_t contents[ FD_ALT_CACHE_ADDR_MAX ];
+    for( ulong t=0UL; t<ALT_CNT; t++ ) {
+      fd_acct_addr_t table[1];
+      memset( table->b, 'T', FD_TXN_ACCT_ADDR_SZ ); FD_STORE( ulong, table->b, t );
+      for( ulong k=0UL; k<FD_ALT_CACHE_ADDR_MAX; k++ ) {
+        memset( contents[ k ].b, 'A', FD_TXN_ACCT_ADDR_SZ ); FD_STORE( ulong, contents[ k ].b, acct_cnt+t*FD_ALT_CACHE_ADDR_MAX+k );
+      }
+      fd_alt_cache_insert( alt_cache, table, contents, FD_ALT_CACHE_ADDR_MAX );
+    }
+    fd_pack_set_alt_cache( pack, alt_cache );
+  }
+
+  fd_fee_stats_t * fee_stats = NULL;
+  if( use_fee_stats ) {
+    fee_stats = fd_fee_stats_join( fd_fee_stats_new( fee_stats_scratch ) );
+    fd_pack_set_fee_stats( pack, fee_stats );
+  }
+
+  /* Transactions expire after the same number of blocks as in the pack
+     tile, so a contended population doesn't just fill the pool with
+     transactions that can never be scheduled. */
+  ulong const max_age = 150UL;
+
+  ulong next_sig = 0UL;
+  while( fd_pack_avail_txn_cnt( pack )<pack_depth ) insert_one( pack, cfg, rng, &next_sig, max_age );
+
+  ulong txns0       = metrics->txns_scheduled;
+  ulong candidates0 = metrics->candidates_evaluated;
+
+  long   insert_ns   = 0L;
+  long   schedule_ns = 0L;
+  ulong  insert_cnt  = 0UL;
+  double fill_sum    = 0.0;
+  double fill_min    = 1.0;
+  ulong  occ_min     = ULONG_MAX;
+  ulong  occ_max     = 0UL;
+  ulong  occ_sum     = 0UL;
+
+  for( ulong block=0UL; block<block_cnt; block++ ) {
+    ulong block_cus0 = metrics->cus_scheduled;
+    for( ulong mb=0UL; mb<mb_per_block; mb++ ) {
+      ulong bank_tile = mb % bank_cnt;
+      fd_pack_microblock_complete( pack, bank_tile );
+
+      long start = fd_log_wallclock();
+      for( ulong j=0UL; j<arrival_per_mb; j++ ) insert_one( pack, cfg, rng, &next_sig, block+max_age );
+      long mid = fd_log_wallclock();
+      ulong microblock_sz;
+      fd_pack_schedule_next_microblock( pack, cus_per_mb, sched_vote_frac, bank_tile, microblock, sizeof(microblock), &microblock_sz );
+      long end = fd_log_wallclock();
+
+      insert_ns   += mid - start;
+      schedule_ns += end - mid;
+      insert_cnt  += arrival_per_mb;
+    }
+    for( ulong i=0UL; i<bank_cnt; i++ ) fd_pack_microblock_complete( pack, i );
+    fd_pack_end_block( pack );
+    fd_pack_expire_before( pack, block+1UL );
+    fd_pack_publish_fee_stats( pack );
+
+    double fill = (double)(metrics->cus_scheduled - block_cus0)/(double)FD_PACK_MAX_COST_PER_BLOCK;
+    ulong  occ  = fd_pack_avail_txn_cnt( pack );
+    fill_sum += fill;
+    fill_min  = fd_double_if( fill<fill_min, fill, fill_min );
+    occ_sum  += occ;
+    occ_min   = fd_ulong_min( occ_min, occ );
+    occ_max   = fd_ulong_max( occ_max, occ );
+
+    if( FD_UNLIKELY( (block%report_interval)==report_interval-1UL ) ) {
+      FD_LOG_NOTICE(( "block %5lu: fill %5.1f%%, pending %5lu, evicted %lu, expired %lu, votes replaced %lu",
+                      block, 100.0*fill, occ, metrics->evicted_cnt, metrics->expired_cnt, metrics->vote_replaced_cnt ));
+    }
+  }
+
+  ulong  txns       = metrics->txns_scheduled       - txns0;
+  ulong  candidates = metrics->candidates_evaluated - candidates0;
+  double blocks     = (double)fd_ulong_max( block_cnt, 1UL );
+
+  FD_LOG_NOTICE(( "scheduled %lu txns in %lu blocks: %.3e txns/s, %.3f ns/candidate (%lu candidates), %.3f ns/insert",
+                  txns, block_cnt, 1e9*(double)txns/(double)fd_long_max( schedule_ns, 1L ),
+                  (double)schedule_ns/(double)fd_ulong_max( candidates, 1UL ), candidates,
+                  (double)insert_ns/(double)fd_ulong_max( insert_cnt, 1UL ) ));
+  FD_LOG_NOTICE(( "block fill: mean %.1f%%, min %.1f%%. pending at end of block: min %lu, mean %.0f, max %lu",
+                  100.0*fill_sum/blocks, 100.0*fill_min, occ_min, (double)occ_sum/blocks, occ_max ));
+
+  if( alt_cache ) FD_LOG_NOTICE(( "%lu inserted transactions had unresolved lookup tables", metrics->alt_unresolved_cnt ));
+
+  if( alt_cache ) fd_alt_cache_delete( fd_alt_cache_leave( alt_cache ) );
+  if( fee_stats ) fd_fee_stats_delete( fd_fee_stats_leave( fee_stats ) );
+  fd_pack_delete( fd_pack_leave( pack ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -0,0 +1,206 @@
+#include "../fd_ballet.h"
+#include "fd_pack.h"
+#include "fd_compute_budget_program.h"
+
+/* bench_pack_conflict measures how quickly pack evaluates candidate
+   transactions for account conflicts.  It keeps a pack object full of
+   synthetic transactions and repeatedly schedules microblocks for a set
+   of bank tiles, completing each bank tile's microblock right before
+   scheduling the next one for it.  Two transaction mixes are run:
+
+     uncontended: every transaction writes accounts no other transaction
+                  uses and reads from a large set of shared accounts.
+     contended:   every transaction writes and reads accounts from a
+                  small set of hot accounts.
+
+   The conflict detection engine is picked at compile time.  To compare
+   the bitset engine against the map-only one, run this once from a
+   normal build and once from a build with EXTRAS=pack-bitset. */
+
+#define PACK_DEPTH        (4096UL)
+#define BANK_TILE_CNT        (4UL)
+#define MAX_TXN_PER_MICRO   (31UL)
+#define WRITE_CNT            (2UL)
+#define READ_CNT             (2UL)
+
+#define PACK_SCRATCH_SZ (512UL*1024UL*1024UL)
+uchar pack_scratch[ PACK_SCRATCH_SZ ] __attribute__((aligned(128)));
+
+uchar microblock[ MAX_TXN_PER_MICRO*FD_PACK_MICROBLOCK_TXN_MAX_SZ ] __attribute__((aligned(FD_PACK_MICROBLOCK_TXN_ALIGN)));
+
+static const uchar work_program_id[ FD_TXN_ACCT_ADDR_SZ ] = "Bench Program Id Does Some Work.";
+
+/* make_txn writes a transaction into slot with a unique signature
+   derived from sig, that writes the accounts identified by w and reads
+   the accounts identified by r, and that requests compute CUs and pays
+   rewards lamports in priority fees. */
+static void
+make_txn( fd_txn_p_t  * slot,
+          ulong         sig,
+          ulong const * w,
+          ulong const * r,
+          uint          compute,
+          uint          rewards ) {
+  uchar    * p_base = slot->payload;
+  uchar    * p      = p_base;
+  fd_txn_t * t      = TXN(slot);
+
+  *(p++) = (uchar)1;
+  memset( p, 0, FD_TXN_SIGNATURE_SZ ); FD_STORE( ulong, p, sig );  p += FD_TXN_SIGNATURE_SZ;
+
+  t->transaction_version   = FD_TXN_VLEGACY;
+  t->signature_cnt         = 1;
+  t->signature_off         = 1;
+  t->message_off           = FD_TXN_SIGNATURE_SZ+1UL;
+  t->readonly_signed_cnt   = 0;
+  t->readonly_unsigned_cnt = (uchar)(READ_CNT + 2UL);
+  t->acct_addr_cnt         = (ushort)(1UL + WRITE_CNT + 2UL + READ_CNT);
+  t->acct_addr_off         = FD_TXN_SIGNATURE_SZ+1UL;
+
+  /* Signer, then writable accounts, then the two programs, then the
+     readonly accounts.  Account ids are offset so that the signer's
+     address never collides with another account's. */
+  memset( p, 'S', FD_TXN_ACCT_ADDR_SZ ); FD_STORE( ulong, p, sig );                   p += FD_TXN_ACCT_ADDR_SZ;
+  for( ulong i=0UL; i<WRITE_CNT; i++ ) {
+    memset( p, 'A', FD_TXN_ACCT_ADDR_SZ ); FD_STORE( ulong, p, w[ i ] );              p += FD_TXN_ACCT_ADDR_SZ;
+  }
+  fd_memcpy( p, FD_COMPUTE_BUDGET_PROGRAM_ID, FD_TXN_ACCT_ADDR_SZ );                  p += FD_TXN_ACCT_ADDR_SZ;
+  fd_memcpy( p, work_program_id,              FD_TXN_ACCT_ADDR_SZ );                  p += FD_TXN_ACCT_ADDR_SZ;
+  for( ulong i=0UL; i<READ_CNT; i++ ) {
+    memset( p, 'A', FD_TXN_ACCT_ADDR_SZ ); FD_STORE( ulong, p, r[ i ] );              p += FD_TXN_ACCT_ADDR_SZ;
+  }
+
+  t->recent_blockhash_off         = 0;
+  t->addr_table_lookup_cnt        = 0;
+  t->addr_table_adtl_writable_cnt = 0;
+  t->addr_table_adtl_cnt          = 0;
+  t->instr_cnt                    = 2;
+
+  /* RequestUnitsDeprecated( compute, rewards ) */
+  t->instr[ 0 ].program_id = (uchar)(1UL+WRITE_CNT);
+  t->instr[ 0 ].acct_cnt   = 0;
+  t->instr[ 0 ].data_sz    = 9;
+  t->instr[ 0 ].acct_off   = (ushort)(p - p_base);
+  t->instr[ 0 ].data_off   = (ushort)(p - p_base);
+  *p = '\0'; fd_memcpy( p+1, &compute, sizeof(uint) ); fd_memcpy( p+5, &rewards, sizeof(uint) );
+  p += 9UL;
+
+  t->instr[ 1 ].program_id = (uchar)(2UL+WRITE_CNT);
+  t->instr[ 1 ].acct_cnt   = 0;
+  t->instr[ 1 ].data_sz    = 1;
+  t->instr[ 1 ].acct_off   = (ushort)(p - p_base);
+  t->instr[ 1 ].data_off   = (ushort)(p - p_base);
+  *(p++) = (uchar)0;
+
+  slot->payload_sz = (ulong)(p - p_base);
+}
+
+/* insert_one inserts a random transaction into pack.  In the contended
+   mix, all accounts are drawn from hot_cnt hot accounts.  Otherwise,
+   written accounts are fresh and read accounts are drawn from a set of
+   4096. */
+static void
+insert_one( fd_pack_t * pack,
+            fd_rng_t  * rng,
+            ulong     * next_id,
+            int         contended,
+            ulong       hot_cnt ) {
+  ulong w[ WRITE_CNT ];
+  ulong r[ READ_CNT  ];
+  if( contended ) {
+    /* Draw distinct accounts so the transaction is well-formed */
+    ulong picked[ WRITE_CNT+READ_CNT ];
+    for( ulong i=0UL; i<WRITE_CNT+READ_CNT; i++ ) {
+      int dup;
+      do {
+        picked[ i ] = fd_rng_ulong_roll( rng, hot_cnt );
+        dup = 0;
+        for( ulong j=0UL; j<i; j++ ) dup |= picked[ j ]==picked[ i ];
+      } while( dup );
+    }
+    for( ulong i=0UL; i<WRITE_CNT; i++ ) w[ i ] = picked[ i ];
+    for( ulong i=0UL; i<READ_CNT;  i++ ) r[ i ] = picked[ WRITE_CNT+i ];
+  } else {
+    for( ulong i=0UL; i<WRITE_CNT; i++ ) w[ i ] = 4096UL + (*next_id)++;
+    r[ 0 ] = fd_rng_ulong_roll( rng, 2048UL );
+    r[ 1 ] = 2048UL + fd_rng_ulong_roll( rng, 2048UL );
+  }
+
+  fd_txn_p_t * slot = fd_pack_insert_txn_init( pack );
+  make_txn( slot, (*next_id)++, w, r, 10000U + fd_rng_uint_roll( rng, 10000U ), 1000U + fd_rng_uint_roll( rng, 100000U ) );
+  fd_pack_insert_txn_fini( pack, slot, ULONG_MAX );
+}
+
+static void
+run( char const * name,
+     fd_rng_t   * rng,
+     int          contended,
+     ulong        hot_cnt,
+     ulong        microblock_cnt ) {
+  ulong footprint = fd_pack_footprint( PACK_DEPTH, BANK_TILE_CNT, MAX_TXN_PER_MICRO );
+  if( FD_UNLIKELY( footprint>PACK_SCRATCH_SZ ) ) FD_LOG_ERR(( "bench required %lu bytes, but scratch was only %lu", footprint, PACK_SCRATCH_SZ ));
+  fd_pack_t * pack = fd_pack_join( fd_pack_new( pack_scratch, PACK_DEPTH, BANK_TILE_CNT, MAX_TXN_PER_MICRO, rng ) );
+
+  ulong next_id = 0UL;
+  while( fd_pack_avail_txn_cnt( pack )<PACK_DEPTH ) insert_one( pack, rng, &next_id, contended, hot_cnt );
+
+  fd_pack_metrics_t const * metrics = fd_pack_metrics( pack );
+  ulong candidates0 = metrics->candidates_evaluated;
+  ulong fallback0   = metrics->bitset_fallback_cnt;
+
+  long  elapsed   = 0L;
+  ulong scheduled = 0UL;
+  for( ulong i=0UL; i<microblock_cnt; i++ ) {
+    ulong bank_tile = i % BANK_TILE_CNT;
+    fd_pack_microblock_complete( pack, bank_tile );
+
+    long start = fd_log_wallclock();
+    ulong microblock_sz;
+    ulong txn_cnt = fd_pack_schedule_next_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, bank_tile,
+                                                      microblock, sizeof(microblock), &microblock_sz );
+    elapsed += fd_log_wallclock() - start;
+
+    scheduled += txn_cnt;
+    for( ulong j=0UL; j<txn_cnt; j++ ) insert_one( pack, rng, &next_id, contended, hot_cnt );
+
+    /* Keep the per-block and per-account cost limits from dominating */
+    if( FD_UNLIKELY( (i%64UL)==63UL ) ) fd_pack_end_block( pack );
+  }
+
+  ulong candidates = metrics->candidates_evaluated - candidates0;
+  ulong fallback   = metrics->bitset_fallback_cnt  - fallback0;
+
+  FD_LOG_NOTICE(( "%-11s: %lu microblocks, %lu txns scheduled, %lu candidates (%.1f%% precise), "
+                  "%.3f ns/candidate, %.3e candidates/s",
+                  name, microblock_cnt, scheduled, candidates, 100.0*(double)fallback/(double)fd_ulong_max( candidates, 1UL ),
+                  (double)elapsed/(double)fd_ulong_max( candidates, 1UL ),
+                  1e9*(double)candidates/(double)fd_long_max( elapsed, 1L ) ));
+
+  fd_pack_delete( fd_pack_leave( pack ) );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong microblock_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--microblock-cnt", NULL,  10000UL );
+  ulong hot_cnt        = fd_env_strip_cmdline_ulong( &argc, &argv, "--hot-cnt",        NULL,     32UL );
+  uint  seed           = fd_env_strip_cmdline_uint ( &argc, &argv, "--seed",           NULL,      0U  );
+
+  if( FD_UNLIKELY( hot_cnt<WRITE_CNT+READ_CNT ) ) FD_LOG_ERR(( "--hot-cnt too small" ));
+
+  fd_rng_t _rng[1];
+  fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, seed, 0UL ) );
+
+  FD_LOG_NOTICE(( "Conflict detection: %s", FD_PACK_USE_BITSET ? "bitset" : "map" ));
+
+  run( "uncontended", rng, 0, hot_cnt, microblock_cnt );
+  run( "contended",   rng, 1, hot_cnt, microblock_cnt );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -0,0 +1,345 @@
+#include "../fd_ballet.h"
+#include "fd_pack.h"
+#include "fd_compute_budget_program.h"
+
+/* bench_pack_shard measures how scheduling throughput scales with the
+   number of shards of a sharded pack (see fd_pack_shard.h).  For each
+   shard count K in 1, 2, 4, ... up to --max-shards, it builds K shard
+   pack objects and a coordinator sharing one shard ctl, and runs rounds
+   in which:
+
+     - K*--arrival transactions arrive, are routed with
+       fd_pack_shard_route, and are inserted into their pack object,
+     - unless the coordinator holds the barrier, each shard schedules a
+       microblock for each of its bank tiles, and
+     - the coordinator requests the barrier once it has a microblock's
+       worth of transactions, and schedules
+       a microblock for each of shard 0's bank tiles once the shards
+       have parked.
+
+   Each shard is modeled as its own tile, but everything runs on one
+   thread here, so each shard's work is timed separately.  A round
+   takes as long as the slowest shard (which routes every arrival and
+   inserts and schedules its own) plus the coordinator, which runs while
+   the shards are parked.  Shard 0 also inserts into the coordinator.
+   Reported throughput is scheduled transactions per second of that
+   critical path.
+
+   --cross-frac is the fraction of transactions whose accounts are
+   drawn without regard to shards, which nearly always makes them
+   cross-shard for K>1.  The rest are drawn so that all of their
+   accounts, including the fee payer, belong to one shard.  Every
+   --rounds-per-block rounds the block ends, and the block fill reported
+   is the average cost of a block, across all the pack objects, as a
+   fraction of FD_PACK_MAX_COST_PER_BLOCK. */
+
+#define PACK_DEPTH        (4096UL)
+#define BANK_TILE_CNT        (4UL)
+#define MAX_TXN_PER_MICRO   (31UL)
+#define WRITE_CNT            (2UL)
+#define READ_CNT             (2UL)
+#define WRITE_ACCT_CNT (1UL<<20)
+#define READ_ACCT_CNT     (4096UL)
+
+#define PACK_SCRATCH_SZ (1024UL*1024UL*1024UL)
+uchar pack_scratch[ PACK_SCRATCH_SZ ] __attribute__((aligned(128)));
+
+uchar shard_ctl_mem[ FD_PACK_SHARD_CTL_FOOTPRINT ] __attribute__((aligned(FD_PACK_SHARD_CTL_ALIGN)));
+
+uchar microblock[ MAX_TXN_PER_MICRO*FD_PACK_MICROBLOCK_TXN_MAX_SZ ] __attribute__((aligned(FD_PACK_MICROBLOCK_TXN_ALIGN)));
+
+fd_txn_p_t arrivals[ FD_PACK_SHARD_MAX*BANK_TILE_CNT*MAX_TXN_PER_MICRO ];
+
+static const uchar work_program_id[ FD_TXN_ACCT_ADDR_SZ ] = "Bench Program Id Does Some Work.";
+
+/* acct_addr writes the address of the account with the given id and
+   tag ('S' for fee payers, 'A' for the rest) to addr. */
+static inline void
+acct_addr( fd_acct_addr_t * addr,
+           uchar            tag,
+           ulong            id ) {
+  memset( addr->b, tag, FD_TXN_ACCT_ADDR_SZ );
+  FD_STORE( ulong, addr->b, id );
+}
+
+static inline ulong
+acct_shard( uchar tag,
+            ulong id,
+            ulong shard_cnt ) {
+  fd_acct_addr_t addr[1];
+  acct_addr( addr, tag, id );
+  return fd_pack_shard_of( addr, shard_cnt );
+}
+
+/* make_txn writes a transaction into slot paid for by the account with
+   id sig and with signature sig, that writes the accounts identified by
+   w and reads the accounts identified by r, and that requests compute
+   CUs and pays rewards lamports in priority fees. */
+static void
+make_txn( fd_txn_p_t  * slot,
+          ulong         sig,
+          ulong const * w,
+          ulong const * r,
+          uint          compute,
+          uint          rewards ) {
+  uchar    * p_base = slot->payload;
+  uchar    * p      = p_base;
+  fd_txn_t * t      = TXN(slot);
+
+  *(p++) = (uchar)1;
+  memset( p, 0, FD_TXN_SIGNATURE_SZ ); FD_STORE( ulong, p, sig );  p += FD_TXN_SIGNATURE_SZ;
+
+  t->transaction_version   = FD_TXN_VLEGACY;
+  t->signature_cnt         = 1;
+  t->signature_off         = 1;
+  t->message_off           = FD_TXN_SIGNATURE_SZ+1UL;
+  t->readonly_signed_cnt   = 0;
+  t->readonly_unsigned_cnt = (uchar)(READ_CNT + 2UL);
+  t->acct_addr_cnt         = (ushort)(1UL + WRITE_CNT + 2UL + READ_CNT);
+  t->acct_addr_off         = FD_TXN_SIGNATURE_SZ+1UL;
+
+  /* Signer, then writable accounts, then the two programs, then the
+     readonly accounts. */
+  acct_addr( (fd_acct_addr_t *)p, 'S', sig );                                         p += FD_TXN_ACCT_ADDR_SZ;
+  for( ulong i=0UL; i<WRITE_CNT; i++ ) { acct_addr( (fd_acct_addr_t *)p, 'A', w[ i ] ); p += FD_TXN_ACCT_ADDR_SZ; }
+  fd_memcpy( p, FD_COMPUTE_BUDGET_PROGRAM_ID, FD_TXN_ACCT_ADDR_SZ );                  p += FD_TXN_ACCT_ADDR_SZ;
+  fd_memcpy( p, work_program_id,              FD_TXN_ACCT_ADDR_SZ );                  p += FD_TXN_ACCT_ADDR_SZ;
+  for( ulong i=0UL; i<READ_CNT;  i++ ) { acct_addr( (fd_acct_addr_t *)p, 'A', r[ i ] ); p += FD_TXN_ACCT_ADDR_SZ; }
+
+  t->recent_blockhash_off         = 0;
+  t->addr_table_lookup_cnt        = 0;
+  t->addr_table_adtl_writable_cnt = 0;
+  t->addr_table_adtl_cnt          = 0;
+  t->instr_cnt                    = 2;
+
+  /* RequestUnitsDeprecated( compute, rewards ) */
+  t->instr[ 0 ].program_id = (uchar)(1UL+WRITE_CNT);
+  t->instr[ 0 ].acct_cnt   = 0;
+  t->instr[ 0 ].data_sz    = 9;
+  t->instr[ 0 ].acct_off   = (ushort)(p - p_base);
+  t->instr[ 0 ].data_off   = (ushort)(p - p_base);
+  *p = '\0'; fd_memcpy( p+1, &compute, sizeof(uint) ); fd_memcpy( p+5, &rewards, sizeof(uint) );
+  p += 9UL;
+
+  t->instr[ 1 ].program_id = (uchar)(2UL+WRITE_CNT);
+  t->instr[ 1 ].acct_cnt   = 0;
+  t->instr[ 1 ].data_sz    = 1;
+  t->instr[ 1 ].acct_off   = (ushort)(p - p_base);
+  t->instr[ 1 ].data_off   = (ushort)(p - p_base);
+  *(p++) = (uchar)0;
+
+  slot->payload_sz = (ulong)(p - p_base);
+}
+
+/* draw_acct returns the id of a random account in [base, base+cnt)
+   that belongs to shard, or to any shard if shard is ULONG_MAX, and
+   isn't one of the n in used. */
+static ulong
+draw_acct( fd_rng_t    * rng,
+           ulong         base,
+           ulong         cnt,
+           ulong         shard,
+           ulong         shard_cnt,
+           ulong const * used,
+           ulong         n ) {
+  for(;;) {
+    ulong id = base + fd_rng_ulong_roll( rng, cnt );
+    if( (shard!=ULONG_MAX) && acct_shard( 'A', id, shard_cnt )!=shard ) continue;
+    int dup = 0;
+    for( ulong j=0UL; j<n; j++ ) dup |= used[ j ]==id;
+    if( !dup ) return id;
+  }
+}
+
+/* gen_txn writes a random transaction into slot, local to a random
+   shard with probability 1-cross_frac. */
+static void
+gen_txn( fd_txn_p_t * slot,
+         fd_rng_t   * rng,
+         ulong      * next_sig,
+         ulong        shard_cnt,
+         double       cross_frac ) {
+  ulong shard = ULONG_MAX;
+  if( fd_rng_double_o( rng )>=cross_frac ) shard = fd_rng_ulong_roll( rng, shard_cnt );
+
+  ulong sig;
+  do sig = (*next_sig)++; while( (shard!=ULONG_MAX) && acct_shard( 'S', sig, shard_cnt )!=shard );
+
+  ulong w[ WRITE_CNT ];
+  ulong r[ READ_CNT  ];
+  for( ulong i=0UL; i<WRITE_CNT; i++ ) w[ i ] = draw_acct( rng, 0UL,            WRITE_ACCT_CNT, shard, shard_cnt, w, i );
+  for( ulong i=0UL; i<READ_CNT;  i++ ) r[ i ] = draw_acct( rng, WRITE_ACCT_CNT, READ_ACCT_CNT,  shard, shard_cnt, r, i );
+
+  make_txn( slot, sig, w, r, 10000U + fd_rng_uint_roll( rng, 10000U ), 1000U + fd_rng_uint_roll( rng, 100000U ) );
+}
+
+static inline void
+insert( fd_pack_t        * pack,
+        fd_txn_p_t const * src ) {
+  fd_txn_p_t * slot = fd_pack_insert_txn_init( pack );
+  fd_memcpy( slot, src, sizeof(fd_txn_p_t) );
+  fd_pack_insert_txn_fini( pack, slot, ULONG_MAX );
+}
+
+/* schedule schedules a microblock for each bank tile of pack, and
+   returns the number of transactions scheduled. */
+static ulong
+schedule( fd_pack_t * pack ) {
+  ulong scheduled = 0UL;
+  for( ulong b=0UL; b<BANK_TILE_CNT; b++ ) {
+    ulong microblock_sz;
+    scheduled += fd_pack_schedule_next_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, b,
+                                                   microblock, sizeof(microblock), &microblock_sz );
+  }
+  return scheduled;
+}
+
+static void
+complete( fd_pack_t * pack ) {
+  for( ulong b=0UL; b<BANK_TILE_CNT; b++ ) fd_pack_microblock_complete( pack, b );
+}
+
+typedef struct {
+  double txns_per_s;
+  double cross_pct;
+  double fill_pct;
+  ulong  barrier_cnt;
+} result_t;
+
+static result_t
+run( fd_rng_t * rng,
+     ulong      shard_cnt,
+     double     cross_frac,
+     ulong      arrival,
+     ulong      round_cnt,
+     ulong      rounds_per_block ) {
+  ulong footprint = fd_pack_footprint( PACK_DEPTH, BANK_TILE_CNT, MAX_TXN_PER_MICRO );
+  ulong pack_cnt  = shard_cnt+1UL;
+  ulong stride    = fd_ulong_align_up( footprint, fd_pack_align() );
+  if( FD_UNLIKELY( stride*pack_cnt>PACK_SCRATCH_SZ ) )
+    FD_LOG_ERR(( "bench required %lu bytes, but scratch was only %lu", stride*pack_cnt, PACK_SCRATCH_SZ ));
+
+  fd_pack_shard_ctl_t * ctl = fd_pack_shard_ctl_join( fd_pack_shard_ctl_new( shard_ctl_mem, shard_cnt ) );
+
+  fd_pack_t * pack[ FD_PACK_SHARD_MAX+1UL ];
+  for( ulong i=0UL; i<pack_cnt; i++ ) {
+    pack[ i ] = fd_pack_join( fd_pack_new( pack_scratch + i*stride, PACK_DEPTH, BANK_TILE_CNT, MAX_TXN_PER_MICRO, rng ) );
+    fd_pack_set_shard_ctl( pack[ i ], ctl, i==shard_cnt );
+  }
+  fd_pack_t * coord = pack[ shard_cnt ];
+
+  ulong next_sig = 0UL;
+  ulong arrival_cnt = arrival*shard_cnt;
+
+  long  shard_ns[ FD_PACK_SHARD_MAX ];
+  long  critical  = 0L;
+  ulong scheduled = 0UL;
+  ulong cross_cnt = 0UL;
+  ulong total_cnt = 0UL;
+  ulong barrier_cnt = 0UL;
+  ulong fill_sum  = 0UL;
+  ulong block_cnt = 0UL;
+  int   requested = 0;
+
+  for( ulong round=0UL; round<round_cnt; round++ ) {
+    for( ulong i=0UL; i<arrival_cnt; i++ ) gen_txn( arrivals+i, rng, &next_sig, shard_cnt, cross_frac );
+
+    /* Every shard routes every arrival */
+    long start = fd_log_wallclock();
+    ulong dest[ FD_PACK_SHARD_MAX*BANK_TILE_CNT*MAX_TXN_PER_MICRO ];
+    for( ulong i=0UL; i<arrival_cnt; i++ ) dest[ i ] = fd_pack_shard_route( TXN(arrivals+i), arrivals[ i ].payload, NULL, shard_cnt );
+    long route_ns = fd_log_wallclock() - start;
+    for( ulong s=0UL; s<shard_cnt; s++ ) shard_ns[ s ] = route_ns;
+
+    for( ulong i=0UL; i<arrival_cnt; i++ ) {
+      ulong s = fd_ulong_if( dest[ i ]==FD_PACK_SHARD_CROSS, shard_cnt, dest[ i ] );
+      start = fd_log_wallclock();
+      insert( pack[ s ], arrivals+i );
+      shard_ns[ fd_ulong_if( s==shard_cnt, 0UL, s ) ] += fd_log_wallclock() - start;
+      cross_cnt += (ulong)(s==shard_cnt);
+    }
+    total_cnt += arrival_cnt;
+
+    int block_end = (round%rounds_per_block)==rounds_per_block-1UL;
+    if( !requested && fd_pack_avail_txn_cnt( coord )>=MAX_TXN_PER_MICRO ) {
+      fd_pack_shard_ctl_request( ctl );
+      requested = 1;
+    }
+
+    /* Microblocks scheduled in the previous round are done by now */
+    for( ulong s=0UL; s<shard_cnt; s++ ) {
+      complete( pack[ s ] );
+      if( !fd_pack_shard_ctl_may_schedule( ctl, s, 1 ) ) continue;
+      start = fd_log_wallclock();
+      scheduled += schedule( pack[ s ] );
+      shard_ns[ s ] += fd_log_wallclock() - start;
+    }
+
+    long round_ns = 0L;
+    for( ulong s=0UL; s<shard_cnt; s++ ) round_ns = fd_long_max( round_ns, shard_ns[ s ] );
+
+    if( requested && fd_pack_shard_ctl_quiesced( ctl ) ) {
+      start = fd_log_wallclock();
+      scheduled += schedule( coord );
+      round_ns += fd_log_wallclock() - start;
+      complete( coord );
+      fd_pack_shard_ctl_release( ctl );
+      requested = 0;
+      barrier_cnt++;
+    }
+    critical += round_ns;
+
+    if( block_end ) {
+      fill_sum += fd_pack_shard_ctl_used( ctl, FD_PACK_SHARD_BUDGET_BLOCK );
+      block_cnt++;
+      for( ulong i=0UL; i<pack_cnt; i++ ) fd_pack_end_block( pack[ i ] );
+      fd_pack_shard_ctl_new_block( ctl );
+    }
+  }
+
+  for( ulong i=0UL; i<pack_cnt; i++ ) fd_pack_delete( fd_pack_leave( pack[ i ] ) );
+  fd_pack_shard_ctl_delete( fd_pack_shard_ctl_leave( ctl ) );
+
+  result_t res;
+  res.txns_per_s  = 1e9*(double)scheduled/(double)fd_long_max( critical, 1L );
+  res.cross_pct   = 100.0*(double)cross_cnt/(double)fd_ulong_max( total_cnt, 1UL );
+  res.fill_pct    = 100.0*(double)fill_sum/((double)FD_PACK_MAX_COST_PER_BLOCK*(double)fd_ulong_max( block_cnt, 1UL ));
+  res.barrier_cnt = barrier_cnt;
+  return res;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong  max_shards       = fd_env_strip_cmdline_ulong ( &argc, &argv, "--max-shards",       NULL,  8UL  );
+  double cross_frac       = fd_env_strip_cmdline_double( &argc, &argv, "--cross-frac",       NULL,  0.01 );
+  ulong  arrival          = fd_env_strip_cmdline_ulong ( &argc, &argv, "--arrival",          NULL, BANK_TILE_CNT*MAX_TXN_PER_MICRO );
+  ulong  round_cnt        = fd_env_strip_cmdline_ulong ( &argc, &argv, "--round-cnt",        NULL, 512UL );
+  ulong  rounds_per_block = fd_env_strip_cmdline_ulong ( &argc, &argv, "--rounds-per-block", NULL,  2UL  );
+  uint   seed             = fd_env_strip_cmdline_uint  ( &argc, &argv, "--seed",             NULL,  0U   );
+
+  if( FD_UNLIKELY( (max_shards==0UL) | (max_shards>FD_PACK_SHARD_MAX) ) ) FD_LOG_ERR(( "--max-shards must be in [1, %lu]", FD_PACK_SHARD_MAX ));
+  if( FD_UNLIKELY( arrival>BANK_TILE_CNT*MAX_TXN_PER_MICRO ) ) FD_LOG_ERR(( "--arrival must be at most %lu", BANK_TILE_CNT*MAX_TXN_PER_MICRO ));
+  if( FD_UNLIKELY( !rounds_per_block ) ) FD_LOG_ERR(( "--rounds-per-block must be positive" ));
+
+  fd_rng_t _rng[1];
+  fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, seed, 0UL ) );
+
+  FD_LOG_NOTICE(( "Conflict detection: %s, cross-shard fraction %.3f", FD_PACK_USE_BITSET ? "bitset" : "map", cross_frac ));
+
+  double base = 0.0;
+  for( ulong k=1UL; k<=max_shards; k*=2UL ) {
+    result_t res = run( rng, k, cross_frac, arrival, round_cnt, rounds_per_block );
+    if( k==1UL ) base = res.txns_per_s;
+    FD_LOG_NOTICE(( "shards %2lu: %.3e txns/s, speedup %.2fx, %.2f%% cross-shard, %lu barriers, block fill %.1f%%",
+                    k, res.txns_per_s, res.txns_per_s/base, res.cross_pct, res.barrier_cnt, res.fill_pct ));
+  }
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
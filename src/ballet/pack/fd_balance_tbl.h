@@ -0,0 +1,192 @@
+#ifndef HEADER_fd_src_ballet_pack_fd_balance_tbl_h
+#define HEADER_fd_src_ballet_pack_fd_balance_tbl_h
+
+#include "../fd_ballet_base.h"
+#include "../txn/fd_txn.h"
+
+/* fd_balance_tbl is a snapshot of the lamport balances of a set of
+   accounts, typically recent fee payers, that pack uses to drop
+   transactions whose fee payer can't afford them.  It is an open
+   addressed hash table with linear probing meant to live in a workspace
+   shared between whatever refreshes the balances from the account
+   store (the writer) and pack (the reader).
+
+   Each slot is protected by a sequence lock, as in fd_alt_cache:
+
+     - There must be at most one writer at a time.  The writer makes the
+       sequence number of a slot odd, updates the slot, and then makes
+       it even again.
+     - Readers copy the slot and retry if the sequence number was odd or
+       changed while they did.
+
+   Slots are never removed individually, since that would break probe
+   sequences for concurrent readers.  Instead, the writer can clear the
+   whole table, e.g. when it gets too full of accounts that haven't paid
+   fees in a while.  A reader that races with a clear or with the insert
+   of a new account may not find the account, which is always safe
+   because an account that isn't found is assumed to be able to afford
+   anything.
+
+   The all-zero address, which is the address of the system program and
+   so can't be a fee payer, marks an empty slot and can't be stored. */
+
+#define FD_BALANCE_TBL_MAGIC (0xF17EDA2C37BA1A00UL) /* F17E=FIRE,DA2C/37=DANCER,BA1A=BALA,00=V0 / FIREDANCER BALANCE TBL V0 */
+
+#define FD_BALANCE_TBL_ALIGN (64UL)
+
+#define FD_BALANCE_TBL_FOOTPRINT( slot_cnt ) ( sizeof(fd_balance_tbl_t) + ((slot_cnt)-1UL)*sizeof(fd_balance_tbl_slot_t) )
+
+struct __attribute__((aligned(FD_BALANCE_TBL_ALIGN))) fd_private_balance_tbl_slot {
+  ulong          seq;      /* odd while the slot is being written */
+  ulong          lamports;
+  fd_acct_addr_t key;      /* all zero if the slot is empty */
+};
+typedef struct fd_private_balance_tbl_slot fd_balance_tbl_slot_t;
+
+struct __attribute__((aligned(FD_BALANCE_TBL_ALIGN))) fd_private_balance_tbl {
+  /* magic: set to FD_BALANCE_TBL_MAGIC */
+  ulong magic;
+  /* slot_cnt_mask: (slot_cnt_mask+1) is the number of slots, a power of
+     two */
+  ulong slot_cnt_mask;
+  /* slots: the array of (slot_cnt_mask+1) slots follows.  The array
+     size of 1 is just convention. */
+  fd_balance_tbl_slot_t slots[1];
+};
+typedef struct fd_private_balance_tbl fd_balance_tbl_t;
+
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_balance_tbl_{align, footprint} return the alignment and footprint
+   of a region of memory suitable for a table with slot_cnt slots.
+   slot_cnt must be a power of two.  For good performance, the table
+   should hold at most about half as many accounts as it has slots.
+   fd_balance_tbl_footprint returns 0 for an invalid slot_cnt. */
+FD_FN_CONST static inline ulong fd_balance_tbl_align    ( void ) { return FD_BALANCE_TBL_ALIGN; }
+FD_FN_CONST static inline ulong fd_balance_tbl_footprint( ulong slot_cnt ) {
+  if( FD_UNLIKELY( !slot_cnt || !fd_ulong_is_pow2( slot_cnt )                                         ) ) return 0UL;
+  if( FD_UNLIKELY(  slot_cnt > ((ULONG_MAX - sizeof(fd_balance_tbl_t))/sizeof(fd_balance_tbl_slot_t)) ) ) return 0UL;
+  return FD_BALANCE_TBL_FOOTPRINT( slot_cnt );
+}
+
+/* fd_balance_tbl_clear empties tbl.  Same rules as
+   fd_balance_tbl_update. */
+static inline void
+fd_balance_tbl_clear( fd_balance_tbl_t * tbl ) {
+  for( ulong i=0UL; i<=tbl->slot_cnt_mask; i++ ) {
+    fd_balance_tbl_slot_t * slot = tbl->slots + i;
+    ulong seq = slot->seq;
+    FD_VOLATILE( slot->seq ) = seq+1UL;
+    FD_COMPILER_MFENCE();
+    fd_memset( slot->key.b, 0, FD_TXN_ACCT_ADDR_SZ );
+    slot->lamports = 0UL;
+    FD_COMPILER_MFENCE();
+    FD_VOLATILE( slot->seq ) = seq+2UL;
+  }
+}
+
+/* fd_balance_tbl_new formats mem, which must have the required
+   alignment and footprint, as an empty table with slot_cnt slots.
+   Returns mem on success and NULL if slot_cnt is invalid.  The memory
+   region can be shared with other threads or processes; each should
+   have its own join. */
+static inline void *
+fd_balance_tbl_new( void * mem,
+                    ulong  slot_cnt ) {
+  if( FD_UNLIKELY( !fd_balance_tbl_footprint( slot_cnt ) ) ) return NULL;
+  fd_balance_tbl_t * tbl = (fd_balance_tbl_t *)mem;
+  tbl->slot_cnt_mask = slot_cnt-1UL;
+  for( ulong i=0UL; i<slot_cnt; i++ ) tbl->slots[ i ].seq = 0UL;
+  fd_balance_tbl_clear( tbl );
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( tbl->magic ) = FD_BALANCE_TBL_MAGIC;
+  FD_COMPILER_MFENCE();
+  return mem;
+}
+
+static inline fd_balance_tbl_t *
+fd_balance_tbl_join( void * _tbl ) {
+  fd_balance_tbl_t * tbl = (fd_balance_tbl_t *)_tbl;
+  if( FD_UNLIKELY( tbl->magic != FD_BALANCE_TBL_MAGIC ) ) return NULL;
+  return tbl;
+}
+static inline void * fd_balance_tbl_leave ( fd_balance_tbl_t * tbl ) { return (void *)tbl; }
+static inline void * fd_balance_tbl_delete( fd_balance_tbl_t * tbl ) {
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( tbl->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+  return (void *)tbl;
+}
+
+FD_FN_PURE static inline ulong
+fd_balance_tbl_private_start( fd_balance_tbl_t const * tbl,
+                              fd_acct_addr_t const   * acct ) {
+  return fd_ulong_hash( fd_ulong_load_8( acct->b ) ) & tbl->slot_cnt_mask;
+}
+
+FD_FN_PURE static inline int
+fd_balance_tbl_private_is_empty( fd_acct_addr_t const * key ) {
+  return (fd_ulong_load_8( key->b )|fd_ulong_load_8( key->b+8 )|fd_ulong_load_8( key->b+16 )|fd_ulong_load_8( key->b+24 ))==0UL;
+}
+
+/* fd_balance_tbl_update sets the balance of acct to lamports, adding
+   acct to tbl if it isn't there yet.  Returns 1 on success and 0 if
+   acct isn't in tbl and tbl is full.  acct must not be the all-zero
+   address.  Must not be called concurrently with another update or
+   clear, but can be called concurrently with fd_balance_tbl_query. */
+static inline int
+fd_balance_tbl_update( fd_balance_tbl_t     * tbl,
+                       fd_acct_addr_t const * acct,
+                       ulong                  lamports ) {
+  ulong mask = tbl->slot_cnt_mask;
+  ulong idx  = fd_balance_tbl_private_start( tbl, acct );
+  for( ulong probe=0UL; probe<=mask; probe++ ) {
+    fd_balance_tbl_slot_t * slot  = tbl->slots + ((idx+probe) & mask);
+    int                     empty = fd_balance_tbl_private_is_empty( &slot->key );
+    if( empty || !memcmp( slot->key.b, acct->b, FD_TXN_ACCT_ADDR_SZ ) ) {
+      ulong seq = slot->seq;
+      FD_VOLATILE( slot->seq ) = seq+1UL;
+      FD_COMPILER_MFENCE();
+      slot->key      = *acct;
+      slot->lamports = lamports;
+      FD_COMPILER_MFENCE();
+      FD_VOLATILE( slot->seq ) = seq+2UL;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/* fd_balance_tbl_query looks up the balance of acct.  Returns 1 and
+   stores the balance at *lamports if acct is in tbl, and returns 0
+   otherwise.  Safe to call concurrently with the writer. */
+static inline int
+fd_balance_tbl_query( fd_balance_tbl_t const * tbl,
+                      fd_acct_addr_t const   * acct,
+                      ulong                  * lamports ) {
+  ulong mask = tbl->slot_cnt_mask;
+  ulong idx  = fd_balance_tbl_private_start( tbl, acct );
+  for( ulong probe=0UL; probe<=mask; probe++ ) {
+    fd_balance_tbl_slot_t const * slot = tbl->slots + ((idx+probe) & mask);
+    fd_acct_addr_t key;
+    ulong          val;
+    for(;;) {
+      ulong seq0 = FD_VOLATILE_CONST( slot->seq );
+      FD_COMPILER_MFENCE();
+      key = slot->key;
+      val = slot->lamports;
+      FD_COMPILER_MFENCE();
+      ulong seq1 = FD_VOLATILE_CONST( slot->seq );
+      if( FD_LIKELY( (seq0==seq1) & !(seq0 & 1UL) ) ) break;
+      FD_SPIN_PAUSE();
+    }
+    if( fd_balance_tbl_private_is_empty( &key ) ) return 0;
+    if( !memcmp( key.b, acct->b, FD_TXN_ACCT_ADDR_SZ ) ) { *lamports = val; return 1; }
+  }
+  return 0;
+}
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_pack_fd_balance_tbl_h */
@@ -0,0 +1,166 @@
+#ifndef HEADER_fd_src_ballet_pack_fd_fee_stats_h
+#define HEADER_fd_src_ballet_pack_fd_fee_stats_h
+
+#include "../fd_ballet_base.h"
+#include "../txn/fd_txn.h"
+
+/* fd_fee_stats is a small snapshot of the local fee market that pack
+   publishes for monitoring and RPC: for each of the most contended
+   accounts (the ones written by the most pending transactions), how
+   many pending transactions write it, the approximate minimum and
+   median priority fee they pay per compute unit, and how many compute
+   units of transactions writing it have been scheduled in the current
+   block.
+
+   Pack is the only writer and republishes the whole table at once, so
+   the table is protected by a single sequence lock:
+
+     - The writer makes the sequence number odd, rewrites the table, and
+       then makes it even again.
+     - Readers copy the table and retry if the sequence number was odd
+       or changed while they did.
+
+   Readers never block pack, so the table can be mapped read-only by
+   any number of processes.
+
+   Fees are in micro-lamports per compute unit and exclude the
+   signature fee, i.e. they are the priority fee of a transaction
+   divided by its estimated cost. */
+
+#define FD_FEE_STATS_MAGIC (0xF17EDA2C37FEE500UL) /* F17E=FIRE,DA2C/37=DANCER,FEE5=FEES,00=V0 / FIREDANCER FEE STATS V0 */
+
+#define FD_FEE_STATS_ALIGN (64UL)
+
+#define FD_FEE_STATS_FOOTPRINT ( sizeof(fd_fee_stats_t) )
+
+/* FD_FEE_STATS_ACCT_MAX is the number of accounts the table tracks. */
+#define FD_FEE_STATS_ACCT_MAX (32UL)
+
+struct __attribute__((aligned(64))) fd_fee_stats_acct {
+  fd_acct_addr_t key;
+  /* pending_cnt: the number of pending transactions that write key */
+  ulong          pending_cnt;
+  /* {min,median}_fee_per_cu: the approximate minimum and median
+     priority fee per compute unit of those transactions, in
+     micro-lamports */
+  ulong          min_fee_per_cu;
+  ulong          median_fee_per_cu;
+  /* cus_scheduled: the compute units of transactions that write key
+     scheduled so far in the current block */
+  ulong          cus_scheduled;
+};
+typedef struct fd_fee_stats_acct fd_fee_stats_acct_t;
+
+struct __attribute__((aligned(FD_FEE_STATS_ALIGN))) fd_private_fee_stats {
+  /* magic: set to FD_FEE_STATS_MAGIC */
+  ulong magic;
+  /* seq: odd while the table is being written */
+  ulong seq;
+  /* pending_cnt: the total number of pending transactions, not
+     counting the vote lane */
+  ulong pending_cnt;
+  /* acct_cnt: the number of valid entries in accts, sorted by
+     pending_cnt, largest first */
+  ulong acct_cnt;
+  fd_fee_stats_acct_t accts[ FD_FEE_STATS_ACCT_MAX ];
+};
+typedef struct fd_private_fee_stats fd_fee_stats_t;
+
+FD_PROTOTYPES_BEGIN
+
+FD_FN_CONST static inline ulong fd_fee_stats_align    ( void ) { return FD_FEE_STATS_ALIGN;     }
+FD_FN_CONST static inline ulong fd_fee_stats_footprint( void ) { return FD_FEE_STATS_FOOTPRINT;  }
+
+/* fd_fee_stats_new formats mem, which must have the required alignment
+   and footprint, as an empty table.  Returns mem.  The memory region
+   can be shared with other threads or processes; each should have its
+   own join. */
+static inline void *
+fd_fee_stats_new( void * mem ) {
+  fd_fee_stats_t * stats = (fd_fee_stats_t *)mem;
+  fd_memset( stats, 0, sizeof(fd_fee_stats_t) );
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( stats->magic ) = FD_FEE_STATS_MAGIC;
+  FD_COMPILER_MFENCE();
+  return mem;
+}
+
+static inline fd_fee_stats_t *
+fd_fee_stats_join( void * _stats ) {
+  fd_fee_stats_t * stats = (fd_fee_stats_t *)_stats;
+  if( FD_UNLIKELY( stats->magic != FD_FEE_STATS_MAGIC ) ) return NULL;
+  return stats;
+}
+static inline void * fd_fee_stats_leave ( fd_fee_stats_t * stats ) { return (void *)stats; }
+static inline void * fd_fee_stats_delete( fd_fee_stats_t * stats ) {
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( stats->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+  return (void *)stats;
+}
+
+/* fd_fee_stats_publish replaces the contents of stats with the
+   acct_cnt entries of accts (at most FD_FEE_STATS_ACCT_MAX, extras are
+   dropped) and the total pending count pending_cnt.  There must be at
+   most one writer at a time. */
+static inline void
+fd_fee_stats_publish( fd_fee_stats_t            * stats,
+                      fd_fee_stats_acct_t const * accts,
+                      ulong                       acct_cnt,
+                      ulong                       pending_cnt ) {
+  acct_cnt = fd_ulong_min( acct_cnt, FD_FEE_STATS_ACCT_MAX );
+  ulong seq = stats->seq;
+  FD_VOLATILE( stats->seq ) = seq+1UL;
+  FD_COMPILER_MFENCE();
+  stats->pending_cnt = pending_cnt;
+  stats->acct_cnt    = acct_cnt;
+  fd_memcpy( stats->accts, accts, acct_cnt*sizeof(fd_fee_stats_acct_t) );
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( stats->seq ) = seq+2UL;
+}
+
+/* fd_fee_stats_read copies a consistent snapshot of the entries of
+   stats to out, which must have room for FD_FEE_STATS_ACCT_MAX
+   entries, and returns the number of entries copied.  If
+   opt_pending_cnt is non-NULL, the total pending count is stored there.
+   Safe to call concurrently with the writer. */
+static inline ulong
+fd_fee_stats_read( fd_fee_stats_t const * stats,
+                   fd_fee_stats_acct_t  * out,
+                   ulong                * opt_pending_cnt ) {
+  ulong acct_cnt;
+  ulong pending_cnt;
+  for(;;) {
+    ulong seq0 = FD_VOLATILE_CONST( stats->seq );
+    FD_COMPILER_MFENCE();
+    pending_cnt = stats->pending_cnt;
+    acct_cnt    = fd_ulong_min( stats->acct_cnt, FD_FEE_STATS_ACCT_MAX );
+    fd_memcpy( out, stats->accts, acct_cnt*sizeof(fd_fee_stats_acct_t) );
+    FD_COMPILER_MFENCE();
+    ulong seq1 = FD_VOLATILE_CONST( stats->seq );
+    if( FD_LIKELY( (seq0==seq1) & !(seq0 & 1UL) ) ) break;
+    FD_SPIN_PAUSE();
+  }
+  if( opt_pending_cnt ) *opt_pending_cnt = pending_cnt;
+  return acct_cnt;
+}
+
+/* fd_fee_stats_query looks up acct in stats.  Returns 1 and stores a
+   consistent copy of its entry at out if acct is one of the tracked
+   accounts, and returns 0 otherwise.  Safe to call concurrently with
+   the writer. */
+static inline int
+fd_fee_stats_query( fd_fee_stats_t const * stats,
+                    fd_acct_addr_t const * acct,
+                    fd_fee_stats_acct_t  * out ) {
+  fd_fee_stats_acct_t accts[ FD_FEE_STATS_ACCT_MAX ];
+  ulong acct_cnt = fd_fee_stats_read( stats, accts, NULL );
+  for( ulong i=0UL; i<acct_cnt; i++ ) {
+    if( !memcmp( accts[ i ].key.b, acct->b, FD_TXN_ACCT_ADDR_SZ ) ) { *out = accts[ i ]; return 1; }
+  }
+  return 0;
+}
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_pack_fd_fee_stats_h */
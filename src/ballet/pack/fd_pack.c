@@ -2,13 +2,46 @@
 #include "fd_pack.h"
 #include "fd_pack_cost.h"
 #include "fd_compute_budget_program.h"
+#include "../txn/fd_compact_u16.h"
 #include <math.h> /* for sqrt */
 #include <stddef.h> /* for offsetof */
+#if FD_PACK_USE_BITSET && FD_HAS_AVX
+#include "../../util/simd/fd_avx.h"
+#endif
 
 
 /* Declare a bunch of helper structs used for pack-internal data
    structures. */
 
+#if FD_PACK_USE_BITSET
+/* Each account address hashes to one of FD_PACK_BITSET_MAX bits.  Bit
+   FD_PACK_BITSET_NULL is never set and is used for padding so that
+   lists of bit indices can be tested 8 at a time.  A bitset occupies
+   FD_PACK_BITSET_WORD_CNT ulongs, which includes the null bit. */
+#define FD_PACK_BITSET_MAX         (16384UL)
+#define FD_PACK_BITSET_NULL        ((ushort)FD_PACK_BITSET_MAX)
+#define FD_PACK_BITSET_WORD_CNT    (FD_PACK_BITSET_MAX/64UL + 4UL)
+#define FD_PACK_BITSET_ACCT_BIT_MAX (FD_TXN_ACCT_ADDR_MAX + 16UL)
+#endif
+
+/* fd_pack_alt_chunk_t: FD_PACK_ALT_CHUNK_SZ of the resolved addresses
+   of the accounts a pending transaction loads from address lookup
+   tables.  Most transactions don't use lookup tables and most of the
+   ones that do load a handful of accounts, so rather than reserving
+   room for FD_TXN_ACCT_ADDR_MAX addresses in every fd_pack_ord_txn_t,
+   they're stored in chunks from a pool shared by all of them.  The pool
+   has room for FD_PACK_ALT_ACCT_PER_TXN addresses per pending
+   transaction on average.  next is only used while the chunk is free. */
+#define FD_PACK_ALT_CHUNK_SZ     (8UL)
+#define FD_PACK_ALT_CHUNK_MAX    (FD_TXN_ACCT_ADDR_MAX/FD_PACK_ALT_CHUNK_SZ)
+#define FD_PACK_ALT_ACCT_PER_TXN (16UL)
+
+union fd_pack_private_alt_chunk {
+  ulong          next;
+  fd_acct_addr_t acct[ FD_PACK_ALT_CHUNK_SZ ];
+};
+typedef union fd_pack_private_alt_chunk fd_pack_alt_chunk_t;
+
 
 /* fd_pack_ord_txn_t: An fd_txn_p_t with information required to order
    it by priority */
@@ -26,16 +59,86 @@ struct fd_pack_private_ord_txn {
   uint         rewards;     /* in Lamports */
   uint         compute_est; /* in compute units */
 
+  /* txn_compute_est and txn_rewards are the cost and fee of just this
+     transaction.  For the first transaction of a bundle, rewards and
+     compute_est are the totals over the whole bundle so that the bundle
+     is ordered and limited as a unit.  Otherwise, they're equal.  The
+     other bundle_cnt-1 transactions of the bundle are in no tree, but
+     hang off the first one, in order, via bundle_next. */
+  uint         txn_compute_est;
+  uint         txn_rewards;
+  ushort       bundle_cnt;
+  ulong        bundle_next;
+
+  /* is_lane_vote: 1 if this is a simple vote inserted on its own (not
+     in a bundle) whose vote account pack could determine.  Those go in
+     the vote lane instead of a treap, see vote_head below. */
+  ushort       is_lane_vote;
+
+  /* fee_bucket: for the first transaction of a bundle or a transaction
+     inserted on its own, the fee histogram bucket (see
+     fd_pack_fee_bucket) its writable accounts are counted in for the
+     fee statistics, or FD_PACK_FEE_UNTRACKED or FD_PACK_FEE_OFF if they
+     aren't.  Set on insert. */
+  ushort       fee_bucket;
+
   /* The treap fields */
   ulong parent;
   ulong left;
   ulong right;
   ulong prio;
 
-  /* Since this struct can be in one of several trees, it's helpful to
-     store which tree.  This should be one of the FD_ORD_TXN_ROOT_*
+  /* expires_at is the value given to fd_pack_insert_txn_fini.  While
+     the transaction is pending, it's also in the expiry treap, which
+     is ordered by expires_at and uses the exp_* fields. */
+  ulong expires_at;
+  ulong exp_parent;
+  ulong exp_left;
+  ulong exp_right;
+  ulong exp_prio;
+
+  /* While the transaction is blocked (root is one of the
+     FD_ORD_TXN_ROOT_BLOCKED_* values), it's in neither the pending treap
+     nor the vote lane but in a doubly linked list, using blk_prev and
+     blk_next, of the transactions waiting on the same thing.  While a
+     vote is in the vote lane, blk_prev and blk_next link it in the lane
+     instead.  blk_acct is the index of
+     the account whose lock it's waiting on in the blk_member-th
+     transaction of its bundle (0 if it's not a bundle). */
+  ulong  blk_prev;
+  ulong  blk_next;
+  ushort blk_acct;
+  ushort blk_member; /* Which transaction of the bundle has blk_acct */
+
+  /* Since this struct can be in one of several trees or lists, it's
+     helpful to store which one.  This should be one of the FD_ORD_TXN_ROOT_*
      values. */
   int root;
+
+  /* acct_cat is the category of accounts (see fd_txn.h) that pack
+     knows the addresses of: FD_TXN_ACCT_CAT_ALL, unless the transaction
+     loads accounts from address lookup tables that couldn't be
+     resolved, in which case it's FD_TXN_ACCT_CAT_IMM and only the
+     accounts listed in the transaction itself are checked for
+     conflicts.  The resolved addresses of the accounts loaded from
+     lookup tables are in the alt_chunk_cnt chunks of the ALT pool (see
+     fd_pack_alt_chunk_t) listed in alt_chunk, in order, so that account
+     acct_addr_cnt+i is address i%FD_PACK_ALT_CHUNK_SZ of chunk
+     alt_chunk[ i/FD_PACK_ALT_CHUNK_SZ ].  Use fd_pack_ord_acct to
+     access accounts.  Populated on insert. */
+  int    acct_cat;
+  ushort alt_chunk_cnt;
+  uint   alt_chunk[ FD_PACK_ALT_CHUNK_MAX ];
+
+#if FD_PACK_USE_BITSET
+  /* acct_bit holds the bitset index of each of the transaction's
+     writable accounts, padded with FD_PACK_BITSET_NULL to a multiple
+     of 8, followed by the same for its readonly accounts.  w_bit_cnt
+     and r_bit_cnt are the unpadded counts.  Populated on insert. */
+  ushort w_bit_cnt;
+  ushort r_bit_cnt;
+  ushort acct_bit[ FD_PACK_BITSET_ACCT_BIT_MAX ];
+#endif
 };
 typedef struct fd_pack_private_ord_txn fd_pack_ord_txn_t;
 
@@ -52,26 +155,73 @@ FD_STATIC_ASSERT( offsetof( fd_pack_ord_txn_t, txn->payload )==0UL, fd_pack_ord_
 
 #define FD_ORD_TXN_ROOT_FREE 0
 #define FD_ORD_TXN_ROOT_PENDING 1
-#define FD_ORD_TXN_ROOT_PENDING_VOTE 2
-#define FD_ORD_TXN_ROOT_DELAYED_BASE 3 /* [3, 3+FD_PACK_MAX_GAP) */
-
-/* fd_pack_addr_use_t: Used for two distinct purposes: to record that an
-   address is in use and can't be used again until the nth microblock,
-   and to keep track of the cost of all transactions that write to the
-   specified account.  If these were different structs, they'd have
-   identical shape and result in two fd_map_dynamic sets of functions
-   with identical code.  It doesn't seem like the compiler is very good
-   at merging code like that, so in order to reduce code bloat, we'll
-   just combine them. */
+#define FD_ORD_TXN_ROOT_PENDING_VOTE 2  /* In the vote lane */
+#define FD_ORD_TXN_ROOT_BLOCKED_ACCT 3  /* Waiting for an account lock to be released */
+#define FD_ORD_TXN_ROOT_BLOCKED_BLOCK 4 /* Waiting for the next block */
+
+/* fd_pack_addr_use_t: Used for three distinct purposes: to record which
+   bank tiles currently hold a lock on an address, to keep track of the
+   cost of all transactions that write to the specified account, and to
+   keep track of the fees paid by the specified fee payer.  If these
+   were different structs, they'd have identical shape and result in
+   several fd_map_dynamic sets of functions with identical code.  It
+   doesn't seem like the compiler is very good at merging code like
+   that, so in order to reduce code bloat, we'll just combine them. */
 struct fd_pack_private_addr_use_record {
   fd_acct_addr_t key; /* account address */
   union{
-    ulong          in_use_until; /* In microblocks */
+    ulong          in_use_by;  /* Bitmask of bank tiles, see below */
     ulong          total_cost; /* In cost units/CUs */
+    ulong          spent;      /* In lamports */
   };
+  /* blocked_head: only used in acct_in_use.  Pool index of the first
+     transaction blocked until the lock on this account is released, or
+     null.  See fd_pack_block. */
+  ulong            blocked_head;
 };
 typedef struct fd_pack_private_addr_use_record fd_pack_addr_use_t;
 
+/* fd_pack_vote_acct_t: Maps the vote account of each vote in the vote
+   lane (or blocked from it) to that vote, so that a newer vote for the
+   same account can replace it. */
+struct fd_pack_private_vote_acct {
+  fd_acct_addr_t key;     /* vote account address */
+  ulong          txn_idx; /* pool index of the pending vote */
+  ulong          slot;    /* last slot it votes for, see fd_pack_vote_slot */
+};
+typedef struct fd_pack_private_vote_acct fd_pack_vote_acct_t;
+
+/* FD_PACK_FEE_HIST_CNT: the number of buckets of the fee per CU
+   histograms, see fd_pack_fee_bucket.  FD_PACK_FEE_UNTRACKED is the
+   fee_bucket of a transaction that's only counted in fee_pending_cnt,
+   and FD_PACK_FEE_OFF that of one that isn't counted at all. */
+#define FD_PACK_FEE_HIST_CNT  (64UL)
+#define FD_PACK_FEE_UNTRACKED ((ushort)USHORT_MAX)
+#define FD_PACK_FEE_OFF       ((ushort)(USHORT_MAX-1))
+
+/* fd_pack_fee_acct_t: Counts the pending transactions that write each
+   account, for fd_pack_publish_fee_stats.  Updated as transactions are
+   inserted and removed.  An account with no pending writers is not in
+   the map. */
+struct fd_pack_private_fee_acct {
+  fd_acct_addr_t key;         /* account address */
+  uint           pending_cnt;
+  uint           top_idx;     /* index in fee_top, or UINT_MAX */
+  /* hist[ b ]: how many of those transactions pay a priority fee per CU
+     in bucket b */
+  uint           hist[ FD_PACK_FEE_HIST_CNT ];
+};
+typedef struct fd_pack_private_fee_acct fd_pack_fee_acct_t;
+
+/* in_use_by: bit i (for i in [0, FD_PACK_MAX_BANK_TILES)) is set if the
+   outstanding microblock at bank tile i reads or writes the account.
+   FD_PACK_IN_USE_WRITABLE is set if the account is written, in which
+   case exactly one bank tile bit is set.  An account with no bank tile
+   bits set is not in the map. */
+#define FD_PACK_IN_USE_WRITABLE  (0x8000000000000000UL)
+#define FD_PACK_IN_USE_BANK_MASK (0x3FFFFFFFFFFFFFFFUL)
+FD_STATIC_ASSERT( FD_PACK_MAX_BANK_TILES<=62UL, fd_pack_in_use );
+
 
 /* fd_pack_sig_to_entry_t: An element of an fd_map that maps the first
    transaction signature to the corresponding fd_pack_ord_txn_t so that
@@ -100,6 +250,11 @@ typedef struct fd_pack_sig_to_txn fd_pack_sig_to_txn_t;
 #define POOL_NEXT       parent
 #include "../../util/tmpl/fd_pool.c"
 
+#define POOL_NAME       alt_pool
+#define POOL_T          fd_pack_alt_chunk_t
+#define POOL_NEXT       next
+#include "../../util/tmpl/fd_pool.c"
+
 #define TREAP_T         fd_pack_ord_txn_t
 #define TREAP_NAME      treap
 #define TREAP_QUERY_T   void *                                         /* We don't use query ... */
@@ -108,6 +263,19 @@ typedef struct fd_pack_sig_to_txn fd_pack_sig_to_txn_t;
 #define TREAP_LT        COMPARE_WORSE
 #include "../../util/tmpl/fd_treap.c"
 
+/* Every pending transaction is also in a treap ordered by expiry so
+   that the ones that expire first can be found without a scan. */
+#define TREAP_T         fd_pack_ord_txn_t
+#define TREAP_NAME      expq
+#define TREAP_QUERY_T   void *
+#define TREAP_CMP(a,b)  (__extension__({ (void)(a); (void)(b); -1; }))
+#define TREAP_LT(e0,e1) ((e0)->expires_at<(e1)->expires_at)
+#define TREAP_PARENT    exp_parent
+#define TREAP_LEFT      exp_left
+#define TREAP_RIGHT     exp_right
+#define TREAP_PRIO      exp_prio
+#include "../../util/tmpl/fd_treap.c"
+
 
 /* Define a strange map where key and value are kind of the same
    variable.  Essentially, it maps the contents to which the pointer
@@ -137,11 +305,70 @@ static const fd_acct_addr_t null_addr = { 0 };
 #define MAP_KEY_HASH(key)     ((uint)fd_ulong_hash( fd_ulong_load_8( (key).b ) ))
 #include "../../util/tmpl/fd_map_dynamic.c"
 
+#define MAP_NAME              vote_accts
+#define MAP_T                 fd_pack_vote_acct_t
+#define MAP_KEY_T             fd_acct_addr_t
+#define MAP_KEY_NULL          null_addr
+#define MAP_KEY_INVAL(k)      MAP_KEY_EQUAL(k, null_addr)
+#define MAP_KEY_EQUAL(k0,k1)  (!memcmp((k0).b,(k1).b, FD_TXN_ACCT_ADDR_SZ))
+#define MAP_KEY_EQUAL_IS_SLOW 1
+#define MAP_MEMOIZE           0
+#define MAP_KEY_HASH(key)     ((uint)fd_ulong_hash( fd_ulong_load_8( (key).b ) ))
+#include "../../util/tmpl/fd_map_dynamic.c"
+
+#define MAP_NAME              fee_accts
+#define MAP_T                 fd_pack_fee_acct_t
+#define MAP_KEY_T             fd_acct_addr_t
+#define MAP_KEY_NULL          null_addr
+#define MAP_KEY_INVAL(k)      MAP_KEY_EQUAL(k, null_addr)
+#define MAP_KEY_EQUAL(k0,k1)  (!memcmp((k0).b,(k1).b, FD_TXN_ACCT_ADDR_SZ))
+#define MAP_KEY_EQUAL_IS_SLOW 1
+#define MAP_MEMOIZE           0
+#define MAP_KEY_HASH(key)     ((uint)fd_hash( 0UL, (key).b, FD_TXN_ACCT_ADDR_SZ ))
+#include "../../util/tmpl/fd_map_dynamic.c"
+
+
+#if FD_PACK_USE_BITSET
+
+static inline ushort
+fd_pack_bitset_idx( fd_acct_addr_t const * addr ) {
+  return (ushort)(fd_ulong_hash( fd_ulong_load_8( addr->b ) ) & (FD_PACK_BITSET_MAX-1UL));
+}
+
+static inline void
+fd_pack_bitset_insert( ulong * set,
+                       ushort  bit ) {
+  set[ bit>>6 ] |= 1UL<<(bit&63);
+}
+
+/* fd_pack_bitset_test_any returns 1 if any of the bits in bit[ i ] for
+   i in [0, cnt) is set in set and 0 otherwise.  cnt must be a multiple
+   of 8. */
+static inline int
+fd_pack_bitset_test_any( ulong  const * set,
+                         ushort const * bit,
+                         ulong          cnt ) {
+#if FD_HAS_AVX
+  wu_t hits = wu_zero();
+  for( ulong i=0UL; i<cnt; i+=8UL ) {
+    wu_t idx  = _mm256_cvtepu16_epi32( _mm_loadu_si128( (__m128i const *)(bit+i) ) );
+    wu_t word = _mm256_i32gather_epi32( (int const *)set, wu_shr( idx, 5 ), 4 );
+    hits = wu_or( hits, wu_and( word, wu_shl_vector( wu_one(), wu_and( idx, wu_bcast( 31U ) ) ) ) );
+  }
+  return wc_any( wu_to_wc( hits ) );
+#else
+  ulong hits = 0UL;
+  for( ulong i=0UL; i<cnt; i++ ) hits |= set[ bit[ i ]>>6 ] & (1UL<<(bit[ i ]&63));
+  return !!hits;
+#endif
+}
+
+#endif /* FD_PACK_USE_BITSET */
 
 /* Finally, we can now declare the main pack data structure */
 struct fd_pack_private {
   ulong      pack_depth;
-  ulong      gap;
+  ulong      bank_tile_cnt;
   ulong      max_txn_per_microblock;
 
   ulong      pending_txn_cnt;
@@ -149,9 +376,34 @@ struct fd_pack_private {
                                 generated in this block? */
   fd_rng_t * rng;
 
+  /* cu_est: if non-NULL, refines the cost estimate of inserted
+     transactions.  See fd_pack_set_cu_est_tbl. */
+  fd_est_ftbl_t const * cu_est;
+
+  /* alt_cache: if non-NULL, used to resolve accounts loaded from
+     address lookup tables.  See fd_pack_set_alt_cache. */
+  fd_alt_cache_t const * alt_cache;
+
+  /* balances: if non-NULL, the fee payer balances used to drop
+     transactions that can't be afforded.  See fd_pack_set_balance_tbl.
+     payer_spend holds the fees of the transactions scheduled in this
+     block by fee payer. */
+  fd_balance_tbl_t const * balances;
+
+  /* shard_ctl: if non-NULL, the shard ctl whose block-wide cost
+     counters this pack object shares with the other pack objects of a
+     sharded pack.  write_cost_limit is this pack object's part of the
+     per-account write cost limit.  See fd_pack_set_shard_ctl. */
+  fd_pack_shard_ctl_t * shard_ctl;
+  ulong                 write_cost_limit;
+
   ulong      cumulative_block_cost;
   ulong      cumulative_vote_cost;
 
+  /* outstanding_microblock_mask: bit i is set if bank tile i has been
+     given a microblock that it has not yet reported as complete. */
+  ulong      outstanding_microblock_mask;
+
   /* The actual footprint for the pool and maps is allocated
      in the same order in which they are declared immediately following
      the struct.  I.e. these pointers point to memory not far after the
@@ -160,61 +412,137 @@ struct fd_pack_private {
 
   fd_pack_ord_txn_t * pool;
 
+  /* alt_pool holds the resolved addresses of the accounts pending
+     transactions load from address lookup tables.  See
+     fd_pack_alt_chunk_t. */
+  fd_pack_alt_chunk_t * alt_pool;
+
   /* Transactions in the pool can be in one of various trees.  The
-     default situation is that the transaction is in pending
-     pending_votes, depending on whether it is a vote or not.
-
-     If this were the only storage for transactions though, in the case
-     that there are a lot of transactions that conflict, we'd end up
-     going through transactions a bunch of times.  To optimize that,
-     when we know that we won't be able to consider a transaction until
-     at least the kth microblock in the future, we stick it in a "data
-     structure" like a bucket queue based on when it will become
-     available.
-
-     This is just a performance optimization and done on a best effort
-     basis; a transaction coming out of delayed might still not be
-     available because of new conflicts.  Transactions in pending might
-     have conflicts we just haven't discovered yet.  The authoritative
-     source for conflicts is acct_uses_{read,write}.
-
-     Unlike typical bucket queues, the buckets here form a ring, and
-     each element of the ring is a tree. */
+     default situation is that the transaction is in pending, or in the
+     vote lane if it's a lane vote (see is_lane_vote).  Transactions in
+     pending might have conflicts we just haven't discovered yet.  The
+     authoritative source for conflicts is acct_in_use. */
 
   treap_t pending[1];
-  treap_t pending_votes[1];
-  treap_t delayed[ FD_PACK_MAX_GAP ]; /* bucket queue */
 
-  fd_pack_addr_use_t   * read_in_use; /* Map from account address to microblock when it can be used */
-  fd_pack_addr_use_t   * write_in_use;
+  /* The vote lane: a doubly linked list, through blk_prev and blk_next,
+     of the pending lane votes that aren't blocked, oldest first.  Votes
+     all cost and pay about the same, so there's nothing to gain from
+     ordering them by priority, and a list makes inserting, scheduling,
+     and evicting a vote O(1).  vote_head and vote_tail are pool
+     indices, or null if the lane is empty.  vote_accts maps the vote
+     account of every pending lane vote (blocked or not) to it, so that
+     only the latest vote for each vote account is kept. */
+  ulong                 vote_head;
+  ulong                 vote_tail;
+  fd_pack_vote_acct_t * vote_accts;
+
+  /* A transaction that is found to conflict while scheduling is taken
+     out of its treap so that it isn't evaluated again and again while
+     the conflict lasts.  If it conflicts with an outstanding
+     microblock, it's put in the list of transactions blocked on the
+     account in question (see blocked_head in acct_in_use), and goes
+     back to its treap when the lock on that account is released.  If
+     it would exceed a per-account limit, it's put in the
+     blocked_block_head list and goes back at the end of the block. */
+  ulong   blocked_block_head;
+
+  /* expiring: every pending transaction (in pending, the vote lane, or
+     blocked), ordered by expires_at. */
+  expq_t  expiring[1];
+
+  /* acct_in_use: Map from account address to the bank tiles that
+     currently hold a lock on it.  See in_use_by above. */
+  fd_pack_addr_use_t   * acct_in_use;
   fd_pack_addr_use_t   * writer_costs;
+  fd_pack_addr_use_t   * payer_spend;
   fd_pack_sig_to_txn_t * signature_map; /* Stores pointers into pool for deleting by signature */
+
+  /* fee_stats: if non-NULL, where fd_pack_publish_fee_stats publishes
+     to, and fee_accts the fee statistics of each account written by
+     pending transactions outside the vote lane that were inserted since
+     it was set.  fee_top holds the addresses of the (roughly) most
+     contended of those, the ones that fd_pack_publish_fee_stats
+     publishes, and fee_top_pending their pending_cnt.  fee_pending_cnt
+     is the number of those pending transactions.  See
+     fd_pack_set_fee_stats. */
+  fd_fee_stats_t       * fee_stats;
+  fd_pack_fee_acct_t   * fee_accts;
+  ulong                  fee_pending_cnt;
+  ulong                  fee_top_cnt;
+  fd_acct_addr_t         fee_top        [ FD_FEE_STATS_ACCT_MAX ];
+  uint                   fee_top_pending[ FD_FEE_STATS_ACCT_MAX ];
+
+  /* use_by_bank: for each bank tile, the list of addresses locked by
+     its outstanding microblock, so that they can be released in
+     fd_pack_microblock_complete without a scan of acct_in_use.  Each
+     address appears at most once per bank tile.  use_by_bank[ i ]
+     points to max_txn_per_microblock*FD_TXN_ACCT_ADDR_MAX elements in
+     the footprint, and use_by_bank_cnt[ i ] of them are valid. */
+  fd_acct_addr_t * use_by_bank    [ FD_PACK_MAX_BANK_TILES ];
+  ulong            use_by_bank_cnt[ FD_PACK_MAX_BANK_TILES ];
+
+  fd_pack_metrics_t metrics[1];
+
+#if FD_PACK_USE_BITSET
+  /* Conservative approximations of acct_in_use and writer_costs.  A
+     bit is set in w_in_use if any account that hashes to it is written
+     by an outstanding microblock, and in rw_in_use if it is read or
+     written.  A bit is set in w_saturated if any account that hashes
+     to it has a writer cost over half the per-account limit.  Since no
+     transaction costs more than that half (checked before using the
+     bitsets), a transaction none of whose bits are set can't conflict.
+     bank_w_in_use and bank_rw_in_use point to bank_tile_cnt bitsets
+     each in the footprint, one per bank tile, and w_in_use and
+     rw_in_use are the union of those. */
+  ulong   w_in_use   [ FD_PACK_BITSET_WORD_CNT ] __attribute__((aligned(32)));
+  ulong   rw_in_use  [ FD_PACK_BITSET_WORD_CNT ] __attribute__((aligned(32)));
+  ulong   w_saturated[ FD_PACK_BITSET_WORD_CNT ] __attribute__((aligned(32)));
+  ulong * bank_w_in_use;
+  ulong * bank_rw_in_use;
+#endif
 };
 
 typedef struct fd_pack_private fd_pack_t;
 
+/* fd_pack_alt_chunk_cnt returns the number of chunks in the ALT pool of
+   a pack object with depth pack_depth.  It always has room for a
+   bundle that loads as many accounts as possible. */
+static inline ulong
+fd_pack_alt_chunk_cnt( ulong pack_depth ) {
+  return fd_ulong_max( pack_depth*FD_PACK_ALT_ACCT_PER_TXN/FD_PACK_ALT_CHUNK_SZ, FD_PACK_MAX_TXN_PER_BUNDLE*FD_PACK_ALT_CHUNK_MAX );
+}
+
 ulong
 fd_pack_footprint( ulong pack_depth,
-                   ulong gap,
+                   ulong bank_tile_cnt,
                    ulong max_txn_per_microblock ) {
-  if( FD_UNLIKELY( (gap==0) | (gap>FD_PACK_MAX_GAP) ) ) return 0UL;
+  if( FD_UNLIKELY( (bank_tile_cnt==0) | (bank_tile_cnt>FD_PACK_MAX_BANK_TILES) ) ) return 0UL;
 
   ulong l;
-  ulong max_acct_in_flight = FD_TXN_ACCT_ADDR_MAX * (gap+1UL) * max_txn_per_microblock;
+  ulong max_acct_in_flight = FD_TXN_ACCT_ADDR_MAX * bank_tile_cnt * max_txn_per_microblock;
   ulong max_txn_per_block  = FD_PACK_MAX_COST_PER_BLOCK / FD_PACK_MIN_TXN_COST;
 
   /* log base 2, but with a 2* so that the hash table stays sparse */
   int lg_uses_tbl_sz = fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*max_acct_in_flight ) );
   int lg_max_txn     = fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*max_txn_per_block  ) );
   int lg_depth       = fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*pack_depth         ) );
+  ulong alt_chunk_cnt = fd_pack_alt_chunk_cnt( pack_depth );
 
   l = FD_LAYOUT_INIT;
-  l = FD_LAYOUT_APPEND( l, FD_PACK_ALIGN,      sizeof(fd_pack_t)                      );
-  l = FD_LAYOUT_APPEND( l, trp_pool_align (),  trp_pool_footprint ( pack_depth+1UL )  );
-  l = FD_LAYOUT_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_uses_tbl_sz )  );
-  l = FD_LAYOUT_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_uses_tbl_sz )  );
-  l = FD_LAYOUT_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_max_txn     )  );
-  l = FD_LAYOUT_APPEND( l, sig2txn_align  (),  sig2txn_footprint  ( lg_depth       )  );
+  l = FD_LAYOUT_APPEND( l, FD_PACK_ALIGN,          sizeof(fd_pack_t)                      );
+  l = FD_LAYOUT_APPEND( l, trp_pool_align (),      trp_pool_footprint ( pack_depth+FD_PACK_MAX_TXN_PER_BUNDLE )  );
+  l = FD_LAYOUT_APPEND( l, acct_uses_align(),      acct_uses_footprint( lg_uses_tbl_sz )  );
+  l = FD_LAYOUT_APPEND( l, acct_uses_align(),      acct_uses_footprint( lg_max_txn     )  );
+  l = FD_LAYOUT_APPEND( l, acct_uses_align(),      acct_uses_footprint( lg_max_txn     )  );
+  l = FD_LAYOUT_APPEND( l, sig2txn_align  (),      sig2txn_footprint  ( lg_depth       )  );
+  l = FD_LAYOUT_APPEND( l, vote_accts_align(),     vote_accts_footprint( lg_depth      )  );
+  l = FD_LAYOUT_APPEND( l, fee_accts_align(),      fee_accts_footprint( lg_depth+1     )  );
+  l = FD_LAYOUT_APPEND( l, alt_pool_align (),      alt_pool_footprint ( alt_chunk_cnt  )  );
+  l = FD_LAYOUT_APPEND( l, alignof(fd_acct_addr_t), max_acct_in_flight*sizeof(fd_acct_addr_t) );
+#if FD_PACK_USE_BITSET
+  l = FD_LAYOUT_APPEND( l, 32UL,                   2UL*bank_tile_cnt*FD_PACK_BITSET_WORD_CNT*sizeof(ulong) );
+#endif
   return FD_LAYOUT_FINI( l, FD_PACK_ALIGN );
 }
 
@@ -222,52 +550,88 @@ fd_pack_footprint( ulong pack_depth,
 void *
 fd_pack_new( void *     mem,
              ulong      pack_depth,
-             ulong      gap,
+             ulong      bank_tile_cnt,
              ulong      max_txn_per_microblock,
              fd_rng_t * rng                     ) {
 
-  ulong max_acct_in_flight = FD_TXN_ACCT_ADDR_MAX * (gap+1UL) * max_txn_per_microblock;
+  if( FD_UNLIKELY( !fd_pack_footprint( pack_depth, bank_tile_cnt, max_txn_per_microblock ) ) ) {
+    FD_LOG_WARNING(( "bad bank_tile_cnt (%lu)", bank_tile_cnt ));
+    return NULL;
+  }
+
+  ulong max_acct_in_flight = FD_TXN_ACCT_ADDR_MAX * bank_tile_cnt * max_txn_per_microblock;
   ulong max_txn_per_block  = FD_PACK_MAX_COST_PER_BLOCK / FD_PACK_MIN_TXN_COST;
 
   /* log base 2, but with a 2* so that the hash table stays sparse */
   int lg_uses_tbl_sz = fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*max_acct_in_flight ) );
   int lg_max_txn     = fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*max_txn_per_block  ) );
   int lg_depth       = fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*pack_depth         ) );
+  ulong alt_chunk_cnt = fd_pack_alt_chunk_cnt( pack_depth );
 
   FD_SCRATCH_ALLOC_INIT( l, mem );
-  /* The pool has one extra element that is used between insert_init and
-     cancel/fini. */
+  /* The pool has FD_PACK_MAX_TXN_PER_BUNDLE extra elements that are used
+     between insert_{txn,bundle}_init and cancel/fini. */
   fd_pack_t * pack   = FD_SCRATCH_ALLOC_APPEND( l,  FD_PACK_ALIGN,                  sizeof(fd_pack_t)                     );
-  void * _pool       = FD_SCRATCH_ALLOC_APPEND( l,  trp_pool_align(),               trp_pool_footprint ( pack_depth+1UL ) );
-  void * _uses_read  = FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(),              acct_uses_footprint( lg_uses_tbl_sz ) );
-  void * _uses_write = FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(),              acct_uses_footprint( lg_uses_tbl_sz ) );
+  void * _pool       = FD_SCRATCH_ALLOC_APPEND( l,  trp_pool_align(),               trp_pool_footprint ( pack_depth+FD_PACK_MAX_TXN_PER_BUNDLE ) );
+  void * _uses       = FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(),              acct_uses_footprint( lg_uses_tbl_sz ) );
   void * _writer_cost= FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(),              acct_uses_footprint( lg_max_txn     ) );
+  void * _payer_spend= FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(),              acct_uses_footprint( lg_max_txn     ) );
   void * _sig_map    = FD_SCRATCH_ALLOC_APPEND( l,  sig2txn_align(),                sig2txn_footprint  ( lg_depth       ) );
-
-  pack->pack_depth             = pack_depth;
-  pack->gap                    = gap;
-  pack->max_txn_per_microblock = max_txn_per_microblock;
-  pack->pending_txn_cnt        = 0UL;
-  pack->microblock_cnt         = 0UL;
-  pack->rng                    = rng;
-  pack->cumulative_block_cost  = 0UL;
-  pack->cumulative_vote_cost   = 0UL;
+  void * _vote_accts = FD_SCRATCH_ALLOC_APPEND( l,  vote_accts_align(),             vote_accts_footprint( lg_depth      ) );
+  void * _fee_accts  = FD_SCRATCH_ALLOC_APPEND( l,  fee_accts_align(),              fee_accts_footprint( lg_depth+1     ) );
+  void * _alt_pool   = FD_SCRATCH_ALLOC_APPEND( l,  alt_pool_align(),               alt_pool_footprint ( alt_chunk_cnt  ) );
+
+  pack->pack_depth                  = pack_depth;
+  pack->bank_tile_cnt               = bank_tile_cnt;
+  pack->max_txn_per_microblock      = max_txn_per_microblock;
+  pack->pending_txn_cnt             = 0UL;
+  pack->microblock_cnt              = 0UL;
+  pack->rng                         = rng;
+  pack->cu_est                      = NULL;
+  pack->alt_cache                   = NULL;
+  pack->balances                    = NULL;
+  pack->shard_ctl                   = NULL;
+  pack->write_cost_limit            = FD_PACK_MAX_WRITE_COST_PER_ACCT;
+  pack->cumulative_block_cost       = 0UL;
+  pack->cumulative_vote_cost        = 0UL;
+  pack->outstanding_microblock_mask = 0UL;
+  pack->fee_stats                   = NULL;
+  pack->fee_pending_cnt             = 0UL;
+  pack->fee_top_cnt                 = 0UL;
 
   treap_new( (void*)pack->pending,       pack_depth );
-  treap_new( (void*)pack->pending_votes, pack_depth );
-  for( ulong i=0UL; i<FD_PACK_MAX_GAP; i++ ) treap_new( (void*)(pack->delayed+i), pack_depth );
-
+  expq_new ( (void*)pack->expiring,      pack_depth );
 
-  trp_pool_new(  _pool,        pack_depth+1UL );
-  acct_uses_new( _uses_read,   lg_uses_tbl_sz );
-  acct_uses_new( _uses_write,  lg_uses_tbl_sz );
+  trp_pool_new(  _pool,        pack_depth+FD_PACK_MAX_TXN_PER_BUNDLE );
+  acct_uses_new( _uses,        lg_uses_tbl_sz );
   acct_uses_new( _writer_cost, lg_max_txn     );
+  acct_uses_new( _payer_spend, lg_max_txn     );
   sig2txn_new(   _sig_map,     lg_depth       );
+  vote_accts_new( _vote_accts, lg_depth       );
+  fee_accts_new( _fee_accts,   lg_depth+1     );
+  alt_pool_new(  _alt_pool,    alt_chunk_cnt  );
 
   fd_pack_ord_txn_t * pool = trp_pool_join( _pool );
-  treap_seed( pool, pack_depth+1UL, fd_rng_ulong( rng ) );
+  treap_seed( pool, pack_depth+FD_PACK_MAX_TXN_PER_BUNDLE, fd_rng_ulong( rng ) );
+  expq_seed ( pool, pack_depth+FD_PACK_MAX_TXN_PER_BUNDLE, fd_rng_ulong( rng ) );
+  pack->blocked_block_head = trp_pool_idx_null( pool );
+  pack->vote_head          = trp_pool_idx_null( pool );
+  pack->vote_tail          = trp_pool_idx_null( pool );
   (void)trp_pool_leave( pool );
 
+  for( ulong i=0UL; i<FD_PACK_MAX_BANK_TILES; i++ ) pack->use_by_bank_cnt[ i ] = 0UL;
+
+  memset( pack->metrics, 0, sizeof(fd_pack_metrics_t) );
+
+#if FD_PACK_USE_BITSET
+  memset( pack->w_in_use,    0, sizeof(pack->w_in_use   ) );
+  memset( pack->rw_in_use,   0, sizeof(pack->rw_in_use  ) );
+  memset( pack->w_saturated, 0, sizeof(pack->w_saturated) );
+  (void)FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_acct_addr_t), max_acct_in_flight*sizeof(fd_acct_addr_t) );
+  ulong * bank_bitsets = FD_SCRATCH_ALLOC_APPEND( l, 32UL, 2UL*bank_tile_cnt*FD_PACK_BITSET_WORD_CNT*sizeof(ulong) );
+  memset( bank_bitsets, 0, 2UL*bank_tile_cnt*FD_PACK_BITSET_WORD_CNT*sizeof(ulong) );
+#endif
+
   return mem;
 }
 
@@ -277,21 +641,34 @@ fd_pack_join( void * mem ) {
   fd_pack_t * pack  = FD_SCRATCH_ALLOC_APPEND( l, FD_PACK_ALIGN, sizeof(fd_pack_t) );
 
   ulong pack_depth             = pack->pack_depth;
-  ulong gap                    = pack->gap;
+  ulong bank_tile_cnt          = pack->bank_tile_cnt;
   ulong max_txn_per_microblock = pack->max_txn_per_microblock;
 
-  ulong max_acct_in_flight = FD_TXN_ACCT_ADDR_MAX * (gap+1UL) * max_txn_per_microblock;
+  ulong max_acct_in_flight = FD_TXN_ACCT_ADDR_MAX * bank_tile_cnt * max_txn_per_microblock;
   ulong max_txn_per_block  = FD_PACK_MAX_COST_PER_BLOCK / FD_PACK_MIN_TXN_COST;
   int lg_uses_tbl_sz = fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*max_acct_in_flight ) );
   int lg_max_txn     = fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*max_txn_per_block  ) );
   int lg_depth       = fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*pack_depth         ) );
+  ulong alt_chunk_cnt = fd_pack_alt_chunk_cnt( pack_depth );
 
 
-  pack->pool          = trp_pool_join(  FD_SCRATCH_ALLOC_APPEND( l,  trp_pool_align(),  trp_pool_footprint ( pack_depth+1UL ) ) );
-  pack->read_in_use   = acct_uses_join( FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(), acct_uses_footprint( lg_uses_tbl_sz ) ) );
-  pack->write_in_use  = acct_uses_join( FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(), acct_uses_footprint( lg_uses_tbl_sz ) ) );
+  pack->pool          = trp_pool_join(  FD_SCRATCH_ALLOC_APPEND( l,  trp_pool_align(),  trp_pool_footprint ( pack_depth+FD_PACK_MAX_TXN_PER_BUNDLE ) ) );
+  pack->acct_in_use   = acct_uses_join( FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(), acct_uses_footprint( lg_uses_tbl_sz ) ) );
   pack->writer_costs  = acct_uses_join( FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(), acct_uses_footprint( lg_max_txn     ) ) );
+  pack->payer_spend   = acct_uses_join( FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(), acct_uses_footprint( lg_max_txn     ) ) );
   pack->signature_map = sig2txn_join(   FD_SCRATCH_ALLOC_APPEND( l,  sig2txn_align(),   sig2txn_footprint  ( lg_depth       ) ) );
+  pack->vote_accts    = vote_accts_join( FD_SCRATCH_ALLOC_APPEND( l, vote_accts_align(), vote_accts_footprint( lg_depth     ) ) );
+  pack->fee_accts     = fee_accts_join( FD_SCRATCH_ALLOC_APPEND( l,  fee_accts_align(), fee_accts_footprint( lg_depth+1     ) ) );
+  pack->alt_pool      = alt_pool_join(  FD_SCRATCH_ALLOC_APPEND( l,  alt_pool_align(),  alt_pool_footprint ( alt_chunk_cnt  ) ) );
+
+  fd_acct_addr_t * use_by_bank = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_acct_addr_t), max_acct_in_flight*sizeof(fd_acct_addr_t) );
+  for( ulong i=0UL; i<bank_tile_cnt; i++ ) pack->use_by_bank[ i ] = use_by_bank + i*max_txn_per_microblock*FD_TXN_ACCT_ADDR_MAX;
+
+#if FD_PACK_USE_BITSET
+  ulong * bank_bitsets = FD_SCRATCH_ALLOC_APPEND( l, 32UL, 2UL*bank_tile_cnt*FD_PACK_BITSET_WORD_CNT*sizeof(ulong) );
+  pack->bank_w_in_use  = bank_bitsets;
+  pack->bank_rw_in_use = bank_bitsets + bank_tile_cnt*FD_PACK_BITSET_WORD_CNT;
+#endif
 
   return pack;
 }
@@ -299,16 +676,20 @@ fd_pack_join( void * mem ) {
 
 
 static int
-fd_pack_estimate_rewards_and_compute( fd_txn_p_t        * txnp,
+fd_pack_estimate_rewards_and_compute( fd_pack_t         * pack,
+                                      fd_txn_p_t        * txnp,
                                       fd_pack_ord_txn_t * out ) {
   fd_txn_t * txn = TXN(txnp);
   ulong sig_rewards = FD_PACK_FEE_PER_SIGNATURE * txn->signature_cnt;
 
-  ulong cost = fd_pack_compute_cost( txnp, &txnp->is_simple_vote );
+  ulong non_builtin_cost;
+  ulong cost = fd_pack_compute_cost( txnp, &txnp->is_simple_vote, &non_builtin_cost );
 
   if( FD_UNLIKELY( !cost ) ) return 0;
 
   fd_compute_budget_program_state_t cb_prog_st = {0};
+  fd_est_ftbl_t const * cu_est = pack->cu_est;
+  float                 est_cus = 0.0f;
 
   /* TODO: Refactor so that this doesn't scan all the instructions a
      second time after scanning them in fd_pack_compute_cost. */
@@ -320,17 +701,36 @@ fd_pack_estimate_rewards_and_compute( fd_txn_p_t        * txnp,
       /* Parse the compute budget program instruction */
       if( FD_UNLIKELY( !fd_compute_budget_program_parse( txnp->payload+txn->instr[ i ].data_off, txn->instr[ i ].data_sz, &cb_prog_st )))
         return 0;
-    } else {
-      /* No fancy CU estimation in this version of pack */
+    } else if( cu_est ) {
+      /* Built-in programs are included too, but their cost is fixed and
+         not part of non_builtin_cost, so at worst this is a slight
+         overestimate for transactions that mix the two. */
+      float var;
+      float mean = fd_est_ftbl_estimate( cu_est, fd_pack_cu_est_tag( acct_addr ), &var );
+      est_cus += mean + sqrtf( var );
     }
   }
+  if( FD_UNLIKELY( cu_est ) ) {
+    /* Clamp before converting, converting an out of range float is UB.
+       Written such that NaN maps to max as well, though NaN can't be
+       relied on with -ffast-math. */
+    est_cus   = fd_float_if( !(est_cus<(float)FD_PACK_MAX_TXN_COST), (float)FD_PACK_MAX_TXN_COST, est_cus );
+    ulong est = (ulong)est_cus;
+    cost = cost - non_builtin_cost + fd_ulong_min( non_builtin_cost, est );
+  }
   ulong adtl_rewards = 0UL;
   uint  compute_max  = 0UL;
   fd_compute_budget_program_finalize( &cb_prog_st, txn->instr_cnt, &adtl_rewards, &compute_max );
   out->rewards     = (adtl_rewards < (UINT_MAX - sig_rewards)) ? (uint)(sig_rewards + adtl_rewards) : UINT_MAX;
   out->compute_est = (uint)cost;
 
-  out->root = txnp->is_simple_vote ? FD_ORD_TXN_ROOT_PENDING_VOTE : FD_ORD_TXN_ROOT_PENDING;
+  out->txn_compute_est = (uint)cost;
+  out->txn_rewards     = out->rewards;
+  out->bundle_cnt      = (ushort)1;
+  out->bundle_next     = trp_pool_idx_null( pack->pool );
+  out->is_lane_vote    = (ushort)0;
+
+  out->root = FD_ORD_TXN_ROOT_PENDING;
 
 #if DETAILED_LOGGING
   FD_LOG_NOTICE(( "TXN estimated compute %lu+-%f. Rewards: %lu + %lu", compute_expected, (double)compute_variance, sig_rewards, adtl_rewards ));
@@ -340,29 +740,548 @@ fd_pack_estimate_rewards_and_compute( fd_txn_p_t        * txnp,
 }
 
 /* Can the fee payer afford to pay a transaction with the specified
-   price?  Returns 1 if so, 0 otherwise.  This is just a stub that
-   always returns 1 for now.  In general, this function can't be totally
-   accurate, because the transactions immediately prior to this one can
-   affect the balance of this fee payer, but a simple check here may be
-   helpful for reducing spam. */
+   price?  Returns 1 if so, 0 otherwise.  The fee payer's balance comes
+   from the balance table, less what the transactions already scheduled
+   in this block will charge it.  This can't be totally accurate,
+   because the table is only a periodically refreshed snapshot and other
+   transactions can move lamports in and out of the account, but it
+   catches the common spam pattern of many transactions draining the
+   same payer.  Payers that aren't in the table (or no table) are given
+   the benefit of the doubt. */
 static int
-fd_pack_can_fee_payer_afford( fd_acct_addr_t const * acct_addr,
+fd_pack_can_fee_payer_afford( fd_pack_t            * pack,
+                              fd_acct_addr_t const * acct_addr,
                               ulong                  price /* in lamports */) {
-  (void)acct_addr;
-  (void)price;
+  fd_balance_tbl_t const * balances = pack->balances;
+  ulong                    balance;
+  if( FD_LIKELY( !balances || !fd_balance_tbl_query( balances, acct_addr, &balance ) ) ) return 1;
+
+  fd_pack_addr_use_t * spend = acct_uses_query( pack->payer_spend, *acct_addr, NULL );
+  ulong                spent = spend ? spend->spent : 0UL;
+  return (price<=balance) && (spent<=balance-price);
+}
+
+
+/* fd_pack_ord_acct returns the address of account i (in the order of
+   fd_txn_acct_iter) of the transaction in ord.  i must be the index of
+   an account in ord->acct_cat. */
+static inline fd_acct_addr_t const *
+fd_pack_ord_acct( fd_pack_t const         * pack,
+                  fd_pack_ord_txn_t const * ord,
+                  ulong                     i ) {
+  fd_txn_t const * txn     = TXN(ord->txn);
+  ulong            imm_cnt = (ulong)txn->acct_addr_cnt;
+  if( FD_LIKELY( i<imm_cnt ) ) return fd_txn_get_acct_addrs( txn, ord->txn->payload ) + i;
+  i -= imm_cnt;
+  return pack->alt_pool[ ord->alt_chunk[ i/FD_PACK_ALT_CHUNK_SZ ] ].acct + (i%FD_PACK_ALT_CHUNK_SZ);
+}
+
+/* fd_pack_ord_release releases ord and its chunks of the ALT pool, if
+   any.  Pool elements acquired in fd_pack_insert_{txn,bundle}_init
+   must be released this way rather than directly. */
+static inline void
+fd_pack_ord_release( fd_pack_t         * pack,
+                     fd_pack_ord_txn_t * ord ) {
+  for( ulong c=0UL; c<(ulong)ord->alt_chunk_cnt; c++ ) alt_pool_idx_release( pack->alt_pool, (ulong)ord->alt_chunk[ c ] );
+  trp_pool_ele_release( pack->pool, ord );
+}
+
+/* fd_pack_resolve_alts fills in the acct_cat, alt_chunk_cnt, and
+   alt_chunk fields of ord.  Resolving needs every table the transaction
+   uses to be in the ALT cache with every index it uses in bounds and
+   enough free chunks in the ALT pool; otherwise, none of the accounts
+   from tables are considered.  Returns 0 if the transaction loads an
+   account that it already lists or loads, which the runtime rejects
+   (and which would confuse the lock tracking), and 1 otherwise. */
+static int
+fd_pack_resolve_alts( fd_pack_t         * pack,
+                      fd_pack_ord_txn_t * ord ) {
+  fd_txn_t * txn = TXN(ord->txn);
+  ord->acct_cat      = FD_TXN_ACCT_CAT_ALL;
+  ord->alt_chunk_cnt = (ushort)0;
+  if( FD_LIKELY( !txn->addr_table_lookup_cnt ) ) return 1;
+
+  fd_alt_cache_t const * cache = pack->alt_cache;
+  if( FD_UNLIKELY( !cache ) ) { ord->acct_cat = FD_TXN_ACCT_CAT_IMM; return 1; }
+
+  uchar const *                  payload = ord->txn->payload;
+  fd_txn_acct_addr_lut_t const * tables  = fd_txn_get_address_tables( txn );
+  /* The writable accounts from every table come first, then the
+     readonly ones, each in table order.  They're resolved here and
+     then copied to the ALT pool once it's known they're needed. */
+  fd_acct_addr_t   alt[ FD_TXN_ACCT_ADDR_MAX ];
+  fd_acct_addr_t * w = alt;
+  fd_acct_addr_t * r = alt + txn->addr_table_adtl_writable_cnt;
+  for( ulong i=0UL; i<(ulong)txn->addr_table_lookup_cnt; i++ ) {
+    fd_acct_addr_t const * table = (fd_acct_addr_t const *)(payload + tables[ i ].addr_off);
+    if( FD_UNLIKELY( !fd_alt_cache_resolve( cache, table, payload+tables[ i ].writable_off, tables[ i ].writable_cnt, w ) ||
+                     !fd_alt_cache_resolve( cache, table, payload+tables[ i ].readonly_off, tables[ i ].readonly_cnt, r ) ) ) {
+      ord->acct_cat = FD_TXN_ACCT_CAT_IMM;
+      pack->metrics->alt_unresolved_cnt++;
+      return 1;
+    }
+    w += tables[ i ].writable_cnt;
+    r += tables[ i ].readonly_cnt;
+  }
+
+  fd_acct_addr_t const * imm     = fd_txn_get_acct_addrs( txn, payload );
+  ulong                  imm_cnt = (ulong)txn->acct_addr_cnt;
+  ulong                  alt_cnt = (ulong)txn->addr_table_adtl_cnt;
+  for( ulong i=0UL; i<alt_cnt; i++ ) {
+    for( ulong j=0UL; j<imm_cnt; j++ ) if( FD_UNLIKELY( !memcmp( alt+i, imm+j, FD_TXN_ACCT_ADDR_SZ ) ) ) return 0;
+    for( ulong j=0UL; j<i;       j++ ) if( FD_UNLIKELY( !memcmp( alt+i, alt+j, FD_TXN_ACCT_ADDR_SZ ) ) ) return 0;
+  }
+
+  ulong chunk_cnt = (alt_cnt+FD_PACK_ALT_CHUNK_SZ-1UL)/FD_PACK_ALT_CHUNK_SZ;
+  if( FD_UNLIKELY( alt_pool_free( pack->alt_pool )<chunk_cnt ) ) {
+    ord->acct_cat = FD_TXN_ACCT_CAT_IMM;
+    pack->metrics->alt_unresolved_cnt++;
+    return 1;
+  }
+  for( ulong c=0UL; c<chunk_cnt; c++ ) {
+    ulong idx = alt_pool_idx_acquire( pack->alt_pool );
+    ulong off = c*FD_PACK_ALT_CHUNK_SZ;
+    ord->alt_chunk[ c ] = (uint)idx;
+    fd_memcpy( pack->alt_pool[ idx ].acct, alt+off, fd_ulong_min( alt_cnt-off, FD_PACK_ALT_CHUNK_SZ )*sizeof(fd_acct_addr_t) );
+  }
+  ord->alt_chunk_cnt = (ushort)chunk_cnt;
   return 1;
 }
 
+#if FD_PACK_USE_BITSET
+/* fd_pack_bitset_populate fills in the acct_bit, w_bit_cnt, and
+   r_bit_cnt fields of ord from the transaction's account addresses. */
+static void
+fd_pack_bitset_populate( fd_pack_t const   * pack,
+                         fd_pack_ord_txn_t * ord ) {
+  fd_txn_t * txn = TXN(ord->txn);
+  ushort *   bit = ord->acct_bit;
+
+  fd_txn_acct_iter_t ctrl[1];
+  ulong w_cnt = 0UL;
+  for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & ord->acct_cat, ctrl ); i<fd_txn_acct_iter_end();
+      i=fd_txn_acct_iter_next( i, ctrl ) ) {
+    bit[ w_cnt++ ] = fd_pack_bitset_idx( fd_pack_ord_acct( pack, ord, i ) );
+  }
+  ulong w_pad = fd_ulong_align_up( w_cnt, 8UL );
+  for( ulong j=w_cnt; j<w_pad; j++ ) bit[ j ] = FD_PACK_BITSET_NULL;
+
+  bit += w_pad;
+  ulong r_cnt = 0UL;
+  for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_READONLY & ord->acct_cat, ctrl ); i<fd_txn_acct_iter_end();
+      i=fd_txn_acct_iter_next( i, ctrl ) ) {
+    bit[ r_cnt++ ] = fd_pack_bitset_idx( fd_pack_ord_acct( pack, ord, i ) );
+  }
+  ulong r_pad = fd_ulong_align_up( r_cnt, 8UL );
+  for( ulong j=r_cnt; j<r_pad; j++ ) bit[ j ] = FD_PACK_BITSET_NULL;
+
+  ord->w_bit_cnt = (ushort)w_cnt;
+  ord->r_bit_cnt = (ushort)r_cnt;
+}
+#endif
+
+fd_txn_p_t *
+fd_pack_insert_txn_init( fd_pack_t * pack ) {
+  fd_pack_ord_txn_t * ord = trp_pool_ele_acquire( pack->pool );
+  ord->alt_chunk_cnt = (ushort)0;
+  return ord->txn;
+}
+
+void fd_pack_insert_txn_cancel( fd_pack_t * pack, fd_txn_p_t * txn ) { fd_pack_ord_release( pack, (fd_pack_ord_txn_t*)txn ); }
+
+/* fd_pack_blocked_head returns the head of the list of blocked
+   transactions that ord, which must be blocked, is in. */
+static ulong *
+fd_pack_blocked_head( fd_pack_t               * pack,
+                      fd_pack_ord_txn_t const * ord ) {
+  if( ord->root==FD_ORD_TXN_ROOT_BLOCKED_BLOCK ) return &pack->blocked_block_head;
+  fd_pack_ord_txn_t const * owner = ord;
+  for( ulong j=0UL; j<(ulong)ord->blk_member; j++ ) owner = pack->pool + owner->bundle_next;
+  /* The entry exists as long as anything is blocked on it */
+  return &acct_uses_query( pack->acct_in_use, *fd_pack_ord_acct( pack, owner, owner->blk_acct ), NULL )->blocked_head;
+}
+
+/* fd_pack_lane_{push_head,push_tail,remove} add ord to the head or
+   tail of the vote lane, or remove it from the lane.  They don't change
+   ord->root. */
+static inline void
+fd_pack_lane_push_head( fd_pack_t         * pack,
+                        fd_pack_ord_txn_t * ord ) {
+  fd_pack_ord_txn_t * pool = pack->pool;
+  ulong               idx  = trp_pool_idx( pool, ord );
+  ulong               null = trp_pool_idx_null( pool );
+  ord->blk_prev = null;
+  ord->blk_next = pack->vote_head;
+  if( pack->vote_head!=null ) pool[ pack->vote_head ].blk_prev = idx;
+  else                        pack->vote_tail                  = idx;
+  pack->vote_head = idx;
+}
 
+static inline void
+fd_pack_lane_push_tail( fd_pack_t         * pack,
+                        fd_pack_ord_txn_t * ord ) {
+  fd_pack_ord_txn_t * pool = pack->pool;
+  ulong               idx  = trp_pool_idx( pool, ord );
+  ulong               null = trp_pool_idx_null( pool );
+  ord->blk_prev = pack->vote_tail;
+  ord->blk_next = null;
+  if( pack->vote_tail!=null ) pool[ pack->vote_tail ].blk_next = idx;
+  else                        pack->vote_head                  = idx;
+  pack->vote_tail = idx;
+}
+
+static inline void
+fd_pack_lane_remove( fd_pack_t         * pack,
+                     fd_pack_ord_txn_t * ord ) {
+  fd_pack_ord_txn_t * pool = pack->pool;
+  ulong               null = trp_pool_idx_null( pool );
+  if( ord->blk_prev==null ) pack->vote_head               = ord->blk_next;
+  else                      pool[ ord->blk_prev ].blk_next = ord->blk_next;
+  if( ord->blk_next==null ) pack->vote_tail               = ord->blk_prev;
+  else                      pool[ ord->blk_next ].blk_prev = ord->blk_prev;
+}
 
+/* fd_pack_vote_acct returns the vote account of the simple vote in ord,
+   which is the first account of its only instruction, or NULL if it
+   isn't one pack can key the vote on, i.e. it's loaded from a lookup
+   table or it's the all-zero address. */
+static inline fd_acct_addr_t const *
+fd_pack_vote_acct( fd_pack_ord_txn_t const * ord ) {
+  fd_txn_t const * txn     = TXN(ord->txn);
+  uchar const    * payload = ord->txn->payload;
+  if( FD_UNLIKELY( !txn->instr[ 0 ].acct_cnt ) ) return NULL;
+  ulong idx = (ulong)payload[ txn->instr[ 0 ].acct_off ];
+  if( FD_UNLIKELY( idx>=(ulong)txn->acct_addr_cnt ) ) return NULL;
+  fd_acct_addr_t const * acct = fd_txn_get_acct_addrs( txn, payload ) + idx;
+  if( FD_UNLIKELY( !memcmp( acct->b, null_addr.b, FD_TXN_ACCT_ADDR_SZ ) ) ) return NULL;
+  return acct;
+}
 
+/* fd_pack_vote_slot returns the last slot the simple vote in ord votes
+   for, read from its vote instruction, or 0 if pack doesn't recognize
+   the instruction or it's malformed.  The slot is the last one in the
+   list for Vote and VoteSwitch, the last lockout for UpdateVoteState
+   and UpdateVoteStateSwitch, and the root plus the sum of the lockout
+   offsets for the compact forms and TowerSync.  This only reads the
+   payload, so a malformed vote is still scheduled (and fails) like
+   before. */
+static ulong
+fd_pack_vote_slot( fd_pack_ord_txn_t const * ord ) {
+  fd_txn_t const * txn  = TXN(ord->txn);
+  uchar const    * data = ord->txn->payload + txn->instr[ 0 ].data_off;
+  ulong            sz   = (ulong)txn->instr[ 0 ].data_sz;
+  if( FD_UNLIKELY( sz<12UL ) ) return 0UL;
+  uint  kind = fd_uint_load_4( data );
+  ulong cnt  = fd_ulong_load_8( data+4UL );
+  switch( kind ) {
+    case  2U: /* Vote */
+    case  6U: /* VoteSwitch */
+      if( FD_UNLIKELY( (cnt==0UL) | (cnt>(sz-12UL)/8UL) ) ) return 0UL;
+      return fd_ulong_load_8( data+12UL+8UL*(cnt-1UL) );
+    case  8U: /* UpdateVoteState */
+    case  9U: /* UpdateVoteStateSwitch */
+      if( FD_UNLIKELY( (cnt==0UL) | (cnt>(sz-12UL)/12UL) ) ) return 0UL;
+      return fd_ulong_load_8( data+12UL+12UL*(cnt-1UL) );
+    case 12U: /* CompactUpdateVoteState */
+    case 13U: /* CompactUpdateVoteStateSwitch */
+    case 14U: /* TowerSync */
+    case 15U: /* TowerSyncSwitch */ {
+      /* cnt is the root here, ULONG_MAX if there is none */
+      ulong  slot = fd_ulong_if( cnt==ULONG_MAX, 0UL, cnt );
+      ulong  off  = 12UL;
+      ushort lockout_cnt;
+      ulong  cu16_sz = fd_cu16_dec( data+off, sz-off, &lockout_cnt );
+      if( FD_UNLIKELY( !cu16_sz ) ) return 0UL;
+      off += cu16_sz;
+      for( ulong i=0UL; i<(ulong)lockout_cnt; i++ ) {
+        /* offset is a varint, followed by a one byte confirmation count */
+        ulong offset = 0UL;
+        for( ulong shift=0UL; ; shift+=7UL ) {
+          if( FD_UNLIKELY( (off>=sz) | (shift>63UL) ) ) return 0UL;
+          uchar b = data[ off++ ];
+          offset |= (ulong)(b & 0x7F) << shift;
+          if( !(b & 0x80) ) break;
+        }
+        off++;
+        slot += offset;
+      }
+      if( FD_UNLIKELY( off>sz ) ) return 0UL;
+      return slot;
+    }
+    default:
+      return 0UL;
+  }
+}
+
+/* fd_pack_block moves ord from the pending treap or the vote lane to
+   the list of transactions blocked on root (one of the
+   FD_ORD_TXN_ROOT_BLOCKED_* values).  For FD_ORD_TXN_ROOT_BLOCKED_ACCT,
+   ord->blk_acct must already be set. */
+static void
+fd_pack_block( fd_pack_t         * pack,
+               fd_pack_ord_txn_t * ord,
+               int                 root ) {
+  fd_pack_ord_txn_t * pool = pack->pool;
+  if( ord->root==FD_ORD_TXN_ROOT_PENDING_VOTE ) fd_pack_lane_remove( pack, ord );
+  else                                          treap_ele_remove( pack->pending, ord, pool );
+  ord->root = root;
+
+  ulong * head = fd_pack_blocked_head( pack, ord );
+  ulong   idx  = trp_pool_idx( pool, ord );
+  ord->blk_prev = trp_pool_idx_null( pool );
+  ord->blk_next = *head;
+  if( *head!=trp_pool_idx_null( pool ) ) pool[ *head ].blk_prev = idx;
+  *head = idx;
+  pack->metrics->blocked_cnt++;
+}
+
+/* fd_pack_unblock_all moves every transaction in the blocked list that
+   starts at head back to the pending treap or, for lane votes, to the
+   head of the vote lane, since they're older than what's there. */
+static void
+fd_pack_unblock_all( fd_pack_t * pack,
+                     ulong       head ) {
+  fd_pack_ord_txn_t * pool = pack->pool;
+  while( head!=trp_pool_idx_null( pool ) ) {
+    fd_pack_ord_txn_t * ord = pool + head;
+    head = ord->blk_next;
+    if( ord->is_lane_vote ) { ord->root = FD_ORD_TXN_ROOT_PENDING_VOTE; fd_pack_lane_push_head( pack, ord );         }
+    else                    { ord->root = FD_ORD_TXN_ROOT_PENDING;      treap_ele_insert( pack->pending, ord, pool ); }
+  }
+}
+
+/* fd_pack_fee_bucket returns the index of the histogram bucket that
+   holds fee: fees below 2 each have their own bucket, and each power of
+   two above that is split into 2 equal buckets, so a bucket is at most
+   half as wide as its lower bound.  Fees of 2^32 and up all go in the
+   last bucket.  fd_pack_fee_bucket_lo returns the lower bound of bucket
+   b. */
+static inline ulong
+fd_pack_fee_bucket( ulong fee ) {
+  if( FD_UNLIKELY( fee<2UL ) ) return fee;
+  int msb = fd_ulong_find_msb( fee );
+  return fd_ulong_min( (ulong)msb*2UL + ((fee>>(msb-1)) & 1UL), FD_PACK_FEE_HIST_CNT-1UL );
+}
+
+static inline ulong
+fd_pack_fee_bucket_lo( ulong b ) {
+  if( FD_UNLIKELY( b<2UL ) ) return b;
+  return (2UL | (b & 1UL))<<(b/2UL - 1UL);
+}
+
+/* fd_pack_fee_top_update records that the pending_cnt of e, an account
+   in fee_accts, went up.  If e isn't one of the accounts in fee_top, it
+   takes the place of the least contended one if it's now more
+   contended, or a free place if there is one.  Accounts whose count
+   goes down stay in fee_top until they have no pending writers, so
+   fee_top is only approximately the most contended accounts. */
+static inline void
+fd_pack_fee_top_update( fd_pack_t          * pack,
+                        fd_pack_fee_acct_t * e ) {
+  if( FD_LIKELY( e->top_idx!=UINT_MAX ) ) { pack->fee_top_pending[ e->top_idx ] = e->pending_cnt; return; }
+
+  ulong idx = pack->fee_top_cnt;
+  if( FD_LIKELY( idx==FD_FEE_STATS_ACCT_MAX ) ) {
+    idx = 0UL;
+    for( ulong k=1UL; k<FD_FEE_STATS_ACCT_MAX; k++ ) idx = fd_ulong_if( pack->fee_top_pending[ k ]<pack->fee_top_pending[ idx ], k, idx );
+    if( FD_LIKELY( e->pending_cnt<=pack->fee_top_pending[ idx ] ) ) return;
+    fee_accts_query( pack->fee_accts, pack->fee_top[ idx ], NULL )->top_idx = UINT_MAX;
+  } else {
+    pack->fee_top_cnt++;
+  }
+  pack->fee_top        [ idx ] = e->key;
+  pack->fee_top_pending[ idx ] = e->pending_cnt;
+  e->top_idx = (uint)idx;
+}
+
+/* fd_pack_fee_insert counts head, which must be the first transaction
+   of a bundle or a transaction inserted on its own, and the rest of its
+   bundle in the fee statistics.  It's priced at the priority fee per
+   CU of the whole bundle, i.e. without the signature fees.  If the
+   writable accounts might not fit in fee_accts, only the pending count
+   is updated.  The vote lane is not counted, and nothing is unless
+   pack has somewhere to publish the statistics. */
+static void
+fd_pack_fee_insert( fd_pack_t         * pack,
+                    fd_pack_ord_txn_t * head ) {
+  head->fee_bucket = FD_PACK_FEE_OFF;
+  if( FD_LIKELY( head->is_lane_vote | !pack->fee_stats ) ) return;
+  head->fee_bucket = FD_PACK_FEE_UNTRACKED;
+  pack->fee_pending_cnt += (ulong)head->bundle_cnt;
+
+  fd_pack_ord_txn_t  * pool      = pack->pool;
+  fd_pack_fee_acct_t * fee_accts = pack->fee_accts;
+  ulong                null      = trp_pool_idx_null( pool );
+
+  ulong sig_fee = 0UL;
+  ulong w_cnt   = 0UL;
+  for( ulong m=trp_pool_idx( pool, head ); m!=null; m=pool[ m ].bundle_next ) {
+    fd_txn_t * txn = TXN(pool[ m ].txn);
+    sig_fee += FD_PACK_FEE_PER_SIGNATURE * (ulong)txn->signature_cnt;
+    w_cnt   += fd_txn_account_cnt( txn, FD_TXN_ACCT_CAT_WRITABLE );
+  }
+  /* Keep the table sparse */
+  if( FD_UNLIKELY( fee_accts_key_cnt( fee_accts )+w_cnt>fee_accts_key_max( fee_accts )/2UL ) ) return;
+
+  ulong fee    = fd_ulong_sat_sub( (ulong)head->rewards, sig_fee )*1000000UL / fd_ulong_max( (ulong)head->compute_est, 1UL );
+  ulong bucket = fd_pack_fee_bucket( fee );
+  head->fee_bucket = (ushort)bucket;
+
+  for( ulong m=trp_pool_idx( pool, head ); m!=null; m=pool[ m ].bundle_next ) {
+    fd_pack_ord_txn_t const * cur = pool+m;
+    fd_txn_acct_iter_t ctrl[1];
+    for( ulong i=fd_txn_acct_iter_init( TXN(cur->txn), FD_TXN_ACCT_CAT_WRITABLE & cur->acct_cat, ctrl ); i<fd_txn_acct_iter_end();
+        i=fd_txn_acct_iter_next( i, ctrl ) ) {
+      fd_acct_addr_t acct = *fd_pack_ord_acct( pack, cur, i );
+      if( FD_UNLIKELY( fee_accts_key_inval( acct ) ) ) continue;
+      fd_pack_fee_acct_t * e = fee_accts_query( fee_accts, acct, NULL );
+      if( FD_UNLIKELY( !e ) ) {
+        e = fee_accts_insert( fee_accts, acct );
+        e->pending_cnt = 0U;
+        e->top_idx     = UINT_MAX;
+        memset( e->hist, 0, sizeof(e->hist) );
+      }
+      e->pending_cnt++;
+      e->hist[ bucket ]++;
+      fd_pack_fee_top_update( pack, e );
+    }
+  }
+}
+
+/* fd_pack_fee_remove undoes fd_pack_fee_insert for head and the rest
+   of its bundle. */
+static void
+fd_pack_fee_remove( fd_pack_t               * pack,
+                    fd_pack_ord_txn_t const * head ) {
+  ulong bucket = (ulong)head->fee_bucket;
+  if( FD_LIKELY( bucket==(ulong)FD_PACK_FEE_OFF ) ) return;
+  pack->fee_pending_cnt -= (ulong)head->bundle_cnt;
+  if( FD_UNLIKELY( bucket==(ulong)FD_PACK_FEE_UNTRACKED ) ) return;
+
+  fd_pack_ord_txn_t  * pool      = pack->pool;
+  fd_pack_fee_acct_t * fee_accts = pack->fee_accts;
+  ulong                null      = trp_pool_idx_null( pool );
+
+  for( ulong m=trp_pool_idx( pool, head ); m!=null; m=pool[ m ].bundle_next ) {
+    fd_pack_ord_txn_t const * cur = pool+m;
+    fd_txn_acct_iter_t ctrl[1];
+    for( ulong i=fd_txn_acct_iter_init( TXN(cur->txn), FD_TXN_ACCT_CAT_WRITABLE & cur->acct_cat, ctrl ); i<fd_txn_acct_iter_end();
+        i=fd_txn_acct_iter_next( i, ctrl ) ) {
+      fd_acct_addr_t acct = *fd_pack_ord_acct( pack, cur, i );
+      if( FD_UNLIKELY( fee_accts_key_inval( acct ) ) ) continue;
+      fd_pack_fee_acct_t * e = fee_accts_query( fee_accts, acct, NULL );
+      e->pending_cnt--;
+      e->hist[ bucket ]--;
+      if( FD_LIKELY( e->pending_cnt ) ) {
+        if( e->top_idx!=UINT_MAX ) pack->fee_top_pending[ e->top_idx ] = e->pending_cnt;
+        continue;
+      }
+      if( e->top_idx!=UINT_MAX ) {
+        ulong idx  = (ulong)e->top_idx;
+        ulong last = --pack->fee_top_cnt;
+        if( idx!=last ) {
+          pack->fee_top        [ idx ] = pack->fee_top        [ last ];
+          pack->fee_top_pending[ idx ] = pack->fee_top_pending[ last ];
+          fee_accts_query( fee_accts, pack->fee_top[ idx ], NULL )->top_idx = (uint)idx;
+        }
+      }
+      fee_accts_remove( fee_accts, e );
+    }
+  }
+}
+
+/* fd_pack_release_bundle releases the transaction with pool index idx
+   and the rest of its bundle, if any, back to the pool. */
+static void
+fd_pack_release_bundle( fd_pack_t * pack,
+                        ulong       idx ) {
+  fd_pack_ord_txn_t * pool = pack->pool;
+  while( idx!=trp_pool_idx_null( pool ) ) {
+    ulong next = pool[ idx ].bundle_next;
+    fd_pack_ord_release( pack, pool+idx );
+    idx = next;
+  }
+}
+
+/* fd_pack_pending_remove removes ord, which must be pending (in
+   pending, the vote lane, or blocked), from pack and releases it and
+   the rest of its bundle back to the pool. */
+static void
+fd_pack_pending_remove( fd_pack_t         * pack,
+                        fd_pack_ord_txn_t * ord ) {
+  fd_pack_ord_txn_t      * pool = pack->pool;
+  fd_ed25519_sig_t const * sig  = fd_txn_get_signatures( TXN( ord->txn ), ord->txn->payload );
+  sig2txn_remove( pack->signature_map, sig2txn_query( pack->signature_map, sig, NULL ) );
+
+  if( FD_LIKELY( ord->root==FD_ORD_TXN_ROOT_PENDING ) ) {
+    treap_ele_remove( pack->pending, ord, pool );
+  } else if( ord->root==FD_ORD_TXN_ROOT_PENDING_VOTE ) {
+    fd_pack_lane_remove( pack, ord );
+  } else {
+    ulong null = trp_pool_idx_null( pool );
+    if( ord->blk_prev==null ) *fd_pack_blocked_head( pack, ord ) = ord->blk_next;
+    else                      pool[ ord->blk_prev ].blk_next     = ord->blk_next;
+    if( ord->blk_next!=null ) pool[ ord->blk_next ].blk_prev     = ord->blk_prev;
+  }
+  if( ord->is_lane_vote ) vote_accts_remove( pack->vote_accts, vote_accts_query( pack->vote_accts, *fd_pack_vote_acct( ord ), NULL ) );
+  fd_pack_fee_remove( pack, ord );
+  expq_ele_remove( pack->expiring, ord, pool );
+  pack->pending_txn_cnt -= (ulong)ord->bundle_cnt;
+  fd_pack_release_bundle( pack, trp_pool_idx( pool, ord ) );
+}
+
+/* fd_pack_make_room ensures there's room for cnt more pending
+   transactions, evicting pending transactions if necessary.  An
+   incoming lane vote evicts the oldest votes in the vote lane, which
+   are the most likely to be stale.  Otherwise, or if the vote lane is
+   empty, the lowest priority transactions in the pending treap go, or
+   the oldest votes if that's empty, but only if ord is better than each
+   of them.  Otherwise, nothing is evicted.  Finding the worst is a walk
+   down the left spine of the treap, so this is O(cnt log pack_depth) in
+   expectation.  Returns 1 if there's room now and 0 if not.  ord must
+   not be pending yet, and ord->root must be set. */
+static int
+fd_pack_make_room( fd_pack_t               * pack,
+                   fd_pack_ord_txn_t const * ord,
+                   ulong                     cnt ) {
+  if( FD_LIKELY( pack->pending_txn_cnt+cnt<=pack->pack_depth ) ) return 1;
+  ulong need = pack->pending_txn_cnt+cnt-pack->pack_depth;
+
+  fd_pack_ord_txn_t * pool      = pack->pool;
+  ulong               null      = trp_pool_idx_null( pool );
+  int                 is_vote   = ord->root==FD_ORD_TXN_ROOT_PENDING_VOTE;
+  int                 from_lane = (pack->vote_head!=null) & (is_vote | !treap_ele_cnt( pack->pending ));
+
+  /* Check first so that nothing is evicted if ord loses.  If every
+     pending transaction is blocked, there's nothing cheap to compare
+     against, and the blocked ones will be schedulable soon. */
+  ulong freed = 0UL;
+  if( from_lane ) {
+    for( ulong i=pack->vote_head; (freed<need) & (i!=null); i=pool[ i ].blk_next ) {
+      if( !is_vote && !COMPARE_WORSE( pool+i, ord ) ) break;
+      freed++;
+    }
+  } else {
+    for( treap_fwd_iter_t it=treap_fwd_iter_init( pack->pending, pool ); (freed<need) & !treap_fwd_iter_done( it ); it=treap_fwd_iter_next( it, pool ) ) {
+      fd_pack_ord_txn_t * worst = treap_fwd_iter_ele( it, pool );
+      if( !COMPARE_WORSE( worst, ord ) ) break;
+      freed += (ulong)worst->bundle_cnt;
+    }
+  }
+  if( freed<need ) return 0;
 
-fd_txn_p_t * fd_pack_insert_txn_init(   fd_pack_t * pack                   ) { return trp_pool_ele_acquire( pack->pool )->txn; }
-void         fd_pack_insert_txn_cancel( fd_pack_t * pack, fd_txn_p_t * txn ) { trp_pool_ele_release( pack->pool, (fd_pack_ord_txn_t*)txn ); }
+  while( pack->pending_txn_cnt+cnt>pack->pack_depth ) {
+    pack->metrics->evicted_cnt++;
+    if( from_lane ) fd_pack_pending_remove( pack, pool+pack->vote_head );
+    else            fd_pack_pending_remove( pack, treap_fwd_iter_ele( treap_fwd_iter_init( pack->pending, pool ), pool ) );
+  }
+  return 1;
+}
 
 void
 fd_pack_insert_txn_fini( fd_pack_t  * pack,
-                         fd_txn_p_t * txnp ) {
+                         fd_txn_p_t * txnp,
+                         ulong        expires_at ) {
 
   fd_pack_ord_txn_t * ord = (fd_pack_ord_txn_t *)txnp;
 
@@ -371,184 +1290,549 @@ fd_pack_insert_txn_fini( fd_pack_t  * pack,
 
   fd_acct_addr_t const * accts = fd_txn_get_acct_addrs( txn, payload );
 
-  if( FD_UNLIKELY( !fd_pack_estimate_rewards_and_compute( txnp, ord ) ) ) {
-    trp_pool_ele_release( pack->pool, ord );
+  if( FD_UNLIKELY( !fd_pack_estimate_rewards_and_compute( pack, txnp, ord ) ) ) {
+    fd_pack_ord_release( pack, ord );
     return;
   }
   /* Throw out transactions ... */
   /*           ... that are unfunded */
-  if( FD_UNLIKELY( !fd_pack_can_fee_payer_afford( accts, ord->rewards ) ) ) { trp_pool_ele_release( pack->pool, ord ); return; }
+  if( FD_UNLIKELY( !fd_pack_can_fee_payer_afford( pack, accts, ord->rewards ) ) ) {
+    pack->metrics->unaffordable_cnt++;
+    fd_pack_ord_release( pack, ord );
+    return;
+  }
   /*           ... that are so big they'll never run */
-  if( FD_UNLIKELY( ord->compute_est >= FD_PACK_MAX_COST_PER_BLOCK       ) ) { trp_pool_ele_release( pack->pool, ord ); return; }
-
-  /* TODO: Add recent blockhash based expiry here */
-
-  if( FD_UNLIKELY( pack->pending_txn_cnt == pack->pack_depth ) ) {
-    /* If the tree is full, we'll double check to make sure this is
-       better than the worst element in the tree before inserting.  If
-       the new transaction is better than that one, we'll delete it and
-       insert the new transaction. Otherwise, we'll throw away this
-       transaction. */
-    /* TODO: Increment a counter to mark this is happening */
-    fd_pack_ord_txn_t * worst = treap_fwd_iter_ele( treap_fwd_iter_init( pack->pending, pack->pool ), pack->pool );
-    if( FD_UNLIKELY( !worst ) ) {
-      /* We have nothing to sacrifice because they're all in other
-         trees. */
-      trp_pool_ele_release( pack->pool, ord );
-      return;
-    }
-    else if( !COMPARE_WORSE( worst, ord ) ) {
-      /* What we have in the tree is better than this transaction, so just
-         pretend this transaction never happened */
-      trp_pool_ele_release( pack->pool, ord );
-      return;
-    } else {
-      /* Remove the worst from the tree */
-      fd_ed25519_sig_t const * worst_sig = fd_txn_get_signatures( TXN( worst->txn ), worst->txn->payload );
-      sig2txn_remove( pack->signature_map, sig2txn_query( pack->signature_map, worst_sig, NULL ) );
-
-      treap_ele_remove    ( pack->pending, worst, pack->pool );
-      trp_pool_ele_release( pack->pool,    worst             );
-      pack->pending_txn_cnt--;
+  if( FD_UNLIKELY( ord->compute_est >= FD_PACK_MAX_COST_PER_BLOCK       ) ) { fd_pack_ord_release( pack, ord ); return; }
+  /*           ... that load an account twice */
+  if( FD_UNLIKELY( !fd_pack_resolve_alts( pack, ord )                   ) ) { fd_pack_ord_release( pack, ord ); return; }
+
+  ord->expires_at = expires_at;
+
+  /* A vote for the same or a later slot than a pending vote for the
+     same vote account supersedes it, so the pending one won't be needed
+     anymore.  A vote for an earlier slot (e.g. one that was replayed or
+     arrived late) is the one that isn't needed.  If either slot is
+     unknown, the most recently inserted vote wins. */
+  fd_acct_addr_t const * vote_acct = txnp->is_simple_vote ? fd_pack_vote_acct( ord ) : NULL;
+  ulong                  vote_slot = 0UL;
+  if( FD_LIKELY( vote_acct ) ) {
+    ord->is_lane_vote = (ushort)1;
+    ord->root         = FD_ORD_TXN_ROOT_PENDING_VOTE;
+    vote_slot         = fd_pack_vote_slot( ord );
+    fd_pack_vote_acct_t * prev = vote_accts_query( pack->vote_accts, *vote_acct, NULL );
+    if( FD_UNLIKELY( prev ) ) {
+      if( FD_UNLIKELY( vote_slot && (vote_slot<prev->slot) ) ) {
+        pack->metrics->vote_outdated_cnt++;
+        fd_pack_ord_release( pack, ord );
+        return;
+      }
+      pack->metrics->vote_replaced_cnt++;
+      fd_pack_pending_remove( pack, pack->pool+prev->txn_idx );
     }
   }
 
+  if( FD_UNLIKELY( !fd_pack_make_room( pack, ord, 1UL ) ) ) {
+    /* What we have in the tree is better than this transaction, so just
+       pretend this transaction never happened */
+    pack->metrics->insert_rejected_full_cnt++;
+    fd_pack_ord_release( pack, ord );
+    return;
+  }
+
+#if FD_PACK_USE_BITSET
+  fd_pack_bitset_populate( pack, ord );
+#endif
+
   pack->pending_txn_cnt++;
 
   sig2txn_insert( pack->signature_map, fd_txn_get_signatures( txn, payload ) );
 
-  if( FD_LIKELY( ord->root == FD_ORD_TXN_ROOT_PENDING_VOTE ) )
-    treap_ele_insert( pack->pending_votes, ord, pack->pool );
-  else
-    treap_ele_insert( pack->pending,       ord, pack->pool );
+  if( FD_LIKELY( ord->is_lane_vote ) ) {
+    fd_pack_vote_acct_t * cur = vote_accts_insert( pack->vote_accts, *vote_acct );
+    cur->txn_idx = trp_pool_idx( pack->pool, ord );
+    cur->slot    = vote_slot;
+    fd_pack_lane_push_tail( pack, ord );
+  } else {
+    treap_ele_insert( pack->pending, ord, pack->pool );
+  }
+  expq_ele_insert( pack->expiring, ord, pack->pool );
+  fd_pack_fee_insert( pack, ord );
+}
+
+fd_txn_p_t * const *
+fd_pack_insert_bundle_init( fd_pack_t   * pack,
+                            fd_txn_p_t ** bundle,
+                            ulong         txn_cnt ) {
+  if( FD_UNLIKELY( (txn_cnt==0UL) | (txn_cnt>FD_PACK_MAX_TXN_PER_BUNDLE) ) ) return NULL;
+  for( ulong i=0UL; i<txn_cnt; i++ ) {
+    fd_pack_ord_txn_t * ord = trp_pool_ele_acquire( pack->pool );
+    ord->alt_chunk_cnt = (ushort)0;
+    bundle[ i ] = ord->txn;
+  }
+  return bundle;
+}
+
+void
+fd_pack_insert_bundle_cancel( fd_pack_t          * pack,
+                              fd_txn_p_t * const * bundle,
+                              ulong                txn_cnt ) {
+  for( ulong i=0UL; i<txn_cnt; i++ ) fd_pack_ord_release( pack, (fd_pack_ord_txn_t *)bundle[ i ] );
+}
+
+/* fd_pack_txn_pair_conflicts returns 1 if the transactions in a and b
+   can't be in the same microblock because one of them writes an
+   account that the other reads or writes, and 0 otherwise.  Both must
+   have their accounts resolved already. */
+static int
+fd_pack_txn_pair_conflicts( fd_pack_t const         * pack,
+                            fd_pack_ord_txn_t const * a,
+                            fd_pack_ord_txn_t const * b ) {
+  fd_txn_t * a_txn = TXN(a->txn);
+  fd_txn_t * b_txn = TXN(b->txn);
+
+  fd_txn_acct_iter_t a_ctrl[1];
+  fd_txn_acct_iter_t b_ctrl[1];
+  for( ulong i=fd_txn_acct_iter_init( a_txn, FD_TXN_ACCT_CAT_WRITABLE & a->acct_cat, a_ctrl ); i<fd_txn_acct_iter_end();
+      i=fd_txn_acct_iter_next( i, a_ctrl ) ) {
+    for( ulong j=fd_txn_acct_iter_init( b_txn, b->acct_cat, b_ctrl ); j<fd_txn_acct_iter_end();
+        j=fd_txn_acct_iter_next( j, b_ctrl ) ) {
+      if( !memcmp( fd_pack_ord_acct( pack, a, i ), fd_pack_ord_acct( pack, b, j ), FD_TXN_ACCT_ADDR_SZ ) ) return 1;
+    }
+  }
+  for( ulong i=fd_txn_acct_iter_init( a_txn, FD_TXN_ACCT_CAT_READONLY & a->acct_cat, a_ctrl ); i<fd_txn_acct_iter_end();
+      i=fd_txn_acct_iter_next( i, a_ctrl ) ) {
+    for( ulong j=fd_txn_acct_iter_init( b_txn, FD_TXN_ACCT_CAT_WRITABLE & b->acct_cat, b_ctrl ); j<fd_txn_acct_iter_end();
+        j=fd_txn_acct_iter_next( j, b_ctrl ) ) {
+      if( !memcmp( fd_pack_ord_acct( pack, a, i ), fd_pack_ord_acct( pack, b, j ), FD_TXN_ACCT_ADDR_SZ ) ) return 1;
+    }
+  }
+  return 0;
+}
+
+void
+fd_pack_insert_bundle_fini( fd_pack_t          * pack,
+                            fd_txn_p_t * const * bundle,
+                            ulong                txn_cnt,
+                            ulong                expires_at ) {
+  fd_pack_ord_txn_t * pool = pack->pool;
+  fd_pack_ord_txn_t * head = (fd_pack_ord_txn_t *)bundle[ 0 ];
+
+  /* Throw out bundles that can never be scheduled */
+  if( FD_UNLIKELY( txn_cnt>pack->max_txn_per_microblock ) ) goto reject;
+
+  ulong rewards = 0UL;
+  ulong compute = 0UL;
+  for( ulong i=0UL; i<txn_cnt; i++ ) {
+    fd_pack_ord_txn_t * ord = (fd_pack_ord_txn_t *)bundle[ i ];
+    fd_acct_addr_t const * accts = fd_txn_get_acct_addrs( TXN(bundle[ i ]), bundle[ i ]->payload );
+    /* All or nothing: if any transaction would be thrown out alone, so
+       is the bundle. */
+    if( FD_UNLIKELY( !fd_pack_estimate_rewards_and_compute( pack, bundle[ i ], ord ) ) ) goto reject;
+    /* The fee payer has to afford this transaction on top of the
+       earlier ones in the bundle it pays for */
+    ulong price = ord->rewards;
+    for( ulong j=0UL; j<i; j++ ) {
+      fd_acct_addr_t const * prev_accts = fd_txn_get_acct_addrs( TXN(bundle[ j ]), bundle[ j ]->payload );
+      if( !memcmp( accts, prev_accts, FD_TXN_ACCT_ADDR_SZ ) ) price += ((fd_pack_ord_txn_t *)bundle[ j ])->rewards;
+    }
+    if( FD_UNLIKELY( !fd_pack_can_fee_payer_afford( pack, accts, price )             ) ) { pack->metrics->unaffordable_cnt++; goto reject; }
+    if( FD_UNLIKELY( !fd_pack_resolve_alts( pack, ord )                              ) ) goto reject;
+    for( ulong j=0UL; j<i; j++ ) if( FD_UNLIKELY( fd_pack_txn_pair_conflicts( pack, (fd_pack_ord_txn_t *)bundle[ j ], ord ) ) ) goto reject;
+    rewards += ord->rewards;
+    compute += ord->compute_est;
+  }
+  if( FD_UNLIKELY( compute >= FD_PACK_MAX_COST_PER_BLOCK ) ) goto reject;
+
+  /* Bundles are scheduled with the non-votes even if they contain
+     votes. */
+  head->rewards     = (uint)fd_ulong_min( rewards, (ulong)UINT_MAX );
+  head->compute_est = (uint)compute;
+  head->bundle_cnt  = (ushort)txn_cnt;
+  head->root        = FD_ORD_TXN_ROOT_PENDING;
+  head->expires_at  = expires_at;
+
+  if( FD_UNLIKELY( !fd_pack_make_room( pack, head, txn_cnt ) ) ) {
+    pack->metrics->insert_rejected_full_cnt++;
+    goto reject;
+  }
+
+  for( ulong i=0UL; i<txn_cnt; i++ ) {
+    fd_pack_ord_txn_t * ord = (fd_pack_ord_txn_t *)bundle[ i ];
+    if( i+1UL<txn_cnt ) ord->bundle_next = trp_pool_idx( pool, (fd_pack_ord_txn_t *)bundle[ i+1UL ] );
+#if FD_PACK_USE_BITSET
+    fd_pack_bitset_populate( pack, ord );
+#endif
+  }
+
+  pack->pending_txn_cnt += txn_cnt;
+
+  /* The bundle is known by the signature of its first transaction */
+  sig2txn_insert( pack->signature_map, fd_txn_get_signatures( TXN(bundle[ 0 ]), bundle[ 0 ]->payload ) );
+  treap_ele_insert( pack->pending,  head, pool );
+  expq_ele_insert ( pack->expiring, head, pool );
+  fd_pack_fee_insert( pack, head );
+  return;
+
+reject:
+  fd_pack_insert_bundle_cancel( pack, bundle, txn_cnt );
+}
+
+/* fd_pack_txn_conflicts returns FD_ORD_TXN_ROOT_BLOCKED_ACCT if the
+   transaction in cur can't be scheduled at the moment because it writes
+   an account that an outstanding microblock reads or writes, or reads
+   an account that an outstanding microblock writes.  In that case,
+   cur->blk_acct is set to the index of the account.  Returns
+   FD_ORD_TXN_ROOT_BLOCKED_BLOCK if it would push the cost of an account
+   it writes past the per-block limit.  Returns 0 otherwise. */
+static inline int
+fd_pack_txn_conflicts( fd_pack_t         * pack,
+                       fd_pack_ord_txn_t * cur ) {
+  fd_pack_addr_use_t   * acct_in_use  = pack->acct_in_use;
+  fd_pack_addr_use_t   * writer_costs = pack->writer_costs;
+  fd_txn_t             * txn          = TXN(cur->txn);
+
+  fd_txn_acct_iter_t ctrl[1];
+  /* Check conflicts between this transactions's writable accounts and
+     current readers or writers */
+  for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & cur->acct_cat, ctrl ); i<fd_txn_acct_iter_end();
+      i=fd_txn_acct_iter_next( i, ctrl ) ) {
+    fd_acct_addr_t const * acct = fd_pack_ord_acct( pack, cur, i );
+
+    fd_pack_addr_use_t * in_wcost_table = acct_uses_query( writer_costs, *acct, NULL );
+    if( in_wcost_table && in_wcost_table->total_cost+cur->txn_compute_est > pack->write_cost_limit ) {
+      /* Can't be scheduled until the next block */
+      return FD_ORD_TXN_ROOT_BLOCKED_BLOCK;
+    }
+
+    if( acct_uses_query( acct_in_use, *acct, NULL ) ) {
+#if DETAILED_LOGGING
+      FD_LOG_NOTICE(( "Stalling transaction because it writes %i which an outstanding microblock reads or writes", (int)acct->b[0] ));
+#endif
+      cur->blk_acct = (ushort)i;
+      return FD_ORD_TXN_ROOT_BLOCKED_ACCT;
+    }
+  }
+
+  /* Check conflicts between this transactions's readonly accounts and
+     current writers */
+  for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_READONLY & cur->acct_cat, ctrl ); i<fd_txn_acct_iter_end();
+      i=fd_txn_acct_iter_next( i, ctrl ) ) {
+    fd_acct_addr_t const * acct = fd_pack_ord_acct( pack, cur, i );
+
+    fd_pack_addr_use_t * in_use = acct_uses_query( acct_in_use, *acct, NULL );
+    if( in_use && (in_use->in_use_by & FD_PACK_IN_USE_WRITABLE) ) {
+#if DETAILED_LOGGING
+      FD_LOG_NOTICE(( "Stalling transaction because it reads %i which an outstanding microblock writes", (int)acct->b[0] ));
+#endif
+      cur->blk_acct = (ushort)i;
+      return FD_ORD_TXN_ROOT_BLOCKED_ACCT;
+    }
+  }
+  return 0;
+}
+
+/* fd_pack_bundle_conflicts is fd_pack_txn_conflicts for every
+   transaction of the bundle that starts with head (which may be a lone
+   transaction).  The bundle is checked against the union of the
+   accounts of its transactions, which can't conflict with each other.
+   If it returns FD_ORD_TXN_ROOT_BLOCKED_ACCT, head->blk_member is set
+   to the transaction with the conflicting account. */
+static inline int
+fd_pack_bundle_conflicts( fd_pack_t         * pack,
+                          fd_pack_ord_txn_t * head ) {
+  fd_pack_ord_txn_t * pool = pack->pool;
+  ulong               m    = trp_pool_idx( pool, head );
+  for( ulong j=0UL; j<(ulong)head->bundle_cnt; j++ ) {
+    int blocked_on = fd_pack_txn_conflicts( pack, pool+m );
+    if( blocked_on ) { head->blk_member = (ushort)j; return blocked_on; }
+    m = pool[ m ].bundle_next;
+  }
+  return 0;
+}
+
+/* fd_pack_bundle_affordable returns 1 if the fee payer of every
+   transaction of the bundle that starts with head (which may be a lone
+   transaction) can afford it, together with the earlier transactions
+   of the bundle it pays for, given what's scheduled so far in this
+   block, and 0 otherwise. */
+static inline int
+fd_pack_bundle_affordable( fd_pack_t               * pack,
+                           fd_pack_ord_txn_t const * head ) {
+  fd_pack_ord_txn_t * pool = pack->pool;
+  ulong               m0   = trp_pool_idx( pool, head );
+  for( ulong m=m0; m!=trp_pool_idx_null( pool ); m=pool[ m ].bundle_next ) {
+    fd_txn_p_t     const * txnp  = pool[ m ].txn;
+    fd_acct_addr_t const * payer = fd_txn_get_acct_addrs( TXN(txnp), txnp->payload );
+    ulong                  price = pool[ m ].txn_rewards;
+    for( ulong k=m0; k!=m; k=pool[ k ].bundle_next ) {
+      fd_txn_p_t const * prev = pool[ k ].txn;
+      if( !memcmp( payer, fd_txn_get_acct_addrs( TXN(prev), prev->payload ), FD_TXN_ACCT_ADDR_SZ ) ) price += pool[ k ].txn_rewards;
+    }
+    if( FD_UNLIKELY( !fd_pack_can_fee_payer_afford( pack, payer, price ) ) ) return 0;
+  }
+  return 1;
+}
+
+#if FD_PACK_USE_BITSET
+/* fd_pack_bitset_maybe_conflicts returns 0 if the bitsets prove that
+   the transaction in cur doesn't conflict and 1 if it might. */
+static inline int
+fd_pack_bitset_maybe_conflicts( fd_pack_t               * pack,
+                                fd_pack_ord_txn_t const * cur ) {
+  ulong          w_pad = fd_ulong_align_up( (ulong)cur->w_bit_cnt, 8UL );
+  ushort const * w_bit = cur->acct_bit;
+  ushort const * r_bit = cur->acct_bit + w_pad;
+  return (cur->txn_compute_est > pack->write_cost_limit/2UL)                                              |
+         fd_pack_bitset_test_any( pack->rw_in_use,   w_bit, w_pad                                       ) |
+         fd_pack_bitset_test_any( pack->w_saturated, w_bit, w_pad                                       ) |
+         fd_pack_bitset_test_any( pack->w_in_use,    r_bit, fd_ulong_align_up( (ulong)cur->r_bit_cnt, 8UL ) );
+}
+#endif
+
+/* fd_pack_ord_rec_sz returns the size of the microblock record of the
+   transaction in cur. */
+static inline ulong
+fd_pack_ord_rec_sz( fd_pack_ord_txn_t const * cur ) {
+  fd_txn_t const * txn = TXN(cur->txn);
+  return fd_pack_microblock_txn_sz( cur->txn->payload_sz, fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
+}
+
+/* fd_pack_include writes the record of the transaction in cur to out,
+   which must have room for it, and takes the locks and per-account
+   cost it needs for bank_tile.  Returns the size of the record. */
+static inline ulong
+fd_pack_include( fd_pack_t         * pack,
+                 fd_pack_ord_txn_t * cur,
+                 ulong               bank_tile,
+                 uchar             * out ) {
+  fd_pack_addr_use_t * acct_in_use  = pack->acct_in_use;
+  fd_pack_addr_use_t * writer_costs = pack->writer_costs;
+
+  ulong bank_bit = 1UL<<bank_tile;
+  fd_acct_addr_t * use_by_bank     = pack->use_by_bank    [ bank_tile ];
+  ulong            use_by_bank_cnt = pack->use_by_bank_cnt[ bank_tile ];
+
+  fd_txn_t * txn = TXN(cur->txn);
+
+  /* Write just the used bytes of the transaction */
+  ulong txn_sz  = fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt );
+  ulong rec_sz  = fd_pack_microblock_txn_sz( cur->txn->payload_sz, txn_sz );
+  ulong txn_off = fd_ulong_align_up( sizeof(fd_pack_microblock_txn_t)+cur->txn->payload_sz, alignof(fd_txn_t) );
+  fd_pack_microblock_txn_t * rec = (fd_pack_microblock_txn_t *)out;
+  rec->rec_sz     = (ushort)rec_sz;
+  rec->payload_sz = (ushort)cur->txn->payload_sz;
+  rec->txn_off    = (ushort)txn_off;
+  rec->flags      = fd_ushort_if( cur->txn->is_simple_vote, FD_PACK_MICROBLOCK_TXN_FLAG_SIMPLE_VOTE, (ushort)0 );
+  rec->meta       = cur->txn->meta;
+  fd_memcpy( rec+1,         cur->txn->payload, cur->txn->payload_sz );
+  fd_memcpy( out + txn_off, txn,               txn_sz               );
+
+  fd_txn_acct_iter_t ctrl[1];
+  for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & cur->acct_cat, ctrl ); i<fd_txn_acct_iter_end();
+      i=fd_txn_acct_iter_next( i, ctrl ) ) {
+    fd_acct_addr_t acct_addr = *fd_pack_ord_acct( pack, cur, i );
+
+    fd_pack_addr_use_t * in_wcost_table = acct_uses_query( writer_costs, acct_addr, NULL );
+    if( !in_wcost_table ) { in_wcost_table = acct_uses_insert( writer_costs, acct_addr );   in_wcost_table->total_cost = 0UL; }
+    in_wcost_table->total_cost += cur->txn_compute_est;
+#if FD_PACK_USE_BITSET
+    if( FD_UNLIKELY( in_wcost_table->total_cost > pack->write_cost_limit/2UL ) )
+      fd_pack_bitset_insert( pack->w_saturated, fd_pack_bitset_idx( &acct_addr ) );
+#endif
+
+    /* We checked above that no one else is using it.  A transaction
+       can't list the same account twice, and the transactions of a
+       bundle don't conflict, so this is a fresh entry. */
+    fd_pack_addr_use_t * in_use = acct_uses_insert( acct_in_use, acct_addr );
+    in_use->in_use_by    = bank_bit | FD_PACK_IN_USE_WRITABLE;
+    in_use->blocked_head = trp_pool_idx_null( pack->pool );
+    use_by_bank[ use_by_bank_cnt++ ] = acct_addr;
+  }
+  for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_READONLY & cur->acct_cat, ctrl ); i<fd_txn_acct_iter_end();
+      i=fd_txn_acct_iter_next( i, ctrl ) ) {
+    fd_acct_addr_t acct_addr = *fd_pack_ord_acct( pack, cur, i );
+
+    fd_pack_addr_use_t * in_use = acct_uses_query( acct_in_use, acct_addr, NULL );
+    if( !in_use ) { in_use = acct_uses_insert( acct_in_use, acct_addr ); in_use->in_use_by = 0UL; in_use->blocked_head = trp_pool_idx_null( pack->pool ); }
+    if( !(in_use->in_use_by & bank_bit) ) use_by_bank[ use_by_bank_cnt++ ] = acct_addr;
+    in_use->in_use_by |= bank_bit;
+  }
+
+#if FD_PACK_USE_BITSET
+  ulong * bank_w_in_use  = pack->bank_w_in_use  + bank_tile*FD_PACK_BITSET_WORD_CNT;
+  ulong * bank_rw_in_use = pack->bank_rw_in_use + bank_tile*FD_PACK_BITSET_WORD_CNT;
+  ushort const * w_bit = cur->acct_bit;
+  ushort const * r_bit = cur->acct_bit + fd_ulong_align_up( (ulong)cur->w_bit_cnt, 8UL );
+  for( ulong i=0UL; i<(ulong)cur->w_bit_cnt; i++ ) {
+    fd_pack_bitset_insert( bank_w_in_use,  w_bit[ i ] ); fd_pack_bitset_insert( pack->w_in_use,  w_bit[ i ] );
+    fd_pack_bitset_insert( bank_rw_in_use, w_bit[ i ] ); fd_pack_bitset_insert( pack->rw_in_use, w_bit[ i ] );
+  }
+  for( ulong i=0UL; i<(ulong)cur->r_bit_cnt; i++ ) {
+    fd_pack_bitset_insert( bank_rw_in_use, r_bit[ i ] ); fd_pack_bitset_insert( pack->rw_in_use, r_bit[ i ] );
+  }
+#endif
+
+  if( FD_UNLIKELY( pack->balances ) ) {
+    fd_acct_addr_t       payer = *fd_pack_ord_acct( pack, cur, 0UL );
+    fd_pack_addr_use_t * spend = acct_uses_query( pack->payer_spend, payer, NULL );
+    if( !spend ) { spend = acct_uses_insert( pack->payer_spend, payer ); spend->spent = 0UL; }
+    spend->spent += cur->txn_rewards;
+  }
+
+  pack->use_by_bank_cnt[ bank_tile ] = use_by_bank_cnt;
+  return rec_sz;
 }
 
 typedef struct {
   ulong cus_scheduled;
   ulong txns_scheduled;
+  ulong bytes_written;
 } sched_return_t;
 
 static inline sched_return_t
 fd_pack_schedule_next_microblock_impl( fd_pack_t  * pack,
-                                       treap_t    * sched_from,
-                                       int          move_delayed,
                                        ulong        cu_limit,
                                        ulong        txn_limit,
-                                       fd_txn_p_t * out ) {
+                                       ulong        bank_tile,
+                                       uchar      * out,
+                                       ulong        out_rem ) {
 
-  ulong                gap          = pack->gap;
   fd_pack_ord_txn_t  * pool         = pack->pool;
-  fd_pack_addr_use_t * read_in_use  = pack->read_in_use;
-  fd_pack_addr_use_t * write_in_use = pack->write_in_use;
-  fd_pack_addr_use_t * writer_costs = pack->writer_costs;
+  ulong                null         = trp_pool_idx_null( pool );
 
   ulong txns_scheduled = 0UL;
   ulong cus_scheduled  = 0UL;
+  ulong bytes_written  = 0UL;
+
+  treap_t * sched_from = pack->pending;
 
   treap_rev_iter_t prev;
   for( treap_rev_iter_t _cur=treap_rev_iter_init( sched_from, pool );
       (cu_limit>=FD_PACK_MIN_TXN_COST) & (txn_limit>0) & !treap_rev_iter_done( _cur ); _cur=prev ) {
     prev = treap_rev_iter_next( _cur, pool );
 
-    fd_pack_ord_txn_t * cur = treap_rev_iter_ele( _cur, pool );
-
-    fd_txn_t * txn = TXN(cur->txn);
-    fd_acct_addr_t const * acct = fd_txn_get_acct_addrs( txn, cur->txn->payload );
+    /* cur is a lone transaction or the first of a bundle, in which case
+       the whole bundle is scheduled or none of it is. */
+    fd_pack_ord_txn_t * cur        = treap_rev_iter_ele( _cur, pool );
+    ulong               bundle_cnt = (ulong)cur->bundle_cnt;
 
-    ulong delay_until = pack->microblock_cnt;
-
-    if( cur->compute_est>cu_limit ) {
+    if( (cur->compute_est>cu_limit) | (bundle_cnt>txn_limit) ) {
       /* Too big to be scheduled at the moment, but might be okay for
-         the next microblock, so we don't want to delay it. */
+         the next microblock. */
       continue;
     }
 
-    fd_txn_acct_iter_t ctrl[1];
-    /* Check conflicts between this transactions's writable accounts and
-       current readers */
-    for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
-        i=fd_txn_acct_iter_next( i, ctrl ) ) {
+    ulong rec_sz = 0UL;
+    for( ulong m=trp_pool_idx( pool, cur ); m!=null; m=pool[ m ].bundle_next ) rec_sz += fd_pack_ord_rec_sz( pool+m );
+    if( FD_UNLIKELY( rec_sz>out_rem ) ) {
+      /* Doesn't fit in what's left of the output, same as above. */
+      continue;
+    }
 
-      fd_pack_addr_use_t * in_wcost_table = acct_uses_query( writer_costs, acct[i], NULL );
-      if( in_wcost_table && in_wcost_table->total_cost+cur->compute_est > FD_PACK_MAX_WRITE_COST_PER_ACCT ) {
-        /* Can't be scheduled until the next block */
-        delay_until = ULONG_MAX;
-        break;
-      }
+    pack->metrics->candidates_evaluated++;
 
-      fd_pack_addr_use_t * in_r_table = acct_uses_query( read_in_use, acct[i], NULL );
-      if( in_r_table ) { delay_until = fd_ulong_max( delay_until, in_r_table->in_use_until );
-#if DETAILED_LOGGING
-        FD_LOG_NOTICE(( "Stalling transaction until >= %lu because it writes %i which another transaction taken reads", delay_until, (int)acct[i].b[0] ));
-#endif
-      }
+    if( FD_UNLIKELY( pack->balances && !fd_pack_bundle_affordable( pack, cur ) ) ) {
+      /* The fee payer has spent too much on what's already in this
+         block.  It's unlikely to get richer before this expires. */
+      pack->metrics->unaffordable_cnt += bundle_cnt;
+      fd_pack_pending_remove( pack, cur );
+      continue;
     }
 
-    /* Check conflicts between all of this transactions's accounts and
-       current writers */
-    for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
-        i=fd_txn_acct_iter_next( i, ctrl ) ) {
-
-      fd_pack_addr_use_t * in_w_table = acct_uses_query( write_in_use,  acct[i], NULL );
-      if( in_w_table ) { delay_until = fd_ulong_max( delay_until, in_w_table->in_use_until );
-#if DETAILED_LOGGING
-        FD_LOG_NOTICE(( "Stalling transaction until >= %lu because it reads or writes %i which another transaction taken writes", delay_until, (int)acct[i].b[0] ));
+#if FD_PACK_USE_BITSET
+    int maybe_conflicts = 0;
+    for( ulong m=trp_pool_idx( pool, cur ); m!=null; m=pool[ m ].bundle_next ) maybe_conflicts |= fd_pack_bitset_maybe_conflicts( pack, pool+m );
+#else
+    int maybe_conflicts = 1;
 #endif
+
+    if( maybe_conflicts ) {
+      pack->metrics->bitset_fallback_cnt++;
+      int blocked_on = fd_pack_bundle_conflicts( pack, cur );
+      if( blocked_on ) {
+        /* Set it aside until whatever it conflicts with goes away */
+        fd_pack_block( pack, cur, blocked_on );
+        continue;
       }
     }
 
-    if( delay_until==pack->microblock_cnt ) {
-      /* Include this transaction in the microblock! */
-      txns_scheduled++;
-      cus_scheduled += cur->compute_est;
-      cu_limit -= cur->compute_est;
-      txn_limit--;
-
-      *out++ = *cur->txn; /* TODO: this copies more bytes than necessary in most cases */
+    /* Include this transaction (or bundle, in order) in the microblock! */
+    txns_scheduled += bundle_cnt;
+    cus_scheduled  += cur->compute_est;
+    cu_limit       -= cur->compute_est;
+    txn_limit      -= bundle_cnt;
+    out_rem        -= rec_sz;
+    bytes_written  += rec_sz;
+    for( ulong m=trp_pool_idx( pool, cur ); m!=null; m=pool[ m ].bundle_next ) out += fd_pack_include( pack, pool+m, bank_tile, out );
 
-      ulong in_use_until = pack->microblock_cnt + gap;
+    fd_pack_pending_remove( pack, cur );
+  }
 
-      for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
-          i=fd_txn_acct_iter_next( i, ctrl ) ) {
-        fd_acct_addr_t acct_addr = acct[i];
+  sched_return_t to_return = { .cus_scheduled = cus_scheduled, .txns_scheduled = txns_scheduled, .bytes_written = bytes_written };
+  return to_return;
+}
 
-        fd_pack_addr_use_t * in_wcost_table = acct_uses_query( writer_costs, acct_addr, NULL );
-        if( !in_wcost_table ) { in_wcost_table = acct_uses_insert( writer_costs, acct_addr );   in_wcost_table->total_cost = 0UL; }
-        in_wcost_table->total_cost += cur->compute_est;
+/* fd_pack_schedule_votes is fd_pack_schedule_next_microblock_impl for
+   the vote lane.  It takes votes oldest first, and since they are all
+   about the same size and cost, it stops at the first one that doesn't
+   fit instead of looking for a smaller one.  Each vote is examined at
+   most once per call, so this is O(1) per vote scheduled or blocked. */
+static inline sched_return_t
+fd_pack_schedule_votes( fd_pack_t  * pack,
+                        ulong        cu_limit,
+                        ulong        txn_limit,
+                        ulong        bank_tile,
+                        uchar      * out,
+                        ulong        out_rem ) {
 
-        fd_pack_addr_use_t * in_w_table = acct_uses_query( write_in_use,  acct_addr, NULL );
-        if( !in_w_table ) in_w_table = acct_uses_insert( write_in_use, acct_addr );
-        in_w_table->in_use_until = in_use_until;
+  fd_pack_ord_txn_t  * pool         = pack->pool;
+  ulong                null         = trp_pool_idx_null( pool );
 
-      }
-      for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_READONLY & FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
-          i=fd_txn_acct_iter_next( i, ctrl ) ) {
-        fd_acct_addr_t acct_addr = acct[i];
+  ulong txns_scheduled = 0UL;
+  ulong cus_scheduled  = 0UL;
+  ulong bytes_written  = 0UL;
 
-        fd_pack_addr_use_t * in_r_table = acct_uses_query( read_in_use, acct_addr, NULL );
-        if( !in_r_table ) in_r_table = acct_uses_insert( read_in_use, acct_addr );
-        in_r_table->in_use_until = in_use_until;
-      }
+  while( (txn_limit>0) & (pack->vote_head!=null) ) {
+    fd_pack_ord_txn_t * cur    = pool + pack->vote_head;
+    ulong               rec_sz = fd_pack_ord_rec_sz( cur );
+    if( (cur->compute_est>cu_limit) | (rec_sz>out_rem) ) break;
 
-      fd_ed25519_sig_t const * sig0 = fd_txn_get_signatures( txn, cur->txn->payload );
-      fd_pack_sig_to_txn_t * in_tbl = sig2txn_query( pack->signature_map, sig0, NULL );
-      sig2txn_remove( pack->signature_map, in_tbl );
+    pack->metrics->candidates_evaluated++;
 
-      treap_ele_remove( sched_from, cur, pool );
-      trp_pool_ele_release( pool, cur );
-      pack->pending_txn_cnt--;
+    if( FD_UNLIKELY( pack->balances && !fd_pack_bundle_affordable( pack, cur ) ) ) {
+      pack->metrics->unaffordable_cnt++;
+      fd_pack_pending_remove( pack, cur );
+      continue;
+    }
 
-    } else if( move_delayed ) {
-      delay_until = fd_ulong_min( delay_until, pack->microblock_cnt+FD_PACK_MAX_GAP );
-      cur->root = FD_ORD_TXN_ROOT_DELAYED_BASE + (int)delay_until;
+#if FD_PACK_USE_BITSET
+    int maybe_conflicts = fd_pack_bitset_maybe_conflicts( pack, cur );
+#else
+    int maybe_conflicts = 1;
+#endif
 
-      treap_ele_remove( sched_from,                                    cur, pool );
-      treap_ele_insert( pack->delayed+(delay_until % FD_PACK_MAX_GAP), cur, pool );
+    if( maybe_conflicts ) {
+      pack->metrics->bitset_fallback_cnt++;
+      int blocked_on = fd_pack_txn_conflicts( pack, cur );
+      if( blocked_on ) {
+        cur->blk_member = (ushort)0;
+        fd_pack_block( pack, cur, blocked_on );
+        continue;
+      }
     }
-  }
 
+    txns_scheduled++;
+    cus_scheduled  += cur->compute_est;
+    cu_limit       -= cur->compute_est;
+    txn_limit      --;
+    out_rem        -= rec_sz;
+    bytes_written  += rec_sz;
+    out            += fd_pack_include( pack, cur, bank_tile, out );
+
+    fd_pack_pending_remove( pack, cur );
+  }
 
-  sched_return_t to_return = { .cus_scheduled = cus_scheduled, .txns_scheduled = txns_scheduled };
+  sched_return_t to_return = { .cus_scheduled = cus_scheduled, .txns_scheduled = txns_scheduled, .bytes_written = bytes_written };
   return to_return;
 }
 
@@ -558,59 +1842,139 @@ ulong
 fd_pack_schedule_next_microblock( fd_pack_t *  pack,
                                   ulong        total_cus,
                                   float        vote_fraction,
-                                  fd_txn_p_t * out ) {
-
-
-  /* Move all the transactions that were delayed until now back into
-     pending so they'll be reconsidered. */
-  treap_merge( pack->pending, pack->delayed+(pack->microblock_cnt % FD_PACK_MAX_GAP), pack->pool );
+                                  ulong        bank_tile,
+                                  uchar      * out,
+                                  ulong        out_max,
+                                  ulong      * out_sz ) {
+  *out_sz = 0UL;
 
+  /* The locks held by this bank tile's previous microblock have not
+     been released yet, so it can't take another. */
+  if( FD_UNLIKELY( pack->outstanding_microblock_mask & (1UL<<bank_tile) ) ) return 0UL;
 
   /* TODO: Decide if these are exactly how we want to handle limits */
   total_cus = fd_ulong_min( total_cus, FD_PACK_MAX_COST_PER_BLOCK - pack->cumulative_block_cost );
   ulong vote_cus = fd_ulong_min( (ulong)((float)total_cus * vote_fraction), FD_PACK_MAX_VOTE_COST_PER_BLOCK - pack->cumulative_vote_cost );
+
+  /* When sharded, the block limits are shared, so take what this
+     microblock might use from the shard ctl and give back the rest
+     below. */
+  fd_pack_shard_ctl_t * ctl = pack->shard_ctl;
+  ulong block_gen = 0UL;
+  ulong vote_gen  = 0UL;
+  if( FD_UNLIKELY( ctl ) ) {
+    total_cus = fd_pack_shard_ctl_reserve( ctl, FD_PACK_SHARD_BUDGET_BLOCK, FD_PACK_MAX_COST_PER_BLOCK,      total_cus,                           &block_gen );
+    vote_cus  = fd_pack_shard_ctl_reserve( ctl, FD_PACK_SHARD_BUDGET_VOTE,  FD_PACK_MAX_VOTE_COST_PER_BLOCK, fd_ulong_min( vote_cus, total_cus ), &vote_gen  );
+  }
   ulong vote_reserved_txns = fd_ulong_min( vote_cus/FD_PACK_TYPICAL_VOTE_COST,
                                            (ulong)((float)pack->max_txn_per_microblock * vote_fraction) );
 
   ulong cu_limit  = total_cus - vote_cus;
   ulong txn_limit = pack->max_txn_per_microblock - vote_reserved_txns;
   ulong scheduled = 0UL;
+  ulong written   = 0UL;
+  ulong block_cost0 = pack->cumulative_block_cost;
 
   sched_return_t status;
 
   /* Try to schedule non-vote transactions */
-  status = fd_pack_schedule_next_microblock_impl( pack, pack->pending,       1, cu_limit, txn_limit,          out+scheduled );
+  status = fd_pack_schedule_next_microblock_impl( pack, cu_limit, txn_limit, bank_tile, out+written, out_max-written );
 
   scheduled += status.txns_scheduled;
+  written   += status.bytes_written;
   txn_limit -= status.txns_scheduled;
   cu_limit  -= status.cus_scheduled;
   pack->cumulative_block_cost += status.cus_scheduled;
 
 
   /* Schedule vote transactions */
-  status = fd_pack_schedule_next_microblock_impl( pack, pack->pending_votes, 0, vote_cus, vote_reserved_txns, out+scheduled );
+  status = fd_pack_schedule_votes( pack, vote_cus, vote_reserved_txns, bank_tile, out+written, out_max-written );
 
   scheduled                   += status.txns_scheduled;
+  written                     += status.bytes_written;
   pack->cumulative_vote_cost  += status.cus_scheduled;
   pack->cumulative_block_cost += status.cus_scheduled;
+  if( FD_UNLIKELY( ctl ) ) fd_pack_shard_ctl_unreserve( ctl, FD_PACK_SHARD_BUDGET_VOTE, vote_gen, vote_cus - status.cus_scheduled );
   /* Add any remaining CUs/txns to the non-vote limits */
   txn_limit += vote_reserved_txns - status.txns_scheduled;
   cu_limit  += vote_cus - status.cus_scheduled;
 
 
   /* Fill any remaining space with non-vote transactions */
-  status = fd_pack_schedule_next_microblock_impl( pack, pack->pending,       1, cu_limit, txn_limit,          out+scheduled );
+  status = fd_pack_schedule_next_microblock_impl( pack, cu_limit, txn_limit, bank_tile, out+written, out_max-written );
 
   scheduled                   += status.txns_scheduled;
+  written                     += status.bytes_written;
   pack->cumulative_block_cost += status.cus_scheduled;
 
+  if( FD_UNLIKELY( ctl ) ) fd_pack_shard_ctl_unreserve( ctl, FD_PACK_SHARD_BUDGET_BLOCK, block_gen, total_cus - (pack->cumulative_block_cost - block_cost0) );
+
   pack->microblock_cnt++;
+  pack->metrics->txns_scheduled += scheduled;
+  pack->metrics->cus_scheduled  += pack->cumulative_block_cost - block_cost0;
+  *out_sz = written;
+  pack->outstanding_microblock_mask |= fd_ulong_if( !!scheduled, 1UL<<bank_tile, 0UL );
 
   return scheduled;
 }
 
+void
+fd_pack_microblock_complete( fd_pack_t * pack,
+                             ulong       bank_tile ) {
+  ulong bank_bit = 1UL<<bank_tile;
+  if( FD_UNLIKELY( !(pack->outstanding_microblock_mask & bank_bit) ) ) return;
+
+  fd_pack_addr_use_t * acct_in_use = pack->acct_in_use;
+  fd_acct_addr_t     * use_by_bank = pack->use_by_bank[ bank_tile ];
+  ulong                use_cnt     = pack->use_by_bank_cnt[ bank_tile ];
+
+  for( ulong i=0UL; i<use_cnt; i++ ) {
+    fd_pack_addr_use_t * in_use = acct_uses_query( acct_in_use, use_by_bank[ i ], NULL );
+    if( FD_UNLIKELY( !in_use ) ) continue; /* Should be impossible */
+    in_use->in_use_by &= ~bank_bit;
+    if( !(in_use->in_use_by & FD_PACK_IN_USE_BANK_MASK) ) {
+      ulong blocked = in_use->blocked_head;
+      acct_uses_remove( acct_in_use, in_use );
+      fd_pack_unblock_all( pack, blocked );
+    }
+  }
+
+  pack->use_by_bank_cnt[ bank_tile ] = 0UL;
+  pack->outstanding_microblock_mask &= ~bank_bit;
+
+#if FD_PACK_USE_BITSET
+  /* Bits can be shared between bank tiles, so rebuild the union from
+     the bank tiles that are still outstanding. */
+  memset( pack->bank_w_in_use  + bank_tile*FD_PACK_BITSET_WORD_CNT, 0, FD_PACK_BITSET_WORD_CNT*sizeof(ulong) );
+  memset( pack->bank_rw_in_use + bank_tile*FD_PACK_BITSET_WORD_CNT, 0, FD_PACK_BITSET_WORD_CNT*sizeof(ulong) );
+  memset( pack->w_in_use,  0, sizeof(pack->w_in_use ) );
+  memset( pack->rw_in_use, 0, sizeof(pack->rw_in_use) );
+  for( ulong outstanding=pack->outstanding_microblock_mask; outstanding; outstanding=fd_ulong_pop_lsb( outstanding ) ) {
+    ulong const * bank_w  = pack->bank_w_in_use  + (ulong)fd_ulong_find_lsb( outstanding )*FD_PACK_BITSET_WORD_CNT;
+    ulong const * bank_rw = pack->bank_rw_in_use + (ulong)fd_ulong_find_lsb( outstanding )*FD_PACK_BITSET_WORD_CNT;
+    for( ulong j=0UL; j<FD_PACK_BITSET_MAX/64UL; j++ ) { pack->w_in_use[ j ] |= bank_w[ j ]; pack->rw_in_use[ j ] |= bank_rw[ j ]; }
+  }
+#endif
+}
+
 ulong fd_pack_avail_txn_cnt( fd_pack_t * pack ) { return pack->pending_txn_cnt; }
-ulong fd_pack_gap          ( fd_pack_t * pack ) { return pack->gap;             }
+
+void fd_pack_set_cu_est_tbl( fd_pack_t * pack, fd_est_ftbl_t const * tbl ) { pack->cu_est = tbl; }
+void fd_pack_set_alt_cache( fd_pack_t * pack, fd_alt_cache_t const * cache ) { pack->alt_cache = cache; }
+void fd_pack_set_balance_tbl( fd_pack_t * pack, fd_balance_tbl_t const * tbl ) { pack->balances = tbl; }
+void fd_pack_set_fee_stats( fd_pack_t * pack, fd_fee_stats_t * stats ) { pack->fee_stats = stats; }
+
+void
+fd_pack_set_shard_ctl( fd_pack_t           * pack,
+                       fd_pack_shard_ctl_t * ctl,
+                       int                   coord ) {
+  pack->shard_ctl        = ctl;
+  pack->write_cost_limit = fd_ulong_if( !ctl, FD_PACK_MAX_WRITE_COST_PER_ACCT,
+                           fd_ulong_if( coord, FD_PACK_SHARD_COORD_WRITE_COST, FD_PACK_MAX_WRITE_COST_PER_ACCT - FD_PACK_SHARD_COORD_WRITE_COST ) );
+}
+ulong fd_pack_bank_tile_cnt( fd_pack_t * pack ) { return pack->bank_tile_cnt;   }
+
+fd_pack_metrics_t const * fd_pack_metrics( fd_pack_t const * pack ) { return pack->metrics; }
 
 void
 fd_pack_end_block( fd_pack_t * pack ) {
@@ -618,39 +1982,73 @@ fd_pack_end_block( fd_pack_t * pack ) {
   pack->cumulative_block_cost = 0UL;
   pack->cumulative_vote_cost  = 0UL;
 
-  for( ulong i=0UL; i<FD_PACK_MAX_GAP; i++ ) treap_merge( pack->pending, pack->delayed+i, pack->pool );
-
-  acct_uses_clear( pack->read_in_use  );
-  acct_uses_clear( pack->write_in_use );
   acct_uses_clear( pack->writer_costs );
+  acct_uses_clear( pack->payer_spend  );
+#if FD_PACK_USE_BITSET
+  memset( pack->w_saturated, 0, sizeof(pack->w_saturated) );
+#endif
+
+  fd_pack_unblock_all( pack, pack->blocked_block_head );
+  pack->blocked_block_head = trp_pool_idx_null( pack->pool );
 }
 
-static void
-release_tree( treap_t           * treap,
-              fd_pack_ord_txn_t * pool ) {
-  treap_fwd_iter_t next;
-  for( treap_fwd_iter_t it=treap_fwd_iter_init( treap, pool ); !treap_fwd_iter_idx( it ); it=next ) {
-    next = treap_fwd_iter_next( it, pool );
-    ulong idx = treap_fwd_iter_idx( it );
-    treap_idx_remove    ( treap, idx, pool );
-    trp_pool_idx_release( pool,  idx       );
+ulong
+fd_pack_expire_before( fd_pack_t * pack,
+                       ulong       expire_before ) {
+  ulong expired_cnt = 0UL;
+  for(;;) {
+    expq_fwd_iter_t it = expq_fwd_iter_init( pack->expiring, pack->pool );
+    if( expq_fwd_iter_done( it ) ) break;
+    fd_pack_ord_txn_t * oldest = expq_fwd_iter_ele( it, pack->pool );
+    if( oldest->expires_at>=expire_before ) break;
+
+    fd_pack_pending_remove( pack, oldest );
+    expired_cnt++;
   }
+  pack->metrics->expired_cnt += expired_cnt;
+  return expired_cnt;
 }
 
+
 void
 fd_pack_clear_all( fd_pack_t * pack ) {
   pack->pending_txn_cnt       = 0UL;
   pack->microblock_cnt        = 0UL;
   pack->cumulative_block_cost = 0UL;
   pack->cumulative_vote_cost  = 0UL;
-
-  release_tree( pack->pending,       pack->pool );
-  release_tree( pack->pending_votes, pack->pool );
-  for( ulong i=0UL; i<FD_PACK_MAX_GAP; i++ ) { release_tree( pack->delayed+i, pack->pool ); }
-
-  acct_uses_clear( pack->read_in_use  );
-  acct_uses_clear( pack->write_in_use );
+  pack->outstanding_microblock_mask = 0UL;
+
+  /* Every pending transaction is in the expiry treap, including the
+     blocked ones, so walk that instead of each of the places a pending
+     transaction can be, and then reset them all. */
+  fd_pack_ord_txn_t * pool = pack->pool;
+  expq_fwd_iter_t next;
+  for( expq_fwd_iter_t it=expq_fwd_iter_init( pack->expiring, pool ); !expq_fwd_iter_done( it ); it=next ) {
+    next = expq_fwd_iter_next( it, pool );
+    fd_pack_release_bundle( pack, expq_fwd_iter_idx( it ) );
+  }
+  treap_new( (void*)pack->pending,       pack->pack_depth );
+  expq_new ( (void*)pack->expiring,      pack->pack_depth );
+  pack->blocked_block_head = trp_pool_idx_null( pool );
+  pack->vote_head          = trp_pool_idx_null( pool );
+  pack->vote_tail          = trp_pool_idx_null( pool );
+  vote_accts_clear( pack->vote_accts );
+  fee_accts_clear( pack->fee_accts );
+  pack->fee_pending_cnt = 0UL;
+  pack->fee_top_cnt     = 0UL;
+
+  acct_uses_clear( pack->acct_in_use  );
   acct_uses_clear( pack->writer_costs );
+  acct_uses_clear( pack->payer_spend  );
+  for( ulong i=0UL; i<FD_PACK_MAX_BANK_TILES; i++ ) pack->use_by_bank_cnt[ i ] = 0UL;
+
+#if FD_PACK_USE_BITSET
+  memset( pack->w_in_use,       0, sizeof(pack->w_in_use   ) );
+  memset( pack->rw_in_use,      0, sizeof(pack->rw_in_use  ) );
+  memset( pack->w_saturated,    0, sizeof(pack->w_saturated) );
+  memset( pack->bank_w_in_use,  0, pack->bank_tile_cnt*FD_PACK_BITSET_WORD_CNT*sizeof(ulong) );
+  memset( pack->bank_rw_in_use, 0, pack->bank_tile_cnt*FD_PACK_BITSET_WORD_CNT*sizeof(ulong) );
+#endif
 
   sig2txn_clear( pack->signature_map );
 }
@@ -667,22 +2065,56 @@ fd_pack_delete_transaction( fd_pack_t              * pack,
      the first element of the fd_pack_ord_txn_t struct.  The signature
      we insert is 1 byte into the start of the payload. */
   fd_pack_ord_txn_t * containing = (fd_pack_ord_txn_t *)( (uchar*)in_tbl->key - 1UL );
-  treap_t * root = NULL;
-  int root_idx = containing->root;
-  switch( root_idx ) {
-    case FD_ORD_TXN_ROOT_FREE:          /* Should be impossible */                                    return 0;
-    case FD_ORD_TXN_ROOT_PENDING:       root = pack->pending;                                        break;
-    case FD_ORD_TXN_ROOT_PENDING_VOTE:  root = pack->pending_votes;                                  break;
-    default:                            root = pack->delayed+(root_idx-FD_ORD_TXN_ROOT_DELAYED_BASE); break;
-  }
-  treap_ele_remove( root, containing, pack->pool );
-  trp_pool_ele_release( pack->pool, containing );
-  sig2txn_remove( pack->signature_map, in_tbl );
-  pack->pending_txn_cnt--;
+  switch( containing->root ) {
+    case FD_ORD_TXN_ROOT_PENDING:
+    case FD_ORD_TXN_ROOT_PENDING_VOTE:
+    case FD_ORD_TXN_ROOT_BLOCKED_ACCT:
+    case FD_ORD_TXN_ROOT_BLOCKED_BLOCK: break;
+    default:                            /* Should be impossible */ return 0;
+  }
+  fd_pack_pending_remove( pack, containing );
 
   return 1;
 }
 
 
+void
+fd_pack_publish_fee_stats( fd_pack_t * pack ) {
+  fd_fee_stats_t * stats = pack->fee_stats;
+  if( FD_UNLIKELY( !stats ) ) return;
+
+  fd_fee_stats_acct_t out[ FD_FEE_STATS_ACCT_MAX ];
+  ulong               top_cnt = pack->fee_top_cnt;
+  for( ulong r=0UL; r<top_cnt; r++ ) {
+    fd_pack_fee_acct_t const * e = fee_accts_query( pack->fee_accts, pack->fee_top[ r ], NULL );
+
+    /* The min is the lower bound of the first non-empty bucket, and the
+       median that of the bucket where half of them have been seen */
+    ulong half = ((ulong)e->pending_cnt+1UL)/2UL;
+    ulong seen = 0UL;
+    ulong lo   = FD_PACK_FEE_HIST_CNT;
+    ulong b    = 0UL;
+    for( ; b<FD_PACK_FEE_HIST_CNT-1UL; b++ ) {
+      if( e->hist[ b ] ) lo = fd_ulong_min( lo, b );
+      seen += e->hist[ b ];
+      if( seen>=half ) break;
+    }
+    lo = fd_ulong_min( lo, b );
+
+    fd_pack_addr_use_t const * wcost = acct_uses_query( pack->writer_costs, e->key, NULL );
+
+    /* Insertion sort by pending_cnt, largest first.  There are only a
+       few of them. */
+    ulong j = r;
+    while( j && out[ j-1UL ].pending_cnt<(ulong)e->pending_cnt ) { out[ j ] = out[ j-1UL ]; j--; }
+    out[ j ].key               = e->key;
+    out[ j ].pending_cnt       = e->pending_cnt;
+    out[ j ].min_fee_per_cu    = fd_pack_fee_bucket_lo( lo );
+    out[ j ].median_fee_per_cu = fd_pack_fee_bucket_lo( b  );
+    out[ j ].cus_scheduled     = wcost ? wcost->total_cost : 0UL;
+  }
+  fd_fee_stats_publish( stats, out, top_cnt, pack->fee_pending_cnt );
+}
+
 void * fd_pack_leave ( fd_pack_t * pack ) { FD_COMPILER_MFENCE(); return (void *)pack; }
 void * fd_pack_delete( void      * mem  ) { FD_COMPILER_MFENCE(); return mem;          }
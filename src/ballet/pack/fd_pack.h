@@ -8,11 +8,33 @@
 #include "../fd_ballet_base.h"
 #include "../txn/fd_txn.h"
 #include "fd_est_tbl.h"
+#include "fd_est_ftbl.h"
+#include "fd_alt_cache.h"
+#include "fd_balance_tbl.h"
+#include "fd_fee_stats.h"
+#include "fd_pack_shard.h"
 
 
 #define FD_PACK_ALIGN     (32UL)
 
-#define FD_PACK_MAX_GAP 64UL
+/* FD_PACK_MAX_BANK_TILES gives the maximum number of bank tiles that a
+   single pack object can schedule for concurrently.  Account locks are
+   tracked with one bit per bank tile in a ulong, and the top bits are
+   reserved for flags. */
+#define FD_PACK_MAX_BANK_TILES 62UL
+
+/* FD_PACK_MAX_TXN_PER_BUNDLE gives the maximum number of transactions in
+   a bundle.  See fd_pack_insert_bundle_init. */
+#define FD_PACK_MAX_TXN_PER_BUNDLE 5UL
+
+/* FD_PACK_USE_BITSET: set to 1 (e.g. build with EXTRAS=pack-bitset) to
+   screen candidate transactions for account conflicts using bitsets
+   indexed by a hash of the account address before falling back to the
+   precise per-account maps.  The scheduling decisions are identical
+   either way; only the cost of evaluating a candidate differs. */
+#ifndef FD_PACK_USE_BITSET
+#define FD_PACK_USE_BITSET 0
+#endif
 
 
 /* NOTE: THE FOLLOWING CONSTANTS ARE CONSENSUS CRITICAL AND CANNOT BE
@@ -45,6 +67,105 @@ typedef struct fd_txn_p fd_txn_p_t;
 #define TXN(txn_p) ((fd_txn_t *)( (txn_p)->_ ))
 
 
+/* A scheduled microblock is written out in a compact format: a
+   sequence of variable size records, one per transaction, packed back
+   to back.  Each record is:
+
+     fd_pack_microblock_txn_t header ....... (16 bytes)
+     payload ............................... (payload_sz bytes)
+     padding to alignof(fd_txn_t)
+     fd_txn_t ............................. (fd_txn_footprint bytes)
+     padding to FD_PACK_MICROBLOCK_TXN_ALIGN
+
+   so only the bytes of the payload and of the parsed transaction that
+   are actually used get written.  rec_sz is the size of the whole
+   record including the header and padding, and txn_off is the offset
+   of the fd_txn_t from the start of the record.  Records start at
+   multiples of FD_PACK_MICROBLOCK_TXN_ALIGN from the start of the
+   microblock, and no record is larger than
+   FD_PACK_MICROBLOCK_TXN_MAX_SZ. */
+
+#define FD_PACK_MICROBLOCK_TXN_ALIGN            (8UL)
+#define FD_PACK_MICROBLOCK_TXN_MAX_SZ           (2112UL) /* 16 + 1232 + 1 + 860, aligned up to 8 */
+#define FD_PACK_MICROBLOCK_TXN_FLAG_SIMPLE_VOTE ((ushort)1)
+
+struct fd_pack_microblock_txn {
+  ushort rec_sz;
+  ushort payload_sz;
+  ushort txn_off;
+  ushort flags;  /* Bitwise OR of FD_PACK_MICROBLOCK_TXN_FLAG_* */
+  ulong  meta;   /* The meta field of the fd_txn_p_t that was inserted */
+};
+typedef struct fd_pack_microblock_txn fd_pack_microblock_txn_t;
+
+FD_STATIC_ASSERT( sizeof(fd_pack_microblock_txn_t)==16UL, fd_pack_microblock_txn );
+FD_STATIC_ASSERT( FD_PACK_MICROBLOCK_TXN_MAX_SZ>=sizeof(fd_pack_microblock_txn_t)+FD_TPU_MTU+1UL+FD_TXN_MAX_SZ, fd_pack_microblock_txn );
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_pack_microblock_txn_sz returns the size of the record that holds a
+   transaction with the given payload size and fd_txn_t footprint. */
+FD_FN_CONST static inline ulong
+fd_pack_microblock_txn_sz( ulong payload_sz,
+                           ulong txn_sz      ) {
+  ulong txn_off = fd_ulong_align_up( sizeof(fd_pack_microblock_txn_t)+payload_sz, alignof(fd_txn_t) );
+  return fd_ulong_align_up( txn_off+txn_sz, FD_PACK_MICROBLOCK_TXN_ALIGN );
+}
+
+/* Accessors for the parts of a record.  rec must point to the header
+   of a valid record.  fd_pack_microblock_txn_next returns a pointer to
+   the record that follows rec, which is only valid if rec is not the
+   last record of the microblock. */
+FD_FN_CONST static inline uchar const *
+fd_pack_microblock_txn_payload( fd_pack_microblock_txn_t const * rec ) {
+  return (uchar const *)(rec+1);
+}
+
+FD_FN_PURE static inline fd_txn_t const *
+fd_pack_microblock_txn_txn( fd_pack_microblock_txn_t const * rec ) {
+  return (fd_txn_t const *)((ulong)rec + (ulong)rec->txn_off);
+}
+
+FD_FN_PURE static inline fd_pack_microblock_txn_t const *
+fd_pack_microblock_txn_next( fd_pack_microblock_txn_t const * rec ) {
+  return (fd_pack_microblock_txn_t const *)((ulong)rec + (ulong)rec->rec_sz);
+}
+
+
+/* fd_pack_metrics_t: counters that a pack object maintains over its
+   lifetime.  They are never reset, not even by fd_pack_clear_all. */
+struct fd_pack_metrics {
+  ulong txns_scheduled;       /* Transactions included in a microblock */
+  ulong cus_scheduled;        /* Total estimated cost of those transactions */
+  ulong candidates_evaluated; /* Transactions considered for inclusion in a microblock */
+  ulong bitset_fallback_cnt;  /* Candidates that needed the precise conflict check.
+                                 Always equal to candidates_evaluated unless
+                                 FD_PACK_USE_BITSET */
+  ulong evicted_cnt;              /* Pending transactions removed to make room for
+                                     a better one while pack was full */
+  ulong insert_rejected_full_cnt; /* Inserts dropped because pack was full and the
+                                     transaction was no better than what it held */
+  ulong expired_cnt;              /* Pending transactions removed by
+                                     fd_pack_expire_before */
+  ulong blocked_cnt;              /* Candidates set aside until the account lock
+                                     or per-account limit they conflicted
+                                     with is released */
+  ulong alt_unresolved_cnt;       /* Inserted transactions that load accounts from
+                                     address lookup tables that the ALT cache
+                                     couldn't resolve or that pack had no room
+                                     left to store */
+  ulong unaffordable_cnt;         /* Transactions dropped at insert or when
+                                     scheduling because their fee payer's
+                                     balance couldn't cover their fee */
+  ulong vote_replaced_cnt;        /* Pending votes removed because a vote for
+                                     the same vote account and the same or a
+                                     later slot was inserted */
+  ulong vote_outdated_cnt;        /* Votes dropped at insert because a pending
+                                     vote for the same vote account was for a
+                                     later slot */
+};
+typedef struct fd_pack_metrics fd_pack_metrics_t;
+
 /* Forward declare opaque handle */
 struct fd_pack_private;
 typedef struct fd_pack_private fd_pack_t;
@@ -56,11 +177,14 @@ typedef struct fd_pack_private fd_pack_t;
    pack_depth sets the maximum number of pending transactions that pack
    stores and may eventually schedule.
 
-   gap sets the number of microblocks between any two conflicting uses
-   of an account. For example, if gap==2, then if pack schedules a
-   transaction that writes to an account A, the following microblock
-   will not contain any transactions that read or write to A, but the
-   microblock after that one may.  gap must be in [1, FD_PACK_MAX_GAP].
+   bank_tile_cnt sets the number of bank tiles to which this pack
+   object can schedule microblocks concurrently.  Each bank tile has at
+   most one outstanding microblock at a time.  The accounts a
+   microblock reads or writes stay locked from when it is scheduled
+   until the bank tile reports completion with
+   fd_pack_microblock_complete, so two conflicting uses of an account
+   are never in flight at the same time.  bank_tile_cnt must be in
+   [1, FD_PACK_MAX_BANK_TILES].
 
    max_txn_per_microblock sets the maximum number of transactions that
    pack will schedule in a single microblock. */
@@ -69,21 +193,21 @@ FD_FN_CONST static inline ulong fd_pack_align       ( void ) { return FD_PACK_AL
 
 FD_FN_CONST ulong
 fd_pack_footprint( ulong pack_depth,
-                   ulong gap,
+                   ulong bank_tile_cnt,
                    ulong max_txn_per_microblock );
 
 
 /* fd_pack_new formats a region of memory to be suitable for use as a
    pack object.  mem is a non-NULL pointer to a region of memory in the
    local address space with the required alignment and footprint.
-   pack_depth, gap, and max_txn_per_microblock are as above.  rng is a
+   pack_depth, bank_tile_cnt, and max_txn_per_microblock are as above.  rng is a
    local join to a random number generator used to perturb estimates.
 
    Returns `mem` (which will be properly formatted as a pack object) on
    success and NULL on failure.  Logs details on failure.  The caller
    will not be joined to the pack object when this function returns. */
 void * fd_pack_new( void * mem,
-    ulong pack_depth, ulong gap, ulong max_txn_per_microblock,
+    ulong pack_depth, ulong bank_tile_cnt, ulong max_txn_per_microblock,
     fd_rng_t * rng );
 
 /* fd_pack_join joins the caller to the pack object.  Every successful
@@ -98,10 +222,101 @@ fd_pack_t * fd_pack_join( void * mem );
 
 FD_FN_PURE ulong fd_pack_avail_txn_cnt( fd_pack_t * pack );
 
-/* fd_pack_gap: returns the value of gap provided in pack when the pack
-   object was initialized with fd_pack_new.  pack must be a valid local
-   join.  The result will be in [1, FD_PACK_MAX_GAP]. */
-FD_FN_PURE ulong fd_pack_gap( fd_pack_t * pack );
+/* fd_pack_bank_tile_cnt: returns the value of bank_tile_cnt provided in
+   pack when the pack object was initialized with fd_pack_new.  pack
+   must be a valid local join.  The result will be in [1,
+   FD_PACK_MAX_BANK_TILES]. */
+FD_FN_PURE ulong fd_pack_bank_tile_cnt( fd_pack_t * pack );
+
+/* fd_pack_metrics returns the metrics counters of pack.  pack must be a
+   valid local join.  The returned pointer has the same lifetime as the
+   local join. */
+FD_FN_CONST fd_pack_metrics_t const * fd_pack_metrics( fd_pack_t const * pack );
+
+/* fd_pack_cu_est_tag returns the tag under which the compute units
+   consumed by instructions of the program with address program_id are
+   recorded in a CU estimation table.  See fd_pack_set_cu_est_tbl. */
+FD_FN_PURE static inline ulong
+fd_pack_cu_est_tag( fd_acct_addr_t const * program_id ) {
+  return fd_ulong_hash( fd_ulong_load_8( program_id->b ) );
+}
+
+/* fd_pack_set_cu_est_tbl makes pack consult tbl when estimating the
+   cost of transactions inserted from now on.  tbl should be fed the CUs
+   that instructions actually consume, tagged with fd_pack_cu_est_tag of
+   their program, typically by the bank tiles as they execute
+   microblocks.  It's read concurrently without locks (see
+   fd_est_ftbl.h), and should be created with a default value of
+   FD_COMPUTE_BUDGET_DEFAULT_INSTR_CU_LIMIT so that programs that haven't
+   been seen yet are estimated conservatively.
+
+   With a table, the part of a transaction's cost that comes from the CU
+   limit of its non-built-in instructions is replaced by the sum over
+   those instructions of the estimated mean plus one standard deviation,
+   if that is lower.  The rest of the cost model is unchanged.  This
+   affects the priority (rewards per CU) of the transaction as well as
+   how much of the microblock, block and per-account limits it uses, so
+   blocks are filled based on expected rather than worst-case cost.
+   Passing NULL reverts to the pure cost model.  pack must be a valid
+   local join and tbl, if non-NULL, a local join that outlives its use
+   by pack. */
+void fd_pack_set_cu_est_tbl( fd_pack_t * pack, fd_est_ftbl_t const * tbl );
+
+/* fd_pack_set_alt_cache makes pack resolve the accounts that
+   transactions inserted from now on load from address lookup tables
+   using cache.  cache should be kept up to date with the contents of
+   the tables from the account store, typically by the bank tiles.  It's
+   read concurrently without locks (see fd_alt_cache.h).
+
+   Without a cache, or if a transaction uses a table that isn't cached
+   or pack is out of room for resolved addresses, which it only
+   provisions for a few per pending transaction on average (both
+   counted in alt_unresolved_cnt), only the accounts listed in the
+   transaction itself are known to pack, so it may schedule transactions
+   that conflict on an account from a table in the same microblock or in
+   concurrent microblocks, and doesn't charge their cost to that
+   account's per-block write limit.  The bank tiles then serialize them
+   or fail them, at the expense of throughput.  With the cache, those
+   accounts are treated exactly like the others.  Passing NULL disables
+   resolution.  pack must be a valid local join and cache, if non-NULL,
+   a local join that outlives its use by pack. */
+void fd_pack_set_alt_cache( fd_pack_t * pack, fd_alt_cache_t const * cache );
+
+/* fd_pack_set_balance_tbl makes pack check that the fee payer of each
+   transaction can afford its fee (the signature fee plus the priority
+   fee), according to the balances in tbl, less the fees of the
+   transactions that pack has already scheduled in the current block.
+   That's checked at insert, so that transactions that can't be afforded
+   don't take up space in the pool, and again before scheduling, since
+   by then the payer may have spent its balance on other transactions.
+   Transactions that fail either check are dropped.  Payers that aren't
+   in tbl can afford anything.  tbl should be refreshed periodically
+   from the account store, typically by the bank tiles, and is read
+   concurrently without locks (see fd_balance_tbl.h).  Passing NULL
+   disables the check.  pack must be a valid local join and tbl, if
+   non-NULL, a local join that outlives its use by pack. */
+void fd_pack_set_balance_tbl( fd_pack_t * pack, fd_balance_tbl_t const * tbl );
+
+/* fd_pack_set_fee_stats makes pack count the transactions inserted from
+   now on in the local fee market statistics that
+   fd_pack_publish_fee_stats publishes to stats.  Counting them costs a
+   map update per written account on every insert and every removal
+   (including scheduling), so pack doesn't unless it has somewhere to
+   publish them.  Passing NULL stops counting new transactions and
+   publishing.  pack must be a valid local join and stats, if non-NULL,
+   a local join of a fee stats table that outlives its use by pack and
+   of which pack is the only writer. */
+void fd_pack_set_fee_stats( fd_pack_t * pack, fd_fee_stats_t * stats );
+
+/* fd_pack_set_shard_ctl makes pack one of the pack objects of a sharded
+   pack sharing ctl (see fd_pack_shard.h): a shard if coord is zero and
+   the coordinator otherwise.  The block cost limits then apply to all
+   of them together, and pack gets its part of the per-account write
+   cost limit.  It's up to the caller to insert only the transactions
+   fd_pack_shard_route sends to pack, and to use the barrier.  Passing
+   NULL makes pack stand alone again.  pack must be a valid local join
+   and ctl, if non-NULL, a local join that outlives its use by pack. */
+void fd_pack_set_shard_ctl( fd_pack_t * pack, fd_pack_shard_ctl_t * ctl, int coord );
 
 /* fd_pack_insert_txn_{init,fini,cancel} execute the process of
    inserting a new transaction into the pool of available transactions
@@ -122,32 +337,132 @@ FD_FN_PURE ulong fd_pack_gap( fd_pack_t * pack );
    The caller of these methods should not retain any read or write
    interest in the transaction after _fini or _cancel have been called.
 
+   expires_at is an opaque, caller-chosen timestamp (e.g. a slot or
+   block count) after which the transaction should no longer be
+   scheduled.  Pack never looks at the clock; the transaction stays
+   pending until it is scheduled, deleted, evicted, or removed by a
+   call to fd_pack_expire_before with a larger value.
+
+   Simple votes are kept apart from other transactions, oldest first,
+   and only the latest vote for each vote account is kept: inserting a
+   simple vote discards any pending vote for the same vote account that
+   votes for the same or an earlier slot, and a simple vote for an
+   earlier slot than the pending one is discarded instead.
+   Votes that are part of a bundle are treated like any other
+   transaction.
+
+   If pack already holds pack_depth pending transactions, a new simple
+   vote replaces the oldest pending simple vote.  Any other new
+   transaction (or a vote, if there are no pending votes) is compared
+   against the lowest priority pending non-vote transaction, or the
+   oldest vote if there are none, and the lower priority of the two is
+   discarded.  Blocked transactions (see
+   fd_pack_schedule_next_microblock) are not considered, and if every
+   pending transaction is blocked, the new one is discarded.  This
+   takes O(log pack_depth) time, and O(1) for votes.
+
    pack must be a local join of a pack object.  From the caller's
    perspective, these functions cannot fail.
  */
-fd_txn_p_t * fd_pack_insert_txn_init  ( fd_pack_t * pack                   );
-void         fd_pack_insert_txn_fini  ( fd_pack_t * pack, fd_txn_p_t * txn );
-void         fd_pack_insert_txn_cancel( fd_pack_t * pack, fd_txn_p_t * txn );
+fd_txn_p_t * fd_pack_insert_txn_init  ( fd_pack_t * pack                                     );
+void         fd_pack_insert_txn_fini  ( fd_pack_t * pack, fd_txn_p_t * txn, ulong expires_at );
+void         fd_pack_insert_txn_cancel( fd_pack_t * pack, fd_txn_p_t * txn                   );
+
+/* fd_pack_insert_bundle_{init,fini,cancel} are like
+   fd_pack_insert_txn_{init,fini,cancel}, but insert a bundle: an
+   ordered group of txn_cnt transactions that are scheduled all or
+   nothing, contiguously and in order in a single microblock.
+
+   fd_pack_insert_bundle_init stores pointers to txn_cnt pieces of
+   memory where the transactions should be stored in bundle[ i ] for i
+   in [0, txn_cnt) and returns bundle.  txn_cnt must be in [1,
+   FD_PACK_MAX_TXN_PER_BUNDLE]; otherwise it returns NULL and the call
+   doesn't need a matching _fini or _cancel.  Otherwise, every call
+   must be paired with a call to exactly one of _fini or _cancel with
+   the same bundle and txn_cnt, and not interleaved with
+   fd_pack_insert_txn_*.
+
+   The bundle is prioritized as a unit by its total rewards per total
+   cost, and it's checked for conflicts and against the microblock,
+   block, and per-account limits with the union of the accounts of its
+   transactions.  Since transactions in a microblock can't conflict,
+   _fini throws out bundles with a transaction that writes an account
+   another transaction of the bundle uses, as well as bundles with any
+   transaction that would be thrown out if it were inserted alone, and
+   bundles with more than max_txn_per_microblock transactions.  If pack
+   is full, the bundle takes the place of as many of the lowest
+   priority non-vote transactions as needed as long as it's better than
+   each of them, as described for fd_pack_insert_txn_fini, and is
+   thrown out otherwise.
+
+   A pending bundle is identified by the signature of its first
+   transaction, e.g. for fd_pack_delete_transaction, which removes the
+   whole bundle.  Bundles count as txn_cnt transactions toward
+   pack_depth and fd_pack_avail_txn_cnt. */
+fd_txn_p_t * const * fd_pack_insert_bundle_init  ( fd_pack_t * pack, fd_txn_p_t ** bundle, ulong txn_cnt );
+void                 fd_pack_insert_bundle_fini  ( fd_pack_t * pack, fd_txn_p_t * const * bundle, ulong txn_cnt, ulong expires_at );
+void                 fd_pack_insert_bundle_cancel( fd_pack_t * pack, fd_txn_p_t * const * bundle, ulong txn_cnt );
 
 
 /* fd_pack_schedule_next_microblock schedules transactions to form a
-   microblock, which is a set of non-conflicting transactions.
-
-   pack must be a local join of a pack object.  Transactions part of the
-   scheduled microblock are copied to out in no particular order.  The
-   cumulative cost of these transactions will not excede total_cus, and
+   microblock for bank tile bank_tile.  A microblock is a set of
+   transactions that do not conflict with each other or with any
+   transaction in a microblock that is outstanding at another bank tile.
+
+   pack must be a local join of a pack object.  bank_tile must be in
+   [0, bank_tile_cnt) and must not have an outstanding microblock, i.e.
+   every microblock previously scheduled for bank_tile must have been
+   acknowledged with fd_pack_microblock_complete.  If bank_tile has an
+   outstanding microblock, nothing is scheduled and 0 is returned.
+
+   Transactions part of the scheduled microblock are written to out in
+   the compact record format described above, in no particular order,
+   except that the transactions of a bundle are contiguous and in
+   order.
+   out must be aligned to FD_PACK_MICROBLOCK_TXN_ALIGN and have room for
+   out_max bytes.  On return, *out_sz holds the number of bytes written,
+   which will not excede out_max.  A transaction whose record doesn't
+   fit in the remaining space is left for a later microblock.  The
+   cumulative cost of the transactions will not excede total_cus, and
    the number of transactions will not excede the value of
    max_txn_per_microblock given in fd_pack_new.
 
    The block will not contain more than
    vote_fraction*max_txn_per_microblock votes, and votes in total will
    not consume more than vote_fraction*total_cus of the microblock.
+   Votes are scheduled oldest first, in O(1) time per vote.
+
+   A pending transaction that is found to conflict with an outstanding
+   microblock is blocked: it is set aside and not considered again
+   until the lock on the account it conflicts with is released by
+   fd_pack_microblock_complete.  Likewise, one that would exceed the
+   per-account write cost limit is blocked until fd_pack_end_block.
+   Blocked transactions still count as pending.  This way, the cost of
+   scheduling is proportional to the number of transactions that can
+   be scheduled, not the number that are pending, even when many of
+   them write the same hot account.
 
    Returns the number of transactions in the scheduled microblock.  The
    return value may be 0 if there are no eligible transactions at the
-   moment. */
-
-ulong fd_pack_schedule_next_microblock( fd_pack_t * pack, ulong total_cus, float vote_fraction, fd_txn_p_t * out );
+   moment.  A microblock with 0 transactions is not outstanding. */
+
+ulong
+fd_pack_schedule_next_microblock( fd_pack_t * pack,
+                                  ulong       total_cus,
+                                  float       vote_fraction,
+                                  ulong       bank_tile,
+                                  uchar     * out,
+                                  ulong       out_max,
+                                  ulong     * out_sz );
+
+/* fd_pack_microblock_complete signals that bank_tile has finished
+   executing the microblock most recently scheduled for it, releasing
+   the account locks held by that microblock.  Transactions that
+   conflicted only with that microblock become eligible to be
+   scheduled.  Calling this for a bank tile without an outstanding
+   microblock is a no-op.  pack must be a local join of a pack object
+   and bank_tile must be in [0, bank_tile_cnt). */
+void fd_pack_microblock_complete( fd_pack_t * pack, ulong bank_tile );
 
 /* fd_pack_delete_txn removes a transaction (identified by its first
    signature) from the pool of available transactions.  Returns 1 if the
@@ -155,18 +470,48 @@ ulong fd_pack_schedule_next_microblock( fd_pack_t * pack, ulong total_cus, float
 int fd_pack_delete_transaction( fd_pack_t * pack, fd_ed25519_sig_t const * sig0 );
 
 /* fd_pack_end_block resets some state to prepare for the next block.
-   Specifically, the per-block limits are cleared and transactions in
-   the microblocks scheduled after the call to this function are allowed
-   to conflict with transactions in microblocks scheduled before the
-   call to this function, even within gap microblocks. */
+   Specifically, the per-block limits are cleared.  Account locks held
+   by outstanding microblocks are not affected; they are still released
+   by fd_pack_microblock_complete. */
 void fd_pack_end_block( fd_pack_t * pack );
 
+/* fd_pack_expire_before removes all pending transactions with
+   expires_at strictly less than expire_before, e.g. those whose recent
+   blockhash is too old to land.  Transactions in outstanding
+   microblocks are not affected.  Takes O((1+k) log pack_depth) time
+   where k is the number removed.  Returns k. */
+ulong fd_pack_expire_before( fd_pack_t * pack, ulong expire_before );
+
 
 /* fd_pack_clear_all resets the state associated with this pack object.
    All pending transactions are removed from the pool of available
-   transactions and all limits are reset. */
+   transactions, all limits are reset and all bank tiles are treated as
+   having no outstanding microblock. */
 void fd_pack_clear_all( fd_pack_t * pack );
 
+/* fd_pack_publish_fee_stats publishes a snapshot of the local fee
+   market to stats (see fd_fee_stats.h): up to FD_FEE_STATS_ACCT_MAX of
+   the accounts written by the most pending transactions, with how many
+   pending transactions write each, the approximate minimum and median
+   priority fee per compute unit among them, and the compute units of
+   transactions writing it scheduled so far in the current block.  The
+   transactions of a bundle are counted individually but priced at the
+   priority fee per compute unit of the whole bundle, and the vote lane
+   is not counted.  The minimum and median are lower bounds of
+   logarithmic histogram buckets, so they can be up to a third below
+   the true values.  If there are more distinct written accounts than
+   pack can track, some are left out, and an account whose count went
+   down may keep its place over one with more writers until that one
+   gets another.
+
+   Pack keeps these counts up to date as transactions are inserted and
+   removed, so this takes O(FD_FEE_STATS_ACCT_MAX) time, and doesn't
+   change the state of pack.  The snapshot only covers the transactions
+   inserted while pack had a fee stats table (see
+   fd_pack_set_fee_stats), and nothing is published if it doesn't have
+   one now.  pack must be a local join of a pack object. */
+void fd_pack_publish_fee_stats( fd_pack_t * pack );
+
 
 /* fd_pack_leave leaves a local join of a pack object.  Returns pack.
    fd_pack_delete unformats a memory region used to store a pack object
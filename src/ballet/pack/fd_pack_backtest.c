@@ -0,0 +1,533 @@
+/* fd_pack_backtest replays transactions captured from the TPU through
+   pack under different configurations, to compare them offline.
+
+   Usage:
+
+     fd_pack_backtest --pcap FILE [--port N] [options]
+
+   FILE is a pcap or pcapng capture of Ethernet frames.  The UDP
+   payload of each IPv4/UDP packet (to port N if given) is parsed as a
+   transaction; packets that don't parse are skipped.  QUIC traffic is
+   encrypted, so the capture has to be of plain UDP TPU traffic, or of
+   the decrypted stream re-encapsulated in UDP.
+
+   Each run simulates the pack tile against the capture's own clock:
+   transactions are inserted when they were captured, each bank tile
+   takes a microblock, executes it for --exec-ns ns and asks for the next
+   one, and the block ends every --block-ns ns.  These options take a
+   comma separated list of values, and every combination is run:
+
+     --exec-ns                 Simulated execution time of a microblock
+     --max-txn-per-microblock
+     --vote-fraction
+     --cu-est-history          History of the CU estimation table (see
+                               fd_pack_set_cu_est_tbl), or 0 to run
+                               without one
+
+   A capture doesn't say how many CUs transactions actually consumed, so
+   with an estimation table, each instruction is taken to consume
+   --cu-used-frac of its share of the transaction's CU limit.
+
+   For each run it reports how full blocks got in CUs, the fees (the
+   signature fees plus priority fees) of the transactions scheduled, how
+   close accounts got to the per-account write cost limit, and the CPU
+   time spent inserting and scheduling.  Write cost is counted with the
+   cost model, i.e. with the requested CU limits, so with an estimation
+   table, an account can go past 100% where pack's estimates undercut
+   the limits. */
+
+#include "../fd_ballet.h"
+#include "fd_pack.h"
+#include "fd_pack_cost.h"
+#include "fd_compute_budget_program.h"
+#include "../../util/net/fd_pcap.h"
+#include "../../util/net/fd_pcapng.h"
+#include "../../util/net/fd_ip4.h"
+#include "../../util/net/fd_udp.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BACKTEST_LIST_MAX (16UL)
+
+/* A transaction from the capture.  Its payload is at off in the
+   capture's payload buffer.  fee is what it pays in lamports, cost is
+   its cost under the cost model and instr_cus is the share of its CU
+   limit of each of its instructions other than the compute budget
+   program's. */
+struct backtest_txn {
+  long   ts;
+  ulong  off;
+  ushort sz;
+  ushort is_vote;
+  uint   cost;
+  ulong  fee;
+  uint   instr_cus;
+};
+typedef struct backtest_txn backtest_txn_t;
+
+struct backtest_capture {
+  backtest_txn_t * txn;
+  ulong            txn_cnt;
+  ulong            txn_max;
+  uchar          * payload;
+  ulong            payload_sz;
+  ulong            payload_max;
+  ulong            pkt_cnt;
+  ulong            vote_cnt;
+};
+typedef struct backtest_capture backtest_capture_t;
+
+struct backtest_cfg {
+  ulong depth;
+  ulong bank_cnt;
+  long  block_ns;
+  ulong cus_per_microblock;
+  float cu_used_frac;
+  long  exec_ns;
+  ulong max_txn_per_microblock;
+  float vote_fraction;
+  ulong cu_est_history;
+  int   verbose;
+};
+typedef struct backtest_cfg backtest_cfg_t;
+
+/* Per-block write cost of each account, to find the accounts that
+   approach FD_PACK_MAX_WRITE_COST_PER_ACCT. */
+struct backtest_wcost {
+  fd_acct_addr_t key;
+  ulong          cost;
+};
+typedef struct backtest_wcost backtest_wcost_t;
+
+static const fd_acct_addr_t null_addr = { 0 };
+
+#define MAP_NAME              wcost
+#define MAP_T                 backtest_wcost_t
+#define MAP_KEY_T             fd_acct_addr_t
+#define MAP_KEY_NULL          null_addr
+#define MAP_KEY_INVAL(k)      MAP_KEY_EQUAL(k, null_addr)
+#define MAP_KEY_EQUAL(k0,k1)  (!memcmp((k0).b,(k1).b, FD_TXN_ACCT_ADDR_SZ))
+#define MAP_KEY_EQUAL_IS_SLOW 1
+#define MAP_MEMOIZE           0
+#define MAP_KEY_HASH(key)     ((uint)fd_hash( 0UL, (key).b, FD_TXN_ACCT_ADDR_SZ ))
+#include "../../util/tmpl/fd_map_dynamic.c"
+
+#define WCOST_LG_SLOT_CNT  (20)
+#define CU_EST_BIN_CNT     (4096UL)
+#define MICROBLOCK_MAX_SZ  (USHORT_MAX)
+
+uchar microblock[ MICROBLOCK_MAX_SZ ] __attribute__((aligned(FD_PACK_MICROBLOCK_TXN_ALIGN)));
+
+/* Loading the capture ************************************************/
+
+/* udp_payload finds the UDP payload of the Ethernet frame of pkt_sz
+   bytes at pkt.  Returns the payload and stores its size at *sz, or
+   returns NULL if the frame isn't IPv4/UDP to port (in host order), or
+   to any port if port is 0. */
+static uchar const *
+udp_payload( uchar const * pkt,
+             ulong         pkt_sz,
+             ushort        port,
+             ulong       * sz ) {
+  uchar const * end = pkt+pkt_sz;
+  uchar const * p   = pkt;
+  if( FD_UNLIKELY( pkt_sz<sizeof(fd_eth_hdr_t) ) ) return NULL;
+  ushort net_type = ((fd_eth_hdr_t const *)p)->net_type;
+  p += sizeof(fd_eth_hdr_t);
+  while( net_type==fd_ushort_bswap( FD_ETH_HDR_TYPE_VLAN ) ) {
+    if( FD_UNLIKELY( (ulong)(end-p)<sizeof(fd_vlan_tag_t) ) ) return NULL;
+    net_type = ((fd_vlan_tag_t const *)p)->net_type;
+    p += sizeof(fd_vlan_tag_t);
+  }
+  if( FD_UNLIKELY( net_type!=fd_ushort_bswap( FD_ETH_HDR_TYPE_IP ) ) ) return NULL;
+
+  if( FD_UNLIKELY( (ulong)(end-p)<sizeof(fd_ip4_hdr_t) ) ) return NULL;
+  fd_ip4_hdr_t const * ip4 = (fd_ip4_hdr_t const *)p;
+  ulong ip4_sz = 4UL*(ulong)ip4->ihl;
+  if( FD_UNLIKELY( (ip4->protocol!=FD_IP4_HDR_PROTOCOL_UDP) | (ip4_sz<sizeof(fd_ip4_hdr_t)) ) ) return NULL;
+  if( FD_UNLIKELY( (ulong)(end-p)<ip4_sz+sizeof(fd_udp_hdr_t) ) ) return NULL;
+  p += ip4_sz;
+
+  fd_udp_hdr_t const * udp = (fd_udp_hdr_t const *)p;
+  if( FD_UNLIKELY( port && fd_ushort_bswap( udp->net_dport )!=port ) ) return NULL;
+  ulong udp_sz = (ulong)fd_ushort_bswap( udp->net_len );
+  if( FD_UNLIKELY( (udp_sz<sizeof(fd_udp_hdr_t)) | (udp_sz>(ulong)(end-p)) ) ) return NULL;
+  *sz = udp_sz-sizeof(fd_udp_hdr_t);
+  return p+sizeof(fd_udp_hdr_t);
+}
+
+/* capture_add parses the sz byte payload captured at ts as a
+   transaction and adds it to cap if it is one. */
+static void
+capture_add( backtest_capture_t * cap,
+             uchar const        * payload,
+             ulong                sz,
+             long                 ts ) {
+  cap->pkt_cnt++;
+  if( FD_UNLIKELY( !sz || sz>FD_TPU_MTU ) ) return;
+
+  fd_txn_p_t txnp[1];
+  if( FD_UNLIKELY( !fd_txn_parse( payload, sz, TXN(txnp), NULL ) ) ) return;
+  fd_memcpy( txnp->payload, payload, sz );
+  txnp->payload_sz = sz;
+
+  int   is_vote;
+  ulong cost = fd_pack_compute_cost( txnp, &is_vote, NULL );
+  if( FD_UNLIKELY( !cost ) ) return;
+
+  fd_txn_t * txn = TXN(txnp);
+  fd_acct_addr_t const * addrs = fd_txn_get_acct_addrs( txn, txnp->payload );
+  fd_compute_budget_program_state_t cbp[1];
+  fd_compute_budget_program_init( cbp );
+  ulong other_cnt = 0UL;
+  for( ulong i=0UL; i<(ulong)txn->instr_cnt; i++ ) {
+    if( memcmp( addrs+txn->instr[ i ].program_id, FD_COMPUTE_BUDGET_PROGRAM_ID, FD_TXN_ACCT_ADDR_SZ ) ) { other_cnt++; continue; }
+    if( FD_UNLIKELY( !fd_compute_budget_program_parse( payload+txn->instr[ i ].data_off, txn->instr[ i ].data_sz, cbp ) ) ) return;
+  }
+  ulong rewards;
+  uint  compute_max;
+  fd_compute_budget_program_finalize( cbp, txn->instr_cnt, &rewards, &compute_max );
+
+  if( FD_UNLIKELY( cap->txn_cnt==cap->txn_max ) ) {
+    cap->txn_max = fd_ulong_max( 2UL*cap->txn_max, 4096UL );
+    cap->txn     = (backtest_txn_t *)realloc( cap->txn, cap->txn_max*sizeof(backtest_txn_t) );
+    if( FD_UNLIKELY( !cap->txn ) ) FD_LOG_ERR(( "realloc failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  }
+  if( FD_UNLIKELY( cap->payload_sz+sz>cap->payload_max ) ) {
+    cap->payload_max = fd_ulong_max( 2UL*cap->payload_max, 1UL<<22 );
+    cap->payload     = (uchar *)realloc( cap->payload, cap->payload_max );
+    if( FD_UNLIKELY( !cap->payload ) ) FD_LOG_ERR(( "realloc failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  }
+
+  /* Keep the clock monotonic, in case the capture was merged */
+  if( FD_LIKELY( cap->txn_cnt ) ) ts = fd_long_max( ts, cap->txn[ cap->txn_cnt-1UL ].ts );
+
+  backtest_txn_t * t = cap->txn + cap->txn_cnt++;
+  t->ts        = ts;
+  t->off       = cap->payload_sz;
+  t->sz        = (ushort)sz;
+  t->is_vote   = (ushort)!!is_vote;
+  t->cost      = (uint)cost;
+  t->fee       = FD_PACK_FEE_PER_SIGNATURE*(ulong)txn->signature_cnt + rewards;
+  t->instr_cus = (uint)(compute_max/fd_ulong_max( other_cnt, 1UL ));
+  fd_memcpy( cap->payload+cap->payload_sz, payload, sz );
+  cap->payload_sz += sz;
+  cap->vote_cnt   += (ulong)!!is_vote;
+}
+
+static void
+capture_load( backtest_capture_t * cap,
+              char const         * path,
+              ushort               port ) {
+  FILE * file = fopen( path, "rb" );
+  if( FD_UNLIKELY( !file ) ) FD_LOG_ERR(( "fopen(\"%s\") failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+
+  uint magic;
+  if( FD_UNLIKELY( fread( &magic, sizeof(uint), 1UL, file )!=1UL ) ) FD_LOG_ERR(( "\"%s\" is too short to be a capture", path ));
+  rewind( file );
+
+  ulong sz;
+  if( magic==0x0A0D0D0AU ) { /* pcapng section header block */
+    void * mem = aligned_alloc( fd_pcapng_iter_align(), fd_pcapng_iter_footprint() );
+    if( FD_UNLIKELY( !mem ) ) FD_LOG_ERR(( "aligned_alloc failed" ));
+    fd_pcapng_iter_t * iter = fd_pcapng_iter_new( mem, file );
+    if( FD_UNLIKELY( !iter ) ) FD_LOG_ERR(( "fd_pcapng_iter_new failed" ));
+    fd_pcapng_frame_t const * frame;
+    while( (frame = fd_pcapng_iter_next( iter )) ) {
+      if( FD_UNLIKELY( !fd_pcapng_is_pkt( frame ) ) ) continue;
+      uchar const * payload = udp_payload( frame->data, frame->data_sz, port, &sz );
+      if( FD_LIKELY( payload ) ) capture_add( cap, payload, sz, frame->ts );
+    }
+    if( FD_UNLIKELY( fd_pcapng_iter_err( iter )!=FD_PCAPNG_ITER_EOF ) ) FD_LOG_WARNING(( "stopped reading \"%s\" early", path ));
+    free( fd_pcapng_iter_delete( iter ) );
+  } else {
+    fd_pcap_iter_t * iter = fd_pcap_iter_new( file );
+    if( FD_UNLIKELY( !iter ) ) FD_LOG_ERR(( "\"%s\" is neither a pcap nor a pcapng capture", path ));
+    uchar pkt[ 2048 ];
+    long  ts;
+    ulong pkt_sz;
+    while( (pkt_sz = fd_pcap_iter_next( iter, pkt, sizeof(pkt), &ts )) ) {
+      /* fd_pcap assumes a ns resolution capture, but captures with the
+         classic magic number have us resolution */
+      if( magic==0xa1b2c3d4U ) ts = 1000000000L*(ts/1000000000L) + 1000L*(ts%1000000000L);
+      uchar const * payload = udp_payload( pkt, pkt_sz, port, &sz );
+      if( FD_LIKELY( payload ) ) capture_add( cap, payload, sz, ts );
+    }
+    file = (FILE *)fd_pcap_iter_delete( iter );
+  }
+  if( FD_UNLIKELY( fclose( file ) ) ) FD_LOG_WARNING(( "fclose failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+}
+
+/* Running the simulation *********************************************/
+
+struct backtest_result {
+  ulong  block_cnt;
+  double fill_sum;         /* Sum over blocks of the fraction of FD_PACK_MAX_COST_PER_BLOCK used */
+  ulong  full_block_cnt;   /* Blocks at least 95% full */
+  ulong  txn_scheduled;
+  ulong  vote_scheduled;
+  ulong  fees;
+  ulong  hot_acct_cnt;     /* (block, account) pairs at least 90% of the way to the write cost limit */
+  double max_wcost_frac;
+  long   insert_ns;
+  long   schedule_ns;
+  ulong  microblock_cnt;
+};
+typedef struct backtest_result backtest_result_t;
+
+static void
+end_block( fd_pack_t         * pack,
+           backtest_wcost_t  * wcost_map,
+           ulong             * cus0,
+           backtest_result_t * res,
+           int                 verbose ) {
+  ulong  cus  = fd_pack_metrics( pack )->cus_scheduled - *cus0;
+  double fill = (double)cus/(double)FD_PACK_MAX_COST_PER_BLOCK;
+  *cus0 = fd_pack_metrics( pack )->cus_scheduled;
+
+  ulong  hot = 0UL;
+  double max = 0.0;
+  ulong  slot_cnt = wcost_slot_cnt( wcost_map );
+  for( ulong i=0UL; i<slot_cnt; i++ ) {
+    if( wcost_key_inval( wcost_map[ i ].key ) ) continue;
+    double frac = (double)wcost_map[ i ].cost/(double)FD_PACK_MAX_WRITE_COST_PER_ACCT;
+    hot += (ulong)(frac>=0.9);
+    max  = fd_double_if( frac>max, frac, max );
+  }
+  wcost_clear( wcost_map );
+
+  if( FD_UNLIKELY( verbose ) )
+    FD_LOG_NOTICE(( "block %lu: %lu CUs (%.1f%%), %lu accounts near the write cost limit, hottest at %.1f%%, %lu pending",
+                    res->block_cnt, cus, 100.0*fill, hot, 100.0*max, fd_pack_avail_txn_cnt( pack ) ));
+
+  res->block_cnt++;
+  res->fill_sum       += fill;
+  res->full_block_cnt += (ulong)(fill>=0.95);
+  res->hot_acct_cnt   += hot;
+  res->max_wcost_frac  = fd_double_if( max>res->max_wcost_frac, max, res->max_wcost_frac );
+  fd_pack_end_block( pack );
+}
+
+/* account_microblock accounts for the sz byte microblock just scheduled
+   and, if cu_est is non-NULL, feeds the estimation table as the bank
+   tile would once it executed it. */
+static void
+account_microblock( backtest_capture_t const * cap,
+                    backtest_cfg_t     const * cfg,
+                    uchar const              * mb,
+                    ulong                      txn_cnt,
+                    backtest_wcost_t         * wcost_map,
+                    fd_est_ftbl_t            * cu_est,
+                    backtest_result_t        * res ) {
+  fd_pack_microblock_txn_t const * rec = (fd_pack_microblock_txn_t const *)mb;
+  for( ulong j=0UL; j<txn_cnt; j++, rec=fd_pack_microblock_txn_next( rec ) ) {
+    backtest_txn_t const * t       = cap->txn + rec->meta;
+    uchar const          * payload = fd_pack_microblock_txn_payload( rec );
+    fd_txn_t             * txn     = (fd_txn_t *)fd_pack_microblock_txn_txn( rec ); /* acct iter wants non-const */
+    fd_acct_addr_t const * addrs   = fd_txn_get_acct_addrs( txn, payload );
+
+    res->txn_scheduled++;
+    res->vote_scheduled += (ulong)t->is_vote;
+    res->fees           += t->fee;
+
+    fd_txn_acct_iter_t ctrl[1];
+    for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
+        i=fd_txn_acct_iter_next( i, ctrl ) ) {
+      if( FD_UNLIKELY( wcost_key_inval( addrs[ i ] ) ) ) continue; /* Can't be a map key */
+      backtest_wcost_t * w = wcost_query( wcost_map, addrs[ i ], NULL );
+      if( FD_UNLIKELY( !w ) ) {
+        /* Past 3/4 full, the map gets slow; the rest of the block's new
+           accounts just aren't tracked. */
+        if( FD_UNLIKELY( wcost_key_cnt( wcost_map )>=3UL*wcost_slot_cnt( wcost_map )/4UL ) ) continue;
+        w = wcost_insert( wcost_map, addrs[ i ] );
+        w->cost = 0UL;
+      }
+      w->cost += t->cost;
+    }
+
+    if( FD_LIKELY( cu_est ) ) {
+      uint used = (uint)((float)t->instr_cus*cfg->cu_used_frac);
+      for( ulong i=0UL; i<(ulong)txn->instr_cnt; i++ ) {
+        fd_acct_addr_t const * prog = addrs + txn->instr[ i ].program_id;
+        if( !memcmp( prog, FD_COMPUTE_BUDGET_PROGRAM_ID, FD_TXN_ACCT_ADDR_SZ ) ) continue;
+        fd_est_ftbl_update( cu_est, fd_pack_cu_est_tag( prog ), used );
+      }
+    }
+  }
+}
+
+static backtest_result_t
+run( backtest_capture_t const * cap,
+     backtest_cfg_t     const * cfg ) {
+  backtest_result_t res = {0};
+
+  fd_rng_t _rng[1];
+  fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  ulong  footprint = fd_pack_footprint( cfg->depth, cfg->bank_cnt, cfg->max_txn_per_microblock );
+  if( FD_UNLIKELY( !footprint ) ) FD_LOG_ERR(( "bad pack configuration" ));
+  void * pack_mem  = aligned_alloc( fd_pack_align(), fd_ulong_align_up( footprint, fd_pack_align() ) );
+  if( FD_UNLIKELY( !pack_mem ) ) FD_LOG_ERR(( "aligned_alloc(%lu) failed", footprint ));
+  fd_pack_t * pack = fd_pack_join( fd_pack_new( pack_mem, cfg->depth, cfg->bank_cnt, cfg->max_txn_per_microblock, rng ) );
+  if( FD_UNLIKELY( !pack ) ) FD_LOG_ERR(( "fd_pack_new failed" ));
+
+  fd_est_ftbl_t * cu_est     = NULL;
+  void          * cu_est_mem = NULL;
+  if( cfg->cu_est_history ) {
+    cu_est_mem = aligned_alloc( fd_est_ftbl_align(), fd_ulong_align_up( fd_est_ftbl_footprint( CU_EST_BIN_CNT ), fd_est_ftbl_align() ) );
+    if( FD_UNLIKELY( !cu_est_mem ) ) FD_LOG_ERR(( "aligned_alloc failed" ));
+    cu_est = fd_est_ftbl_join( fd_est_ftbl_new( cu_est_mem, CU_EST_BIN_CNT, cfg->cu_est_history, FD_COMPUTE_BUDGET_DEFAULT_INSTR_CU_LIMIT ) );
+    fd_pack_set_cu_est_tbl( pack, cu_est );
+  }
+
+  void * wcost_mem = aligned_alloc( wcost_align(), fd_ulong_align_up( wcost_footprint( WCOST_LG_SLOT_CNT ), wcost_align() ) );
+  if( FD_UNLIKELY( !wcost_mem ) ) FD_LOG_ERR(( "aligned_alloc failed" ));
+  backtest_wcost_t * wcost_map = wcost_join( wcost_new( wcost_mem, WCOST_LG_SLOT_CNT ) );
+
+  long t0        = cap->txn[ 0 ].ts;
+  long block_end = t0 + cfg->block_ns;
+  long bank_free[ FD_PACK_MAX_BANK_TILES ];
+  for( ulong b=0UL; b<cfg->bank_cnt; b++ ) bank_free[ b ] = t0;
+
+  ulong block_idx = 0UL;
+  ulong cus0      = 0UL;
+  ulong next      = 0UL;
+  for(;;) {
+    ulong bank = 0UL;
+    for( ulong b=1UL; b<cfg->bank_cnt; b++ ) bank = fd_ulong_if( bank_free[ b ]<bank_free[ bank ], b, bank );
+    long arrival = fd_long_if( next<cap->txn_cnt, next<cap->txn_cnt ? cap->txn[ next ].ts : 0L, LONG_MAX );
+
+    if( block_end<=fd_long_min( arrival, bank_free[ bank ] ) ) {
+      /* The block ends before anything else happens */
+      end_block( pack, wcost_map, &cus0, &res, cfg->verbose );
+      block_end += cfg->block_ns;
+      block_idx++;
+      fd_pack_expire_before( pack, block_idx );
+      if( FD_UNLIKELY( next==cap->txn_cnt ) ) break;
+
+    } else if( arrival<=bank_free[ bank ] ) {
+      backtest_txn_t const * t = cap->txn + next;
+      long start = fd_log_wallclock();
+      fd_txn_p_t * slot = fd_pack_insert_txn_init( pack );
+      fd_memcpy( slot->payload, cap->payload+t->off, t->sz );
+      slot->payload_sz = t->sz;
+      slot->meta       = next;
+      fd_txn_parse( slot->payload, t->sz, TXN(slot), NULL );
+      fd_pack_insert_txn_fini( pack, slot, block_idx+150UL );
+      res.insert_ns += fd_log_wallclock() - start;
+      next++;
+
+    } else {
+      long now = bank_free[ bank ];
+      fd_pack_microblock_complete( pack, bank );
+      ulong mb_sz;
+      long start = fd_log_wallclock();
+      ulong txn_cnt = fd_pack_schedule_next_microblock( pack, cfg->cus_per_microblock, cfg->vote_fraction, bank,
+                                                        microblock, sizeof(microblock), &mb_sz );
+      res.schedule_ns += fd_log_wallclock() - start;
+      res.microblock_cnt += (ulong)!!txn_cnt;
+      account_microblock( cap, cfg, microblock, txn_cnt, wcost_map, cu_est, &res );
+      bank_free[ bank ] = now + cfg->exec_ns;
+    }
+  }
+
+  fd_pack_delete( fd_pack_leave( pack ) );
+  free( pack_mem );
+  if( cu_est ) free( fd_est_ftbl_delete( fd_est_ftbl_leave( cu_est ) ) );
+  free( wcost_delete( wcost_leave( wcost_map ) ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+  return res;
+}
+
+/* parse_list parses the comma separated list of numbers in s into out,
+   which has room for BACKTEST_LIST_MAX, and returns how many there
+   were. */
+static ulong
+parse_list( char const * name,
+            char const * s,
+            double     * out ) {
+  ulong cnt = 0UL;
+  for(;;) {
+    if( FD_UNLIKELY( cnt==BACKTEST_LIST_MAX ) ) FD_LOG_ERR(( "%s has more than %lu values", name, BACKTEST_LIST_MAX ));
+    char * end;
+    out[ cnt++ ] = strtod( s, &end );
+    if( FD_UNLIKELY( end==s || (*end!=',' && *end!='\0') ) ) FD_LOG_ERR(( "could not parse %s \"%s\"", name, s ));
+    if( *end=='\0' ) return cnt;
+    s = end+1;
+  }
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * pcap      = fd_env_strip_cmdline_cstr  ( &argc, &argv, "--pcap",                   NULL, NULL                 );
+  ushort       port      = fd_env_strip_cmdline_ushort( &argc, &argv, "--port",                   NULL, (ushort)0            );
+  ulong        depth     = fd_env_strip_cmdline_ulong ( &argc, &argv, "--depth",                  NULL, 32768UL              );
+  ulong        bank_cnt  = fd_env_strip_cmdline_ulong ( &argc, &argv, "--bank-cnt",               NULL, 4UL                  );
+  long         block_ns  = fd_env_strip_cmdline_long  ( &argc, &argv, "--block-ns",               NULL, 400000000L           );
+  ulong        mb_cus    = fd_env_strip_cmdline_ulong ( &argc, &argv, "--cus-per-microblock",     NULL, 1500000UL            );
+  float        used_frac = fd_env_strip_cmdline_float ( &argc, &argv, "--cu-used-frac",           NULL, 0.5f                 );
+  char const * exec_s    = fd_env_strip_cmdline_cstr  ( &argc, &argv, "--exec-ns",                NULL, "2000000"            );
+  char const * max_txn_s = fd_env_strip_cmdline_cstr  ( &argc, &argv, "--max-txn-per-microblock", NULL, "31"                 );
+  char const * vote_s    = fd_env_strip_cmdline_cstr  ( &argc, &argv, "--vote-fraction",          NULL, "0.75"               );
+  char const * hist_s    = fd_env_strip_cmdline_cstr  ( &argc, &argv, "--cu-est-history",         NULL, "0"                  );
+  int          verbose   = fd_env_strip_cmdline_int   ( &argc, &argv, "--verbose",                NULL, 0                    );
+
+  if( FD_UNLIKELY( !pcap ) ) FD_LOG_ERR(( "--pcap not specified" ));
+  if( FD_UNLIKELY( (bank_cnt==0UL) | (bank_cnt>FD_PACK_MAX_BANK_TILES) ) ) FD_LOG_ERR(( "--bank-cnt must be in [1, %lu]", FD_PACK_MAX_BANK_TILES ));
+  if( FD_UNLIKELY( block_ns<=0L ) ) FD_LOG_ERR(( "--block-ns must be positive" ));
+
+  double exec_ns[ BACKTEST_LIST_MAX ]; ulong exec_ns_cnt = parse_list( "--exec-ns",                exec_s,    exec_ns );
+  double max_txn[ BACKTEST_LIST_MAX ]; ulong max_txn_cnt = parse_list( "--max-txn-per-microblock", max_txn_s, max_txn );
+  double vote   [ BACKTEST_LIST_MAX ]; ulong vote_cnt    = parse_list( "--vote-fraction",          vote_s,    vote    );
+  double hist   [ BACKTEST_LIST_MAX ]; ulong hist_cnt    = parse_list( "--cu-est-history",         hist_s,    hist    );
+
+  backtest_capture_t cap[1] = {{0}};
+  capture_load( cap, pcap, port );
+  if( FD_UNLIKELY( !cap->txn_cnt ) ) FD_LOG_ERR(( "no transactions in %lu packets of \"%s\"", cap->pkt_cnt, pcap ));
+  long span = cap->txn[ cap->txn_cnt-1UL ].ts - cap->txn[ 0 ].ts;
+  FD_LOG_NOTICE(( "loaded %lu transactions (%lu votes) from %lu packets spanning %.3f s",
+                  cap->txn_cnt, cap->vote_cnt, cap->pkt_cnt, 1e-9*(double)span ));
+
+  for( ulong e=0UL; e<exec_ns_cnt; e++ )
+  for( ulong m=0UL; m<max_txn_cnt; m++ )
+  for( ulong v=0UL; v<vote_cnt;    v++ )
+  for( ulong h=0UL; h<hist_cnt;    h++ ) {
+    backtest_cfg_t cfg = {
+      .depth                  = depth,
+      .bank_cnt               = bank_cnt,
+      .block_ns               = block_ns,
+      .cus_per_microblock     = mb_cus,
+      .cu_used_frac           = used_frac,
+      .exec_ns                = (long)exec_ns[ e ],
+      .max_txn_per_microblock = (ulong)max_txn[ m ],
+      .vote_fraction          = (float)vote[ v ],
+      .cu_est_history         = (ulong)hist[ h ],
+      .verbose                = verbose,
+    };
+    if( FD_UNLIKELY( cfg.exec_ns<=0L ) ) FD_LOG_ERR(( "--exec-ns must be positive" ));
+
+    backtest_result_t res = run( cap, &cfg );
+    ulong blocks = fd_ulong_max( res.block_cnt, 1UL );
+    FD_LOG_NOTICE(( "exec %li ns, max txn/microblock %lu, vote fraction %.2f, CU est history %lu: "
+                    "%lu blocks %.1f%% full on average (%lu at least 95%%), %lu of %lu txns scheduled (%lu votes), "
+                    "%lu lamports in fees, %lu accounts near the write cost limit (hottest at %.1f%%), "
+                    "%lu microblocks, insert %.3f ms (%.1f ns/txn), schedule %.3f ms (%.1f ns/txn)",
+                    cfg.exec_ns, cfg.max_txn_per_microblock, (double)cfg.vote_fraction, cfg.cu_est_history,
+                    res.block_cnt, 100.0*res.fill_sum/(double)blocks, res.full_block_cnt,
+                    res.txn_scheduled, cap->txn_cnt, res.vote_scheduled,
+                    res.fees, res.hot_acct_cnt, 100.0*res.max_wcost_frac,
+                    res.microblock_cnt,
+                    1e-6*(double)res.insert_ns,   (double)res.insert_ns  /(double)cap->txn_cnt,
+                    1e-6*(double)res.schedule_ns, (double)res.schedule_ns/(double)fd_ulong_max( res.txn_scheduled, 1UL ) ));
+  }
+
+  free( cap->txn );
+  free( cap->payload );
+  fd_halt();
+  return 0;
+}
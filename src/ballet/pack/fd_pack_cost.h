@@ -144,11 +144,14 @@ static const ulong FD_PACK_TYPICAL_VOTE_COST = ( COST_PER_SIGNATURE
    transaction is a Simple Vote transaction.  On success, returns the
    cost, which is in [1020, FD_PACK_MAX_COST] and sets the value pointed to by
    is_simple_vote to nonzero/zero depending on if it is a simple vote
-   transaction.  On failure, returns 0 and does not modify the value
-   pointed to by is_simple_vote. */
+   transaction.  If opt_non_builtin_cost is non-NULL, it is also set to
+   the part of the cost that comes from the CU limit of non-built-in
+   instructions.  On failure, returns 0 and does not modify the values
+   pointed to by is_simple_vote or opt_non_builtin_cost. */
 static inline ulong
 fd_pack_compute_cost( fd_txn_p_t * txnp,
-                      int        * is_simple_vote ) {
+                      int        * is_simple_vote,
+                      ulong      * opt_non_builtin_cost ) {
   fd_txn_t * txn = TXN(txnp);
 
   const uchar compute_budget_prog_id[FD_TXN_ACCT_ADDR_SZ] = { COMPUTE_BUDGET_PROG_ID };
@@ -210,6 +213,7 @@ fd_pack_compute_cost( fd_txn_p_t * txnp,
 
 
   *is_simple_vote = (vote_instr_cnt==1UL) & (txn->instr_cnt==1UL);
+  if( opt_non_builtin_cost ) *opt_non_builtin_cost = non_builtin_cost;
 
   /* <= FD_PACK_MAX_COST, so no overflow concerns */
   return signature_cost + writable_cost + builtin_cost + instr_data_cost + non_builtin_cost;
@@ -0,0 +1,88 @@
+#include "fd_balance_tbl.h"
+
+#define SLOT_CNT 64UL
+static uchar scratch[ FD_BALANCE_TBL_FOOTPRINT( SLOT_CNT ) ] __attribute__((aligned(FD_BALANCE_TBL_ALIGN)));
+
+#define WRITER_UPDATE_CNT (1000000UL)
+
+static fd_balance_tbl_t * shared_tbl;
+
+static fd_acct_addr_t
+acct( ulong i ) {
+  fd_acct_addr_t a;
+  memset( a.b, 'A', FD_TXN_ACCT_ADDR_SZ );
+  FD_STORE( ulong, a.b+8, i );
+  return a;
+}
+
+/* The writer keeps setting every account's balance to a value that
+   encodes the account, so a torn read would show up as a mismatch. */
+static int
+writer_main( int     argc,
+             char ** argv ) {
+  (void)argc; (void)argv;
+  for( ulong i=0UL; i<WRITER_UPDATE_CNT; i++ ) {
+    fd_acct_addr_t a = acct( i%(SLOT_CNT/2UL) );
+    FD_TEST( fd_balance_tbl_update( shared_tbl, &a, ((i%(SLOT_CNT/2UL))<<32) | (i & 0xFFFFFFFFUL) ) );
+  }
+  return 0;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  FD_TEST( fd_balance_tbl_align( ) == FD_BALANCE_TBL_ALIGN );
+  FD_TEST( fd_balance_tbl_footprint( SLOT_CNT ) == sizeof(scratch) );
+  FD_TEST( !fd_balance_tbl_footprint( 0UL ) );
+  FD_TEST( !fd_balance_tbl_footprint( 3UL ) );
+  FD_TEST( !fd_balance_tbl_new( scratch, 3UL ) );
+
+  fd_balance_tbl_t * tbl = fd_balance_tbl_join( fd_balance_tbl_new( scratch, SLOT_CNT ) ); FD_TEST( tbl );
+
+  ulong lamports = 0UL;
+  for( ulong i=0UL; i<SLOT_CNT; i++ ) { fd_acct_addr_t a = acct( i ); FD_TEST( !fd_balance_tbl_query( tbl, &a, &lamports ) ); }
+
+  FD_LOG_NOTICE(( "testing updates" ));
+  for( ulong i=0UL; i<SLOT_CNT; i++ ) { fd_acct_addr_t a = acct( i ); FD_TEST( fd_balance_tbl_update( tbl, &a, 1000UL*i ) ); }
+  for( ulong i=0UL; i<SLOT_CNT; i++ ) {
+    fd_acct_addr_t a = acct( i );
+    FD_TEST( fd_balance_tbl_query( tbl, &a, &lamports ) ); FD_TEST( lamports==1000UL*i );
+    FD_TEST( fd_balance_tbl_update( tbl, &a, 7UL*i ) );
+  }
+  for( ulong i=0UL; i<SLOT_CNT; i++ ) { fd_acct_addr_t a = acct( i ); FD_TEST( fd_balance_tbl_query( tbl, &a, &lamports ) ); FD_TEST( lamports==7UL*i ); }
+
+  FD_LOG_NOTICE(( "testing full table" ));
+  fd_acct_addr_t extra = acct( SLOT_CNT );
+  FD_TEST( !fd_balance_tbl_update( tbl, &extra, 1UL ) );
+  FD_TEST( !fd_balance_tbl_query ( tbl, &extra, &lamports ) );
+
+  FD_LOG_NOTICE(( "testing clear" ));
+  fd_balance_tbl_clear( tbl );
+  for( ulong i=0UL; i<SLOT_CNT; i++ ) { fd_acct_addr_t a = acct( i ); FD_TEST( !fd_balance_tbl_query( tbl, &a, &lamports ) ); }
+  FD_TEST( fd_balance_tbl_update( tbl, &extra, 1UL ) );
+  FD_TEST( fd_balance_tbl_query ( tbl, &extra, &lamports ) ); FD_TEST( lamports==1UL );
+
+  ulong tile_cnt = fd_tile_cnt();
+  if( tile_cnt>1UL ) {
+    FD_LOG_NOTICE(( "testing concurrent queries while updating" ));
+    fd_balance_tbl_clear( tbl );
+    shared_tbl = tbl;
+    FD_TEST( fd_tile_exec_new( 1UL, writer_main, 0, NULL ) );
+    for( ulong i=0UL; i<WRITER_UPDATE_CNT; i++ ) {
+      ulong          k = i%(SLOT_CNT/2UL);
+      fd_acct_addr_t a = acct( k );
+      if( fd_balance_tbl_query( tbl, &a, &lamports ) ) FD_TEST( (lamports>>32)==k );
+    }
+    fd_tile_exec_delete( fd_tile_exec( 1UL ), NULL );
+  } else {
+    FD_LOG_NOTICE(( "skipping concurrency test (needs --tile-cpus with more than one tile)" ));
+  }
+
+  fd_balance_tbl_delete( fd_balance_tbl_leave( tbl ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
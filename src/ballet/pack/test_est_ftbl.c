@@ -0,0 +1,111 @@
+#include <math.h>
+#include "fd_est_ftbl.h"
+
+#define TBL_SZ 8UL
+static uchar scratch[ FD_EST_FTBL_FOOTPRINT( TBL_SZ ) ] __attribute__((aligned(FD_EST_FTBL_ALIGN)));
+
+#define WRITER_UPDATE_CNT (100000UL)
+
+static fd_est_ftbl_t * shared_tbl;
+
+/* Each writer tile inserts WRITER_UPDATE_CNT copies of the same value
+   into bin 0.  If updates were lost or torn, the denominator wouldn't
+   add up and the mean would drift from the value. */
+static int
+writer_main( int     argc,
+             char ** argv ) {
+  (void)argc; (void)argv;
+  for( ulong i=0UL; i<WRITER_UPDATE_CNT; i++ ) fd_est_ftbl_update( shared_tbl, 0UL, 1000U );
+  return 0;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  FD_TEST( fd_est_ftbl_align( ) == FD_EST_FTBL_ALIGN );
+  FD_TEST( fd_est_ftbl_footprint( TBL_SZ ) == sizeof(scratch) );
+  FD_TEST( !fd_est_ftbl_footprint( 3UL ) );
+  FD_TEST( !fd_est_ftbl_new( scratch, TBL_SZ, 0UL, 1U ) );
+
+  const uint default_val = 1234;
+  void *          _tbl = fd_est_ftbl_new( scratch, TBL_SZ, 1000UL, default_val ); FD_TEST( _tbl );
+  fd_est_ftbl_t *  tbl = fd_est_ftbl_join( _tbl );                                FD_TEST(  tbl );
+  float out_var = 1.0f;
+  FD_LOG_NOTICE(( "testing empty query gives default value" )); /* in bin 0 */
+  FD_TEST( fd_est_ftbl_estimate( tbl, 0UL, &out_var ) == (float)default_val );
+  FD_TEST( out_var == 0.0f );
+  for( uint i=0U; i<9U; i++ ) {
+    fd_est_ftbl_update( tbl, 0UL, i );
+    out_var = 1.0f;
+    FD_TEST( fd_est_ftbl_estimate( tbl, 0UL, &out_var ) < 9.0f );
+  }
+  FD_TEST( fd_est_ftbl_estimate( tbl, 0UL, &out_var ) < 5.0f );
+
+  FD_LOG_NOTICE(( "testing single entry normal distribution" )); /* in bin 1 */
+  for( ulong i=0UL; i<2000UL; i++ ) {
+    /* Distribution is N(mu=1000, sigma=100) */
+    double val = 1000.5 + 100.0*fd_rng_double_norm( rng );
+    fd_est_ftbl_update( tbl, 1UL, (uint)val );
+  }
+  double mean = (double)fd_est_ftbl_estimate( tbl, 1UL, &out_var );
+  double var  = (double)out_var;
+  double stdev_mean = 1.0 / sqrt( 1000.0 );
+  mean -= 1000.0;
+  var  *= 1.0/(100.0*100.0);
+  FD_TEST( (-6.0*100.0*stdev_mean < mean) & (mean < 6.0*100.0*stdev_mean) );
+  FD_TEST( (0.9 < var) & (var < 1.1) );
+  FD_LOG_NOTICE(( "pass. mean=%f, var=%f", mean, var ));
+
+  FD_LOG_NOTICE(( "testing exponential distribution" )); /* in bin 2 */
+  for( ulong i=0UL; i<6000UL; i++ ) {
+    fd_est_ftbl_update( tbl, 2UL, (uint)( 0.5 + 500.0*fd_rng_double_exp( rng ) ) );
+  }
+  mean = (double)fd_est_ftbl_estimate( tbl, 2UL, &out_var ) * (1.0/500.0);
+  var  = (double)out_var * (1.0/(500.0*500.0));
+  FD_TEST( (1.0-6.0*stdev_mean < mean) & (mean < 1.0+6.0*stdev_mean) );
+  FD_TEST( (0.9 < var) & (var < 1.1) );
+  FD_LOG_NOTICE(( "pass. mean=%f, var=%f", mean, var ));
+
+  FD_LOG_NOTICE(( "testing large values" )); /* in bin 3 */
+  for( ulong i=0UL; i<10000UL; i++ ) fd_est_ftbl_update( tbl, 3UL, UINT_MAX );
+  mean = (double)fd_est_ftbl_estimate( tbl, 3UL, &out_var );
+  FD_TEST( fabs( mean/(double)UINT_MAX - 1.0 ) < 1e-3 );
+  FD_TEST( isfinite( out_var ) );
+
+  ulong tile_cnt = fd_tile_cnt();
+  if( FD_EST_FTBL_ATOMIC && tile_cnt>1UL ) {
+    FD_LOG_NOTICE(( "testing concurrent updates from %lu tiles", tile_cnt-1UL ));
+    fd_est_ftbl_delete( fd_est_ftbl_leave( tbl ) );
+    /* A long history so the denominator keeps growing */
+    shared_tbl = fd_est_ftbl_join( fd_est_ftbl_new( scratch, TBL_SZ, 1000000000UL, default_val ) );
+
+    for( ulong i=1UL; i<tile_cnt; i++ ) FD_TEST( fd_tile_exec_new( i, writer_main, 0, NULL ) );
+    /* Query while the writers are running.  Every snapshot is a
+       complete update, so the mean is always the value written. */
+    for( ulong i=0UL; i<WRITER_UPDATE_CNT; i++ ) {
+      float m = fd_est_ftbl_estimate( shared_tbl, 0UL, NULL );
+      FD_TEST( (m==(float)default_val) | (fabsf( m-1000.0f )<1.0f) );
+    }
+    for( ulong i=1UL; i<tile_cnt; i++ ) fd_tile_exec_delete( fd_tile_exec( i ), NULL );
+
+    /* d = sum_{k<n} C^k, which is within 1% of n for this history */
+    float  d = shared_tbl->bins[0].d;
+    double n = (double)((tile_cnt-1UL)*WRITER_UPDATE_CNT);
+    FD_LOG_NOTICE(( "d=%f, expected %f", (double)d, n ));
+    FD_TEST( fabs( (double)d/n - 1.0 ) < 0.01 );
+    tbl = shared_tbl;
+  } else {
+    FD_LOG_NOTICE(( "skipping concurrency test (needs atomic updates and --tile-cpus with more than one tile)" ));
+  }
+
+  fd_est_ftbl_delete( fd_est_ftbl_leave( tbl ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
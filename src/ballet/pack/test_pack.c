@@ -16,6 +16,16 @@ ulong payload_sz[ MAX_TEST_TXNS ];
 #define PACK_SCRATCH_SZ (128UL*1024UL*1024UL)
 uchar pack_scratch[ PACK_SCRATCH_SZ ] __attribute__((aligned(128)));
 
+#define ALT_CACHE_ENTRY_CNT (4UL)
+uchar alt_cache_scratch[ FD_ALT_CACHE_FOOTPRINT( ALT_CACHE_ENTRY_CNT ) ] __attribute__((aligned(FD_ALT_CACHE_ALIGN)));
+
+#define BALANCE_TBL_SLOT_CNT (16UL)
+uchar balance_tbl_scratch[ FD_BALANCE_TBL_FOOTPRINT( BALANCE_TBL_SLOT_CNT ) ] __attribute__((aligned(FD_BALANCE_TBL_ALIGN)));
+
+uchar fee_stats_scratch[ FD_FEE_STATS_FOOTPRINT ] __attribute__((aligned(FD_FEE_STATS_ALIGN)));
+
+uchar shard_ctl_scratch[ FD_PACK_SHARD_CTL_FOOTPRINT ] __attribute__((aligned(FD_PACK_SHARD_CTL_ALIGN)));
+
 
 const char SIGNATURE_SUFFIX[ FD_TXN_SIGNATURE_SZ - sizeof(ulong) - sizeof(uint) ] = ": this is the fake signature of transaction number ";
 const char WORK_PROGRAM_ID[ FD_TXN_ACCT_ADDR_SZ ] = "Work Program Id Consumes 1<<j CU";
@@ -28,9 +38,10 @@ fd_rng_t * rng;
 
 struct pack_outcome {
   ulong microblock_cnt;
-  aset_t  r_accts_in_use[ FD_PACK_MAX_GAP ];
-  aset_t  w_accts_in_use[ FD_PACK_MAX_GAP ];
-  fd_txn_p_t results[1024];
+  aset_t  r_accts_in_use[ FD_PACK_MAX_BANK_TILES ];
+  aset_t  w_accts_in_use[ FD_PACK_MAX_BANK_TILES ];
+  ulong results_sz;
+  uchar results[ 1024UL*FD_PACK_MICROBLOCK_TXN_MAX_SZ ] __attribute__((aligned(FD_PACK_MICROBLOCK_TXN_ALIGN)));
 };
 typedef struct pack_outcome pack_outcome_t;
 
@@ -39,21 +50,20 @@ pack_outcome_t outcome;
 
 static fd_pack_t *
 init_all( ulong pack_depth,
-          ulong gap,
+          ulong bank_tile_cnt,
           ulong max_txn_per_microblock,
           pack_outcome_t * outcome     ) {
-  ulong footprint = fd_pack_footprint( pack_depth, gap, max_txn_per_microblock );
+  ulong footprint = fd_pack_footprint( pack_depth, bank_tile_cnt, max_txn_per_microblock );
 
   if( footprint>PACK_SCRATCH_SZ ) FD_LOG_ERR(( "Test required %lu bytes, but scratch was only %lu", footprint, PACK_SCRATCH_SZ ));
 #if DETAILED_STATUS_MESSAGES
   else                         FD_LOG_NOTICE(( "Test required %lu bytes of %lu available bytes",    footprint, PACK_SCRATCH_SZ ));
 #endif
 
-  fd_pack_t * pack = fd_pack_join( fd_pack_new( pack_scratch, pack_depth, gap, max_txn_per_microblock, rng ) );
-#define MAX_BANKING_THREADS 64
+  fd_pack_t * pack = fd_pack_join( fd_pack_new( pack_scratch, pack_depth, bank_tile_cnt, max_txn_per_microblock, rng ) );
 
   outcome->microblock_cnt = 0UL;
-  for( ulong i=0UL; i<FD_PACK_MAX_GAP; i++ ) {
+  for( ulong i=0UL; i<FD_PACK_MAX_BANK_TILES; i++ ) {
     outcome->r_accts_in_use[ i ] = aset_null( );
     outcome->w_accts_in_use[ i ] = aset_null( );
   }
@@ -159,6 +169,7 @@ make_vote_transaction( ulong i ) {
   uchar * p = payload_scratch[ i ];
 
   fd_memcpy( p, sample_vote, sample_vote_sz );
+  payload_sz[ i ] = sample_vote_sz;
   /* Make signature and the two writable accounts unique */
   p[ 0x01+(i%8) ] = (uchar)(p[ 0x01+(i%8) ] + 1UL + (i/8));
   p[ 0x45+(i%8) ] = (uchar)(p[ 0x45+(i%8) ] + 1UL + (i/8));
@@ -166,15 +177,66 @@ make_vote_transaction( ulong i ) {
   fd_txn_parse( p, sample_vote_sz, txn_scratch[i], NULL );
 }
 
+/* Turns the transaction made by make_transaction( i, ... ) into a v0
+   transaction that also writes the accounts at the w_cnt indices in w
+   and reads the accounts at the r_cnt indices in r of the address
+   lookup table whose address is table repeated. */
+static void
+add_lookup( ulong         i,
+            char          table,
+            uchar const * w,
+            ulong         w_cnt,
+            uchar const * r,
+            ulong         r_cnt ) {
+  uchar    * p_base = payload_scratch[ i ];
+  uchar    * p      = p_base + payload_sz[ i ];
+  fd_txn_t * t      = (fd_txn_t*) txn_scratch[ i ];
+
+  t->transaction_version          = FD_TXN_V0;
+  t->addr_table_lookup_cnt        = 1;
+  t->addr_table_adtl_writable_cnt = (uchar)w_cnt;
+  t->addr_table_adtl_cnt          = (uchar)(w_cnt+r_cnt);
+
+  fd_txn_acct_addr_lut_t * lut = fd_txn_get_address_tables( t );
+  lut->addr_off     = (ushort)(p - p_base); memset( p, table, FD_TXN_ACCT_ADDR_SZ ); p += FD_TXN_ACCT_ADDR_SZ;
+  lut->writable_cnt = (uchar)w_cnt;
+  lut->writable_off = (ushort)(p - p_base); fd_memcpy( p, w, w_cnt );                p += w_cnt;
+  lut->readonly_cnt = (uchar)r_cnt;
+  lut->readonly_off = (ushort)(p - p_base); fd_memcpy( p, r, r_cnt );                p += r_cnt;
+
+  payload_sz[ i ] = (ulong)(p-p_base);
+}
+
 static void
-insert( ulong i,
-        fd_pack_t * pack ) {
+insert_expiring( ulong i,
+                 fd_pack_t * pack,
+                 ulong expires_at ) {
   fd_txn_p_t * slot       = fd_pack_insert_txn_init( pack );
   fd_txn_t *   txn        = (fd_txn_t*) txn_scratch[ i ];
   fd_memcpy( slot->payload, payload_scratch[ i ], payload_sz[ i ] );
+  slot->payload_sz = payload_sz[ i ];
   fd_memcpy( TXN(slot),     txn,     fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
 
-  fd_pack_insert_txn_fini( pack, slot );
+  fd_pack_insert_txn_fini( pack, slot, expires_at );
+}
+
+static void insert( ulong i, fd_pack_t * pack ) { insert_expiring( i, pack, ULONG_MAX ); }
+
+/* Inserts the transactions in txn_scratch[ idx[ j ] ] for j in [0, cnt)
+   as a bundle. */
+static void
+insert_bundle( ulong const * idx,
+               ulong         cnt,
+               fd_pack_t   * pack ) {
+  fd_txn_p_t * bundle[ FD_PACK_MAX_TXN_PER_BUNDLE ];
+  FD_TEST( fd_pack_insert_bundle_init( pack, bundle, cnt )==bundle );
+  for( ulong j=0UL; j<cnt; j++ ) {
+    fd_txn_t * txn = (fd_txn_t*) txn_scratch[ idx[ j ] ];
+    fd_memcpy( bundle[ j ]->payload, payload_scratch[ idx[ j ] ], payload_sz[ idx[ j ] ] );
+    bundle[ j ]->payload_sz = payload_sz[ idx[ j ] ];
+    fd_memcpy( TXN(bundle[ j ]), txn, fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
+  }
+  fd_pack_insert_bundle_fini( pack, bundle, cnt, ULONG_MAX );
 }
 
 
@@ -185,18 +247,22 @@ schedule_validate_microblock( fd_pack_t * pack,
                               float vote_fraction,
                               ulong min_txns,
                               ulong min_rewards,
+                              ulong bank_tile,
                               pack_outcome_t * outcome ) {
 
   ulong pre_txn_cnt  = fd_pack_avail_txn_cnt( pack );
-  ulong txn_cnt = fd_pack_schedule_next_microblock( pack, total_cus, vote_fraction, outcome->results );
+  ulong pre_dropped  = fd_pack_metrics( pack )->unaffordable_cnt;
+  ulong txn_cnt = fd_pack_schedule_next_microblock( pack, total_cus, vote_fraction, bank_tile,
+                                                    outcome->results, sizeof(outcome->results), &outcome->results_sz );
   ulong post_txn_cnt = fd_pack_avail_txn_cnt( pack );
+  ulong dropped      = fd_pack_metrics( pack )->unaffordable_cnt - pre_dropped;
 
 #if DETAILED_STATUS_MESSAGES
   FD_LOG_NOTICE(( "Scheduling microblock. %lu avail -> %lu avail. %lu scheduled", pre_txn_cnt, post_txn_cnt, txn_cnt ));
 #endif
 
   FD_TEST( txn_cnt >= min_txns );
-  FD_TEST( pre_txn_cnt-post_txn_cnt == txn_cnt );
+  FD_TEST( pre_txn_cnt-post_txn_cnt == txn_cnt+dropped );
 
   ulong total_rewards = 0UL;
 
@@ -204,9 +270,11 @@ schedule_validate_microblock( fd_pack_t * pack,
   aset_t  read_accts = aset_null( );
   aset_t write_accts = aset_null( );
 
+  fd_pack_microblock_txn_t const * rec = (fd_pack_microblock_txn_t const *)outcome->results;
   for( ulong i=0UL; i<txn_cnt; i++ ) {
-    fd_txn_p_t * txnp = outcome->results+i;
-    fd_txn_t   * txn  = TXN(txnp);
+    uchar    const * payload = fd_pack_microblock_txn_payload( rec );
+    fd_txn_t       * txn     = (fd_txn_t *)fd_pack_microblock_txn_txn( rec ); /* acct iter wants non-const */
+    FD_TEST( rec->rec_sz==fd_pack_microblock_txn_sz( rec->payload_sz, fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) ) );
 
     fd_compute_budget_program_state_t cbp;
     fd_compute_budget_program_init( &cbp );
@@ -215,13 +283,13 @@ schedule_validate_microblock( fd_pack_t * pack,
     uint compute = 0U;
     if( FD_LIKELY( txn->instr_cnt>1UL ) ) {
       fd_txn_instr_t ix = txn->instr[0]; /* For these transactions, the compute budget instr is always the 1st */
-      FD_TEST( fd_compute_budget_program_parse( txnp->payload + ix.data_off, ix.data_sz, &cbp ) );
+      FD_TEST( fd_compute_budget_program_parse( payload + ix.data_off, ix.data_sz, &cbp ) );
       fd_compute_budget_program_finalize( &cbp, txn->instr_cnt, &rewards, &compute );
     } /* else it's a vote */
 
     total_rewards += rewards;
 
-    fd_acct_addr_t const * acct = fd_txn_get_acct_addrs( txn, txnp->payload );
+    fd_acct_addr_t const * acct = fd_txn_get_acct_addrs( txn, payload );
     fd_txn_acct_iter_t ctrl[1];
     for( ulong j=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE_NONSIGNER_IMM, ctrl ); j<fd_txn_acct_iter_end();
         j = fd_txn_acct_iter_next( j, ctrl ) ) {
@@ -237,27 +305,55 @@ schedule_validate_microblock( fd_pack_t * pack,
       if( (0x30UL<=b0) & (b0<0x70UL) & (b0==b1) )
         read_accts = aset_insert( read_accts, (ulong)b0-0x30UL );
     }
+
+    rec = fd_pack_microblock_txn_next( rec );
   }
+  FD_TEST( (ulong)((uchar const *)rec - outcome->results)==outcome->results_sz );
 
   FD_TEST( total_rewards >= min_rewards );
 
   FD_TEST( aset_is_null( aset_intersect( read_accts, write_accts ) ) );
 
-  /* Check for conflict with gap back */
-  for( ulong i=1UL; i<fd_ulong_min( outcome->microblock_cnt, fd_pack_gap( pack ) ); i++ ) {
-    ulong mb = (outcome->microblock_cnt - i) % FD_PACK_MAX_GAP;
+  /* Check for conflict with the outstanding microblocks of the other
+     bank tiles */
+  for( ulong i=0UL; i<fd_pack_bank_tile_cnt( pack ); i++ ) {
+    if( i==bank_tile ) continue;
 
-    FD_TEST( aset_is_null( aset_intersect( write_accts, outcome->r_accts_in_use[ mb ] ) ) );
-    FD_TEST( aset_is_null( aset_intersect( write_accts, outcome->w_accts_in_use[ mb ] ) ) );
-    FD_TEST( aset_is_null( aset_intersect( read_accts,  outcome->w_accts_in_use[ mb ] ) ) );
+    FD_TEST( aset_is_null( aset_intersect( write_accts, outcome->r_accts_in_use[ i ] ) ) );
+    FD_TEST( aset_is_null( aset_intersect( write_accts, outcome->w_accts_in_use[ i ] ) ) );
+    FD_TEST( aset_is_null( aset_intersect( read_accts,  outcome->w_accts_in_use[ i ] ) ) );
+  }
+  if( txn_cnt ) {
+    outcome->r_accts_in_use[ bank_tile ] =  read_accts;
+    outcome->w_accts_in_use[ bank_tile ] = write_accts;
   }
-  ulong mb = outcome->microblock_cnt % FD_PACK_MAX_GAP;
-  outcome->r_accts_in_use[ mb ] =  read_accts;
-  outcome->w_accts_in_use[ mb ] = write_accts;
 
   outcome->microblock_cnt++;
 }
 
+/* Tells pack that bank_tile finished executing its outstanding
+   microblock. */
+static void
+complete( fd_pack_t      * pack,
+          ulong            bank_tile,
+          pack_outcome_t * outcome ) {
+  fd_pack_microblock_complete( pack, bank_tile );
+  outcome->r_accts_in_use[ bank_tile ] = aset_null( );
+  outcome->w_accts_in_use[ bank_tile ] = aset_null( );
+}
+
+/* Schedules a microblock on bank tile 0 and immediately completes it. */
+static void
+schedule_validate_complete( fd_pack_t * pack,
+                            ulong total_cus,
+                            float vote_fraction,
+                            ulong min_txns,
+                            ulong min_rewards,
+                            pack_outcome_t * outcome ) {
+  schedule_validate_microblock( pack, total_cus, vote_fraction, min_txns, min_rewards, 0UL, outcome );
+  complete( pack, 0UL, outcome );
+}
+
 void test0( void ) {
   FD_LOG_NOTICE(( "TEST 0" ));
   fd_pack_t * pack = init_all( 128UL, 3UL, 128UL, &outcome );
@@ -266,12 +362,14 @@ void test0( void ) {
   rewards += make_transaction( i,  500U, 11.0, "A",    "B" ); insert( i++, pack );
   rewards += make_transaction( i,  500U, 10.0, "C",    "D" ); insert( i++, pack );
   rewards += make_transaction( i,  800U, 10.0, "EFGH", "D" ); insert( i++, pack );
-  schedule_validate_microblock( pack, 30000UL, 0.0f, 3UL, rewards, &outcome );
+  schedule_validate_microblock( pack, 30000UL, 0.0f, 3UL, rewards, 0UL, &outcome );
 
   make_transaction( i,  500U, 10.0, "D", "I" );    insert( i++, pack );
-  schedule_validate_microblock( pack, 30000UL, 0.0f, 0UL, 0UL, &outcome ); /* Can't schedule due to gap */
-  schedule_validate_microblock( pack, 30000UL, 0.0f, 0UL, 0UL, &outcome ); /* Can't schedule due to gap */
-  schedule_validate_microblock( pack, 30000UL, 0.0f, 1UL, 0UL, &outcome ); /* Gap ended */
+  schedule_validate_microblock( pack, 30000UL, 0.0f, 0UL, 0UL, 0UL, &outcome ); /* Bank 0 is still busy */
+  schedule_validate_microblock( pack, 30000UL, 0.0f, 0UL, 0UL, 1UL, &outcome ); /* D is read by bank 0 */
+  schedule_validate_microblock( pack, 30000UL, 0.0f, 0UL, 0UL, 2UL, &outcome ); /* D is read by bank 0 */
+  complete( pack, 0UL, &outcome );
+  schedule_validate_microblock( pack, 30000UL, 0.0f, 1UL, 0UL, 2UL, &outcome ); /* Lock released */
 }
 
 /* The original two that broke my first algorithm */
@@ -281,8 +379,8 @@ void test1( void ) {
   ulong i = 0;
   ulong reward1 = make_transaction( i,  500U, 11.0, "A", "B" ); insert( i++, pack );
   ulong reward2 = make_transaction( i,  500U, 10.0, "B", "A" ); insert( i++, pack );
-  schedule_validate_microblock( pack, 30000UL, 0.0f, 1UL, reward1, &outcome );
-  schedule_validate_microblock( pack, 30000UL, 0.0f, 1UL, reward2, &outcome );
+  schedule_validate_complete( pack, 30000UL, 0.0f, 1UL, reward1, &outcome );
+  schedule_validate_complete( pack, 30000UL, 0.0f, 1UL, reward2, &outcome );
 }
 
 void test2( void ) {
@@ -294,8 +392,8 @@ void test2( void ) {
   ulong r1 = make_transaction( i,  500U, j--, "C", "B" ); insert( i++, pack );
   ulong r2 = make_transaction( i,  500U, j--, "D", "C" ); insert( i++, pack );
   ulong r3 = make_transaction( i,  500U, j--, "A", "D" ); insert( i++, pack );
-  schedule_validate_microblock( pack, 30000UL, 0.0f, 2UL, r0+r2, &outcome );
-  schedule_validate_microblock( pack, 30000UL, 0.0f, 2UL, r1+r3, &outcome );
+  schedule_validate_complete( pack, 30000UL, 0.0f, 2UL, r0+r2, &outcome );
+  schedule_validate_complete( pack, 30000UL, 0.0f, 2UL, r1+r3, &outcome );
 
   /* A smart scheduler that allows read bypass could schedule the first 3 at
      the same time then #4 after they all finish. */
@@ -312,16 +410,111 @@ void test_vote( void ) {
   make_vote_transaction( i ); insert( i++, pack );
 
   FD_TEST( fd_pack_avail_txn_cnt( pack ) == 4UL );
-  schedule_validate_microblock( pack, 30000UL, 0.0f, 0UL, 0UL, &outcome );
+  schedule_validate_complete( pack, 30000UL, 0.0f, 0UL, 0UL, &outcome );
   FD_TEST( fd_pack_avail_txn_cnt( pack ) == 4UL );
 
-  schedule_validate_microblock( pack, 30000UL, 0.25f, 1UL, 0UL, &outcome );
+  schedule_validate_complete( pack, 30000UL, 0.25f, 1UL, 0UL, &outcome );
   FD_TEST( fd_pack_avail_txn_cnt( pack ) == 3UL );
 
-  schedule_validate_microblock( pack, 30000UL, 1.0f, 3UL, 0UL, &outcome );
+  schedule_validate_complete( pack, 30000UL, 1.0f, 3UL, 0UL, &outcome );
   FD_TEST( fd_pack_avail_txn_cnt( pack ) == 0UL );
 
-  for( ulong j=0UL; j<3UL; j++ ) FD_TEST( outcome.results[ j ].is_simple_vote );
+  fd_pack_microblock_txn_t const * rec = (fd_pack_microblock_txn_t const *)outcome.results;
+  for( ulong j=0UL; j<3UL; j++ ) {
+    FD_TEST( rec->flags & FD_PACK_MICROBLOCK_TXN_FLAG_SIMPLE_VOTE );
+    rec = fd_pack_microblock_txn_next( rec );
+  }
+}
+
+/* Makes vote i vote for the same vote account as vote j, keeping its
+   own signature. */
+static void
+make_same_voter( ulong i,
+                 ulong j ) {
+  fd_memcpy( payload_scratch[ i ]+0x45, payload_scratch[ j ]+0x45, 0x40UL );
+  fd_txn_parse( payload_scratch[ i ], payload_sz[ i ], txn_scratch[ i ], NULL );
+}
+
+/* Makes vote i, which must be a Vote instruction for a single slot
+   like sample_vote, vote for slot. */
+static void
+set_vote_slot( ulong i,
+               ulong slot ) {
+  fd_txn_t const * txn = (fd_txn_t const *)txn_scratch[ i ];
+  FD_STORE( ulong, payload_scratch[ i ]+txn->instr[ 0 ].data_off+12UL, slot );
+}
+
+static void
+test_vote_lane( void ) {
+  FD_LOG_NOTICE(( "TEST VOTE LANE" ));
+  fd_pack_t * pack = init_all( 4UL, 1UL, 4UL, &outcome );
+  fd_pack_metrics_t const * metrics = fd_pack_metrics( pack );
+
+  ulong i = 0UL;
+  make_vote_transaction( i );                            insert( i++, pack );
+  make_vote_transaction( i );                            insert( i++, pack );
+  make_vote_transaction( i );                            insert( i++, pack );
+  /* Supersedes vote 1 */
+  make_vote_transaction( i ); make_same_voter( i, 1UL ); insert( i++, pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==3UL );
+  FD_TEST( metrics->vote_replaced_cnt==1UL );
+  FD_TEST( !fd_pack_delete_transaction( pack, fd_txn_get_signatures( (fd_txn_t *)txn_scratch[1], payload_scratch[1] ) ) );
+
+  /* Full, so the oldest vote goes */
+  make_vote_transaction( i );                            insert( i++, pack );
+  make_vote_transaction( i );                            insert( i++, pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==4UL );
+  FD_TEST( metrics->evicted_cnt==1UL );
+
+  /* Votes are scheduled oldest first */
+  ulong expected[4] = { 2UL, 3UL, 4UL, 5UL };
+  schedule_validate_complete( pack, 30000UL, 1.0f, 4UL, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+  fd_pack_microblock_txn_t const * rec = (fd_pack_microblock_txn_t const *)outcome.results;
+  for( ulong j=0UL; j<4UL; j++ ) {
+    FD_TEST( !memcmp( fd_pack_microblock_txn_payload( rec )+1UL, payload_scratch[ expected[ j ] ]+1UL, FD_TXN_SIGNATURE_SZ ) );
+    rec = fd_pack_microblock_txn_next( rec );
+  }
+
+  /* A newer vote replaces one that's blocked on its vote account */
+  pack = init_all( 4UL, 2UL, 4UL, &outcome );
+  metrics = fd_pack_metrics( pack );
+  i = 0UL;
+  make_vote_transaction( i );                            insert( i++, pack );
+  schedule_validate_microblock( pack, 30000UL, 1.0f, 1UL, 0UL, 0UL, &outcome );
+  make_vote_transaction( i ); make_same_voter( i, 0UL ); insert( i++, pack );
+  schedule_validate_microblock( pack, 30000UL, 1.0f, 0UL, 0UL, 1UL, &outcome );
+  FD_TEST( metrics->blocked_cnt==1UL );
+  make_vote_transaction( i ); make_same_voter( i, 0UL ); insert( i++, pack );
+  FD_TEST( metrics->vote_replaced_cnt==1UL );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+  complete( pack, 0UL, &outcome );
+  schedule_validate_complete( pack, 30000UL, 1.0f, 1UL, 0UL, &outcome );
+  FD_TEST( !memcmp( fd_pack_microblock_txn_payload( (fd_pack_microblock_txn_t const *)outcome.results )+1UL, payload_scratch[ 2 ]+1UL, FD_TXN_SIGNATURE_SZ ) );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+
+  /* An older vote doesn't replace a newer one, but one for the same
+     slot does */
+  pack = init_all( 4UL, 1UL, 4UL, &outcome );
+  metrics = fd_pack_metrics( pack );
+  i = 0UL;
+  make_vote_transaction( i );                            set_vote_slot( i, 1001UL ); insert( i++, pack );
+  make_vote_transaction( i ); make_same_voter( i, 0UL ); set_vote_slot( i, 1000UL ); insert( i++, pack );
+  FD_TEST( metrics->vote_outdated_cnt==1UL );
+  FD_TEST( metrics->vote_replaced_cnt==0UL );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+  FD_TEST( !fd_pack_delete_transaction( pack, fd_txn_get_signatures( (fd_txn_t *)txn_scratch[1], payload_scratch[1] ) ) );
+  make_vote_transaction( i ); make_same_voter( i, 0UL ); set_vote_slot( i, 1001UL ); insert( i++, pack );
+  FD_TEST( metrics->vote_outdated_cnt==1UL );
+  FD_TEST( metrics->vote_replaced_cnt==1UL );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+  schedule_validate_complete( pack, 30000UL, 1.0f, 1UL, 0UL, &outcome );
+  FD_TEST( !memcmp( fd_pack_microblock_txn_payload( (fd_pack_microblock_txn_t const *)outcome.results )+1UL, payload_scratch[ 2 ]+1UL, FD_TXN_SIGNATURE_SZ ) );
+
+  /* Once it's scheduled, an older vote is accepted again */
+  make_vote_transaction( i ); make_same_voter( i, 0UL ); set_vote_slot( i, 1000UL ); insert( i++, pack );
+  FD_TEST( metrics->vote_outdated_cnt==1UL );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
 }
 
 static void
@@ -349,7 +542,7 @@ test_delete( void ) {
 
   FD_TEST( fd_pack_avail_txn_cnt( pack ) == 3UL );
 
-  schedule_validate_microblock( pack, 300000UL, 0.0f, 3UL, 0UL, &outcome );
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 3UL, 0UL, 0UL, &outcome );
 
   FD_TEST( fd_pack_avail_txn_cnt( pack ) == 0UL );
 
@@ -363,6 +556,7 @@ test_delete( void ) {
   FD_TEST( !fd_pack_delete_transaction( pack, sig5 ) );
 
   FD_TEST( fd_pack_avail_txn_cnt( pack ) == 0UL );
+  complete( pack, 0UL, &outcome );
 
   i=0UL;
   ulong r0 = make_transaction( i, 800U, 12.0, "A", "B" ); insert( i++, pack );
@@ -374,7 +568,7 @@ test_delete( void ) {
 
   /* They all conflict now */
 
-  schedule_validate_microblock( pack, 300000UL, 0.0f, 1UL, r0, &outcome );
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 1UL, r0, 0UL, &outcome );
   FD_TEST( fd_pack_avail_txn_cnt( pack ) == 5UL );
 
   FD_TEST( !fd_pack_delete_transaction( pack, sig0 ) );
@@ -382,12 +576,13 @@ test_delete( void ) {
   FD_TEST(  fd_pack_delete_transaction( pack, sig5 ) );
   FD_TEST( fd_pack_avail_txn_cnt( pack ) == 3UL );
 
-  /* wait the gap */
-  schedule_validate_microblock( pack, 300000UL, 0.0f, 0UL, 0, &outcome );
-  schedule_validate_microblock( pack, 300000UL, 0.0f, 0UL, 0, &outcome );
-  schedule_validate_microblock( pack, 300000UL, 0.0f, 0UL, 0, &outcome );
+  /* wait for bank 0 to finish */
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 0UL, 0, 1UL, &outcome );
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 0UL, 0, 2UL, &outcome );
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 0UL, 0, 3UL, &outcome );
+  complete( pack, 0UL, &outcome );
 
-  schedule_validate_microblock( pack, 300000UL, 0.0f, 1UL, r2, &outcome );
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 1UL, r2, 1UL, &outcome );
   FD_TEST(  fd_pack_delete_transaction( pack, sig3 ) );
   FD_TEST(  fd_pack_delete_transaction( pack, sig4 ) );
   FD_TEST( fd_pack_avail_txn_cnt( pack ) == 0UL );
@@ -406,15 +601,17 @@ void performance_test( void ) {
     fd_txn_p_t * slot       = fd_pack_insert_txn_init( pack );
     fd_txn_t *   txn        = (fd_txn_t*) txn_scratch[ j&1 ];
     fd_memcpy( slot->payload, payload_scratch[ j&1 ], payload_sz[ j&1 ]                                              );
+    slot->payload_sz = payload_sz[ j&1 ];
     fd_memcpy( TXN(slot),     txn,                    fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
 
-    fd_pack_insert_txn_fini( pack, slot );
+    fd_pack_insert_txn_fini( pack, slot, ULONG_MAX );
   }
   long end = fd_log_wallclock( );
   FD_LOG_NOTICE(( "Inserting when not full: %f ns", ((double)(end-start))/10240.0 ));
   start = fd_log_wallclock( );
   for( ulong j=0UL; j<10240UL; j++ ) {
-    fd_pack_schedule_next_microblock( pack, 2000UL, 0.0f, outcome.results );
+    fd_pack_schedule_next_microblock( pack, 2000UL, 0.0f, 0UL, outcome.results, sizeof(outcome.results), &outcome.results_sz );
+    fd_pack_microblock_complete( pack, 0UL );
   }
   end = fd_log_wallclock( );
   FD_LOG_NOTICE(( "Scheduling: %f ns", ((double)(end-start))/10240.0 ));
@@ -430,9 +627,10 @@ void heap_overflow_test( void ) {
     fd_txn_p_t * slot       = fd_pack_insert_txn_init( pack );
     fd_txn_t *   txn        = (fd_txn_t*) txn_scratch[ j ];
     fd_memcpy( slot->payload, payload_scratch[ j ], payload_sz[ j ]                                                );
+    slot->payload_sz = payload_sz[ j ];
     fd_memcpy( TXN(slot),     txn,                  fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
 
-    fd_pack_insert_txn_fini( pack, slot );
+    fd_pack_insert_txn_fini( pack, slot, ULONG_MAX );
   }
   FD_TEST( fd_pack_avail_txn_cnt( pack )==1024UL );
 
@@ -444,39 +642,758 @@ void heap_overflow_test( void ) {
     fd_txn_p_t * slot       = fd_pack_insert_txn_init( pack );
     fd_txn_t *   txn        = (fd_txn_t*) txn_scratch[ 1UL ];
     fd_memcpy( slot->payload, payload_scratch[ 1UL ], payload_sz[ 1UL ]                                              );
+    slot->payload_sz = payload_sz[ 1UL ];
     fd_memcpy( TXN(slot),     txn,                    fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
 
-    fd_pack_insert_txn_fini( pack, slot );
+    fd_pack_insert_txn_fini( pack, slot, ULONG_MAX );
   }
 
   FD_TEST( fd_pack_avail_txn_cnt( pack )==1024UL );
+  FD_TEST( fd_pack_metrics( pack )->evicted_cnt==1024UL );
+  FD_TEST( fd_pack_metrics( pack )->insert_rejected_full_cnt==0UL );
 
   for( ulong j=0UL; j<1024UL; j++ ) {
-    schedule_validate_microblock( pack, 10000UL, 0.0f, 1UL, r_hi, &outcome );
+    schedule_validate_complete( pack, 10000UL, 0.0f, 1UL, r_hi, &outcome );
   }
 
   FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
 }
 
 static void
-test_gap( void ) {
-  FD_LOG_NOTICE(( "TEST GAP" ));
+test_eviction( void ) {
+  FD_LOG_NOTICE(( "TEST EVICTION" ));
+  fd_pack_t * pack = init_all( 4UL, 1UL, 4UL, &outcome );
+  fd_pack_metrics_t const * metrics = fd_pack_metrics( pack );
+
+  ulong i=0UL;
+  make_vote_transaction( i );                         insert( i++, pack );
+  make_vote_transaction( i );                         insert( i++, pack );
+  make_transaction( i, 500U, 12.0, "A", "B" );        insert( i++, pack );
+  make_transaction( i, 500U, 12.5, "C", "D" );        insert( i++, pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==4UL );
+
+  /* Worse than every non-vote, so it's dropped even though it pays
+     more per CU than the votes */
+  make_transaction( i, 500U, 11.0, "E", "F" );        insert( i++, pack );
+  FD_TEST( metrics->insert_rejected_full_cnt==1UL );
+  FD_TEST( metrics->evicted_cnt==0UL );
+
+  /* Better than the worst non-vote, which it replaces */
+  ulong r_hi = make_transaction( i, 500U, 13.0, "G", "H" ); insert( i++, pack );
+  FD_TEST( metrics->evicted_cnt==1UL );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==4UL );
 
-  for( ulong gap=1UL; gap<=FD_PACK_MAX_GAP; gap++ ) {
-    fd_pack_t * pack = init_all( 10240UL, gap, 2UL, &outcome );
+  fd_ed25519_sig_t const * sig2 = fd_txn_get_signatures( (fd_txn_t *)txn_scratch[2], payload_scratch[2] );
+  fd_ed25519_sig_t const * sig4 = fd_txn_get_signatures( (fd_txn_t *)txn_scratch[4], payload_scratch[4] );
+  FD_TEST( !fd_pack_delete_transaction( pack, sig2 ) );
+  FD_TEST( !fd_pack_delete_transaction( pack, sig4 ) );
+
+  schedule_validate_complete( pack, 30000UL, 0.5f, 3UL, r_hi, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+}
+
+static void
+test_expiry( void ) {
+  FD_LOG_NOTICE(( "TEST EXPIRY" ));
+  fd_pack_t * pack = init_all( 1024UL, 1UL, 4UL, &outcome );
+
+  ulong i=0UL;
+  make_transaction( i, 500U, 11.0, "A", "B" );              insert_expiring( i++, pack, 10UL );
+  make_transaction( i, 500U, 10.0, "C", "D" );              insert_expiring( i++, pack, 20UL );
+  make_vote_transaction( i );                               insert_expiring( i++, pack, 20UL );
+  ulong r = make_transaction( i, 500U, 12.0, "E", "F" );    insert_expiring( i++, pack, 30UL );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==4UL );
+
+  FD_TEST( fd_pack_expire_before( pack, 10UL )==0UL );
+  FD_TEST( fd_pack_expire_before( pack, 21UL )==3UL );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+  FD_TEST( fd_pack_metrics( pack )->expired_cnt==3UL );
+
+  fd_ed25519_sig_t const * sig0 = fd_txn_get_signatures( (fd_txn_t *)txn_scratch[0], payload_scratch[0] );
+  FD_TEST( !fd_pack_delete_transaction( pack, sig0 ) );
+
+  schedule_validate_complete( pack, 10000UL, 0.0f, 1UL, r, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+  FD_TEST( fd_pack_expire_before( pack, ULONG_MAX )==0UL );
+
+  /* Expiry is tracked across clear_all */
+  make_transaction( i, 500U, 11.0, "A", "B" );              insert_expiring( i++, pack, 10UL );
+  fd_pack_clear_all( pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+  FD_TEST( fd_pack_expire_before( pack, ULONG_MAX )==0UL );
+  make_transaction( i, 500U, 11.0, "A", "B" );              insert_expiring( i++, pack, 10UL );
+  FD_TEST( fd_pack_expire_before( pack, ULONG_MAX )==1UL );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+}
+
+#define CU_EST_BIN_CNT (64UL)
+static uchar cu_est_scratch[ FD_EST_FTBL_FOOTPRINT( CU_EST_BIN_CNT ) ] __attribute__((aligned(FD_EST_FTBL_ALIGN)));
+
+static void
+test_cu_est( void ) {
+  FD_LOG_NOTICE(( "TEST CU ESTIMATION" ));
+  fd_pack_t * pack = init_all( 1024UL, 1UL, 4UL, &outcome );
+
+  fd_est_ftbl_t * tbl = fd_est_ftbl_join( fd_est_ftbl_new( cu_est_scratch, CU_EST_BIN_CNT, 1000UL,
+                                                           FD_COMPUTE_BUDGET_DEFAULT_INSTR_CU_LIMIT ) );
+  ulong work_tag = fd_pack_cu_est_tag( (fd_acct_addr_t const *)WORK_PROGRAM_ID );
+  for( ulong j=0UL; j<1000UL; j++ ) fd_est_ftbl_update( tbl, work_tag, 90U + (uint)(j%21UL) );
+
+  /* Requests 0x10101 CUs over 3 instructions, but each actually uses
+     about 100. */
+  ulong i=0UL;
+  make_transaction( i, 0x10101U, 11.0, "A", "B" ); insert( i++, pack );
+  schedule_validate_complete( pack, 20000UL, 0.0f, 0UL, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+
+  fd_pack_set_cu_est_tbl( pack, tbl );
+  ulong r = make_transaction( i, 0x10101U, 10.0, "C", "D" ); insert( i++, pack );
+  schedule_validate_complete( pack, 20000UL, 0.0f, 1UL, r, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+
+  /* The estimate never exceeds the requested CUs: a program pack has
+     no data on gets the default for each instruction. */
+  fd_pack_clear_all( pack );
+  fd_est_ftbl_new( cu_est_scratch, CU_EST_BIN_CNT, 1000UL, FD_COMPUTE_BUDGET_DEFAULT_INSTR_CU_LIMIT );
+  make_transaction( i, 0x10101U, 10.0, "C", "D" ); insert( i++, pack );
+  schedule_validate_complete( pack, 60000UL, 0.0f, 0UL, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+
+  /* Same for estimates that don't fit in a ulong or overflow to inf
+     when summed over the instructions. */
+  fd_pack_clear_all( pack );
+  tbl->default_val = FLT_MAX;
+  r = make_transaction( i, 0x10101U, 10.0, "C", "D" ); insert( i++, pack );
+  schedule_validate_complete( pack, 60000UL, 0.0f, 0UL, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+  schedule_validate_complete( pack, 200000UL, 0.0f, 1UL, r, &outcome );
+
+  fd_pack_clear_all( pack );
+  tbl->default_val = 1e30f;
+  r = make_transaction( i, 0x10101U, 10.0, "C", "D" ); insert( i++, pack );
+  schedule_validate_complete( pack, 60000UL, 0.0f, 0UL, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+  schedule_validate_complete( pack, 200000UL, 0.0f, 1UL, r, &outcome );
+
+  fd_pack_set_cu_est_tbl( pack, NULL );
+  fd_est_ftbl_delete( fd_est_ftbl_leave( tbl ) );
+}
+
+static void
+test_bank_tiles( void ) {
+  FD_LOG_NOTICE(( "TEST BANK TILES" ));
+
+  for( ulong bank_tile_cnt=1UL; bank_tile_cnt<=FD_PACK_MAX_BANK_TILES; bank_tile_cnt++ ) {
+    fd_pack_t * pack = init_all( 10240UL, bank_tile_cnt, 2UL, &outcome );
 
     ulong i=0UL;
     ulong reward1 = make_transaction( i,  500U, 11.0, "A", "B" );      insert( i++, pack );
     ulong reward2 = make_transaction( i,  500U, 10.0, "B", "A" );      insert( i++, pack );
 
-    schedule_validate_microblock( pack, 10000UL, 0.0f, 1UL, reward1, &outcome );
+    schedule_validate_microblock( pack, 10000UL, 0.0f, 1UL, reward1, 0UL, &outcome );
+
+    /* No other bank can take the conflicting transaction while bank 0
+       holds the locks, no matter how many microblocks are scheduled. */
+    for( ulong j=1UL; j<bank_tile_cnt; j++ ) schedule_validate_microblock( pack, 10000UL, 0.0f, 0UL, 0UL, j, &outcome );
+    for( ulong j=1UL; j<bank_tile_cnt; j++ ) complete( pack, j, &outcome );
+    for( ulong j=1UL; j<bank_tile_cnt; j++ ) schedule_validate_microblock( pack, 10000UL, 0.0f, 0UL, 0UL, j, &outcome );
+
+    FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+
+    complete( pack, 0UL, &outcome );
+    schedule_validate_microblock( pack, 10000UL, 0.0f, 1UL, reward2, bank_tile_cnt-1UL, &outcome );
+    complete( pack, bank_tile_cnt-1UL, &outcome );
+  }
+
+  /* Non-conflicting transactions spread out over all the bank tiles,
+     and shared readonly accounts don't serialize them. */
+  fd_pack_t * pack = init_all( 10240UL, 8UL, 1UL, &outcome );
+  char const * writes[ 8 ] = { "A", "B", "C", "D", "E", "F", "G", "H" };
+  for( ulong i=0UL; i<8UL; i++ ) { make_transaction( i, 500U, 11.0, writes[ i ], "Z" ); insert( i, pack ); }
+  for( ulong i=0UL; i<8UL; i++ ) schedule_validate_microblock( pack, 10000UL, 0.0f, 1UL, 0UL, i, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+
+  /* A writer of the shared account has to wait for all the readers. */
+  make_transaction( 8UL, 500U, 11.0, "Z", "" ); insert( 8UL, pack );
+  for( ulong i=0UL; i<7UL; i++ ) {
+    complete( pack, i, &outcome );
+    schedule_validate_microblock( pack, 10000UL, 0.0f, 0UL, 0UL, i, &outcome );
+  }
+  complete( pack, 7UL, &outcome );
+  schedule_validate_microblock( pack, 10000UL, 0.0f, 1UL, 0UL, 7UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+
+  fd_pack_metrics_t const * metrics = fd_pack_metrics( pack );
+  FD_TEST( metrics->candidates_evaluated>=9UL );
+  FD_TEST( metrics->bitset_fallback_cnt<=metrics->candidates_evaluated );
+#if !FD_PACK_USE_BITSET
+  FD_TEST( metrics->bitset_fallback_cnt==metrics->candidates_evaluated );
+#endif
+}
+
+static void
+test_blocked( void ) {
+  FD_LOG_NOTICE(( "TEST BLOCKED" ));
+  fd_pack_t * pack = init_all( 1024UL, 2UL, 4UL, &outcome );
+  fd_pack_metrics_t const * metrics = fd_pack_metrics( pack );
+
+  /* Lots of transactions that write the same hot account.  Once the
+     best one is scheduled, the rest are blocked on it. */
+  ulong rewards[ 100 ];
+  for( ulong i=0UL; i<100UL; i++ ) {
+    rewards[ i ] = make_transaction( i, 500U, 10.0+0.01*(double)i, "A", "B" );
+    insert_expiring( i, pack, 10UL+i );
+  }
+  schedule_validate_microblock( pack, 10000UL, 0.0f, 1UL, rewards[ 99 ], 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==99UL );
+  FD_TEST( metrics->blocked_cnt==99UL );
+
+  /* Other bank tiles don't evaluate them again while the lock is held */
+  ulong candidates = metrics->candidates_evaluated;
+  for( ulong j=0UL; j<10UL; j++ ) schedule_validate_microblock( pack, 10000UL, 0.0f, 0UL, 0UL, 1UL, &outcome );
+  FD_TEST( metrics->candidates_evaluated==candidates );
+
+  /* Blocked transactions can still be deleted and expire */
+  FD_TEST( fd_pack_delete_transaction( pack, fd_txn_get_signatures( (fd_txn_t *)txn_scratch[0], payload_scratch[0] ) ) );
+  FD_TEST( fd_pack_expire_before( pack, 12UL )==1UL );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==97UL );
+
+  /* Releasing the lock makes them eligible again, best first */
+  complete( pack, 0UL, &outcome );
+  schedule_validate_microblock( pack, 10000UL, 0.0f, 1UL, rewards[ 98 ], 1UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==96UL );
+  FD_TEST( metrics->blocked_cnt==99UL+96UL );
+  complete( pack, 1UL, &outcome );
+
+  for( ulong j=0UL; j<96UL; j++ ) schedule_validate_complete( pack, 10000UL, 0.0f, 1UL, rewards[ 97UL-j ], &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+
+  /* clear_all removes blocked transactions too */
+  for( ulong i=0UL; i<4UL; i++ ) { make_transaction( i, 500U, 11.0, "A", "B" ); insert( i, pack ); }
+  schedule_validate_microblock( pack, 10000UL, 0.0f, 1UL, 0UL, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==3UL );
+  fd_pack_clear_all( pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+  FD_TEST( fd_pack_expire_before( pack, ULONG_MAX )==0UL );
+  for( ulong i=0UL; i<4UL; i++ ) { make_transaction( i, 500U, 11.0, "A", "B" ); insert( i, pack ); }
+  schedule_validate_complete( pack, 10000UL, 0.0f, 1UL, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==3UL );
+}
+
+/* Returns the index passed to make_transaction of the j-th transaction
+   in the most recently scheduled microblock. */
+static ulong
+result_idx( ulong j ) {
+  fd_pack_microblock_txn_t const * rec = (fd_pack_microblock_txn_t const *)outcome.results;
+  for( ulong k=0UL; k<j; k++ ) rec = fd_pack_microblock_txn_next( rec );
+  return FD_LOAD( ulong, fd_pack_microblock_txn_payload( rec )+1UL );
+}
+
+static void
+test_bundle( void ) {
+  FD_LOG_NOTICE(( "TEST BUNDLE" ));
+  fd_pack_t * pack = init_all( 1024UL, 2UL, 8UL, &outcome );
+
+  fd_txn_p_t * bundle[ FD_PACK_MAX_TXN_PER_BUNDLE+1UL ];
+  FD_TEST( !fd_pack_insert_bundle_init( pack, bundle, 0UL ) );
+  FD_TEST( !fd_pack_insert_bundle_init( pack, bundle, FD_PACK_MAX_TXN_PER_BUNDLE+1UL ) );
+
+  /* The bundle is prioritized as a whole, so the high paying last
+     transaction carries the other two ahead of the single transaction
+     that conflicts with the first.  They're scheduled in order. */
+  make_transaction( 0UL, 500U, 10.0, "A", "B" );
+  make_transaction( 1UL, 500U, 10.0, "C", "B" );
+  make_transaction( 2UL, 500U, 13.0, "D", ""  );
+  make_transaction( 3UL, 500U, 12.0, "A", ""  ); insert( 3UL, pack );
+  ulong b0[ 3 ] = { 0UL, 1UL, 2UL };
+  insert_bundle( b0, 3UL, pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==4UL );
+  schedule_validate_microblock( pack, 100000UL, 0.0f, 3UL, 0UL, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+  for( ulong j=0UL; j<3UL; j++ ) FD_TEST( result_idx( j )==j );
+  complete( pack, 0UL, &outcome );
+  schedule_validate_complete( pack, 100000UL, 0.0f, 1UL, 0UL, &outcome );
+  FD_TEST( result_idx( 0UL )==3UL );
+
+  /* All or nothing: each transaction fits in the CU limit, but not
+     both */
+  make_transaction( 4UL, 6000U, 11.0, "E", "" );
+  make_transaction( 5UL, 6000U, 11.0, "F", "" );
+  ulong b1[ 2 ] = { 4UL, 5UL };
+  insert_bundle( b1, 2UL, pack );
+  schedule_validate_complete( pack, 10000UL, 0.0f, 0UL, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==2UL );
+
+  /* Identified by the first signature */
+  FD_TEST( !fd_pack_delete_transaction( pack, fd_txn_get_signatures( (fd_txn_t *)txn_scratch[5], payload_scratch[5] ) ) );
+  FD_TEST(  fd_pack_delete_transaction( pack, fd_txn_get_signatures( (fd_txn_t *)txn_scratch[4], payload_scratch[4] ) ) );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
 
-    for( ulong j=1UL; j<gap; j++ ) schedule_validate_microblock( pack, 10000UL, 0.0f, 0UL, 0UL, &outcome );
+  /* Transactions in a bundle can't conflict with each other */
+  make_transaction( 6UL, 500U, 11.0, "G", ""  );
+  make_transaction( 7UL, 500U, 11.0, "H", "G" );
+  ulong b2[ 2 ] = { 6UL, 7UL };
+  insert_bundle( b2, 2UL, pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+
+  /* A bundle that conflicts through any of its transactions waits for
+     the lock */
+  make_transaction( 8UL,  500U, 11.0, "J", ""  ); insert( 8UL, pack );
+  schedule_validate_microblock( pack, 100000UL, 0.0f, 1UL, 0UL, 0UL, &outcome );
+  make_transaction( 9UL,  500U, 13.0, "K", ""  );
+  make_transaction( 10UL, 500U, 13.0, "L", "J" );
+  ulong b3[ 2 ] = { 9UL, 10UL };
+  insert_bundle( b3, 2UL, pack );
+  schedule_validate_microblock( pack, 100000UL, 0.0f, 0UL, 0UL, 1UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==2UL );
+  complete( pack, 0UL, &outcome );
+  schedule_validate_microblock( pack, 100000UL, 0.0f, 2UL, 0UL, 1UL, &outcome );
+  FD_TEST( (result_idx( 0UL )==9UL) & (result_idx( 1UL )==10UL) );
+  complete( pack, 1UL, &outcome );
+
+  /* Bundles that don't fit in a microblock are thrown out, and a full
+     pack only makes room for a bundle if it beats everything it
+     displaces. */
+  pack = init_all( 4UL, 1UL, 2UL, &outcome );
+  make_transaction( 0UL, 500U, 11.0, "A", "" );
+  make_transaction( 1UL, 500U, 11.0, "B", "" );
+  make_transaction( 2UL, 500U, 11.0, "C", "" );
+  ulong b4[ 3 ] = { 0UL, 1UL, 2UL };
+  insert_bundle( b4, 3UL, pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+
+  make_transaction( 0UL, 500U, 11.0, "A", "" ); insert( 0UL, pack );
+  make_transaction( 1UL, 500U, 12.0, "B", "" ); insert( 1UL, pack );
+  make_transaction( 2UL, 500U, 13.0, "C", "" ); insert( 2UL, pack );
+  make_transaction( 3UL, 500U, 10.5, "D", "" );
+  make_transaction( 4UL, 500U, 10.5, "E", "" );
+  ulong b5[ 2 ] = { 3UL, 4UL };
+  insert_bundle( b5, 2UL, pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==3UL );
+  FD_TEST( fd_pack_metrics( pack )->insert_rejected_full_cnt==1UL );
+  make_transaction( 3UL, 500U, 12.5, "D", "" );
+  make_transaction( 4UL, 500U, 12.5, "E", "" );
+  insert_bundle( b5, 2UL, pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==4UL );
+  FD_TEST( fd_pack_metrics( pack )->evicted_cnt==1UL );
+  FD_TEST( !fd_pack_delete_transaction( pack, fd_txn_get_signatures( (fd_txn_t *)txn_scratch[0], payload_scratch[0] ) ) );
+}
 
+static void
+test_alt( void ) {
+  FD_LOG_NOTICE(( "TEST ALT" ));
+  fd_alt_cache_t * cache = fd_alt_cache_join( fd_alt_cache_new( alt_cache_scratch, ALT_CACHE_ENTRY_CNT ) );
+  FD_TEST( cache );
+
+  /* Table T holds A, B, C, D */
+  fd_acct_addr_t table[1];  memset( table->b, 'T', FD_TXN_ACCT_ADDR_SZ );
+  fd_acct_addr_t contents[ 4 ];
+  for( ulong k=0UL; k<4UL; k++ ) memset( contents[ k ].b, (int)('A'+k), FD_TXN_ACCT_ADDR_SZ );
+  fd_alt_cache_insert( cache, table, contents, 4UL );
+
+  fd_acct_addr_t out[ 2 ];
+  uchar idx[ 2 ] = { 3, 1 };
+  FD_TEST( fd_alt_cache_resolve( cache, table, idx, 2UL, out ) );
+  FD_TEST( !memcmp( out[ 0 ].b, contents[ 3 ].b, FD_TXN_ACCT_ADDR_SZ ) );
+  FD_TEST( !memcmp( out[ 1 ].b, contents[ 1 ].b, FD_TXN_ACCT_ADDR_SZ ) );
+  uchar bad[ 1 ] = { 4 };
+  FD_TEST( !fd_alt_cache_resolve( cache, table, bad, 1UL, out ) );
+  fd_acct_addr_t other[1];  memset( other->b, 'U', FD_TXN_ACCT_ADDR_SZ );
+  FD_TEST( !fd_alt_cache_resolve( cache, other, idx, 2UL, out ) );
+
+  /* Transaction 1 writes A through the table, so it conflicts with
+     transaction 0 only if pack resolves the table. */
+  uchar a[ 1 ] = { 0 };
+  for( int resolve=0; resolve<2; resolve++ ) {
+    fd_pack_t * pack = init_all( 1024UL, 2UL, 4UL, &outcome );
+    if( resolve ) fd_pack_set_alt_cache( pack, cache );
+    make_transaction( 0UL, 500U, 11.0, "A", "" );                                 insert( 0UL, pack );
+    make_transaction( 1UL, 500U, 10.0, "X", "" ); add_lookup( 1UL, 'T', a, 1UL, NULL, 0UL ); insert( 1UL, pack );
+    FD_TEST( fd_pack_metrics( pack )->alt_unresolved_cnt==0UL );
+
+    schedule_validate_microblock( pack, 100000UL, 0.0f, 1UL, 0UL, 0UL, &outcome );
+    FD_TEST( fd_pack_avail_txn_cnt( pack )==(resolve ? 1UL : 0UL) );
+    if( !resolve ) continue;
+    /* Nor can another bank tile take it while A is locked */
+    schedule_validate_microblock( pack, 100000UL, 0.0f, 0UL, 0UL, 1UL, &outcome );
+    FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+    complete( pack, 0UL, &outcome );
+    schedule_validate_microblock( pack, 100000UL, 0.0f, 1UL, 0UL, 1UL, &outcome );
+    FD_TEST( result_idx( 0UL )==1UL );
+    complete( pack, 1UL, &outcome );
+
+    /* Reading A through the table conflicts with writing it too */
+    make_transaction( 2UL, 500U, 11.0, "A", "" );                                 insert( 2UL, pack );
+    make_transaction( 3UL, 500U, 10.0, "Y", "" ); add_lookup( 3UL, 'T', NULL, 0UL, a, 1UL ); insert( 3UL, pack );
+    schedule_validate_complete( pack, 100000UL, 0.0f, 1UL, 0UL, &outcome );
     FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+    schedule_validate_complete( pack, 100000UL, 0.0f, 1UL, 0UL, &outcome );
+
+    /* The transactions of a bundle can't conflict through a table */
+    make_transaction( 4UL, 500U, 10.0, "A", "" );
+    make_transaction( 5UL, 500U, 10.0, "Z", "" ); add_lookup( 5UL, 'T', a, 1UL, NULL, 0UL );
+    ulong b0[ 2 ] = { 4UL, 5UL };
+    insert_bundle( b0, 2UL, pack );
+    FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+
+    /* Unknown tables and out of bounds indices fall back to the
+       accounts in the transaction itself */
+    make_transaction( 6UL, 500U, 11.0, "A", "" );                                 insert( 6UL, pack );
+    make_transaction( 7UL, 500U, 10.0, "V", "" ); add_lookup( 7UL, 'U', a,   1UL, NULL, 0UL ); insert( 7UL, pack );
+    make_transaction( 8UL, 500U, 10.0, "W", "" ); add_lookup( 8UL, 'T', bad, 1UL, NULL, 0UL ); insert( 8UL, pack );
+    FD_TEST( fd_pack_metrics( pack )->alt_unresolved_cnt==2UL );
+    schedule_validate_complete( pack, 100000UL, 0.0f, 3UL, 0UL, &outcome );
+    FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+
+    /* Loading an account twice is invalid */
+    uchar aa[ 2 ] = { 0, 0 };
+    make_transaction( 9UL,  500U, 10.0, "A", "" ); add_lookup( 9UL,  'T', NULL, 0UL, a,  1UL ); insert( 9UL,  pack );
+    make_transaction( 10UL, 500U, 10.0, "Q", "" ); add_lookup( 10UL, 'T', aa,   2UL, NULL, 0UL ); insert( 10UL, pack );
+    FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+  }
 
-    schedule_validate_microblock( pack, 10000UL, 0.0f, 1UL, reward2, &outcome );
+  /* Table S holds 120 distinct accounts, the last of which is B.  Pack
+     only has room for the resolved addresses of 5 transactions that
+     load all of them, so the sixth falls back to the accounts in the
+     transaction itself. */
+  fd_acct_addr_t big[ 120 ];
+  uchar          all[ 120 ];
+  for( ulong k=0UL; k<120UL; k++ ) {
+    memset( big[ k ].b, 'S', FD_TXN_ACCT_ADDR_SZ ); FD_STORE( ulong, big[ k ].b, k );
+    all[ k ] = (uchar)k;
+  }
+  memset( big[ 119 ].b, 'B', FD_TXN_ACCT_ADDR_SZ );
+  memset( table->b, 'S', FD_TXN_ACCT_ADDR_SZ );
+  fd_alt_cache_insert( cache, table, big, 120UL );
+
+  fd_pack_t * pack = init_all( 8UL, 2UL, 4UL, &outcome );
+  fd_pack_set_alt_cache( pack, cache );
+  for( ulong i=0UL; i<6UL; i++ ) {
+    make_transaction( i, 500U, 10.0, "", "" ); add_lookup( i, 'S', all, 120UL, NULL, 0UL ); insert( i, pack );
+    FD_TEST( fd_pack_metrics( pack )->alt_unresolved_cnt==(i<5UL ? 0UL : 1UL) );
   }
+  make_transaction( 6UL, 500U, 11.0, "B", "" ); insert( 6UL, pack );
+
+  /* The ones that were resolved conflict with 6 on B */
+  schedule_validate_microblock( pack, 100000UL, 0.0f, 2UL, 0UL, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==5UL );
+  complete( pack, 0UL, &outcome );
+
+  /* Scheduling one of them frees its chunks for the next one */
+  schedule_validate_complete( pack, 100000UL, 0.0f, 1UL, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==4UL );
+  make_transaction( 7UL, 500U, 10.0, "", "" ); add_lookup( 7UL, 'S', all, 120UL, NULL, 0UL ); insert( 7UL, pack );
+  FD_TEST( fd_pack_metrics( pack )->alt_unresolved_cnt==1UL );
+  fd_pack_clear_all( pack );
+  make_transaction( 8UL, 500U, 10.0, "", "" ); add_lookup( 8UL, 'S', all, 120UL, NULL, 0UL ); insert( 8UL, pack );
+  FD_TEST( fd_pack_metrics( pack )->alt_unresolved_cnt==1UL );
+
+  fd_alt_cache_delete( fd_alt_cache_leave( cache ) );
+}
+
+/* Makes the fee payer of transaction i the same as that of transaction
+   payer. */
+static void
+set_payer( ulong i,
+           ulong payer ) {
+  fd_txn_t * txn = (fd_txn_t*) txn_scratch[ i ];
+  fd_memcpy( payload_scratch[ i ]+txn->acct_addr_off, payload_scratch[ payer ]+txn->acct_addr_off, FD_TXN_ACCT_ADDR_SZ );
+}
+
+static void
+test_fee_payer( void ) {
+  FD_LOG_NOTICE(( "TEST FEE PAYER" ));
+  fd_pack_t * pack = init_all( 1024UL, 1UL, 4UL, &outcome );
+  fd_pack_metrics_t const * metrics = fd_pack_metrics( pack );
+  fd_balance_tbl_t * tbl = fd_balance_tbl_join( fd_balance_tbl_new( balance_tbl_scratch, BALANCE_TBL_SLOT_CNT ) );
+  FD_TEST( tbl );
+  fd_pack_set_balance_tbl( pack, tbl );
+
+  /* Payers that aren't in the table can afford anything */
+  make_transaction( 0UL, 500U, 11.0, "A", "" ); insert( 0UL, pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+  schedule_validate_complete( pack, 100000UL, 0.0f, 1UL, 0UL, &outcome );
+
+  /* A payer that can't afford the fee is dropped at insert */
+  ulong fee = make_transaction( 1UL, 500U, 11.0, "B", "" ) + FD_PACK_FEE_PER_SIGNATURE;
+  fd_acct_addr_t const * payer = fd_txn_get_acct_addrs( (fd_txn_t *)txn_scratch[ 1 ], payload_scratch[ 1 ] );
+  FD_TEST( fd_balance_tbl_update( tbl, payer, fee-1UL ) );
+  insert( 1UL, pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+  FD_TEST( metrics->unaffordable_cnt==1UL );
+  FD_TEST( fd_balance_tbl_update( tbl, payer, fee ) );
+  insert( 1UL, pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+  schedule_validate_complete( pack, 100000UL, 0.0f, 1UL, 0UL, &outcome );
+
+  /* The rest of the block, it has nothing left, even for a transaction
+     it could afford on its own */
+  make_transaction( 2UL, 500U, 11.0, "C", "" ); set_payer( 2UL, 1UL ); insert( 2UL, pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+  FD_TEST( metrics->unaffordable_cnt==2UL );
+
+  /* Transactions inserted before the payer ran out are dropped when
+     they're considered for scheduling */
+  fd_pack_end_block( pack );
+  FD_TEST( fd_balance_tbl_update( tbl, payer, 2UL*fee-1UL ) );
+  for( ulong i=3UL; i<6UL; i++ ) { make_transaction( i, 500U, 11.0, "D", "" ); set_payer( i, 1UL ); insert( i, pack ); }
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==3UL );
+  schedule_validate_complete( pack, 100000UL, 0.0f, 1UL, 0UL, &outcome );
+  schedule_validate_complete( pack, 100000UL, 0.0f, 0UL, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+  FD_TEST( metrics->unaffordable_cnt==4UL );
+
+  /* Bundle members with the same fee payer are charged together */
+  fd_pack_end_block( pack );
+  fee = make_transaction( 6UL, 500U, 11.0, "E", "" ) + FD_PACK_FEE_PER_SIGNATURE;
+  make_transaction( 7UL, 500U, 11.0, "F", "" ); set_payer( 7UL, 6UL );
+  payer = fd_txn_get_acct_addrs( (fd_txn_t *)txn_scratch[ 6 ], payload_scratch[ 6 ] );
+  FD_TEST( fd_balance_tbl_update( tbl, payer, 2UL*fee-1UL ) );
+  ulong b0[ 2 ] = { 6UL, 7UL };
+  insert_bundle( b0, 2UL, pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+  FD_TEST( metrics->unaffordable_cnt==5UL );
+
+  /* Affording both, it's rejected only because the transactions
+     conflict on the fee payer */
+  FD_TEST( fd_balance_tbl_update( tbl, payer, 2UL*fee ) );
+  insert_bundle( b0, 2UL, pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+  FD_TEST( metrics->unaffordable_cnt==5UL );
+
+  fd_pack_set_balance_tbl( pack, NULL );
+  fd_balance_tbl_delete( fd_balance_tbl_leave( tbl ) );
+}
+
+static void
+test_fee_stats( void ) {
+  FD_LOG_NOTICE(( "TEST FEE STATS" ));
+  fd_pack_t * pack = init_all( 1024UL, 1UL, 4UL, &outcome );
+  fd_fee_stats_t * stats = fd_fee_stats_join( fd_fee_stats_new( fee_stats_scratch ) );
+  FD_TEST( stats );
+
+  /* Nothing is counted until pack has somewhere to publish to */
+  make_transaction( 11UL, 500U, 5.0, "A", "" ); insert( 11UL, pack );
+  fd_pack_publish_fee_stats( pack );
+  fd_pack_set_fee_stats( pack, stats );
+
+  fd_fee_stats_acct_t accts[ FD_FEE_STATS_ACCT_MAX ];
+  ulong               pending_cnt;
+  fd_pack_publish_fee_stats( pack );
+  FD_TEST( fd_fee_stats_read( stats, accts, &pending_cnt )==0UL );
+  FD_TEST( pending_cnt==0UL );
+
+  /* With just the middle transaction writing A, its fee is the min */
+  make_transaction( 2UL, 500U, 5.0, "A", "" ); insert( 2UL, pack );
+  fd_pack_publish_fee_stats( pack );
+  fd_acct_addr_t a; memset( a.b, 'A', FD_TXN_ACCT_ADDR_SZ );
+  fd_fee_stats_acct_t e[1];
+  FD_TEST( fd_fee_stats_query( stats, &a, e ) );
+  FD_TEST( e->pending_cnt==1UL );
+  ulong mid_fee = e->min_fee_per_cu;
+  FD_TEST( mid_fee>0UL );
+
+  /* Readers of A don't count, and neither does the vote lane */
+  make_transaction( 0UL, 500U, 3.0, "A",  "" ); insert( 0UL, pack );
+  make_transaction( 1UL, 500U, 4.0, "A",  "" ); insert( 1UL, pack );
+  make_transaction( 3UL, 500U, 6.0, "A",  "" ); insert( 3UL, pack );
+  make_transaction( 4UL, 500U, 7.0, "A",  "" ); insert( 4UL, pack );
+  make_transaction( 5UL, 500U, 5.0, "B",  "" ); insert( 5UL, pack );
+  make_transaction( 6UL, 500U, 6.0, "B",  "" ); insert( 6UL, pack );
+  make_transaction( 7UL, 500U, 7.0, "B",  "" ); insert( 7UL, pack );
+  make_transaction( 8UL, 500U, 2.0, "C", "A" ); insert( 8UL, pack );
+  make_vote_transaction( 9UL );                 insert( 9UL, pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==11UL );
+
+  fd_pack_publish_fee_stats( pack );
+  ulong acct_cnt = fd_fee_stats_read( stats, accts, &pending_cnt );
+  FD_TEST( pending_cnt==9UL );
+  FD_TEST( acct_cnt==12UL ); /* A, B, C, and 9 signers */
+  FD_TEST( !memcmp( accts[ 0 ].key.b, a.b, FD_TXN_ACCT_ADDR_SZ ) );
+  FD_TEST( accts[ 0 ].pending_cnt==5UL );
+  FD_TEST( accts[ 1 ].pending_cnt==3UL );
+  for( ulong i=2UL; i<acct_cnt; i++ ) FD_TEST( accts[ i ].pending_cnt==1UL );
+  FD_TEST( accts[ 0 ].min_fee_per_cu<mid_fee );
+  FD_TEST( accts[ 0 ].median_fee_per_cu==mid_fee );
+  FD_TEST( accts[ 1 ].min_fee_per_cu==mid_fee );
+  FD_TEST( accts[ 0 ].cus_scheduled==0UL );
+
+  /* Scheduling the best writer of A moves its cost to cus_scheduled */
+  schedule_validate_complete( pack, 100000UL, 0.0f, 2UL, 0UL, &outcome );
+  fd_pack_publish_fee_stats( pack );
+  FD_TEST( fd_fee_stats_query( stats, &a, e ) );
+  FD_TEST( e->pending_cnt==4UL );
+  FD_TEST( e->cus_scheduled>0UL );
+  fd_pack_end_block( pack );
+  fd_pack_publish_fee_stats( pack );
+  FD_TEST( fd_fee_stats_query( stats, &a, e ) );
+  FD_TEST( e->cus_scheduled==0UL );
+
+  /* The signature fee isn't part of the priority fee */
+  make_transaction( 10UL, 500U, -10.0, "D", "" ); insert( 10UL, pack );
+  fd_pack_publish_fee_stats( pack );
+  fd_acct_addr_t d; memset( d.b, 'D', FD_TXN_ACCT_ADDR_SZ );
+  FD_TEST( fd_fee_stats_query( stats, &d, e ) );
+  FD_TEST( e->pending_cnt==1UL );
+  FD_TEST( e->min_fee_per_cu==0UL );
+  FD_TEST( e->median_fee_per_cu==0UL );
+
+  /* Removing the transactions that are still pending takes them out
+     again */
+  for( ulong i=0UL; i<=11UL; i++ ) fd_pack_delete_transaction( pack, fd_txn_get_signatures( (fd_txn_t *)txn_scratch[ i ], payload_scratch[ i ] ) );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+  fd_pack_publish_fee_stats( pack );
+  FD_TEST( fd_fee_stats_read( stats, accts, &pending_cnt )==0UL );
+  FD_TEST( pending_cnt==0UL );
+
+  fd_fee_stats_delete( fd_fee_stats_leave( stats ) );
+}
+
+/* Returns the shard of the account made of c repeated. */
+static ulong
+shard_of_char( char  c,
+               ulong shard_cnt ) {
+  fd_acct_addr_t acct[1];
+  memset( acct->b, c, FD_TXN_ACCT_ADDR_SZ );
+  return fd_pack_shard_of( acct, shard_cnt );
+}
+
+static void
+test_shard( void ) {
+  FD_LOG_NOTICE(( "TEST SHARD" ));
+  FD_TEST( !fd_pack_shard_ctl_new( shard_ctl_scratch, 0UL ) );
+  FD_TEST( !fd_pack_shard_ctl_new( shard_ctl_scratch, FD_PACK_SHARD_MAX+1UL ) );
+  fd_pack_shard_ctl_t * ctl = fd_pack_shard_ctl_join( fd_pack_shard_ctl_new( shard_ctl_scratch, 2UL ) );
+  FD_TEST( ctl );
+  FD_TEST( fd_pack_shard_ctl_shard_cnt( ctl )==2UL );
+
+  /* Routing.  c0 and c1 are accounts in different shards, and
+     transaction i's fee payer is in c0's shard.  The programs a
+     transaction invokes don't count. */
+  char c0 = 'A';
+  char c1 = 'B';
+  while( shard_of_char( c1, 2UL )==shard_of_char( c0, 2UL ) ) c1++;
+  ulong s0 = shard_of_char( c0, 2UL );
+  ulong i  = 0UL;
+  for(;;) {
+    make_transaction( i, 500U, 11.0, "", "" );
+    fd_txn_t * txn = (fd_txn_t *)txn_scratch[ i ];
+    if( fd_pack_shard_of( fd_txn_get_acct_addrs( txn, payload_scratch[ i ] ), 2UL )==s0 ) break;
+    i++;
+  }
+  char w0[ 2 ] = { c0, '\0' };  char w1[ 2 ] = { c1, '\0' };  char w01[ 3 ] = { c0, c1, '\0' };
+  fd_txn_t * txn = (fd_txn_t *)txn_scratch[ i ];
+  make_transaction( i, 500U, 11.0, w0,  ""  ); FD_TEST( fd_pack_shard_route( txn, payload_scratch[ i ], NULL, 2UL )==s0 );
+  FD_TEST( fd_pack_shard_route( txn, payload_scratch[ i ], NULL, 1UL )==0UL );
+  make_transaction( i, 500U, 11.0, "",  w0  ); FD_TEST( fd_pack_shard_route( txn, payload_scratch[ i ], NULL, 2UL )==s0 );
+  make_transaction( i, 500U, 11.0, w01, ""  ); FD_TEST( fd_pack_shard_route( txn, payload_scratch[ i ], NULL, 2UL )==FD_PACK_SHARD_CROSS );
+  make_transaction( i, 500U, 11.0, w0,  w1  ); FD_TEST( fd_pack_shard_route( txn, payload_scratch[ i ], NULL, 2UL )==FD_PACK_SHARD_CROSS );
+
+  /* Accounts loaded from a table count only if they can be resolved */
+  fd_alt_cache_t * cache = fd_alt_cache_join( fd_alt_cache_new( alt_cache_scratch, ALT_CACHE_ENTRY_CNT ) );
+  fd_acct_addr_t table[1];  memset( table->b, 'T', FD_TXN_ACCT_ADDR_SZ );
+  fd_acct_addr_t contents[ 2 ];
+  memset( contents[ 0 ].b, c0, FD_TXN_ACCT_ADDR_SZ );
+  memset( contents[ 1 ].b, c1, FD_TXN_ACCT_ADDR_SZ );
+  fd_alt_cache_insert( cache, table, contents, 2UL );
+  uchar idx0[ 1 ] = { 0 };  uchar idx1[ 1 ] = { 1 };
+  make_transaction( i, 500U, 11.0, w0, "" ); add_lookup( i, 'T', idx0, 1UL, NULL, 0UL );
+  FD_TEST( fd_pack_shard_route( txn, payload_scratch[ i ], NULL,  2UL )==FD_PACK_SHARD_CROSS );
+  FD_TEST( fd_pack_shard_route( txn, payload_scratch[ i ], cache, 2UL )==s0 );
+  make_transaction( i, 500U, 11.0, w0, "" ); add_lookup( i, 'T', NULL, 0UL, idx1, 1UL );
+  FD_TEST( fd_pack_shard_route( txn, payload_scratch[ i ], cache, 2UL )==FD_PACK_SHARD_CROSS );
+  fd_alt_cache_delete( fd_alt_cache_leave( cache ) );
+
+  /* Budget counters: reservations stop at the limit, and what's given
+     back after the block ended isn't taken off the next one */
+  ulong gen0, gen1;
+  ulong block_gen = fd_pack_shard_ctl_block_gen( ctl );
+  FD_TEST( fd_pack_shard_ctl_reserve( ctl, FD_PACK_SHARD_BUDGET_BLOCK, 100UL, 60UL, &gen0 )==60UL );
+  FD_TEST( fd_pack_shard_ctl_reserve( ctl, FD_PACK_SHARD_BUDGET_BLOCK, 100UL, 60UL, &gen1 )==40UL );
+  FD_TEST( fd_pack_shard_ctl_reserve( ctl, FD_PACK_SHARD_BUDGET_BLOCK, 100UL, 60UL, &gen1 )==0UL  );
+  fd_pack_shard_ctl_unreserve( ctl, FD_PACK_SHARD_BUDGET_BLOCK, gen0, 10UL );
+  FD_TEST( fd_pack_shard_ctl_used( ctl, FD_PACK_SHARD_BUDGET_BLOCK )==90UL );
+  FD_TEST( fd_pack_shard_ctl_used( ctl, FD_PACK_SHARD_BUDGET_VOTE  )==0UL  );
+  fd_pack_shard_ctl_new_block( ctl );
+  fd_pack_shard_ctl_unreserve( ctl, FD_PACK_SHARD_BUDGET_BLOCK, gen0, 50UL );
+  FD_TEST( fd_pack_shard_ctl_used( ctl, FD_PACK_SHARD_BUDGET_BLOCK )==0UL );
+  FD_TEST( fd_pack_shard_ctl_reserve( ctl, FD_PACK_SHARD_BUDGET_BLOCK, 100UL, 60UL, &gen1 )==60UL );
+  FD_TEST( gen1!=gen0 );
+  fd_pack_shard_ctl_new_block( ctl );
+  FD_TEST( ((fd_pack_shard_ctl_block_gen( ctl )-block_gen) & ((1UL<<FD_PACK_SHARD_GEN_BITS)-1UL))==2UL );
+
+  /* Barrier: a shard only parks once it's idle */
+  FD_TEST( fd_pack_shard_ctl_may_schedule( ctl, 0UL, 1 ) );
+  fd_pack_shard_ctl_request( ctl );
+  FD_TEST( !fd_pack_shard_ctl_quiesced( ctl ) );
+  FD_TEST( !fd_pack_shard_ctl_may_schedule( ctl, 0UL, 0 ) );
+  FD_TEST( !fd_pack_shard_ctl_may_schedule( ctl, 1UL, 1 ) );
+  FD_TEST( !fd_pack_shard_ctl_quiesced( ctl ) );
+  FD_TEST( !fd_pack_shard_ctl_may_schedule( ctl, 0UL, 1 ) );
+  FD_TEST(  fd_pack_shard_ctl_quiesced( ctl ) );
+  fd_pack_shard_ctl_release( ctl );
+  FD_TEST( fd_pack_shard_ctl_may_schedule( ctl, 0UL, 1 ) );
+  FD_TEST( fd_pack_shard_ctl_may_schedule( ctl, 1UL, 1 ) );
+
+  /* The block limit is shared between the pack objects.  The
+     transactions only write their fee payers, so that the per-account
+     limit doesn't get in the way. */
+  if( 1 ) {
+    fd_pack_t * pack0 = init_all( 1024UL, 1UL, 1024UL, &outcome );
+    ulong footprint = fd_ulong_align_up( fd_pack_footprint( 1024UL, 1UL, 1024UL ), fd_pack_align() );
+    FD_TEST( 2UL*footprint<=PACK_SCRATCH_SZ );
+    fd_pack_t * pack1 = fd_pack_join( fd_pack_new( pack_scratch+footprint, 1024UL, 1UL, 1024UL, rng ) );
+    fd_pack_set_shard_ctl( pack0, ctl, 0 );
+    fd_pack_set_shard_ctl( pack1, ctl, 0 );
+
+    ulong k=0UL;
+    for( ulong j=0UL; j<FD_PACK_MAX_COST_PER_BLOCK/4000004UL; j++ ) {
+      make_transaction( k, 1000001U, 11.0, "", "" ); insert( k++, pack0 );
+      make_transaction( k, 1000001U, 11.0, "", "" ); insert( k++, pack0 );
+      make_transaction( k, 1000001U, 11.0, "", "" ); insert( k++, pack0 );
+      make_transaction( k, 1000001U, 11.0, "", "" ); insert( k++, pack0 );
+      schedule_validate_complete( pack0, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 4UL, 0UL, &outcome );
+    }
+    FD_TEST( fd_pack_shard_ctl_used( ctl, FD_PACK_SHARD_BUDGET_BLOCK )>FD_PACK_MAX_COST_PER_BLOCK-4000004UL );
+
+    make_transaction( k, 1000001U, 11.0, "", "" ); insert( k++, pack1 );
+    make_transaction( k, 1000001U, 11.0, "", "" ); insert( k++, pack1 );
+    make_transaction( k, 1000001U, 11.0, "", "" ); insert( k++, pack1 );
+    make_transaction( k, 1000001U, 10.0, "", "" ); insert( k++, pack1 );
+    schedule_validate_complete( pack1, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 3UL, 0UL, &outcome );
+    FD_TEST( fd_pack_avail_txn_cnt( pack1 )==1UL );
+    FD_TEST( fd_pack_shard_ctl_used( ctl, FD_PACK_SHARD_BUDGET_BLOCK )<=FD_PACK_MAX_COST_PER_BLOCK );
+
+    fd_pack_end_block( pack0 );
+    fd_pack_end_block( pack1 );
+    schedule_validate_complete( pack1, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 0UL, 0UL, &outcome );
+    FD_TEST( fd_pack_avail_txn_cnt( pack1 )==1UL );
+    fd_pack_shard_ctl_new_block( ctl );
+    schedule_validate_complete( pack1, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 1UL, 0UL, &outcome );
+
+    fd_pack_delete( fd_pack_leave( pack1 ) );
+  }
+
+  /* The coordinator gets FD_PACK_SHARD_COORD_WRITE_COST per account */
+  if( 1 ) {
+    fd_pack_t * pack = init_all( 1024UL, 1UL, 1024UL, &outcome );
+    fd_pack_shard_ctl_new_block( ctl );
+    fd_pack_set_shard_ctl( pack, ctl, 1 );
+    ulong per_block = FD_PACK_SHARD_COORD_WRITE_COST/1000001UL;
+    for( ulong j=0UL; j<per_block; j++ ) {
+      make_transaction( 0UL, 1000001U, 11.0, "A", "B" ); insert( 0UL, pack );
+      schedule_validate_complete( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 1UL, 0UL, &outcome );
+    }
+    make_transaction( 0UL, 1000001U, 11.0, "A", "B" ); insert( 0UL, pack );
+    schedule_validate_complete( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 0UL, 0UL, &outcome );
+    FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+    fd_pack_end_block( pack );
+    fd_pack_shard_ctl_new_block( ctl );
+    schedule_validate_complete( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 1UL, 0UL, &outcome );
+    fd_pack_set_shard_ctl( pack, NULL, 0 );
+  }
+
+  fd_pack_shard_ctl_delete( fd_pack_shard_ctl_leave( ctl ) );
 }
 
 static void
@@ -493,7 +1410,7 @@ test_limits( void ) {
       insert( i, pack );
     }
     FD_TEST( fd_pack_avail_txn_cnt( pack )==max*2UL );
-    schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 1.0f, max, 0UL, &outcome );
+    schedule_validate_complete( pack, FD_PACK_MAX_COST_PER_BLOCK, 1.0f, max, 0UL, &outcome );
     FD_TEST( fd_pack_avail_txn_cnt( pack )==max     );
   }
 
@@ -510,7 +1427,7 @@ test_limits( void ) {
     for( ulong cu_limit=0UL; cu_limit<45UL*SAMPLE_VOTE_COST; cu_limit += SAMPLE_VOTE_COST ) {
       /* FIXME: CU limit for votes is done based on the typical cost,
          which is slightly different from the sample vote cost. */
-      schedule_validate_microblock( pack, cu_limit*3437/SAMPLE_VOTE_COST, 1.0f, cu_limit/SAMPLE_VOTE_COST, 0UL, &outcome );
+      schedule_validate_complete( pack, cu_limit*3437/SAMPLE_VOTE_COST, 1.0f, cu_limit/SAMPLE_VOTE_COST, 0UL, &outcome );
     }
     /* sum_{x=0}^44 x = 990, so there should be 34 transactions left */
     FD_TEST( fd_pack_avail_txn_cnt( pack )==34UL );
@@ -523,18 +1440,18 @@ test_limits( void ) {
 
     for( ulong j=0UL; j<FD_PACK_MAX_VOTE_COST_PER_BLOCK/(1024UL*SAMPLE_VOTE_COST); j++ ) {
       for( ulong i=0UL; i<1024UL; i++ ) { make_vote_transaction( i ); insert( i, pack ); }
-      schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 1.0f, 1024UL, 0UL, &outcome );
+      schedule_validate_complete( pack, FD_PACK_MAX_COST_PER_BLOCK, 1.0f, 1024UL, 0UL, &outcome );
     }
 
     for( ulong i=0UL; i<1024UL; i++ ) { make_vote_transaction( i ); insert( i, pack ); }
     ulong consumed_cost = (1024UL*SAMPLE_VOTE_COST)*(FD_PACK_MAX_VOTE_COST_PER_BLOCK/(1024UL*SAMPLE_VOTE_COST));
     ulong expected_votes = (FD_PACK_MAX_VOTE_COST_PER_BLOCK-consumed_cost)/SAMPLE_VOTE_COST;
 
-    schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 1.0f,        expected_votes, 0UL, &outcome );
+    schedule_validate_complete( pack, FD_PACK_MAX_COST_PER_BLOCK, 1.0f,        expected_votes, 0UL, &outcome );
     FD_TEST( fd_pack_avail_txn_cnt( pack )==1024UL-expected_votes );
 
     fd_pack_end_block( pack );
-    schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 1.0f, 1024UL-expected_votes, 0UL, &outcome );
+    schedule_validate_complete( pack, FD_PACK_MAX_COST_PER_BLOCK, 1.0f, 1024UL-expected_votes, 0UL, &outcome );
   }
 
 
@@ -547,16 +1464,16 @@ test_limits( void ) {
     for( ulong j=0UL; j<FD_PACK_MAX_WRITE_COST_PER_ACCT/1000001UL; j++ ) {
       make_transaction( 0UL, 1000001U, 11.0, "A", "B" );
       insert( 0UL, pack );
-      schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 1UL, 0UL, &outcome );
+      schedule_validate_complete( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 1UL, 0UL, &outcome );
     }
 
     make_transaction( 0UL, 1000001U, 11.0, "A", "B" );
     insert( 0UL, pack );
-    schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 0UL, 0UL, &outcome );
+    schedule_validate_complete( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 0UL, 0UL, &outcome );
     FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
 
     fd_pack_end_block( pack );
-    schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 1UL, 0UL, &outcome );
+    schedule_validate_complete( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 1UL, 0UL, &outcome );
   }
 
 
@@ -572,18 +1489,18 @@ test_limits( void ) {
       make_transaction( i, 1000001U, 11.0, "C", "D" );     insert( i++, pack );
       make_transaction( i, 1000001U, 11.0, "E", "F" );     insert( i++, pack );
       make_transaction( i, 1000001U, 11.0, "G", "H" );     insert( i++, pack );
-      schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 4UL, 0UL, &outcome );
+      schedule_validate_complete( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 4UL, 0UL, &outcome );
     }
 
     make_transaction( i, 1000001U, 11.0, "J", "K" );     insert( i++, pack );
     make_transaction( i, 1000001U, 11.0, "L", "M" );     insert( i++, pack );
     make_transaction( i, 1000001U, 11.0, "N", "P" );     insert( i++, pack );
     make_transaction( i, 1000001U, 10.0, "Q", "R" );     insert( i++, pack );
-    schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 3UL, 0UL, &outcome );
+    schedule_validate_complete( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 3UL, 0UL, &outcome );
     FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
 
     fd_pack_end_block( pack );
-    schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 1UL, 0UL, &outcome );
+    schedule_validate_complete( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 1UL, 0UL, &outcome );
   }
 }
 
@@ -598,10 +1515,20 @@ main( int     argc,
   test1();
   test2();
   test_vote();
+  test_vote_lane();
   performance_test();
   heap_overflow_test();
   test_delete();
-  test_gap();
+  test_eviction();
+  test_expiry();
+  test_cu_est();
+  test_bank_tiles();
+  test_blocked();
+  test_bundle();
+  test_alt();
+  test_fee_payer();
+  test_fee_stats();
+  test_shard();
   test_limits();
 
   fd_rng_delete( fd_rng_leave( rng ) );
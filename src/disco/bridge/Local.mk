@@ -0,0 +1,4 @@
+$(call add-hdrs,fd_bridge.h)
+$(call add-objs,fd_bridge,fd_disco)
+$(call make-bin,fd_bridge_tile,fd_bridge_tile,fd_disco fd_tango fd_util)
+$(call make-unit-test,test_bridge,test_bridge,fd_disco fd_tango fd_util)
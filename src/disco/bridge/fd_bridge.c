@@ -0,0 +1,482 @@
+#include "fd_bridge.h"
+
+/* fd_bridge_private_copy copies the sz byte payload at src to dst.
+   src and dst are assumed FD_CHUNK_ALIGN aligned and the regions they
+   point to are assumed to extend at least to the next FD_CHUNK_SZ
+   boundary past sz (true for frags in the data region of a dcache and
+   for frags reserved with fd_dcache_compact_next), so the copy is done
+   in whole chunks.  On targets with AVX, the copy uses non-temporal
+   stores and the caller should do a store fence before publishing the
+   copy to consumers. */
+
+static inline void
+fd_bridge_private_copy( uchar *       dst,
+                        uchar const * src,
+                        ulong         sz ) {
+# if FD_HAS_AVX
+  for( ulong off=0UL; off<sz; off+=FD_CHUNK_SZ ) {
+    __m256i a = _mm256_load_si256( (__m256i const *)(src+off     ) );
+    __m256i b = _mm256_load_si256( (__m256i const *)(src+off+32UL) );
+    _mm256_stream_si256( (__m256i *)(dst+off     ), a );
+    _mm256_stream_si256( (__m256i *)(dst+off+32UL), b );
+  }
+# else
+  fd_memcpy( dst, src, sz );
+# endif
+}
+
+/* fd_bridge_private_in_update returns flow control credits to the in
+   up to (but not including) frag seq and drains the run-time
+   diagnostics accumulated since the last update.  See fd_mux_tile for
+   notes on the quasi-atomic draining. */
+
+static inline void
+fd_bridge_private_in_update( ulong * in_fseq,
+                             ulong   seq,
+                             uint *  accum ) {
+  fd_fseq_update( in_fseq, seq );
+
+  ulong * diag = (ulong *)fd_fseq_app_laddr( in_fseq );
+  ulong a0 = (ulong)accum[0]; ulong a1 = (ulong)accum[1]; ulong a2 = (ulong)accum[2];
+  ulong a3 = (ulong)accum[3]; ulong a4 = (ulong)accum[4]; ulong a5 = (ulong)accum[5];
+  FD_COMPILER_MFENCE();
+  diag[0] += a0;              diag[1] += a1;              diag[2] += a2;
+  diag[3] += a3;              diag[4] += a4;              diag[5] += a5;
+  FD_COMPILER_MFENCE();
+  accum[0] = 0U;              accum[1] = 0U;              accum[2] = 0U;
+  accum[3] = 0U;              accum[4] = 0U;              accum[5] = 0U;
+}
+
+#define SCRATCH_ALLOC( a, s ) (__extension__({                    \
+    ulong _scratch_alloc = fd_ulong_align_up( scratch_top, (a) ); \
+    scratch_top = _scratch_alloc + (s);                           \
+    (void *)_scratch_alloc;                                       \
+  }))
+
+ulong
+fd_bridge_tile_scratch_align( void ) {
+  return FD_BRIDGE_TILE_SCRATCH_ALIGN;
+}
+
+ulong
+fd_bridge_tile_scratch_footprint( ulong out_cnt ) {
+  if( FD_UNLIKELY( out_cnt>FD_BRIDGE_TILE_OUT_MAX ) ) return 0UL;
+  ulong scratch_top = 0UL;
+  SCRATCH_ALLOC( alignof(ulong const *), out_cnt*sizeof(ulong const *) ); /* out_fseq */
+  SCRATCH_ALLOC( alignof(ulong *),       out_cnt*sizeof(ulong *)       ); /* out_slow */
+  SCRATCH_ALLOC( alignof(ulong),         out_cnt*sizeof(ulong)         ); /* out_seq */
+  SCRATCH_ALLOC( alignof(ushort),        (out_cnt+2UL)*sizeof(ushort)  ); /* event_map */
+  return fd_ulong_align_up( scratch_top, fd_bridge_tile_scratch_align() );
+}
+
+int
+fd_bridge_tile( fd_cnc_t *             cnc,
+                fd_frag_meta_t const * in_mcache,
+                uchar const *          in_dcache,
+                ulong *                in_fseq,
+                fd_frag_meta_t *       mcache,
+                uchar *                dcache,
+                ulong                  mtu,
+                ulong                  out_cnt,
+                ulong **               _out_fseq,
+                ulong                  cr_max,
+                long                   lazy,
+                fd_rng_t *             rng,
+                void *                 scratch ) {
+
+  /* cnc state */
+  ulong * cnc_diag;           /* ==fd_cnc_app_laddr( cnc ), local address of the bridge tile cnc diagnostic region */
+  ulong   cnc_diag_in_backp;  /* is the run loop currently backpressured by one or more of the outs, in [0,1] */
+  ulong   cnc_diag_backp_cnt; /* Accumulates number of transitions of tile to backpressured between housekeeping events */
+
+  /* in frag stream state */
+  ulong         in_depth;  /* ==fd_mcache_depth( in_mcache ), depth of the in's mcache (const) */
+  ulong         in_seq;    /* sequence number of next frag expected from the in */
+  void const *  in_base;   /* ==fd_wksp_containing( in_dcache ), in frag chunks are relative to this */
+  ulong         in_chunk0; /* ==fd_dcache_compact_chunk0( in_base, in_dcache ), first chunk of the in's data region */
+  ulong         in_chunk1; /* ==fd_dcache_compact_chunk1( in_base, in_dcache ), one past last chunk of the in's data region */
+  uint          in_accum[6]; /* local diagnostic accumulators, drained during in housekeeping */
+                             /* Assumes FD_FSEQ_DIAG_{PUB_CNT,PUB_SZ,FILT_CNT,FILT_SZ,OVRNP_CNT,OVRNR_CONT} are 0:5 */
+
+  /* out frag stream state */
+  ulong   depth;  /* ==fd_mcache_depth( mcache ), depth of the mcache / positive integer power of 2 */
+  ulong * sync;   /* ==fd_mcache_seq_laddr( mcache ), local addr where bridge mcache sync info is published */
+  ulong   seq;    /* next bridge frag sequence number to publish */
+  void *  base;   /* ==fd_wksp_containing( dcache ), out frag chunks are relative to this */
+  ulong   chunk0; /* ==fd_dcache_compact_chunk0( base, dcache ) */
+  ulong   wmark;  /* ==fd_dcache_compact_wmark ( base, dcache, mtu ) */
+  ulong   chunk;  /* chunk where the next frag payload will be copied, in [chunk0,wmark] */
+
+  /* out flow control state */
+  ulong          cr_avail; /* number of flow control credits available to publish downstream, in [0,cr_max] */
+  ulong const ** out_fseq; /* out_fseq[out_idx] for out_idx in [0,out_cnt) is where to receive fctl credits from outs */
+  ulong **       out_slow; /* out_slow[out_idx] for out_idx in [0,out_cnt) is where to accumulate slow events */
+  ulong *        out_seq;  /* out_seq [out_idx] is the most recent observation of out_fseq[out_idx] */
+
+  /* housekeeping state */
+  ulong    event_cnt; /* ==out_cnt+2, total number of housekeeping events */
+  ulong    event_seq; /* current position in housekeeping event sequence, in [0,event_cnt) */
+  ushort * event_map; /* current mapping of event_seq to event idx, event_map[ event_seq ] is next event to process */
+  ulong    async_min; /* minimum number of ticks between processing a housekeeping event, positive integer power of 2 */
+
+  do {
+
+    FD_LOG_INFO(( "Booting bridge (out-cnt %lu)", out_cnt ));
+    if( FD_UNLIKELY( out_cnt>FD_BRIDGE_TILE_OUT_MAX ) ) { FD_LOG_WARNING(( "out_cnt too large" )); return 1; }
+
+    if( FD_UNLIKELY( !scratch ) ) {
+      FD_LOG_WARNING(( "NULL scratch" ));
+      return 1;
+    }
+
+    if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)scratch, fd_bridge_tile_scratch_align() ) ) ) {
+      FD_LOG_WARNING(( "misaligned scratch" ));
+      return 1;
+    }
+
+    ulong scratch_top = (ulong)scratch;
+
+    /* cnc state init */
+
+    if( FD_UNLIKELY( !cnc ) ) { FD_LOG_WARNING(( "NULL cnc" )); return 1; }
+    if( FD_UNLIKELY( fd_cnc_app_sz( cnc )<16UL ) ) { FD_LOG_WARNING(( "cnc app sz must be at least 16" )); return 1; }
+    if( FD_UNLIKELY( fd_cnc_signal_query( cnc )!=FD_CNC_SIGNAL_BOOT ) ) { FD_LOG_WARNING(( "already booted" )); return 1; }
+
+    cnc_diag = (ulong *)fd_cnc_app_laddr( cnc );
+
+    /* in_backp==1, backp_cnt==0 indicates waiting for initial credits,
+       cleared during first housekeeping if credits available */
+    cnc_diag_in_backp  = 1UL;
+    cnc_diag_backp_cnt = 0UL;
+
+    /* in frag stream init */
+
+    if( FD_UNLIKELY( !in_mcache ) ) { FD_LOG_WARNING(( "NULL in_mcache" )); return 1; }
+    if( FD_UNLIKELY( !in_dcache ) ) { FD_LOG_WARNING(( "NULL in_dcache" )); return 1; }
+    if( FD_UNLIKELY( !in_fseq   ) ) { FD_LOG_WARNING(( "NULL in_fseq"   )); return 1; }
+
+    in_base = fd_wksp_containing( in_dcache );
+    if( FD_UNLIKELY( !in_base ) ) { FD_LOG_WARNING(( "in_dcache must be in a wksp" )); return 1; }
+
+    in_depth  = fd_mcache_depth( in_mcache );
+    in_seq    = fd_mcache_seq_query( fd_mcache_seq_laddr_const( in_mcache ) ); /* FIXME: ALLOW OPTION FOR MANUAL SPECIFICATION? */
+    in_chunk0 = fd_dcache_compact_chunk0( in_base, in_dcache );
+    in_chunk1 = fd_dcache_compact_chunk1( in_base, in_dcache );
+
+    in_accum[0] = 0U; in_accum[1] = 0U; in_accum[2] = 0U;
+    in_accum[3] = 0U; in_accum[4] = 0U; in_accum[5] = 0U;
+
+    /* out frag stream init */
+
+    if( FD_UNLIKELY( !mcache ) ) { FD_LOG_WARNING(( "NULL mcache" )); return 1; }
+    if( FD_UNLIKELY( !dcache ) ) { FD_LOG_WARNING(( "NULL dcache" )); return 1; }
+
+    depth = fd_mcache_depth    ( mcache );
+    sync  = fd_mcache_seq_laddr( mcache );
+    seq   = fd_mcache_seq_query( sync ); /* FIXME: ALLOW OPTION FOR MANUAL SPECIFICATION */
+
+    base = fd_wksp_containing( dcache );
+    if( FD_UNLIKELY( !base ) ) { FD_LOG_WARNING(( "dcache must be in a wksp" )); return 1; }
+
+    if( FD_UNLIKELY( !mtu ) ) { FD_LOG_WARNING(( "zero mtu" )); return 1; }
+    if( FD_UNLIKELY( !fd_dcache_compact_is_safe( base, dcache, mtu, depth ) ) ) {
+      FD_LOG_WARNING(( "dcache not compatible with mtu %lu and mcache depth %lu", mtu, depth ));
+      return 1;
+    }
+
+    chunk0 = fd_dcache_compact_chunk0( base, dcache );
+    wmark  = fd_dcache_compact_wmark ( base, dcache, mtu );
+    chunk  = chunk0;
+
+    /* out flow control init (see fd_mux_tile for details).  Since the
+       bridge copies payloads, credits returned to the in do not depend
+       on how many frags are exposed to the outs, so cr_max is only
+       limited by the out mcache depth. */
+
+    if( !cr_max ) cr_max = depth; /* use default */
+    FD_LOG_INFO(( "Using cr_max %lu", cr_max ));
+    if( FD_UNLIKELY( !((1UL<=cr_max) & (cr_max<=depth)) ) ) {
+      FD_LOG_WARNING(( "cr_max %lu must be in [1,%lu] for this mcache", cr_max, depth ));
+      return 1;
+    }
+
+    cr_avail = 0UL; /* Will be initialized by run loop */
+
+    out_fseq = (ulong const **)SCRATCH_ALLOC( alignof(ulong const *), out_cnt*sizeof(ulong const *) );
+    out_slow = (ulong **)      SCRATCH_ALLOC( alignof(ulong *),       out_cnt*sizeof(ulong *)       );
+    out_seq  = (ulong *)       SCRATCH_ALLOC( alignof(ulong),         out_cnt*sizeof(ulong)         );
+
+    if( FD_UNLIKELY( !!out_cnt && !_out_fseq ) ) { FD_LOG_WARNING(( "NULL out_fseq" )); return 1; }
+    for( ulong out_idx=0UL; out_idx<out_cnt; out_idx++ ) {
+      if( FD_UNLIKELY( !_out_fseq[ out_idx ] ) ) { FD_LOG_WARNING(( "NULL out_fseq[%lu]", out_idx )); return 1; }
+      out_fseq[ out_idx ] = _out_fseq[ out_idx ];
+      out_slow[ out_idx ] = (ulong *)fd_fseq_app_laddr( _out_fseq[ out_idx ] ) + FD_FSEQ_DIAG_SLOW_CNT;
+      out_seq [ out_idx ] = fd_fseq_query( out_fseq[ out_idx ] );
+    }
+
+    /* housekeeping init */
+
+    if( lazy<=0L ) lazy = fd_tempo_lazy_default( cr_max );
+    FD_LOG_INFO(( "Configuring housekeeping (lazy %li ns)", lazy ));
+
+    /* Initialize the initial housekeeping event sequence to immediately
+       update cr_avail on the first run loop iteration and then update
+       the in accordingly.  event_idx:
+         <out_cnt   - receive credits from out event_idx
+         ==out_cnt  - housekeeping
+         >out_cnt   - send credits to the in */
+
+    event_cnt = out_cnt + 2UL;
+    event_map = (ushort *)SCRATCH_ALLOC( alignof(ushort), event_cnt*sizeof(ushort) );
+    event_seq = 0UL;                                     event_map[ event_seq++ ] = (ushort)out_cnt;
+    /**/                                                 event_map[ event_seq++ ] = (ushort)(out_cnt+1UL);
+    for( ulong out_idx=0UL; out_idx<out_cnt; out_idx++ ) event_map[ event_seq++ ] = (ushort)out_idx;
+    event_seq = 0UL;
+
+    async_min = fd_tempo_async_min( lazy, event_cnt, (float)fd_tempo_tick_per_ns( NULL ) );
+    if( FD_UNLIKELY( !async_min ) ) { FD_LOG_WARNING(( "bad lazy" )); return 1; }
+
+  } while(0);
+
+  FD_LOG_INFO(( "Running bridge" ));
+  fd_cnc_signal( cnc, FD_CNC_SIGNAL_RUN );
+  long then = fd_tickcount();
+  long now  = then;
+  for(;;) {
+
+    /* Do housekeeping at a low rate in the background */
+
+    if( FD_UNLIKELY( (now-then)>=0L ) ) {
+      ulong event_idx = (ulong)event_map[ event_seq ];
+
+      if( FD_LIKELY( event_idx<out_cnt ) ) { /* out fctl for out out_idx */
+        ulong out_idx = event_idx;
+
+        /* Receive flow control credits from this out. */
+        out_seq[ out_idx ] = fd_fseq_query( out_fseq[ out_idx ] );
+
+      } else if( FD_LIKELY( event_idx>out_cnt ) ) { /* in fctl */
+
+        /* Send flow control credits and drain flow control diagnostics
+           for the in.  All frags before in_seq have been copied, so
+           they can all be returned. */
+        fd_bridge_private_in_update( in_fseq, in_seq, in_accum );
+
+      } else { /* event_idx==out_cnt, housekeeping event */
+
+        /* Send synchronization info */
+        fd_mcache_seq_update( sync, seq );
+
+        /* Send diagnostic info */
+        fd_cnc_heartbeat( cnc, now );
+        FD_COMPILER_MFENCE();
+        cnc_diag[ FD_CNC_DIAG_IN_BACKP  ]  = cnc_diag_in_backp;
+        cnc_diag[ FD_CNC_DIAG_BACKP_CNT ] += cnc_diag_backp_cnt;
+        FD_COMPILER_MFENCE();
+        cnc_diag_backp_cnt = 0UL;
+
+        /* Receive command-and-control signals */
+        ulong s = fd_cnc_signal_query( cnc );
+        if( FD_UNLIKELY( s!=FD_CNC_SIGNAL_RUN ) ) {
+          if( FD_LIKELY( s==FD_CNC_SIGNAL_HALT ) ) break;
+          if( FD_UNLIKELY( s!=FD_BRIDGE_CNC_SIGNAL_ACK ) ) {
+            char buf[ FD_CNC_SIGNAL_CSTR_BUF_MAX ];
+            FD_LOG_WARNING(( "Unexpected signal %s (%lu) received; trying to resume", fd_cnc_signal_cstr( s, buf ), s ));
+          }
+          fd_cnc_signal( cnc, FD_CNC_SIGNAL_RUN );
+        }
+
+        /* Receive flow control credits */
+        if( FD_LIKELY( cr_avail<cr_max ) ) {
+          ulong slowest_out = ULONG_MAX;
+          cr_avail = cr_max;
+          for( ulong out_idx=0UL; out_idx<out_cnt; out_idx++ ) {
+            ulong out_cr_avail = (ulong)fd_long_max( (long)cr_max-fd_long_max( fd_seq_diff( seq, out_seq[ out_idx ] ), 0L ), 0L );
+            slowest_out = fd_ulong_if( out_cr_avail<cr_avail, out_idx, slowest_out );
+            cr_avail    = fd_ulong_min( out_cr_avail, cr_avail );
+          }
+          /* See notes in fd_mux_tile about use of quasi-atomic diagnostic accum */
+          if( FD_LIKELY( slowest_out!=ULONG_MAX ) ) {
+            FD_COMPILER_MFENCE();
+            out_slow[ slowest_out ]++;
+            FD_COMPILER_MFENCE();
+          }
+        }
+      }
+
+      /* Select which event to do next (randomized round robin) and
+         reload the housekeeping timer. */
+
+      event_seq++;
+      if( FD_UNLIKELY( event_seq>=event_cnt ) ) {
+        event_seq = 0UL;
+        ulong  swap_idx = (ulong)fd_rng_uint_roll( rng, (uint)event_cnt );
+        ushort map_tmp        = event_map[ swap_idx ];
+        event_map[ swap_idx ] = event_map[ 0        ];
+        event_map[ 0        ] = map_tmp;
+      }
+
+      then = now + (long)fd_tempo_async_reload( rng, async_min );
+    }
+
+    /* Check if we are backpressured (see fd_mux_tile for details) */
+
+    if( FD_UNLIKELY( !cr_avail ) ) {
+      cnc_diag_backp_cnt += (ulong)!cnc_diag_in_backp;
+      cnc_diag_in_backp   = 1UL;
+      FD_SPIN_PAUSE();
+      now = fd_tickcount();
+      continue;
+    }
+    cnc_diag_in_backp = 0UL;
+
+    /* Gather a batch of up to min(cr_avail,BATCH_MAX) frags that are
+       ready from the in and prefetch their payloads.  This should
+       always be overrun free if the in is honoring our flow control
+       (we can cheaply detect if it isn't).  An overrun part way through
+       the batch just ends the batch; it will be detected when the batch
+       is validated below or on the next poll. */
+
+    fd_frag_meta_t batch    [ FD_BRIDGE_TILE_BATCH_MAX ] __attribute__((aligned(FD_FRAG_META_ALIGN)));
+    uchar const *  batch_src[ FD_BRIDGE_TILE_BATCH_MAX ];
+
+    ulong batch_max = fd_ulong_min( cr_avail, FD_BRIDGE_TILE_BATCH_MAX );
+    ulong batch_cnt = 0UL;
+    ulong batch_seq = in_seq;
+    do {
+      fd_frag_meta_t const * mline = in_mcache + fd_mcache_line_idx( batch_seq, in_depth );
+
+      FD_COMPILER_MFENCE();
+      ulong seq_found = mline->seq;
+      FD_COMPILER_MFENCE();
+
+      long diff = fd_seq_diff( batch_seq, seq_found );
+      if( FD_UNLIKELY( diff ) ) { /* Caught up or overrun, optimize for new frag case */
+        if( FD_UNLIKELY( (diff<0L) & !batch_cnt ) ) { /* Overrun (impossible if in is honoring our flow control) */
+          in_seq = seq_found; /* Resume from here (probably reasonably current, could query in mcache sync instead) */
+          in_accum[ FD_FSEQ_DIAG_OVRNP_CNT ]++;
+        }
+        break;
+      }
+
+      FD_COMPILER_MFENCE();
+      ulong sig      =        mline->sig;
+      ulong in_chunk = (ulong)mline->chunk;
+      ulong sz       = (ulong)mline->sz;
+      ulong ctl      = (ulong)mline->ctl;
+      ulong tsorig   = (ulong)mline->tsorig;
+      FD_COMPILER_MFENCE();
+      ulong seq_test =        mline->seq;
+      FD_COMPILER_MFENCE();
+
+      if( FD_UNLIKELY( fd_seq_ne( seq_test, seq_found ) ) ) { /* Overrun while reading (impossible if in honoring our fctl) */
+        if( !batch_cnt ) {
+          in_seq = seq_test; /* Resume from here */
+          in_accum[ FD_FSEQ_DIAG_OVRNR_CNT ]++;
+        }
+        break;
+      }
+
+      /* Only copy frags that fit in our mtu and whose payload is in the
+         in's data region (no overflow as chunk and sz are narrow). */
+
+      ulong in_chunk_cnt = (sz + FD_CHUNK_SZ-1UL) >> FD_CHUNK_LG_SZ;
+      int   valid        = (sz<=mtu) & (in_chunk>=in_chunk0) & ((in_chunk+in_chunk_cnt)<=in_chunk1);
+
+      uchar const * src = valid ? (uchar const *)fd_chunk_to_laddr_const( in_base, in_chunk ) : NULL;
+      if( FD_LIKELY( src ) ) for( ulong off=0UL; off<sz; off+=FD_CHUNK_SZ ) __builtin_prefetch( src+off, 0, 0 );
+
+      fd_frag_meta_t * meta = batch + batch_cnt;
+      meta->sig    = sig;
+      meta->sz     = (ushort)sz;
+      meta->ctl    = (ushort)ctl;
+      meta->tsorig = (uint)tsorig;
+      batch_src[ batch_cnt ] = src;
+
+      batch_cnt++;
+      batch_seq = fd_seq_inc( batch_seq, 1UL );
+    } while( batch_cnt<batch_max );
+
+    if( FD_UNLIKELY( !batch_cnt ) ) { /* Don't bother with spin as the in is likely remote */
+      now = fd_tickcount();
+      continue;
+    }
+
+    /* Copy the batch payloads into the dcache, compacting out filtered
+       frags as we go. */
+
+    ulong pub_cnt = 0UL;
+    ulong pub_sz  = 0UL;
+    ulong filt_sz = 0UL;
+    for( ulong batch_idx=0UL; batch_idx<batch_cnt; batch_idx++ ) {
+      fd_frag_meta_t * meta = batch + batch_idx;
+      ulong            sz   = (ulong)meta->sz;
+      uchar const *    src  = batch_src[ batch_idx ];
+      if( FD_UNLIKELY( !src ) ) { filt_sz += sz; continue; }
+      fd_bridge_private_copy( (uchar *)fd_chunk_to_laddr( base, chunk ), src, sz );
+      fd_frag_meta_t * pub = batch + pub_cnt;
+      pub->sig    = meta->sig;
+      pub->chunk  = (uint)chunk;
+      pub->sz     = meta->sz;
+      pub->ctl    = meta->ctl;
+      pub->tsorig = meta->tsorig;
+      pub_cnt++;
+      pub_sz += sz;
+      chunk = fd_dcache_compact_next( chunk, sz, chunk0, wmark );
+    }
+
+    /* Validate the batch wasn't overrun while we were copying it.
+       Since the in overwrites mcache lines in sequence order and
+       payloads are only overwritten after the corresponding mcache line
+       has been reused, it is sufficient to check the oldest frag of the
+       batch. */
+
+    FD_COMPILER_MFENCE();
+    ulong seq_test = in_mcache[ fd_mcache_line_idx( in_seq, in_depth ) ].seq;
+    FD_COMPILER_MFENCE();
+    if( FD_UNLIKELY( fd_seq_ne( seq_test, in_seq ) ) ) { /* Overrun while copying (impossible if in honoring our fctl) */
+      in_seq = seq_test; /* Resume from here */
+      in_accum[ FD_FSEQ_DIAG_OVRNR_CNT ]++;
+      now = fd_tickcount();
+      continue;
+    }
+
+    /* Publish the batch.  The store fence makes the non-temporal
+       payload stores visible before the metadata that exposes them. */
+
+    now = fd_tickcount();
+    if( FD_LIKELY( pub_cnt ) ) {
+      uint tspub = (uint)fd_frag_meta_ts_comp( now );
+      for( ulong pub_idx=0UL; pub_idx<pub_cnt; pub_idx++ ) batch[ pub_idx ].tspub = tspub;
+#     if FD_HAS_AVX
+      _mm_sfence();
+#     endif
+      seq = fd_mcache_publish_burst( mcache, depth, seq, batch, pub_cnt );
+      cr_avail -= pub_cnt;
+    }
+
+    /* Windup for the next poll and accumulate diagnostics */
+
+    in_seq = batch_seq;
+    in_accum[ FD_FSEQ_DIAG_PUB_CNT  ] += (uint)pub_cnt;
+    in_accum[ FD_FSEQ_DIAG_PUB_SZ   ] += (uint)pub_sz;
+    in_accum[ FD_FSEQ_DIAG_FILT_CNT ] += (uint)(batch_cnt-pub_cnt);
+    in_accum[ FD_FSEQ_DIAG_FILT_SZ  ] += (uint)filt_sz;
+  }
+
+  do {
+
+    FD_LOG_INFO(( "Halting bridge" ));
+
+    fd_mcache_seq_update( sync, seq );
+    fd_bridge_private_in_update( in_fseq, in_seq, in_accum );
+
+    FD_LOG_INFO(( "Halted bridge" ));
+    fd_cnc_signal( cnc, FD_CNC_SIGNAL_BOOT );
+
+  } while(0);
+
+  return 0;
+}
+
+#undef SCRATCH_ALLOC
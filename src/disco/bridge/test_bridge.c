@@ -0,0 +1,333 @@
+#include "../fd_disco.h"
+
+#if FD_HAS_HOSTED
+
+FD_STATIC_ASSERT( FD_BRIDGE_CNC_SIGNAL_ACK==4UL, unit_test );
+
+FD_STATIC_ASSERT( FD_BRIDGE_TILE_OUT_MAX  ==8192UL, unit_test );
+FD_STATIC_ASSERT( FD_BRIDGE_TILE_BATCH_MAX==16UL,   unit_test );
+
+FD_STATIC_ASSERT( FD_BRIDGE_TILE_SCRATCH_ALIGN==128UL, unit_test );
+
+/* The test drives a bridge tile running on tile 1 from tile 0, which
+   acts as both the upstream producer (publishing into the in mcache /
+   dcache, in workspace "in") and the downstream reliable consumer
+   (reading from the out mcache / dcache, in workspace "out").  Frag
+   metadata and payloads are deterministic functions of the frag's in
+   sequence number (carried in sig) so the consumer can validate
+   everything the bridge republished, including which frags it should
+   have filtered. */
+
+struct test_cfg {
+  fd_cnc_t *             cnc;
+  fd_frag_meta_t const * in_mcache;
+  uchar const *          in_dcache;
+  ulong *                in_fseq;
+  fd_frag_meta_t *       mcache;
+  uchar *                dcache;
+  ulong                  mtu;
+  ulong *                out_fseq;
+  ulong                  cr_max;
+  long                   lazy;
+  uint                   seed;
+  void *                 scratch;
+};
+
+typedef struct test_cfg test_cfg_t;
+
+static test_cfg_t cfg[1];
+
+static int
+bridge_tile_main( int     argc,
+                  char ** argv ) {
+  (void)argc; (void)argv;
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, cfg->seed, 0UL ) );
+  int err = fd_bridge_tile( cfg->cnc, cfg->in_mcache, cfg->in_dcache, cfg->in_fseq, cfg->mcache, cfg->dcache, cfg->mtu,
+                            1UL, &cfg->out_fseq, cfg->cr_max, cfg->lazy, rng, cfg->scratch );
+  fd_rng_delete( fd_rng_leave( rng ) );
+  return err;
+}
+
+/* Deterministic frag contents for the frag with in sequence number
+   seq.  Roughly one frag in 16 is larger than the bridge's mtu. */
+
+static inline ulong
+test_frag_sz( ulong seq,
+              ulong mtu ) {
+  ulong h = fd_ulong_hash( seq );
+  return (h & 15UL) ? ((h>>4) % (mtu+1UL)) : (mtu + 1UL + ((h>>4) & 127UL));
+}
+
+static inline ulong test_frag_ctl   ( ulong seq ) { return fd_frag_meta_ctl( seq & 127UL, (int)(seq>>1) & 1, (int)(seq>>2) & 1, !(seq & 63UL) ); }
+static inline ulong test_frag_tsorig( ulong seq ) { return (ulong)(uint)(seq*3UL); }
+static inline uchar test_frag_byte  ( ulong seq, ulong off ) { return (uchar)(seq*7UL + off); }
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  FD_TEST( fd_bridge_tile_scratch_align()==FD_BRIDGE_TILE_SCRATCH_ALIGN );
+  FD_TEST( !fd_bridge_tile_scratch_footprint( FD_BRIDGE_TILE_OUT_MAX+1UL ) );
+  for( ulong iter_rem=1000000UL; iter_rem; iter_rem-- ) {
+    ulong out_cnt = fd_rng_ulong_roll( rng, FD_BRIDGE_TILE_OUT_MAX+1UL );
+    FD_TEST( fd_bridge_tile_scratch_footprint( out_cnt )==FD_BRIDGE_TILE_SCRATCH_FOOTPRINT( out_cnt ) );
+  }
+
+  if( FD_UNLIKELY( fd_tile_cnt()<2UL ) ) {
+    FD_LOG_WARNING(( "skip: unit test requires at least 2 tiles" ));
+    fd_rng_delete( fd_rng_leave( rng ) );
+    fd_halt();
+    return 0;
+  }
+
+  ulong cpu_idx = fd_tile_cpu_id( fd_tile_idx() );
+  if( cpu_idx>=fd_shmem_cpu_cnt() ) cpu_idx = 0UL;
+
+  char const * _page_sz = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",  NULL, "gigantic"                   );
+  ulong        page_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt", NULL, 1UL                          );
+  ulong        numa_idx = fd_env_strip_cmdline_ulong( &argc, &argv, "--numa-idx", NULL, fd_shmem_numa_idx( cpu_idx ) );
+  ulong        in_depth = fd_env_strip_cmdline_ulong( &argc, &argv, "--in-depth", NULL, 1024UL                       );
+  ulong        depth    = fd_env_strip_cmdline_ulong( &argc, &argv, "--depth",    NULL, 256UL                        );
+  ulong        mtu      = fd_env_strip_cmdline_ulong( &argc, &argv, "--mtu",      NULL, 1232UL                       );
+  ulong        cr_max   = fd_env_strip_cmdline_ulong( &argc, &argv, "--cr-max",   NULL, 0UL /* use default */        );
+  long         lazy     = fd_env_strip_cmdline_long ( &argc, &argv, "--lazy",     NULL, 0L  /* use default */        );
+  ulong        frag_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--frag-cnt", NULL, 100000UL                     );
+
+  ulong page_sz = fd_cstr_to_shmem_page_sz( _page_sz );
+  if( FD_UNLIKELY( !page_sz ) ) FD_LOG_ERR(( "unsupported --page-sz" ));
+
+  /* The in can produce frags larger than the bridge's mtu (which the
+     bridge should filter) */
+
+  ulong in_mtu = mtu + 128UL;
+
+  FD_LOG_NOTICE(( "Creating workspaces with --page-cnt %lu --page-sz %s pages on --numa-idx %lu", page_cnt, _page_sz, numa_idx ));
+  fd_wksp_t * in_wksp  = fd_wksp_new_anonymous( page_sz, page_cnt, fd_shmem_cpu_idx( numa_idx ), "in",  0UL ); FD_TEST( in_wksp  );
+  fd_wksp_t * out_wksp = fd_wksp_new_anonymous( page_sz, page_cnt, fd_shmem_cpu_idx( numa_idx ), "out", 0UL ); FD_TEST( out_wksp );
+
+  FD_LOG_NOTICE(( "Creating in (--in-depth %lu, in-mtu %lu) and out (--depth %lu, --mtu %lu)", in_depth, in_mtu, depth, mtu ));
+
+  ulong in_seq0   = fd_rng_ulong( rng );
+  ulong out_seq0  = fd_rng_ulong( rng );
+  ulong in_data_sz = fd_dcache_req_data_sz( in_mtu, in_depth, 1UL, 1 ); FD_TEST( in_data_sz );
+  ulong data_sz    = fd_dcache_req_data_sz( mtu,    depth,    1UL, 1 ); FD_TEST( data_sz    );
+
+  void * in_mcache_mem = fd_wksp_alloc_laddr( in_wksp, fd_mcache_align(), fd_mcache_footprint( in_depth, 0UL ),   1UL );
+  void * in_dcache_mem = fd_wksp_alloc_laddr( in_wksp, fd_dcache_align(), fd_dcache_footprint( in_data_sz, 0UL ), 1UL );
+  void * fctl_mem      = fd_wksp_alloc_laddr( in_wksp, fd_fctl_align(),   fd_fctl_footprint( 1UL ),               1UL );
+
+  void * cnc_mem       = fd_wksp_alloc_laddr( out_wksp, fd_cnc_align(),    fd_cnc_footprint( 64UL ),               1UL );
+  void * in_fseq_mem   = fd_wksp_alloc_laddr( out_wksp, fd_fseq_align(),   fd_fseq_footprint(),                    1UL );
+  void * mcache_mem    = fd_wksp_alloc_laddr( out_wksp, fd_mcache_align(), fd_mcache_footprint( depth, 0UL ),      1UL );
+  void * dcache_mem    = fd_wksp_alloc_laddr( out_wksp, fd_dcache_align(), fd_dcache_footprint( data_sz, 0UL ),    1UL );
+  void * out_fseq_mem  = fd_wksp_alloc_laddr( out_wksp, fd_fseq_align(),   fd_fseq_footprint(),                    1UL );
+  void * scratch       = fd_wksp_alloc_laddr( out_wksp, fd_bridge_tile_scratch_align(), fd_bridge_tile_scratch_footprint( 1UL ), 1UL );
+  FD_TEST( in_mcache_mem ); FD_TEST( in_dcache_mem ); FD_TEST( fctl_mem ); FD_TEST( cnc_mem ); FD_TEST( in_fseq_mem );
+  FD_TEST( mcache_mem    ); FD_TEST( dcache_mem    ); FD_TEST( out_fseq_mem ); FD_TEST( scratch );
+
+  fd_frag_meta_t * in_mcache = fd_mcache_join( fd_mcache_new( in_mcache_mem, in_depth, 0UL, in_seq0 ) ); FD_TEST( in_mcache );
+  uchar *          in_dcache = fd_dcache_join( fd_dcache_new( in_dcache_mem, in_data_sz, 0UL ) );         FD_TEST( in_dcache );
+  ulong *          in_fseq   = fd_fseq_join  ( fd_fseq_new  ( in_fseq_mem,   in_seq0 ) );                  FD_TEST( in_fseq   );
+  fd_cnc_t *       cnc       = fd_cnc_join   ( fd_cnc_new   ( cnc_mem, 64UL, 0UL, fd_tickcount() ) );      FD_TEST( cnc       );
+  fd_frag_meta_t * mcache    = fd_mcache_join( fd_mcache_new( mcache_mem, depth, 0UL, out_seq0 ) );        FD_TEST( mcache    );
+  uchar *          dcache    = fd_dcache_join( fd_dcache_new( dcache_mem, data_sz, 0UL ) );                FD_TEST( dcache    );
+  ulong *          out_fseq  = fd_fseq_join  ( fd_fseq_new  ( out_fseq_mem,  out_seq0 ) );                 FD_TEST( out_fseq  );
+
+  ulong * in_diag  = (ulong *)fd_fseq_app_laddr( in_fseq  );
+  ulong * out_diag = (ulong *)fd_fseq_app_laddr( out_fseq );
+  ulong * cnc_diag = (ulong *)fd_cnc_app_laddr ( cnc      );
+
+  fd_fctl_t * fctl = fd_fctl_cfg_done( fd_fctl_cfg_rx_add( fd_fctl_join( fd_fctl_new( fctl_mem, 1UL ) ),
+                                                           in_depth, in_fseq, &in_diag[ FD_FSEQ_DIAG_SLOW_CNT ] ),
+                                       1UL, 0UL, 0UL, 0UL );
+  FD_TEST( fctl );
+
+  /* Test boot failures */
+
+  FD_TEST( fd_bridge_tile( cnc, in_mcache, in_dcache, in_fseq, mcache, dcache, mtu,      1UL, &out_fseq, 0UL,      0L, rng, NULL        ) );
+  FD_TEST( fd_bridge_tile( cnc, in_mcache, in_dcache, in_fseq, mcache, dcache, mtu,      1UL, &out_fseq, 0UL,      0L, rng, (uchar *)scratch+1UL ) );
+  FD_TEST( fd_bridge_tile( NULL,in_mcache, in_dcache, in_fseq, mcache, dcache, mtu,      1UL, &out_fseq, 0UL,      0L, rng, scratch     ) );
+  FD_TEST( fd_bridge_tile( cnc, NULL,      in_dcache, in_fseq, mcache, dcache, mtu,      1UL, &out_fseq, 0UL,      0L, rng, scratch     ) );
+  FD_TEST( fd_bridge_tile( cnc, in_mcache, NULL,      in_fseq, mcache, dcache, mtu,      1UL, &out_fseq, 0UL,      0L, rng, scratch     ) );
+  FD_TEST( fd_bridge_tile( cnc, in_mcache, in_dcache, NULL,    mcache, dcache, mtu,      1UL, &out_fseq, 0UL,      0L, rng, scratch     ) );
+  FD_TEST( fd_bridge_tile( cnc, in_mcache, in_dcache, in_fseq, NULL,   dcache, mtu,      1UL, &out_fseq, 0UL,      0L, rng, scratch     ) );
+  FD_TEST( fd_bridge_tile( cnc, in_mcache, in_dcache, in_fseq, mcache, NULL,   mtu,      1UL, &out_fseq, 0UL,      0L, rng, scratch     ) );
+  FD_TEST( fd_bridge_tile( cnc, in_mcache, in_dcache, in_fseq, mcache, dcache, 0UL,      1UL, &out_fseq, 0UL,      0L, rng, scratch     ) );
+  FD_TEST( fd_bridge_tile( cnc, in_mcache, in_dcache, in_fseq, mcache, dcache, in_mtu*4, 1UL, &out_fseq, 0UL,      0L, rng, scratch     ) );
+  FD_TEST( fd_bridge_tile( cnc, in_mcache, in_dcache, in_fseq, mcache, dcache, mtu,      1UL, NULL,      0UL,      0L, rng, scratch     ) );
+  FD_TEST( fd_bridge_tile( cnc, in_mcache, in_dcache, in_fseq, mcache, dcache, mtu,      1UL, &out_fseq, depth+1UL,0L, rng, scratch     ) );
+  FD_TEST( fd_cnc_signal_query( cnc )==FD_CNC_SIGNAL_BOOT );
+
+  FD_LOG_NOTICE(( "Booting bridge" ));
+
+  cfg->cnc       = cnc;
+  cfg->in_mcache = in_mcache;
+  cfg->in_dcache = in_dcache;
+  cfg->in_fseq   = in_fseq;
+  cfg->mcache    = mcache;
+  cfg->dcache    = dcache;
+  cfg->mtu       = mtu;
+  cfg->out_fseq  = out_fseq;
+  cfg->cr_max    = cr_max;
+  cfg->lazy      = lazy;
+  cfg->seed      = 1234U;
+  cfg->scratch   = scratch;
+
+  fd_tile_exec_t * exec = fd_tile_exec_new( 1UL, bridge_tile_main, 0, NULL ); FD_TEST( exec );
+  FD_TEST( fd_cnc_wait( cnc, FD_CNC_SIGNAL_BOOT, (long)5e9, NULL )==FD_CNC_SIGNAL_RUN );
+
+  FD_LOG_NOTICE(( "Running (--frag-cnt %lu, --cr-max %lu, --lazy %li)", frag_cnt, cr_max, lazy ));
+
+  ulong in_chunk0 = fd_dcache_compact_chunk0( in_wksp, in_dcache );
+  ulong in_wmark  = fd_dcache_compact_wmark ( in_wksp, in_dcache, in_mtu );
+  ulong in_chunk  = in_chunk0;
+
+  ulong tx_seq   = in_seq0;                         /* Next frag to publish into the in */
+  ulong tx_end   = fd_seq_inc( in_seq0, frag_cnt );
+  ulong cr_avail = 0UL;
+  ulong rx_seq   = out_seq0;                        /* Next frag expected from the bridge */
+  ulong rx_sig   = in_seq0;                         /* In sequence number of the next frag expected from the bridge */
+  ulong pub_cnt  = 0UL;
+  ulong filt_cnt = 0UL;
+  ulong pub_sz   = 0UL;
+  ulong filt_sz  = 0UL;
+
+  long  tic = fd_log_wallclock();
+  for(;;) {
+
+    /* Skip over frags the bridge should filter */
+
+    while( fd_seq_lt( rx_sig, tx_end ) && test_frag_sz( rx_sig, mtu )>mtu ) {
+      filt_cnt++; filt_sz += test_frag_sz( rx_sig, mtu );
+      rx_sig = fd_seq_inc( rx_sig, 1UL );
+    }
+    if( FD_UNLIKELY( fd_seq_ge( rx_sig, tx_end ) ) ) break;
+
+    /* Publish the next frag into the in if we can */
+
+    cr_avail = fd_fctl_tx_cr_update( fctl, cr_avail, tx_seq );
+    if( fd_seq_lt( tx_seq, tx_end ) && cr_avail ) {
+      ulong   sz = test_frag_sz( tx_seq, mtu );
+      uchar * p  = (uchar *)fd_chunk_to_laddr( in_wksp, in_chunk );
+      for( ulong off=0UL; off<sz; off++ ) p[ off ] = test_frag_byte( tx_seq, off );
+      fd_mcache_publish( in_mcache, in_depth, tx_seq, tx_seq, in_chunk, sz, test_frag_ctl( tx_seq ), test_frag_tsorig( tx_seq ), 0UL );
+      in_chunk = fd_dcache_compact_next( in_chunk, sz, in_chunk0, in_wmark );
+      tx_seq   = fd_seq_inc( tx_seq, 1UL );
+      cr_avail--;
+    }
+
+    /* Receive the next frag from the bridge if available */
+
+    fd_frag_meta_t const * mline = mcache + fd_mcache_line_idx( rx_seq, depth );
+    FD_COMPILER_MFENCE();
+    ulong seq_found = mline->seq;
+    FD_COMPILER_MFENCE();
+    long diff = fd_seq_diff( rx_seq, seq_found );
+    if( diff ) {
+      FD_TEST( diff>0L ); /* Reliable consumer should never be overrun */
+      FD_SPIN_PAUSE();
+      continue;
+    }
+
+    FD_COMPILER_MFENCE();
+    ulong sig    =        mline->sig;
+    ulong chunk  = (ulong)mline->chunk;
+    ulong sz     = (ulong)mline->sz;
+    ulong ctl    = (ulong)mline->ctl;
+    ulong tsorig = (ulong)mline->tsorig;
+    FD_COMPILER_MFENCE();
+    FD_TEST( fd_seq_eq( mline->seq, rx_seq ) );
+
+    FD_TEST( sig   ==rx_sig                      );
+    FD_TEST( sz    ==test_frag_sz   ( sig, mtu ) );
+    FD_TEST( ctl   ==test_frag_ctl   ( sig )     );
+    FD_TEST( tsorig==test_frag_tsorig( sig )     );
+    FD_TEST( fd_dcache_compact_chunk0( out_wksp, dcache )<=chunk );
+    FD_TEST( chunk<=fd_dcache_compact_wmark( out_wksp, dcache, mtu ) );
+
+    uchar const * p = (uchar const *)fd_chunk_to_laddr_const( out_wksp, chunk );
+    for( ulong off=0UL; off<sz; off++ ) FD_TEST( p[ off ]==test_frag_byte( sig, off ) );
+
+    pub_cnt++; pub_sz += sz;
+    rx_seq = fd_seq_inc( rx_seq, 1UL );
+    rx_sig = fd_seq_inc( rx_sig, 1UL );
+    fd_fctl_rx_cr_return( out_fseq, rx_seq );
+  }
+  long toc = fd_log_wallclock();
+
+  FD_LOG_NOTICE(( "%lu frags bridged (%lu filtered) in %.3f s", pub_cnt, filt_cnt, 1e-9*(double)(toc-tic) ));
+  FD_TEST( pub_cnt+filt_cnt==frag_cnt );
+
+  /* Wait for the bridge to consume any trailing filtered frags */
+
+  while( fd_seq_lt( fd_fseq_query( in_fseq ), tx_end ) ) FD_SPIN_PAUSE();
+
+  FD_LOG_NOTICE(( "Halting bridge" ));
+
+  FD_TEST( !fd_cnc_open( cnc ) );
+  fd_cnc_signal( cnc, FD_CNC_SIGNAL_HALT );
+  fd_cnc_close( cnc );
+  FD_TEST( fd_cnc_wait( cnc, FD_CNC_SIGNAL_HALT, (long)5e9, NULL )==FD_CNC_SIGNAL_BOOT );
+  int ret;
+  FD_TEST( !fd_tile_exec_delete( exec, &ret ) );
+  FD_TEST( !ret );
+
+  /* All frags should be returned to the in and accounted for */
+
+  FD_TEST( fd_seq_eq( fd_fseq_query( in_fseq ), tx_end ) );
+  FD_TEST( fd_seq_eq( fd_mcache_seq_query( fd_mcache_seq_laddr( mcache ) ), rx_seq ) );
+  FD_TEST( in_diag[ FD_FSEQ_DIAG_PUB_CNT   ]==pub_cnt  );
+  FD_TEST( in_diag[ FD_FSEQ_DIAG_PUB_SZ    ]==pub_sz   );
+  FD_TEST( in_diag[ FD_FSEQ_DIAG_FILT_CNT  ]==filt_cnt );
+  FD_TEST( in_diag[ FD_FSEQ_DIAG_FILT_SZ   ]==filt_sz  );
+  FD_TEST( in_diag[ FD_FSEQ_DIAG_OVRNP_CNT ]==0UL      );
+  FD_TEST( in_diag[ FD_FSEQ_DIAG_OVRNR_CNT ]==0UL      );
+  FD_LOG_NOTICE(( "bridge backp_cnt %lu, out slow_cnt %lu",
+                  cnc_diag[ FD_CNC_DIAG_BACKP_CNT ], out_diag[ FD_FSEQ_DIAG_SLOW_CNT ] ));
+
+  FD_LOG_NOTICE(( "Cleaning up" ));
+
+  FD_TEST( fd_fctl_delete  ( fd_fctl_leave  ( fctl      ) ) );
+  FD_TEST( fd_fseq_delete  ( fd_fseq_leave  ( out_fseq  ) ) );
+  FD_TEST( fd_dcache_delete( fd_dcache_leave( dcache    ) ) );
+  FD_TEST( fd_mcache_delete( fd_mcache_leave( mcache    ) ) );
+  FD_TEST( fd_cnc_delete   ( fd_cnc_leave   ( cnc       ) ) );
+  FD_TEST( fd_fseq_delete  ( fd_fseq_leave  ( in_fseq   ) ) );
+  FD_TEST( fd_dcache_delete( fd_dcache_leave( in_dcache ) ) );
+  FD_TEST( fd_mcache_delete( fd_mcache_leave( in_mcache ) ) );
+
+  fd_wksp_free_laddr( scratch       );
+  fd_wksp_free_laddr( out_fseq_mem  );
+  fd_wksp_free_laddr( dcache_mem    );
+  fd_wksp_free_laddr( mcache_mem    );
+  fd_wksp_free_laddr( in_fseq_mem   );
+  fd_wksp_free_laddr( cnc_mem       );
+  fd_wksp_free_laddr( fctl_mem      );
+  fd_wksp_free_laddr( in_dcache_mem );
+  fd_wksp_free_laddr( in_mcache_mem );
+
+  fd_wksp_delete_anonymous( out_wksp );
+  fd_wksp_delete_anonymous( in_wksp  );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
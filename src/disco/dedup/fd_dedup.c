@@ -83,6 +83,8 @@ fd_dedup_tile_scratch_footprint( ulong in_cnt,
   if( FD_UNLIKELY( out_cnt>FD_DEDUP_TILE_OUT_MAX ) ) return 0UL;
   ulong scratch_top = 0UL;
   SCRATCH_ALLOC( alignof(fd_dedup_tile_in_t), in_cnt*sizeof(fd_dedup_tile_in_t)   ); /* in */
+  SCRATCH_ALLOC( alignof(uint *),             in_cnt*sizeof(uint *)               ); /* in_lat */
+  SCRATCH_ALLOC( alignof(ulong),              in_cnt*sizeof(ulong)                ); /* in_link */
   SCRATCH_ALLOC( alignof(ulong const *),      out_cnt*sizeof(ulong const *)       ); /* out_fseq */
   SCRATCH_ALLOC( alignof(ulong *),            out_cnt*sizeof(ulong *)             ); /* out_slow */
   SCRATCH_ALLOC( alignof(ulong),              out_cnt*sizeof(ulong)               ); /* out_seq */
@@ -97,6 +99,7 @@ fd_dedup_tile( fd_cnc_t *              cnc,
                ulong **                in_fseq,
                fd_tcache_t *           tcache,
                fd_frag_meta_t *        mcache,
+               fd_trace_t *            trace,
                ulong                   out_cnt,
                ulong **                _out_fseq,
                ulong                   cr_max,
@@ -115,6 +118,9 @@ fd_dedup_tile( fd_cnc_t *              cnc,
   fd_dedup_tile_in_t * in;   /* in[in_seq] for in_seq in [0,in_cnt) has information about input fragment stream currently at
                                 position in_seq in the in_idx polling sequence.  The ordering of this array is continuously
                                 shuffled to avoid lighthousing effects in the output fragment stream at extreme fan-in and load */
+  uint **            in_lat; /* in_lat[in_seq] is where to accumulate latency histograms for in[in_seq] (shuffled with in),
+                                NULL if the cnc app region has no room for them */
+  ulong *            in_link; /* in_link[in_seq] is the in_idx of in[in_seq] (shuffled with in), used for tracing */
 
   /* tcache filter state */
   ulong   tcache_depth;   /* ==fd_tcache_depth       ( tcache ), maximum unique sigs held by the tcache */
@@ -176,7 +182,12 @@ fd_dedup_tile( fd_cnc_t *              cnc,
     /* in frag stream init */
 
     in_seq = 0UL; /* First in to poll */
-    in = (fd_dedup_tile_in_t *)SCRATCH_ALLOC( alignof(fd_dedup_tile_in_t), in_cnt*sizeof(fd_dedup_tile_in_t) );
+    in      = (fd_dedup_tile_in_t *)SCRATCH_ALLOC( alignof(fd_dedup_tile_in_t), in_cnt*sizeof(fd_dedup_tile_in_t) );
+    in_lat  = (uint **)             SCRATCH_ALLOC( alignof(uint *),             in_cnt*sizeof(uint *)             );
+    in_link = (ulong *)             SCRATCH_ALLOC( alignof(ulong),              in_cnt*sizeof(ulong)              );
+
+    uint * lat = fd_lat_cnc_laddr( cnc, in_cnt );
+    if( FD_UNLIKELY( !lat ) ) FD_LOG_INFO(( "cnc app sz too small for latency histograms; not accumulating them" ));
 
     ulong min_in_depth = (ulong)LONG_MAX;
 
@@ -201,6 +212,9 @@ fd_dedup_tile( fd_cnc_t *              cnc,
 
       this_in->accum[0] = 0U; this_in->accum[1] = 0U; this_in->accum[2] = 0U;
       this_in->accum[3] = 0U; this_in->accum[4] = 0U; this_in->accum[5] = 0U;
+
+      in_lat [ in_idx ] = lat ? fd_lat_link( lat, in_idx ) : NULL;
+      in_link[ in_idx ] = in_idx;
     }
 
     /* tcache filter init */
@@ -212,6 +226,7 @@ fd_dedup_tile( fd_cnc_t *              cnc,
     _tcache_sync   = fd_tcache_oldest_laddr( tcache );
     _tcache_ring   = fd_tcache_ring_laddr  ( tcache );
     _tcache_map    = fd_tcache_map_laddr   ( tcache );
+    if( FD_UNLIKELY( FD_TCACHE_USE_BKT && tcache_map_cnt<FD_TCACHE_BKT_SLOT_CNT ) ) { FD_LOG_WARNING(( "tcache map_cnt too small" )); return 1; }
     
     FD_COMPILER_MFENCE();
     tcache_sync = FD_VOLATILE_CONST( *_tcache_sync );
@@ -450,6 +465,14 @@ fd_dedup_tile( fd_cnc_t *              cnc,
           in_tmp         = in[ swap_idx ];
           in[ swap_idx ] = in[ 0        ];
           in[ 0        ] = in_tmp;
+
+          uint * lat_tmp     = in_lat[ swap_idx ];
+          in_lat[ swap_idx ] = in_lat[ 0        ];
+          in_lat[ 0        ] = lat_tmp;
+
+          ulong link_tmp      = in_link[ swap_idx ];
+          in_link[ swap_idx ] = in_link[ 0        ];
+          in_link[ 0        ] = link_tmp;
         }
       }
 
@@ -477,7 +500,9 @@ fd_dedup_tile( fd_cnc_t *              cnc,
     /* Select which in to poll next (randomized round robin) */
 
     if( FD_UNLIKELY( !in_cnt ) ) { now = fd_tickcount(); continue; }
-    fd_dedup_tile_in_t * this_in = &in[ in_seq ];
+    fd_dedup_tile_in_t * this_in     = &in    [ in_seq ];
+    uint *               this_in_lat =  in_lat[ in_seq ];
+    ulong                this_in_idx =  in_link[ in_seq ];
     in_seq++;
     if( in_seq>=in_cnt ) in_seq = 0UL; /* cmov */
 
@@ -516,6 +541,7 @@ fd_dedup_tile( fd_cnc_t *              cnc,
     ulong sz       = (ulong)this_in_mline->sz;
     ulong ctl      = (ulong)this_in_mline->ctl;
     ulong tsorig   = (ulong)this_in_mline->tsorig;
+    ulong tsin     = (ulong)this_in_mline->tspub;
     FD_COMPILER_MFENCE();
     ulong seq_test =        this_in_mline->seq;
     FD_COMPILER_MFENCE();
@@ -528,11 +554,21 @@ fd_dedup_tile( fd_cnc_t *              cnc,
       continue;
     }
 
-    /* We have successfully loaded the metadata.  Decide whether it
-       is interesting downstream and publish or filter accordingly. */
+    /* We have successfully loaded the metadata.  Record how long it
+       took to get here and then decide whether it is interesting
+       downstream and publish or filter accordingly. */
+
+    if( FD_LIKELY( this_in_lat ) ) fd_lat_sample( this_in_lat, now, tsorig, tsin );
+
+    int traced = fd_trace_sampled( trace, sig );
+    if( FD_UNLIKELY( traced ) ) fd_trace_record( trace, sig, this_in_idx, this_in_seq, FD_TRACE_EVENT_RX, now );
 
     int is_dup;
-    FD_TCACHE_INSERT( is_dup, tcache_sync, _tcache_ring, tcache_depth, _tcache_map, tcache_map_cnt, sig );
+#   if FD_TCACHE_USE_BKT
+    FD_TCACHE_BKT_INSERT( is_dup, tcache_sync, _tcache_ring, tcache_depth, _tcache_map, tcache_map_cnt, sig );
+#   else
+    FD_TCACHE_INSERT    ( is_dup, tcache_sync, _tcache_ring, tcache_depth, _tcache_map, tcache_map_cnt, sig );
+#   endif
     if( FD_UNLIKELY( is_dup ) ) { /* Optimize for forwarding path */
       now = fd_tickcount();
       /* If there are any frags from this in that are currently exposed
@@ -546,10 +582,12 @@ fd_dedup_tile( fd_cnc_t *              cnc,
          any in).  If cr_avail<cr_max, we assume the worst (that all
          exposed_frags are from this in) and increment cr_filt. */
       cr_filt += (ulong)(cr_avail<cr_max);
+      if( FD_UNLIKELY( traced ) ) fd_trace_record( trace, sig, this_in_idx, this_in_seq, FD_TRACE_EVENT_FILT, now );
     } else {
       now = fd_tickcount();
       ulong tspub = (ulong)fd_frag_meta_ts_comp( now );
       fd_mcache_publish( mcache, depth, seq, sig, chunk, sz, ctl, tsorig, tspub );
+      if( FD_UNLIKELY( traced ) ) fd_trace_record( trace, sig, 0UL, seq, FD_TRACE_EVENT_PUB, now );
       cr_avail--;
       seq = fd_seq_inc( seq, 1UL );
     }
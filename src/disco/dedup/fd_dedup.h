@@ -43,8 +43,11 @@
 #define FD_DEDUP_TILE_SCRATCH_ALIGN (128UL)
 #define FD_DEDUP_TILE_SCRATCH_FOOTPRINT( in_cnt, out_cnt )              \
   FD_LAYOUT_FINI( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( \
-  FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_INIT,                   \
+  FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( \
+  FD_LAYOUT_INIT,                                                       \
     64UL,             (in_cnt)*64UL                           ),        \
+    alignof(uint *),  (in_cnt)*sizeof(uint *)                 ),        \
+    alignof(ulong),   (in_cnt)*sizeof(ulong)                  ),        \
     alignof(ulong *), (out_cnt)*sizeof(ulong *)               ),        \
     alignof(ulong *), (out_cnt)*sizeof(ulong *)               ),        \
     alignof(ulong),   (out_cnt)*sizeof(ulong)                 ),        \
@@ -217,12 +220,22 @@ FD_PROTOTYPES_BEGIN
    at boot (as such that they can be accumulated over multiple runs).
    Clearing is up to monitoring scripts.  It is recommend that inputs
    and outputs also use their cnc and fseq application regions similarly
-   for monitoring simplicity / consistency.
-
-   The lifetime of the cnc, mcaches, fseqs, tcache, rng and scratch used
+   for monitoring simplicity / consistency.  If the cnc application
+   region is at least FD_LAT_CNC_APP_SZ( in_cnt ) bytes, the dedup also
+   accumulates the standard per in frag latency histograms there (see
+   fd_lat.h).
+
+   If trace is non-NULL, the dedup records the events of the frags it
+   receives that are sampled by trace, using the frag sig as the trace
+   key (see fd_trace.h): RX (link is the in_idx) when it starts
+   processing a frag and then PUB (link is 0, seq is the sequence number
+   in mcache) or FILT (link is the in_idx) when it forwards or filters
+   it.  If trace is NULL, tracing is off.
+
+   The lifetime of the cnc, mcaches, fseqs, tcache, trace, rng and scratch used
    by this tile should be a superset of this tile's lifetime.  While
    this tile is running, no other tile should use cnc for its command
-   and control, modify the tcache, publish into mcache, use the rng for
+   and control, modify the tcache, record to trace, publish into mcache, use the rng for
    anything (and the rng should be be seeded distinctly from all other
    rngs in the system), or use scratch for anything.  This tile will act
    as a reliable consumer of in_mcache metadata.  This tile uses the
@@ -250,6 +263,7 @@ fd_dedup_tile( fd_cnc_t *              cnc,           /* Local join to the dedup
                ulong **                in_fseq,       /* in_fseq  [in_idx] is the local join to input in_idx's fseq */
                fd_tcache_t *           tcache,        /* Local join to the dedup's unique signature cache */
                fd_frag_meta_t *        mcache,        /* Local join to the dedup's frag stream output mcache */
+               fd_trace_t *            trace,         /* Local join to the dedup's trace, NULL if not tracing */
                ulong                   out_cnt,       /* Number of reliable consumers, reliable consumers are indexed [0,out_cnt) */
                ulong **                out_fseq,      /* out_fseq[out_idx] is the local join to reliable consumer out_idx's fseq */
                ulong                   cr_max,        /* Maximum number of flow control credits, 0 means use a reasonable default */
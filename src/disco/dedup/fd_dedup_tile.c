@@ -17,6 +17,7 @@ main( int     argc,
   char const * _tcache     = fd_env_strip_cmdline_cstr ( &argc, &argv, "--tcache",     NULL, NULL );
   char const * _mcache     = fd_env_strip_cmdline_cstr ( &argc, &argv, "--mcache",     NULL, NULL );
   char const * _out_fseqs  = fd_env_strip_cmdline_cstr ( &argc, &argv, "--out-fseqs",  NULL, ""   );
+  char const * _trace      = fd_env_strip_cmdline_cstr ( &argc, &argv, "--trace",      NULL, NULL ); /* NULL <> no tracing */
   ulong        cr_max      = fd_env_strip_cmdline_ulong( &argc, &argv, "--cr-max",     NULL, 0UL  ); /*   0 <> use default */
   long         lazy        = fd_env_strip_cmdline_long ( &argc, &argv, "--lazy",       NULL, 0L   ); /* <=0 <> use default */
   uint         seed        = fd_env_strip_cmdline_uint ( &argc, &argv, "--seed",       NULL, (uint)(ulong)fd_tickcount() );
@@ -69,6 +70,13 @@ main( int     argc,
     if( FD_UNLIKELY( !out_fseq[ out_idx ] ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
   }
 
+  fd_trace_t * trace = NULL;
+  if( _trace ) {
+    FD_LOG_NOTICE(( "Joining --trace %s", _trace ));
+    trace = fd_trace_join( fd_wksp_map( _trace ) );
+    if( FD_UNLIKELY( !trace ) ) FD_LOG_ERR(( "fd_trace_join failed" ));
+  }
+
   FD_LOG_NOTICE(( "Using --cr-max %lu, --lazy %li", cr_max, lazy ));
 
   FD_LOG_NOTICE(( "Creating rng --seed %u", seed ));
@@ -87,7 +95,7 @@ main( int     argc,
 
   FD_LOG_NOTICE(( "Run" ));
 
-  int err = fd_dedup_tile( cnc, in_cnt, in_mcache, in_fseq, tcache, mcache, out_cnt, out_fseq, cr_max, lazy, rng, scratch, fd_tempo_tick_per_ns( NULL ) );
+  int err = fd_dedup_tile( cnc, in_cnt, in_mcache, in_fseq, tcache, mcache, trace, out_cnt, out_fseq, cr_max, lazy, rng, scratch, fd_tempo_tick_per_ns( NULL ) );
   if( FD_UNLIKELY( err ) ) FD_LOG_ERR(( "fd_dedup_tile failed (%i)", err ));
 
   FD_LOG_NOTICE(( "Fini" ));
@@ -95,6 +103,7 @@ main( int     argc,
   fd_shmem_release( scratch, page_sz, page_cnt );
   fd_rng_delete( fd_rng_leave( rng ) );
   for( ulong out_idx=out_cnt; out_idx; out_idx-- ) fd_wksp_unmap( fd_fseq_leave( out_fseq[ out_idx-1UL ] ) );
+  if( trace ) fd_wksp_unmap( fd_trace_leave( trace ) );
   fd_wksp_unmap( fd_mcache_leave( mcache ) );
   fd_wksp_unmap( fd_tcache_leave( tcache ) );
   for( ulong in_idx=in_cnt; in_idx; in_idx-- ) fd_wksp_unmap( fd_fseq_leave  ( in_fseq  [ in_idx-1UL ] ) );
@@ -27,6 +27,7 @@ struct test_cfg {
   uchar *     dedup_tcache_mem;
   uchar *     dedup_mcache_mem;
   uchar *     dedup_scratch_mem;
+  uchar *     dedup_trace_mem;
   ulong       dedup_cr_max;
   long        dedup_lazy;
   uint        dedup_seed;
@@ -281,6 +282,7 @@ dedup_tile_main( int     argc,
 
   fd_tcache_t *    dedup_tcache = fd_tcache_join( cfg->dedup_tcache_mem );
   fd_frag_meta_t * dedup_mcache = fd_mcache_join( cfg->dedup_mcache_mem );
+  fd_trace_t *     dedup_trace  = fd_trace_join ( cfg->dedup_trace_mem  );
 
   ulong * rx_fseq[ 128 ];
   for( ulong rx_idx=0UL; rx_idx<cfg->rx_cnt; rx_idx++ )
@@ -289,12 +291,13 @@ dedup_tile_main( int     argc,
   fd_rng_t _rng[1];
   fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, cfg->dedup_seed, 0UL ) );
 
-  int err = fd_dedup_tile( cnc, cfg->tx_cnt, tx_mcache, tx_fseq, dedup_tcache, dedup_mcache, cfg->rx_cnt, rx_fseq,
+  int err = fd_dedup_tile( cnc, cfg->tx_cnt, tx_mcache, tx_fseq, dedup_tcache, dedup_mcache, dedup_trace, cfg->rx_cnt, rx_fseq,
                            cfg->dedup_cr_max, cfg->dedup_lazy, rng, cfg->dedup_scratch_mem, fd_tempo_tick_per_ns( NULL ) );
   if( FD_UNLIKELY( err ) ) FD_LOG_ERR(( "fd_dedup_tile failed (%i)", err ));
 
   fd_rng_delete( fd_rng_leave( rng ) );
   for( ulong rx_idx=cfg->rx_cnt; rx_idx; rx_idx-- ) fd_fseq_leave  ( rx_fseq  [ rx_idx-1UL ] );
+  fd_trace_leave ( dedup_trace  );
   fd_mcache_leave( dedup_mcache );
   fd_tcache_leave( dedup_tcache );
   for( ulong tx_idx=cfg->tx_cnt; tx_idx; tx_idx-- ) fd_fseq_leave  ( tx_fseq  [ tx_idx-1UL ] );
@@ -478,6 +481,8 @@ main( int     argc,
   long         dedup_lazy     = fd_env_strip_cmdline_long ( &argc, &argv, "--dedup-lazy",     NULL, 0L /* use default */       );
   ulong        rx_cnt         = fd_env_strip_cmdline_ulong( &argc, &argv, "--rx-cnt",         NULL, 2UL                        );
   int          rx_lazy        = fd_env_strip_cmdline_int  ( &argc, &argv, "--rx-lazy",        NULL, 7                          );
+  ulong        trace_depth    = fd_env_strip_cmdline_ulong( &argc, &argv, "--trace-depth",    NULL, 65536UL                    );
+  ulong        trace_lg       = fd_env_strip_cmdline_ulong( &argc, &argv, "--trace-lg",       NULL, 4UL                        );
   ulong        test_depth     = fd_env_strip_cmdline_ulong( &argc, &argv, "--test-depth",     NULL, 2046UL                     );
   ulong        test_map_cnt   = fd_env_strip_cmdline_ulong( &argc, &argv, "--test-map-cnt",   NULL, 0UL /* use default */      );
   long         duration       = fd_env_strip_cmdline_long ( &argc, &argv, "--duration",       NULL, (long)10e9                 );
@@ -530,8 +535,11 @@ main( int     argc,
   fd_wksp_t * wksp = fd_wksp_new_anonymous( page_sz, page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
   FD_TEST( wksp );
 
-  FD_LOG_NOTICE(( "Creating cncs (--tx-cnt %lu, dedup-cnt 1, --rx-cnt %lu, app-sz 64)", tx_cnt, rx_cnt ));
-  ulong   cnc_footprint = fd_cnc_footprint( 64UL ); /* Room for 8 64-bit diagnostic counters */
+  /* The dedup cnc also has room for the latency histograms of its
+     ins.  For simplicity, all cncs have the same footprint. */
+  ulong   dedup_cnc_app_sz = FD_LAT_CNC_APP_SZ( tx_cnt );
+  FD_LOG_NOTICE(( "Creating cncs (--tx-cnt %lu, dedup-cnt 1, --rx-cnt %lu, app-sz 64, dedup app-sz %lu)", tx_cnt, rx_cnt, dedup_cnc_app_sz ));
+  ulong   cnc_footprint = fd_cnc_footprint( dedup_cnc_app_sz );
   uchar * cnc_mem       = (uchar *)fd_wksp_alloc_laddr( wksp, fd_cnc_align(), cnc_footprint*(tx_cnt+1UL+rx_cnt), 1UL );
   FD_TEST( cnc_mem );
 
@@ -578,9 +586,15 @@ main( int     argc,
   uchar * dedup_scratch_mem       = (uchar *)fd_wksp_alloc_laddr( wksp, fd_dedup_tile_scratch_align(), dedup_scratch_footprint, 1UL );
   FD_TEST( dedup_scratch_mem );
 
+  FD_LOG_NOTICE(( "Creating dedup trace (--trace-depth %lu, --trace-lg %lu)", trace_depth, trace_lg ));
+  ulong   dedup_trace_footprint = fd_trace_footprint( trace_depth );
+  if( FD_UNLIKELY( !dedup_trace_footprint ) ) FD_LOG_ERR(( "bad --trace-depth" ));
+  uchar * dedup_trace_mem       = (uchar *)fd_wksp_alloc_laddr( wksp, fd_trace_align(), dedup_trace_footprint, 1UL );
+  FD_TEST( dedup_trace_mem );
+
   FD_LOG_NOTICE(( "Creating rx tcache (--test-depth %lu, --test-map-cnt %lu)", test_depth, test_map_cnt ));
   ulong   rx_tcache_footprint = fd_tcache_footprint( test_depth, test_map_cnt );
-  uchar * rx_tcache_mem       = (uchar *)fd_wksp_alloc_laddr( wksp, fd_tcache_align(), rx_tcache_footprint, 1UL );
+  uchar * rx_tcache_mem       = (uchar *)fd_wksp_alloc_laddr( wksp, fd_tcache_align(), rx_tcache_footprint*rx_cnt, 1UL );
   FD_TEST( rx_tcache_mem );
 
   long now = fd_tickcount();
@@ -602,6 +616,7 @@ main( int     argc,
   cfg->dedup_tcache_mem  = dedup_tcache_mem;
   cfg->dedup_mcache_mem  = dedup_mcache_mem;
   cfg->dedup_scratch_mem = dedup_scratch_mem;
+  cfg->dedup_trace_mem   = dedup_trace_mem;
   cfg->dedup_cr_max      = dedup_cr_max;
   cfg->dedup_lazy        = dedup_lazy;
   cfg->dedup_seed        = rng_seq++;
@@ -631,9 +646,10 @@ main( int     argc,
   }
 
   ulong dedup_seq0 = fd_rng_ulong( rng );
-  FD_TEST( fd_cnc_new   ( cfg->dedup_cnc_mem,    64UL, 1UL, now               ) );
+  FD_TEST( fd_cnc_new   ( cfg->dedup_cnc_mem,    dedup_cnc_app_sz, 1UL, now   ) );
   FD_TEST( fd_tcache_new( cfg->dedup_tcache_mem, tcache_depth, tcache_map_cnt ) );
   FD_TEST( fd_mcache_new( cfg->dedup_mcache_mem, dedup_depth, 0UL, dedup_seq0 ) );
+  FD_TEST( fd_trace_new ( cfg->dedup_trace_mem,  trace_depth, tx_cnt+1UL, trace_lg ) );
 
   for( ulong rx_idx=0UL; rx_idx<rx_cnt; rx_idx++ ) {
     FD_TEST( fd_cnc_new   ( cfg->rx_cnc_mem    + rx_idx*cfg->rx_cnc_footprint,    64UL, 2UL, now           ) );
@@ -686,6 +702,54 @@ main( int     argc,
     FD_TEST( !ret );
   }
 
+  /* Every frag the dedup processed from an in should be in that in's
+     latency histograms */
+
+  uint const * lat = fd_lat_cnc_laddr_const( cnc[ tx_cnt+1UL ], tx_cnt );
+  FD_TEST( lat );
+  for( ulong tx_idx=0UL; tx_idx<tx_cnt; tx_idx++ ) {
+    ulong const * diag = (ulong const *)fd_fseq_app_laddr_const( fd_fseq_join( cfg->tx_fseq_mem + tx_idx*cfg->tx_fseq_footprint ) );
+    ulong         cnt  = diag[ FD_FSEQ_DIAG_PUB_CNT ] + diag[ FD_FSEQ_DIAG_FILT_CNT ];
+    uint const *  link = fd_lat_link_const( lat, tx_idx );
+    FD_TEST( fd_lat_hist_cnt( link + FD_LAT_HIST_ORIG*FD_LAT_BKT_CNT, NULL )==cnt );
+    FD_TEST( fd_lat_hist_cnt( link + FD_LAT_HIST_PUB *FD_LAT_BKT_CNT, NULL )==cnt );
+    FD_LOG_NOTICE(( "in %lu: %lu frags, tsorig latency p50 <=%lu p99 <=%lu ticks", tx_idx, cnt,
+                    fd_lat_hist_pctile( link + FD_LAT_HIST_ORIG*FD_LAT_BKT_CNT, NULL, 0.50 ),
+                    fd_lat_hist_pctile( link + FD_LAT_HIST_ORIG*FD_LAT_BKT_CNT, NULL, 0.99 ) ));
+  }
+
+  /* Every event in the dedup trace should be for a sampled frag and
+     every sampled frag received should have been either filtered or
+     published (up to one frag whose rx or outcome fell off the edge of
+     the snapped window). */
+
+  fd_trace_t * trace     = fd_trace_join( cfg->dedup_trace_mem ); FD_TEST( trace );
+  ulong        event_max = trace_depth;
+  fd_trace_event_t * event = (fd_trace_event_t *)fd_wksp_alloc_laddr( wksp, alignof(fd_trace_event_t),
+                                                                      event_max*sizeof(fd_trace_event_t), 1UL );
+  FD_TEST( event );
+  ulong trace_cursor;
+  ulong trace_lost;
+  ulong event_cnt = fd_trace_snap( trace, 0UL, event, event_max, &trace_cursor, &trace_lost );
+  FD_TEST( event_cnt+trace_lost==trace_cursor );
+  ulong trace_cnt[ FD_TRACE_EVENT_CNT ] = { 0UL };
+  for( ulong event_idx=0UL; event_idx<event_cnt; event_idx++ ) {
+    fd_trace_event_t const * e = event + event_idx;
+    FD_TEST( fd_trace_sampled( trace, e->key ) );
+    FD_TEST( e->tile==(ushort)(tx_cnt+1UL) );
+    FD_TEST( e->event==FD_TRACE_EVENT_RX || e->event==FD_TRACE_EVENT_FILT || e->event==FD_TRACE_EVENT_PUB );
+    if( e->event!=FD_TRACE_EVENT_PUB ) FD_TEST( e->link<tx_cnt );
+    else                               FD_TEST( !e->link );
+    trace_cnt[ e->event ]++;
+  }
+  ulong trace_rx_cnt  = trace_cnt[ FD_TRACE_EVENT_RX ];
+  ulong trace_out_cnt = trace_cnt[ FD_TRACE_EVENT_FILT ] + trace_cnt[ FD_TRACE_EVENT_PUB ];
+  FD_TEST( trace_rx_cnt<=trace_out_cnt+1UL && trace_out_cnt<=trace_rx_cnt+1UL );
+  FD_LOG_NOTICE(( "trace: %lu events (%lu lost), %lu rx, %lu filt, %lu pub", event_cnt, trace_lost, trace_rx_cnt,
+                  trace_cnt[ FD_TRACE_EVENT_FILT ], trace_cnt[ FD_TRACE_EVENT_PUB ] ));
+  fd_wksp_free_laddr( event );
+  FD_TEST( fd_trace_leave( trace ) );
+
   for( ulong tile_idx=1UL; tile_idx<tile_cnt; tile_idx++ ) FD_TEST( fd_cnc_leave( cnc[ tile_idx ] ) );
 
   FD_LOG_NOTICE(( "Cleaning up" ));
@@ -697,6 +761,7 @@ main( int     argc,
     FD_TEST( fd_cnc_delete   ( cfg->rx_cnc_mem    + rx_idx*cfg->rx_cnc_footprint    ) );
   }
 
+  FD_TEST( fd_trace_delete ( cfg->dedup_trace_mem  ) );
   FD_TEST( fd_mcache_delete( cfg->dedup_mcache_mem ) );
   FD_TEST( fd_tcache_delete( cfg->dedup_tcache_mem ) );
   FD_TEST( fd_cnc_delete   ( cfg->dedup_cnc_mem    ) );
@@ -711,6 +776,7 @@ main( int     argc,
   }
 
   fd_wksp_free_laddr( rx_tcache_mem     );
+  fd_wksp_free_laddr( dedup_trace_mem   );
   fd_wksp_free_laddr( dedup_scratch_mem );
   fd_wksp_free_laddr( dedup_mcache_mem  );
   fd_wksp_free_laddr( dedup_tcache_mem  );
@@ -2,4 +2,5 @@ ifdef FD_HAS_OPENSSL
 $(call add-hdrs,fd_quic.h)
 $(call add-objs,fd_quic_tile,fd_disco)
 $(call make-unit-test,test_quic_tile,test_quic_tile,fd_disco fd_tango fd_ballet fd_quic fd_util)
+$(call make-unit-test,test_quic_tile_stream,test_quic_tile_stream,fd_disco fd_tango fd_ballet fd_quic fd_util)
 endif
@@ -26,6 +26,10 @@
    stream information in the dcache's application region.  (An array of
    fd_quic_tpu_msg_ctx_t)
 
+   Txns that arrive in a single packet (the common case) are published
+   as soon as their stream data is received.  Fragmented txns are
+   published once their stream is closed.
+
    ### Networking
 
    Each QUIC tile serves a single network device RX queue.  Serving
@@ -123,6 +127,7 @@ fd_quic_tile( fd_cnc_t *         cnc,           /* Local join to the tile's comm
               fd_xsk_aio_t *     xsk_aio,       /* Local join to QUIC XSK aio */
               fd_frag_meta_t *   mcache,        /* Local join to the tile's txn output mcache */
               uchar *            dcache,        /* Local join to the tile's txn output dcache */
+              fd_trace_t *       trace,         /* Local join to the tile's trace, NULL if not tracing */
               long               lazy,          /* Laziness, <=0 means use a reasonable default */
               fd_rng_t *         rng,           /* Local join to the rng this tile should use */
               void *             scratch,       /* Tile scratch memory */
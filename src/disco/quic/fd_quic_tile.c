@@ -63,13 +63,108 @@ struct fd_quic_tpu_ctx {
 
   fd_quic_tpu_msg_ctx_t ** pubq;
 
+  /* publish */
+
+  ulong                   tx_idx;
+  fd_trace_t *            trace;
+  fd_txn_parse_counters_t txn_parse_counters;
+
   /* meta */
 
+  ulong   cnc_diag_tpu_pub_cnt;
+  ulong   cnc_diag_tpu_pub_sz;
   ulong   cnc_diag_tpu_conn_live_cnt;
   ulong   cnc_diag_tpu_conn_seq;
 };
 typedef struct fd_quic_tpu_ctx fd_quic_tpu_ctx_t;
 
+/* fd_tpu_publish parses the completed txn of the given msg in place,
+   appends the txn trailer and publishes it to the tile's mcache.
+   Returns 1 if a frag was published and 0 if the txn was dropped. */
+
+static int
+fd_tpu_publish( fd_quic_tpu_ctx_t *     ctx,
+                fd_quic_tpu_msg_ctx_t * msg ) {
+
+  /* Get byte slice backing serialized txn data */
+
+  uchar * txn    = msg->data;
+  ulong   txn_sz = msg->sz;
+
+  FD_TEST( txn_sz<=1232UL );
+
+  /* At this point dcache only contains raw payload of txn.
+     Beyond end of txn, but within bounds of msg layout, add a trailer
+     describing the txn layout.
+
+     [ payload      ] (txn_sz bytes)
+     [ pad-align 2B ] (? bytes)
+     [ fd_txn_t     ] (? bytes)
+     [ payload_sz   ] (2B) */
+
+  /* Ensure sufficient space to store trailer */
+
+  void * txn_t = (void *)( fd_ulong_align_up( (ulong)msg->data + txn_sz, 2UL ) );
+  if( FD_UNLIKELY( (FD_TPU_DCACHE_MTU - ((ulong)txn_t - (ulong)msg->data)) < (FD_TXN_MAX_SZ+2UL) ) ) {
+    FD_LOG_WARNING(( "dcache entry too small" ));
+    return 0;
+  }
+
+  /* Parse transaction */
+
+  ulong txn_t_sz = fd_txn_parse( txn, txn_sz, txn_t, &ctx->txn_parse_counters );
+  if( txn_t_sz==0 ) {
+    FD_LOG_DEBUG(( "fd_txn_parse(sz=%lu) failed", txn_sz ));
+    return 0; /* invalid txn (terminate conn?) */
+  }
+
+  /* Transactions are traced by the first 8 bytes of their first
+     signature (same as the sig of the frag the verify tiles
+     publish for it) */
+
+  fd_trace_t * trace     = ctx->trace;
+  ulong        trace_key = 0UL;
+  int          traced    = 0;
+  if( FD_UNLIKELY( trace ) ) {
+    trace_key = FD_LOAD( ulong, txn + ((fd_txn_t const *)txn_t)->signature_off );
+    traced    = fd_trace_sampled( trace, trace_key );
+  }
+
+  /* Write payload_sz */
+
+  ushort * payload_sz = (ushort *)( (ulong)txn_t + txn_t_sz );
+  *payload_sz = (ushort)txn_sz;
+
+  /* End of message */
+
+  void * msg_end = (void *)( (ulong)payload_sz + 2UL );
+
+  /* Create mcache entry */
+
+  ulong seq    = *ctx->seq;
+  ulong chunk  = fd_laddr_to_chunk( ctx->base, msg->data );
+  ulong sz     = (ulong)msg_end - (ulong)msg->data;
+  ulong sig    = 0; /* A non-dummy entry representing a finished transaction */
+  ulong ctl    = fd_frag_meta_ctl( ctx->tx_idx, 1 /* som */, 1 /* eom */, 0 /* err */ );
+  ulong tsorig = msg->tsorig;
+  long  tsnow  = fd_tickcount();
+  ulong tspub  = fd_frag_meta_ts_comp( tsnow );
+
+  fd_mcache_publish( ctx->mcache, ctx->depth, seq, sig, chunk, sz, ctl, tsorig, tspub );
+
+  if( FD_UNLIKELY( traced ) ) {
+    fd_trace_record( trace, trace_key, 0UL, 0UL, FD_TRACE_EVENT_RX,  fd_frag_meta_ts_decomp( tsorig, tsnow ) );
+    fd_trace_record( trace, trace_key, 0UL, seq, FD_TRACE_EVENT_PUB, tsnow                                   );
+  }
+
+  /* Windup for the next publish and accumulate diagnostics */
+
+  *ctx->seq = fd_seq_inc( seq, 1UL );
+  ctx->cnc_diag_tpu_pub_cnt++;
+  ctx->cnc_diag_tpu_pub_sz += sz;
+  return 1;
+}
+
 /* QUIC callbacks *****************************************************/
 
 /* Tile-local sequence number for conns */
@@ -180,8 +275,6 @@ fd_tpu_stream_receive( fd_quic_stream_t * stream,
                        ulong              offset,
                        int                fin ) {
 
-  (void)fin; /* TODO instantly publish if offset==0UL && fin */
-
   /* Bounds check */
   /* TODO this bounds check is not complete and assumes that the QUIC
      implementation rejects obviously invalid offset values, e.g. those
@@ -201,16 +294,35 @@ fd_tpu_stream_receive( fd_quic_stream_t * stream,
   /* Load existing dcache chunk ctx */
 
   fd_quic_tpu_msg_ctx_t * msg_ctx = (fd_quic_tpu_msg_ctx_t *)stream_ctx;
+  if( FD_UNLIKELY( !msg_ctx ) )
+    return;  /* already published */
   if( FD_UNLIKELY( msg_ctx->conn_id != conn_id || msg_ctx->stream_id != stream_id ) ) {
     //fd_quic_stream_close( stream, 0x03 ); /* FIXME fd_quic_stream_close not implemented */
     FD_LOG_WARNING(( "dcache overflow while demuxing %lu!=%lu %lu!=%lu", conn_id, msg_ctx->conn_id, stream_id, msg_ctx->stream_id ));
     return;  /* overrun */
   }
 
-  /* Append data into chunk */
+  /* Append data into chunk.  This is the only copy of txn data in the
+     tile: data points into the conn's decrypt scratch (fd_quic decrypts
+     out of place), and is only valid for the duration of this call. */
 
   fd_memcpy( msg_ctx->data + offset, data, data_sz );
   msg_ctx->sz = (uint)total_sz;
+
+  /* Most txns fit in a single packet.  Publish those right away while
+     the chunk is still hot in cache rather than deferring them to the
+     publish queue.  This also keeps inflight_streams at zero across a
+     batch of such streams, such that fd_tpu_stream_create does not need
+     to publish dummy frags to reclaim chunks.  The stream context is
+     cleared such that the upcoming end notification is ignored. */
+
+  if( offset==0UL && fin ) {
+    fd_quic_tpu_ctx_t * ctx = stream->conn->quic->cb.quic_ctx;
+    msg_ctx->stream_id = ULONG_MAX;
+    fd_tpu_publish( ctx, msg_ctx );
+    ctx->inflight_streams -= 1;
+    stream->context = NULL;
+  }
 }
 
 /* fd_tpu_stream_notify implements fd_quic_cb_stream_notify_t */
@@ -218,6 +330,9 @@ static void
 fd_tpu_stream_notify( fd_quic_stream_t * stream,
                       void *             stream_ctx,
                       int                type ) {
+  if( FD_LIKELY( !stream_ctx ) )
+    return;  /* already published by fd_tpu_stream_receive */
+
   /* Load QUIC state */
 
   fd_quic_tpu_msg_ctx_t * msg_ctx = (fd_quic_tpu_msg_ctx_t *)stream_ctx;
@@ -261,6 +376,7 @@ fd_quic_tile( fd_cnc_t *         cnc,
               fd_xsk_aio_t *     xsk_aio,
               fd_frag_meta_t *   mcache,
               uchar *            dcache,
+              fd_trace_t *       trace,
               long               lazy,
               fd_rng_t *         rng,
               void *             scratch,
@@ -268,8 +384,6 @@ fd_quic_tile( fd_cnc_t *         cnc,
 
   /* cnc state */
   ulong * cnc_diag;
-  ulong   cnc_diag_tpu_pub_cnt;
-  ulong   cnc_diag_tpu_pub_sz;
 
   /* out frag stream state */
   ulong   depth;  /* ==fd_mcache_depth( mcache ), depth of the mcache / positive integer power of 2 */
@@ -293,9 +407,6 @@ fd_quic_tile( fd_cnc_t *         cnc,
 
   ulong mtu = FD_TPU_DCACHE_MTU;
 
-  /* txn parser */
-  fd_txn_parse_counters_t txn_parse_counters = {0};
-
   do {
 
     FD_LOG_INFO(( "Booting quic" ));
@@ -320,9 +431,6 @@ fd_quic_tile( fd_cnc_t *         cnc,
 
     cnc_diag = (ulong *)fd_cnc_app_laddr( cnc );
 
-    cnc_diag_tpu_pub_cnt = 0UL;
-    cnc_diag_tpu_pub_sz  = 0UL;
-
     /* out frag stream init */
 
     if( FD_UNLIKELY( !mcache ) ) { FD_LOG_WARNING(( "NULL mcache" )); return 1; }
@@ -390,6 +498,10 @@ fd_quic_tile( fd_cnc_t *         cnc,
     quic_ctx.wmark      = wmark;
     quic_ctx.chunk      = chunk;
     quic_ctx.pubq       = msg_pubq;
+    quic_ctx.tx_idx     = fd_tile_idx();
+    quic_ctx.trace      = trace;
+    quic_ctx.cnc_diag_tpu_pub_cnt = 0UL;
+    quic_ctx.cnc_diag_tpu_pub_sz  = 0UL;
     quic_ctx.cnc_diag_tpu_conn_live_cnt = 0UL;
     quic_ctx.seq        = &seq;
     quic_ctx.mcache     = mcache;
@@ -410,8 +522,6 @@ fd_quic_tile( fd_cnc_t *         cnc,
 
   } while(0);
 
-  ulong tx_idx  = fd_tile_idx();
-
   FD_LOG_INFO(( "running QUIC server" ));
   fd_cnc_signal( cnc, FD_CNC_SIGNAL_RUN );
   long then = fd_tickcount();
@@ -427,13 +537,13 @@ fd_quic_tile( fd_cnc_t *         cnc,
       fd_cnc_heartbeat( cnc, now );
       FD_COMPILER_MFENCE();
       cnc_diag[ FD_QUIC_CNC_DIAG_CHUNK_IDX         ]  = chunk;
-      cnc_diag[ FD_QUIC_CNC_DIAG_TPU_PUB_CNT       ] += cnc_diag_tpu_pub_cnt;
-      cnc_diag[ FD_QUIC_CNC_DIAG_TPU_PUB_SZ        ] += cnc_diag_tpu_pub_sz;
+      cnc_diag[ FD_QUIC_CNC_DIAG_TPU_PUB_CNT       ] += quic_ctx.cnc_diag_tpu_pub_cnt;
+      cnc_diag[ FD_QUIC_CNC_DIAG_TPU_PUB_SZ        ] += quic_ctx.cnc_diag_tpu_pub_sz;
       cnc_diag[ FD_QUIC_CNC_DIAG_TPU_CONN_LIVE_CNT ]  = quic_ctx.cnc_diag_tpu_conn_live_cnt;
       cnc_diag[ FD_QUIC_CNC_DIAG_TPU_CONN_SEQ      ]  = quic_ctx.cnc_diag_tpu_conn_seq;
       FD_COMPILER_MFENCE();
-      cnc_diag_tpu_pub_cnt = 0UL;
-      cnc_diag_tpu_pub_sz  = 0UL;
+      quic_ctx.cnc_diag_tpu_pub_cnt = 0UL;
+      quic_ctx.cnc_diag_tpu_pub_sz  = 0UL;
 
       /* Receive command-and-control signals */
       ulong s = fd_cnc_signal_query( cnc );
@@ -464,64 +574,8 @@ fd_quic_tile( fd_cnc_t *         cnc,
       if( FD_UNLIKELY( msg->stream_id != ULONG_MAX ) )
         continue;  /* overrun */
 
-      /* Get byte slice backing serialized txn data */
-
-      uchar * txn    = msg->data;
-      ulong   txn_sz = msg->sz;
-
-      FD_TEST( txn_sz<=1232UL );
-
-      /* At this point dcache only contains raw payload of txn.
-         Beyond end of txn, but within bounds of msg layout, add a trailer
-         describing the txn layout.
-
-         [ payload      ] (txn_sz bytes)
-         [ pad-align 2B ] (? bytes)
-         [ fd_txn_t     ] (? bytes)
-         [ payload_sz   ] (2B) */
-
-      /* Ensure sufficient space to store trailer */
-
-      void * txn_t = (void *)( fd_ulong_align_up( (ulong)msg->data + txn_sz, 2UL ) );
-      if( FD_UNLIKELY( (mtu - ((ulong)txn_t - (ulong)msg->data)) < (FD_TXN_MAX_SZ+2UL) ) ) {
-        FD_LOG_WARNING(( "dcache entry too small" ));
-        continue;
-      }
-
-      /* Parse transaction */
-
-      ulong txn_t_sz = fd_txn_parse( txn, txn_sz, txn_t, &txn_parse_counters );
-      if( txn_t_sz==0 ) {
-        FD_LOG_DEBUG(( "fd_txn_parse(sz=%lu) failed", txn_sz ));
-        continue; /* invalid txn (terminate conn?) */
-      }
-
-      /* Write payload_sz */
-
-      ushort * payload_sz = (ushort *)( (ulong)txn_t + txn_t_sz );
-      *payload_sz = (ushort)txn_sz;
-
-      /* End of message */
-
-      void * msg_end = (void *)( (ulong)payload_sz + 2UL );
-
-      /* Create mcache entry */
-
-      ulong chunk  = fd_laddr_to_chunk( base, msg->data );
-      ulong sz     = (ulong)msg_end - (ulong)msg->data;
-      ulong sig    = 0; /* A non-dummy entry representing a finished transaction */
-      ulong ctl    = fd_frag_meta_ctl( tx_idx, 1 /* som */, 1 /* eom */, 0 /* err */ );
-      ulong tsorig = msg->tsorig;
-      ulong tspub  = fd_frag_meta_ts_comp( fd_tickcount() );
-
-      fd_mcache_publish( mcache, depth, seq, sig, chunk, sz, ctl, tsorig, tspub );
+      fd_tpu_publish( &quic_ctx, msg );
       quic_ctx.inflight_streams -= 1;
-
-      /* Windup for the next iteration and accumulate diagnostics */
-
-      seq = fd_seq_inc( seq, 1UL );
-      cnc_diag_tpu_pub_cnt++;
-      cnc_diag_tpu_pub_sz += sz;
     }
     pubq_remove_all( msg_pubq );
 
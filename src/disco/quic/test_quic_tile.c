@@ -190,6 +190,7 @@ tx_tile_main( int     argc,
       cfg->xsk_aio,
       cfg->tx_mcache,
       cfg->tx_dcache,
+      NULL,
       cfg->tx_lazy,
       rng,
       scratch,
@@ -314,7 +315,7 @@ int main( int     argc,
 
   FD_LOG_NOTICE(( "Listening on " FD_IP4_ADDR_FMT ":%u",
                   FD_IP4_ADDR_FMT_ARGS( listen_addr ), udp_port ));
-  FD_TEST( 0==fd_xdp_listen_udp_port( bpf_dir, listen_addr, udp_port, 0U ) );
+  FD_TEST( 0==fd_xdp_listen_udp_port( bpf_dir, listen_addr, udp_port, FD_XDP_PROTO_TPU_QUIC_USER ) );
 
   FD_LOG_NOTICE(( "Joining xsk" ));
   cfg->xsk = fd_xsk_join( shxsk );
@@ -0,0 +1,186 @@
+#include "../../util/fd_util.h"
+
+#if FD_HAS_HOSTED && FD_HAS_X86 && FD_HAS_OPENSSL
+
+/* Drives the TPU stream callbacks of the QUIC tile directly, without a
+   network device or QUIC handshake. */
+
+#include "fd_quic_tile.c"
+#include "../../tango/quic/fd_quic_conn.h"
+
+/* This transaction landed on mainnet (507 bytes) */
+FD_IMPORT_BINARY( txn_bin, "src/ballet/txn/fixtures/transaction2.bin" );
+
+static fd_quic_t        quic[1];
+static fd_quic_conn_t   conn[1];
+static fd_quic_stream_t stream[4];
+
+/* test_frag checks the frag at seq in mcache.  Returns the frag's
+   chunk.  sig==0 are txns, which are checked to match txn_bin. */
+
+static ulong
+test_frag( fd_quic_tpu_ctx_t * ctx,
+           ulong               seq,
+           ulong               sig ) {
+  fd_frag_meta_t const * mline = ctx->mcache + fd_mcache_line_idx( seq, ctx->depth );
+  FD_TEST( mline->seq==seq );
+  FD_TEST( mline->sig==sig );
+  if( !sig ) {
+    uchar const * p = fd_chunk_to_laddr_const( ctx->base, mline->chunk );
+    ulong payload_sz = *(ushort const *)( p + mline->sz - sizeof(ushort) );
+    FD_TEST( payload_sz==txn_bin_sz );
+    FD_TEST( !memcmp( p, txn_bin, txn_bin_sz ) );
+    fd_txn_t const * txn = (fd_txn_t const *)( p + fd_ulong_align_up( payload_sz, 2UL ) );
+    FD_TEST( txn->signature_cnt );
+  }
+  return mline->chunk;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong cpu_idx = fd_tile_cpu_id( fd_tile_idx() );
+  if( cpu_idx>fd_shmem_cpu_cnt() ) cpu_idx = 0UL;
+
+  char const * _page_sz = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",  NULL, "normal"                     );
+  ulong        page_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt", NULL, 1024UL                       );
+  ulong        numa_idx = fd_env_strip_cmdline_ulong( &argc, &argv, "--numa-idx", NULL, fd_shmem_numa_idx( cpu_idx ) );
+  ulong        depth    = fd_env_strip_cmdline_ulong( &argc, &argv, "--depth",    NULL, 128UL                        );
+
+  FD_LOG_NOTICE(( "Creating workspace (--page-cnt %lu, --page-sz %s, --numa-idx %lu)", page_cnt, _page_sz, numa_idx ));
+  fd_wksp_t * wksp =
+    fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
+  FD_TEST( wksp );
+
+  ulong seq0 = 0UL;
+  fd_frag_meta_t * mcache = fd_mcache_join( fd_mcache_new(
+      fd_wksp_alloc_laddr( wksp, fd_mcache_align(), fd_mcache_footprint( depth, 0UL ), 1UL ), depth, 0UL, seq0 ) );
+  FD_TEST( mcache );
+
+  ulong   app_sz  = fd_quic_dcache_app_footprint( depth );
+  ulong   data_sz = fd_dcache_req_data_sz( FD_TPU_DCACHE_MTU, depth, 1UL, 1 ); FD_TEST( data_sz );
+  uchar * dcache  = fd_dcache_join( fd_dcache_new(
+      fd_wksp_alloc_laddr( wksp, fd_dcache_align(), fd_dcache_footprint( data_sz, app_sz ), 1UL ), data_sz, app_sz ) );
+  FD_TEST( dcache );
+
+  ulong pubq_mem_sz = pubq_footprint( depth );
+  fd_quic_tpu_msg_ctx_t ** msg_pubq = pubq_join( pubq_new( fd_wksp_alloc_laddr( wksp, pubq_align(), pubq_mem_sz, 1UL ), depth ) );
+  FD_TEST( msg_pubq );
+
+  /* Set up the tile's QUIC context the same way fd_quic_tile does */
+
+  ulong seq = seq0;
+
+  fd_quic_tpu_ctx_t ctx[1] = {{0}};
+  ctx->base             = (uchar *)wksp;
+  ctx->dcache_app       = fd_dcache_app_laddr( dcache );
+  ctx->chunk0           = fd_dcache_compact_chunk0( wksp, dcache );
+  ctx->wmark            = fd_dcache_compact_wmark ( wksp, dcache, FD_TPU_DCACHE_MTU );
+  ctx->chunk            = ctx->chunk0;
+  ctx->inflight_streams = 0UL;
+  ctx->mcache           = mcache;
+  ctx->seq              = &seq;
+  ctx->depth            = depth;
+  ctx->pubq             = msg_pubq;
+
+  quic->cb.quic_ctx   = ctx;
+  conn->quic          = quic;
+  conn->local_conn_id = 1UL;
+  for( ulong i=0UL; i<4UL; i++ ) {
+    stream[i].conn      = conn;
+    stream[i].stream_id = i<<2;
+    stream[i].context   = NULL;
+  }
+
+  /* A batch of txns that fit into the first stream frame are published
+     from stream_receive.  inflight_streams never exceeds one, so no
+     dummy frags are published to reclaim dcache chunks. */
+
+  for( ulong i=0UL; i<4UL; i++ ) {
+    fd_tpu_stream_create( stream+i, ctx, 0 );
+    FD_TEST( ctx->inflight_streams==1UL );
+    FD_TEST( seq==seq0+i );
+    FD_TEST( stream[i].context );
+
+    fd_tpu_stream_receive( stream+i, stream[i].context, txn_bin, txn_bin_sz, 0UL, 1 );
+    FD_TEST( ctx->inflight_streams==0UL );
+    FD_TEST( seq==seq0+i+1UL );
+    FD_TEST( !stream[i].context );
+    FD_TEST( test_frag( ctx, seq0+i, 0UL )==ctx->chunk );
+
+    /* The end notification of a published stream is ignored */
+    fd_tpu_stream_notify( stream+i, stream[i].context, FD_QUIC_NOTIFY_END );
+    FD_TEST( ctx->inflight_streams==0UL );
+    FD_TEST( !pubq_cnt( msg_pubq ) );
+  }
+  FD_TEST( ctx->cnc_diag_tpu_pub_cnt==4UL );
+  seq0 = seq;
+
+  /* Fragmented txns are published from the publish queue once their
+     stream ends.  Creating a stream while another one is in flight
+     publishes a dummy frag. */
+
+  ulong split = txn_bin_sz/2UL;
+  for( ulong i=0UL; i<2UL; i++ ) {
+    stream[i].stream_id += 16UL;
+    fd_tpu_stream_create( stream+i, ctx, 0 );
+    fd_tpu_stream_receive( stream+i, stream[i].context, txn_bin, split, 0UL, 0 );
+    FD_TEST( stream[i].context );
+  }
+  FD_TEST( ctx->inflight_streams==2UL );
+  FD_TEST( seq==seq0+1UL );
+  test_frag( ctx, seq0, 1UL );
+
+  for( ulong i=0UL; i<2UL; i++ ) {
+    fd_tpu_stream_receive( stream+i, stream[i].context, txn_bin+split, txn_bin_sz-split, split, 1 );
+    FD_TEST( stream[i].context );
+    fd_tpu_stream_notify( stream+i, stream[i].context, FD_QUIC_NOTIFY_END );
+  }
+  FD_TEST( ctx->inflight_streams==2UL );
+  FD_TEST( pubq_cnt( msg_pubq )==2UL );
+  FD_TEST( seq==seq0+1UL );
+
+  for( ulong i=0UL; i<2UL; i++ ) {
+    FD_TEST( fd_tpu_publish( ctx, msg_pubq[i] ) );
+    ctx->inflight_streams -= 1;
+  }
+  pubq_remove_all( msg_pubq );
+  FD_TEST( ctx->inflight_streams==0UL );
+  test_frag( ctx, seq0+1UL, 0UL );
+  test_frag( ctx, seq0+2UL, 0UL );
+  seq0 = seq;
+
+  /* A stream that is aborted before completion releases its slot */
+
+  stream[0].stream_id += 16UL;
+  fd_tpu_stream_create( stream, ctx, 0 );
+  fd_tpu_stream_receive( stream, stream[0].context, txn_bin, split, 0UL, 0 );
+  FD_TEST( ctx->inflight_streams==1UL );
+  fd_tpu_stream_notify( stream, stream[0].context, FD_QUIC_NOTIFY_ABORT );
+  FD_TEST( ctx->inflight_streams==0UL );
+  FD_TEST( seq==seq0 );
+
+  fd_wksp_free_laddr( pubq_delete      ( pubq_leave      ( msg_pubq ) ) );
+  fd_wksp_free_laddr( fd_dcache_delete ( fd_dcache_leave ( dcache   ) ) );
+  fd_wksp_free_laddr( fd_mcache_delete ( fd_mcache_leave ( mcache   ) ) );
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else /* FD_HAS_HOSTED && FD_HAS_X86 && FD_HAS_OPENSSL */
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED, FD_HAS_X86, FD_HAS_OPENSSL capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif /* FD_HAS_HOSTED && FD_HAS_X86 && FD_HAS_OPENSSL */
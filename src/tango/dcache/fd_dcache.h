@@ -268,6 +268,170 @@ fd_dcache_compact_next( ulong chunk,    /* Assumed in [chunk0,wmark] */
   return fd_ulong_if( chunk>wmark, chunk0, chunk );                 /* If that goes over the high water mark, wrap to zero */
 }
 
+/* Multi-frag messages:
+
+   A message larger than a single frag can carry (fd_frag_meta_t sz is
+   16 bits) can be sent as a run of consecutive frags whose payloads are
+   stored contiguously in a compact dcache.  The first frag of the
+   message has its SOM bit set, the last its EOM bit set (a message that
+   fits in one frag has both set).  Every frag but the last has exactly
+   frag_mtu bytes, where frag_mtu is a positive multiple of
+   2*FD_CHUNK_SZ no larger than FD_DCACHE_MSG_FRAG_MTU_MAX, so that frag
+   i of a message starting at chunk is at chunk + i*frag_mtu/FD_CHUNK_SZ.
+
+   The producer reserves room for a whole message exactly as it would a
+   single frag, just with the message mtu in place of the frag mtu:
+   the dcache is sized with FD_DCACHE_REQ_DATA_SZ( msg_mtu, depth, 1, 1 ),
+   the watermark is fd_dcache_compact_wmark( base, dcache, msg_mtu ), the
+   message payload is written starting at chunk and the next message
+   starts at fd_dcache_compact_next( chunk, msg_sz, chunk0, wmark ).
+   This is safe because each message uses at least one of the depth
+   mcache lines.  The frag metadata for a message is then given by
+   fd_dcache_msg_frag_meta and can be published with a single
+   fd_mcache_publish_burst.
+
+   A consumer feeds each frag it receives to fd_dcache_msg_append, which
+   checks that the frags of a message are sequential and contiguous.
+   When the EOM frag arrives, the whole message can be read in place at
+   fd_dcache_msg_laddr_const without any copying.  As for single frags,
+   the producer may have overwritten the payload by the time the
+   consumer is done with it.  The payload was intact if the SOM frag was
+   not overrun when the consumer finished, i.e. if
+   fd_mcache_query( mcache, depth, msg->seq0 ) still returns msg->seq0
+   (the producer cannot reuse the message's chunks until depth more
+   frags have been published after the SOM frag). */
+
+#define FD_DCACHE_MSG_FRAG_MTU_MAX (65408UL) /* Largest multiple of 2*FD_CHUNK_SZ that fits in 16 bits */
+
+/* FD_DCACHE_MSG_* give the possible return values of
+   fd_dcache_msg_append.  The error codes are negative; on error, any
+   message being reassembled is discarded. */
+
+#define FD_DCACHE_MSG_CONT        ( 0) /* Frag accepted, more frags needed to complete the message */
+#define FD_DCACHE_MSG_DONE        ( 1) /* Frag accepted, message complete */
+#define FD_DCACHE_MSG_ERR_ORPHAN  (-1) /* Frag is not SOM but no message is being reassembled */
+#define FD_DCACHE_MSG_ERR_SEQ     (-2) /* Frag does not immediately follow the previous frag of the message (overrun) */
+#define FD_DCACHE_MSG_ERR_LAYOUT  (-3) /* Frag payload does not immediately follow the previous frag's payload */
+#define FD_DCACHE_MSG_ERR_FRAG    (-4) /* Frag has its ERR bit set */
+
+/* fd_dcache_msg_t is the consumer side reassembly state for a
+   multi-frag message.  It only records where the message is; the
+   payload itself is never copied. */
+
+struct fd_dcache_msg {
+  ulong seq0;     /* Sequence number of the message's SOM frag */
+  ulong seq;      /* Sequence number of the next frag expected */
+  ulong chunk;    /* Chunk of the message's SOM frag (i.e. the start of the message payload) */
+  ulong sz;       /* Bytes of payload reassembled so far */
+  ulong frag_cnt; /* Number of frags reassembled so far */
+  int   active;   /* 1 if a message is being reassembled (SOM seen but not EOM) */
+};
+
+typedef struct fd_dcache_msg fd_dcache_msg_t;
+
+/* fd_dcache_msg_frag_cnt returns the number of frags needed to send a
+   msg_sz byte message in frags of at most frag_mtu bytes.  This is at
+   least 1 (a zero byte message is a single zero byte frag).  frag_mtu
+   is assumed valid as described above. */
+
+FD_FN_CONST static inline ulong
+fd_dcache_msg_frag_cnt( ulong msg_sz,
+                        ulong frag_mtu ) {
+  return fd_ulong_max( (msg_sz + frag_mtu - 1UL) / frag_mtu, 1UL );
+}
+
+/* fd_dcache_msg_frag_meta fills in meta[i] for i in [0,frag_cnt) with
+   the metadata for the frags of a msg_sz byte message whose payload
+   starts at chunk and returns frag_cnt, where frag_cnt is
+   fd_dcache_msg_frag_cnt( msg_sz, frag_mtu ).  meta should have room
+   for at least that many entries.  Every frag gets the same sig, orig,
+   tsorig and tspub.  meta[i].seq is set to zero (fd_mcache_publish_burst
+   ignores it). */
+
+static inline ulong
+fd_dcache_msg_frag_meta( fd_frag_meta_t * meta,
+                         ulong            chunk,    /* Assumed in [chunk0,wmark] */
+                         ulong            msg_sz,   /* Assumed in [0,msg_mtu] */
+                         ulong            frag_mtu, /* Assumed valid */
+                         ulong            sig,
+                         ulong            orig,
+                         ulong            tsorig,
+                         ulong            tspub ) {
+  ulong frag_cnt   = fd_dcache_msg_frag_cnt( msg_sz, frag_mtu );
+  ulong chunk_frag = frag_mtu >> FD_CHUNK_LG_SZ;
+  for( ulong i=0UL; i<frag_cnt; i++ ) {
+    int eom = (i==frag_cnt-1UL);
+    meta[i].seq    = 0UL;
+    meta[i].sig    = sig;
+    meta[i].chunk  = (uint)(chunk + i*chunk_frag);
+    meta[i].sz     = (ushort)fd_ulong_if( eom, msg_sz - i*frag_mtu, frag_mtu );
+    meta[i].ctl    = (ushort)fd_frag_meta_ctl( orig, i==0UL, eom, 0 );
+    meta[i].tsorig = (uint)tsorig;
+    meta[i].tspub  = (uint)tspub;
+  }
+  return frag_cnt;
+}
+
+/* fd_dcache_msg_reset discards any message being reassembled by msg.
+   Also used to initialize msg.  Returns msg. */
+
+static inline fd_dcache_msg_t *
+fd_dcache_msg_reset( fd_dcache_msg_t * msg ) {
+  msg->seq0     = 0UL;
+  msg->seq      = 0UL;
+  msg->chunk    = 0UL;
+  msg->sz       = 0UL;
+  msg->frag_cnt = 0UL;
+  msg->active   = 0;
+  return msg;
+}
+
+/* fd_dcache_msg_append adds the frag with sequence number seq and
+   metadata chunk, sz and ctl to the message being reassembled by msg.
+   Returns FD_DCACHE_MSG_DONE if this frag completed a message (msg
+   then describes the complete message until the next call),
+   FD_DCACHE_MSG_CONT if more frags are needed and a negative
+   FD_DCACHE_MSG_ERR_* code if the frag could not be used (msg is then
+   reset).  A SOM frag always starts a new message, discarding any
+   incomplete one. */
+
+static inline int
+fd_dcache_msg_append( fd_dcache_msg_t * msg,
+                      ulong             seq,
+                      ulong             chunk,
+                      ulong             sz,
+                      ulong             ctl ) {
+  if( fd_frag_meta_ctl_som( ctl ) ) {
+    msg->seq0     = seq;
+    msg->chunk    = chunk;
+    msg->sz       = 0UL;
+    msg->frag_cnt = 0UL;
+  } else {
+    if( FD_UNLIKELY( !msg->active ) ) { fd_dcache_msg_reset( msg ); return FD_DCACHE_MSG_ERR_ORPHAN; }
+    if( FD_UNLIKELY( fd_seq_ne( seq, msg->seq ) ) ) { fd_dcache_msg_reset( msg ); return FD_DCACHE_MSG_ERR_SEQ; }
+    if( FD_UNLIKELY( (!fd_ulong_is_aligned( msg->sz, 2UL*FD_CHUNK_SZ )) |
+                     (chunk!=msg->chunk + (msg->sz >> FD_CHUNK_LG_SZ)) ) ) { fd_dcache_msg_reset( msg ); return FD_DCACHE_MSG_ERR_LAYOUT; }
+  }
+  if( FD_UNLIKELY( fd_frag_meta_ctl_err( ctl ) ) ) { fd_dcache_msg_reset( msg ); return FD_DCACHE_MSG_ERR_FRAG; }
+
+  msg->seq       = fd_seq_inc( seq, 1UL );
+  msg->sz       += sz;
+  msg->frag_cnt += 1UL;
+  msg->active    = !fd_frag_meta_ctl_eom( ctl );
+  return fd_int_if( msg->active, FD_DCACHE_MSG_CONT, FD_DCACHE_MSG_DONE );
+}
+
+/* fd_dcache_msg_laddr_const returns the location in the caller's local
+   address space of the first byte of the message payload described by
+   msg, given the same base used for chunk indexing by the producer.
+   The payload is msg->sz contiguous bytes. */
+
+FD_FN_PURE static inline uchar const *
+fd_dcache_msg_laddr_const( fd_dcache_msg_t const * msg,
+                           void const *            base ) {
+  return (uchar const *)fd_chunk_to_laddr_const( base, msg->chunk );
+}
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_tango_dcache_fd_dcache_h */
@@ -201,6 +201,109 @@ main( int     argc,
     }
   }
 
+  /* Test multi-frag messages */
+
+  ulong msg_mtu  = 1000UL;
+  ulong frag_mtu = 128UL;
+  ulong msg_depth = 16UL;
+  if( FD_LIKELY( data_sz >= fd_dcache_req_data_sz( msg_mtu, msg_depth, 1UL /*burst*/, 1 /*compact*/ ) ) ) {
+    uchar * base = dcache;
+
+    FD_TEST( fd_dcache_compact_is_safe( base, dcache, msg_mtu, msg_depth ) );
+    ulong chunk0 = fd_dcache_compact_chunk0( base, dcache );
+    ulong wmark  = fd_dcache_compact_wmark ( base, dcache, msg_mtu );
+
+    FD_TEST( fd_ulong_is_aligned( FD_DCACHE_MSG_FRAG_MTU_MAX, 2UL*FD_CHUNK_SZ ) );
+    FD_TEST( FD_DCACHE_MSG_FRAG_MTU_MAX<=(ulong)USHORT_MAX && FD_DCACHE_MSG_FRAG_MTU_MAX+2UL*FD_CHUNK_SZ>(ulong)USHORT_MAX );
+
+    FD_TEST( fd_dcache_msg_frag_cnt(   0UL, 128UL )==1UL );
+    FD_TEST( fd_dcache_msg_frag_cnt(   1UL, 128UL )==1UL );
+    FD_TEST( fd_dcache_msg_frag_cnt( 128UL, 128UL )==1UL );
+    FD_TEST( fd_dcache_msg_frag_cnt( 129UL, 128UL )==2UL );
+    FD_TEST( fd_dcache_msg_frag_cnt( 256UL, 128UL )==2UL );
+
+    fd_frag_meta_t  meta[ 8 ];
+    fd_dcache_msg_t msg[1]; fd_dcache_msg_reset( msg );
+
+    ulong chunk = chunk0;
+    ulong seq   = 1234UL;
+    for( ulong iter=0UL; iter<100000UL; iter++ ) {
+
+      /* Produce a random message */
+
+      ulong msg_sz = fd_rng_ulong_roll( rng, msg_mtu+1UL ); /* In [0,msg_mtu] */
+      uchar * p    = (uchar *)fd_chunk_to_laddr( base, chunk );
+      for( ulong b=0UL; b<msg_sz; b++ ) p[b] = (uchar)(iter+b);
+
+      ulong frag_cnt = fd_dcache_msg_frag_meta( meta, chunk, msg_sz, frag_mtu, iter, 3UL, 5UL, 7UL );
+      FD_TEST( frag_cnt==fd_dcache_msg_frag_cnt( msg_sz, frag_mtu ) );
+      FD_TEST( frag_cnt<=8UL );
+      for( ulong i=0UL; i<frag_cnt; i++ ) meta[i].seq = fd_seq_inc( seq, i );
+
+      /* Occasionally drop or corrupt a frag */
+
+      ulong bad = ULONG_MAX;
+      int   how = 0;
+      if( frag_cnt>1UL && !fd_rng_uint_roll( rng, 8U ) ) {
+        bad = 1UL + fd_rng_ulong_roll( rng, frag_cnt-1UL ); /* In [1,frag_cnt) */
+        how = (int)fd_rng_uint_roll( rng, 3U );
+      }
+
+      /* Consume it */
+
+      int done = 0;
+      for( ulong i=0UL; i<frag_cnt; i++ ) {
+        ulong f_seq   = meta[i].seq;
+        ulong f_chunk = meta[i].chunk;
+        ulong f_ctl   = meta[i].ctl;
+        int   expect  = fd_int_if( i==frag_cnt-1UL, FD_DCACHE_MSG_DONE, FD_DCACHE_MSG_CONT );
+        if( i==bad ) {
+          switch( how ) {
+          case 0:  f_seq   = fd_seq_inc( f_seq, 1UL );                            expect = FD_DCACHE_MSG_ERR_SEQ;    break;
+          case 1:  f_chunk = f_chunk + 2UL;                                       expect = FD_DCACHE_MSG_ERR_LAYOUT; break;
+          default: f_ctl   = fd_frag_meta_ctl( 3UL, 0, i==frag_cnt-1UL, 1 );      expect = FD_DCACHE_MSG_ERR_FRAG;   break;
+          }
+        }
+        if( i>bad ) expect = FD_DCACHE_MSG_ERR_ORPHAN;
+        int res = fd_dcache_msg_append( msg, f_seq, f_chunk, meta[i].sz, f_ctl );
+        FD_TEST( res==expect );
+        done = (res==FD_DCACHE_MSG_DONE);
+        if( i==0UL ) FD_TEST( fd_frag_meta_ctl_orig( meta[i].ctl )==3UL && meta[i].sig==iter );
+      }
+      FD_TEST( done==(bad==ULONG_MAX) );
+
+      if( done ) {
+        FD_TEST( msg->seq0==seq );
+        FD_TEST( msg->seq==fd_seq_inc( seq, frag_cnt ) );
+        FD_TEST( msg->sz==msg_sz );
+        FD_TEST( msg->frag_cnt==frag_cnt );
+        FD_TEST( !msg->active );
+        uchar const * q = fd_dcache_msg_laddr_const( msg, base );
+        FD_TEST( q==p );
+        for( ulong b=0UL; b<msg_sz; b++ ) FD_TEST( q[b]==(uchar)(iter+b) );
+      }
+
+      seq   = fd_seq_inc( seq, frag_cnt );
+      chunk = fd_dcache_compact_next( chunk, msg_sz, chunk0, wmark );
+      FD_TEST( chunk0<=chunk ); FD_TEST( chunk<=wmark );
+    }
+
+    /* A SOM frag in the middle of a message restarts reassembly */
+
+    FD_TEST( fd_dcache_msg_append( msg, 10UL, chunk0,     128UL, fd_frag_meta_ctl( 0UL, 1, 0, 0 ) )==FD_DCACHE_MSG_CONT );
+    FD_TEST( fd_dcache_msg_append( msg, 11UL, chunk0+4UL,  64UL, fd_frag_meta_ctl( 0UL, 1, 1, 0 ) )==FD_DCACHE_MSG_DONE );
+    FD_TEST( msg->seq0==11UL && msg->chunk==chunk0+4UL && msg->sz==64UL && msg->frag_cnt==1UL );
+
+    /* Continuation after a complete message is an orphan */
+
+    FD_TEST( fd_dcache_msg_append( msg, 12UL, chunk0+6UL,  64UL, fd_frag_meta_ctl( 0UL, 0, 1, 0 ) )==FD_DCACHE_MSG_ERR_ORPHAN );
+
+    /* Non-final frags that are not a multiple of 2*FD_CHUNK_SZ are rejected */
+
+    FD_TEST( fd_dcache_msg_append( msg, 20UL, chunk0,     100UL, fd_frag_meta_ctl( 0UL, 1, 0, 0 ) )==FD_DCACHE_MSG_CONT );
+    FD_TEST( fd_dcache_msg_append( msg, 21UL, chunk0+2UL, 100UL, fd_frag_meta_ctl( 0UL, 0, 1, 0 ) )==FD_DCACHE_MSG_ERR_LAYOUT );
+  }
+
   /* Test mcache destruction */
 
   FD_TEST( fd_dcache_leave( NULL   )==NULL     ); /* null dcache */
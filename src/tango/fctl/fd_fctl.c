@@ -27,6 +27,10 @@ fd_fctl_new( void * shmem,
   fctl->cr_max    = 0UL;
   fctl->cr_resume = 0UL;
   fctl->cr_refill = 0UL;
+  fctl->adapt         = 0;
+  fctl->cr_refill_max = 0UL;
+  fctl->cr_lag        = 0UL;
+  fctl->query_cnt     = 0UL;
 
   return shmem;
 }
@@ -137,3 +141,72 @@ fd_fctl_cfg_done( fd_fctl_t * fctl,
   return fctl;
 }
 
+
+fd_fctl_t *
+fd_fctl_cfg_adapt( fd_fctl_t * fctl ) {
+  if( FD_UNLIKELY( !fctl ) ) {
+    FD_LOG_WARNING(( "NULL fctl" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fctl->cr_burst ) ) {
+    FD_LOG_WARNING(( "fctl not configured" ));
+    return NULL;
+  }
+
+  fctl->adapt         = 1;
+  fctl->cr_refill_max = fctl->cr_refill;
+  fctl->cr_lag        = 0UL;
+
+  return fctl;
+}
+
+void
+fd_fctl_private_adapt( fd_fctl_t * fctl,
+                       ulong       cr_avail,
+                       ulong       cr_query,
+                       int         in_refill ) {
+  ulong cr_burst      = fctl->cr_burst;
+  ulong cr_max        = fctl->cr_max;
+  ulong cr_refill_max = fctl->cr_refill_max;
+
+  /* Filter the lag of the slowest receiver.  cr_query is in [0,cr_max]
+     so lag_obs is in [0,cr_max] and so is the filtered lag (no
+     overflow as cr_max<=LONG_MAX). */
+
+  long  lag_obs = (long)(cr_max - cr_query);
+  long  lag     = (long)fctl->cr_lag;
+  lag += (lag_obs - lag) / 4L;
+  ulong cr_lag  = (ulong)lag;
+
+  /* Retune the refill threshold.  Everything below is in
+     [cr_burst,cr_refill_max]. */
+
+  ulong cr_refill = fctl->cr_refill;
+  if( FD_UNLIKELY( cr_avail<cr_burst ) ) {
+
+    /* The transmitter ran out of credits.  React as fast as possible. */
+
+    cr_refill = cr_refill_max;
+
+  } else if( !fctl->in_refill ) {
+
+    /* The query returned enough credits to resume, i.e. the receivers
+       are keeping up.  Start refilling later. */
+
+    ulong margin = fd_ulong_max( cr_lag, (cr_refill_max-cr_burst)>>2 );
+    ulong floor  = cr_burst + fd_ulong_min( margin, cr_refill_max-cr_burst );
+    if( cr_refill>floor ) cr_refill -= (cr_refill-floor)>>2;
+
+  } else if( !in_refill ) {
+
+    /* The receivers just fell behind (we just entered the refilling
+       state).  Start refilling earlier. */
+
+    cr_refill += (cr_refill_max-cr_refill+1UL)>>1;
+
+  }
+
+  fctl->cr_lag    = cr_lag;
+  fctl->cr_refill = cr_refill;
+}
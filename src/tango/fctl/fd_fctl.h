@@ -56,6 +56,10 @@ struct fd_fctl_private {
   ulong  cr_max;    /* ", in [cr_burst,LONG_MAX] */
   ulong  cr_resume; /* ", in [cr_burst,cr_max  ] */
   ulong  cr_refill; /* ", In [1,cr_resume      ] */
+  int    adapt;     /* 1 if cr_refill is tuned online (see fd_fctl_cfg_adapt) */
+  ulong  cr_refill_max; /* If adapt, the configured cr_refill (upper bound of the tuned cr_refill) */
+  ulong  cr_lag;    /* If adapt, filtered slowest receiver lag in credits observed by queries, in [0,cr_max] */
+  ulong  query_cnt; /* Number of times receivers have been queried by fd_fctl_tx_cr_update */
   /* rx_max fd_fctl_private_rx_t array indexed [0,rx_max) follows.  Only
      elements [0,rx_cnt) are in use.  Only elements with non-NULL
      seq_laddr are currently allowed to backpressure this fctl. */
@@ -76,6 +80,19 @@ fd_fctl_private_rx_const( fd_fctl_t const * fctl ) {
   return (fd_fctl_private_rx_t const *)(fctl+1UL);
 }
 
+/* fd_fctl_private_adapt retunes the cr_refill of an adaptive fctl
+   after fd_fctl_tx_cr_update has queried the receivers and updated its
+   refilling state.  cr_avail is the credits the transmitter had before
+   the query, cr_query is the query result and in_refill is whether the
+   fctl was in the refilling state before the query.  See
+   fd_fctl_cfg_adapt for details. */
+
+void
+fd_fctl_private_adapt( fd_fctl_t * fctl,
+                       ulong       cr_avail,
+                       ulong       cr_query,
+                       int         in_refill );
+
 FD_PROTOTYPES_END
 
 /* Public APIs ********************************************************/
@@ -219,6 +236,37 @@ fd_fctl_cfg_done( fd_fctl_t * fctl,
                   ulong       cr_resume,
                   ulong       cr_refill );
 
+/* fd_fctl_cfg_adapt enables adaptive credit management for a
+   configured fctl.  The cr_refill configured by fd_fctl_cfg_done is
+   then an upper bound for a threshold that is tuned online by
+   fd_fctl_tx_cr_update each time it queries the receivers:
+
+   - The lag of the slowest receiver (cr_max minus the credits the
+     query returned) is filtered into a lag estimate.
+
+   - If the query returned enough credits to resume (the receivers are
+     keeping up), cr_refill decays toward cr_burst plus the lag
+     estimate (with a margin of 1/4 of the configured range), so that
+     the receivers' fseq cache lines get polled as rarely as possible.
+
+   - If the query did not return enough credits (the receivers are
+     falling behind), cr_refill jumps halfway back toward the
+     configured cr_refill so the next refill starts earlier.  If the
+     transmitter was already out of credits (backpressured), it jumps
+     all the way back.
+
+   cr_resume is not tuned: lowering it behind steadily lagging
+   receivers just trades polls while refilling for more frequent
+   refills.
+
+   All of this happens in the refill path only; the common path of
+   fd_fctl_tx_cr_update is unchanged.  Returns fctl on success and NULL
+   on failure (logs details).  Reasons for failure include NULL fctl and
+   fctl not configured. */
+
+fd_fctl_t *
+fd_fctl_cfg_adapt( fd_fctl_t * fctl );
+
 /* Accessor APIs */
 
 /* fd_fctl_{rx_max,rx_cnt,
@@ -243,6 +291,16 @@ FD_FN_PURE static inline ulong fd_fctl_cr_max   ( fd_fctl_t const * fctl ) { ret
 FD_FN_PURE static inline ulong fd_fctl_cr_resume( fd_fctl_t const * fctl ) { return fctl->cr_resume;     }
 FD_FN_PURE static inline ulong fd_fctl_cr_refill( fd_fctl_t const * fctl ) { return fctl->cr_refill;     }
 
+/* fd_fctl_{adapt,cr_lag,query_cnt} return whether fctl is adaptive,
+   its current receiver lag estimate (0 if not adaptive) and the number
+   of receiver queries fd_fctl_tx_cr_update has done so far.  For an
+   adaptive fctl, fd_fctl_cr_refill above returns the current tuned
+   threshold. */
+
+FD_FN_PURE static inline int   fd_fctl_adapt    ( fd_fctl_t const * fctl ) { return fctl->adapt;         }
+FD_FN_PURE static inline ulong fd_fctl_cr_lag   ( fd_fctl_t const * fctl ) { return fctl->cr_lag;        }
+FD_FN_PURE static inline ulong fd_fctl_query_cnt( fd_fctl_t const * fctl ) { return fctl->query_cnt;     }
+
 FD_FN_PURE static inline ulong
 fd_fctl_rx_cr_max( fd_fctl_t const * fctl,
                    ulong             rx_idx ) {
@@ -519,7 +577,9 @@ fd_fctl_tx_cr_update( fd_fctl_t * fctl,
        might be available. */
  
     ulong rx_idx_slow;
-    ulong cr_query = fd_fctl_cr_query( fctl, tx_seq, &rx_idx_slow );
+    ulong cr_query       = fd_fctl_cr_query( fctl, tx_seq, &rx_idx_slow );
+    ulong cr_avail_query = cr_avail;
+    fctl->query_cnt++;
 
     if( FD_LIKELY( cr_query>=fctl->cr_resume ) ) { /* Yes, strictly ">=" */
     
@@ -560,6 +620,8 @@ fd_fctl_tx_cr_update( fd_fctl_t * fctl,
 
     } */
 
+    if( FD_UNLIKELY( fctl->adapt ) ) fd_fctl_private_adapt( fctl, cr_avail_query, cr_query, in_refill );
+
   }
 
   return cr_avail;
@@ -9,6 +9,10 @@ static uchar __attribute__((aligned(FD_FCTL_ALIGN))) shmem[ FD_FCTL_FOOTPRINT( R
 static ulong rx_seq [ RX_MAX ]; /* Init to zero */
 static ulong rx_slow[ RX_MAX ];
 
+static uchar __attribute__((aligned(FD_FCTL_ALIGN))) sim_shmem[ 2 ][ FD_FCTL_FOOTPRINT( 1UL ) ];
+static ulong sim_rx_seq [ 2 ];
+static ulong sim_rx_slow[ 2 ];
+
 int
 main( int     argc,
       char ** argv ) {
@@ -99,6 +103,79 @@ main( int     argc,
   /* FIXME: TX_CR_UPDATE TESTING HERE */
   fd_fctl_tx_cr_update( fctl, 0UL, 0UL );
 
+  /* Test adaptive credit management */
+
+  FD_TEST( !fd_fctl_adapt( fctl ) );
+  FD_TEST( fd_fctl_cfg_adapt( NULL )==NULL ); /* null fctl */
+  FD_TEST( fd_fctl_cfg_adapt( fd_fctl_join( fd_fctl_new( sim_shmem[0], 1UL ) ) )==NULL ); /* not configured */
+
+  /* Simulate a transmitter sending one frag per step to a receiver
+     through a static and an adaptive fctl.  In phase 0 the receiver
+     keeps up (it trails the transmitter by a few frags), in phase 1 it
+     stalls and in phase 2 it consumes a frag every other step. */
+
+  ulong sim_cr_max = 1024UL;
+  fd_fctl_t * sim_fctl[2];
+  for( ulong i=0UL; i<2UL; i++ ) {
+    sim_fctl[i] = fd_fctl_cfg_done( fd_fctl_cfg_rx_add( fd_fctl_join( fd_fctl_new( sim_shmem[i], 1UL ) ),
+                                                        sim_cr_max, &sim_rx_seq[i], &sim_rx_slow[i] ),
+                                    1UL, 0UL, 0UL, 0UL );
+    FD_TEST( sim_fctl[i] );
+  }
+  FD_TEST( fd_fctl_cfg_adapt( sim_fctl[1] )==sim_fctl[1] );
+  FD_TEST( fd_fctl_adapt( sim_fctl[1] ) );
+
+  ulong sim_resume     = fd_fctl_cr_resume( sim_fctl[1] );
+  ulong sim_refill0    = fd_fctl_cr_refill( sim_fctl[1] );
+  ulong phase_query_cnt[3][2];
+  ulong phase_stall_cnt[3][2];
+
+  for( ulong i=0UL; i<2UL; i++ ) {
+    fd_fctl_t * f        = sim_fctl[i];
+    ulong       tx_seq   = 0UL;
+    ulong       cr_avail = 0UL;
+    ulong       step     = 0UL;
+    sim_rx_seq[i] = 0UL;
+    for( ulong phase=0UL; phase<3UL; phase++ ) {
+      ulong query_cnt0 = fd_fctl_query_cnt( f );
+      ulong stall_cnt  = 0UL;
+      ulong refill_max = 0UL;
+      for( ulong rem=100000UL; rem; rem-- ) {
+
+        /* Receiver */
+
+        switch( phase ) {
+        case 0UL: { ulong lag = fd_rng_ulong_roll( rng, 16UL ); if( fd_seq_gt( fd_seq_dec( tx_seq, lag ), sim_rx_seq[i] ) ) sim_rx_seq[i] = fd_seq_dec( tx_seq, lag ); break; }
+        case 1UL: if( rem>=90000UL && fd_seq_lt( sim_rx_seq[i], tx_seq ) ) sim_rx_seq[i]++; break; /* stalled for most of the phase */
+        default:  if( (step & 1UL) && fd_seq_lt( sim_rx_seq[i], tx_seq ) ) sim_rx_seq[i]++; break;
+        }
+
+        /* Transmitter (housekeeping every step) */
+
+        cr_avail = fd_fctl_tx_cr_update( f, cr_avail, tx_seq );
+        FD_TEST( fd_fctl_cr_burst( f )<=fd_fctl_cr_refill( f ) );
+        FD_TEST( fd_fctl_cr_refill( f )<=fd_fctl_cr_resume( f ) );
+        FD_TEST( fd_fctl_cr_resume( f )==sim_resume );
+        FD_TEST( fd_fctl_cr_lag( f )<=fd_fctl_cr_max( f ) );
+        refill_max = fd_ulong_max( refill_max, fd_fctl_cr_refill( f ) );
+        if( FD_UNLIKELY( cr_avail<1UL ) ) { stall_cnt++; step++; continue; }
+        tx_seq = fd_seq_inc( tx_seq, 1UL );
+        cr_avail--;
+        FD_TEST( fd_seq_diff( tx_seq, sim_rx_seq[i] )<=(long)sim_cr_max ); /* never overrun the receiver */
+        step++;
+      }
+      phase_query_cnt[phase][i] = fd_fctl_query_cnt( f ) - query_cnt0;
+      phase_stall_cnt[phase][i] = stall_cnt;
+      if( i==1UL && phase==0UL ) FD_TEST( fd_fctl_cr_refill( f )<sim_refill0 );    /* Refills later when keeping up */
+      if( i==1UL && phase==1UL ) FD_TEST( refill_max==sim_refill0 );                /* Reacts fully to backpressure */
+    }
+  }
+
+  for( ulong phase=0UL; phase<3UL; phase++ )
+    FD_LOG_NOTICE(( "phase %lu: static %lu queries %lu stalls, adaptive %lu queries %lu stalls",
+                    phase, phase_query_cnt[phase][0], phase_stall_cnt[phase][0], phase_query_cnt[phase][1], phase_stall_cnt[phase][1] ));
+  FD_TEST( phase_query_cnt[0][1]<phase_query_cnt[0][0] ); /* Fewer fseq polls when the receiver keeps up */
+
   FD_TEST( fd_fctl_leave ( fctl )==shfctl );
   FD_TEST( fd_fctl_delete( fctl )==shmem  );
 
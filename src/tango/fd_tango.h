@@ -10,6 +10,8 @@
 #include "dcache/fd_dcache.h" /* Includes fd_tango_base.h */
 #include "tcache/fd_tcache.h" /* Includes fd_tango_base.h */
 #include "aio/fd_aio.h"       /* Includes fd_tango_base.h */
+#include "lat/fd_lat.h"       /* Includes fd_tango_base.h */
+#include "trace/fd_trace.h"   /* Includes fd_tango_base.h */
 
 #endif /* HEADER_fd_src_tango_fd_tango_h */
 
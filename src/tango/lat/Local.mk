@@ -0,0 +1,4 @@
+$(call add-hdrs,fd_lat.h)
+$(call add-objs,fd_lat,fd_tango)
+$(call make-unit-test,test_lat,test_lat,fd_tango fd_util)
+$(call run-unit-test,test_lat,)
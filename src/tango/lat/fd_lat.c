@@ -0,0 +1,30 @@
+#include "fd_lat.h"
+
+ulong
+fd_lat_hist_cnt( uint const * hist,
+                 uint const * hist_then ) {
+  ulong cnt = 0UL;
+  for( ulong idx=0UL; idx<FD_LAT_BKT_CNT; idx++ )
+    cnt += (ulong)(uint)(hist[ idx ] - (hist_then ? hist_then[ idx ] : 0U));
+  return cnt;
+}
+
+ulong
+fd_lat_hist_pctile( uint const * hist,
+                    uint const * hist_then,
+                    double       q ) {
+  ulong cnt = fd_lat_hist_cnt( hist, hist_then );
+  if( FD_UNLIKELY( !cnt ) ) return ULONG_MAX;
+
+  /* rank is the 1-indexed rank of the sample at quantile q */
+  q = fd_double_if( q<0., 0., fd_double_if( q>1., 1., q ) );
+  ulong rank = fd_ulong_max( (ulong)(q*(double)cnt + 0.5), 1UL );
+  rank = fd_ulong_min( rank, cnt );
+
+  ulong sum = 0UL;
+  for( ulong idx=0UL; idx<FD_LAT_BKT_CNT-1UL; idx++ ) {
+    sum += (ulong)(uint)(hist[ idx ] - (hist_then ? hist_then[ idx ] : 0U));
+    if( sum>=rank ) return fd_lat_bkt_lo( idx+1UL ) - 1UL;
+  }
+  return ULONG_MAX;
+}
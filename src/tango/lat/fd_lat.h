@@ -0,0 +1,156 @@
+#ifndef HEADER_fd_src_tango_lat_fd_lat_h
+#define HEADER_fd_src_tango_lat_fd_lat_h
+
+/* fd_lat provides APIs for accumulating per link frag latency
+   histograms on a consumer's critical path in a standard remote
+   monitoring friendly way.  A histogram is a flat array of
+   FD_LAT_BKT_CNT uint counters.  Buckets are log-linear: values in
+   [0,4) get their own bucket and each power of two octave above that
+   is split into 4 equal width buckets (such that a bucket is at most
+   ~25% wide relative to the values it holds).  The last bucket also
+   holds all values too large to fit in the others (i.e. at least
+   2^33).
+
+   For each in, a consumer tracks two histograms of the tickcount
+   deltas:
+
+     ORIG is now - tsorig, the time since the frag's origin (e.g. when
+     the original packet was received from the NIC by the first tile in
+     the pipeline), and
+
+     PUB is now - tspub, the time the frag spent between being published
+     by the producer and being picked up by the consumer.
+
+   where now is when the consumer read the frag metadata.  The two
+   histograms for a link are stored contiguously (ORIG then PUB) and the
+   links for a consumer's ins are stored contiguously, indexed by in.
+
+   Counters are only written by the consumer and only approximately
+   read by monitors (counters wrap mod 2^32, monitors should difference
+   snapshots as usual). */
+
+#include "../cnc/fd_cnc.h"
+
+#define FD_LAT_BKT_CNT (128UL)
+
+#define FD_LAT_HIST_ORIG (0UL)
+#define FD_LAT_HIST_PUB  (1UL)
+
+/* FD_LAT_LINK_FOOTPRINT is the number of bytes used by the pair of
+   histograms of a link. */
+
+#define FD_LAT_LINK_FOOTPRINT (2UL*FD_LAT_BKT_CNT*sizeof(uint))
+
+/* FD_LAT_CNC_APP_{OFF,SZ} specify the standard location of the link
+   latency histograms in a consumer's cnc application region.  The
+   histograms for a consumer with in_cnt ins start OFF bytes into the
+   cnc app region (leaving the front of the region for the standard
+   FD_CNC_DIAG_* and application specific diagnostics) and the region
+   needs to be at least SZ( in_cnt ) bytes.  Tiles whose cnc app region
+   is too small for their ins do not accumulate latency histograms. */
+
+#define FD_LAT_CNC_APP_OFF            (2048UL)
+#define FD_LAT_CNC_APP_SZ( in_cnt ) (FD_LAT_CNC_APP_OFF + (in_cnt)*FD_LAT_LINK_FOOTPRINT)
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_lat_bkt_idx returns the index of the bucket holding dt.  Result
+   will be in [0,FD_LAT_BKT_CNT).  Branchless and a handful of
+   cycles. */
+
+FD_FN_CONST static inline ulong
+fd_lat_bkt_idx( ulong dt ) {
+  int   s   = fd_ulong_find_msb( dt | 4UL ) - 2; /* dt<4 is handled as though it was in the 4 octave with s==0 */
+  ulong idx = (((ulong)s)<<2) + (dt>>s);
+  return fd_ulong_min( idx, FD_LAT_BKT_CNT-1UL );
+}
+
+/* fd_lat_bkt_lo returns the smallest value held by the bucket with
+   index idx.  Assumes idx in [0,FD_LAT_BKT_CNT).  The largest value
+   held by bucket idx<FD_LAT_BKT_CNT-1 is fd_lat_bkt_lo( idx+1 )-1. */
+
+FD_FN_CONST static inline ulong
+fd_lat_bkt_lo( ulong idx ) {
+  if( idx<4UL ) return idx;
+  int s = (int)(idx>>2) - 1;
+  return (4UL + (idx & 3UL)) << s;
+}
+
+/* fd_lat_hist_sample records the sample dt in histogram hist. */
+
+static inline void
+fd_lat_hist_sample( uint * hist,
+                    ulong  dt ) {
+  ulong idx = fd_lat_bkt_idx( dt );
+  FD_VOLATILE( hist[ idx ] ) = FD_VOLATILE_CONST( hist[ idx ] ) + 1U;
+}
+
+/* fd_lat_sample records the latencies of a frag with metadata
+   timestamps tsorig and tspub (compressed as usual) that was read at
+   tickcount now into the link histogram pair at lat.  Deltas that
+   look negative (e.g. tickcount skew between cores) are recorded as
+   0. */
+
+static inline void
+fd_lat_sample( uint * lat,
+               long   now,
+               ulong  tsorig,
+               ulong  tspub ) {
+  long dt_orig = now - fd_frag_meta_ts_decomp( tsorig, now );
+  long dt_pub  = now - fd_frag_meta_ts_decomp( tspub,  now );
+  fd_lat_hist_sample( lat + FD_LAT_HIST_ORIG*FD_LAT_BKT_CNT, (ulong)fd_long_max( dt_orig, 0L ) );
+  fd_lat_hist_sample( lat + FD_LAT_HIST_PUB *FD_LAT_BKT_CNT, (ulong)fd_long_max( dt_pub,  0L ) );
+}
+
+/* fd_lat_cnc_laddr returns the location of the link histograms of in 0
+   in cnc's application region for a consumer with in_cnt ins.  The
+   histograms for in in_idx are at fd_lat_link( lat, in_idx ).  Returns
+   NULL if the cnc app region is too small.  Assumes cnc is a current
+   local join.  fd_lat_cnc_laddr_const is a const correct version. */
+
+FD_FN_PURE static inline uint *
+fd_lat_cnc_laddr( fd_cnc_t * cnc,
+                  ulong      in_cnt ) {
+  if( FD_UNLIKELY( fd_cnc_app_sz( cnc )<FD_LAT_CNC_APP_SZ( in_cnt ) ) ) return NULL;
+  return (uint *)((ulong)fd_cnc_app_laddr( cnc ) + FD_LAT_CNC_APP_OFF);
+}
+
+FD_FN_PURE static inline uint const *
+fd_lat_cnc_laddr_const( fd_cnc_t const * cnc,
+                        ulong            in_cnt ) {
+  if( FD_UNLIKELY( fd_cnc_app_sz( cnc )<FD_LAT_CNC_APP_SZ( in_cnt ) ) ) return NULL;
+  return (uint const *)((ulong)fd_cnc_app_laddr_const( cnc ) + FD_LAT_CNC_APP_OFF);
+}
+
+FD_FN_CONST static inline uint *
+fd_lat_link( uint * lat,
+             ulong  in_idx ) {
+  return lat + in_idx*2UL*FD_LAT_BKT_CNT;
+}
+
+FD_FN_CONST static inline uint const *
+fd_lat_link_const( uint const * lat,
+                   ulong        in_idx ) {
+  return lat + in_idx*2UL*FD_LAT_BKT_CNT;
+}
+
+/* fd_lat_hist_cnt returns the number of samples recorded in hist since
+   the snapshot hist_then was taken (hist_then NULL means since hist was
+   created).  fd_lat_hist_pctile returns an upper bound for the q-th
+   quantile (q in [0,1]) of the samples recorded since hist_then, the
+   largest value held by the bucket containing the quantile (ULONG_MAX
+   if that is the last bucket or there are no samples).  These are meant
+   for monitors and are not optimized. */
+
+FD_FN_PURE ulong
+fd_lat_hist_cnt( uint const * hist,
+                 uint const * hist_then );
+
+FD_FN_PURE ulong
+fd_lat_hist_pctile( uint const * hist,
+                    uint const * hist_then,
+                    double       q );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_tango_lat_fd_lat_h */
@@ -0,0 +1,110 @@
+#include "../fd_tango.h"
+
+FD_STATIC_ASSERT( FD_LAT_BKT_CNT       ==128UL,  unit_test );
+FD_STATIC_ASSERT( FD_LAT_HIST_ORIG     ==0UL,    unit_test );
+FD_STATIC_ASSERT( FD_LAT_HIST_PUB      ==1UL,    unit_test );
+FD_STATIC_ASSERT( FD_LAT_LINK_FOOTPRINT==1024UL, unit_test );
+FD_STATIC_ASSERT( FD_LAT_CNC_APP_OFF   ==2048UL, unit_test );
+
+#define APP_SZ FD_LAT_CNC_APP_SZ( 3UL )
+
+static uchar shmem[ FD_CNC_FOOTPRINT( APP_SZ ) ] __attribute__((aligned(FD_CNC_ALIGN)));
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  /* Test bucket boundaries */
+
+  FD_TEST( fd_lat_bkt_lo( 0UL )==0UL );
+  for( ulong idx=0UL; idx<FD_LAT_BKT_CNT; idx++ ) {
+    ulong lo = fd_lat_bkt_lo( idx );
+    FD_TEST( fd_lat_bkt_idx( lo )==idx );
+    if( idx ) FD_TEST( fd_lat_bkt_idx( lo-1UL )==idx-1UL );
+    if( idx<FD_LAT_BKT_CNT-1UL ) {
+      ulong hi = fd_lat_bkt_lo( idx+1UL ) - 1UL;
+      FD_TEST( hi>=lo );
+      FD_TEST( fd_lat_bkt_idx( hi )==idx );
+      if( idx>=4UL ) FD_TEST( 4UL*(hi-lo+1UL)<=lo ); /* at most 25% wide */
+    }
+  }
+  for( ulong dt=0UL; dt<4UL; dt++ ) FD_TEST( fd_lat_bkt_idx( dt )==dt );
+  FD_TEST( fd_lat_bkt_idx( ULONG_MAX )==FD_LAT_BKT_CNT-1UL );
+  FD_TEST( fd_lat_bkt_idx( 1UL<<33   )==FD_LAT_BKT_CNT-1UL );
+  FD_TEST( fd_lat_bkt_idx( UINT_MAX  ) <FD_LAT_BKT_CNT-1UL );
+
+  for( ulong iter=0UL; iter<1000000UL; iter++ ) {
+    ulong dt  = fd_rng_ulong( rng ) >> fd_rng_uint_roll( rng, 64U );
+    ulong idx = fd_lat_bkt_idx( dt );
+    FD_TEST( idx<FD_LAT_BKT_CNT );
+    FD_TEST( fd_lat_bkt_lo( idx )<=dt );
+    if( idx<FD_LAT_BKT_CNT-1UL ) FD_TEST( dt<fd_lat_bkt_lo( idx+1UL ) );
+  }
+
+  /* Test cnc placement */
+
+  fd_cnc_t * cnc = fd_cnc_join( fd_cnc_new( shmem, APP_SZ, 0UL, 0L ) ); FD_TEST( cnc );
+  uint * lat = fd_lat_cnc_laddr( cnc, 3UL );
+  FD_TEST( (ulong)lat==(ulong)fd_cnc_app_laddr( cnc ) + FD_LAT_CNC_APP_OFF );
+  FD_TEST( fd_lat_cnc_laddr_const( cnc, 3UL )==lat );
+  FD_TEST( !fd_lat_cnc_laddr      ( cnc, 4UL ) );
+  FD_TEST( !fd_lat_cnc_laddr_const( cnc, 4UL ) );
+  FD_TEST( fd_lat_link( lat, 2UL )==lat + 4UL*FD_LAT_BKT_CNT );
+  FD_TEST( (ulong)(fd_lat_link( lat, 2UL ) + 2UL*FD_LAT_BKT_CNT)==(ulong)fd_cnc_app_laddr( cnc ) + APP_SZ );
+  fd_memset( lat, 0, 3UL*FD_LAT_LINK_FOOTPRINT );
+
+  /* Test sampling.  Timestamps are compressed as usual and we sample
+     around a tickcount wrap of the compressed representation. */
+
+  uint * link = fd_lat_link( lat, 1UL );
+  uint * orig = link + FD_LAT_HIST_ORIG*FD_LAT_BKT_CNT;
+  uint * pub  = link + FD_LAT_HIST_PUB *FD_LAT_BKT_CNT;
+  long   now  = (long)(1UL<<32) + 10L;
+  fd_lat_sample( link, now, fd_frag_meta_ts_comp( now-1000L ), fd_frag_meta_ts_comp( now-20L ) );
+  fd_lat_sample( link, now, fd_frag_meta_ts_comp( now+5L    ), fd_frag_meta_ts_comp( now     ) ); /* skewed */
+  FD_TEST( orig[ fd_lat_bkt_idx( 1000UL ) ]==1U ); FD_TEST( orig[ 0 ]==1U ); FD_TEST( fd_lat_hist_cnt( orig, NULL )==2UL );
+  FD_TEST( pub [ fd_lat_bkt_idx(   20UL ) ]==1U ); FD_TEST( pub [ 0 ]==1U ); FD_TEST( fd_lat_hist_cnt( pub,  NULL )==2UL );
+  FD_TEST( fd_lat_hist_cnt( fd_lat_link( lat, 0UL ), NULL )==0UL );
+  FD_TEST( fd_lat_hist_cnt( fd_lat_link( lat, 2UL ), NULL )==0UL );
+
+  /* Test quantiles against uniform samples in [0,100000) taken after a
+     snapshot */
+
+  uint then[ FD_LAT_BKT_CNT ];
+  fd_memcpy( then, orig, sizeof(then) );
+  FD_TEST( fd_lat_hist_pctile( orig, then, 0.5 )==ULONG_MAX );
+
+  ulong n = 100000UL;
+  for( ulong i=0UL; i<n; i++ ) fd_lat_hist_sample( orig, i );
+  FD_TEST( fd_lat_hist_cnt( orig, then )==n );
+  FD_TEST( fd_lat_hist_cnt( orig, NULL )==n+2UL );
+
+  static double const q[] = { 0.0, 0.5, 0.9, 0.99, 0.999, 1.0 };
+  for( ulong i=0UL; i<sizeof(q)/sizeof(q[0]); i++ ) {
+    ulong exact = (ulong)(q[i]*(double)n);
+    ulong p     = fd_lat_hist_pctile( orig, then, q[i] );
+    FD_TEST( p>=fd_ulong_min( exact, n-1UL ) );
+    FD_TEST( (double)p<=1.25*(double)exact + 4. );
+  }
+
+  /* Test wrap of the counters between snapshots */
+
+  uint now_hist[ FD_LAT_BKT_CNT ];
+  fd_memset( then,     0, sizeof(then)     );
+  fd_memset( now_hist, 0, sizeof(now_hist) );
+  then[ 10 ] = UINT_MAX-2U; now_hist[ 10 ] = 5U; /* 8 samples */
+  then[ 20 ] = 7U;          now_hist[ 20 ] = 9U; /* 2 samples */
+  FD_TEST( fd_lat_hist_cnt   ( now_hist, then      )==10UL );
+  FD_TEST( fd_lat_hist_pctile( now_hist, then, 0.5 )==fd_lat_bkt_lo( 11UL )-1UL );
+  FD_TEST( fd_lat_hist_pctile( now_hist, then, 1.0 )==fd_lat_bkt_lo( 21UL )-1UL );
+
+  fd_cnc_delete( fd_cnc_leave( cnc ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -0,0 +1,189 @@
+#include "../fd_tango.h"
+
+#if FD_HAS_HOSTED && FD_HAS_AVX
+
+/* bench_mcache_burst measures the throughput of a producer on tile 1
+   publishing frag metadata to a consumer on tile 0 through an mcache,
+   one frag at a time (fd_mcache_publish_avx / FD_MCACHE_WAIT_AVX)
+   versus in bursts (fd_mcache_publish_burst_avx /
+   FD_MCACHE_WAIT_BURST_AVX).  The consumer returns flow control
+   credits to the producer through a shared sequence number after each
+   frag or burst it drains.  In single mode, burst is just how many
+   frags the producer publishes per credit check.  Ticks are
+   fd_tickcount ticks, i.e. cycles of the invariant TSC on x86.  Run it
+   with --tile-cpus naming different pairs of cores (e.g. hyperthread
+   siblings, cores sharing an L3, cores on different sockets) to
+   compare core pairs. */
+
+#define DEPTH_MAX (65536UL)
+#define BURST_MAX (256UL)
+
+static uchar mcache_mem[ FD_MCACHE_FOOTPRINT( DEPTH_MAX, 0UL ) ] __attribute__((aligned(FD_MCACHE_ALIGN)));
+
+/* rx_seq is the next sequence number the consumer will receive.  It's
+   on its own pair of cache lines. */
+static ulong rx_seq[ 16 ] __attribute__((aligned(128)));
+
+struct bench_cfg {
+  fd_frag_meta_t * mcache;
+  ulong            depth;
+  ulong            seq0;
+  ulong            frag_cnt;
+  ulong            burst;
+  int              use_burst;
+};
+typedef struct bench_cfg bench_cfg_t;
+
+static bench_cfg_t cfg[1];
+
+static int
+tx_tile_main( int     argc,
+              char ** argv ) {
+  (void)argc; (void)argv;
+  fd_frag_meta_t * mcache = cfg->mcache;
+  ulong            depth  = cfg->depth;
+  ulong            burst  = cfg->burst;
+
+  fd_frag_meta_t meta[ BURST_MAX ];
+  for( ulong i=0UL; i<burst; i++ ) {
+    meta[i].seq    = 0UL;
+    meta[i].sig    = i;
+    meta[i].chunk  = (uint)i;
+    meta[i].sz     = (ushort)64;
+    meta[i].ctl    = (ushort)fd_frag_meta_ctl( 0UL, 1, 1, 0 );
+    meta[i].tsorig = 0U;
+    meta[i].tspub  = 0U;
+  }
+
+  ulong seq     = cfg->seq0;
+  ulong seq_end = fd_seq_inc( seq, cfg->frag_cnt );
+  while( fd_seq_lt( seq, seq_end ) ) {
+    ulong cnt = fd_ulong_min( burst, (ulong)fd_seq_diff( seq_end, seq ) );
+
+    /* Wait for credits to publish the whole burst without overrunning
+       the consumer */
+    while( fd_seq_diff( fd_seq_inc( seq, cnt ), FD_VOLATILE_CONST( rx_seq[0] ) )>(long)depth ) FD_SPIN_PAUSE();
+
+    if( cfg->use_burst ) {
+      seq = fd_mcache_publish_burst_avx( mcache, depth, seq, meta, cnt );
+    } else {
+      for( ulong i=0UL; i<cnt; i++ ) {
+        fd_mcache_publish_avx( mcache, depth, seq, meta[i].sig, meta[i].chunk, meta[i].sz, meta[i].ctl, meta[i].tsorig, meta[i].tspub );
+        seq = fd_seq_inc( seq, 1UL );
+      }
+    }
+  }
+  fd_mcache_seq_update( fd_mcache_seq_laddr( mcache ), seq );
+  return 0;
+}
+
+static void
+bench( fd_frag_meta_t * mcache,
+       ulong            depth,
+       ulong            frag_cnt,
+       ulong            burst,
+       int              use_burst ) {
+
+  ulong seq0 = fd_mcache_seq_query( fd_mcache_seq_laddr_const( mcache ) );
+  FD_VOLATILE( rx_seq[0] ) = seq0;
+
+  cfg->mcache    = mcache;
+  cfg->depth     = depth;
+  cfg->seq0      = seq0;
+  cfg->frag_cnt  = frag_cnt;
+  cfg->burst     = burst;
+  cfg->use_burst = use_burst;
+
+  fd_frag_meta_t meta[ BURST_MAX ];
+  ulong          seq     = seq0;
+  ulong          seq_end = fd_seq_inc( seq0, frag_cnt );
+  ulong          ovrn    = 0UL;
+  ulong          chk     = 0UL;
+
+  fd_tile_exec_t * tx = fd_tile_exec_new( 1UL, tx_tile_main, 0, NULL );
+  if( FD_UNLIKELY( !tx ) ) FD_LOG_ERR(( "fd_tile_exec_new failed" ));
+
+  long tic = 0L;
+  long t0  = 0L;
+  while( fd_seq_lt( seq, seq_end ) ) {
+    ulong poll_max = ULONG_MAX;
+    ulong seq_found;
+    long  seq_diff;
+    ulong cnt;
+    if( use_burst ) {
+      FD_MCACHE_WAIT_BURST_AVX( meta, cnt, seq_found, seq_diff, poll_max, mcache, depth, seq, burst );
+    } else {
+      fd_frag_meta_t const * mline;
+      __m256i                meta_avx;
+      FD_MCACHE_WAIT_AVX( meta_avx, mline, seq_found, seq_diff, poll_max, mcache, depth, seq );
+      (void)mline;
+      _mm256_store_si256( &meta[0].avx, meta_avx );
+      cnt = seq_diff ? 0UL : 1UL;
+    }
+    if( FD_UNLIKELY( seq==seq0 ) ) { tic = fd_tickcount(); t0 = fd_log_wallclock(); }
+    if( FD_UNLIKELY( seq_diff ) ) { ovrn++; seq = seq_found; continue; }
+
+    for( ulong i=0UL; i<cnt; i++ ) chk += meta[i].sig;
+    seq = fd_seq_inc( seq, cnt );
+    FD_VOLATILE( rx_seq[0] ) = seq;
+  }
+  long toc = fd_tickcount();
+  long t1  = fd_log_wallclock();
+
+  fd_tile_exec_delete( tx, NULL );
+
+  double dt = (double)(t1-t0);
+  FD_LOG_NOTICE(( "%-6s burst %3lu: %10.3e frags/s, %7.2f ticks/frag (ovrn %lu, chk %lx)",
+                  use_burst ? "burst" : "single", burst,
+                  1e9*(double)frag_cnt/fd_double_if( dt>0., dt, 1. ),
+                  (double)(toc-tic)/(double)frag_cnt,
+                  ovrn, chk ));
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong depth    = fd_env_strip_cmdline_ulong( &argc, &argv, "--depth",    NULL,    4096UL );
+  ulong frag_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--frag-cnt", NULL, 10000000UL );
+
+  if( FD_UNLIKELY( fd_tile_cnt()<2UL ) ) {
+    FD_LOG_WARNING(( "skip: this benchmark requires at least two tiles, e.g. --tile-cpus 1,2" ));
+    fd_halt();
+    return 0;
+  }
+  if( FD_UNLIKELY( depth>DEPTH_MAX ) ) FD_LOG_ERR(( "increase DEPTH_MAX to support this large --depth" ));
+
+  fd_frag_meta_t * mcache = fd_mcache_join( fd_mcache_new( mcache_mem, depth, 0UL, 0UL ) );
+  if( FD_UNLIKELY( !mcache ) ) FD_LOG_ERR(( "bad --depth" ));
+
+  double tick_per_ns = fd_tempo_tick_per_ns( NULL );
+  FD_LOG_NOTICE(( "--depth %lu --frag-cnt %lu (%.3f ticks per ns)", depth, frag_cnt, tick_per_ns ));
+
+  static ulong const bursts[] = { 1UL, 4UL, 16UL, 64UL, 256UL };
+  for( ulong b=0UL; b<sizeof(bursts)/sizeof(bursts[0]); b++ ) {
+    if( bursts[ b ]>depth ) break;
+    bench( mcache, depth, frag_cnt, bursts[ b ], 0 );
+    bench( mcache, depth, frag_cnt, bursts[ b ], 1 );
+  }
+
+  fd_mcache_delete( fd_mcache_leave( mcache ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED and FD_HAS_AVX capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
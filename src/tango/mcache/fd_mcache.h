@@ -377,6 +377,84 @@ fd_mcache_publish_avx( fd_frag_meta_t * mcache,   /* Assumed a current local joi
 
 #endif
 
+/* fd_mcache_publish_burst inserts the metadata for the cnt frags
+   [seq,seq+cnt) cyclic into the given depth entry mcache.  The
+   metadata for frag seq+i is taken from meta[i], except for
+   meta[i].seq, which is ignored.  cnt is assumed in [1,depth].
+   Returns seq+cnt cyclic, the next sequence number to publish.
+
+   This is equivalent to cnt calls to fd_mcache_publish (and is
+   compatible with the same consumers) but amortizes the ordering over
+   the burst: all cnt lines are marked as being written, then all of
+   their bodies are written, then all of them are marked as available,
+   oldest first, with a single compiler fence between each phase.  Since
+   x86 stores are observed in order, a consumer that observes frag
+   seq+i as available will also observe frags [seq,seq+i) as available
+   (or overrun).  The caller still updates the mcache's seq with
+   fd_mcache_seq_update (typically once per burst, at housekeeping
+   cadence).  This implies a compiler mfence to the caller. */
+
+static inline ulong
+fd_mcache_publish_burst( fd_frag_meta_t *       mcache,   /* Assumed a current local join */
+                         ulong                  depth,    /* Assumed an integer power-of-2 >= BLOCK */
+                         ulong                  seq,
+                         fd_frag_meta_t const * meta,     /* Indexed [0,cnt) */
+                         ulong                  cnt ) {   /* Assumed in [1,depth] */
+  FD_COMPILER_MFENCE();
+  for( ulong i=0UL; i<cnt; i++ ) mcache[ fd_mcache_line_idx( fd_seq_inc( seq, i ), depth ) ].seq = fd_seq_dec( fd_seq_inc( seq, i ), 1UL );
+  FD_COMPILER_MFENCE();
+  for( ulong i=0UL; i<cnt; i++ ) {
+    fd_frag_meta_t * line = mcache + fd_mcache_line_idx( fd_seq_inc( seq, i ), depth );
+    line->sig    = meta[i].sig;
+    line->chunk  = meta[i].chunk;
+    line->sz     = meta[i].sz;
+    line->ctl    = meta[i].ctl;
+    line->tsorig = meta[i].tsorig;
+    line->tspub  = meta[i].tspub;
+  }
+  FD_COMPILER_MFENCE();
+  for( ulong i=0UL; i<cnt; i++ ) mcache[ fd_mcache_line_idx( fd_seq_inc( seq, i ), depth ) ].seq = fd_seq_inc( seq, i );
+  FD_COMPILER_MFENCE();
+  return fd_seq_inc( seq, cnt );
+}
+
+#if FD_HAS_AVX
+
+/* fd_mcache_publish_burst_avx is an AVX implementation of
+   fd_mcache_publish_burst.  Each line is written with a single atomic
+   AVX store, so no line needs to be marked as being written and there
+   is only a single compiler fence for the whole burst.  It is
+   compatible with FD_MCACHE_WAIT, FD_MCACHE_WAIT_SSE,
+   FD_MCACHE_WAIT_AVX and FD_MCACHE_WAIT_BURST_AVX, with the same
+   target requirements as fd_mcache_publish_avx.
+
+   Regular (cached) stores are used rather than non-temporal ones:
+   consumers typically read the lines shortly after they are written,
+   and non-temporal stores would both evict them from the cache
+   hierarchy and require a store fence to be ordered with the stores
+   that follow. */
+
+static inline ulong
+fd_mcache_publish_burst_avx( fd_frag_meta_t *       mcache,   /* Assumed a current local join */
+                             ulong                  depth,    /* Assumed an integer power-of-2 >= BLOCK */
+                             ulong                  seq,
+                             fd_frag_meta_t const * meta,     /* Indexed [0,cnt) */
+                             ulong                  cnt ) {   /* Assumed in [1,depth] */
+  __m256i seq_avx = _mm256_setr_epi64x( (long)seq, 0L, 0L, 0L );
+  __m256i one_avx = _mm256_setr_epi64x( 1L,        0L, 0L, 0L );
+  __m256i msk_avx = _mm256_setr_epi64x( 0L,       -1L, -1L, -1L );
+  FD_COMPILER_MFENCE();
+  for( ulong i=0UL; i<cnt; i++ ) {
+    __m256i meta_avx = _mm256_or_si256( _mm256_and_si256( _mm256_load_si256( &meta[i].avx ), msk_avx ), seq_avx );
+    _mm256_store_si256( &mcache[ fd_mcache_line_idx( fd_seq_inc( seq, i ), depth ) ].avx, meta_avx );
+    seq_avx = _mm256_add_epi64( seq_avx, one_avx );
+  }
+  FD_COMPILER_MFENCE();
+  return fd_seq_inc( seq, cnt );
+}
+
+#endif
+
 /* FD_MCACHE_WAIT does a bounded wait for a producer to transmit a
    particular frag.
 
@@ -724,6 +802,65 @@ fd_mcache_publish_avx( fd_frag_meta_t * mcache,   /* Assumed a current local joi
     (poll_max)  = _fd_mcache_wait_poll_max;                                                                            \
   } while(0)
 
+/* FD_MCACHE_WAIT_BURST_AVX: similar to FD_MCACHE_WAIT_AVX but, once
+   frag seq_expected is available, also drains the frags after it that
+   are already available, up to cnt_max (positive) frags in total, in
+   the same pass.  meta (fd_frag_meta_t * compatible) should point to
+   room for cnt_max frags.  On return:
+
+   - If poll_max is zero, the wait timed out (as in FD_MCACHE_WAIT) and
+     cnt is zero.
+   - Otherwise, if seq_diff is positive, the consumer was overrun (as in
+     FD_MCACHE_WAIT_AVX, seq_found is a lower bound of where the
+     producer is at) and cnt is zero.
+   - Otherwise, cnt is in [1,cnt_max] and meta[i] holds the metadata for
+     frag seq_expected+i for i in [0,cnt).  Frag seq_expected+cnt was
+     not available yet (or cnt==cnt_max).
+
+   Each line is loaded with a single atomic AVX load, so this has the
+   same target and producer requirements as FD_MCACHE_WAIT_AVX.  Since
+   the producer overwrites lines in sequence order, a caller that
+   speculatively processes the burst only needs to check that frag
+   seq_expected was not overrun afterward, e.g.
+
+     fd_seq_eq( fd_mcache_query( mcache, depth, seq_expected ), seq_expected )
+
+   to know that none of the burst was. */
+
+#define FD_MCACHE_WAIT_BURST_AVX( meta, cnt, seq_found, seq_diff, poll_max, mcache, depth, seq_expected, cnt_max ) do {       \
+    fd_frag_meta_t *       _fd_mcache_burst_meta         = (meta);                                                            \
+    fd_frag_meta_t const * _fd_mcache_burst_mcache       = (mcache);                                                          \
+    ulong                  _fd_mcache_burst_depth        = (depth);                                                           \
+    ulong                  _fd_mcache_burst_seq_expected = (seq_expected);                                                    \
+    ulong                  _fd_mcache_burst_cnt_max      = (cnt_max);                                                         \
+    fd_frag_meta_t const * _fd_mcache_burst_mline;                                                                            \
+    __m256i                _fd_mcache_burst_meta_avx;                                                                         \
+    ulong                  _fd_mcache_burst_seq_found    = 0UL;                                                               \
+    long                   _fd_mcache_burst_seq_diff     = 0L;                                                                \
+    ulong                  _fd_mcache_burst_poll_max     = (poll_max);                                                        \
+    FD_MCACHE_WAIT_AVX( _fd_mcache_burst_meta_avx, _fd_mcache_burst_mline, _fd_mcache_burst_seq_found,                        \
+                        _fd_mcache_burst_seq_diff, _fd_mcache_burst_poll_max,                                                 \
+                        _fd_mcache_burst_mcache, _fd_mcache_burst_depth, _fd_mcache_burst_seq_expected );                     \
+    (void)_fd_mcache_burst_mline;                                                                                             \
+    ulong _fd_mcache_burst_cnt = 0UL;                                                                                         \
+    if( FD_LIKELY( _fd_mcache_burst_poll_max && !_fd_mcache_burst_seq_diff ) ) {                                              \
+      _mm256_store_si256( &_fd_mcache_burst_meta[0].avx, _fd_mcache_burst_meta_avx );                                         \
+      for( _fd_mcache_burst_cnt=1UL; _fd_mcache_burst_cnt<_fd_mcache_burst_cnt_max; _fd_mcache_burst_cnt++ ) {                \
+        ulong   _fd_mcache_burst_seq_next = fd_seq_inc( _fd_mcache_burst_seq_expected, _fd_mcache_burst_cnt );                \
+        FD_COMPILER_MFENCE();                                                                                                 \
+        __m256i _fd_mcache_burst_next_avx = _mm256_load_si256( &_fd_mcache_burst_mcache[                                      \
+                                             fd_mcache_line_idx( _fd_mcache_burst_seq_next, _fd_mcache_burst_depth ) ].avx ); \
+        FD_COMPILER_MFENCE();                                                                                                 \
+        if( fd_seq_ne( fd_frag_meta_avx_seq( _fd_mcache_burst_next_avx ), _fd_mcache_burst_seq_next ) ) break;                \
+        _mm256_store_si256( &_fd_mcache_burst_meta[ _fd_mcache_burst_cnt ].avx, _fd_mcache_burst_next_avx );                  \
+      }                                                                                                                       \
+    }                                                                                                                         \
+    (cnt)       = _fd_mcache_burst_cnt;                                                                                       \
+    (seq_found) = _fd_mcache_burst_seq_found;                                                                                 \
+    (seq_diff)  = _fd_mcache_burst_seq_diff;                                                                                  \
+    (poll_max)  = _fd_mcache_burst_poll_max;                                                                                  \
+  } while(0)
+
 #endif
 
 /* fd_mcache_query returns seq_query if seq_query is still in the mcache
@@ -190,6 +190,88 @@ main( int     argc,
     fd_mcache_seq_update( _seq, fd_seq_inc( next, 1UL ) );
   }
 
+  /* Test burst publish and consume */
+
+  do {
+    fd_frag_meta_t burst[ 64 ];
+    fd_frag_meta_t found[ 64 ];
+    ulong tx_seq = fd_mcache_seq_query( _seq_const );
+    ulong rx_seq = tx_seq;
+    for( ulong iter=0UL; iter<100000UL; iter++ ) {
+      ulong cnt = 1UL + fd_rng_ulong_roll( rng, 64UL );
+      for( ulong i=0UL; i<cnt; i++ ) {
+        ulong s = fd_seq_inc( tx_seq, i );
+        burst[i].seq    = 0UL;
+        burst[i].sig    = fd_ulong_hash( s );
+        burst[i].chunk  = (uint  )s;
+        burst[i].sz     = (ushort)s;
+        burst[i].ctl    = (ushort)(s>>16);
+        burst[i].tsorig = (uint  )(s>>32);
+        burst[i].tspub  = (uint  )~s;
+      }
+#if FD_HAS_AVX
+      int use_avx = (int)(iter & 1UL);
+#else
+      int use_avx = 0;
+#endif
+      ulong next = use_avx ? 0UL : fd_mcache_publish_burst( mcache, depth, tx_seq, burst, cnt );
+#if FD_HAS_AVX
+      if( use_avx ) next = fd_mcache_publish_burst_avx( mcache, depth, tx_seq, burst, cnt );
+#endif
+      FD_TEST( fd_seq_eq( next, fd_seq_inc( tx_seq, cnt ) ) );
+      for( ulong i=0UL; i<cnt; i++ ) {
+        ulong s = fd_seq_inc( tx_seq, i );
+        fd_frag_meta_t const * line = mcache + fd_mcache_line_idx( s, depth );
+        FD_TEST( fd_seq_eq( fd_mcache_query( mcache, depth, s ), s ) );
+        FD_TEST( line->sig==fd_ulong_hash( s ) && line->chunk==(uint)s && line->sz==(ushort)s && line->ctl==(ushort)(s>>16) &&
+                 line->tsorig==(uint)(s>>32) && line->tspub==(uint)~s );
+      }
+      FD_TEST( fd_seq_gt( next, fd_mcache_query( mcache, depth, next ) ) );
+      tx_seq = next;
+      fd_mcache_seq_update( _seq, tx_seq );
+
+#if FD_HAS_AVX
+      /* Drain what was published in random sized bursts */
+      while( fd_seq_lt( rx_seq, tx_seq ) ) {
+        ulong cnt_max   = 1UL + fd_rng_ulong_roll( rng, 64UL );
+        ulong poll_max  = 1UL;
+        ulong rx_cnt;
+        ulong seq_found;
+        long  seq_diff;
+        FD_MCACHE_WAIT_BURST_AVX( found, rx_cnt, seq_found, seq_diff, poll_max, mcache, depth, rx_seq, cnt_max );
+        FD_TEST( !poll_max ); /* Available on the first and only poll, so poll_max is exhausted */
+        (void)seq_found; (void)seq_diff; (void)rx_cnt;
+        poll_max = 2UL;
+        FD_MCACHE_WAIT_BURST_AVX( found, rx_cnt, seq_found, seq_diff, poll_max, mcache, depth, rx_seq, cnt_max );
+        FD_TEST( poll_max==1UL );
+        FD_TEST( fd_seq_eq( seq_found, rx_seq ) && !seq_diff );
+        FD_TEST( rx_cnt==fd_ulong_min( cnt_max, (ulong)fd_seq_diff( tx_seq, rx_seq ) ) );
+        for( ulong i=0UL; i<rx_cnt; i++ ) {
+          ulong s = fd_seq_inc( rx_seq, i );
+          FD_TEST( fd_seq_eq( found[i].seq, s ) && found[i].sig==fd_ulong_hash( s ) && found[i].chunk==(uint)s );
+        }
+        rx_seq = fd_seq_inc( rx_seq, rx_cnt );
+      }
+
+      /* Nothing more to drain times out, and an overrun consumer is
+         detected */
+      ulong poll_max = 4UL;
+      ulong rx_cnt;
+      ulong seq_found;
+      long  seq_diff;
+      FD_MCACHE_WAIT_BURST_AVX( found, rx_cnt, seq_found, seq_diff, poll_max, mcache, depth, rx_seq, 64UL );
+      FD_TEST( !poll_max && !rx_cnt );
+      poll_max = 4UL;
+      FD_MCACHE_WAIT_BURST_AVX( found, rx_cnt, seq_found, seq_diff, poll_max, mcache, depth, fd_seq_dec( rx_seq, 2UL*depth ), 64UL );
+      FD_TEST( poll_max==3UL && !rx_cnt && seq_diff>0L );
+      (void)seq_found;
+#else
+      rx_seq = tx_seq;
+#endif
+    }
+    (void)rx_seq;
+  } while(0);
+
   /* Test mcache for corruption */
 
   FD_TEST( fd_mcache_depth          ( mcache )==depth      );
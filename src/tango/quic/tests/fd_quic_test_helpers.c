@@ -316,6 +316,7 @@ fd_quic_udpsock_create( void *           _sock,
   ulong        xsk_pkt_cnt  = fd_env_strip_cmdline_ulong ( pargc, pargv, "--xsk-pkt-cnt",  NULL,      32UL );
   char const * _listen_ip   = fd_env_strip_cmdline_cstr  ( pargc, pargv, "--listen-ip",    NULL, "0.0.0.0" );
   ushort       listen_port  = fd_env_strip_cmdline_ushort( pargc, pargv, "--listen-port",  NULL,       0U  );
+  int          io_uring     = fd_env_strip_cmdline_contains( pargc, pargv, "--io-uring" );
 
   uint listen_ip = 0;
   if( FD_UNLIKELY( !fd_cstr_to_ip4_addr( _listen_ip, &listen_ip ) ) ) FD_LOG_ERR(( "invalid --listen-ip" ));
@@ -380,7 +381,7 @@ fd_quic_udpsock_create( void *           _sock,
 
     FD_LOG_NOTICE(( "Adding UDP listener (" FD_IP4_ADDR_FMT ":%u)",
                     FD_IP4_ADDR_FMT_ARGS( quic_sock->listen_ip ), quic_sock->listen_port ));
-    if( FD_UNLIKELY( 0!=fd_xdp_listen_udp_port( xdp_app_name, quic_sock->listen_ip, quic_sock->listen_port, 0 ) ) ) {
+    if( FD_UNLIKELY( 0!=fd_xdp_listen_udp_port( xdp_app_name, quic_sock->listen_ip, quic_sock->listen_port, FD_XDP_PROTO_TPU_QUIC_USER ) ) ) {
       FD_LOG_WARNING(( "failed to add UDP listener" ));
       fd_xsk_aio_leave( xsk_aio );
       fd_xsk_leave( xsk );
@@ -416,6 +417,29 @@ fd_quic_udpsock_create( void *           _sock,
       return NULL;
     }
 
+    if( io_uring ) {
+      void * uring_mem = fd_wksp_alloc_laddr( wksp, fd_uringsock_align(),
+                           fd_uringsock_footprint( mtu, rx_depth, tx_depth ),
+                           1UL );
+      fd_uringsock_t * uring = uring_mem ? fd_uringsock_join( fd_uringsock_new( uring_mem, mtu, rx_depth, tx_depth ), sock_fd ) : NULL;
+      if( FD_LIKELY( uring ) ) {
+        quic_sock->type              = FD_QUIC_UDPSOCK_TYPE_URINGSOCK;
+        quic_sock->wksp              = wksp;
+        quic_sock->uringsock.sock    = uring;
+        quic_sock->uringsock.sock_fd = sock_fd;
+        quic_sock->aio               = fd_uringsock_get_tx( uring );
+        quic_sock->listen_ip         = fd_uringsock_get_ip4_address( uring );
+        quic_sock->listen_port       = (ushort)fd_uringsock_get_listen_port( uring );
+        fd_uringsock_set_rx( uring, rx_aio );
+
+        FD_LOG_NOTICE(( "UDP socket (io_uring) listening on " FD_IP4_ADDR_FMT ":%u",
+                        FD_IP4_ADDR_FMT_ARGS( quic_sock->listen_ip ), quic_sock->listen_port ));
+        return quic_sock;
+      }
+      FD_LOG_WARNING(( "fd_uringsock_join() failed, falling back to fd_udpsock" ));
+      if( uring_mem ) fd_wksp_free_laddr( uring_mem );
+    }
+
     void * sock_mem = fd_wksp_alloc_laddr( wksp, fd_udpsock_align(),
                         fd_udpsock_footprint( mtu, rx_depth, tx_depth ),
                         1UL );
@@ -463,6 +487,10 @@ fd_quic_udpsock_destroy( fd_quic_udpsock_t * udpsock ) {
     fd_wksp_free_laddr( fd_udpsock_delete( fd_udpsock_leave( udpsock->udpsock.sock ) ) );
     close( udpsock->udpsock.sock_fd );
     break;
+  case FD_QUIC_UDPSOCK_TYPE_URINGSOCK:
+    fd_wksp_free_laddr( fd_uringsock_delete( fd_uringsock_leave( udpsock->uringsock.sock ) ) );
+    close( udpsock->uringsock.sock_fd );
+    break;
   }
 
   return udpsock;
@@ -477,5 +505,8 @@ fd_quic_udpsock_service( fd_quic_udpsock_t const * udpsock ) {
   case FD_QUIC_UDPSOCK_TYPE_UDPSOCK:
     fd_udpsock_service( udpsock->udpsock.sock );
     break;
+  case FD_QUIC_UDPSOCK_TYPE_URINGSOCK:
+    fd_uringsock_service( udpsock->uringsock.sock );
+    break;
   }
 }
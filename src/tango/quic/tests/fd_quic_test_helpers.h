@@ -5,6 +5,7 @@
 #include "../../aio/fd_aio_pcapng.h"
 #include "../../xdp/fd_xdp.h"
 #include "../../udpsock/fd_udpsock.h"
+#include "../../uringsock/fd_uringsock.h"
 
 /* Common helpers for QUIC tests.  The tests using these gain the
    following command-line options:
@@ -78,12 +79,15 @@ fd_quic_test_keylog( fd_quic_virtual_pair_t const * pair,
 FD_PROTOTYPES_END
 
 /* fd_quic_udpsock is a command-line helper for creating an UDP channel
-   over AF_XDP or UDP sockets. */
+   over AF_XDP or UDP sockets.  --io-uring services the UDP socket with
+   fd_uringsock instead of fd_udpsock (falls back to fd_udpsock if
+   io_uring is not available). */
 
 struct fd_quic_udpsock {
   int type;
-# define FD_QUIC_UDPSOCK_TYPE_XSK     1
-# define FD_QUIC_UDPSOCK_TYPE_UDPSOCK 2
+# define FD_QUIC_UDPSOCK_TYPE_XSK       1
+# define FD_QUIC_UDPSOCK_TYPE_UDPSOCK   2
+# define FD_QUIC_UDPSOCK_TYPE_URINGSOCK 3
 
   uchar  self_mac[6];
   uint   listen_ip;
@@ -99,6 +103,10 @@ struct fd_quic_udpsock {
       fd_udpsock_t * sock;
       int            sock_fd;
     } udpsock;
+    struct {
+      fd_uringsock_t * sock;
+      int              sock_fd;
+    } uringsock;
   };
 
   fd_aio_t const * aio;
@@ -1,4 +1,5 @@
 $(call add-hdrs,fd_tcache.h)
 $(call add-objs,fd_tcache,fd_tango)
 $(call make-unit-test,test_tcache,test_tcache,fd_tango fd_util)
+$(call make-unit-test,bench_tcache,bench_tcache,fd_tango fd_util)
 
@@ -0,0 +1,179 @@
+#define _GNU_SOURCE
+#include "../fd_tango.h"
+
+#if FD_HAS_HOSTED && defined(__linux__)
+
+/* bench_tcache compares the insert throughput of the linear probed
+   (FD_TCACHE_INSERT) and bucketized (FD_TCACHE_BKT_INSERT) tcache maps
+   for a range of depths and duplicate rates.  It also reports the last
+   level cache misses per insert when the kernel lets us count them
+   (perf_event_paranoid, containers, VMs, ... might not).  Tags are IID
+   uniform random except for duplicates, which repeat a tag on average
+   --dup-avg-age tags back.  Use --depth-max to limit the largest depth
+   tested (the tcache footprint is ~40 bytes per unit of depth with the
+   default map_cnt). */
+
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+static int
+cache_miss_fd_open( void ) {
+  struct perf_event_attr attr;
+  fd_memset( &attr, 0, sizeof(attr) );
+  attr.type           = PERF_TYPE_HARDWARE;
+  attr.size           = sizeof(attr);
+  attr.config         = PERF_COUNT_HW_CACHE_MISSES;
+  attr.disabled       = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv     = 1;
+  return (int)syscall( SYS_perf_event_open, &attr, 0 /* this thread */, -1 /* any cpu */, -1 /* no group */, 0UL );
+}
+
+static ulong
+cache_miss_read( int fd ) {
+  ulong cnt = 0UL;
+  if( FD_UNLIKELY( read( fd, &cnt, sizeof(ulong) )!=(long)sizeof(ulong) ) ) return 0UL;
+  return cnt;
+}
+
+static void
+bench( fd_wksp_t * wksp,
+       fd_rng_t *  rng,
+       int         miss_fd,
+       ulong       depth,
+       float       dup_frac,
+       float       dup_avg_age,
+       ulong *     tag,
+       ulong       tag_cnt ) {
+
+  ulong map_cnt = fd_tcache_map_cnt_default( depth );
+  void * mem = fd_wksp_alloc_laddr( wksp, fd_tcache_align(), fd_tcache_footprint( depth, map_cnt ), 1UL );
+  if( FD_UNLIKELY( !mem ) ) { FD_LOG_WARNING(( "skipping --depth %lu (increase --page-cnt)", depth )); return; }
+  fd_tcache_t * tcache = fd_tcache_join( fd_tcache_new( mem, depth, map_cnt ) ); FD_TEST( tcache );
+  ulong * ring = fd_tcache_ring_laddr( tcache );
+  ulong * map  = fd_tcache_map_laddr ( tcache );
+
+  uint dup_thresh = (uint)(0.5f + dup_frac*(float)(1UL<<32));
+  for( ulong idx=0UL; idx<tag_cnt; idx++ ) {
+    ulong t;
+    int is_dup = (fd_rng_uint( rng ) < dup_thresh);
+    if( is_dup ) {
+      ulong age = (ulong)(uint)(int)(1.0f + dup_avg_age*fd_rng_float_exp( rng ));
+      if( FD_UNLIKELY( age>idx ) ) is_dup = 0;
+      else                         t = tag[ idx - age ];
+    }
+    if( !is_dup ) do t = fd_rng_ulong( rng ); while( FD_UNLIKELY( fd_tcache_tag_is_null( t ) ) );
+    tag[ idx ] = t;
+  }
+
+  for( int bkt=0; bkt<2; bkt++ ) {
+    ulong oldest = fd_tcache_reset( ring, depth, map, map_cnt );
+
+    /* Fill the tcache so we measure steady state (insert + evict) */
+
+    for( ulong rem=depth; rem; rem-- ) {
+      ulong t; do t = fd_rng_ulong( rng ); while( FD_UNLIKELY( fd_tcache_tag_is_null( t ) ) );
+      int dup;
+      if( bkt ) FD_TCACHE_BKT_INSERT( dup, oldest, ring, depth, map, map_cnt, t );
+      else      FD_TCACHE_INSERT    ( dup, oldest, ring, depth, map, map_cnt, t );
+      (void)dup;
+    }
+
+    ulong dup_cnt = 0UL;
+    if( miss_fd>=0 ) { ioctl( miss_fd, PERF_EVENT_IOC_RESET, 0 ); ioctl( miss_fd, PERF_EVENT_IOC_ENABLE, 0 ); }
+    long tic = fd_log_wallclock();
+    if( bkt ) {
+      for( ulong idx=0UL; idx<tag_cnt; idx++ ) {
+        int dup;
+        FD_TCACHE_BKT_INSERT( dup, oldest, ring, depth, map, map_cnt, tag[ idx ] );
+        dup_cnt += (ulong)dup;
+      }
+    } else {
+      for( ulong idx=0UL; idx<tag_cnt; idx++ ) {
+        int dup;
+        FD_TCACHE_INSERT( dup, oldest, ring, depth, map, map_cnt, tag[ idx ] );
+        dup_cnt += (ulong)dup;
+      }
+    }
+    long toc = fd_log_wallclock();
+    ulong miss_cnt = 0UL;
+    if( miss_fd>=0 ) { ioctl( miss_fd, PERF_EVENT_IOC_DISABLE, 0 ); miss_cnt = cache_miss_read( miss_fd ); }
+
+    double dt = (double)(toc-tic);
+    if( miss_fd>=0 )
+      FD_LOG_NOTICE(( "depth %8lu dup %.2f %-13s: %9.3e inserts/s, %6.2f ns/insert, %5.2f LLC misses/insert (dup %.3f)",
+                      depth, (double)dup_frac, bkt ? "bucketized" : "linear probed",
+                      1e9*(double)tag_cnt/dt, dt/(double)tag_cnt, (double)miss_cnt/(double)tag_cnt,
+                      (double)dup_cnt/(double)tag_cnt ));
+    else
+      FD_LOG_NOTICE(( "depth %8lu dup %.2f %-13s: %9.3e inserts/s, %6.2f ns/insert, n/a LLC misses/insert (dup %.3f)",
+                      depth, (double)dup_frac, bkt ? "bucketized" : "linear probed",
+                      1e9*(double)tag_cnt/dt, dt/(double)tag_cnt,
+                      (double)dup_cnt/(double)tag_cnt ));
+  }
+
+  fd_wksp_free_laddr( fd_tcache_delete( fd_tcache_leave( tcache ) ) );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong cpu_idx = fd_tile_cpu_id( fd_tile_idx() );
+  if( cpu_idx>fd_shmem_cpu_cnt() ) cpu_idx = 0UL;
+
+  char const * _page_sz    = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",     NULL, "gigantic"                   );
+  ulong        page_cnt    = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt",    NULL, 1UL                          );
+  ulong        numa_idx    = fd_env_strip_cmdline_ulong( &argc, &argv, "--numa-idx",    NULL, fd_shmem_numa_idx( cpu_idx ) );
+  ulong        depth_max   = fd_env_strip_cmdline_ulong( &argc, &argv, "--depth-max",   NULL, (1UL<<22)-2UL                );
+  ulong        tag_cnt     = fd_env_strip_cmdline_ulong( &argc, &argv, "--tag-cnt",     NULL, 1UL<<22                      );
+  float        dup_avg_age = fd_env_strip_cmdline_float( &argc, &argv, "--dup-avg-age", NULL, 1.f                          );
+
+  FD_LOG_NOTICE(( "Creating workspace (--page-cnt %lu, --page-sz %s, --numa-idx %lu)", page_cnt, _page_sz, numa_idx ));
+  fd_wksp_t * wksp =
+    fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
+  FD_TEST( wksp );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  ulong * tag = (ulong *)fd_wksp_alloc_laddr( wksp, 0UL, tag_cnt*sizeof(ulong), 1UL );
+  if( FD_UNLIKELY( !tag ) ) FD_LOG_ERR(( "--tag-cnt too large for workspace (increase --page-cnt)" ));
+
+  int miss_fd = cache_miss_fd_open();
+  if( FD_UNLIKELY( miss_fd<0 ) ) FD_LOG_WARNING(( "perf_event_open failed; cache misses will not be reported" ));
+
+  FD_LOG_NOTICE(( "--tag-cnt %lu --dup-avg-age %.2f --depth-max %lu", tag_cnt, (double)dup_avg_age, depth_max ));
+
+  static ulong const depths   [] = { (1UL<<10)-2UL, (1UL<<16)-2UL, (1UL<<20)-2UL, (1UL<<22)-2UL };
+  static float const dup_fracs[] = { 0.f, 0.25f, 0.5f, 0.9f };
+  for( ulong d=0UL; d<sizeof(depths)/sizeof(depths[0]); d++ ) {
+    if( depths[d]>depth_max ) break;
+    for( ulong f=0UL; f<sizeof(dup_fracs)/sizeof(dup_fracs[0]); f++ )
+      bench( wksp, rng, miss_fd, depths[d], dup_fracs[f], dup_avg_age, tag, tag_cnt );
+  }
+
+  if( miss_fd>=0 ) close( miss_fd );
+  fd_wksp_free_laddr( tag );
+  fd_rng_delete( fd_rng_leave( rng ) );
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
@@ -12,8 +12,9 @@ fd_tcache_footprint( ulong depth,
 
   if( FD_UNLIKELY( (!depth) | (map_cnt<(depth+2UL)) | (!fd_ulong_is_pow2( map_cnt )) ) ) return 0UL; /* Invalid depth / max_cnt */
 
-  ulong cnt = 4UL+depth; if( FD_UNLIKELY( cnt<depth   ) ) return 0UL; /* overflow */
-  cnt += map_cnt;        if( FD_UNLIKELY( cnt<map_cnt ) ) return 0UL; /* overflow */
+  ulong cnt = 4UL+depth;                 if( FD_UNLIKELY( cnt<depth   ) ) return 0UL; /* overflow */
+  cnt = fd_ulong_align_up( cnt, 8UL );  if( FD_UNLIKELY( cnt<depth   ) ) return 0UL; /* overflow (map is cache line aligned) */
+  cnt += map_cnt;                       if( FD_UNLIKELY( cnt<map_cnt ) ) return 0UL; /* overflow */
   if( FD_UNLIKELY( cnt>(ULONG_MAX/sizeof(ulong)) ) ) return 0UL; /* overflow */
   cnt *= sizeof(ulong); /* no overflow */
   ulong footprint = fd_ulong_align_up( cnt, FD_TCACHE_ALIGN ); if( FD_UNLIKELY( footprint<cnt ) ) return 0UL; /* overflow */
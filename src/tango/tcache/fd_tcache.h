@@ -32,9 +32,9 @@
    declarations. */
 
 #define FD_TCACHE_ALIGN (128UL)
-#define FD_TCACHE_FOOTPRINT( depth, map_cnt )                     \
-  FD_LAYOUT_FINI( FD_LAYOUT_APPEND( FD_LAYOUT_INIT,               \
-    FD_TCACHE_ALIGN, (4UL + (depth) + (map_cnt))*sizeof(ulong) ), \
+#define FD_TCACHE_FOOTPRINT( depth, map_cnt )                                         \
+  FD_LAYOUT_FINI( FD_LAYOUT_APPEND( FD_LAYOUT_INIT,                                   \
+    FD_TCACHE_ALIGN, (FD_ULONG_ALIGN_UP( 4UL + (depth), 8UL ) + (map_cnt))*sizeof(ulong) ), \
     FD_TCACHE_ALIGN )
 
 /* FD_TCACHE_TAG_NULL is a tag value that will never be inserted. */
@@ -81,6 +81,10 @@ struct __attribute((aligned(FD_TCACHE_ALIGN))) fd_tcache_private {
      active use / occupy local cache and the access pattern will be
      highly sequential. */
 
+  /* Padding to a cache line boundary (the map is cache line aligned so
+     that it can also be used as a bucketized map, see
+     FD_TCACHE_BKT_INSERT below) */
+
   /* map_cnt ulong (map):
 
      This is a sparse linear probed key-only map of tags currently in
@@ -222,7 +226,7 @@ FD_FN_PURE  static inline ulong   fd_tcache_map_cnt     ( fd_tcache_t const * tc
 
 FD_FN_CONST static inline ulong * fd_tcache_oldest_laddr( fd_tcache_t * tcache ) { return &tcache->oldest; }
 FD_FN_CONST static inline ulong * fd_tcache_ring_laddr  ( fd_tcache_t * tcache ) { return ((ulong *)tcache)+4UL; }
-FD_FN_PURE  static inline ulong * fd_tcache_map_laddr   ( fd_tcache_t * tcache ) { return ((ulong *)tcache)+4UL+tcache->depth; }
+FD_FN_PURE  static inline ulong * fd_tcache_map_laddr   ( fd_tcache_t * tcache ) { return ((ulong *)tcache)+fd_ulong_align_up( 4UL+tcache->depth, 8UL ); }
 
 /* fd_tcache_tag_is_null returns non-zero if tag is FD_TCACHE_TAG_NULL
    and zero otherwise. */
@@ -403,6 +407,208 @@ fd_tcache_remove( ulong * map,
     (oldest) = _fti_oldest;                                                      \
   } while(0)
 
+/* Bucketized map:
+
+   The map of a tcache can alternatively be used as a bucketized map.
+   The map_cnt slots are grouped into map_cnt/FD_TCACHE_BKT_SLOT_CNT
+   buckets of FD_TCACHE_BKT_SLOT_CNT tags (one 64 byte cache line per
+   bucket).  A tag is stored in the first free slot of the bucket
+   selected by its low bits, or, if that bucket is full, of the next
+   non-full bucket (cyclic).  A query compares the tag against all the
+   slots of a bucket at once (two AVX compares on targets with AVX) and
+   only moves on to the next bucket if the bucket is full without a
+   match.  For the default sparse fill ratios, buckets overflow rarely,
+   so nearly every query or insert touches a single map cache line
+   (versus possibly two for the linear probed map and with fewer
+   data-dependent branches).
+
+   The FD_TCACHE_BKT_* API is a drop-in replacement for the
+   FD_TCACHE_{QUERY,INSERT} / fd_tcache_remove API (same arguments,
+   same depth / eviction semantics) but the two place tags differently.
+   A given tcache must be accessed exclusively through one of the two
+   APIs from the last reset onward.  The bucketized API additionally
+   requires map_cnt to be at least FD_TCACHE_BKT_SLOT_CNT (this is
+   always the case for fd_tcache_map_cnt_default).
+
+   FD_TCACHE_USE_BKT selects which API the tiles that use a tcache
+   (e.g. dedup, verify) use.  Build with EXTRAS=tcache-bkt to use the
+   bucketized map. */
+
+#ifndef FD_TCACHE_USE_BKT
+#define FD_TCACHE_USE_BKT 0
+#endif
+
+#define FD_TCACHE_BKT_SLOT_CNT (8UL)
+
+/* fd_tcache_bkt_start returns the index of the first slot of the
+   bucket in a map with map_cnt slots to start probing for tag.  Assumes
+   tag is not null and map_cnt is an integer power of 2 of at least
+   FD_TCACHE_BKT_SLOT_CNT.
+
+   fd_tcache_bkt_next returns the index of the first slot of the bucket
+   following the bucket whose first slot is idx (cyclic). */
+
+FD_FN_CONST static inline ulong fd_tcache_bkt_start( ulong tag, ulong map_cnt ) { return  tag                        & (map_cnt-FD_TCACHE_BKT_SLOT_CNT); }
+FD_FN_CONST static inline ulong fd_tcache_bkt_next ( ulong idx, ulong map_cnt ) { return (idx+FD_TCACHE_BKT_SLOT_CNT) & (map_cnt-1UL);                    }
+
+/* fd_tcache_bkt_probe compares tag against the FD_TCACHE_BKT_SLOT_CNT
+   slots of the cache line aligned bucket bkt.  Returns a bit mask with
+   bit i set if slot i holds tag and stores a bit mask with bit i set if
+   slot i is empty at *_empty. */
+
+static inline uint
+fd_tcache_bkt_probe( ulong const * bkt,
+                     ulong         tag,
+                     uint *        _empty ) {
+# if FD_HAS_AVX
+  __m256i b0 = _mm256_load_si256( (__m256i const *) bkt      );
+  __m256i b1 = _mm256_load_si256( (__m256i const *)(bkt+4UL) );
+  __m256i t  = _mm256_set1_epi64x( (long)tag );
+  __m256i z  = _mm256_setzero_si256(); /* FD_TCACHE_TAG_NULL */
+  *_empty = (uint)  _mm256_movemask_pd( _mm256_castsi256_pd( _mm256_cmpeq_epi64( b0, z ) ) )
+          | ((uint)_mm256_movemask_pd( _mm256_castsi256_pd( _mm256_cmpeq_epi64( b1, z ) ) ) << 4);
+  return    (uint)  _mm256_movemask_pd( _mm256_castsi256_pd( _mm256_cmpeq_epi64( b0, t ) ) )
+          | ((uint)_mm256_movemask_pd( _mm256_castsi256_pd( _mm256_cmpeq_epi64( b1, t ) ) ) << 4);
+# else
+  uint match = 0U;
+  uint empty = 0U;
+  for( ulong i=0UL; i<FD_TCACHE_BKT_SLOT_CNT; i++ ) {
+    match |= ((uint)(bkt[i]==tag                  )) << i;
+    empty |= ((uint)fd_tcache_tag_is_null( bkt[i] )) << i;
+  }
+  *_empty = empty;
+  return match;
+# endif
+}
+
+/* FD_TCACHE_BKT_QUERY is FD_TCACHE_QUERY for a bucketized map (same
+   arguments and semantics).  Assumes map is cache line aligned and
+   map_cnt is an integer power-of-two of at least
+   FD_TCACHE_BKT_SLOT_CNT. */
+
+#define FD_TCACHE_BKT_QUERY( found, map_idx, map, map_cnt, tag ) do {              \
+    ulong const * _ftbq_map     = (map);                                           \
+    ulong         _ftbq_map_cnt = (map_cnt);                                       \
+    ulong         _ftbq_tag     = (tag);                                           \
+    ulong         _ftbq_bkt     = fd_tcache_bkt_start( _ftbq_tag, _ftbq_map_cnt ); \
+    int           _ftbq_found;                                                     \
+    ulong         _ftbq_map_idx;                                                   \
+    for(;;) {                                                                      \
+      uint _ftbq_empty;                                                            \
+      uint _ftbq_match = fd_tcache_bkt_probe( _ftbq_map+_ftbq_bkt, _ftbq_tag,      \
+                                              &_ftbq_empty );                      \
+      if( FD_LIKELY( _ftbq_match ) ) {                                             \
+        _ftbq_found   = 1;                                                         \
+        _ftbq_map_idx = _ftbq_bkt + (ulong)fd_uint_find_lsb( _ftbq_match );        \
+        break;                                                                     \
+      }                                                                            \
+      if( FD_LIKELY( _ftbq_empty ) ) {                                             \
+        _ftbq_found   = 0;                                                         \
+        _ftbq_map_idx = _ftbq_bkt + (ulong)fd_uint_find_lsb( _ftbq_empty );        \
+        break;                                                                     \
+      }                                                                            \
+      _ftbq_bkt = fd_tcache_bkt_next( _ftbq_bkt, _ftbq_map_cnt );                  \
+    }                                                                              \
+    (found)   = _ftbq_found;                                                       \
+    (map_idx) = _ftbq_map_idx;                                                     \
+  } while(0)
+
+/* fd_tcache_bkt_remove is fd_tcache_remove for a bucketized map (same
+   arguments and semantics).
+
+   Removing a tag from a full bucket could strand tags that overflowed
+   past it (a query stops at the first non-full bucket), so, like the
+   linear probed map, subsequent buckets are scanned for a tag whose
+   probe sequence passes through the hole and that tag is moved into
+   the hole.  This repeats until a non-full bucket is reached.  Since
+   bucket overflow is rare at sparse fill ratios, this almost always
+   just clears the slot. */
+
+FD_FN_UNUSED static void /* Work around -Winline */
+fd_tcache_bkt_remove( ulong * map,
+                      ulong   map_cnt,
+                      ulong   tag ) {
+
+  if( FD_LIKELY( !fd_tcache_tag_is_null( tag ) ) ) {
+
+    int   found;
+    ulong hole;
+    FD_TCACHE_BKT_QUERY( found, hole, map, map_cnt, tag );
+    if( FD_LIKELY( found ) ) {
+
+      /* If the tag's bucket was not full, no tag can have overflowed
+         past it (the common case). */
+
+      ulong hole_bkt = hole & ~(FD_TCACHE_BKT_SLOT_CNT-1UL);
+      uint  empty;     fd_tcache_bkt_probe( map+hole_bkt, FD_TCACHE_TAG_NULL, &empty );
+      map[ hole ] = FD_TCACHE_TAG_NULL;
+      if( FD_LIKELY( empty ) ) return;
+
+      ulong bkt = hole_bkt;
+      for(;;) {
+        bkt = fd_tcache_bkt_next( bkt, map_cnt );
+        if( FD_UNLIKELY( bkt==hole_bkt ) ) return; /* Wrapped (e.g. single bucket map) */
+
+        /* Look for a tag in bkt whose home bucket is not in
+           (hole_bkt,bkt] cyclic, i.e. whose probe sequence passes
+           through the hole's bucket.  If there is none and bkt is not
+           full, no tag further along can pass through the hole either. */
+
+        fd_tcache_bkt_probe( map+bkt, FD_TCACHE_TAG_NULL, &empty );
+        ulong dist_hole = (bkt - hole_bkt) & (map_cnt-1UL);
+        ulong slot      = ULONG_MAX;
+        for( ulong i=0UL; i<FD_TCACHE_BKT_SLOT_CNT; i++ ) {
+          ulong slot_tag = map[ bkt+i ];
+          if( fd_tcache_tag_is_null( slot_tag ) ) continue;
+          ulong dist_home = (bkt - fd_tcache_bkt_start( slot_tag, map_cnt )) & (map_cnt-1UL);
+          if( dist_home>=dist_hole ) { slot = bkt+i; break; }
+        }
+        if( FD_LIKELY( slot!=ULONG_MAX ) ) {
+          map[ hole ] = map[ slot ];
+          map[ slot ] = FD_TCACHE_TAG_NULL;
+          hole        = slot;
+          hole_bkt    = bkt;
+        }
+        if( FD_LIKELY( empty ) ) return; /* bkt was not full */
+      }
+    }
+  }
+}
+
+/* FD_TCACHE_BKT_INSERT is FD_TCACHE_INSERT for a bucketized map (same
+   arguments and semantics).  Assumes additionally that map is cache
+   line aligned and map_cnt is at least FD_TCACHE_BKT_SLOT_CNT. */
+
+#define FD_TCACHE_BKT_INSERT( dup, oldest, ring, depth, map, map_cnt, tag ) do {        \
+    ulong   _ftbi_oldest   = (oldest);                                                  \
+    ulong * _ftbi_ring     = (ring);                                                    \
+    ulong   _ftbi_depth    = (depth);                                                   \
+    ulong * _ftbi_map      = (map);                                                     \
+    ulong   _ftbi_map_cnt  = (map_cnt);                                                 \
+    ulong   _ftbi_tag      = (tag);                                                     \
+                                                                                        \
+    int   _ftbi_dup;                                                                    \
+    ulong _ftbi_map_idx;                                                                \
+    FD_TCACHE_BKT_QUERY( _ftbi_dup, _ftbi_map_idx, _ftbi_map, _ftbi_map_cnt, _ftbi_tag ); \
+    if( !_ftbi_dup ) { /* application dependent branch probability */                   \
+                                                                                        \
+      /* Insert tag into the map (assumes depth <= map_cnt-2) */                        \
+      _ftbi_map[ _ftbi_map_idx ] = _ftbi_tag;                                           \
+                                                                                        \
+      /* Evict oldest tag / insert tag into ring */                                     \
+      ulong _ftbi_tag_oldest = _ftbi_ring[ _ftbi_oldest ];                              \
+      _ftbi_ring[ _ftbi_oldest ] = _ftbi_tag;                                           \
+      _ftbi_oldest++;                                                                   \
+      if( _ftbi_oldest >= _ftbi_depth ) _ftbi_oldest = 0UL; /* cmov */                  \
+                                                                                        \
+      /* Remove oldest tag from map */                                                  \
+      /* _ftbi_tag_oldest will be null at startup but remove handles that case */       \
+      fd_tcache_bkt_remove( _ftbi_map, _ftbi_map_cnt, _ftbi_tag_oldest );               \
+    }                                                                                   \
+    (dup)    = _ftbi_dup;                                                               \
+    (oldest) = _ftbi_oldest;                                                            \
+  } while(0)
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_tango_tcache_fd_tcache_h */
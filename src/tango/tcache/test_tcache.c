@@ -74,6 +74,9 @@ main( int     argc,
   ulong * _oldest = fd_tcache_oldest_laddr( tcache ); FD_TEST( _oldest );
   ulong * ring    = fd_tcache_ring_laddr  ( tcache ); FD_TEST( ring    );
   ulong * map     = fd_tcache_map_laddr   ( tcache ); FD_TEST( map     );
+  FD_TEST( fd_ulong_is_aligned( (ulong)map, 64UL ) );
+  FD_TEST( (ulong)map >= (ulong)(ring+depth) );
+  FD_TEST( (ulong)(map+map_cnt) <= (ulong)tcache + footprint );
   ulong   oldest  = _oldest[0];                       FD_TEST( !oldest );
 
   FD_TEST( fd_tcache_tag_is_null( FD_TCACHE_TAG_NULL ) );
@@ -199,6 +202,130 @@ main( int     argc,
     rem += (ulong)is_dup; /* Only count unique inserts */
   }
 
+  FD_LOG_NOTICE(( "Testing bucketized query and remove" ));
+
+  oldest = fd_tcache_reset( ring, depth, map, map_cnt ); FD_TEST( !oldest );
+
+  for( ulong seq=0UL; seq<depth; seq++ ) {
+    ulong tag = fd_ulong_hash( seq + 1UL ); /* Assumes FD_TCACHE_TAG_NULL is zero, hash is perm and hash(0) is 0 */
+
+    int   found;
+    ulong map_idx;
+    FD_TCACHE_BKT_QUERY( found, map_idx, map, map_cnt, tag );
+    FD_TEST( !found );
+    FD_TEST( map_idx<map_cnt );
+    FD_TEST( fd_tcache_tag_is_null( map[ map_idx ] ) );
+
+    map[ map_idx ] = tag;
+
+    int   found2;
+    ulong map_idx2;
+    FD_TCACHE_BKT_QUERY( found2, map_idx2, map, map_cnt, tag );
+    FD_TEST( found2 );
+    FD_TEST( map_idx2==map_idx );
+  }
+
+  for( ulong seq=0UL; seq<depth; seq++ ) {
+    ulong tag = fd_ulong_hash( seq + 1UL );
+
+    int   found;
+    ulong map_idx;
+    FD_TCACHE_BKT_QUERY( found, map_idx, map, map_cnt, tag );
+    FD_TEST( found );
+    FD_TEST( map[ map_idx ]==tag );
+
+    fd_tcache_bkt_remove( map, map_cnt, tag );
+
+    FD_TCACHE_BKT_QUERY( found, map_idx, map, map_cnt, tag );
+    FD_TEST( !found );
+    FD_TEST( fd_tcache_tag_is_null( map[ map_idx ] ) );
+  }
+  for( ulong map_idx=0UL; map_idx<map_cnt; map_idx++ ) FD_TEST( fd_tcache_tag_is_null( map[ map_idx ] ) );
+
+  FD_LOG_NOTICE(( "Running bucketized" ));
+
+  oldest = fd_tcache_reset( ring, depth, map, map_cnt ); FD_TEST( !oldest );
+
+  for( ulong rem=3UL*depth; rem; rem-- ) {
+
+    ulong tag;
+
+    int is_dup = (fd_rng_uint( rng ) < dup_thresh);
+    if( is_dup ) {
+      ulong age; do age = (ulong)(uint)(int)(1.0f + dup_avg_age*fd_rng_float_exp( rng )); while( FD_UNLIKELY( age>depth ) );
+      ulong dup_idx = oldest + depth - age;
+      dup_idx = fd_ulong_if( dup_idx<depth, dup_idx, dup_idx-depth );
+      tag = ring[ dup_idx ];
+      if( FD_UNLIKELY( fd_tcache_tag_is_null( tag ) ) ) is_dup = 0;
+    }
+
+    if( !is_dup ) {
+      int found;
+      do {
+        do tag = fd_rng_ulong( rng ); while( FD_UNLIKELY( fd_tcache_tag_is_null( tag ) ) );
+        ulong map_idx;
+        FD_TCACHE_BKT_QUERY( found, map_idx, map, map_cnt, tag );
+        (void)map_idx;
+      } while( FD_UNLIKELY( found ) );
+    }
+
+    int dup;
+    FD_TCACHE_BKT_INSERT( dup, oldest, ring, depth, map, map_cnt, tag );
+    FD_TEST( dup==is_dup );
+    rem += (ulong)is_dup;
+  }
+
+  FD_LOG_NOTICE(( "Testing bucketized overflow" ));
+
+  /* Small, nearly full maps where buckets overflow constantly.  Check
+     that every tag in the ring is still found and nothing else is. */
+
+  do {
+    static ulong small[ FD_TCACHE_FOOTPRINT( 1022UL, 1024UL )/sizeof(ulong) ] __attribute__((aligned(FD_TCACHE_ALIGN)));
+    static ulong const small_map_cnt[4] = { 8UL, 16UL, 64UL, 1024UL };
+    for( ulong t=0UL; t<4UL; t++ ) {
+      ulong         s_map_cnt = small_map_cnt[t];
+      ulong         s_depth   = s_map_cnt - 2UL;
+      fd_tcache_t * s_tcache  = fd_tcache_join( fd_tcache_new( small, s_depth, s_map_cnt ) ); FD_TEST( s_tcache );
+      ulong *       s_ring    = fd_tcache_ring_laddr( s_tcache );
+      ulong *       s_map     = fd_tcache_map_laddr ( s_tcache );
+      ulong         s_oldest  = 0UL;
+      FD_TEST( fd_ulong_is_aligned( (ulong)s_map, 64UL ) );
+
+      for( ulong iter=0UL; iter<20000UL; iter++ ) {
+        /* Few distinct low bits so tags pile up in a few buckets */
+        ulong tag = (fd_rng_ulong( rng ) & ~(s_map_cnt-1UL)) | (fd_rng_ulong_roll( rng, 3UL )*FD_TCACHE_BKT_SLOT_CNT);
+        tag |= (ulong)!tag; /* not null (the low bits bucket is unchanged) */
+        if( fd_rng_uint_roll( rng, 4U )==0U ) { /* dup */
+          ulong d = s_ring[ fd_rng_ulong_roll( rng, s_depth ) ];
+          if( !fd_tcache_tag_is_null( d ) ) tag = d;
+        }
+
+        int in_ring = 0;
+        for( ulong i=0UL; i<s_depth; i++ ) in_ring |= (s_ring[i]==tag);
+
+        int dup;
+        FD_TCACHE_BKT_INSERT( dup, s_oldest, s_ring, s_depth, s_map, s_map_cnt, tag );
+        FD_TEST( dup==in_ring );
+
+        ulong cnt = 0UL;
+        for( ulong i=0UL; i<s_depth; i++ ) {
+          if( fd_tcache_tag_is_null( s_ring[i] ) ) continue;
+          int   found;
+          ulong map_idx;
+          FD_TCACHE_BKT_QUERY( found, map_idx, s_map, s_map_cnt, s_ring[i] );
+          FD_TEST( found );
+          FD_TEST( s_map[ map_idx ]==s_ring[i] );
+          cnt++;
+        }
+        for( ulong i=0UL; i<s_map_cnt; i++ ) cnt -= (ulong)!fd_tcache_tag_is_null( s_map[i] );
+        FD_TEST( !cnt );
+      }
+
+      FD_TEST( fd_tcache_delete( fd_tcache_leave( s_tcache ) )==small );
+    }
+  } while(0);
+
   FD_LOG_NOTICE(( "Benchmarking" ));
 
   ulong   bench_cnt = 1UL<<20;
@@ -220,16 +347,26 @@ main( int     argc,
     }
 
     /* Benchmark it */
+    int bkt = (iter>=5UL);
+    if( (iter==0UL) | (iter==5UL) ) oldest = fd_tcache_reset( ring, depth, map, map_cnt ); /* Switching map layout */
     long tic = fd_log_wallclock();
-    for( ulong bench_idx=0UL; bench_idx<bench_cnt; bench_idx++ ) {
-      int dup;
-      FD_TCACHE_INSERT( dup, oldest, ring, depth, map, map_cnt, bench_tag[ bench_idx ] );
-      (void)dup;
+    if( bkt ) {
+      for( ulong bench_idx=0UL; bench_idx<bench_cnt; bench_idx++ ) {
+        int dup;
+        FD_TCACHE_BKT_INSERT( dup, oldest, ring, depth, map, map_cnt, bench_tag[ bench_idx ] );
+        (void)dup;
+      }
+    } else {
+      for( ulong bench_idx=0UL; bench_idx<bench_cnt; bench_idx++ ) {
+        int dup;
+        FD_TCACHE_INSERT( dup, oldest, ring, depth, map, map_cnt, bench_tag[ bench_idx ] );
+        (void)dup;
+      }
     }
     long toc = fd_log_wallclock();
 
     float avg = ((float)(toc-tic))/((float)bench_cnt);
-    FD_LOG_NOTICE(( "iter %lu: %.3f ns/dedup", iter, (double)avg ));
+    FD_LOG_NOTICE(( "iter %lu: %.3f ns/dedup (%s)", iter, (double)avg, bkt ? "bucketized" : "linear probed" ));
   }
 
   FD_LOG_NOTICE(( "Cleaning up" ));
@@ -0,0 +1,179 @@
+#include "fd_trace.h"
+
+#define FD_TRACE_MAGIC (0xf17eda2c377ace00UL) /* firedancer trace ver 0 */
+
+FD_STATIC_ASSERT( sizeof(fd_trace_event_t)==32UL,             layout );
+FD_STATIC_ASSERT( sizeof(fd_trace_t)      ==FD_TRACE_ALIGN,   layout );
+
+ulong
+fd_trace_align( void ) {
+  return FD_TRACE_ALIGN;
+}
+
+ulong
+fd_trace_footprint( ulong depth ) {
+  if( FD_UNLIKELY( depth<FD_TRACE_DEPTH_MIN          ) ) return 0UL;
+  if( FD_UNLIKELY( !fd_ulong_is_pow2( depth )        ) ) return 0UL;
+  if( FD_UNLIKELY( depth>(1UL<<(63-5))               ) ) return 0UL; /* overflow */
+  return FD_TRACE_FOOTPRINT( depth );
+}
+
+void *
+fd_trace_new( void * shmem,
+              ulong  depth,
+              ulong  tile,
+              ulong  lg_sample ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_trace_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_trace_footprint( depth );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad depth" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( tile>(ulong)USHORT_MAX ) ) {
+    FD_LOG_WARNING(( "bad tile" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( lg_sample>FD_TRACE_LG_SAMPLE_MAX ) ) {
+    FD_LOG_WARNING(( "bad lg_sample" ));
+    return NULL;
+  }
+
+  fd_trace_t * trace = (fd_trace_t *)shmem;
+
+  memset( trace, 0, footprint );
+
+  trace->depth     = depth;
+  trace->tile      = tile;
+  trace->lg_sample = lg_sample;
+  trace->mask      = (1UL<<lg_sample)-1UL;
+  trace->cursor    = 0UL;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( trace->magic ) = FD_TRACE_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_trace_t *
+fd_trace_join( void * shtrace ) {
+
+  if( FD_UNLIKELY( !shtrace ) ) {
+    FD_LOG_WARNING(( "NULL shtrace" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shtrace, fd_trace_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shtrace" ));
+    return NULL;
+  }
+
+  fd_trace_t * trace = (fd_trace_t *)shtrace;
+
+  if( FD_UNLIKELY( trace->magic!=FD_TRACE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return trace;
+}
+
+void *
+fd_trace_leave( fd_trace_t const * trace ) {
+
+  if( FD_UNLIKELY( !trace ) ) {
+    FD_LOG_WARNING(( "NULL trace" ));
+    return NULL;
+  }
+
+  return (void *)trace;
+}
+
+void *
+fd_trace_delete( void * shtrace ) {
+
+  if( FD_UNLIKELY( !shtrace ) ) {
+    FD_LOG_WARNING(( "NULL shtrace" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shtrace, fd_trace_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shtrace" ));
+    return NULL;
+  }
+
+  fd_trace_t * trace = (fd_trace_t *)shtrace;
+
+  if( FD_UNLIKELY( trace->magic!=FD_TRACE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( trace->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return (void *)trace;
+}
+
+ulong
+fd_trace_snap( fd_trace_t const * trace,
+               ulong              cursor0,
+               fd_trace_event_t * out,
+               ulong              out_max,
+               ulong *            _cursor,
+               ulong *            _lost_cnt ) {
+  ulong                    depth = trace->depth;
+  fd_trace_event_t const * ring  = fd_trace_ring_laddr_const( trace );
+
+  ulong cursor1 = fd_trace_cursor( trace );
+  if( FD_UNLIKELY( cursor0>cursor1 ) ) cursor0 = 0UL; /* trace was recreated since the last snap */
+
+  /* Copy the events that are in the ring and fit in out */
+
+  ulong lo = cursor0;
+  if( cursor1>depth   ) lo = fd_ulong_max( lo, cursor1-depth   );
+  if( cursor1>out_max ) lo = fd_ulong_max( lo, cursor1-out_max );
+
+  for( ulong idx=lo; idx<cursor1; idx++ ) out[ idx-lo ] = ring[ idx & (depth-1UL) ];
+
+  /* Events the writer could have been overwriting while they were being
+     copied are not trustworthy.  The writer overwrites event idx-depth
+     while recording event idx.  So when the cursor is cursor2, events
+     before cursor2-depth+1 might have been clobbered. */
+
+  ulong cursor2 = fd_trace_cursor( trace );
+  ulong valid   = lo;
+  if( cursor2>=depth ) valid = fd_ulong_min( fd_ulong_max( valid, cursor2-depth+1UL ), cursor1 );
+
+  ulong cnt = cursor1 - valid;
+  if( FD_UNLIKELY( valid>lo ) ) memmove( out, out + (valid-lo), cnt*sizeof(fd_trace_event_t) );
+
+  *_cursor   = cursor1;
+  *_lost_cnt = valid - cursor0;
+  return cnt;
+}
+
+char const *
+fd_trace_event_cstr( ulong event ) {
+  switch( event ) {
+  case FD_TRACE_EVENT_RX:   return "rx";
+  case FD_TRACE_EVENT_DONE: return "done";
+  case FD_TRACE_EVENT_PUB:  return "pub";
+  case FD_TRACE_EVENT_FILT: return "filt";
+  default: break;
+  }
+  return "unk";
+}
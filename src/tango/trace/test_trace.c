@@ -0,0 +1,152 @@
+#include "../fd_tango.h"
+
+FD_STATIC_ASSERT( FD_TRACE_ALIGN              ==128UL, unit_test );
+FD_STATIC_ASSERT( FD_TRACE_FOOTPRINT( 16UL )  ==640UL, unit_test );
+FD_STATIC_ASSERT( FD_TRACE_DEPTH_MIN          ==16UL,  unit_test );
+FD_STATIC_ASSERT( FD_TRACE_LG_SAMPLE_MAX      ==32UL,  unit_test );
+
+FD_STATIC_ASSERT( FD_TRACE_EVENT_RX  ==0UL, unit_test );
+FD_STATIC_ASSERT( FD_TRACE_EVENT_DONE==1UL, unit_test );
+FD_STATIC_ASSERT( FD_TRACE_EVENT_PUB ==2UL, unit_test );
+FD_STATIC_ASSERT( FD_TRACE_EVENT_FILT==3UL, unit_test );
+FD_STATIC_ASSERT( FD_TRACE_EVENT_CNT ==4UL, unit_test );
+
+#define DEPTH (64UL)
+
+static uchar shmem[ FD_TRACE_FOOTPRINT( DEPTH ) ] __attribute__((aligned(FD_TRACE_ALIGN)));
+
+static fd_trace_event_t out[ 4UL*DEPTH ];
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong tile      = fd_env_strip_cmdline_ulong( &argc, &argv, "--tile",      NULL, 12UL );
+  ulong lg_sample = fd_env_strip_cmdline_ulong( &argc, &argv, "--lg-sample", NULL,  3UL );
+
+  FD_LOG_NOTICE(( "Testing with --tile %lu --lg-sample %lu", tile, lg_sample ));
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  FD_TEST( fd_trace_align()==FD_TRACE_ALIGN );
+  FD_TEST( fd_trace_footprint( DEPTH       )==FD_TRACE_FOOTPRINT( DEPTH ) );
+  FD_TEST( !fd_trace_footprint( 0UL        ) );
+  FD_TEST( !fd_trace_footprint( 8UL        ) );
+  FD_TEST( !fd_trace_footprint( DEPTH+1UL  ) );
+  FD_TEST( !fd_trace_footprint( 1UL<<63    ) );
+
+  FD_TEST( !fd_trace_new( NULL,    DEPTH,     tile,          lg_sample                  ) ); /* null shmem       */
+  FD_TEST( !fd_trace_new( shmem+1, DEPTH,     tile,          lg_sample                  ) ); /* misaligned shmem */
+  FD_TEST( !fd_trace_new( shmem,   DEPTH+1UL, tile,          lg_sample                  ) ); /* bad depth        */
+  FD_TEST( !fd_trace_new( shmem,   DEPTH,     USHORT_MAX+1UL, lg_sample                 ) ); /* bad tile         */
+  FD_TEST( !fd_trace_new( shmem,   DEPTH,     tile,          FD_TRACE_LG_SAMPLE_MAX+1UL ) ); /* bad lg_sample    */
+
+  void *       shtrace = fd_trace_new( shmem, DEPTH, tile, lg_sample ); FD_TEST( shtrace );
+  fd_trace_t * trace   = fd_trace_join( shtrace );                       FD_TEST( trace   );
+
+  FD_TEST( !fd_trace_join( NULL          ) ); /* null shtrace       */
+  FD_TEST( !fd_trace_join( (void *)0x1UL ) ); /* misaligned shtrace */
+
+  ulong * shtrace_magic = (ulong *)shtrace;
+  (*shtrace_magic)++;
+  FD_TEST( !fd_trace_join( shtrace ) ); /* bad magic */
+  (*shtrace_magic)--;
+
+  FD_TEST( fd_trace_depth    ( trace )==DEPTH     );
+  FD_TEST( fd_trace_tile     ( trace )==tile      );
+  FD_TEST( fd_trace_lg_sample( trace )==lg_sample );
+  FD_TEST( fd_trace_cursor   ( trace )==0UL       );
+  FD_TEST( fd_trace_ring_laddr_const( trace )==(fd_trace_event_t const *)fd_trace_ring_laddr( trace ) );
+
+  FD_TEST( !strcmp( fd_trace_event_cstr( FD_TRACE_EVENT_RX   ), "rx"   ) );
+  FD_TEST( !strcmp( fd_trace_event_cstr( FD_TRACE_EVENT_DONE ), "done" ) );
+  FD_TEST( !strcmp( fd_trace_event_cstr( FD_TRACE_EVENT_PUB  ), "pub"  ) );
+  FD_TEST( !strcmp( fd_trace_event_cstr( FD_TRACE_EVENT_FILT ), "filt" ) );
+  FD_TEST( !strcmp( fd_trace_event_cstr( FD_TRACE_EVENT_CNT  ), "unk"  ) );
+
+  /* Test sampling.  Off is never sampled and sampling is deterministic
+     in the key and at about the right rate. */
+
+  ulong iter_cnt   = 1UL<<20;
+  ulong sample_cnt = 0UL;
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    ulong key = fd_rng_ulong( rng );
+    FD_TEST( !fd_trace_sampled( NULL, key ) );
+    int sampled = fd_trace_sampled( trace, key );
+    FD_TEST( sampled==fd_trace_sampled( trace, key ) );
+    sample_cnt += (ulong)sampled;
+  }
+  ulong expected = iter_cnt >> lg_sample;
+  FD_TEST( 4UL*sample_cnt>=3UL*expected && 4UL*sample_cnt<=5UL*expected );
+
+  /* Sequential keys have low entropy in the high bits and lots of it in
+     the low ones, they should still be sampled at about the right rate */
+
+  sample_cnt = 0UL;
+  for( ulong key=0UL; key<iter_cnt; key++ ) sample_cnt += (ulong)fd_trace_sampled( trace, key<<32 );
+  FD_TEST( 4UL*sample_cnt>=3UL*expected && 4UL*sample_cnt<=5UL*expected );
+
+  /* Test record and snap */
+
+  ulong cursor;
+  ulong lost_cnt;
+  FD_TEST( !fd_trace_snap( trace, 0UL, out, 4UL*DEPTH, &cursor, &lost_cnt ) );
+  FD_TEST( cursor==0UL ); FD_TEST( !lost_cnt );
+
+  ulong snap_cursor = 0UL;
+  ulong rec_cnt     = 0UL;
+  for( ulong iter=0UL; iter<100000UL; iter++ ) {
+
+    /* Record a random number of events, possibly more than the ring
+       holds */
+
+    ulong cnt = fd_rng_ulong_roll( rng, 2UL*DEPTH );
+    for( ulong i=0UL; i<cnt; i++ ) {
+      ulong idx = rec_cnt+i;
+      fd_trace_record( trace, idx ^ 0x5555UL, idx & 0xffffUL, idx*3UL, idx % FD_TRACE_EVENT_CNT, (long)(idx*7UL) );
+    }
+    rec_cnt += cnt;
+    FD_TEST( fd_trace_cursor( trace )==rec_cnt );
+
+    ulong out_max = fd_rng_ulong_roll( rng, 4UL*DEPTH+1UL );
+    ulong snap_cnt = fd_trace_snap( trace, snap_cursor, out, out_max, &cursor, &lost_cnt );
+    FD_TEST( cursor==rec_cnt );
+    FD_TEST( snap_cnt<=out_max );
+    FD_TEST( snap_cnt<DEPTH );
+    FD_TEST( lost_cnt+snap_cnt==cnt );
+    if( cnt<=fd_ulong_min( out_max, DEPTH-1UL ) ) FD_TEST( !lost_cnt ); /* No concurrent writer, nothing lost if it fits */
+
+    for( ulong i=0UL; i<snap_cnt; i++ ) {
+      ulong idx = snap_cursor + lost_cnt + i;
+      FD_TEST( out[i].key  ==(idx ^ 0x5555UL)                  );
+      FD_TEST( out[i].seq  ==idx*3UL                           );
+      FD_TEST( out[i].ts   ==(long)(idx*7UL)                   );
+      FD_TEST( out[i].tile ==(ushort)tile                      );
+      FD_TEST( out[i].link ==(ushort)(idx & 0xffffUL)          );
+      FD_TEST( out[i].event==(ushort)(idx % FD_TRACE_EVENT_CNT) );
+    }
+    snap_cursor = cursor;
+  }
+
+  /* Snapping with a cursor from the future (e.g. the trace was
+     recreated) snaps from the beginning */
+
+  FD_TEST( fd_trace_snap( trace, rec_cnt+1UL, out, 4UL*DEPTH, &cursor, &lost_cnt )==DEPTH-1UL );
+  FD_TEST( cursor==rec_cnt ); FD_TEST( lost_cnt==rec_cnt-DEPTH+1UL );
+
+  FD_TEST( fd_trace_leave( NULL  )==NULL    ); /* null trace */
+  FD_TEST( fd_trace_leave( trace )==shtrace );
+
+  FD_TEST( fd_trace_delete( NULL          )==NULL    ); /* null shtrace       */
+  FD_TEST( fd_trace_delete( (void *)0x1UL )==NULL    ); /* misaligned shtrace */
+  FD_TEST( fd_trace_delete( shtrace       )==shtrace );
+  FD_TEST( fd_trace_join  ( shtrace       )==NULL    ); /* deleted */
+  FD_TEST( fd_trace_delete( shtrace       )==NULL    ); /* deleted */
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
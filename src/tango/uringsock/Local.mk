@@ -0,0 +1,7 @@
+ifdef FD_HAS_HOSTED
+$(call add-hdrs,fd_uringsock.h)
+$(call add-objs,fd_uringsock,fd_tango)
+$(call make-unit-test,test_uringsock,test_uringsock,fd_tango fd_util)
+$(call run-unit-test,test_uringsock)
+$(call make-unit-test,bench_uringsock,bench_uringsock,fd_tango fd_util)
+endif
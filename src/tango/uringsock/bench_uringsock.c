@@ -0,0 +1,261 @@
+#include "../../util/fd_util.h"
+#include "fd_uringsock.h"
+#include "../udpsock/fd_udpsock.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include "../../util/net/fd_eth.h"
+#include "../../util/net/fd_ip4.h"
+#include "../../util/net/fd_udp.h"
+
+/* bench_uringsock compares fd_udpsock and fd_uringsock over loopback.
+   A client and an echo server run in the same thread (such that the
+   benchmark also works on hosts with a single core).  For each driver,
+   it measures the cost of an idle service call, the round trip latency
+   of a single packet ping-pong and the throughput of bursts of packets
+   echoed back to the client. */
+
+#define MTU     (1500UL)
+#define PKT_CNT (1024UL)
+
+/* Generic driver interface over the two socket types */
+
+typedef struct {
+  char const * name;
+  void *       sock;
+  void       (*service)( void * sock );
+  fd_aio_t const * tx;
+} drv_t;
+
+static void udpsock_service ( void * sock ) { fd_udpsock_service ( (fd_udpsock_t  *)sock ); }
+static void uringsock_service( void * sock ) { fd_uringsock_service( (fd_uringsock_t *)sock ); }
+
+static int
+new_sock( ushort * port ) {
+  int fd = socket( AF_INET, SOCK_DGRAM, IPPROTO_UDP );
+  if( FD_UNLIKELY( fd<0 ) ) FD_LOG_ERR(( "socket(AF_INET,SOCK_DGRAM,IPPROTO_UDP) failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  int bufsz = 1<<24;
+  setsockopt( fd, SOL_SOCKET, SO_RCVBUF, &bufsz, sizeof(int) );
+  setsockopt( fd, SOL_SOCKET, SO_SNDBUF, &bufsz, sizeof(int) );
+  struct sockaddr_in addr = {
+    .sin_family = AF_INET,
+    .sin_addr   = { .s_addr = FD_IP4_ADDR( 127, 0, 0, 1 ) },
+    .sin_port   = 0,
+  };
+  FD_TEST( !bind( fd, (struct sockaddr const *)fd_type_pun_const( &addr ), sizeof(struct sockaddr_in) ) );
+  socklen_t addrlen = sizeof(struct sockaddr_in);
+  FD_TEST( !getsockname( fd, (struct sockaddr *)fd_type_pun( &addr ), &addrlen ) );
+  *port = fd_ushort_bswap( addr.sin_port );
+  return fd;
+}
+
+static int
+drv_join( drv_t * drv,
+          int     uring,
+          int     fd ) {
+  if( uring ) {
+    ulong footprint = fd_uringsock_footprint( MTU, PKT_CNT, PKT_CNT );
+    fd_uringsock_t * sock = fd_uringsock_join( fd_uringsock_new( aligned_alloc( fd_uringsock_align(), footprint ), MTU, PKT_CNT, PKT_CNT ), fd );
+    if( FD_UNLIKELY( !sock ) ) return 0;
+    *drv = (drv_t){ .name = "uringsock", .sock = sock, .service = uringsock_service, .tx = fd_uringsock_get_tx( sock ) };
+  } else {
+    ulong footprint = fd_udpsock_footprint( MTU, PKT_CNT, PKT_CNT );
+    fd_udpsock_t * sock = fd_udpsock_join( fd_udpsock_new( aligned_alloc( fd_udpsock_align(), footprint ), MTU, PKT_CNT, PKT_CNT ), fd );
+    FD_TEST( sock );
+    *drv = (drv_t){ .name = "udpsock", .sock = sock, .service = udpsock_service, .tx = fd_udpsock_get_tx( sock ) };
+  }
+  return 1;
+}
+
+static void
+drv_leave( drv_t * drv,
+           int     uring ) {
+  if( uring ) free( fd_uringsock_delete( fd_uringsock_leave( (fd_uringsock_t *)drv->sock ) ) );
+  else        free( fd_udpsock_delete  ( fd_udpsock_leave  ( (fd_udpsock_t   *)drv->sock ) ) );
+}
+
+static void
+drv_set_rx( drv_t *          drv,
+            int              uring,
+            fd_aio_t const * aio ) {
+  if( uring ) fd_uringsock_set_rx( (fd_uringsock_t *)drv->sock, aio );
+  else        fd_udpsock_set_rx  ( (fd_udpsock_t   *)drv->sock, aio );
+}
+
+/* The server swaps the addresses and sends the packets back */
+
+static int
+echo_aio_recv( void *                    ctx,
+               fd_aio_pkt_info_t const * batch,
+               ulong                     batch_cnt,
+               ulong *                   opt_batch_idx,
+               int                       flush ) {
+  (void)flush;
+  for( ulong i=0UL; i<batch_cnt; i++ ) {
+    fd_eth_hdr_t * eth_hdr = (fd_eth_hdr_t *)batch[i].buf;
+    fd_ip4_hdr_t * ip4_hdr = (fd_ip4_hdr_t *)(eth_hdr+1);
+    fd_udp_hdr_t * udp_hdr = (fd_udp_hdr_t *)((ulong)ip4_hdr+((ulong)ip4_hdr->ihl<<2));
+    uint           ip4_src = ip4_hdr->saddr;
+    ushort         udp_src = udp_hdr->net_sport;
+    ip4_hdr->saddr     = ip4_hdr->daddr;
+    ip4_hdr->daddr     = ip4_src;
+    udp_hdr->net_sport = udp_hdr->net_dport;
+    udp_hdr->net_dport = udp_src;
+  }
+  fd_aio_t const * out = (fd_aio_t const *)ctx;
+  fd_aio_send( out, batch, batch_cnt, opt_batch_idx, 1 );
+  return FD_AIO_SUCCESS;
+}
+
+/* The client counts the packets echoed back */
+
+static int
+count_aio_recv( void *                    ctx,
+                fd_aio_pkt_info_t const * batch,
+                ulong                     batch_cnt,
+                ulong *                   opt_batch_idx,
+                int                       flush ) {
+  (void)batch; (void)opt_batch_idx; (void)flush;
+  *(ulong *)ctx += batch_cnt;
+  return FD_AIO_SUCCESS;
+}
+
+/* fd_udpsock converts the headers of the packets it sends to host byte
+   order in place, so the client restores the headers of its frames
+   before every send */
+
+static uchar             hdr[ 42UL ];
+static uchar             frame[ PKT_CNT ][ MTU ];
+static fd_aio_pkt_info_t burst[ PKT_CNT ];
+
+static void
+burst_prep( ulong burst_sz ) {
+  for( ulong i=0UL; i<burst_sz; i++ ) fd_memcpy( frame[i], hdr, 42UL );
+}
+
+static void
+bench( int    uring,
+       ulong  payload_sz,
+       ulong  iter_cnt,
+       ulong  burst_sz ) {
+
+  ushort srv_port; int srv_fd = new_sock( &srv_port );
+  ushort cli_port; int cli_fd = new_sock( &cli_port );
+
+  drv_t srv[1];
+  drv_t cli[1];
+  if( FD_UNLIKELY( !drv_join( srv, uring, srv_fd ) ) ) {
+    FD_LOG_WARNING(( "skipping uringsock: io_uring not available" ));
+    close( srv_fd ); close( cli_fd );
+    return;
+  }
+  FD_TEST( drv_join( cli, uring, cli_fd ) );
+
+  ulong rx_cnt = 0UL;
+  fd_aio_t _srv_aio[1]; fd_aio_t * srv_aio = fd_aio_join( fd_aio_new( _srv_aio, (void *)srv->tx, echo_aio_recv  ) );
+  fd_aio_t _cli_aio[1]; fd_aio_t * cli_aio = fd_aio_join( fd_aio_new( _cli_aio, &rx_cnt,         count_aio_recv ) );
+  drv_set_rx( srv, uring, srv_aio );
+  drv_set_rx( cli, uring, cli_aio );
+
+  /* Build the packet the client sends */
+
+  fd_eth_hdr_t * eth = (fd_eth_hdr_t *)hdr;
+  eth->net_type = fd_ushort_bswap( FD_ETH_HDR_TYPE_IP );
+  fd_ip4_hdr_t * ip4 = (fd_ip4_hdr_t *)(eth+1);
+  *ip4 = (fd_ip4_hdr_t) {
+    .ihl         = 5,
+    .version     = 4,
+    .net_tot_len = (ushort)( payload_sz + 28UL ),
+    .ttl         = 64,
+    .protocol    = FD_IP4_HDR_PROTOCOL_UDP,
+    .saddr       = FD_IP4_ADDR( 127, 0, 0, 1 ),
+    .daddr       = FD_IP4_ADDR( 127, 0, 0, 1 )
+  };
+  fd_ip4_hdr_bswap( ip4 );
+  fd_udp_hdr_t * udp = (fd_udp_hdr_t *)(ip4+1);
+  *udp = (fd_udp_hdr_t) {
+    .net_sport = fd_ushort_bswap( cli_port ),
+    .net_dport = fd_ushort_bswap( srv_port ),
+    .net_len   = fd_ushort_bswap( (ushort)( payload_sz + 8UL ) ),
+  };
+  for( ulong i=0UL; i<burst_sz; i++ ) burst[i] = (fd_aio_pkt_info_t){ .buf = frame[i], .buf_sz = (ushort)( 42UL+payload_sz ) };
+
+  /* Idle service cost */
+
+  ulong idle_cnt = 100000UL;
+  long  dt       = -fd_log_wallclock();
+  for( ulong i=0UL; i<idle_cnt; i++ ) cli->service( cli->sock );
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "%-9s: idle service     %8.1f ns", cli->name, (double)dt / (double)idle_cnt ));
+
+  /* Ping-pong latency */
+
+  ulong lost = 0UL;
+  dt = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    ulong want = rx_cnt+1UL;
+    burst_prep( 1UL );
+    fd_aio_send( cli->tx, burst, 1UL, NULL, 1 );
+    long  timeout = fd_log_wallclock() + (long)100e6;
+    while( rx_cnt<want ) {
+      cli->service( cli->sock );
+      srv->service( srv->sock );
+      if( FD_UNLIKELY( fd_log_wallclock()>timeout ) ) { lost++; rx_cnt = want; }
+    }
+  }
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "%-9s: round trip       %8.3f us (%lu B payload, %lu lost)",
+                  cli->name, 1e-3*(double)dt / (double)iter_cnt, payload_sz, lost ));
+
+  /* Burst throughput */
+
+  ulong burst_cnt = fd_ulong_max( iter_cnt / burst_sz, 1UL );
+  ulong sent      = 0UL;
+  rx_cnt = 0UL;
+  dt = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<burst_cnt; iter++ ) {
+    ulong batch_idx = burst_sz;
+    burst_prep( burst_sz );
+    fd_aio_send( cli->tx, burst, burst_sz, &batch_idx, 1 );
+    sent += batch_idx;
+    long  timeout = fd_log_wallclock() + (long)100e6;
+    while( rx_cnt<sent && fd_log_wallclock()<timeout ) {
+      cli->service( cli->sock );
+      srv->service( srv->sock );
+    }
+  }
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "%-9s: burst of %4lu     %8.3f Mpkt/s (%lu of %lu echoed)",
+                  cli->name, burst_sz, 1e3*(double)rx_cnt / (double)dt, rx_cnt, sent ));
+
+  drv_leave( cli, uring );
+  drv_leave( srv, uring );
+  fd_aio_delete( fd_aio_leave( cli_aio ) );
+  fd_aio_delete( fd_aio_leave( srv_aio ) );
+  close( cli_fd );
+  close( srv_fd );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong payload_sz = fd_env_strip_cmdline_ulong( &argc, &argv, "--payload-sz", NULL, 1232UL   );
+  ulong iter_cnt   = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter-cnt",   NULL, 100000UL );
+  ulong burst_sz   = fd_env_strip_cmdline_ulong( &argc, &argv, "--burst-sz",   NULL, 64UL     );
+
+  if( FD_UNLIKELY( payload_sz>MTU-42UL           ) ) FD_LOG_ERR(( "--payload-sz too large" ));
+  if( FD_UNLIKELY( (!burst_sz) | (burst_sz>PKT_CNT) ) ) FD_LOG_ERR(( "--burst-sz out of range" ));
+
+  FD_LOG_NOTICE(( "Benching --payload-sz %lu --iter-cnt %lu --burst-sz %lu", payload_sz, iter_cnt, burst_sz ));
+
+  bench( 0, payload_sz, iter_cnt, burst_sz );
+  bench( 1, payload_sz, iter_cnt, burst_sz );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -0,0 +1,768 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+#include "fd_uringsock.h"
+#include "../../util/net/fd_eth.h"
+#include "../../util/net/fd_ip4.h"
+#include "../../util/net/fd_udp.h"
+
+/* FD_URINGSOCK_FRAME_ALIGN is the alignment of a packet frame */
+
+#define FD_URINGSOCK_FRAME_ALIGN (16UL)
+#define FD_URINGSOCK_HEADROOM    (14UL+20UL+8UL)  /* Ethernet, IPv4, UDP */
+
+/* A multishot recvmsg writes an io_uring_recvmsg_out header and the
+   source address in front of the payload in the provided buffer.  The
+   buffer of a frame starts FD_URINGSOCK_RX_OFF bytes into the frame
+   such that the payload lands right after the headroom and the mock
+   headers can be written over the recvmsg header once it is parsed.
+   A single shot recvmsg writes only the payload into the buffer (and
+   the source address into rx_addr), so its buffers start right after
+   the headroom. */
+
+#define FD_URINGSOCK_RX_OFF (FD_URINGSOCK_HEADROOM - sizeof(struct io_uring_recvmsg_out) - sizeof(struct sockaddr_in))
+
+/* user_data of the requests that are not sends (sends use their slot
+   index) */
+
+#define FD_URINGSOCK_UD_RX     (~0UL)
+#define FD_URINGSOCK_UD_CANCEL (~1UL)
+
+#define FD_URINGSOCK_BGID ((ushort)0)
+
+#define FD_ACQUIRE FD_COMPILER_MFENCE
+#define FD_RELEASE FD_COMPILER_MFENCE
+
+struct __attribute__((aligned(FD_URINGSOCK_ALIGN))) fd_uringsock {
+  fd_aio_t         aio_self;  /* aio provided by uringsock */
+  fd_aio_t const * aio_rx;    /* aio provided by receiver */
+
+  int fd;       /* file descriptor of actual socket */
+  int ring_fd;  /* file descriptor of the io_uring instance, -1 if not joined */
+
+  /* Mock Ethernet fields */
+
+  uchar eth_self_addr[ 6 ];
+  uchar eth_peer_addr[ 6 ];
+
+  /* Mock UDP/IPv4 fields */
+
+  uint   ip_self_addr;   /* network byte order */
+  ushort udp_self_port;  /* little endian */
+
+  ulong  aligned_mtu;
+
+  /* Submission queue (mapped at join) */
+
+  uint *                sq_head;
+  uint *                sq_tail;
+  uint *                sq_array;
+  struct io_uring_sqe * sqes;
+  uint                  sq_mask;
+  uint                  sq_entries;
+  uint                  sq_tail_local; /* Tail including queued but unpublished entries */
+  uint                  sq_pend;       /* Number of published but unsubmitted entries */
+
+  /* Completion queue (mapped at join) */
+
+  uint *                cq_head;
+  uint *                cq_tail;
+  struct io_uring_cqe * cqes;
+  uint                  cq_mask;
+
+  void * sq_map;  ulong sq_map_sz;
+  void * cq_map;  ulong cq_map_sz;
+  void * sqe_map; ulong sqe_map_sz;
+
+  /* Pointers to variable length data structures */
+
+  ulong                      rx_cnt;
+  struct io_uring_buf_ring * rx_ring;      /* provided buffer ring, rx_cnt entries */
+  ushort                     rx_ring_tail;
+  int                        rx_armed;     /* 1 if a recvmsg is in flight */
+  int                        rx_multishot; /* 0 if the kernel does not support multishot recvmsg */
+  struct msghdr              rx_msg;       /* template for the recvmsg */
+  struct sockaddr_in         rx_addr;      /* source address of a single shot recvmsg */
+  void *                     rx_frame;
+  fd_aio_pkt_info_t *        rx_pkt;
+  ushort *                   rx_bid;       /* rx_bid[i] is the buffer id of rx_pkt[i] */
+
+  ulong                tx_cnt;
+  struct msghdr *      tx_msg;
+  struct iovec *       tx_iov;
+  struct sockaddr_in * tx_addr;
+  void *               tx_frame;
+  ulong *              tx_free;      /* stack of free tx slots */
+  ulong                tx_free_cnt;
+
+  /* Variable length data structures follow ...
+
+       struct io_uring_buf   [ rx_cnt ] (rx, page aligned)
+       uchar          [ mtu ][ rx_cnt ] (rx)
+       fd_aio_pkt_info_t     [ rx_cnt ] (rx)
+       ushort                [ rx_cnt ] (rx)
+       struct msghdr         [ tx_cnt ] (tx)
+       struct iovec          [ tx_cnt ] (tx)
+       struct sockaddr_in    [ tx_cnt ] (tx)
+       ulong                 [ tx_cnt ] (tx)
+       uchar          [ mtu ][ tx_cnt ] (tx) */
+};
+
+/* Forward declaration */
+static int
+fd_uringsock_send( void *                    ctx,
+                   fd_aio_pkt_info_t const * batch,
+                   ulong                     batch_cnt,
+                   ulong *                   opt_batch_idx,
+                   int                       flush );
+
+FD_FN_CONST ulong
+fd_uringsock_align( void ) {
+  return FD_URINGSOCK_ALIGN;
+}
+
+FD_FN_CONST ulong
+fd_uringsock_footprint( ulong mtu,
+                        ulong rx_pkt_cnt,
+                        ulong tx_pkt_cnt ) {
+
+  if( FD_UNLIKELY( ( mtu<=FD_URINGSOCK_HEADROOM                  )
+                 | ( mtu> (ulong)USHORT_MAX                      )
+                 | ( !fd_ulong_is_pow2( rx_pkt_cnt )             )
+                 | ( rx_pkt_cnt>FD_URINGSOCK_RX_PKT_CNT_MAX      )
+                 | ( tx_pkt_cnt==0UL                             )
+                 | ( tx_pkt_cnt>FD_URINGSOCK_TX_PKT_CNT_MAX      ) ) )
+    return 0UL;
+
+  ulong aligned_mtu = fd_ulong_align_up( mtu, FD_URINGSOCK_FRAME_ALIGN );
+
+  return
+    FD_LAYOUT_FINI  ( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND(
+    FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND(
+    FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_INIT,
+      alignof( fd_uringsock_t     ),                sizeof( fd_uringsock_t      ) ),
+      FD_URINGSOCK_ALIGN,            rx_pkt_cnt *sizeof( struct io_uring_buf ) ),
+      FD_URINGSOCK_FRAME_ALIGN,      rx_pkt_cnt *aligned_mtu                   ),
+      alignof( fd_aio_pkt_info_t  ), rx_pkt_cnt *sizeof( fd_aio_pkt_info_t   ) ),
+      alignof( ushort             ), rx_pkt_cnt *sizeof( ushort              ) ),
+      alignof( struct msghdr      ), tx_pkt_cnt *sizeof( struct msghdr       ) ),
+      alignof( struct iovec       ), tx_pkt_cnt *sizeof( struct iovec        ) ),
+      alignof( struct sockaddr_in ), tx_pkt_cnt *sizeof( struct sockaddr_in  ) ),
+      alignof( ulong              ), tx_pkt_cnt *sizeof( ulong               ) ),
+      FD_URINGSOCK_FRAME_ALIGN,      tx_pkt_cnt *aligned_mtu                   ),
+      FD_URINGSOCK_ALIGN );
+}
+
+void *
+fd_uringsock_new( void * shmem,
+                  ulong  mtu,
+                  ulong  rx_pkt_cnt,
+                  ulong  tx_pkt_cnt ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  ulong laddr = (ulong)shmem;
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( laddr, fd_uringsock_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+  ulong footprint = fd_uringsock_footprint( mtu, rx_pkt_cnt, tx_pkt_cnt );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "invalid footprint for config" ));
+    return NULL;
+  }
+
+  /* Allocate main struct */
+
+  fd_uringsock_t * sock = (fd_uringsock_t *)laddr;
+  memset( sock, 0, sizeof(fd_uringsock_t) );
+  sock->fd           = -1;
+  sock->ring_fd      = -1;
+  sock->rx_cnt       = rx_pkt_cnt;
+  sock->tx_cnt       = tx_pkt_cnt;
+  sock->rx_multishot = 1;
+  laddr += sizeof(fd_uringsock_t);
+
+  ulong aligned_mtu = fd_ulong_align_up( mtu, FD_URINGSOCK_FRAME_ALIGN );
+  sock->aligned_mtu = aligned_mtu;
+
+  /* Set defaults for mock network headers */
+
+  memcpy( sock->eth_self_addr, (uchar[6]){0x00, 0x00, 0x5e, 0x00, 0x53, 0x42}, 6 );
+  memcpy( sock->eth_peer_addr, (uchar[6]){0x00, 0x00, 0x5e, 0x00, 0x53, 0x43}, 6 );
+
+  sock->ip_self_addr  = FD_IP4_ADDR( 0, 0, 0, 0 );
+  sock->udp_self_port = 0;
+
+  sock->aio_self = (fd_aio_t){
+    .ctx       = sock,
+    .send_func = fd_uringsock_send
+  };
+
+  /* Allocate variable-length data structures */
+
+  laddr  = fd_ulong_align_up( laddr, FD_URINGSOCK_ALIGN );
+  sock->rx_ring = (struct io_uring_buf_ring *)laddr;
+  laddr += rx_pkt_cnt*sizeof(struct io_uring_buf);
+
+  laddr  = fd_ulong_align_up( laddr, FD_URINGSOCK_FRAME_ALIGN );
+  sock->rx_frame = (void *)laddr;
+  laddr += rx_pkt_cnt*aligned_mtu;
+
+  laddr  = fd_ulong_align_up( laddr, alignof(fd_aio_pkt_info_t) );
+  sock->rx_pkt = (fd_aio_pkt_info_t *)laddr;
+  laddr += rx_pkt_cnt*sizeof(fd_aio_pkt_info_t);
+
+  laddr  = fd_ulong_align_up( laddr, alignof(ushort) );
+  sock->rx_bid = (ushort *)laddr;
+  laddr += rx_pkt_cnt*sizeof(ushort);
+
+  laddr  = fd_ulong_align_up( laddr, alignof(struct msghdr) );
+  sock->tx_msg = (struct msghdr *)laddr;
+  laddr += tx_pkt_cnt*sizeof(struct msghdr);
+
+  laddr  = fd_ulong_align_up( laddr, alignof(struct iovec) );
+  sock->tx_iov = (struct iovec *)laddr;
+  laddr += tx_pkt_cnt*sizeof(struct iovec);
+
+  laddr  = fd_ulong_align_up( laddr, alignof(struct sockaddr_in) );
+  sock->tx_addr = (struct sockaddr_in *)laddr;
+  laddr += tx_pkt_cnt*sizeof(struct sockaddr_in);
+
+  laddr  = fd_ulong_align_up( laddr, alignof(ulong) );
+  sock->tx_free = (ulong *)laddr;
+  laddr += tx_pkt_cnt*sizeof(ulong);
+
+  laddr  = fd_ulong_align_up( laddr, FD_URINGSOCK_FRAME_ALIGN );
+  sock->tx_frame = (void *)laddr;
+  laddr += tx_pkt_cnt*aligned_mtu;
+
+  /* Prepare the rx msghdr template and the tx msghdrs.  The recvmsg
+     reads the msghdr only for the sizes of the name and control. */
+
+  sock->rx_msg.msg_namelen    = sizeof(struct sockaddr_in);
+  sock->rx_msg.msg_controllen = 0UL;
+
+  for( ulong i=0UL; i<tx_pkt_cnt; i++ ) {
+    sock->tx_iov[i].iov_base       = (void *)( (ulong)sock->tx_frame + i*aligned_mtu );
+    sock->tx_iov[i].iov_len        = 0UL;
+    sock->tx_addr[i].sin_family    = AF_INET;
+    sock->tx_msg[i].msg_iov        = &sock->tx_iov[i];
+    sock->tx_msg[i].msg_iovlen     = 1;
+    sock->tx_msg[i].msg_name       = &sock->tx_addr[i];
+    sock->tx_msg[i].msg_namelen    = sizeof(struct sockaddr_in);
+    sock->tx_free[i]               = tx_pkt_cnt-1UL-i;
+  }
+  sock->tx_free_cnt = tx_pkt_cnt;
+
+  return shmem;
+}
+
+/* fd_uringsock_sqe returns the next free submission queue entry,
+   zeroed, or NULL if the submission queue is full.  The entry is queued
+   by fd_uringsock_sqe_publish. */
+
+static struct io_uring_sqe *
+fd_uringsock_sqe( fd_uringsock_t * sock ) {
+  uint head = FD_VOLATILE_CONST( *sock->sq_head );
+  FD_ACQUIRE();
+  if( FD_UNLIKELY( (uint)(sock->sq_tail_local-head)>=sock->sq_entries ) ) return NULL;
+  struct io_uring_sqe * sqe = sock->sqes + (sock->sq_tail_local & sock->sq_mask);
+  memset( sqe, 0, sizeof(struct io_uring_sqe) );
+  return sqe;
+}
+
+static void
+fd_uringsock_sqe_publish( fd_uringsock_t * sock ) {
+  sock->sq_tail_local++;
+  sock->sq_pend++;
+  FD_RELEASE();
+  FD_VOLATILE( *sock->sq_tail ) = sock->sq_tail_local;
+}
+
+/* fd_uringsock_submit submits the queued entries to the kernel.  If
+   wait is non-zero, also waits for at least one completion. */
+
+static void
+fd_uringsock_submit( fd_uringsock_t * sock,
+                     int              wait ) {
+  if( FD_LIKELY( !sock->sq_pend && !wait ) ) return;
+  long res = syscall( __NR_io_uring_enter, sock->ring_fd, sock->sq_pend, wait ? 1U : 0U,
+                      wait ? IORING_ENTER_GETEVENTS : 0U, NULL, 0UL );
+  if( FD_UNLIKELY( res<0L ) ) {
+    if( FD_LIKELY( (errno==EAGAIN) | (errno==EBUSY) | (errno==EINTR) ) ) return; /* retry next time */
+    FD_LOG_WARNING(( "io_uring_enter(%d) failed (%i-%s)", sock->ring_fd, errno, fd_io_strerror( errno ) ));
+    return;
+  }
+  sock->sq_pend -= (uint)res;
+}
+
+static void
+fd_uringsock_rx_arm( fd_uringsock_t * sock ) {
+  struct io_uring_sqe * sqe = fd_uringsock_sqe( sock );
+  if( FD_UNLIKELY( !sqe ) ) return; /* retry next service */
+  sqe->opcode    = IORING_OP_RECVMSG;
+  sqe->fd        = sock->fd;
+  sqe->addr      = (ulong)&sock->rx_msg;
+  sqe->len       = 1U;
+  sqe->flags     = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = FD_URINGSOCK_BGID;
+  sqe->ioprio    = sock->rx_multishot ? (ushort)IORING_RECV_MULTISHOT : (ushort)0;
+  sqe->user_data = FD_URINGSOCK_UD_RX;
+  sock->rx_msg.msg_namelen = sizeof(struct sockaddr_in);
+  sock->rx_msg.msg_flags   = 0;
+  fd_uringsock_sqe_publish( sock );
+  sock->rx_armed = 1;
+}
+
+/* fd_uringsock_rx_buf points buf at the rx buffer of frame bid for
+   the current receive mode. */
+
+static inline void
+fd_uringsock_rx_buf( fd_uringsock_t *      sock,
+                     struct io_uring_buf * buf,
+                     ushort                bid ) {
+  ulong off = sock->rx_multishot ? FD_URINGSOCK_RX_OFF : FD_URINGSOCK_HEADROOM;
+  buf->addr = (ulong)sock->rx_frame + (ulong)bid*sock->aligned_mtu + off;
+  buf->len  = (uint)(sock->aligned_mtu - off);
+  buf->bid  = bid;
+}
+
+/* fd_uringsock_rx_give provides buffer bid back to the kernel.  The
+   ring tail is published by fd_uringsock_rx_give_publish. */
+
+static inline void
+fd_uringsock_rx_give( fd_uringsock_t * sock,
+                      ushort           bid ) {
+  fd_uringsock_rx_buf( sock, &sock->rx_ring->bufs[ sock->rx_ring_tail & (sock->rx_cnt-1UL) ], bid );
+  sock->rx_ring_tail++;
+}
+
+static inline void
+fd_uringsock_rx_give_publish( fd_uringsock_t * sock ) {
+  FD_RELEASE();
+  FD_VOLATILE( sock->rx_ring->tail ) = sock->rx_ring_tail;
+}
+
+/* fd_uringsock_rx_single_shot switches the uringsock to single shot
+   recvmsg.  Must not be called while a recvmsg is armed.  The buffers
+   provided to the kernel are moved to the single shot offset in place,
+   entries of the ring that the kernel already consumed are rewritten
+   harmlessly as they get overwritten when their buffer is given back. */
+
+static void
+fd_uringsock_rx_single_shot( fd_uringsock_t * sock ) {
+  sock->rx_multishot = 0;
+  for( ulong i=0UL; i<sock->rx_cnt; i++ ) {
+    struct io_uring_buf * buf = &sock->rx_ring->bufs[ i ];
+    fd_uringsock_rx_buf( sock, buf, buf->bid );
+  }
+  FD_RELEASE();
+}
+
+static void
+fd_uringsock_unmap( fd_uringsock_t * sock ) {
+  if( sock->sqe_map                        ) munmap( sock->sqe_map, sock->sqe_map_sz );
+  if( sock->cq_map && sock->cq_map!=sock->sq_map ) munmap( sock->cq_map, sock->cq_map_sz );
+  if( sock->sq_map                         ) munmap( sock->sq_map, sock->sq_map_sz );
+  sock->sqe_map = NULL;
+  sock->cq_map  = NULL;
+  sock->sq_map  = NULL;
+  if( sock->ring_fd>=0 ) close( sock->ring_fd );
+  sock->ring_fd = -1;
+}
+
+fd_uringsock_t *
+fd_uringsock_join( void * shsock,
+                   int    fd ) {
+
+  if( FD_UNLIKELY( !shsock ) ) {
+    FD_LOG_WARNING(( "NULL shsock" ));
+    return NULL;
+  }
+
+  fd_uringsock_t * sock = (fd_uringsock_t *)shsock;
+
+  /* Extract socket address */
+  struct sockaddr addr;
+  socklen_t addrlen = sizeof(addr);
+  int res = getsockname( fd, &addr, &addrlen );
+  if( FD_UNLIKELY( res < 0 ) ) {
+    FD_LOG_WARNING(( "getsockname(%d) failed (%i-%s)", fd, errno, fd_io_strerror( errno ) ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( addr.sa_family != AF_INET ) ) {
+    FD_LOG_WARNING(( "getsockname(%d) returned non-IPv4 address", fd ));
+    return NULL;
+  }
+  struct sockaddr_in const * sin = (struct sockaddr_in const *)fd_type_pun_const( &addr );
+  sock->fd            = fd;
+  sock->ip_self_addr  = sin->sin_addr.s_addr;
+  sock->udp_self_port = fd_ushort_bswap( sin->sin_port );
+
+  /* Create the io_uring.  The submission queue has room for every send
+     plus the recvmsg and its cancel.  The completion queue has room for
+     a completion for every buffer and every send such that it can't
+     overflow between services. */
+
+  ulong sq_entries = fd_ulong_pow2_up( sock->tx_cnt + 2UL );
+  ulong cq_entries = fd_ulong_pow2_up( sock->rx_cnt + sock->tx_cnt + 2UL );
+
+  struct io_uring_params params;
+  memset( &params, 0, sizeof(params) );
+  params.flags      = IORING_SETUP_CQSIZE;
+  params.cq_entries = (uint)cq_entries;
+  int ring_fd = (int)syscall( __NR_io_uring_setup, (uint)sq_entries, &params );
+  if( FD_UNLIKELY( ring_fd<0 ) ) {
+    FD_LOG_WARNING(( "io_uring_setup(%lu) failed (%i-%s)", sq_entries, errno, fd_io_strerror( errno ) ));
+    return NULL;
+  }
+  sock->ring_fd = ring_fd;
+
+  sock->sq_map_sz  = params.sq_off.array + params.sq_entries*sizeof(uint);
+  sock->cq_map_sz  = params.cq_off.cqes  + params.cq_entries*sizeof(struct io_uring_cqe);
+  sock->sqe_map_sz = params.sq_entries*sizeof(struct io_uring_sqe);
+  int single_mmap  = !!(params.features & IORING_FEAT_SINGLE_MMAP);
+  if( single_mmap ) sock->sq_map_sz = sock->cq_map_sz = fd_ulong_max( sock->sq_map_sz, sock->cq_map_sz );
+
+  void * sq_map = mmap( NULL, sock->sq_map_sz, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, ring_fd, (long)IORING_OFF_SQ_RING );
+  if( FD_UNLIKELY( sq_map==MAP_FAILED ) ) {
+    FD_LOG_WARNING(( "mmap(IORING_OFF_SQ_RING) failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+    fd_uringsock_unmap( sock );
+    return NULL;
+  }
+  sock->sq_map = sq_map;
+
+  void * cq_map = sq_map;
+  if( !single_mmap ) {
+    cq_map = mmap( NULL, sock->cq_map_sz, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, ring_fd, (long)IORING_OFF_CQ_RING );
+    if( FD_UNLIKELY( cq_map==MAP_FAILED ) ) {
+      FD_LOG_WARNING(( "mmap(IORING_OFF_CQ_RING) failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+      fd_uringsock_unmap( sock );
+      return NULL;
+    }
+  }
+  sock->cq_map = cq_map;
+
+  void * sqe_map = mmap( NULL, sock->sqe_map_sz, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, ring_fd, (long)IORING_OFF_SQES );
+  if( FD_UNLIKELY( sqe_map==MAP_FAILED ) ) {
+    FD_LOG_WARNING(( "mmap(IORING_OFF_SQES) failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+    fd_uringsock_unmap( sock );
+    return NULL;
+  }
+  sock->sqe_map = sqe_map;
+
+  sock->sq_head       = (uint *)( (ulong)sq_map + params.sq_off.head  );
+  sock->sq_tail       = (uint *)( (ulong)sq_map + params.sq_off.tail  );
+  sock->sq_array      = (uint *)( (ulong)sq_map + params.sq_off.array );
+  sock->sq_mask       = FD_VOLATILE_CONST( *(uint *)( (ulong)sq_map + params.sq_off.ring_mask ) );
+  sock->sq_entries    = params.sq_entries;
+  sock->sq_tail_local = FD_VOLATILE_CONST( *sock->sq_tail );
+  sock->sq_pend       = 0U;
+  sock->sqes          = (struct io_uring_sqe *)sqe_map;
+
+  sock->cq_head = (uint *)( (ulong)cq_map + params.cq_off.head );
+  sock->cq_tail = (uint *)( (ulong)cq_map + params.cq_off.tail );
+  sock->cq_mask = FD_VOLATILE_CONST( *(uint *)( (ulong)cq_map + params.cq_off.ring_mask ) );
+  sock->cqes    = (struct io_uring_cqe *)( (ulong)cq_map + params.cq_off.cqes );
+
+  /* Entries are always queued in submission order */
+
+  for( uint i=0U; i<params.sq_entries; i++ ) sock->sq_array[ i ] = i;
+
+  /* Provide all the rx buffers to the kernel */
+
+  memset( sock->rx_ring, 0, sock->rx_cnt*sizeof(struct io_uring_buf) );
+  struct io_uring_buf_reg reg;
+  memset( &reg, 0, sizeof(reg) );
+  reg.ring_addr    = (ulong)sock->rx_ring;
+  reg.ring_entries = (uint)sock->rx_cnt;
+  reg.bgid         = FD_URINGSOCK_BGID;
+  if( FD_UNLIKELY( syscall( __NR_io_uring_register, ring_fd, IORING_REGISTER_PBUF_RING, &reg, 1U )<0L ) ) {
+    FD_LOG_WARNING(( "io_uring_register(IORING_REGISTER_PBUF_RING) failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+    fd_uringsock_unmap( sock );
+    return NULL;
+  }
+
+  sock->rx_ring_tail = 0;
+  for( ulong i=0UL; i<sock->rx_cnt; i++ ) fd_uringsock_rx_give( sock, (ushort)i );
+  fd_uringsock_rx_give_publish( sock );
+
+  sock->rx_msg.msg_name = &sock->rx_addr;
+  sock->rx_armed        = 0;
+  fd_uringsock_rx_arm( sock );
+  fd_uringsock_submit( sock, 0 );
+
+  return sock;
+}
+
+/* fd_uringsock_reap handles all the completions in the completion
+   queue.  Received packets are dispatched to the receiver if dispatch
+   is non-zero and dropped otherwise.  Returns the number of
+   completions reaped. */
+
+static ulong
+fd_uringsock_reap( fd_uringsock_t * sock,
+                   int              dispatch ) {
+
+  uint head = *sock->cq_head;
+  uint tail = FD_VOLATILE_CONST( *sock->cq_tail );
+  FD_ACQUIRE();
+  if( FD_LIKELY( head==tail ) ) return 0UL;
+
+  ulong rx_cnt = 0UL;
+  for( uint idx=head; idx!=tail; idx++ ) {
+    struct io_uring_cqe const * cqe = sock->cqes + (idx & sock->cq_mask);
+    ulong ud    = cqe->user_data;
+    int   res   = cqe->res;
+    uint  flags = cqe->flags;
+
+    if( FD_LIKELY( ud<sock->tx_cnt ) ) { /* send completion */
+      if( FD_UNLIKELY( res<0 ) ) FD_LOG_DEBUG(( "sendmsg failed (%i-%s)", -res, fd_io_strerror( -res ) ));
+      sock->tx_free[ sock->tx_free_cnt++ ] = ud;
+      continue;
+    }
+
+    if( FD_UNLIKELY( ud!=FD_URINGSOCK_UD_RX ) ) continue; /* cancel completion */
+
+    if( FD_UNLIKELY( !(flags & IORING_CQE_F_MORE) ) ) sock->rx_armed = 0; /* recvmsg terminated, rearm below */
+
+    if( FD_UNLIKELY( res<0 ) ) {
+      if( FD_UNLIKELY( res==-EINVAL && sock->rx_multishot ) ) {
+        FD_LOG_WARNING(( "multishot recvmsg not supported, falling back to single shot" ));
+        fd_uringsock_rx_single_shot( sock );
+      } else if( FD_UNLIKELY( (res!=-ENOBUFS) & (res!=-ECANCELED) ) ) {
+        FD_LOG_WARNING(( "recvmsg(%d) failed (%i-%s)", sock->fd, -res, fd_io_strerror( -res ) ));
+      }
+      continue;
+    }
+
+    if( FD_UNLIKELY( !(flags & IORING_CQE_F_BUFFER) ) ) continue;
+    ushort bid  = (ushort)(flags >> IORING_CQE_BUFFER_SHIFT);
+    uchar * frame_base = (uchar *)sock->rx_frame + (ulong)bid*sock->aligned_mtu;
+
+    ulong              payload_sz;
+    int                trunc;
+    ulong              namelen;
+    struct sockaddr_in addr;
+    if( FD_LIKELY( sock->rx_multishot ) ) {
+      struct io_uring_recvmsg_out const * out = (struct io_uring_recvmsg_out const *)( frame_base + FD_URINGSOCK_RX_OFF );
+      payload_sz = (ulong)out->payloadlen;
+      trunc      = !!(out->flags & MSG_TRUNC);
+      namelen    = (ulong)out->namelen;
+      addr       = *(struct sockaddr_in const *)( out+1 );
+    } else {
+      /* Only one single shot recvmsg is in flight, so rx_msg and
+         rx_addr belong to this completion */
+      payload_sz = (ulong)(uint)res;
+      trunc      = !!(sock->rx_msg.msg_flags & MSG_TRUNC);
+      namelen    = (ulong)sock->rx_msg.msg_namelen;
+      addr       = sock->rx_addr;
+    }
+    if( FD_UNLIKELY( (!dispatch) | trunc | (namelen<sizeof(struct sockaddr_in))
+                   | (payload_sz>sock->aligned_mtu-FD_URINGSOCK_HEADROOM) ) ) {
+      fd_uringsock_rx_give( sock, bid ); /* drop */
+      continue;
+    }
+
+    /* Create fake headers over the recvmsg header */
+
+    fd_eth_hdr_t * eth = (fd_eth_hdr_t *)frame_base;
+    memcpy( eth->dst, sock->eth_self_addr, 6 );
+    memcpy( eth->src, sock->eth_peer_addr, 6 );
+    eth->net_type = fd_ushort_bswap( FD_ETH_HDR_TYPE_IP );
+
+    fd_ip4_hdr_t * ip4 = (fd_ip4_hdr_t *)((ulong)eth + sizeof(fd_eth_hdr_t));
+    *ip4 = (fd_ip4_hdr_t) {
+      .ihl          = 5,
+      .version      = 4,
+      .tos          = 0,
+      .net_tot_len  = (ushort)( payload_sz
+                      + sizeof(fd_ip4_hdr_t)
+                      + sizeof(fd_udp_hdr_t) ),
+      .net_id       = 0,
+      .net_frag_off = 0,
+      .ttl          = 64,
+      .protocol     = FD_IP4_HDR_PROTOCOL_UDP,
+      .check        = 0,
+      .saddr        = addr.sin_addr.s_addr,
+      .daddr        = sock->ip_self_addr
+    };
+    fd_ip4_hdr_bswap( ip4 );  /* convert to "network" byte order */
+    ip4->check = fd_ip4_hdr_check_fast( ip4 );
+
+    /* Create UDP header with network byte order */
+    fd_udp_hdr_t * udp = (fd_udp_hdr_t *)((ulong)ip4 + sizeof(fd_ip4_hdr_t));
+    *udp = (fd_udp_hdr_t) {
+      .net_sport = (ushort)addr.sin_port,
+      .net_dport = (ushort)fd_ushort_bswap( sock->udp_self_port ),
+      .net_len   = (ushort)fd_ushort_bswap( (ushort)( payload_sz + sizeof(fd_udp_hdr_t) ) ),
+      .check     = 0
+    };
+
+    sock->rx_pkt[ rx_cnt ] = (fd_aio_pkt_info_t) {
+      .buf    = frame_base,
+      .buf_sz = (ushort)( FD_URINGSOCK_HEADROOM + payload_sz )
+    };
+    sock->rx_bid[ rx_cnt ] = bid;
+    rx_cnt++;
+  }
+
+  /* Free the completion queue entries before dispatching such that
+     sends made by the receiver can complete */
+
+  FD_RELEASE();
+  FD_VOLATILE( *sock->cq_head ) = tail;
+
+  /* Dispatch to recipient ignoring errors and give the buffers back */
+
+  if( FD_LIKELY( rx_cnt ) ) fd_aio_send( sock->aio_rx, sock->rx_pkt, rx_cnt, NULL, 0 );
+  for( ulong i=0UL; i<rx_cnt; i++ ) fd_uringsock_rx_give( sock, sock->rx_bid[ i ] );
+  fd_uringsock_rx_give_publish( sock );
+
+  return (ulong)(uint)(tail-head);
+}
+
+void *
+fd_uringsock_leave( fd_uringsock_t * sock ) {
+  if( FD_UNLIKELY( !sock ) ) {
+    FD_LOG_WARNING(( "NULL sock" ));
+    return NULL;
+  }
+
+  if( FD_LIKELY( sock->ring_fd>=0 ) ) {
+
+    /* Cancel the recvmsg and wait for in flight sends such that the
+       kernel is done with the memory of the uringsock */
+
+    if( sock->rx_armed ) {
+      struct io_uring_sqe * sqe = fd_uringsock_sqe( sock );
+      if( FD_LIKELY( sqe ) ) {
+        sqe->opcode    = IORING_OP_ASYNC_CANCEL;
+        sqe->addr      = FD_URINGSOCK_UD_RX;
+        sqe->user_data = FD_URINGSOCK_UD_CANCEL;
+        fd_uringsock_sqe_publish( sock );
+      }
+    }
+    for( ulong iter=0UL; (sock->rx_armed | (sock->tx_free_cnt<sock->tx_cnt)) && iter<1024UL; iter++ ) {
+      fd_uringsock_submit( sock, 1 );
+      fd_uringsock_reap( sock, 0 );
+    }
+    if( FD_UNLIKELY( sock->rx_armed | (sock->tx_free_cnt<sock->tx_cnt) ) )
+      FD_LOG_WARNING(( "requests still in flight at leave" ));
+
+    fd_uringsock_unmap( sock );
+  }
+
+  sock->fd = -1;
+  return (void *)sock;
+}
+
+void *
+fd_uringsock_delete( void * shsock ) {
+  if( FD_UNLIKELY( !shsock ) ) {
+    FD_LOG_WARNING(( "NULL shsock" ));
+    return NULL;
+  }
+  return shsock;
+}
+
+void
+fd_uringsock_set_rx( fd_uringsock_t * sock,
+                     fd_aio_t const * aio ) {
+  sock->aio_rx = aio;
+}
+
+FD_FN_CONST fd_aio_t const *
+fd_uringsock_get_tx( fd_uringsock_t * sock ) {
+  return &sock->aio_self;
+}
+
+void
+fd_uringsock_service( fd_uringsock_t * sock ) {
+  fd_uringsock_reap( sock, 1 );
+  if( FD_UNLIKELY( !sock->rx_armed ) ) fd_uringsock_rx_arm( sock );
+  fd_uringsock_submit( sock, 0 );
+}
+
+static int
+fd_uringsock_send( void *                    ctx,
+                   fd_aio_pkt_info_t const * batch,
+                   ulong                     batch_cnt,
+                   ulong *                   opt_batch_idx,
+                   int                       flush ) {
+
+  fd_uringsock_t * sock = (fd_uringsock_t *)ctx;
+
+  if( FD_UNLIKELY( batch_cnt == 0 ) ) {
+    if( flush ) fd_uringsock_submit( sock, 0 );
+    return FD_AIO_SUCCESS;
+  }
+
+  ulong _dummy_batch_idx;
+  opt_batch_idx = opt_batch_idx ? opt_batch_idx : &_dummy_batch_idx;
+
+  ulong payload_max = sock->aligned_mtu - FD_URINGSOCK_HEADROOM;
+
+  ulong batch_idx;
+  for( batch_idx=0UL; batch_idx<batch_cnt; batch_idx++ ) {
+    uchar const * buf    = (uchar const *)batch[ batch_idx ].buf;
+    ulong         buf_sz = (ulong)batch[ batch_idx ].buf_sz;
+
+    /* Parse the headers without modifying the caller's packet, drop
+       packets that are malformed or too large */
+
+    if( FD_UNLIKELY( buf_sz<sizeof(fd_eth_hdr_t)+sizeof(fd_ip4_hdr_t) ) ) continue;
+    fd_ip4_hdr_t const * ip4 = (fd_ip4_hdr_t const *)( buf + sizeof(fd_eth_hdr_t) );
+    ulong udp_off = sizeof(fd_eth_hdr_t) + (ulong)ip4->ihl*4UL;
+    if( FD_UNLIKELY( buf_sz<udp_off+sizeof(fd_udp_hdr_t) ) ) continue;
+    fd_udp_hdr_t const * udp = (fd_udp_hdr_t const *)( buf + udp_off );
+    ulong payload_off = udp_off + sizeof(fd_udp_hdr_t);
+    ulong payload_sz  = buf_sz - payload_off;
+    if( FD_UNLIKELY( payload_sz>payload_max ) ) continue;
+
+    if( FD_UNLIKELY( !sock->tx_free_cnt ) ) break;
+    struct io_uring_sqe * sqe = fd_uringsock_sqe( sock );
+    if( FD_UNLIKELY( !sqe ) ) break;
+    ulong slot = sock->tx_free[ --sock->tx_free_cnt ];
+
+    fd_memcpy( sock->tx_iov[ slot ].iov_base, buf + payload_off, payload_sz );
+    sock->tx_iov [ slot ].iov_len         = payload_sz;
+    sock->tx_addr[ slot ].sin_addr.s_addr = ip4->daddr; /* already network byte order */
+    sock->tx_addr[ slot ].sin_port        = udp->net_dport;
+
+    sqe->opcode    = IORING_OP_SENDMSG;
+    sqe->fd        = sock->fd;
+    sqe->addr      = (ulong)&sock->tx_msg[ slot ];
+    sqe->len       = 1U;
+    sqe->user_data = slot;
+    fd_uringsock_sqe_publish( sock );
+  }
+
+  if( flush | (batch_idx<batch_cnt) ) fd_uringsock_submit( sock, 0 );
+
+  if( FD_UNLIKELY( batch_idx<batch_cnt ) ) {
+    *opt_batch_idx = batch_idx;
+    return FD_AIO_ERR_AGAIN;
+  }
+  return FD_AIO_SUCCESS;
+}
+
+uint
+fd_uringsock_get_ip4_address( fd_uringsock_t const * sock ) {
+  return sock->ip_self_addr;
+}
+
+uint
+fd_uringsock_get_listen_port( fd_uringsock_t const * sock ) {
+  return sock->udp_self_port;
+}
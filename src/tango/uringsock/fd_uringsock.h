@@ -0,0 +1,114 @@
+#ifndef HEADER_fd_src_tango_uringsock_fd_uringsock_h
+#define HEADER_fd_src_tango_uringsock_fd_uringsock_h
+
+#include "../fd_tango_base.h"
+#include "../aio/fd_aio.h"
+
+/* fd_uringsock is an unprivileged io_uring-based driver for UDP apps.
+   It is a drop-in replacement for fd_udpsock (same API, same mock
+   Ethernet & IP headers, same fd_aio semantics) for hosts where AF_XDP
+   is not available (e.g. virtual NICs with unsupported drivers).
+
+   Unlike fd_udpsock, which makes a recvmmsg syscall on every service
+   call (even when idle) and a sendmmsg syscall per tx batch,
+   fd_uringsock keeps a multishot recvmsg armed on the socket that
+   receives into a ring of buffers provided to the kernel up front, and
+   reaps completions from shared memory.  Idle service calls do not make
+   any syscalls.  Sends are queued as submission queue entries and
+   submitted in batches, once per service call or when the sender
+   flushes.
+
+   Since an fd_aio receiver only lends its packets for the duration of
+   the call, sends are copied into buffers owned by the uringsock which
+   are recycled when the kernel completes them.  Like fd_udpsock, only
+   supports single-threaded operation.
+
+   Requires provided buffer rings (Linux 5.19 or newer).  Multishot
+   recvmsg needs Linux 6.0 or newer, on 5.19 the uringsock falls back to
+   a single shot recvmsg that is re-armed for each packet. */
+
+#define FD_URINGSOCK_ALIGN (4096UL) /* The provided buffer ring must be page aligned */
+
+/* FD_URINGSOCK_RX_PKT_CNT_MAX is the max rx_pkt_cnt of a uringsock, the
+   max number of buffers in a provided buffer ring.  FD_URINGSOCK_TX_PKT_CNT_MAX
+   is the max tx_pkt_cnt, bounded by the size of the submission queue. */
+
+#define FD_URINGSOCK_RX_PKT_CNT_MAX (32768UL)
+#define FD_URINGSOCK_TX_PKT_CNT_MAX (16383UL)
+
+struct fd_uringsock;
+typedef struct fd_uringsock fd_uringsock_t;
+
+FD_PROTOTYPES_BEGIN
+
+FD_FN_CONST ulong
+fd_uringsock_align( void );
+
+/* fd_uringsock_footprint returns the footprint of a uringsock that can
+   receive frames of up to mtu bytes (including the mock headers) into
+   rx_pkt_cnt buffers and have up to tx_pkt_cnt sends in flight.
+   rx_pkt_cnt must be an integer power of 2 of at most
+   FD_URINGSOCK_RX_PKT_CNT_MAX and tx_pkt_cnt must be positive and at
+   most FD_URINGSOCK_TX_PKT_CNT_MAX.  Returns 0 for invalid params. */
+
+FD_FN_CONST ulong
+fd_uringsock_footprint( ulong mtu,
+                        ulong rx_pkt_cnt,
+                        ulong tx_pkt_cnt );
+
+/* fd_uringsock_new prepares a new memory region with matching alignment
+   and footprint for storing an fd_uringsock_t object.  Returns shmem on
+   success and NULL on failure.  The caller is not joined on return. */
+
+void *
+fd_uringsock_new( void * shmem,
+                  ulong  mtu,
+                  ulong  rx_pkt_cnt,
+                  ulong  tx_pkt_cnt );
+
+/* fd_uringsock_join joins the caller to the given initialized memory
+   region using the given bound UDP socket file descriptor.  This creates
+   the io_uring instance of the join (a uringsock is process local, the
+   join is not shareable) and arms the receive.  Returns NULL on failure
+   (logs details), e.g. if the kernel does not support io_uring. */
+
+fd_uringsock_t *
+fd_uringsock_join( void * shsock,
+                   int    fd );
+
+/* fd_uringsock_leave undoes a local join to the fd_uringsock_t object.
+   Cancels the receive and waits for in flight sends to complete before
+   destroying the io_uring instance.  Packets received but not yet
+   serviced are dropped.  Does not close the socket. */
+
+void *
+fd_uringsock_leave( fd_uringsock_t * sock );
+
+/* fd_uringsock_delete releases ownership a memory region back to the
+   caller. */
+
+void *
+fd_uringsock_delete( void * shsock );
+
+void
+fd_uringsock_set_rx( fd_uringsock_t * sock,
+                     fd_aio_t const * aio );
+
+FD_FN_CONST fd_aio_t const *
+fd_uringsock_get_tx( fd_uringsock_t * sock );
+
+/* fd_uringsock_service services aio callbacks for incoming packets,
+   handles completions for tx requests and submits queued sends. */
+
+void
+fd_uringsock_service( fd_uringsock_t * sock );
+
+FD_FN_PURE uint
+fd_uringsock_get_ip4_address( fd_uringsock_t const * sock );
+
+FD_FN_PURE uint
+fd_uringsock_get_listen_port( fd_uringsock_t const * sock );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_tango_uringsock_fd_uringsock_h */
@@ -0,0 +1,278 @@
+/* Included for access to the receive mode */
+#include "fd_uringsock.c"
+#include <errno.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include "../../util/net/fd_eth.h"
+#include "../../util/net/fd_ip4.h"
+#include "../../util/net/fd_udp.h"
+
+#define MTU     (1500UL)
+#define RX_CNT  (64UL)
+#define TX_CNT  (32UL)
+#define PKT_CNT (1000UL)
+
+/* Packet i has a payload of 1+(i%PAYLOAD_MOD) bytes filled with (uchar)i */
+
+#define PAYLOAD_MOD (1400UL)
+
+static int
+new_sock( ushort * port ) {
+  int fd = socket( AF_INET, SOCK_DGRAM, IPPROTO_UDP );
+  if( FD_UNLIKELY( fd<0 ) ) FD_LOG_ERR(( "socket(AF_INET,SOCK_DGRAM,IPPROTO_UDP) failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  int rcvbuf = 1<<22;
+  setsockopt( fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(int) );
+  struct sockaddr_in addr = {
+    .sin_family = AF_INET,
+    .sin_addr   = { .s_addr = FD_IP4_ADDR( 127, 0, 0, 1 ) },
+    .sin_port   = 0,
+  };
+  FD_TEST( !bind( fd, (struct sockaddr const *)fd_type_pun_const( &addr ), sizeof(struct sockaddr_in) ) );
+  socklen_t addrlen = sizeof(struct sockaddr_in);
+  FD_TEST( !getsockname( fd, (struct sockaddr *)fd_type_pun( &addr ), &addrlen ) );
+  *port = fd_ushort_bswap( addr.sin_port );
+  return fd;
+}
+
+/* The receiver checks the mock headers and payload of every packet and
+   counts them */
+
+typedef struct {
+  ulong  rx_cnt;
+  ushort self_port;
+  ushort peer_port;
+} rx_ctx_t;
+
+static int
+test_aio_recv( void *                    ctx,
+               fd_aio_pkt_info_t const * batch,
+               ulong                     batch_cnt,
+               ulong *                   opt_batch_idx,
+               int                       flush ) {
+  (void)opt_batch_idx; (void)flush;
+  rx_ctx_t * rx = (rx_ctx_t *)ctx;
+  for( ulong i=0UL; i<batch_cnt; i++ ) {
+    uchar const * buf = (uchar const *)batch[i].buf;
+    ulong         sz  = batch[i].buf_sz;
+    ulong         idx = rx->rx_cnt++;
+    ulong payload_sz  = 1UL + (idx % PAYLOAD_MOD);
+    FD_TEST( sz==42UL+payload_sz );
+
+    fd_eth_hdr_t const * eth = (fd_eth_hdr_t const *)buf;
+    FD_TEST( eth->net_type==fd_ushort_bswap( FD_ETH_HDR_TYPE_IP ) );
+
+    fd_ip4_hdr_t ip4 = *(fd_ip4_hdr_t const *)(eth+1);
+    FD_TEST( !fd_ip4_hdr_check( &ip4 ) );
+    fd_ip4_hdr_bswap( &ip4 );
+    FD_TEST( ip4.version==4 && ip4.ihl==5 );
+    FD_TEST( ip4.protocol==FD_IP4_HDR_PROTOCOL_UDP );
+    FD_TEST( ip4.net_tot_len==payload_sz+28UL );
+    FD_TEST( ip4.saddr==FD_IP4_ADDR( 127, 0, 0, 1 ) );
+    FD_TEST( ip4.daddr==FD_IP4_ADDR( 127, 0, 0, 1 ) );
+
+    fd_udp_hdr_t const * udp = (fd_udp_hdr_t const *)( buf + 34UL );
+    FD_TEST( fd_ushort_bswap( udp->net_sport )==rx->peer_port );
+    FD_TEST( fd_ushort_bswap( udp->net_dport )==rx->self_port );
+    FD_TEST( fd_ushort_bswap( udp->net_len   )==payload_sz+8UL );
+
+    for( ulong j=0UL; j<payload_sz; j++ ) FD_TEST( buf[ 42UL+j ]==(uchar)idx );
+  }
+  return FD_AIO_SUCCESS;
+}
+
+static uchar frame[ 42UL+PAYLOAD_MOD ];
+
+/* make_pkt creates packet idx addressed to dst_port as it would be sent
+   to a uringsock's tx aio (in "network" byte order) */
+
+static ulong
+make_pkt( ulong  idx,
+          ushort src_port,
+          ushort dst_port ) {
+  ulong payload_sz = 1UL + (idx % PAYLOAD_MOD);
+  fd_eth_hdr_t * eth = (fd_eth_hdr_t *)frame;
+  memset( eth, 0, sizeof(fd_eth_hdr_t) );
+  eth->net_type = fd_ushort_bswap( FD_ETH_HDR_TYPE_IP );
+  fd_ip4_hdr_t * ip4 = (fd_ip4_hdr_t *)(eth+1);
+  *ip4 = (fd_ip4_hdr_t) {
+    .ihl         = 5,
+    .version     = 4,
+    .net_tot_len = (ushort)( payload_sz + 28UL ),
+    .ttl         = 64,
+    .protocol    = FD_IP4_HDR_PROTOCOL_UDP,
+    .saddr       = FD_IP4_ADDR( 127, 0, 0, 1 ),
+    .daddr       = FD_IP4_ADDR( 127, 0, 0, 1 )
+  };
+  fd_ip4_hdr_bswap( ip4 );
+  ip4->check = fd_ip4_hdr_check_fast( ip4 );
+  fd_udp_hdr_t * udp = (fd_udp_hdr_t *)(ip4+1);
+  *udp = (fd_udp_hdr_t) {
+    .net_sport = fd_ushort_bswap( src_port ),
+    .net_dport = fd_ushort_bswap( dst_port ),
+    .net_len   = fd_ushort_bswap( (ushort)( payload_sz + 8UL ) ),
+    .check     = 0
+  };
+  memset( frame+42UL, (uchar)idx, payload_sz );
+  return 42UL+payload_sz;
+}
+
+/* exchange sends packets [*a_tx_cnt,pkt_cnt) from b to a and
+   [*b_tx_cnt,pkt_cnt) from a to b, servicing both until everything
+   arrived.  Sends are throttled by the tx slots and the receivers check
+   the packets arrive in order. */
+
+static void
+exchange( fd_uringsock_t * a,
+          fd_uringsock_t * b,
+          rx_ctx_t *       a_rx,
+          rx_ctx_t *       b_rx,
+          ulong *          _a_tx_cnt,
+          ulong *          _b_tx_cnt,
+          ulong            pkt_cnt ) {
+  fd_aio_t const * a_tx = fd_uringsock_get_tx( a );
+  fd_aio_t const * b_tx = fd_uringsock_get_tx( b );
+  ushort a_port = a_rx->self_port;
+  ushort b_port = b_rx->self_port;
+
+  ulong a_tx_cnt = *_a_tx_cnt;
+  ulong b_tx_cnt = *_b_tx_cnt;
+  long  deadline = fd_log_wallclock() + (long)10e9;
+  while( (a_rx->rx_cnt<pkt_cnt) | (b_rx->rx_cnt<pkt_cnt) ) {
+    FD_TEST( fd_log_wallclock()<deadline );
+
+    /* Don't get more than RX_CNT ahead of the receiver such that
+       nothing is dropped by the kernel */
+
+    if( b_tx_cnt<pkt_cnt && b_tx_cnt<a_rx->rx_cnt+RX_CNT ) {
+      fd_aio_pkt_info_t pkt = { .buf = frame, .buf_sz = (ushort)make_pkt( b_tx_cnt, b_port, a_port ) };
+      ulong batch_idx = 1UL;
+      int   err       = fd_aio_send( b_tx, &pkt, 1UL, &batch_idx, b_tx_cnt%7UL==0UL );
+      if( err==FD_AIO_SUCCESS ) b_tx_cnt++;
+      else { FD_TEST( err==FD_AIO_ERR_AGAIN ); FD_TEST( batch_idx==0UL ); }
+    }
+    if( a_tx_cnt<pkt_cnt && a_tx_cnt<b_rx->rx_cnt+RX_CNT ) {
+      fd_aio_pkt_info_t pkt = { .buf = frame, .buf_sz = (ushort)make_pkt( a_tx_cnt, a_port, b_port ) };
+      ulong batch_idx = 1UL;
+      int   err       = fd_aio_send( a_tx, &pkt, 1UL, &batch_idx, 1 );
+      if( err==FD_AIO_SUCCESS ) a_tx_cnt++;
+      else { FD_TEST( err==FD_AIO_ERR_AGAIN ); FD_TEST( batch_idx==0UL ); }
+    }
+
+    fd_uringsock_service( a );
+    fd_uringsock_service( b );
+  }
+
+  FD_TEST( a_rx->rx_cnt==pkt_cnt );
+  FD_TEST( b_rx->rx_cnt==pkt_cnt );
+  *_a_tx_cnt = a_tx_cnt;
+  *_b_tx_cnt = b_tx_cnt;
+}
+
+/* force_single_shot terminates the multishot recvmsg of sock and
+   switches it to single shot recvmsg, as if the kernel had rejected
+   multishot. */
+
+static void
+force_single_shot( fd_uringsock_t * sock ) {
+  FD_TEST( sock->rx_multishot );
+  struct io_uring_sqe * sqe = fd_uringsock_sqe( sock ); FD_TEST( sqe );
+  sqe->opcode    = IORING_OP_ASYNC_CANCEL;
+  sqe->addr      = FD_URINGSOCK_UD_RX;
+  sqe->user_data = FD_URINGSOCK_UD_CANCEL;
+  fd_uringsock_sqe_publish( sock );
+  for( ulong iter=0UL; sock->rx_armed; iter++ ) {
+    FD_TEST( iter<1024UL );
+    fd_uringsock_submit( sock, 1 );
+    fd_uringsock_reap( sock, 0 );
+  }
+  fd_uringsock_rx_single_shot( sock );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  FD_TEST( fd_uringsock_align()==FD_URINGSOCK_ALIGN );
+  FD_TEST( fd_uringsock_footprint( MTU, RX_CNT, TX_CNT ) );
+  FD_TEST( fd_ulong_is_aligned( fd_uringsock_footprint( MTU, RX_CNT, TX_CNT ), FD_URINGSOCK_ALIGN ) );
+  FD_TEST( !fd_uringsock_footprint( 42UL,  RX_CNT,      TX_CNT                         ) ); /* mtu too small   */
+  FD_TEST( !fd_uringsock_footprint( MTU,   RX_CNT+1UL,  TX_CNT                         ) ); /* rx not pow2     */
+  FD_TEST( !fd_uringsock_footprint( MTU,   2UL*FD_URINGSOCK_RX_PKT_CNT_MAX, TX_CNT     ) ); /* rx too large    */
+  FD_TEST( !fd_uringsock_footprint( MTU,   RX_CNT,      0UL                            ) ); /* no tx           */
+  FD_TEST( !fd_uringsock_footprint( MTU,   RX_CNT,      FD_URINGSOCK_TX_PKT_CNT_MAX+1UL ) ); /* tx too large    */
+
+  ushort a_port; int a_fd = new_sock( &a_port );
+  ushort b_port; int b_fd = new_sock( &b_port );
+
+  ulong  footprint = fd_uringsock_footprint( MTU, RX_CNT, TX_CNT );
+  void * a_mem     = aligned_alloc( fd_uringsock_align(), footprint ); FD_TEST( a_mem );
+  void * b_mem     = aligned_alloc( fd_uringsock_align(), footprint ); FD_TEST( b_mem );
+
+  FD_TEST( !fd_uringsock_new( NULL,                 MTU, RX_CNT, TX_CNT ) ); /* NULL shmem       */
+  FD_TEST( !fd_uringsock_new( (uchar *)a_mem+64UL,  MTU, RX_CNT, TX_CNT ) ); /* misaligned shmem */
+
+  fd_uringsock_t * a = fd_uringsock_join( fd_uringsock_new( a_mem, MTU, RX_CNT, TX_CNT ), a_fd );
+  if( FD_UNLIKELY( !a ) ) {
+    FD_LOG_WARNING(( "skip: io_uring not available" ));
+    free( a_mem ); free( b_mem );
+    close( a_fd ); close( b_fd );
+    fd_halt();
+    return 0;
+  }
+  fd_uringsock_t * b = fd_uringsock_join( fd_uringsock_new( b_mem, MTU, RX_CNT, TX_CNT ), b_fd ); FD_TEST( b );
+
+  FD_TEST( fd_uringsock_get_ip4_address( a )==FD_IP4_ADDR( 127, 0, 0, 1 ) );
+  FD_TEST( fd_uringsock_get_listen_port( a )==a_port );
+  FD_TEST( fd_uringsock_get_listen_port( b )==b_port );
+
+  rx_ctx_t a_rx = { .rx_cnt = 0UL, .self_port = a_port, .peer_port = b_port };
+  rx_ctx_t b_rx = { .rx_cnt = 0UL, .self_port = b_port, .peer_port = a_port };
+  fd_aio_t _a_aio[1]; fd_aio_t * a_aio = fd_aio_join( fd_aio_new( _a_aio, &a_rx, test_aio_recv ) ); FD_TEST( a_aio );
+  fd_aio_t _b_aio[1]; fd_aio_t * b_aio = fd_aio_join( fd_aio_new( _b_aio, &b_rx, test_aio_recv ) ); FD_TEST( b_aio );
+  fd_uringsock_set_rx( a, a_aio );
+  fd_uringsock_set_rx( b, b_aio );
+
+  fd_aio_t const * a_tx = fd_uringsock_get_tx( a );
+
+  ulong a_tx_cnt = 0UL;
+  ulong b_tx_cnt = 0UL;
+  exchange( a, b, &a_rx, &b_rx, &a_tx_cnt, &b_tx_cnt, PKT_CNT );
+
+  /* Same with single shot recvmsg (the fallback for kernels without
+     multishot recvmsg), switched to with buffers in the ring */
+
+  force_single_shot( a );
+  force_single_shot( b );
+  exchange( a, b, &a_rx, &b_rx, &a_tx_cnt, &b_tx_cnt, 2UL*PKT_CNT );
+  FD_TEST( !a->rx_multishot );
+  FD_TEST( !b->rx_multishot );
+
+  /* Malformed packets are dropped */
+
+  fd_aio_pkt_info_t runt = { .buf = frame, .buf_sz = 20 };
+  FD_TEST( fd_aio_send( a_tx, &runt, 1UL, NULL, 1 )==FD_AIO_SUCCESS );
+
+  /* Leave with sends in flight */
+
+  for( ulong i=0UL; i<TX_CNT; i++ ) {
+    fd_aio_pkt_info_t pkt = { .buf = frame, .buf_sz = (ushort)make_pkt( i, a_port, b_port ) };
+    fd_aio_send( a_tx, &pkt, 1UL, NULL, 0 );
+  }
+
+  fd_aio_delete( fd_aio_leave( a_aio ) );
+  fd_aio_delete( fd_aio_leave( b_aio ) );
+  FD_TEST( fd_uringsock_delete( fd_uringsock_leave( a ) )==a_mem );
+  FD_TEST( fd_uringsock_delete( fd_uringsock_leave( b ) )==b_mem );
+  free( a_mem );
+  free( b_mem );
+
+  if( FD_UNLIKELY( close( a_fd )<0 ) ) FD_LOG_ERR(( "close(a_fd) failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  if( FD_UNLIKELY( close( b_fd )<0 ) ) FD_LOG_ERR(( "close(b_fd) failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -24,6 +24,16 @@ fd_cstr_to_xdp_mode( char const * s ) {
   else                             return 0U;
 }
 
+static uint
+fd_cstr_to_xdp_proto( char const * s ) {
+       if( 0==strcmp( s, "gossip"        ) ) return FD_XDP_PROTO_GOSSIP;
+  else if( 0==strcmp( s, "tpu-udp-user"  ) ) return FD_XDP_PROTO_TPU_UDP_USER;
+  else if( 0==strcmp( s, "tpu-quic-user" ) ) return FD_XDP_PROTO_TPU_QUIC_USER;
+  else if( 0==strcmp( s, "tpu-quic-vote" ) ) return FD_XDP_PROTO_TPU_QUIC_VOTE;
+  else if( 0==strcmp( s, "tvu"           ) ) return FD_XDP_PROTO_TVU;
+  else                                       return 0U;
+}
+
 int
 main( int     argc,
       char ** argv ) {
@@ -140,9 +150,9 @@ main( int     argc,
         FD_LOG_ERR(( "%i: %s: invalid UDP port number\n\tDo %s help for help",
                      cnt, cmd, bin ));
 
-      /* TODO: Map protocol string to a uint identifier */
-      (void)_proto;
-      uint proto = 1UL;
+      uint proto = fd_cstr_to_xdp_proto( _proto );
+      if( FD_UNLIKELY( proto==0U ) )
+        FD_LOG_ERR(( "%i: %s: unsupported protocol \"%s\"\n\tDo %s help for help", cnt, cmd, _proto, bin ));
 
       if( FD_UNLIKELY( 0!=fd_xdp_listen_udp_port( _wksp, ip_addr, (uint)udp_port, proto ) ) )
         FD_LOG_ERR(( "%i: %s: fd_xdp_listen_udp_port(%s,%s,%lu,%s) failed\n\tDo %s help for help",
@@ -175,6 +185,29 @@ main( int     argc,
       FD_LOG_NOTICE(( "%i: %s %s %s %lu: success", cnt, cmd, _wksp, _ip_addr, udp_port ));
       SHIFT( 3 );
 
+    } else if( 0==strcmp( cmd, "set-rate-limit" ) ) {
+
+      if( FD_UNLIKELY( argc<3 ) ) FD_LOG_ERR(( "%i: %s: too few arguments\n\tDo %s help for help", cnt, cmd, bin ));
+
+      char const * _wksp       =                   argv[0];
+      ulong        pkt_per_sec = fd_cstr_to_ulong( argv[1] );
+      ulong        burst_cnt   = fd_cstr_to_ulong( argv[2] );
+
+      if( FD_UNLIKELY( pkt_per_sec>1000000000UL ) )
+        FD_LOG_ERR(( "%i: %s: invalid packet rate (at most 1e9 per second)\n\tDo %s help for help",
+                     cnt, cmd, bin ));
+
+      if( FD_UNLIKELY( pkt_per_sec && ( burst_cnt==0UL || burst_cnt>UINT_MAX ) ) )
+        FD_LOG_ERR(( "%i: %s: invalid burst size\n\tDo %s help for help",
+                     cnt, cmd, bin ));
+
+      if( FD_UNLIKELY( 0!=fd_xdp_set_rate_limit( _wksp, pkt_per_sec, burst_cnt ) ) )
+        FD_LOG_ERR(( "%i: %s: fd_xdp_set_rate_limit(%s,%lu,%lu) failed\n\tDo %s help for help",
+                     cnt, cmd, _wksp, pkt_per_sec, burst_cnt, bin ));
+
+      FD_LOG_NOTICE(( "%i: %s %s %lu %lu: success", cnt, cmd, _wksp, pkt_per_sec, burst_cnt ));
+      SHIFT( 3 );
+
     } else if( 0==strcmp( cmd, "new-xsk" ) ) {
 
       if( FD_UNLIKELY( argc<4 ) ) FD_LOG_ERR(( "%i: %s: too few arguments\n\tDo %s help for help", cnt, cmd, bin ));
@@ -5,8 +5,13 @@
    every packet as part of the XDP stage of the Linux host.  Its task is
    to forward packets to the appropriate destination which may be the
    XSKs handling Firedancer traffic or the regular Linux networking
-   stack for unrelated traffic.  It may also be used in the future to
-   protect against packet floods.
+   stack for unrelated traffic.
+
+   It also protects QUIC listeners against packet floods:  Traffic to a
+   QUIC listener that clearly is not a valid QUIC datagram is dropped,
+   and so is traffic exceeding the configured per-source rate limit.
+   Such packets never occupy an XSK frame or cost a cycle in a QUIC
+   tile.  Traffic to other listeners is redirected unfiltered.
 
    The following code targets the Linux eBPF virtual machine which does
    not yet support libc and has strict control-flow and memory
@@ -41,6 +46,17 @@ static void *
                          void const * key)
   = (void *)1U;
 
+static long
+(* bpf_map_update_elem)( void *       map,
+                         void const * key,
+                         void const * value,
+                         ulong        flags )
+  = (void *)2U;
+
+static ulong
+(* bpf_ktime_get_ns)( void )
+  = (void *)5U;
+
 static long
 (* bpf_redirect_map)( void * map,
                       ulong  key,
@@ -84,11 +100,93 @@ extern uint fd_xdp_xsks __attribute__((section("maps")));
 
 /* fd_xdp_udp_dsts: UDP/IP listen addrs
    key is hex pattern 0000AAAAAAAABBBB where AAAAAAAA is the IP dest
-   addr and BBBB is the UDP dest port (in network byte order). */
+   addr and BBBB is the UDP dest port (in network byte order).  value
+   is the listener protocol (FD_XDP_PROTO_{...}). */
 extern uint fd_xdp_udp_dsts __attribute__((section("maps")));
 
+/* fd_xdp_rate_limits: Per-source rate limit state
+   key is the IPv4 source addr (in network byte order).  value is the
+   source's theoretical arrival time (ulong ns, see fd_xdp_rate_cfg_t). */
+extern uint fd_xdp_rate_limits __attribute__((section("maps")));
+
+/* fd_xdp_rate_cfg: Rate limit configuration
+   Single fd_xdp_rate_cfg_t entry at key 0. */
+extern uint fd_xdp_rate_cfg __attribute__((section("maps")));
+
 /* Executable Code ****************************************************/
 
+/* fd_xdp_quic_filter: Returns 1 if the UDP datagram at udp could be a
+   valid QUIC v1 datagram addressed to an fd_quic server, or 0 if it is
+   clearly malformed.  data_end points one past the last byte of the
+   frame.  Only the first QUIC packet of the datagram is inspected.
+   Conn IDs of short header packets are not checked, as the XDP program
+   does not know which conns are open. */
+static inline int
+fd_xdp_quic_filter( uchar const * udp,
+                    uchar const * data_end ) {
+
+  if( FD_UNLIKELY( udp + 8U+FD_XDP_QUIC_MIN_SZ > data_end ) ) return 0;
+
+  /* Reject truncated datagrams and sizes that cannot be QUIC */
+  ulong udp_sz = __builtin_bswap16( *(ushort *)( udp+4UL ) );
+  if( FD_UNLIKELY( udp_sz < 8U+FD_XDP_QUIC_MIN_SZ ) ) return 0;
+  if( FD_UNLIKELY( udp_sz > 8U+FD_XDP_QUIC_MAX_SZ ) ) return 0;
+  if( FD_UNLIKELY( udp + udp_sz > data_end        ) ) return 0;
+
+  uchar const * quic = udp + 8U;
+  uint          flags = quic[0];
+
+  /* QUIC v1 requires the fixed bit in both header forms */
+  if( FD_UNLIKELY( !( flags & 0x40U ) ) ) return 0;
+
+  /* Short header */
+  if( !( flags & 0x80U ) ) return 1;
+
+  /* Long header: fd_quic only supports version 1 */
+  if( FD_UNLIKELY( *(uint *)( quic+1UL ) != 0x01000000U ) ) return 0;
+
+  switch( ( flags>>4 ) & 0x3U ) {
+  case 0U: /* Initial */
+    return udp_sz >= 8U+FD_XDP_QUIC_INITIAL_MIN_SZ;
+  case 2U: /* Handshake, dst conn ID was issued by fd_quic */
+    return quic[5] == FD_XDP_QUIC_CONN_ID_SZ;
+  case 3U: /* Retry, never sent to servers */
+    return 0;
+  default: /* 0-RTT */
+    return 1;
+  }
+}
+
+/* fd_xdp_rate_limit: Returns 1 if a packet from IPv4 source addr
+   ip4_src conforms to the configured rate limit, or 0 if it should be
+   dropped.  Updates to a source's state are not atomic, concurrent
+   packets from the same source on different CPUs may slightly exceed
+   the limit. */
+static inline int
+fd_xdp_rate_limit( uint ip4_src ) {
+
+  uint cfg_key = 0U;
+  fd_xdp_rate_cfg_t const * cfg = bpf_map_lookup_elem( &fd_xdp_rate_cfg, &cfg_key );
+  if( !cfg ) return 1;
+  ulong cost_ns = cfg->cost_ns;
+  if( !cost_ns ) return 1;
+
+  ulong   now = bpf_ktime_get_ns();
+  ulong * tat = bpf_map_lookup_elem( &fd_xdp_rate_limits, &ip4_src );
+  if( !tat ) {
+    /* First packet of this source */
+    ulong next = now + cost_ns;
+    bpf_map_update_elem( &fd_xdp_rate_limits, &ip4_src, &next, 0UL /* BPF_ANY */ );
+    return 1;
+  }
+
+  ulong t = *tat;
+  if( t < now ) t = now;
+  if( FD_UNLIKELY( t - now > cfg->burst_ns ) ) return 0;
+  *tat = t + cost_ns;
+  return 1;
+}
+
 /* fd_xdp_redirect: Entrypoint of redirect XDP program.
    ctx is the XDP context for an Ethernet/IP packet.
    Returns an XDP action code in XDP_{PASS,REDIRECT,DROP}. */
@@ -127,6 +225,16 @@ int fd_xdp_redirect( struct xdp_md *ctx ) {
   uint * udp_value = bpf_map_lookup_elem( &fd_xdp_udp_dsts, &flow_key );
   if( !udp_value ) return XDP_PASS;
 
+  /* QUIC listeners: Drop malformed datagrams and traffic of sources
+     exceeding their rate limit */
+  uint proto = *udp_value;
+  if( proto==FD_XDP_PROTO_TPU_QUIC_USER || proto==FD_XDP_PROTO_TPU_QUIC_VOTE ) {
+    if( FD_UNLIKELY( !fd_xdp_quic_filter( udp, data_end ) ) ) return XDP_DROP;
+
+    uint ip_srcaddr = *(uint *)( iphdr+12UL );
+    if( FD_UNLIKELY( !fd_xdp_rate_limit( ip_srcaddr ) ) ) return XDP_DROP;
+  }
+
   /* Look up the interface queue to find the socket to forward to */
   uint socket_key = ctx->rx_queue_index;
   return bpf_redirect_map( &fd_xdp_xsks, socket_key, 0 );
@@ -10,4 +10,45 @@
 /* FD_XDP_UDP_MAP_CNT: Max supported number of UDP port mappings. */
 #define FD_XDP_UDP_MAP_CNT  64U
 
+/* FD_XDP_PROTO_{...}: Listener protocol identifiers, the values of the
+   fd_xdp_udp_dsts map.  Traffic to QUIC listeners is checked for
+   well-formedness and subject to the per-source rate limit, traffic to
+   other listeners is redirected unfiltered. */
+#define FD_XDP_PROTO_GOSSIP        1U
+#define FD_XDP_PROTO_TPU_UDP_USER  2U
+#define FD_XDP_PROTO_TPU_QUIC_USER 3U
+#define FD_XDP_PROTO_TPU_QUIC_VOTE 4U
+#define FD_XDP_PROTO_TVU           5U
+
+/* FD_XDP_RATE_LIMIT_MAP_CNT: Max number of IPv4 source addresses
+   tracked for rate limiting.  Least recently seen sources get evicted
+   when exceeded. */
+#define FD_XDP_RATE_LIMIT_MAP_CNT 65536U
+
+/* FD_XDP_QUIC_{MIN,MAX}_SZ: Bounds of the UDP payload size of QUIC
+   datagrams accepted by the XDP program.  MIN is the smallest possible
+   short header packet sent to an fd_quic server (1 byte flags, 8 byte
+   conn ID, 4 byte header protection sample offset, 16 byte sample).
+   MAX is the largest payload that fits into a 2048 byte XSK frame.
+   FD_XDP_QUIC_INITIAL_MIN_SZ is the smallest valid UDP payload carrying
+   a QUIC Initial packet (RFC 9000 Section 14.1).  FD_XDP_QUIC_CONN_ID_SZ
+   is the size of the conn IDs issued by fd_quic (FD_QUIC_CONN_ID_SZ). */
+#define FD_XDP_QUIC_MIN_SZ          29U
+#define FD_XDP_QUIC_MAX_SZ        2006U
+#define FD_XDP_QUIC_INITIAL_MIN_SZ 1200U
+#define FD_XDP_QUIC_CONN_ID_SZ       8U
+
+/* fd_xdp_rate_cfg_t is the value type of the single entry of the
+   fd_xdp_rate_cfg map.  Rate limiting is implemented as a generic cell
+   rate algorithm: Each packet from a source advances the source's
+   theoretical arrival time (TAT) by cost_ns.  Packets that arrive more
+   than burst_ns before their source's TAT are dropped.  cost_ns==0
+   disables rate limiting. */
+
+struct fd_xdp_rate_cfg {
+  ulong cost_ns;  /* Average ns between packets of a single source */
+  ulong burst_ns; /* Max ns a source may get ahead of its average rate */
+};
+typedef struct fd_xdp_rate_cfg fd_xdp_rate_cfg_t;
+
 #endif /* HEADER_fd_src_tango_xdp_fd_xdp_redirect_prog_h */
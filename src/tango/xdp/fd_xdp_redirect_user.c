@@ -69,6 +69,39 @@ fd_xdp_reperm( char const * path,
   }
 }
 
+/* fd_xdp_pin_map: Creates an eBPF map with the given attrs and pins it
+   to /sys/fs/bpf/{app_name}/{name}.  Returns 0 on success and -1 on
+   error.  Reasons for error are logged to FD_LOG_WARNING. */
+static int
+fd_xdp_pin_map( char const *     app_name,
+                char const *     name,
+                union bpf_attr * attr,
+                uint             mode,
+                int              uid,
+                int              gid ) {
+
+  int map_fd = (int)bpf( BPF_MAP_CREATE, attr, sizeof(union bpf_attr) );
+  if( FD_UNLIKELY( map_fd<0 ) ) {
+    FD_LOG_WARNING(( "bpf_map_create(%u,\"%s\",%uU,%uU,%u) failed (%i-%s)",
+                     attr->map_type, attr->map_name, attr->key_size, attr->value_size, attr->max_entries,
+                     errno, fd_io_strerror( errno ) ));
+    return -1;
+  }
+
+  char path[ PATH_MAX ];
+  snprintf( path, PATH_MAX, "/sys/fs/bpf/%s/%s", app_name, name );
+  if( FD_UNLIKELY( 0!=fd_bpf_obj_pin( map_fd, path ) ) ) {
+    FD_LOG_WARNING(( "bpf_obj_pin(%u,%s) failed (%i-%s)", map_fd, path, errno, fd_io_strerror( errno ) ));
+    close( map_fd );
+    return -1;
+  }
+
+  fd_xdp_reperm( path, mode, uid, gid, 0 );
+
+  close( map_fd );
+  return 0;
+}
+
 int
 fd_xdp_init( char const * app_name,
              uint         mode,
@@ -81,47 +114,51 @@ fd_xdp_init( char const * app_name,
 
   fd_xdp_reperm( "/sys/fs/bpf", mode, uid, gid, 1 );
 
-  /* Create UDP dsts map */
-
-  union bpf_attr attr = {
-    .map_type    = BPF_MAP_TYPE_HASH,
-    .map_name    = "fd_xdp_udp_dsts",
-    .key_size    = 8U,
-    .value_size  = 4U,
-    .max_entries = FD_XDP_UDP_MAP_CNT,
-  };
-  int udp_dsts_map_fd = (int)bpf( BPF_MAP_CREATE, &attr, sizeof(union bpf_attr) );
-  if( FD_UNLIKELY( udp_dsts_map_fd<0 ) ) {
-    FD_LOG_WARNING(( "bpf_map_create(BPF_MAP_TYPE_HASH,\"fd_xdp_udp_dsts\",8U,4U,%u) failed (%i-%s)",
-                     FD_XDP_UDP_MAP_CNT, errno, fd_io_strerror( errno ) ));
-    return -1;
-  }
-
-  /* Pin UDP dsts map to BPF FS */
+  /* Create app dir in BPF FS */
 
   char path[ PATH_MAX ];
   snprintf( path, PATH_MAX, "/sys/fs/bpf/%s", app_name );
 
   if( FD_UNLIKELY( 0!=mkdir( path, mode ) && errno!=EEXIST ) ) {
     FD_LOG_WARNING(( "mkdir(%s) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
-    close( udp_dsts_map_fd );
     return -1;
   }
 
   fd_xdp_reperm( path, mode, uid, gid, 1 );
 
-  snprintf( path, PATH_MAX, "/sys/fs/bpf/%s/udp_dsts", app_name );
-  if( FD_UNLIKELY( 0!=fd_bpf_obj_pin( udp_dsts_map_fd, path ) ) ) {
-    FD_LOG_WARNING(( "bpf_obj_pin(%u,%s) failed (%i-%s)", udp_dsts_map_fd, path, errno, fd_io_strerror( errno ) ));
-    close( udp_dsts_map_fd );
+  /* Create and pin maps */
+
+  union bpf_attr udp_dsts_attr = {
+    .map_type    = BPF_MAP_TYPE_HASH,
+    .map_name    = "fd_xdp_udp_dsts",
+    .key_size    = 8U,
+    .value_size  = 4U,
+    .max_entries = FD_XDP_UDP_MAP_CNT,
+  };
+  if( FD_UNLIKELY( 0!=fd_xdp_pin_map( app_name, "udp_dsts", &udp_dsts_attr, mode, uid, gid ) ) )
     return -1;
-  }
 
-  fd_xdp_reperm( path, mode, uid, gid, 0 );
+  union bpf_attr rate_limits_attr = {
+    .map_type    = BPF_MAP_TYPE_LRU_HASH,
+    .map_name    = "fd_xdp_rate_lim",
+    .key_size    = 4U,
+    .value_size  = 8U,
+    .max_entries = FD_XDP_RATE_LIMIT_MAP_CNT,
+  };
+  if( FD_UNLIKELY( 0!=fd_xdp_pin_map( app_name, "rate_limits", &rate_limits_attr, mode, uid, gid ) ) )
+    return -1;
 
-  FD_LOG_NOTICE(( "Activated XDP environment at /sys/fs/bpf/%s", app_name ));
+  union bpf_attr rate_cfg_attr = {
+    .map_type    = BPF_MAP_TYPE_ARRAY,
+    .map_name    = "fd_xdp_rate_cfg",
+    .key_size    = 4U,
+    .value_size  = sizeof(fd_xdp_rate_cfg_t),
+    .max_entries = 1U,
+  };
+  if( FD_UNLIKELY( 0!=fd_xdp_pin_map( app_name, "rate_cfg", &rate_cfg_attr, mode, uid, gid ) ) )
+    return -1;
 
-  close( udp_dsts_map_fd );
+  FD_LOG_NOTICE(( "Activated XDP environment at /sys/fs/bpf/%s", app_name ));
   return 0;
 }
 
@@ -171,9 +208,11 @@ fd_xdp_fini( char const * app_name ) {
       FD_LOG_WARNING(( "fd_xdp_unhook_iface(%s,%s) failed", app_name, iface_ent->d_name ));
   }
 
-  /* Remove UDP dst map */
+  /* Remove maps */
 
-  unlinkat( dirfd( app_dir ), "udp_dsts", 0 );
+  unlinkat( dirfd( app_dir ), "udp_dsts",    0 );
+  unlinkat( dirfd( app_dir ), "rate_limits", 0 );
+  unlinkat( dirfd( app_dir ), "rate_cfg",    0 );
 
   /* Remove app dir */
 
@@ -218,8 +257,8 @@ fd_xdp_hook_iface( char const * app_name,
 
   /* Create mutable copy of ELF */
 
-  uchar elf_copy[ 2048UL ];
-  if( FD_UNLIKELY( prog_elf_sz>2048UL ) ) {
+  uchar elf_copy[ 4096UL ];
+  if( FD_UNLIKELY( prog_elf_sz>4096UL ) ) {
     FD_LOG_WARNING(( "ELF too large: %lu bytes", prog_elf_sz ));
     return -1;
   }
@@ -266,6 +305,27 @@ fd_xdp_hook_iface( char const * app_name,
     return -1;
   }
 
+  /* Find rate limit map fds */
+
+  snprintf( path, PATH_MAX, "/sys/fs/bpf/%s/rate_limits", app_name );
+
+  int rate_limits_map_fd = fd_bpf_obj_get( path );
+  if( FD_UNLIKELY( rate_limits_map_fd<0 ) ) {
+    FD_LOG_WARNING(( "bpf_obj_get(%s) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+    close( udp_dsts_map_fd );
+    return -1;
+  }
+
+  snprintf( path, PATH_MAX, "/sys/fs/bpf/%s/rate_cfg", app_name );
+
+  int rate_cfg_map_fd = fd_bpf_obj_get( path );
+  if( FD_UNLIKELY( rate_cfg_map_fd<0 ) ) {
+    FD_LOG_WARNING(( "bpf_obj_get(%s) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+    close( rate_limits_map_fd );
+    close( udp_dsts_map_fd );
+    return -1;
+  }
+
   /* Create and pin XSK map to BPF FS */
 
   union bpf_attr attr = {
@@ -279,6 +339,8 @@ fd_xdp_hook_iface( char const * app_name,
   if( FD_UNLIKELY( xsks_fd<0 ) ) {
     FD_LOG_WARNING(( "Failed to create XSKMAP (%i-%s)", errno, fd_io_strerror( errno ) ));
     close( udp_dsts_map_fd );
+    close( rate_limits_map_fd );
+    close( rate_cfg_map_fd );
     return -1;
   }
 
@@ -287,6 +349,8 @@ fd_xdp_hook_iface( char const * app_name,
     FD_LOG_WARNING(( "bpf_obj_pin(xsks_fd,%s) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
     close( xsks_fd );
     close( udp_dsts_map_fd );
+    close( rate_limits_map_fd );
+    close( rate_cfg_map_fd );
     return -1;
   }
 
@@ -294,14 +358,16 @@ fd_xdp_hook_iface( char const * app_name,
 
   /* Link BPF bytecode */
 
-  fd_ebpf_sym_t syms[ 2 ] = {
-    { .name = "fd_xdp_udp_dsts", .value = (uint)udp_dsts_map_fd },
-    { .name = "fd_xdp_xsks",     .value = (uint)xsks_fd         }
+  fd_ebpf_sym_t syms[ 4 ] = {
+    { .name = "fd_xdp_udp_dsts",    .value = (uint)udp_dsts_map_fd    },
+    { .name = "fd_xdp_xsks",        .value = (uint)xsks_fd            },
+    { .name = "fd_xdp_rate_limits", .value = (uint)rate_limits_map_fd },
+    { .name = "fd_xdp_rate_cfg",    .value = (uint)rate_cfg_map_fd    }
   };
   fd_ebpf_link_opts_t opts = {
     .section = "xdp",
     .sym     = syms,
-    .sym_cnt = 2UL
+    .sym_cnt = 4UL
   };
   fd_ebpf_link_opts_t * res =
     fd_ebpf_static_link( &opts, elf_copy, prog_elf_sz );
@@ -310,6 +376,8 @@ fd_xdp_hook_iface( char const * app_name,
     FD_LOG_WARNING(( "Failed to link eBPF bytecode" ));
     close( xsks_fd );
     close( udp_dsts_map_fd );
+    close( rate_limits_map_fd );
+    close( rate_cfg_map_fd );
     return -1;
   }
 
@@ -341,6 +409,8 @@ fd_xdp_hook_iface( char const * app_name,
     close( prog_fd );
     close( xsks_fd );
     close( udp_dsts_map_fd );
+    close( rate_limits_map_fd );
+    close( rate_cfg_map_fd );
     return -1;
   }
 
@@ -363,6 +433,8 @@ fd_xdp_hook_iface( char const * app_name,
     close( prog_fd );
     close( xsks_fd );
     close( udp_dsts_map_fd );
+    close( rate_limits_map_fd );
+    close( rate_cfg_map_fd );
     return -1;
   }
 
@@ -380,6 +452,8 @@ fd_xdp_hook_iface( char const * app_name,
   FD_TEST( !close( prog_fd ) );
   FD_TEST( !close( xsks_fd ) );
   FD_TEST( !close( udp_dsts_map_fd ) );
+  FD_TEST( !close( rate_limits_map_fd ) );
+  FD_TEST( !close( rate_cfg_map_fd ) );
 
   return 0;
 }
@@ -470,6 +544,11 @@ fd_xdp_listen_udp_port( char const * app_name,
   if( FD_UNLIKELY( 0!=fd_xdp_validate_name_cstr( app_name, NAME_MAX, "app_name" ) ) )
     return -1;
 
+  if( FD_UNLIKELY( proto<FD_XDP_PROTO_GOSSIP || proto>FD_XDP_PROTO_TVU ) ) {
+    FD_LOG_WARNING(( "unsupported proto (%u)", proto ));
+    return -1;
+  }
+
   /* Open map */
 
   int udp_dsts_fd = fd_xdp_get_udp_dsts_map( app_name );
@@ -576,6 +655,57 @@ fd_xdp_clear_listeners( char const * app_name ) {
   return 0;
 }
 
+int
+fd_xdp_set_rate_limit( char const * app_name,
+                       ulong        pkt_per_sec,
+                       ulong        burst_cnt ) {
+  /* Validate arguments */
+
+  if( FD_UNLIKELY( 0!=fd_xdp_validate_name_cstr( app_name, NAME_MAX, "app_name" ) ) )
+    return -1;
+
+  if( FD_UNLIKELY( pkt_per_sec>1000000000UL ) ) {
+    FD_LOG_WARNING(( "pkt_per_sec (%lu) must be at most 1e9", pkt_per_sec ));
+    return -1;
+  }
+  if( FD_UNLIKELY( pkt_per_sec && ( burst_cnt==0UL || burst_cnt>UINT_MAX ) ) ) {
+    FD_LOG_WARNING(( "burst_cnt (%lu) must be in [1,%u]", burst_cnt, UINT_MAX ));
+    return -1;
+  }
+
+  /* Open map */
+
+  char path[ PATH_MAX ];
+  snprintf( path, PATH_MAX, "/sys/fs/bpf/%s/rate_cfg", app_name );
+
+  int rate_cfg_fd = fd_bpf_obj_get( path );
+  if( FD_UNLIKELY( rate_cfg_fd<0 ) ) {
+    FD_LOG_WARNING(( "bpf_obj_get(%s) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+    return -1;
+  }
+
+  /* Update config */
+
+  uint              key = 0U;
+  fd_xdp_rate_cfg_t cfg = {0};
+  if( pkt_per_sec ) {
+    cfg.cost_ns  = 1000000000UL / pkt_per_sec;
+    cfg.burst_ns = (burst_cnt-1UL) * cfg.cost_ns;
+  }
+
+  if( FD_UNLIKELY( 0!=fd_bpf_map_update_elem( rate_cfg_fd, &key, &cfg, BPF_ANY ) ) ) {
+    FD_LOG_WARNING(( "bpf_map_update_elem(fd=%d,key=%u,flags=%#x) failed (%i-%s)",
+                     rate_cfg_fd, key, BPF_ANY, errno, fd_io_strerror( errno ) ));
+    close( rate_cfg_fd );
+    return -1;
+  }
+
+  /* Clean up */
+
+  close( rate_cfg_fd );
+  return 0;
+}
+
 static int
 fd_xdp_get_xsks_map( char const * app_name,
                      char const * ifname ) {
@@ -34,11 +34,13 @@
        - fd_xsk_join()
    - For each UDP/IP destination to listen on
      - fd_xdp_listen_udp_port()
+   - Optionally, fd_xdp_set_rate_limit()
    - ... Application run ... */
 
 /* TODO: Support NUMA-aware eBPF maps */
 
 #include "fd_xsk.h"
+#include "fd_xdp_redirect_prog.h"
 #include "../../util/fd_util.h"
 
 /* FD_XDP_PIN_NAME_SZ: max number of chars in an eBPF pin dir name */
@@ -61,8 +63,10 @@ FD_PROTOTYPES_BEGIN
    Assumes that /sys/fs/bpf is a valid bpffs mount.
    Creates the following files in /sys/fs/bpf/{app_name}/
 
-     udp_dsts  BPF_MAP_TYPE_HASH map, see fd_xdp_udp_dsts in
-               program ebpf_xdp_flow.c
+     udp_dsts     BPF_MAP_TYPE_HASH map, see fd_xdp_udp_dsts in
+                  program fd_xdp_redirect_prog.c
+     rate_limits  BPF_MAP_TYPE_LRU_HASH map, see fd_xdp_rate_limits
+     rate_cfg     BPF_MAP_TYPE_ARRAY map, see fd_xdp_rate_cfg
 
    /sys/fs/bpf and any created dirs and files will assume the given FS
    mode, user ID and group ID.  Executable bit is removed as required.
@@ -135,8 +139,10 @@ fd_xdp_udp_dst_key( uint ip4_addr,
   return ( (ulong)( ip4_addr )<<16 ) | fd_ushort_bswap( (ushort)udp_port );
 }
 
-/* fd_xdp_listen_udp_port installs a listener for protocol proto on IPv4
-   destination addr ip4_dst_addr and UDP destination port udp_dst_port.
+/* fd_xdp_listen_udp_port installs a listener for protocol proto
+   (FD_XDP_PROTO_{...}) on IPv4 destination addr ip4_dst_addr and UDP
+   destination port udp_dst_port.  Traffic to QUIC listeners is subject
+   to the well-formedness checks and rate limit of the XDP program.
    Installation lifetime is until a matching call to
    fd_xdp_release_udp_port() or until the system is shut down.
    On interfaces running the XDP redirect program, causes matching
@@ -166,6 +172,25 @@ fd_xdp_release_udp_port( char const * app_name,
 int
 fd_xdp_clear_listeners( char const * app_name );
 
+/* fd_xdp_set_rate_limit configures the per-source rate limit of the XDP
+   redirect program.  Only traffic to tpu-quic-user and tpu-quic-vote
+   listeners (FD_XDP_PROTO_TPU_QUIC_{USER,VOTE}) is limited: it's
+   dropped in the kernel if its IPv4 source address sends more than
+   pkt_per_sec packets per second on average to them, allowing bursts
+   of up to burst_cnt packets.  Traffic to other listeners is never
+   rate limited.
+   pkt_per_sec==0 disables rate limiting (the default after
+   fd_xdp_init).  pkt_per_sec must be at most 1e9 and burst_cnt must be
+   in [1,UINT_MAX] if rate limiting is enabled.  Takes effect
+   immediately on all interfaces hooked for the given app_name.
+   Returns 0 on success and -1 on error.  Reasons for error are logged
+   to FD_LOG_WARNING. */
+
+int
+fd_xdp_set_rate_limit( char const * app_name,
+                       ulong        pkt_per_sec,
+                       ulong        burst_cnt );
+
 /* Runtime API (unprivileged) *****************************************/
 
 /* fd_xsk_activate installs an XSK file descriptor into the XDP redirect
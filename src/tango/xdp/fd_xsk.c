@@ -20,6 +20,18 @@
 #include "fd_xsk_private.h"
 #include "fd_xdp_redirect_user.h"
 
+/* Busy polling socket options, missing from older libc headers */
+
+#ifndef SO_BUSY_POLL
+#define SO_BUSY_POLL 46
+#endif
+#ifndef SO_PREFER_BUSY_POLL
+#define SO_PREFER_BUSY_POLL 69
+#endif
+#ifndef SO_BUSY_POLL_BUDGET
+#define SO_BUSY_POLL_BUDGET 70
+#endif
+
 /* TODO move this into more appropriate header file
    and set based on architecture, etc. */
 #define FD_ACQUIRE FD_COMPILER_MFENCE
@@ -175,6 +187,41 @@ fd_xsk_unbind( void * shxsk ) {
   return shxsk;
 }
 
+void *
+fd_xsk_set_busy_poll( void * shxsk,
+                      uint   busy_poll_usecs,
+                      uint   busy_poll_budget ) {
+  /* Argument checks */
+
+  if( FD_UNLIKELY( !shxsk ) ) {
+    FD_LOG_WARNING(( "NULL shxsk" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shxsk, fd_xsk_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shxsk" ));
+    return NULL;
+  }
+
+  fd_xsk_t * xsk = (fd_xsk_t *)shxsk;
+  if( FD_UNLIKELY( xsk->magic!=FD_XSK_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic (not an fd_xsk_t?)" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( busy_poll_budget>USHORT_MAX ) ) {
+    FD_LOG_WARNING(( "busy_poll_budget %u too large", busy_poll_budget ));
+    return NULL;
+  }
+
+  /* Assign */
+
+  xsk->busy_poll_usecs  = busy_poll_usecs;
+  xsk->busy_poll_budget = busy_poll_budget;
+
+  return shxsk;
+}
+
 /* New/delete *********************************************************/
 
 void *
@@ -470,6 +517,28 @@ fd_xsk_init( fd_xsk_t * xsk ) {
     return -1;
   }
 
+  /* Opt into busy polling.  The kernel then defers the interrupts of
+     the interface queue while we poll it (requires CAP_NET_ADMIN). */
+
+  if( xsk->busy_poll_usecs ) {
+#   define FD_SET_XSK_SOCKOPT( name, val ) do {                          \
+      int _val = (int)(val);                                             \
+      if( FD_UNLIKELY( 0!=setsockopt( xsk->xsk_fd, SOL_SOCKET, name,     \
+                                      &_val, sizeof(int) ) ) ) {         \
+        FD_LOG_WARNING(( "setsockopt(SOL_SOCKET, " #name ", %d) failed (%i-%s)", \
+                         _val, errno, fd_io_strerror( errno ) ));        \
+        return -1;                                                       \
+      }                                                                  \
+    } while(0)
+
+    FD_SET_XSK_SOCKOPT( SO_PREFER_BUSY_POLL, 1                     );
+    FD_SET_XSK_SOCKOPT( SO_BUSY_POLL,        xsk->busy_poll_usecs  );
+    if( xsk->busy_poll_budget )
+      FD_SET_XSK_SOCKOPT( SO_BUSY_POLL_BUDGET, xsk->busy_poll_budget );
+
+#   undef FD_SET_XSK_SOCKOPT
+  }
+
   /* Associate UMEM region of fd_xsk_t with XSK via setsockopt() */
 
   if( FD_UNLIKELY( 0!=fd_xsk_setup_umem( xsk ) ) ) return -1;
@@ -761,8 +830,9 @@ fd_xsk_tx_enqueue( fd_xsk_t *            xsk,
     /* update producer */
     FD_VOLATILE( *tx->prod ) = prod;
 
-    /* XDP tells us whether we need to specifically wake up the driver/hw */
-    if( fd_xsk_tx_need_wakeup( xsk ) ) {
+    /* XDP tells us whether we need to specifically wake up the driver/hw.
+       When busy polling, the kernel relies on us to always do it. */
+    if( fd_xsk_tx_need_wakeup( xsk ) | fd_xsk_busy_poll( xsk ) ) {
       if( FD_UNLIKELY( -1==sendto( xsk->xsk_fd, NULL, 0, MSG_DONTWAIT, NULL, 0 ) ) ) {
         if( FD_UNLIKELY( errno!=EAGAIN ) ) {
           FD_LOG_WARNING(( "xsk sendto failed xsk_fd=%d (%i-%s)", xsk->xsk_fd, errno, fd_io_strerror( errno ) ));
@@ -774,6 +844,16 @@ fd_xsk_tx_enqueue( fd_xsk_t *            xsk,
   return sz;
 }
 
+void
+fd_xsk_rx_wakeup( fd_xsk_t * xsk ) {
+  if( FD_LIKELY( !( fd_xsk_rx_need_wakeup( xsk ) | fd_xsk_busy_poll( xsk ) ) ) ) return;
+  if( FD_UNLIKELY( -1==recvfrom( xsk->xsk_fd, NULL, 0, MSG_DONTWAIT, NULL, NULL ) ) ) {
+    if( FD_UNLIKELY( (errno!=EAGAIN) & (errno!=EBUSY) ) ) {
+      FD_LOG_WARNING(( "xsk recvfrom failed xsk_fd=%d (%i-%s)", xsk->xsk_fd, errno, fd_io_strerror( errno ) ));
+    }
+  }
+}
+
 ulong
 fd_xsk_rx_complete( fd_xsk_t *            xsk,
                     fd_xsk_frame_meta_t * batch,
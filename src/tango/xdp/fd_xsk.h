@@ -207,6 +207,25 @@ fd_xsk_bind( void *       shxsk,
 void *
 fd_xsk_unbind( void * shxsk );
 
+/* fd_xsk_set_busy_poll configures the XSK to be busy polled by its
+   user.  Takes effect on the next join.  If busy_poll_usecs is non-zero,
+   the XSK is created with SO_PREFER_BUSY_POLL, SO_BUSY_POLL set to
+   busy_poll_usecs and SO_BUSY_POLL_BUDGET set to busy_poll_budget (0
+   for the kernel default).  Interrupts of the interface queue are then
+   deferred in favor of the user driving the queue's NAPI context from
+   its own thread, whenever it services the XSK (see fd_xsk_rx_wakeup
+   and fd_xsk_tx_enqueue).  This needs CAP_NET_ADMIN at join and is only
+   effective if the interface defers interrupts (see
+   /sys/class/net/{ifname}/napi_defer_hard_irqs and gro_flush_timeout).
+   busy_poll_usecs 0 disables busy polling (the default), the XSK then
+   only makes syscalls when the kernel signals it needs a wakeup.
+   Returns shxsk on success or NULL on failure (logs details). */
+
+void *
+fd_xsk_set_busy_poll( void * shxsk,
+                      uint   busy_poll_usecs,
+                      uint   busy_poll_budget );
+
 /* fd_xsk_join joins the caller to the fd_xsk_t and starts packet
    redirection.  shxsk points to the first byte of the memory region
    backing the fd_xsk_t in the caller's address space.  Returns a
@@ -291,6 +310,16 @@ fd_xsk_rx_complete( fd_xsk_t *            xsk,
                     fd_xsk_frame_meta_t * meta,
                     ulong                 meta_cnt );
 
+/* fd_xsk_rx_wakeup: Wakes up the kernel to receive into the XSK, if
+   needed.  Should be called when fd_xsk_rx_complete found no packets.
+   Makes a non-blocking recvfrom syscall if the kernel signals it needs
+   a wakeup to process the fill ring (XDP_USE_NEED_WAKEUP) or if the XSK
+   is busy polled (in which case the syscall drives the NAPI context of
+   the interface queue).  Otherwise, does nothing. */
+
+void
+fd_xsk_rx_wakeup( fd_xsk_t * xsk );
+
 
 /* fd_xsk_tx_enqueue: Enqueues a batch of frames for TX.
 
@@ -302,7 +331,8 @@ fd_xsk_rx_complete( fd_xsk_t *            xsk,
    network, but rather just indicates that the frame memory is
    registered with the AF_XDP sockets.  The frames that failed to
    enqueue are referred to by meta[N+] and may be retried in a later
-   call. */
+   call.  If flush is non-zero, makes the enqueued frames visible to the
+   kernel and wakes it up if needed (always if the XSK is busy polled). */
 
 ulong
 fd_xsk_tx_enqueue( fd_xsk_t *            xsk,
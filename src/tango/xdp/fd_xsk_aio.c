@@ -251,6 +251,10 @@ fd_xsk_aio_service( fd_xsk_aio_t * xsk_aio ) {
   /* try completing receives */
   ulong rx_avail = fd_xsk_rx_complete( xsk, meta, pkt_depth );
 
+  /* nothing received, kick the kernel if it needs it (or if we drive
+     the interface queue by busy polling) */
+  if( !rx_avail ) fd_xsk_rx_wakeup( xsk );
+
   /* forward to aio */
   if( rx_avail ) {
     for( ulong j=0; j<rx_avail; j++ ) {
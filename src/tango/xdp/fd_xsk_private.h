@@ -76,6 +76,12 @@ struct __attribute__((aligned(FD_XSK_ALIGN))) fd_xsk_private {
   uint if_idx;
   uint if_queue_id;
 
+  /* busy_poll_usecs:  SO_BUSY_POLL of the XSK, 0 if not busy polled.
+     busy_poll_budget: SO_BUSY_POLL_BUDGET of the XSK, 0 for default.
+     See fd_xsk_set_busy_poll. */
+  uint busy_poll_usecs;
+  uint busy_poll_budget;
+
   /* Memory layout parameters */
 
   fd_xsk_params_t params;
@@ -127,6 +133,13 @@ fd_xsk_rx_need_wakeup( fd_xsk_t * xsk ) {
   return !!( *xsk->ring_fr.flags & XDP_RING_NEED_WAKEUP );
 }
 
+/* fd_xsk_busy_poll: returns whether the XSK is busy polled. */
+
+static inline int
+fd_xsk_busy_poll( fd_xsk_t * xsk ) {
+  return !!xsk->busy_poll_usecs;
+}
+
 /* fd_xsk_tx_need_wakeup: returns whether a wakeup is required to
    complete a tx operation */
 
@@ -23,14 +23,16 @@
 
 FD_IMPORT_BINARY( fd_xdp_redirect_prog, "src/tango/xdp/fd_xdp_redirect_prog.o" );
 
-static uchar tmp_prog[ 2048UL ];
+static uchar tmp_prog[ 4096UL ];
 
 /* Kernel file descriptors */
 
-int prog_fd     = -1; /* BPF program */
-int udp_dsts_fd = -1; /* UDP destinations */
-int xsks_fd     = -1; /* Queue-to-XSK map */
-int xsk_fd      = -1; /* AF_XDP socket */
+int prog_fd        = -1; /* BPF program */
+int udp_dsts_fd    = -1; /* UDP destinations */
+int rate_limits_fd = -1; /* Per-source rate limit state */
+int rate_cfg_fd    = -1; /* Rate limit config */
+int xsks_fd        = -1; /* Queue-to-XSK map */
+int xsk_fd         = -1; /* AF_XDP socket */
 
 /* Test harness *******************************************************/
 
@@ -47,10 +49,14 @@ struct fd_xdp_redirect_test {
   /* Note: Relies on little-endian addressing */
   fd_udp_dst_kv_t *udp_dsts_kv; /* Null-delimited key-value pairs in UDP dsts map */
   fd_xsks_kv_t    *xsks_kv;     /* Null-delimited key-value pairs in XSKs map     */
+  uint             proto;       /* Proto of default UDP dst, 0 means TPU/QUIC     */
+
+  fd_xdp_rate_cfg_t const * rate_cfg; /* Rate limit config, NULL if disabled */
+  uint                      run_cnt;  /* Number of times the packet is sent, 0 means once */
 
   /* Output ***************/
 
-  uint xdp_action;
+  uint xdp_action;  /* Action taken on the last run */
 };
 typedef struct fd_xdp_redirect_test fd_xdp_redirect_test_t;
 
@@ -77,8 +83,9 @@ fd_bpf_map_clear( int map_fd ) {
 
 static void
 fd_run_xdp_redirect_test( fd_xdp_redirect_test_t const * test ) {
-  fd_bpf_map_clear( udp_dsts_fd );
-  fd_bpf_map_clear( xsks_fd     );
+  fd_bpf_map_clear( udp_dsts_fd    );
+  fd_bpf_map_clear( xsks_fd        );
+  fd_bpf_map_clear( rate_limits_fd );
 
 # define FD_XDP_TEST(c) do { if( FD_UNLIKELY( !(c) ) ) FD_LOG_ERR(( "FAIL (%s): %s", test->name, #c )); } while(0)
 
@@ -92,10 +99,16 @@ fd_run_xdp_redirect_test( fd_xdp_redirect_test_t const * test ) {
   } else {
     /* Add 127.0.0.1:8001 to map by default */
     ulong k=fd_xdp_udp_dst_key( FD_IP4_ADDR( 127, 0, 0, 1), 8001U );
-    uint  v=0U;
+    uint  v=fd_uint_if( !!test->proto, test->proto, FD_XDP_PROTO_TPU_QUIC_USER );
     FD_TEST( 0==fd_bpf_map_update_elem( udp_dsts_fd, &k, &v, 0UL ) );
   }
 
+  /* Configure rate limit */
+  uint              rate_cfg_key = 0U;
+  fd_xdp_rate_cfg_t rate_cfg     = {0};
+  if( test->rate_cfg ) rate_cfg = *test->rate_cfg;
+  FD_TEST( 0==fd_bpf_map_update_elem( rate_cfg_fd, &rate_cfg_key, &rate_cfg, 0UL ) );
+
   /* Hook up to XSK */
   int rx_queue = 0;
   FD_TEST( 0==fd_bpf_map_update_elem( xsks_fd, &rx_queue, &xsk_fd, 0UL ) );
@@ -104,7 +117,8 @@ fd_run_xdp_redirect_test( fd_xdp_redirect_test_t const * test ) {
     .test = {
       .prog_fd      = (uint)prog_fd,
       .data_in      = (ulong)test->packet,
-      .data_size_in = (uint)*test->packet_sz
+      .data_size_in = (uint)*test->packet_sz,
+      .repeat       = test->run_cnt
     }
   };
   FD_XDP_TEST( 0==bpf( BPF_PROG_TEST_RUN, &attr, sizeof(union bpf_attr) ) );
@@ -130,6 +144,60 @@ FD_IMPORT_BINARY( tcp_rst,         "src/tango/xdp/fixtures/tcp_rst.bin"
 
 FD_IMPORT_BINARY( quic_initial,    "src/tango/xdp/fixtures/quic_initial.bin"    );
 
+/* Variants of quic_initial derived at startup (see quic_variants_init).
+   The UDP header starts at offset 34 and the QUIC packet at offset 42. */
+
+#define QUIC_VARIANT( x ) static uchar x[ 1242UL ]; static ulong x##_sz;
+QUIC_VARIANT( quic_tiny          )  /* UDP payload shorter than any QUIC packet */
+QUIC_VARIANT( quic_truncated     )  /* UDP length exceeds frame */
+QUIC_VARIANT( quic_initial_small )  /* Initial in a datagram smaller than 1200 bytes */
+QUIC_VARIANT( quic_no_fixed_bit  )  /* Fixed bit cleared */
+QUIC_VARIANT( quic_bad_version   )  /* Unsupported QUIC version */
+QUIC_VARIANT( quic_retry         )  /* Retry packet */
+QUIC_VARIANT( quic_handshake     )  /* Handshake packet to an fd_quic conn ID */
+QUIC_VARIANT( quic_handshake_cid )  /* Handshake packet with foreign conn ID size */
+QUIC_VARIANT( quic_short         )  /* Short header packet */
+#undef QUIC_VARIANT
+
+static ulong
+quic_variant( uchar * pkt,
+              ulong   pkt_sz,
+              ulong   udp_sz ) {
+  fd_memcpy( pkt, quic_initial, quic_initial_sz );
+  pkt[ 38 ] = (uchar)( udp_sz>>8 );
+  pkt[ 39 ] = (uchar)( udp_sz    );
+  return pkt_sz;
+}
+
+static void
+quic_variants_init( void ) {
+  FD_TEST( quic_initial_sz==1242UL );
+
+  quic_tiny_sz          = quic_variant( quic_tiny,            62UL,   28UL );
+  quic_truncated_sz     = quic_variant( quic_truncated,      642UL, 1208UL );
+  quic_initial_small_sz = quic_variant( quic_initial_small, 1142UL, 1108UL );
+  quic_no_fixed_bit_sz  = quic_variant( quic_no_fixed_bit,  1242UL, 1208UL );
+  quic_no_fixed_bit[ 42 ] = 0x8f;
+  quic_bad_version_sz   = quic_variant( quic_bad_version,   1242UL, 1208UL );
+  quic_bad_version[ 46 ] = 0x02;
+  quic_retry_sz         = quic_variant( quic_retry,         1242UL, 1208UL );
+  quic_retry[ 42 ] = 0xff;
+  quic_handshake_sz     = quic_variant( quic_handshake,      242UL,  208UL );
+  quic_handshake[ 42 ] = 0xef;
+  quic_handshake[ 47 ] = FD_XDP_QUIC_CONN_ID_SZ;
+  quic_handshake_cid_sz = quic_variant( quic_handshake_cid,  242UL,  208UL );
+  quic_handshake_cid[ 42 ] = 0xef;
+  quic_short_sz         = quic_variant( quic_short,           92UL,   58UL );
+  quic_short[ 42 ] = 0x41;
+}
+
+/* rate_1pps_burst3 allows 3 back-to-back packets per source */
+
+static fd_xdp_rate_cfg_t const rate_1pps_burst3 = {
+  .cost_ns  = 1000000000UL,
+  .burst_ns = 2000000000UL
+};
+
 fd_xdp_redirect_test_t tests[] = {
   /* Ensure that program sets XDP_PASS on common packet types that are
      not part of the Firedancer application layer. */
@@ -147,6 +215,35 @@ fd_xdp_redirect_test_t tests[] = {
 
   { TEST( quic_initial    ) .xdp_action = XDP_REDIRECT },
 
+  /* Ensure that clearly malformed QUIC datagrams are dropped */
+
+  { TEST( quic_tiny          ) .xdp_action = XDP_DROP     },
+  { TEST( quic_truncated     ) .xdp_action = XDP_DROP     },
+  { TEST( quic_initial_small ) .xdp_action = XDP_DROP     },
+  { TEST( quic_no_fixed_bit  ) .xdp_action = XDP_DROP     },
+  { TEST( quic_bad_version   ) .xdp_action = XDP_DROP     },
+  { TEST( quic_retry         ) .xdp_action = XDP_DROP     },
+  { TEST( quic_handshake     ) .xdp_action = XDP_REDIRECT },
+  { TEST( quic_handshake_cid ) .xdp_action = XDP_DROP     },
+  { TEST( quic_short         ) .xdp_action = XDP_REDIRECT },
+
+  /* Ensure that sources exceeding the rate limit are dropped */
+
+  { TEST( quic_initial ) .rate_cfg = &rate_1pps_burst3, .run_cnt = 3U, .xdp_action = XDP_REDIRECT },
+  { TEST( quic_initial ) .rate_cfg = &rate_1pps_burst3, .run_cnt = 4U, .xdp_action = XDP_DROP     },
+  { TEST( quic_short   ) .rate_cfg = &rate_1pps_burst3, .run_cnt = 8U, .xdp_action = XDP_DROP     },
+
+  /* Ensure that traffic to vote QUIC listeners is filtered too */
+
+  { TEST( quic_initial ) .proto = FD_XDP_PROTO_TPU_QUIC_VOTE, .rate_cfg = &rate_1pps_burst3, .run_cnt = 4U, .xdp_action = XDP_DROP     },
+  { TEST( quic_tiny    ) .proto = FD_XDP_PROTO_TPU_QUIC_VOTE,                                             .xdp_action = XDP_DROP     },
+
+  /* Ensure that traffic to non-QUIC listeners is redirected unfiltered */
+
+  { TEST( quic_tiny    ) .proto = FD_XDP_PROTO_GOSSIP,                                                    .xdp_action = XDP_REDIRECT },
+  { TEST( quic_retry   ) .proto = FD_XDP_PROTO_TVU,                                                       .xdp_action = XDP_REDIRECT },
+  { TEST( quic_initial ) .proto = FD_XDP_PROTO_TPU_UDP_USER,  .rate_cfg = &rate_1pps_burst3, .run_cnt = 8U, .xdp_action = XDP_REDIRECT },
+
   #undef TEST
   {0}
 };
@@ -176,6 +273,32 @@ int main( int     argc,
     return -1;
   }
 
+  attr = (union bpf_attr) {
+    .map_type    = BPF_MAP_TYPE_LRU_HASH,
+    .map_name    = "fd_xdp_rate_lim",
+    .key_size    = 4U,
+    .value_size  = 8U,
+    .max_entries = FD_XDP_RATE_LIMIT_MAP_CNT,
+  };
+  rate_limits_fd = (int)bpf( BPF_MAP_CREATE, &attr, sizeof(union bpf_attr) );
+  if( FD_UNLIKELY( rate_limits_fd<0 ) ) {
+    FD_LOG_WARNING(( "Failed to create LRU hash map (%i-%s)", errno, fd_io_strerror( errno ) ));
+    return -1;
+  }
+
+  attr = (union bpf_attr) {
+    .map_type    = BPF_MAP_TYPE_ARRAY,
+    .map_name    = "fd_xdp_rate_cfg",
+    .key_size    = 4U,
+    .value_size  = sizeof(fd_xdp_rate_cfg_t),
+    .max_entries = 1U,
+  };
+  rate_cfg_fd = (int)bpf( BPF_MAP_CREATE, &attr, sizeof(union bpf_attr) );
+  if( FD_UNLIKELY( rate_cfg_fd<0 ) ) {
+    FD_LOG_WARNING(( "Failed to create array map (%i-%s)", errno, fd_io_strerror( errno ) ));
+    return -1;
+  }
+
   attr = (union bpf_attr) {
     .map_type    = BPF_MAP_TYPE_XSKMAP,
     .key_size    = 4U,
@@ -191,15 +314,17 @@ int main( int     argc,
 
   /* Link program */
 
-  fd_ebpf_sym_t syms[ 2 ] = {
-    { .name = "fd_xdp_udp_dsts", .value = (ulong)udp_dsts_fd },
-    { .name = "fd_xdp_xsks",     .value = (ulong)xsks_fd     }
+  fd_ebpf_sym_t syms[ 4 ] = {
+    { .name = "fd_xdp_udp_dsts",    .value = (ulong)udp_dsts_fd    },
+    { .name = "fd_xdp_xsks",        .value = (ulong)xsks_fd        },
+    { .name = "fd_xdp_rate_limits", .value = (ulong)rate_limits_fd },
+    { .name = "fd_xdp_rate_cfg",    .value = (ulong)rate_cfg_fd    }
   };
 
   fd_ebpf_link_opts_t link_opts = {
     .section = "xdp",
     .sym     = syms,
-    .sym_cnt = 2UL
+    .sym_cnt = 4UL
   };
 
   FD_TEST( fd_xdp_redirect_prog_sz<=sizeof(tmp_prog) );
@@ -234,6 +359,8 @@ int main( int     argc,
 
   /* Run tests */
 
+  quic_variants_init();
+
   for( fd_xdp_redirect_test_t * t=tests; t->packet; t++ )
     fd_run_xdp_redirect_test( t );
 
@@ -241,6 +368,8 @@ int main( int     argc,
 
   close( xsk_fd );
   close( prog_fd );
+  close( rate_cfg_fd );
+  close( rate_limits_fd );
 
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
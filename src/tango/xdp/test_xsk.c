@@ -136,6 +136,7 @@ test_xsk( void ) {
 
   FD_TEST( NULL==fd_xsk_join  ( shxsk ) );
   FD_TEST( NULL==fd_xsk_bind  ( shxsk, "app",  "lo", 0U ) );
+  FD_TEST( NULL==fd_xsk_set_busy_poll( shxsk, 50U, 64U ) );
   FD_TEST( NULL==fd_xsk_delete( shxsk ) );
 
   xsk->magic--;
@@ -156,6 +157,18 @@ test_xsk( void ) {
 
   FD_TEST( NULL==fd_xsk_bind( (void *)((ulong)shxsk+1UL), "app", "lo", 0U ) ); /* unalign shxsk */
 
+  /* Busy polling */
+
+  FD_TEST( !fd_xsk_busy_poll( xsk ) );
+  FD_TEST( NULL==fd_xsk_set_busy_poll( NULL,                        50U, 64U          ) ); /* NULL shxsk    */
+  FD_TEST( NULL==fd_xsk_set_busy_poll( (void *)((ulong)shxsk+1UL),  50U, 64U          ) ); /* unalign shxsk */
+  FD_TEST( NULL==fd_xsk_set_busy_poll( shxsk,                       50U, 0x10000U     ) ); /* oversz budget */
+  FD_TEST( shxsk==fd_xsk_set_busy_poll( shxsk, 50U, 64U ) );
+  FD_TEST( fd_xsk_busy_poll( xsk ) );
+  FD_TEST( xsk->busy_poll_usecs==50U ); FD_TEST( xsk->busy_poll_budget==64U );
+  FD_TEST( shxsk==fd_xsk_set_busy_poll( shxsk, 0U, 0U ) );
+  FD_TEST( !fd_xsk_busy_poll( xsk ) );
+
   /* Mock join */
 
   FD_TEST( fd_xsk_bind( shxsk, "app", "lo", 0U ) );
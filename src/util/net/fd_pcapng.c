@@ -164,6 +164,8 @@ fd_pcapng_read_option( FILE *               stream,
 
   uint end_off = fd_uint_align_up( opt_hdr.sz, 4U );
   uint read_sz = fd_uint_min( end_off, opt->sz );
+  opt->type    = opt_hdr.type;
+  opt->sz      = (ushort)fd_uint_min( (uint)opt_hdr.sz, (uint)opt->sz );
 
   if( read_sz ) {
     if( FD_UNLIKELY( 1UL!=fread( opt->value, read_sz, 1UL, stream ) ) )
@@ -293,6 +295,7 @@ fd_pcapng_iter_next( fd_pcapng_iter_t * iter ) {
 
       fd_pcapng_idb_desc_t * iface = &iter->iface[ iter->iface_cnt++ ];
       memset( iface, 0, sizeof(fd_pcapng_idb_desc_t) );
+      iface->opts.tsresol = FD_PCAPNG_TSRESOL_US;
 
       /* Read options */
       for( uint j=0; j<FD_PCAPNG_MAX_OPT_CNT; j++ ) {
@@ -406,8 +409,16 @@ fd_pcapng_iter_next( fd_pcapng_iter_t * iter ) {
         return NULL;
       }
 
-      /* Read options */
+      if( FD_UNLIKELY( 0!=fseek( stream, (long)( fd_uint_align_up( epb.cap_len, 4U )-epb.cap_len ), SEEK_CUR ) ) ) {
+        iter->error = FD_PCAPNG_ITER_ERR_IO;
+        FD_LOG_WARNING(( "pcapng: seek failed (%s)", fd_pcapng_iter_strerror( iter->error, stream ) ));
+        return NULL;
+      }
+
+      /* Read options.  Options are optional, and the block may end
+         right after the padded packet data. */
       for( uint j=0; j<FD_PCAPNG_MAX_OPT_CNT; j++ ) {
+        if( ftell( stream )+4L>=end ) break;
         uchar opt_buf[ 128UL ] __attribute__((aligned(32UL)));
         fd_pcapng_option_t opt = { .sz=sizeof(opt_buf), .value=&opt_buf };
         if( FD_UNLIKELY( 0!=(iter->error = fd_pcapng_read_option( stream, &opt )) ) ) {
@@ -430,6 +441,8 @@ fd_pcapng_iter_next( fd_pcapng_iter_t * iter ) {
         /* FIXME support more timestamp resolutions */
         if( iter->iface[ epb.if_idx ].opts.tsresol == FD_PCAPNG_TSRESOL_NS ) {
           pkt.ts = (long)raw;
+        } else if( iter->iface[ epb.if_idx ].opts.tsresol == FD_PCAPNG_TSRESOL_US ) {
+          pkt.ts = (long)( raw*1000UL );
         }
       }
 
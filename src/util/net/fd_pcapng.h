@@ -63,6 +63,7 @@ typedef struct fd_pcapng_idb_opts fd_pcapng_idb_opts_t;
 
 /* FD_PCAPNG_TSRESOL_* sets the resolution of a timestamp. */
 
+#define FD_PCAPNG_TSRESOL_US ((uchar)0x06) /* Default if an IDB doesn't say */
 #define FD_PCAPNG_TSRESOL_NS ((uchar)0x09)
 
 /* fd_pcap_iter iter frame types */
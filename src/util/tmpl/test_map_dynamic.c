@@ -177,6 +177,15 @@ main( int     argc,
     }
   }
 
+  /* Clearing a full map makes all its slots available again */
+  for( ulong iter=0UL; iter<2UL; iter++ ) {
+    for( ulong i=0UL; i<max; i++ ) FD_TEST( map_insert( map, ref[i].mykey ) );
+    FD_TEST( map_key_cnt( map )==max );
+    map_clear( map );
+    FD_TEST( map_key_cnt( map )==0UL );
+    for( ulong i=0UL; i<max; i++ ) FD_TEST( !map_query( map, ref[i].mykey, NULL ) );
+  }
+
   FD_TEST( map_leave ( map   )==shmap       );
   FD_TEST( map_delete( shmap )==(void *)mem );
 